@@ -59,3 +59,13 @@ def config_etrace(cpu_cls, cpu_list, options):
     else:
         fatal("%s does not support data dependency tracing. Use a CPU model of"
               " type or inherited from DerivO3CPU.", cpu_cls)
+
+def config_pipe_trace(cpu_cls, cpu_list, options):
+    if not issubclass(cpu_cls, m5.objects.DerivO3CPU):
+        fatal("%s does not support pipeline tracing. Use a CPU model of"
+              " type or inherited from DerivO3CPU.", cpu_cls)
+    # Every cpu writes its own trace, prefixed with the name of the probe
+    # listener
+    for cpu in cpu_list:
+        cpu.pipeTraceListener = m5.objects.PipeTrace(
+                                traceFile = options.pipe_trace_file)
@@ -687,7 +687,8 @@ def makeDistRoot(testSystem,
                  sync_start,
                  linkspeed,
                  linkdelay,
-                 dumpfile):
+                 dumpfile,
+                 transport="tcp"):
     self = Root(full_system = True)
     self.testsys = testSystem
 
@@ -697,6 +698,7 @@ def makeDistRoot(testSystem,
                                    dist_size = size,
                                    server_name = server_name,
                                    server_port = server_port,
+                                   dist_transport = transport,
                                    sync_start = sync_start,
                                    sync_repeat = sync_repeat)
 
@@ -96,7 +96,12 @@ def create_TLB_Coalescer(options, my_level, my_index, tlb_name,
             eval(Coalescer_constructor(options, my_level, full_system)))
 
 def config_tlb_hierarchy(options, system, shader_idx, gpu_ctrl=None,
-                         full_system=False):
+                         full_system=False, cu_port_peer=None):
+    # cu_port_peer(cu, port) returns what a port of the CU should be
+    # connected to to reach port, e.g. a bridge to another event queue
+    if cu_port_peer is None:
+        cu_port_peer = lambda cu, port: port
+
     n_cu = options.num_compute_units
 
     if options.TLB_config == "perLane":
@@ -186,33 +191,35 @@ def config_tlb_hierarchy(options, system, shader_idx, gpu_ctrl=None,
         if name == 'l1':     # L1 D-TLBs
             tlb_per_cu = num_TLBs // n_cu
             for cu_idx in range(n_cu):
+                cu = system.cpu[shader_idx].CUs[cu_idx]
                 if tlb_per_cu:
                     for tlb in range(tlb_per_cu):
-                        exec('system.cpu[%d].CUs[%d].translation_port[%d] = \
-                                system.l1_coalescer[%d].cpu_side_ports[%d]' % \
-                                (shader_idx, cu_idx, tlb,
-                                    cu_idx*tlb_per_cu+tlb, 0))
+                        coalescer = \
+                            system.l1_coalescer[cu_idx * tlb_per_cu + tlb]
+                        cu.translation_port[tlb] = \
+                            cu_port_peer(cu, coalescer.cpu_side_ports[0])
                 else:
-                    exec('system.cpu[%d].CUs[%d].translation_port[%d] = \
-                            system.l1_coalescer[%d].cpu_side_ports[%d]' % \
-                            (shader_idx, cu_idx, tlb_per_cu,
-                                cu_idx / (n_cu / num_TLBs),
-                                cu_idx % (n_cu / num_TLBs)))
+                    coalescer = \
+                        system.l1_coalescer[int(cu_idx / (n_cu / num_TLBs))]
+                    cu.translation_port[tlb_per_cu] = cu_port_peer(cu,
+                        coalescer.cpu_side_ports[
+                            int(cu_idx % (n_cu / num_TLBs))])
         elif name == 'sqc': # I-TLB
             for index in range(n_cu):
-                sqc_tlb_index = index / options.cu_per_sqc
+                cu = system.cpu[shader_idx].CUs[index]
+                sqc_tlb_index = int(index / options.cu_per_sqc)
                 sqc_tlb_port_id = index % options.cu_per_sqc
-                exec('system.cpu[%d].CUs[%d].sqc_tlb_port = \
-                        system.sqc_coalescer[%d].cpu_side_ports[%d]' % \
-                        (shader_idx, index, sqc_tlb_index, sqc_tlb_port_id))
+                cu.sqc_tlb_port = cu_port_peer(cu,
+                    system.sqc_coalescer[sqc_tlb_index].cpu_side_ports[
+                        sqc_tlb_port_id])
         elif name == 'scalar': # Scalar D-TLB
             for index in range(n_cu):
-                scalar_tlb_index = index / options.cu_per_scalar_cache
+                cu = system.cpu[shader_idx].CUs[index]
+                scalar_tlb_index = int(index / options.cu_per_scalar_cache)
                 scalar_tlb_port_id = index % options.cu_per_scalar_cache
-                exec('system.cpu[%d].CUs[%d].scalar_tlb_port = \
-                        system.scalar_coalescer[%d].cpu_side_ports[%d]' % \
-                        (shader_idx, index, scalar_tlb_index,
-                         scalar_tlb_port_id))
+                cu.scalar_tlb_port = cu_port_peer(cu,
+                    system.scalar_coalescer[scalar_tlb_index].cpu_side_ports[
+                        scalar_tlb_port_id])
 
     # Connect the memSidePorts of all the TLBs with the
     # cpuSidePorts of the Coalescers of the next level
@@ -259,6 +259,10 @@ def addCommonOptions(parser):
                         help="""Data dependency trace file input to
                       Elastic Trace probe in a capture simulation and
                       Trace CPU in a replay simulation""", default="")
+    parser.add_argument("--pipe-trace-file", action="store", type=str,
+                        help="""Write a binary pipeline trace of the O3
+                      CPUs for util/o3-pipeview.py to this file in the
+                      output directory""", default="")
 
     # dist-gem5 options
     parser.add_argument("--dist", action="store_true",
@@ -282,6 +286,10 @@ def addCommonOptions(parser):
                         default=2200,
                         action="store", type=int,
                         help="Message server listen port\nDEFAULT: 2200")
+    parser.add_argument(
+        "--dist-transport", default="tcp", choices=["tcp", "shm"],
+        help="Transport between the dist-gem5 processes. shm only works "
+        "when all of them run on one host\nDEFAULT: tcp")
     parser.add_argument(
         "--dist-sync-repeat", default="0us", action="store", type=str,
         help="Repeat interval for synchronisation barriers among "
@@ -454,6 +462,13 @@ def addSEOptions(parser):
                         "to/host/dir1 --redirects /dir2=/path/to/host/dir2")
     parser.add_argument("--wait-gdb", default=False, action='store_true',
                         help="Wait for remote GDB to connect.")
+    parser.add_argument("--parallel-eventqs", action="store_true",
+                        help="Simulate each CPU on its own event queue and "
+                        "host thread. The CPUs must only share memory, "
+                        "i.e. be atomic CPUs without caches.")
+    parser.add_argument("--sim-quantum", type=str, default="10us",
+                        help="Synchronization quantum of the event queues "
+                        "with --parallel-eventqs")
 
 
 def addFSOptions(parser):
@@ -494,6 +494,8 @@ def run(options, root, testsys, cpu_class):
         # to the switch CPUs
         if options.elastic_trace_en:
             CpuConfig.config_etrace(cpu_class, switch_cpus, options)
+        if options.pipe_trace_file:
+            CpuConfig.config_pipe_trace(cpu_class, switch_cpus, options)
 
         testsys.switch_cpus = switch_cpus
         switch_cpu_list = [(testsys.cpu[i], switch_cpus[i]) for i in range(np)]
@@ -51,6 +51,7 @@ def build_switch(args):
                                       dist_size = args.dist_size,
                                       server_name = args.dist_server_name,
                                       server_port = args.dist_server_port,
+                                      dist_transport = args.dist_transport,
                                       sync_start = args.dist_sync_start,
                                       sync_repeat = args.dist_sync_repeat,
                                       is_switch = True,
@@ -191,6 +191,19 @@ parser.add_argument("--gfx-version", type=str, default='gfx801',
                     help="Gfx version for gpu"
                     "Note: gfx902 is not fully supported by ROCm")
 
+parser.add_argument("--cu-eventq-groups", type=int, default=1,
+                    help="Split the compute units into this many groups, "
+                    "each simulated on its own event queue and host thread. "
+                    "Accesses of the CUs outside the first group to the "
+                    "caches and TLBs take --sim-quantum longer each way.")
+parser.add_argument("--kernel-sample-period", type=int, default=1,
+                    help="Run every Nth kernel launch in detail. The other "
+                    "launches are not executed and complete after the "
+                    "latency measured for the same kernel.")
+parser.add_argument("--kernel-sample-offset", type=int, default=0,
+                    help="Fast-forward through this many kernel launches "
+                    "before the first one run in detail")
+
 Ruby.define_options(parser)
 
 # add TLB options to the parser
@@ -344,6 +357,27 @@ for i in range(n_cu):
     compute_units[-1].ldsBus.mem_side_port = \
         compute_units[-1].localDataStore.cuPort
 
+# Compute units outside the first group run on their own event queues.
+# The shader and dispatcher synchronise with them directly, everything
+# else they reach through their ports to Ruby and the TLBs, which cross
+# back to the first queue through bridges.
+if args.cu_eventq_groups < 1 or args.cu_eventq_groups > n_cu:
+    fatal("--cu-eventq-groups must be between 1 and the number of CUs")
+if args.cu_eventq_groups > 1:
+    for i, cu in enumerate(compute_units):
+        cu.eventq_index = i * args.cu_eventq_groups // n_cu
+
+def cu_port_peer(cu, port):
+    """Return what a port of the CU connects to to reach port."""
+    if args.cu_eventq_groups == 1 or cu.eventq_index == 0:
+        return port
+    bridge = CrossQueueBridge(delay=args.sim_quantum,
+                              mem_side_eventq_index=0)
+    cu._num_eventq_bridges = getattr(cu, '_num_eventq_bridges', 0) + 1
+    setattr(cu, 'eventq_bridge%d' % cu._num_eventq_bridges, bridge)
+    bridge.mem_side_port = port
+    return bridge.cpu_side_port
+
 # Attach compute units to GPU
 shader.CUs = compute_units
 
@@ -446,7 +480,8 @@ render_driver = GPURenderDriver(filename = f'dri/renderD{renderDriNum}')
 # dispatcher.
 gpu_hsapp = HSAPacketProcessor(pioAddr=hsapp_gpu_map_paddr,
                                numHWQueues=args.num_hw_queues)
-dispatcher = GPUDispatcher()
+dispatcher = GPUDispatcher(kernel_sample_period=args.kernel_sample_period,
+                           kernel_sample_offset=args.kernel_sample_offset)
 gpu_cmd_proc = GPUCommandProcessor(hsapp=gpu_hsapp,
                                    dispatcher=dispatcher)
 gpu_driver.device = gpu_cmd_proc
@@ -552,7 +587,8 @@ if fast_forward:
         fatal("KvmCPU can only be used in SE mode with x86")
 
 # configure the TLB hierarchy
-GPUTLBConfig.config_tlb_hierarchy(args, system, shader_idx)
+GPUTLBConfig.config_tlb_hierarchy(args, system, shader_idx,
+                                  cu_port_peer=cu_port_peer)
 
 # create Ruby system
 system.piobus = IOXBar(width=32, response_latency=0,
@@ -615,25 +651,28 @@ wavefront_size = args.wf_size
 for i in range(n_cu):
     # The pipeline issues wavefront_size number of uncoalesced requests
     # in one GPU issue cycle. Hence wavefront_size mem ports.
+    cu = system.cpu[shader_idx].CUs[i]
     for j in range(wavefront_size):
-        system.cpu[shader_idx].CUs[i].memory_port[j] = \
-                  system.ruby._cpu_ports[gpu_port_idx].in_ports[j]
+        cu.memory_port[j] = cu_port_peer(cu,
+                  system.ruby._cpu_ports[gpu_port_idx].in_ports[j])
     gpu_port_idx += 1
 
 for i in range(n_cu):
     if i > 0 and not i % args.cu_per_sqc:
         print("incrementing idx on ", i)
         gpu_port_idx += 1
-    system.cpu[shader_idx].CUs[i].sqc_port = \
-            system.ruby._cpu_ports[gpu_port_idx].in_ports
+    cu = system.cpu[shader_idx].CUs[i]
+    cu.sqc_port = cu_port_peer(cu,
+            system.ruby._cpu_ports[gpu_port_idx].in_ports)
 gpu_port_idx = gpu_port_idx + 1
 
 for i in range(n_cu):
     if i > 0 and not i % args.cu_per_scalar_cache:
         print("incrementing idx on ", i)
         gpu_port_idx += 1
-    system.cpu[shader_idx].CUs[i].scalar_port = \
-        system.ruby._cpu_ports[gpu_port_idx].in_ports
+    cu = system.cpu[shader_idx].CUs[i]
+    cu.scalar_port = cu_port_peer(cu,
+        system.ruby._cpu_ports[gpu_port_idx].in_ports)
 gpu_port_idx = gpu_port_idx + 1
 
 # attach CP ports to Ruby
@@ -694,6 +733,10 @@ else:
     hsaTopology.createCarrizoTopology(args)
 
 m5.ticks.setGlobalFrequency('1THz')
+if args.cu_eventq_groups > 1:
+    m5.ticks.fixGlobalFrequency()
+    root.sim_quantum = m5.ticks.fromSeconds(
+        m5.util.convert.anyToLatency(args.sim_quantum))
 if args.abs_max_tick:
     maxtick = args.abs_max_tick
 else:
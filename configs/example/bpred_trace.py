@@ -0,0 +1,63 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+# Replay a branch trace into one or more branch predictors without
+# simulating a CPU. Each branch of the trace is predicted, corrected and
+# committed by every selected predictor, and the mispredictions per
+# thousand instructions and the replay throughput are reported in the
+# driver stats (mispredicts, mpki and hostBranchRate).
+# ASCII traces can be converted with util/encode_branch_trace.py.
+#
+# Example:
+#   build/X86/gem5.opt configs/example/bpred_trace.py \
+#       --predictors LTAGE,TAGE_SC_L_64KB,MultiperspectivePerceptron64KB \
+#       branches.trc.gz
+
+import argparse
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+parser.add_argument("trace", help="Branch trace in protobuf format")
+parser.add_argument("--predictors", default="LTAGE",
+                    help="Comma-separated list of branch predictor classes")
+parser.add_argument("--max-branches", type=int, default=0,
+                    help="Stop after this many branches (0 for all)")
+
+args = parser.parse_args()
+
+names = args.predictors.split(",")
+root = Root(full_system=False)
+root.driver = BranchTraceDriver(
+    trace_file=args.trace,
+    predictors=[getattr(m5.objects, name)() for name in names],
+    max_branches=args.max_branches)
+
+m5.instantiate()
+exit_event = m5.simulate()
+print("Exiting: %s" % exit_event.getCause())
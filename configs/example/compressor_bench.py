@@ -0,0 +1,97 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Evaluate cache compressors offline over a raw memory dump, without
+# simulating a system. Every line of the dump is compressed by each of
+# the selected compressors, and the resulting size distribution and
+# compression throughput are reported. The regular compressor stats are
+# also updated, so they can be dumped alongside the summary.
+#
+# Example:
+#   build/X86/gem5.opt configs/example/compressor_bench.py \
+#       --compressors BDI,CPack,FPC mem.dump
+
+import argparse
+import time
+
+import m5
+from m5.util import fatal
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+parser.add_argument("dump", help="Raw memory dump to compress")
+parser.add_argument("--compressors", default="BDI",
+                    help="Comma-separated list of compressor classes")
+parser.add_argument("--block-size", type=int, default=64,
+                    help="Cache line size in bytes")
+parser.add_argument("--hist", action="store_true",
+                    help="Print the compressed size distribution")
+
+args = parser.parse_args()
+
+root = Root(full_system=False)
+compressors = []
+for name in args.compressors.split(","):
+    compressor = getattr(m5.objects, name)()
+    setattr(root, name.lower(), compressor)
+    compressors.append((name, compressor))
+
+# The compressors normally inherit the line size from their cache
+for _, compressor in compressors:
+    for obj in compressor.descendants():
+        if not isinstance(obj, BaseCacheCompressor):
+            continue
+        obj.block_size = args.block_size
+        if isinstance(obj, BaseDictionaryCompressor):
+            obj.dictionary_size = args.block_size
+
+m5.instantiate()
+
+line_bits = args.block_size * 8
+print("%-16s %12s %14s %10s %10s" % ("compressor", "lines",
+    "avg_size_bits", "ratio", "MB/s"))
+for name, compressor in compressors:
+    start = time.perf_counter()
+    hist = compressor.getCCObject().compressDump(args.dump)
+    elapsed = time.perf_counter() - start
+
+    lines = sum(hist.values())
+    if lines == 0:
+        fatal("Memory dump %s has no complete lines." % args.dump)
+    total_bits = sum(size * count for size, count in hist.items())
+    avg_bits = total_bits / lines
+    ratio = line_bits / avg_bits if avg_bits else float("inf")
+    mbps = (lines * args.block_size) / (elapsed * 1e6) if elapsed else 0
+    print("%-16s %12d %14.2f %10.2f %10.2f" % (name, lines, avg_bits,
+        ratio, mbps))
+
+    if args.hist:
+        for size, count in sorted(hist.items()):
+            print("    %6d bits: %d" % (size, count))
+
+m5.stats.dump()
@@ -0,0 +1,90 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+# Time drain cycles, as done on every CPU switch and checkpoint, on a
+# synthetic configuration of a given size, to track how the switch cost
+# scales with the number of SimObjects. Each cycle drains the system,
+# writes back and invalidates the memory system, and resumes.
+#
+# Example:
+#   for n in 1000 2000 4000 8000; do
+#       build/NULL/gem5.opt configs/example/drain_bench.py \
+#           --num-objects $n
+#   done
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+parser.add_argument("--num-objects", type=int, default=1000,
+                    help="Approximate number of SimObjects to create")
+parser.add_argument("--cycles", type=int, default=100,
+                    help="Number of drain cycles to time")
+parser.add_argument("--interval", type=int, default=1000,
+                    help="Ticks simulated between two drain cycles")
+
+args = parser.parse_args()
+
+root = Root(full_system=False)
+root.clk_domain = SrcClockDomain(clock="1GHz",
+                                 voltage_domain=VoltageDomain())
+root.subsystems = [SubSystem(clk_domain=DerivedClockDomain(
+                       clk_domain=Parent.clk_domain, clk_divider=2))
+                   for i in range(max(1, args.num_objects // 2))]
+
+m5.instantiate()
+num_objects = len(list(root.descendants()))
+
+drain_s = 0.0
+flush_s = 0.0
+resume_s = 0.0
+m5.simulate(args.interval)
+for i in range(args.cycles):
+    start = time.perf_counter()
+    m5.drain()
+    drained = time.perf_counter()
+    m5.memWriteback(root)
+    m5.memInvalidate(root)
+    flushed = time.perf_counter()
+    # Resuming is part of the next simulate() call
+    m5.simulate(args.interval)
+    resumed = time.perf_counter()
+
+    drain_s += drained - start
+    flush_s += flushed - drained
+    resume_s += resumed - flushed
+
+print("%-12s %12s %12s %12s" % ("objects", "drain_ms", "flush_ms",
+    "resume_ms"))
+print("%-12d %12.3f %12.3f %12.3f" % (num_objects,
+    1e3 * drain_s / args.cycles, 1e3 * flush_s / args.cycles,
+    1e3 * resume_s / args.cycles))
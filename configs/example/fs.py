@@ -173,8 +173,8 @@ def build_test_system(np):
 
         # Sanity check
         if args.simpoint_profile:
-            if not ObjectList.is_noncaching_cpu(TestCPUClass):
-                fatal("SimPoint generation should be done with atomic cpu")
+            if ObjectList.is_kvm_cpu(TestCPUClass):
+                fatal("SimPoint generation can't be done with a KVM cpu")
             if np > 1:
                 fatal("SimPoint generation not supported with more than one CPUs")
 
@@ -338,7 +338,8 @@ elif len(bm) == 1 and args.dist:
                         args.dist_sync_start,
                         args.ethernet_linkspeed,
                         args.ethernet_linkdelay,
-                        args.etherdump);
+                        args.etherdump,
+                        args.dist_transport);
 elif len(bm) == 1:
     root = Root(full_system=True, system=test_sys)
 else:
@@ -0,0 +1,81 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+# Time the instantiation of a synthetic configuration of a given size, to
+# track how the startup cost scales with the number of SimObjects. Each
+# subsystem holds a derived clock domain whose parent domain is found
+# through a proxy, plus a chain of nested subsystems, so both the proxy
+# resolution and the walks over the hierarchy are exercised.
+#
+# Example:
+#   for n in 1000 2000 4000 8000; do
+#       build/NULL/gem5.opt configs/example/instantiate_bench.py \
+#           --num-objects $n
+#   done
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+parser.add_argument("--num-objects", type=int, default=1000,
+                    help="Approximate number of SimObjects to create")
+parser.add_argument("--depth", type=int, default=4,
+                    help="Nesting depth of each subsystem")
+
+args = parser.parse_args()
+
+start = time.perf_counter()
+
+root = Root(full_system=False)
+root.clk_domain = SrcClockDomain(clock="1GHz",
+                                 voltage_domain=VoltageDomain())
+
+subsystems = []
+for i in range(max(1, args.num_objects // (2 * args.depth))):
+    top = sub = SubSystem()
+    for level in range(args.depth):
+        sub.clk_domain = DerivedClockDomain(clk_domain=Parent.clk_domain,
+                                            clk_divider=2)
+        if level + 1 < args.depth:
+            sub.inner = SubSystem()
+            sub = sub.inner
+    subsystems.append(top)
+root.subsystems = subsystems
+
+configured = time.perf_counter()
+m5.instantiate()
+instantiated = time.perf_counter()
+
+num_objects = len(list(root.descendants()))
+print("%-12s %12s %12s" % ("objects", "config_s", "instantiate_s"))
+print("%-12d %12.3f %12.3f" % (num_objects, configured - start,
+    instantiated - configured))
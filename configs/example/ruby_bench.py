@@ -0,0 +1,172 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+# Measure the host cost of the compiled Ruby protocol, to compare the
+# protocols with each other and track their regressions. The selected
+# workload drives every CPU port of the Ruby system, and the number of
+# transactions completed per host second, the peak host memory and the
+# number of events serviced per transaction are reported.
+#
+# The workloads are:
+#   tester  RubyTester checks, each of which is one transaction
+#   tgen    random PyTrafficGen requests, one per transaction
+#   garnet  GarnetSyntheticTraffic packets, one per transaction. This
+#           needs the Garnet_standalone protocol and --network=garnet.
+#
+# Example:
+#   for p in MESI_Two_Level MESI_Three_Level MOESI_CMP_directory CHI \
+#           MOESI_hammer; do
+#       for n in 4 8 16 32 64 128; do
+#           build/$p/gem5.opt configs/example/ruby_bench.py \
+#               --workload tgen --num-cpus $n --num-dirs 4
+#       done
+#   done
+
+import argparse
+import resource
+import time
+
+import m5
+from m5.defines import buildEnv
+from m5.objects import *
+from m5.util import addToPath, fatal
+
+addToPath('../')
+
+from common import Options
+from ruby import Ruby
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+Options.addNoISAOptions(parser)
+
+parser.add_argument("--workload", default="tester",
+                    choices=["tester", "tgen", "garnet"],
+                    help="Traffic driving the Ruby system")
+parser.add_argument("--checks", type=int, default=10000,
+                    help="Number of RubyTester checks to complete")
+parser.add_argument("--duration", type=int, default=1000000,
+                    help="Ticks of traffic for the tgen and garnet "
+                    "workloads")
+parser.add_argument("--period", type=int, default=10,
+                    help="Ticks between two tgen requests of a CPU")
+parser.add_argument("--read-percent", type=int, default=70,
+                    help="Percentage of the tgen requests that are reads")
+parser.add_argument("--injectionrate", type=float, default=0.1,
+                    help="Garnet packets injected per cycle per node")
+
+Ruby.define_options(parser)
+
+args = parser.parse_args()
+
+if args.workload == "garnet" and \
+        buildEnv['PROTOCOL'] != 'Garnet_standalone':
+    fatal("The garnet workload needs the Garnet_standalone protocol.")
+
+block_size = 64
+
+if args.workload == "tester":
+    cpus = [RubyTester(check_flush=(buildEnv['PROTOCOL'] == 'MOESI_hammer'),
+                       checks_to_complete=args.checks)]
+    cpu_list = cpus * args.num_cpus
+elif args.workload == "tgen":
+    cpus = [PyTrafficGen() for i in range(args.num_cpus)]
+    cpu_list = cpus
+else:
+    cpus = [GarnetSyntheticTraffic(sim_cycles=args.duration,
+                                   inj_rate=args.injectionrate,
+                                   num_dest=args.num_dirs)
+            for i in range(args.num_cpus)]
+    cpu_list = cpus
+
+system = System(cpu=cpus, mem_ranges=[AddrRange(args.mem_size)])
+system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
+system.clk_domain = SrcClockDomain(clock=args.sys_clock,
+                                   voltage_domain=system.voltage_domain)
+
+Ruby.create_system(args, False, system, cpus=cpu_list)
+
+system.ruby.clk_domain = SrcClockDomain(clock=args.ruby_clock,
+                                        voltage_domain=system.voltage_domain)
+
+if args.workload == "tester":
+    tester = cpus[0]
+    tester.num_cpus = len(system.ruby._cpu_ports)
+    for ruby_port in system.ruby._cpu_ports:
+        if ruby_port.support_data_reqs and ruby_port.support_inst_reqs:
+            tester.cpuInstDataPort = ruby_port.in_ports
+        elif ruby_port.support_data_reqs:
+            tester.cpuDataPort = ruby_port.in_ports
+        elif ruby_port.support_inst_reqs:
+            tester.cpuInstPort = ruby_port.in_ports
+        ruby_port.no_retry_on_stall = True
+        ruby_port.using_ruby_tester = True
+else:
+    for cpu, ruby_port in zip(cpus, system.ruby._cpu_ports):
+        if args.workload == "tgen":
+            cpu.port = ruby_port.in_ports
+        else:
+            cpu.test = ruby_port.in_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = 'timing'
+
+m5.instantiate()
+
+if args.workload == "tgen":
+    mem_size = system.mem_ranges[0].size()
+    for tgen in cpus:
+        def traffic(tgen=tgen):
+            yield tgen.createRandom(args.duration, 0, mem_size - 1,
+                                    block_size, args.period, args.period,
+                                    args.read_percent, 0)
+            yield tgen.createExit(0)
+        tgen.start(traffic())
+
+start = time.perf_counter()
+exit_event = m5.simulate(args.abs_max_tick)
+host_s = time.perf_counter() - start
+
+if args.workload == "tester":
+    if exit_event.getCause() != "Ruby Tester completed":
+        fatal("RubyTester did not complete: %s" % exit_event.getCause())
+    transactions = args.checks
+else:
+    transactions = sum(cpu.resolveStat("numPackets").value for cpu in cpus)
+
+if transactions == 0:
+    fatal("No transaction was completed.")
+
+events = root.resolveStat("hostEvents").value
+# ru_maxrss is reported in kilobytes on Linux
+peak_rss_mb = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024.0
+
+print("%-20s %8s %8s %12s %12s %12s %12s" % ("protocol", "workload",
+    "cpus", "transactions", "trans/s", "peak_rss_MB", "events/trans"))
+print("%-20s %8s %8d %12d %12.0f %12.1f %12.2f" % (buildEnv['PROTOCOL'],
+    args.workload, args.num_cpus, transactions, transactions / host_s,
+    peak_rss_mb, events / transactions))
@@ -192,6 +192,9 @@ system.cpu_clk_domain = SrcClockDomain(clock = args.cpu_clock,
 if args.elastic_trace_en:
     CpuConfig.config_etrace(CPUClass, system.cpu, args)
 
+if args.pipe_trace_file:
+    CpuConfig.config_pipe_trace(CPUClass, system.cpu, args)
+
 # All cpus belong to a common cpu_clk_domain, therefore running at a common
 # frequency.
 for cpu in system.cpu:
@@ -209,8 +212,8 @@ if ObjectList.is_kvm_cpu(CPUClass) or ObjectList.is_kvm_cpu(FutureClass):
 
 # Sanity check
 if args.simpoint_profile:
-    if not ObjectList.is_noncaching_cpu(CPUClass):
-        fatal("SimPoint/BPProbe should be done with an atomic cpu")
+    if ObjectList.is_kvm_cpu(CPUClass):
+        fatal("SimPoint/BPProbe can't be done with a KVM cpu")
     if np > 1:
         fatal("SimPoint generation not supported with more than one CPUs")
 
@@ -265,8 +268,23 @@ else:
 
 system.workload = SEWorkload.init_compatible(mp0_path)
 
+if args.parallel_eventqs:
+    if args.ruby or args.caches or args.l2cache or \
+       test_mem_mode != 'atomic':
+        fatal("--parallel-eventqs requires atomic CPUs without caches")
+    # The CPUs and their children (TLBs, interrupt controllers, ...)
+    # move to their own event queues, the memory system and the
+    # workload stay on the first one.
+    for i, cpu in enumerate(system.cpu):
+        cpu.eventq_index = i + 1
+
 if args.wait_gdb:
     system.workload.wait_for_remote_gdb = True
 
 root = Root(full_system = False, system = system)
+if args.parallel_eventqs:
+    # converting to ticks needs the tick frequency to be fixed
+    m5.ticks.fixGlobalFrequency()
+    root.sim_quantum = m5.ticks.fromSeconds(
+        m5.util.convert.anyToLatency(args.sim_quantum))
 Simulation.run(args, root, system, FutureClass)
@@ -42,8 +42,9 @@ def define_options(parser):
         help="the number of rows in the mesh topology")
     parser.add_argument(
         "--network", default="simple",
-        choices=['simple', 'garnet'],
-        help="""'simple'|'garnet' (garnet2.0 will be deprecated.)""")
+        choices=['simple', 'garnet', 'analytical'],
+        help="""'simple'|'garnet'|'analytical'
+            (garnet2.0 will be deprecated.)""")
     parser.add_argument(
         "--router-latency", action="store", type=int,
         default=1,
@@ -103,6 +104,13 @@ def create_network(options, ruby):
         RouterClass = GarnetRouter
         InterfaceClass = GarnetNetworkInterface
 
+    elif options.network == "analytical":
+        NetworkClass = AnalyticalNetwork
+        IntLinkClass = BasicIntLink
+        ExtLinkClass = BasicExtLink
+        RouterClass = BasicRouter
+        InterfaceClass = None
+
     else:
         NetworkClass = SimpleNetwork
         IntLinkClass = SimpleIntLink
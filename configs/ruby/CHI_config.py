@@ -209,7 +209,8 @@ class CHI_L1Controller(CHI_Cache_Controller):
         super(CHI_L1Controller, self).__init__(ruby_system)
         self.sequencer = sequencer
         self.cache = cache
-        self.use_prefetcher = False
+        self.prefetcher = prefetcher
+        self.use_prefetcher = prefetcher != NULL
         self.send_evictions = True
         self.is_HN = False
         self.enable_DMT = False
@@ -244,7 +245,8 @@ class CHI_L2Controller(CHI_Cache_Controller):
         super(CHI_L2Controller, self).__init__(ruby_system)
         self.sequencer = NULL
         self.cache = cache
-        self.use_prefetcher = False
+        self.prefetcher = prefetcher
+        self.use_prefetcher = prefetcher != NULL
         self.allow_SD = True
         self.is_HN = False
         self.enable_DMT = False
@@ -278,7 +280,8 @@ class CHI_HNFController(CHI_Cache_Controller):
         super(CHI_HNFController, self).__init__(ruby_system)
         self.sequencer = NULL
         self.cache = cache
-        self.use_prefetcher = False
+        self.prefetcher = prefetcher
+        self.use_prefetcher = prefetcher != NULL
         self.addr_ranges = addr_ranges
         self.allow_SD = True
         self.is_HN = True
@@ -348,6 +351,7 @@ class CHI_DMAController(CHI_Cache_Controller):
             tagAccessLatency = 1
             size = "128"
             assoc = 1
+        self.prefetcher = NULL
         self.use_prefetcher = False
         self.cache = DummyCache()
         self.sequencer.dcache = NULL
@@ -452,11 +456,13 @@ class CHI_RNF(CHI_Node):
             l1d_cache = l1Dcache_type(start_index_bit = self._block_size_bits,
                                       is_icache = False)
 
-            # Placeholders for future prefetcher support
-            if l1Iprefetcher_type != None or l1Dprefetcher_type != None:
-                m5.fatal('Prefetching not supported yet')
+            # prefetchers
             l1i_pf = NULL
+            if l1Iprefetcher_type != None:
+                l1i_pf = l1Iprefetcher_type()
             l1d_pf = NULL
+            if l1Dprefetcher_type != None:
+                l1d_pf = l1Dprefetcher_type()
 
             # cache controllers
             cpu.l1i = CHI_L1Controller(ruby_system, cpu.inst_sequencer,
@@ -498,9 +504,9 @@ class CHI_RNF(CHI_Node):
         for cpu in self._cpus:
             l2_cache = cache_type(start_index_bit = self._block_size_bits,
                                   is_icache = False)
-            if pf_type != None:
-                m5.fatal('Prefetching not supported yet')
             l2_pf = NULL
+            if pf_type != None:
+                l2_pf = pf_type()
 
             cpu.l2 = CHI_L2Controller(self._ruby_system, l2_cache, l2_pf)
 
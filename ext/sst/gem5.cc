@@ -255,6 +255,9 @@ gem5Component::clockTick(SST::Cycle_t currentCycle)
     // what to do in a SST's cycle
     gem5::GlobalSimLoopExitEvent *event = simulateGem5(currentCycle);
     clocksProcessed++;
+    // hand the requests gem5 made during this cycle over to SST
+    systemPort->sendRequestBatch();
+    cachePort->sendRequestBatch();
     // gem5 exits due to reasons other than reaching simulation limit
     if (event != gem5::simulate_limit_event) {
         output.output("exiting: curTick()=%lu cause=`%s` code=%d\n",
@@ -97,6 +97,18 @@ SSTResponderSubComponent::handleTimingReq(
     return true;
 }
 
+void
+SSTResponderSubComponent::sendRequestBatch()
+{
+    responseReceiver->takeRequestBatch(requestBatch);
+    for (auto pkt: requestBatch) {
+        memoryInterface->sendRequest(
+            Translator::gem5RequestToSSTRequest(pkt, sstRequestIdToPacketMap)
+        );
+    }
+    requestBatch.clear();
+}
+
 void
 SSTResponderSubComponent::init(unsigned phase)
 {
@@ -64,6 +64,9 @@ class SSTResponderSubComponent: public SST::SubComponent
     SST::Output* output;
     std::queue<gem5::PacketPtr> responseQueue;
 
+    // The requests taken from the bridge at the end of the last SST clock.
+    std::vector<gem5::PacketPtr> requestBatch;
+
     std::vector<SST::Interfaces::SimpleMem::Request*> initRequests;
 
     std::string gem5SimObjectName;
@@ -87,6 +90,8 @@ class SSTResponderSubComponent: public SST::SubComponent
     bool findCorrespondingSimObject(gem5::Root* gem5_root);
 
     bool handleTimingReq(SST::Interfaces::SimpleMem::Request* request);
+    // Forward the requests gem5 has batched up since the last call.
+    void sendRequestBatch();
     void handleRecvRespRetry();
     void handleRecvFunctional(gem5::PacketPtr pkt);
     void handleSwapReqResponse(SST::Interfaces::SimpleMem::Request* request);
@@ -75,6 +75,7 @@
 
 #define M5OP_WORK_BEGIN         0x5a
 #define M5OP_WORK_END           0x5b
+#define M5OP_RING_DRAIN         0x5c
 
 #define M5OP_DIST_TOGGLE_SYNC   0x62
 
@@ -106,6 +107,7 @@
     M5OP(m5_panic, M5OP_PANIC)                                  \
     M5OP(m5_work_begin, M5OP_WORK_BEGIN)                        \
     M5OP(m5_work_end, M5OP_WORK_END)                            \
+    M5OP(m5_ring_drain, M5OP_RING_DRAIN)                        \
     M5OP(m5_dist_toggle_sync, M5OP_DIST_TOGGLE_SYNC)            \
     M5OP(m5_workload, M5OP_WORKLOAD)                            \
 
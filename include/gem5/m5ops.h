@@ -66,6 +66,8 @@ void m5_load_symbol();
 void m5_panic(void);
 void m5_work_begin(uint64_t workid, uint64_t threadid);
 void m5_work_end(uint64_t workid, uint64_t threadid);
+// Process the ops queued in the shared ring, see gem5/m5ring.h.
+void m5_ring_drain(void);
 
 /*
  * Send a very generic poke to the workload so it can do something. It's up to
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __GEM5_M5RING_H__
+#define __GEM5_M5RING_H__
+
+/*
+ * Layout of the ring of deferred m5 ops shared between a guest and gem5.
+ *
+ * The guest reserves entries by atomically incrementing head, fills them
+ * in, and publishes each one by storing its index plus one into seq last.
+ * gem5 consumes the published entries in order whenever a CPU leaves KVM
+ * or M5OP_RING_DRAIN is executed, and advances tail past them. The guest
+ * must not reuse an entry until tail has moved past it.
+ */
+
+#include <stdint.h>
+
+#define M5_RING_SIZE 0x1000
+
+struct m5_ring_entry
+{
+    uint64_t seq;
+    uint32_t func;
+    uint32_t cpu;
+    uint64_t args[2];
+};
+
+struct m5_ring_header
+{
+    uint64_t head;
+    uint64_t tail;
+    uint64_t reserved[6];
+};
+
+#define M5_RING_ENTRIES ((M5_RING_SIZE - sizeof(struct m5_ring_header)) / \
+                         sizeof(struct m5_ring_entry))
+
+#endif // __GEM5_M5RING_H__
@@ -163,9 +163,15 @@ namespace VegaISA
                 assert(vrfData[0]);
                 auto vgpr = vecReg.template as<DataType>();
                 auto reg_file_vgpr = vrfData[0]->template as<VecElemU32>();
-                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                    std::memcpy((void*)&vgpr[lane],
-                        (void*)&reg_file_vgpr[lane], sizeof(DataType));
+                if (sizeof(DataType) == sizeof(VecElemU32)) {
+                    // same layout as the register file, copy it in one go
+                    std::memcpy((void*)vgpr, (void*)reg_file_vgpr,
+                        sizeof(VecElemU32) * NumVecElemPerVecReg);
+                } else {
+                    for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                        std::memcpy((void*)&vgpr[lane],
+                            (void*)&reg_file_vgpr[lane], sizeof(DataType));
+                    }
                 }
             } else if (NumDwords == 2) {
                 assert(vrfData[0]);
@@ -204,6 +210,10 @@ namespace VegaISA
             ComputeUnit *cu = _gpuDynInst->computeUnit();
             VectorMask &exec_mask = _gpuDynInst->isLoad()
                 ? _gpuDynInst->exec_mask : wf->execMask();
+            // decided once here rather than for every lane, so that the
+            // common case of a full wavefront is a plain copy
+            const bool all_lanes = _gpuDynInst->ignoreExec() ||
+                exec_mask.all();
 
             if (NumDwords == 1) {
                 int vgprIdx = cu->registerManager->mapVgpr(wf, _opIdx);
@@ -212,10 +222,15 @@ namespace VegaISA
                 auto reg_file_vgpr = vrfData[0]->template as<VecElemU32>();
                 auto vgpr = vecReg.template as<DataType>();
 
-                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                    if (exec_mask[lane] || _gpuDynInst->ignoreExec()) {
-                        std::memcpy((void*)&reg_file_vgpr[lane],
-                            (void*)&vgpr[lane], sizeof(DataType));
+                if (all_lanes && sizeof(DataType) == sizeof(VecElemU32)) {
+                    std::memcpy((void*)reg_file_vgpr, (void*)vgpr,
+                        sizeof(VecElemU32) * NumVecElemPerVecReg);
+                } else {
+                    for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                        if (all_lanes || exec_mask[lane]) {
+                            std::memcpy((void*)&reg_file_vgpr[lane],
+                                (void*)&vgpr[lane], sizeof(DataType));
+                        }
                     }
                 }
 
@@ -233,7 +248,7 @@ namespace VegaISA
                 auto vgpr = vecReg.template as<VecElemU64>();
 
                 for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                    if (exec_mask[lane] || _gpuDynInst->ignoreExec()) {
+                    if (all_lanes || exec_mask[lane]) {
                         reg_file_vgpr0[lane] = ((VecElemU32*)&vgpr[lane])[0];
                         reg_file_vgpr1[lane] = ((VecElemU32*)&vgpr[lane])[1];
                     }
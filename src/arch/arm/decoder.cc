@@ -52,7 +52,7 @@ namespace gem5
 namespace ArmISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
+GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 1> Decoder::defaultCache;
 
 Decoder::Decoder(const ArmDecoderParams &params)
     : InstDecoder(params, &data),
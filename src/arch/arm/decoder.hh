@@ -87,8 +87,8 @@ class Decoder : public InstDecoder
     enums::DecoderFlavor decoderFlavor;
 
     /// A cache of decoded instruction objects.
-    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
-    friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
+    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 1> defaultCache;
+    friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 1>;
 
     /**
      * Pre-decode an instruction from the current state of the
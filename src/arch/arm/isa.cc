@@ -154,6 +154,7 @@ ISA::clear()
 
     SCTLR sctlr_rst = miscRegs[MISCREG_SCTLR_RST];
     memset(miscRegs, 0, sizeof(miscRegs));
+    elStateCacheValid = 0;
 
     initID32(p);
 
@@ -1094,6 +1095,19 @@ ISA::setMiscRegNoEffect(int misc_reg, RegVal val)
     const auto &map = getMiscIndices(misc_reg);
     int lower = map.first, upper = map.second;
 
+    switch (misc_reg) {
+      case MISCREG_CPSR:
+      case MISCREG_SCR:
+      case MISCREG_SCR_EL3:
+      case MISCREG_HCR:
+      case MISCREG_HCR2:
+      case MISCREG_HCR_EL2:
+        elStateCacheValid = 0;
+        break;
+      default:
+        break;
+    }
+
     auto v = (val & ~reg.wi()) | reg.rao();
     if (upper > 0) {
         miscRegs[lower] = bits(v, 31, 0);
@@ -2127,6 +2141,7 @@ ISA::unserialize(CheckpointIn &cp)
 {
     DPRINTF(Checkpoint, "Unserializing Arm Misc Registers\n");
     UNSERIALIZE_MAPPING(miscRegs, miscRegName, NUM_PHYS_MISCREGS);
+    elStateCacheValid = 0;
     CPSR tmp_cpsr = miscRegs[MISCREG_CPSR];
     updateRegMap(tmp_cpsr);
 }
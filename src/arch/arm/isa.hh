@@ -41,6 +41,9 @@
 #ifndef __ARCH_ARM_ISA_HH__
 #define __ARCH_ARM_ISA_HH__
 
+#include <array>
+#include <utility>
+
 #include "arch/arm/isa_device.hh"
 #include "arch/arm/mmu.hh"
 #include "arch/arm/pcstate.hh"
@@ -569,6 +572,21 @@ namespace ArmISA
         RegVal miscRegs[NUM_MISCREGS];
         const RegId *intRegMap;
 
+        /**
+         * Decoded view of the execution state of each EL, as computed by
+         * ELStateUsingAArch32K, indexed by security state and EL. It only
+         * depends on SCR_EL3, HCR_EL2 and CPSR besides the fixed system
+         * configuration, so it is flushed whenever one of those is written.
+         */
+        std::array<std::pair<bool, bool>, 8> elStateCache;
+        uint8_t elStateCacheValid = 0;
+
+        static unsigned
+        elStateCacheIdx(ExceptionLevel el, bool secure)
+        {
+            return (secure ? 4 : 0) + el;
+        }
+
         void
         updateRegMap(CPSR cpsr)
         {
@@ -899,6 +917,27 @@ namespace ArmISA
          */
         ExceptionLevel currEL() const;
 
+        /** Look up a cached result of ELStateUsingAArch32K. */
+        bool
+        lookupELState(ExceptionLevel el, bool secure,
+                      std::pair<bool, bool> &state) const
+        {
+            const unsigned idx = elStateCacheIdx(el, secure);
+            if (!(elStateCacheValid & (1 << idx)))
+                return false;
+            state = elStateCache[idx];
+            return true;
+        }
+
+        void
+        cacheELState(ExceptionLevel el, bool secure,
+                     const std::pair<bool, bool> &state)
+        {
+            const unsigned idx = elStateCacheIdx(el, secure);
+            elStateCache[idx] = state;
+            elStateCacheValid |= 1 << idx;
+        }
+
         unsigned getCurSveVecLenInBits() const;
 
         unsigned getCurSveVecLenInBitsAtReset() const { return sveVL * 128; }
@@ -1182,12 +1182,14 @@ MMU::updateMiscReg(ThreadContext *tc,
     // one type of translation anyway
 
     auto& state = stage2 ? s2State : s1State;
+    bool refreshed = false;
     if (state.miscRegValid && miscRegContext == tc->contextId() &&
         ((tran_type == state.curTranType) || stage2)) {
 
     } else {
         DPRINTF(TLBVerbose, "TLB variables changed!\n");
         state.updateMiscReg(tc, tran_type);
+        refreshed = true;
 
         itbStage2->setVMID(state.vmid);
         dtbStage2->setVMID(state.vmid);
@@ -1206,7 +1208,12 @@ MMU::updateMiscReg(ThreadContext *tc,
     }
 
     if (state.directToStage2) {
-        s2State.updateMiscReg(tc, tran_type);
+        // The stage 2 state is derived from the same registers as the
+        // stage 1 one, so it only needs refreshing along with it.
+        if (refreshed || !s2State.miscRegValid ||
+                s2State.curTranType != tran_type) {
+            s2State.updateMiscReg(tc, tran_type);
+        }
         return s2State;
     } else {
         return state;
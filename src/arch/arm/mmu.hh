@@ -57,7 +57,7 @@ namespace ArmISA {
 
 class TableWalker;
 
-class MMU : public BaseMMU
+class MMU final : public BaseMMU
 {
   protected:
     using LookupLevel = enums::ArmLookupLevel;
@@ -463,6 +463,15 @@ TableWalker::walk(const RequestPtr &_req, ThreadContext *_tc, uint16_t _asid,
     }
 
     if (pending || pendingQueue.size()) {
+        if (WalkerState *leader = findCoalescableWalk(currState)) {
+            DPRINTF(PageTableWalker, "Coalescing walk for %#x with the "
+                    "walk for %#x\n", currState->vaddr_tainted,
+                    leader->vaddr_tainted);
+            leader->coalesced.push_back(currState);
+            stats.walksCoalesced++;
+            currState = NULL;
+            return NoFault;
+        }
         pendingQueue.push_back(currState);
         currState = NULL;
         pendingChange();
@@ -2045,6 +2054,7 @@ TableWalker::doL1DescriptorWrapper()
                                       currState->tc, currState->mode);
         stats.walksShortTerminatedAtLevel[0]++;
 
+        releaseCoalesced(currState);
         pending = false;
         nextWalk(currState->tc);
 
@@ -2065,6 +2075,7 @@ TableWalker::doL1DescriptorWrapper()
 
         stats.walksShortTerminatedAtLevel[0]++;
 
+        releaseCoalesced(currState);
         pending = false;
         nextWalk(currState->tc);
 
@@ -2112,6 +2123,7 @@ TableWalker::doL2DescriptorWrapper()
 
 
     stateQueues[LookupLevel::L2].pop_front();
+    releaseCoalesced(currState);
     pending = false;
     nextWalk(currState->tc);
 
@@ -2171,6 +2183,7 @@ TableWalker::doLongDescriptorWrapper(LookupLevel curr_lookup_level)
         currState->transState->finish(currState->fault, currState->req,
                                       currState->tc, currState->mode);
 
+        releaseCoalesced(currState);
         pending = false;
         nextWalk(currState->tc);
 
@@ -2189,6 +2202,7 @@ TableWalker::doLongDescriptorWrapper(LookupLevel curr_lookup_level)
 
         stats.walksLongTerminatedAtLevel[(unsigned) curr_lookup_level]++;
 
+        releaseCoalesced(currState);
         pending = false;
         nextWalk(currState->tc);
 
@@ -2431,6 +2445,59 @@ TableWalker::toLookupLevel(uint8_t lookup_level_as_int)
 
 /* this method keeps track of the table walker queue's residency, so
  * needs to be called whenever requests start and complete. */
+TableWalker::WalkerState *
+TableWalker::findCoalescableWalk(const WalkerState *state) const
+{
+    for (const auto &queue : stateQueues) {
+        for (WalkerState *walk : queue) {
+            if (walk->tc == state->tc &&
+                ((walk->vaddr ^ state->vaddr) >> PageShift) == 0 &&
+                walk->asid == state->asid && walk->vmid == state->vmid &&
+                walk->isHyp == state->isHyp &&
+                walk->isSecure == state->isSecure &&
+                walk->el == state->el && walk->aarch64 == state->aarch64 &&
+                walk->tranType == state->tranType &&
+                walk->mode == state->mode) {
+                return walk;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void
+TableWalker::releaseCoalesced(WalkerState *leader)
+{
+    if (leader->coalesced.empty())
+        return;
+
+    if (leader->fault != NoFault) {
+        pendingQueue.splice(pendingQueue.begin(), leader->coalesced);
+        pendingChange();
+        return;
+    }
+
+    // A walk started by the retried translations must not be mistaken
+    // for a retry of the leader
+    WalkerState *leader_state = currState;
+    currState = NULL;
+    for (WalkerState *follower : leader->coalesced) {
+        if (follower->transState->squashed()) {
+            follower->transState->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                follower->req, follower->tc, follower->mode);
+        } else {
+            stats.walkServiceTime.sample(curTick() - follower->startTime);
+            mmu->translateTiming(follower->req, follower->tc,
+                follower->transState, follower->mode,
+                follower->tranType, isStage2);
+        }
+        delete follower;
+    }
+    leader->coalesced.clear();
+    currState = leader_state;
+}
+
 void
 TableWalker::pendingChange()
 {
@@ -2589,6 +2656,9 @@ TableWalker::TableWalkerStats::TableWalkerStats(statistics::Group *parent)
              "Table walks squashed before starting"),
     ADD_STAT(squashedAfter, statistics::units::Count::get(),
              "Table walks squashed after completion"),
+    ADD_STAT(walksCoalesced, statistics::units::Count::get(),
+             "Table walks that waited for an in-flight walk to the same "
+             "page"),
     ADD_STAT(walkWaitTime, statistics::units::Tick::get(),
              "Table walker wait (enqueue to first request) latency"),
     ADD_STAT(walkServiceTime, statistics::units::Tick::get(),
@@ -2627,6 +2697,9 @@ TableWalker::TableWalkerStats::TableWalkerStats(statistics::Group *parent)
     squashedAfter
         .flags(statistics::nozero);
 
+    walksCoalesced
+        .flags(statistics::nozero);
+
     walkWaitTime
         .init(16)
         .flags(statistics::pdf | statistics::nozero | statistics::nonan);
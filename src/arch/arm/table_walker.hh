@@ -919,6 +919,9 @@ class TableWalker : public ClockedObject
         /** Page entries walked during service (for stats) */
         unsigned levels;
 
+        /** Walks to the same page waiting for this one to complete */
+        std::list<WalkerState *> coalesced;
+
         void doL1Descriptor();
         void doL2Descriptor();
 
@@ -1068,6 +1071,7 @@ class TableWalker : public ClockedObject
         statistics::Vector walksLongTerminatedAtLevel;
         statistics::Scalar squashedBefore;
         statistics::Scalar squashedAfter;
+        statistics::Scalar walksCoalesced;
         statistics::Histogram walkWaitTime;
         statistics::Histogram walkServiceTime;
         // Essentially "L" of queueing theory
@@ -1175,6 +1179,20 @@ class TableWalker : public ClockedObject
 
     void nextWalk(ThreadContext *tc);
 
+    /**
+     * Find an in-flight timing walk that will fill the TLB with the
+     * translation the new walk is after, so the new walk can wait for
+     * it instead of reading the same descriptors again.
+     */
+    WalkerState *findCoalescableWalk(const WalkerState *state) const;
+
+    /**
+     * Retry the walks that waited for the leader. If the leader
+     * completed they are looked up in the TLB again, otherwise they
+     * are requeued to walk on their own and get their own fault.
+     */
+    void releaseCoalesced(WalkerState *leader);
+
     void pendingChange();
 
     static uint8_t pageSizeNtoStatBin(uint8_t N);
@@ -41,6 +41,7 @@
 
 #include "arch/arm/faults.hh"
 #include "arch/arm/interrupts.hh"
+#include "arch/arm/isa.hh"
 #include "arch/arm/mmu.hh"
 #include "arch/arm/page_size.hh"
 #include "arch/arm/regs/cc.hh"
@@ -72,7 +73,7 @@ sendEvent(ThreadContext *tc)
 bool
 isSecure(ThreadContext *tc)
 {
-    CPSR cpsr = tc->readMiscReg(MISCREG_CPSR);
+    CPSR cpsr = tc->readMiscRegNoEffect(MISCREG_CPSR);
     if (ArmSystem::haveEL(tc, EL3) && !cpsr.width && currEL(tc) == EL3)
         return true;
     if (ArmSystem::haveEL(tc, EL3) && cpsr.width  && cpsr.mode == MODE_MON)
@@ -121,7 +122,7 @@ debugTargetFrom(ThreadContext *tc, bool secure)
 bool
 inAArch64(ThreadContext *tc)
 {
-    CPSR cpsr = tc->readMiscReg(MISCREG_CPSR);
+    CPSR cpsr = tc->readMiscRegNoEffect(MISCREG_CPSR);
     return opModeIs64((OperatingMode) (uint8_t) cpsr.mode);
 }
 
@@ -315,8 +316,11 @@ haveAArch32EL(ThreadContext *tc, ExceptionLevel el)
     return true;
 }
 
+namespace
+{
+
 std::pair<bool, bool>
-ELStateUsingAArch32K(ThreadContext *tc, ExceptionLevel el, bool secure)
+computeELStateUsingAArch32K(ThreadContext *tc, ExceptionLevel el, bool secure)
 {
     // Return true if the specified EL is in aarch32 state.
     const bool have_el3 = ArmSystem::haveEL(tc, EL3);
@@ -354,7 +358,7 @@ ELStateUsingAArch32K(ThreadContext *tc, ExceptionLevel el, bool secure)
         // Only know if EL0 using AArch32 from PSTATE
         if (el == EL0 && !aarch32_at_el1) {
             // EL0 controlled by PSTATE
-            CPSR cpsr = tc->readMiscReg(MISCREG_CPSR);
+            CPSR cpsr = tc->readMiscRegNoEffect(MISCREG_CPSR);
             known = (currEL(tc) == EL0);
             aarch32 = (cpsr.width == 1);
         } else {
@@ -367,6 +371,21 @@ ELStateUsingAArch32K(ThreadContext *tc, ExceptionLevel el, bool secure)
     return std::make_pair(known, aarch32);
 }
 
+} // anonymous namespace
+
+std::pair<bool, bool>
+ELStateUsingAArch32K(ThreadContext *tc, ExceptionLevel el, bool secure)
+{
+    auto *isa = static_cast<ISA *>(tc->getIsaPtr());
+
+    std::pair<bool, bool> state;
+    if (!isa->lookupELState(el, secure, state)) {
+        state = computeELStateUsingAArch32K(tc, el, secure);
+        isa->cacheELState(el, secure, state);
+    }
+    return state;
+}
+
 bool
 ELStateUsingAArch32(ThreadContext *tc, ExceptionLevel el, bool secure)
 {
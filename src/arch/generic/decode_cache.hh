@@ -29,6 +29,7 @@
 #ifndef __ARCH_GENERIC_DECODE_CACHE_HH__
 #define __ARCH_GENERIC_DECODE_CACHE_HH__
 
+#include "base/compiler.hh"
 #include "base/types.hh"
 #include "cpu/decode_cache.hh"
 #include "cpu/static_inst_fwd.hh"
@@ -39,7 +40,13 @@ namespace gem5
 namespace GenericISA
 {
 
-template <typename Decoder, typename EMI>
+/**
+ * Decode cache shared by the ISAs with fixed size machine instructions.
+ * Decoded instructions are first looked up by address, in a dense per
+ * page array with one slot per instruction aligned to 1 << InstShift
+ * bytes, and then by machine instruction.
+ */
+template <typename Decoder, typename EMI, Addr InstShift = 0>
 class BasicDecodeCache
 {
   private:
@@ -49,7 +56,7 @@ class BasicDecodeCache
         StaticInstPtr inst;
         EMI machInst;
     };
-    decode_cache::AddrMap<AddrMapEntry> decodePages;
+    decode_cache::AddrMap<AddrMapEntry, 12, InstShift> decodePages;
 
   public:
     /// Decode a machine instruction.
@@ -59,7 +66,7 @@ class BasicDecodeCache
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
         auto &entry = decodePages.lookup(addr);
-        if (entry.inst && (entry.machInst == mach_inst))
+        if (GEM5_LIKELY(entry.inst && (entry.machInst == mach_inst)))
             return entry.inst;
 
         entry.machInst = mach_inst;
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GENERIC_PAGE_WALK_CACHE_HH__
+#define __ARCH_GENERIC_PAGE_WALK_CACHE_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A small, fully associative cache of the upper level page table
+ * entries a page table walker has read, keyed on the physical address
+ * of the entry. Walkers only insert non-leaf entries, so a hit saves a
+ * memory access per level and leaves the leaf entry, and its accessed
+ * and dirty bits, to memory. Like the paging structure caches of real
+ * hardware, it is invalidated along with the TLB.
+ */
+class PageWalkCache
+{
+  public:
+    explicit PageWalkCache(unsigned num_entries) : entries(num_entries) {}
+
+    /** Is the cache holding any entry at all? */
+    bool enabled() const { return !entries.empty(); }
+
+    /**
+     * Looks up the entry stored at a physical address.
+     * @param pte Set to the entry on a hit.
+     * @return Whether the cache had the entry.
+     */
+    bool
+    lookup(Addr addr, uint64_t &pte)
+    {
+        for (auto &entry : entries) {
+            if (entry.valid && entry.addr == addr) {
+                entry.lastUse = ++useCount;
+                pte = entry.pte;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Caches the entry stored at a physical address. */
+    void
+    insert(Addr addr, uint64_t pte)
+    {
+        if (entries.empty())
+            return;
+
+        // Replace the entry itself if it is cached already, else an
+        // invalid entry, else the least recently used one.
+        Entry *victim = nullptr;
+        for (auto &entry : entries) {
+            if (entry.valid && entry.addr == addr) {
+                victim = &entry;
+                break;
+            }
+            if (!victim || (victim->valid &&
+                            (!entry.valid || entry.lastUse < victim->lastUse)))
+                victim = &entry;
+        }
+        victim->valid = true;
+        victim->addr = addr;
+        victim->pte = pte;
+        victim->lastUse = ++useCount;
+    }
+
+    /** Drops all the cached entries. */
+    void
+    flush()
+    {
+        for (auto &entry : entries)
+            entry.valid = false;
+    }
+
+  private:
+    struct Entry
+    {
+        bool valid = false;
+        Addr addr = 0;
+        uint64_t pte = 0;
+        uint64_t lastUse = 0;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t useCount = 0;
+};
+
+} // namespace gem5
+
+#endif // __ARCH_GENERIC_PAGE_WALK_CACHE_HH__
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "arch/generic/shared_tlb.hh"
+
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/TLB.hh"
+
+namespace gem5
+{
+
+SharedTLB::PrefetchTranslation::PrefetchTranslation(SharedTLB &shared_tlb)
+    : sharedTLB(shared_tlb)
+{
+    sharedTLB.stats.prefetches++;
+}
+
+void
+SharedTLB::PrefetchTranslation::finish(const Fault &fault,
+        const RequestPtr &req, ThreadContext *tc, BaseMMU::Mode mode)
+{
+    if (fault != NoFault)
+        sharedTLB.stats.prefetchFaults++;
+    delete this;
+}
+
+SharedTLB::SharedTLB(const Params &p)
+    : ClockedObject(p), assoc(p.assoc),
+      numSets(p.assoc ? p.size / p.assoc : 0), lines(p.size),
+      lookupLatency(p.lookup_latency),
+      responseEvent([this]{ sendResponses(); }, name() + ".response"),
+      prefetcher(p.prefetch_entries, p.prefetch_degree),
+      stats(this)
+{
+    fatal_if(!p.size || !p.assoc || p.size % p.assoc,
+             "%s: size must be a non-zero multiple of assoc\n", name());
+    fatal_if(p.prefetch_degree && !p.prefetch_entries,
+             "%s: prefetching needs prefetch_entries\n", name());
+}
+
+SharedTLB::Line *
+SharedTLB::findSet(Addr vaddr, unsigned log_bytes)
+{
+    return &lines[((vaddr >> log_bytes) % numSets) * assoc];
+}
+
+SharedTLB::Line *
+SharedTLB::find(Addr vaddr, uint64_t context)
+{
+    // Entries are placed by their own page size, so look in a set for
+    // each of the sizes seen.
+    for (unsigned log_bytes : pageSizes) {
+        Line *set = findSet(vaddr, log_bytes);
+        const Addr page = vaddr & ~mask(log_bytes);
+        for (unsigned way = 0; way < assoc; way++) {
+            Line &line = set[way];
+            if (line.valid && line.logBytes == log_bytes &&
+                line.vaddr == page &&
+                (line.global || line.context == context)) {
+                return &line;
+            }
+        }
+    }
+    return nullptr;
+}
+
+const SharedTLB::Entry *
+SharedTLB::lookup(Addr vaddr, uint64_t context, bool hidden)
+{
+    Line *line = find(vaddr, context);
+    if (hidden)
+        return line;
+
+    DPRINTF(TLB, "Shared lookup of %#x in context %#x: %s\n", vaddr,
+            context, line ? "hit" : "miss");
+    if (line) {
+        line->lastUse = ++useCount;
+        stats.hits++;
+    } else {
+        stats.misses++;
+    }
+    return line;
+}
+
+void
+SharedTLB::insert(const Entry &entry)
+{
+    DPRINTF(TLB, "Shared insert of %#x in context %#x: paddr %#x size "
+            "%#x\n", entry.vaddr, entry.context, entry.paddr,
+            1ULL << entry.logBytes);
+
+    pageSizes.insert(entry.logBytes);
+
+    // Replace the entry itself if it is there already, else an invalid
+    // entry, else the least recently used one.
+    Line *set = findSet(entry.vaddr, entry.logBytes);
+    Line *victim = nullptr;
+    for (unsigned way = 0; way < assoc; way++) {
+        Line &line = set[way];
+        if (line.valid && line.logBytes == entry.logBytes &&
+            line.vaddr == entry.vaddr && line.context == entry.context) {
+            victim = &line;
+            break;
+        }
+        if (!victim || (victim->valid &&
+                        (!line.valid || line.lastUse < victim->lastUse)))
+            victim = &line;
+    }
+
+    static_cast<Entry &>(*victim) = entry;
+    victim->valid = true;
+    victim->lastUse = ++useCount;
+}
+
+void
+SharedTLB::flushAll()
+{
+    DPRINTF(TLB, "Shared flush of all entries\n");
+    for (auto &line : lines)
+        line.valid = false;
+}
+
+void
+SharedTLB::flushNonGlobal()
+{
+    DPRINTF(TLB, "Shared flush of the non global entries\n");
+    for (auto &line : lines) {
+        if (!line.global)
+            line.valid = false;
+    }
+}
+
+void
+SharedTLB::flushContext(uint64_t context)
+{
+    DPRINTF(TLB, "Shared flush of context %#x\n", context);
+    for (auto &line : lines) {
+        if (line.context == context)
+            line.valid = false;
+    }
+}
+
+void
+SharedTLB::demap(Addr vaddr)
+{
+    DPRINTF(TLB, "Shared demap of %#x\n", vaddr);
+    for (auto &line : lines) {
+        if (line.valid && line.vaddr == (vaddr & ~mask(line.logBytes)))
+            line.valid = false;
+    }
+}
+
+void
+SharedTLB::respond(std::function<void()> callback)
+{
+    Tick when = clockEdge(lookupLatency);
+    responses.emplace_back(when, std::move(callback));
+    if (!responseEvent.scheduled())
+        schedule(responseEvent, when);
+}
+
+void
+SharedTLB::sendResponses()
+{
+    while (!responses.empty() && responses.front().first <= curTick()) {
+        auto callback = std::move(responses.front().second);
+        responses.pop_front();
+        callback();
+    }
+
+    if (!responses.empty()) {
+        if (!responseEvent.scheduled())
+            schedule(responseEvent, responses.front().first);
+    } else if (drainState() == DrainState::Draining) {
+        signalDrainDone();
+    }
+}
+
+void
+SharedTLB::prefetchCandidates(int requestor, Addr vpn,
+                              std::vector<Addr> &vpns)
+{
+    prefetcher.notifyMiss(requestor, vpn, vpns);
+}
+
+DrainState
+SharedTLB::drain()
+{
+    return responses.empty() ? DrainState::Drained : DrainState::Draining;
+}
+
+SharedTLB::SharedTLBStats::SharedTLBStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of lookups that hit"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of lookups that missed"),
+      ADD_STAT(prefetches, statistics::units::Count::get(),
+               "Number of prefetch walks started"),
+      ADD_STAT(prefetchFaults, statistics::units::Count::get(),
+               "Number of prefetch walks that faulted"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Fraction of the lookups that hit")
+{
+    hitRate = hits / (hits + misses);
+}
+
+} // namespace gem5
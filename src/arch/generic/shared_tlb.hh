@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GENERIC_SHARED_TLB_HH__
+#define __ARCH_GENERIC_SHARED_TLB_HH__
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "arch/generic/mmu.hh"
+#include "arch/generic/tlb_prefetcher.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "params/SharedTLB.hh"
+#include "sim/clocked_object.hh"
+
+namespace gem5
+{
+
+/**
+ * A set associative last level TLB that several ISA TLBs, usually of
+ * different cores, look up on their misses before walking the page
+ * table. It knows nothing about the ISA specific entry formats: the
+ * ISA TLBs fill it with the virtual page, the page size and address
+ * space of their entries, and whatever they need to rebuild the entry
+ * on a hit. It also trains a distance prefetcher on the misses, which
+ * the ISA TLBs use to walk the predicted pages ahead of time.
+ */
+class SharedTLB : public ClockedObject
+{
+  public:
+    /** An entry as the ISA TLBs fill it. */
+    struct Entry
+    {
+        /** The beginning of the virtual page this entry maps */
+        Addr vaddr = 0;
+        /** The size of the page, in address bits */
+        unsigned logBytes = 0;
+        /** The address space the entry belongs to */
+        uint64_t context = 0;
+        /** Whether the entry matches every address space */
+        bool global = false;
+
+        /** The physical page, as the ISA keeps it */
+        Addr paddr = 0;
+        /** Permissions and attributes, as the ISA keeps them */
+        uint64_t attributes = 0;
+    };
+
+    /**
+     * The translation of a prefetch, which nothing waits on. It only
+     * counts the prefetches that fault and frees itself once done.
+     */
+    class PrefetchTranslation : public BaseMMU::Translation
+    {
+      public:
+        PrefetchTranslation(SharedTLB &shared_tlb);
+
+        void markDelayed() override {}
+
+        void finish(const Fault &fault, const RequestPtr &req,
+                    ThreadContext *tc, BaseMMU::Mode mode) override;
+
+      private:
+        SharedTLB &sharedTLB;
+    };
+
+    PARAMS(SharedTLB);
+    SharedTLB(const Params &p);
+
+    /**
+     * Looks up the entry mapping a virtual address.
+     * @param hidden Skip the stats and the replacement state update.
+     */
+    const Entry *lookup(Addr vaddr, uint64_t context, bool hidden = false);
+
+    /** Fills an entry in, replacing any stale copy of it. */
+    void insert(const Entry &entry);
+
+    void flushAll();
+    /** Drops every entry that isn't global. */
+    void flushNonGlobal();
+    /** Drops the entries of an address space. */
+    void flushContext(uint64_t context);
+    /** Drops the entries mapping a virtual address, in any context. */
+    void demap(Addr vaddr);
+
+    /** Calls back once the latency of a hit has passed. */
+    void respond(std::function<void()> callback);
+
+    /**
+     * Trains the prefetcher on a miss.
+     * @param requestor Identifies the stream of misses.
+     * @param vpn Virtual page number of the miss.
+     * @param vpns Set to the virtual page numbers to prefetch.
+     */
+    void prefetchCandidates(int requestor, Addr vpn,
+                            std::vector<Addr> &vpns);
+
+    DrainState drain() override;
+
+  private:
+    struct Line : public Entry
+    {
+        bool valid = false;
+        uint64_t lastUse = 0;
+    };
+
+    Line *find(Addr vaddr, uint64_t context);
+    Line *findSet(Addr vaddr, unsigned log_bytes);
+    void sendResponses();
+
+    const unsigned assoc;
+    const unsigned numSets;
+    std::vector<Line> lines;
+    /** Page sizes of the entries filled so far, each needs a probe */
+    std::set<unsigned> pageSizes;
+    uint64_t useCount = 0;
+
+    const Cycles lookupLatency;
+    std::deque<std::pair<Tick, std::function<void()>>> responses;
+    EventFunctionWrapper responseEvent;
+
+    DistanceTLBPrefetcher prefetcher;
+
+    struct SharedTLBStats : public statistics::Group
+    {
+        SharedTLBStats(statistics::Group *parent);
+
+        statistics::Scalar hits;
+        statistics::Scalar misses;
+        statistics::Scalar prefetches;
+        statistics::Scalar prefetchFaults;
+        statistics::Formula hitRate;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __ARCH_GENERIC_SHARED_TLB_HH__
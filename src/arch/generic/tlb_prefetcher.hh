@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GENERIC_TLB_PREFETCHER_HH__
+#define __ARCH_GENERIC_TLB_PREFETCHER_HH__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Distance prefetcher for TLBs, after Kandiraju and Sivasubramaniam,
+ * "Going the Distance for TLB Prefetching" (ISCA 2002). It follows the
+ * stream of TLB misses of each requestor and learns which distances,
+ * in pages, tend to follow each other. A miss at a distance d from the
+ * previous one prefetches the pages at the distances that followed d
+ * earlier on. A regular stride is simply a distance that follows
+ * itself.
+ */
+class DistanceTLBPrefetcher
+{
+  public:
+    /**
+     * @param num_entries Number of distances the table tracks.
+     * @param degree Number of distances remembered, and so pages
+     *               prefetched, for each of them.
+     */
+    DistanceTLBPrefetcher(unsigned num_entries, unsigned degree)
+      : table(degree ? num_entries : 0), degree(degree)
+    {}
+
+    bool enabled() const { return !table.empty(); }
+
+    /**
+     * Trains on a miss and returns the pages worth prefetching.
+     * @param requestor Identifies the stream of misses, usually the
+     *                  context of the thread that missed.
+     * @param vpn Virtual page number of the miss.
+     * @param vpns Set to the virtual page numbers to prefetch.
+     */
+    void
+    notifyMiss(int requestor, Addr vpn, std::vector<Addr> &vpns)
+    {
+        vpns.clear();
+        if (!enabled())
+            return;
+
+        History &history = histories[requestor];
+        if (!history.valid) {
+            history.valid = true;
+            history.lastVpn = vpn;
+            return;
+        }
+
+        const int64_t distance = int64_t(vpn - history.lastVpn);
+        if (distance == 0)
+            return;
+
+        // The distance just seen follows the previous one
+        if (history.hasDistance) {
+            Entry &prev = entryFor(history.lastDistance);
+            prev.remember(history.lastDistance, distance, degree);
+        }
+        history.lastVpn = vpn;
+        history.lastDistance = distance;
+        history.hasDistance = true;
+
+        const Entry &entry = entryFor(distance);
+        if (!entry.valid || entry.distance != distance)
+            return;
+        for (int64_t next : entry.next)
+            vpns.push_back(vpn + next);
+    }
+
+  private:
+    struct Entry
+    {
+        bool valid = false;
+        int64_t distance = 0;
+        /** The distances that followed, most recent first */
+        std::vector<int64_t> next;
+
+        void
+        remember(int64_t dist, int64_t follower, unsigned degree)
+        {
+            if (!valid || distance != dist) {
+                valid = true;
+                distance = dist;
+                next.clear();
+            }
+            for (auto it = next.begin(); it != next.end(); it++) {
+                if (*it == follower) {
+                    next.erase(it);
+                    break;
+                }
+            }
+            next.insert(next.begin(), follower);
+            if (next.size() > degree)
+                next.pop_back();
+        }
+    };
+
+    struct History
+    {
+        bool valid = false;
+        bool hasDistance = false;
+        Addr lastVpn = 0;
+        int64_t lastDistance = 0;
+    };
+
+    Entry &
+    entryFor(int64_t distance)
+    {
+        return table[uint64_t(distance) % table.size()];
+    }
+
+    std::vector<Entry> table;
+    const unsigned degree;
+    std::unordered_map<int, History> histories;
+};
+
+} // namespace gem5
+
+#endif // __ARCH_GENERIC_TLB_PREFETCHER_HH__
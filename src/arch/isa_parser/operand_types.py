@@ -332,11 +332,20 @@ class VecRegOperand(RegOperand):
         if self.is_dest and self.is_src:
             name += '_merger'
 
+        # Read the register in place if the CPU allows, vector registers
+        # can be large enough for copying them to dominate a simple op.
         tmp_name = f'tmp_s{self.src_reg_idx}'
-        c_read = f'\t\t{self.parser.namespace}::VecRegContainer ' \
-                 f'{tmp_name};\n' \
-                 f'\t\txc->getRegOperand(this, {self.src_reg_idx},\n' \
-                 f'\t\t    &{tmp_name});\n'
+        ctype = f'{self.parser.namespace}::VecRegContainer'
+        c_read = f'\t\tconst {ctype} *{tmp_name}_ptr =\n' \
+                 f'\t\t    (const {ctype} *)xc->getReadableRegOperand(\n' \
+                 f'\t\t        this, {self.src_reg_idx});\n' \
+                 f'\t\t{ctype} {tmp_name}_copy;\n' \
+                 f'\t\tif (!{tmp_name}_ptr) {{\n' \
+                 f'\t\t    xc->getRegOperand(this, {self.src_reg_idx},\n' \
+                 f'\t\t        &{tmp_name}_copy);\n' \
+                 f'\t\t    {tmp_name}_ptr = &{tmp_name}_copy;\n' \
+                 f'\t\t}}\n' \
+                 f'\t\tconst {ctype} &{tmp_name} = *{tmp_name}_ptr;\n'
         # If the parser has detected that elements are being access, create
         # the appropriate view
         if self.elemExt:
@@ -34,7 +34,7 @@ namespace gem5
 namespace MipsISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
+GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 2> Decoder::defaultCache;
 
 } // namespace MipsISA
 } // namespace gem5
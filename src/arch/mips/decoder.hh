@@ -67,8 +67,8 @@ class Decoder : public InstDecoder
 
   protected:
     /// A cache of decoded instruction objects.
-    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
-    friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
+    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 2> defaultCache;
+    friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 2>;
 
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
@@ -34,7 +34,7 @@ namespace gem5
 namespace PowerISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
+GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 2> Decoder::defaultCache;
 
 } // namespace PowerISA
 } // namespace gem5
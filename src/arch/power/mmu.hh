@@ -47,7 +47,7 @@ namespace gem5
 
 namespace PowerISA {
 
-class MMU : public BaseMMU
+class MMU final : public BaseMMU
 {
   public:
     MMU(const PowerMMUParams &p)
@@ -33,6 +33,7 @@ from m5.proxy import *
 
 from m5.objects.BaseTLB import BaseTLB
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.ReplacementPolicies import LRURP
 
 class RiscvPagetableWalker(ClockedObject):
     type = 'RiscvPagetableWalker'
@@ -43,6 +44,11 @@ class RiscvPagetableWalker(ClockedObject):
     system = Param.System(Parent.any, "system object")
     num_squash_per_cycle = Param.Unsigned(4,
             "Number of outstanding walks that can be squashed per cycle")
+    pwc_entries = Param.Unsigned(0, "Number of upper level page table "
+            "entries cached by the page walk cache (0 disables it)")
+    pwc_latency = Param.Cycles(1, "Latency of a page walk cache hit")
+    coalesce_walks = Param.Bool(False, "Complete the waiting walks to a "
+            "page another walk just translated through the TLB")
     # Grab the pma_checker from the MMU
     pma_checker = Param.PMAChecker(Parent.any, "PMA Checker")
     pmp = Param.PMP(Parent.any, "PMP")
@@ -55,6 +61,11 @@ class RiscvTLB(BaseTLB):
     size = Param.Int(64, "TLB size")
     walker = Param.RiscvPagetableWalker(\
             RiscvPagetableWalker(), "page table walker")
+    assoc = Param.Unsigned(0, "TLB associativity (0 for fully associative)")
+    replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+            "Replacement policy")
     # Grab the pma_checker from the MMU
     pma_checker = Param.PMAChecker(Parent.any, "PMA Checker")
     pmp  = Param.PMP(Parent.any, "Physical Memory Protection Unit")
+    shared_tlb = Param.SharedTLB(NULL, "Last level TLB shared with other "
+            "TLBs, looked up before walking the page table")
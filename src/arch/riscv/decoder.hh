@@ -49,7 +49,9 @@ class ISA;
 class Decoder : public InstDecoder
 {
   private:
-    decode_cache::InstMap<ExtMachInst> instMap;
+    /// A cache of decoded instruction objects.
+    GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 1> decodeCache;
+    friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 1>;
     bool aligned;
     bool mid;
 
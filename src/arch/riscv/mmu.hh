@@ -51,7 +51,7 @@ namespace gem5
 
 namespace RiscvISA {
 
-class MMU : public BaseMMU
+class MMU final : public BaseMMU
 {
   public:
     PMAChecker *pma;
@@ -31,6 +31,7 @@
 
 #include "arch/riscv/tlb.hh"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -71,17 +72,25 @@ buildKey(Addr vpn, uint16_t asid)
 }
 
 TLB::TLB(const Params &p) :
-    BaseTLB(p), size(p.size), tlb(size),
-    lruSeq(0), stats(this), pma(p.pma_checker),
-    pmp(p.pmp)
+    BaseTLB(p), size(p.size), assoc(p.assoc ? p.assoc : p.size),
+    numSets(assoc ? size / assoc : 0), tlb(size), lruSeq(0),
+    replacementPolicy(p.replacement_policy), replEntries(size),
+    stats(this), pma(p.pma_checker), pmp(p.pmp)
 {
+    fatal_if(!size || size % assoc,
+             "TLB size must be a non-zero multiple of its associativity.\n");
+
     for (size_t x = 0; x < size; x++) {
         tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
+        replEntries[x].setPosition(x / assoc, x % assoc);
+        replEntries[x].replacementData =
+            replacementPolicy->instantiateEntry();
     }
+    candidates.reserve(assoc);
 
     walker = p.walker;
     walker->setTLB(this);
+    sharedTLB = p.shared_tlb;
 }
 
 Walker *
@@ -90,19 +99,23 @@ TLB::getWalker()
     return walker;
 }
 
-void
-TLB::evictLRU()
+size_t
+TLB::findVictim(Addr vpn, unsigned logBytes)
 {
-    // Find the entry with the lowest (and hence least recently updated)
-    // sequence number.
-
-    size_t lru = 0;
-    for (size_t i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
+    // Pages are placed by their own page number, so the small pages
+    // that make up a large one don't all compete for one set.
+    size_t first = ((vpn >> logBytes) % numSets) * assoc;
+    candidates.clear();
+    for (size_t idx = first; idx < first + assoc; idx++) {
+        if (!tlb[idx].trieHandle)
+            return idx;
+        candidates.push_back(&replEntries[idx]);
     }
 
-    remove(lru);
+    size_t victim = replacementPolicy->getVictim(candidates) -
+        replEntries.data();
+    remove(victim);
+    return victim;
 }
 
 TlbEntry *
@@ -111,8 +124,11 @@ TLB::lookup(Addr vpn, uint16_t asid, BaseMMU::Mode mode, bool hidden)
     TlbEntry *entry = trie.lookup(buildKey(vpn, asid));
 
     if (!hidden) {
-        if (entry)
+        if (entry) {
             entry->lruSeq = nextSeq();
+            replacementPolicy->touch(
+                replEntries[entry - tlb.data()].replacementData);
+        }
 
         if (mode == BaseMMU::Write)
             stats.writeAccesses++;
@@ -140,11 +156,60 @@ TLB::lookup(Addr vpn, uint16_t asid, BaseMMU::Mode mode, bool hidden)
 }
 
 TlbEntry *
-TLB::insert(Addr vpn, const TlbEntry &entry)
+TLB::lookupShared(Addr vaddr, uint16_t asid)
+{
+    const SharedTLB::Entry *shared = sharedTLB->lookup(vaddr, asid);
+    if (!shared)
+        return nullptr;
+
+    TlbEntry entry;
+    entry.paddr = shared->paddr;
+    entry.vaddr = shared->vaddr;
+    entry.logBytes = shared->logBytes;
+    entry.asid = asid;
+    entry.pte = shared->attributes;
+    return insert(entry.vaddr, entry);
+}
+
+void
+TLB::prefetch(Addr vaddr, uint16_t asid, ThreadContext *tc)
+{
+    sharedTLB->prefetchCandidates(tc->contextId(), vaddr >> PageShift,
+                                  prefetchVpns);
+    for (Addr vpn : prefetchVpns) {
+        Addr pf_vaddr = Addr(sext<VADDR_BITS>(vpn << PageShift));
+        if (lookup(pf_vaddr, asid, BaseMMU::Read, true) ||
+            sharedTLB->lookup(pf_vaddr, asid, true)) {
+            continue;
+        }
+
+        DPRINTF(TLB, "prefetch(vpn=%#x, asid=%#x)\n", pf_vaddr, asid);
+        auto req = std::make_shared<Request>(
+            pf_vaddr, 1, Request::PREFETCH, Request::funcRequestorId, 0,
+            tc->contextId());
+        auto *translation = new SharedTLB::PrefetchTranslation(*sharedTLB);
+        if (walker->start(tc, translation, req, BaseMMU::Read) != NoFault)
+            delete translation;
+    }
+}
+
+TlbEntry *
+TLB::insert(Addr vpn, const TlbEntry &entry, ThreadContext *tc)
 {
     DPRINTF(TLB, "insert(vpn=%#x, asid=%#x): ppn=%#x pte=%#x size=%#x\n",
         vpn, entry.asid, entry.paddr, entry.pte, entry.size());
 
+    if (sharedTLB && tc) {
+        SharedTLB::Entry shared;
+        shared.vaddr = vpn;
+        shared.logBytes = entry.logBytes;
+        shared.context = entry.asid;
+        shared.global = entry.pte.g;
+        shared.paddr = entry.paddr;
+        shared.attributes = entry.pte;
+        sharedTLB->insert(shared);
+    }
+
     // If somebody beat us to it, just use that existing entry.
     TlbEntry *newEntry = lookup(vpn, entry.asid, BaseMMU::Read, true);
     if (newEntry) {
@@ -154,11 +219,8 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
         return newEntry;
     }
 
-    if (freeList.empty())
-        evictLRU();
-
-    newEntry = freeList.front();
-    freeList.pop_front();
+    size_t idx = findVictim(vpn, entry.logBytes);
+    newEntry = &tlb[idx];
 
     Addr key = buildKey(vpn, entry.asid);
     *newEntry = entry;
@@ -166,6 +228,7 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
     newEntry->vaddr = vpn;
     newEntry->trieHandle =
     trie.insert(key, TlbEntryTrie::MaxBits - entry.logBytes, newEntry);
+    replacementPolicy->reset(replEntries[idx].replacementData);
     return newEntry;
 }
 
@@ -178,6 +241,12 @@ TLB::demapPage(Addr vpn, uint64_t asid)
         flushAll();
     else {
         DPRINTF(TLB, "flush(vpn=%#x, asid=%#x)\n", vpn, asid);
+        if (sharedTLB) {
+            if (vpn != 0)
+                sharedTLB->demap(vpn);
+            else
+                sharedTLB->flushContext(asid);
+        }
         if (vpn != 0 && asid != 0) {
             TlbEntry *newEntry = lookup(vpn, asid, BaseMMU::Read, true);
             if (newEntry)
@@ -193,6 +262,7 @@ TLB::demapPage(Addr vpn, uint64_t asid)
                 }
             }
         }
+        walker->flushPWC();
     }
 }
 
@@ -204,6 +274,9 @@ TLB::flushAll()
         if (tlb[i].trieHandle)
             remove(i);
     }
+    walker->flushPWC();
+    if (sharedTLB)
+        sharedTLB->flushAll();
 }
 
 void
@@ -216,7 +289,7 @@ TLB::remove(size_t idx)
     assert(tlb[idx].trieHandle);
     trie.remove(tlb[idx].trieHandle);
     tlb[idx].trieHandle = NULL;
-    freeList.push_back(&tlb[idx]);
+    replacementPolicy->invalidate(replEntries[idx].replacementData);
 }
 
 Fault
@@ -285,8 +358,22 @@ TLB::doTranslate(const RequestPtr &req, ThreadContext *tc,
     SATP satp = tc->readMiscReg(MISCREG_SATP);
 
     TlbEntry *e = lookup(vaddr, satp.asid, mode, false);
+    if (!e && sharedTLB) {
+        e = lookupShared(vaddr, satp.asid);
+        if (e && translation != nullptr) {
+            // Finish once the shared TLB has answered, the entry is in
+            // this TLB by then.
+            sharedTLB->respond([this, req, tc, translation, mode] {
+                translateTiming(req, tc, translation, mode);
+            });
+            delayed = true;
+            return NoFault;
+        }
+    }
     if (!e) {
         Fault fault = walker->start(tc, translation, req, mode);
+        if (sharedTLB && translation != nullptr)
+            prefetch(vaddr, satp.asid, tc);
         if (translation != nullptr || fault != NoFault) {
             // This gets ignored in atomic mode.
             delayed = true;
@@ -482,7 +569,11 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = 0;
+    for (uint32_t x = 0; x < size; x++) {
+        if (tlb[x].trieHandle != NULL)
+            _size++;
+    }
     SERIALIZE_SCALAR(_size);
     SERIALIZE_SCALAR(lruSeq);
 
@@ -503,17 +594,20 @@ TLB::unserialize(CheckpointIn &cp)
         fatal("TLB size less than the one in checkpoint!");
     }
 
-    UNSERIALIZE_SCALAR(lruSeq);
+    std::vector<TlbEntry> entries(_size);
+    for (uint32_t x = 0; x < _size; x++)
+        entries[x].unserializeSection(cp, csprintf("Entry%d", x));
 
-    for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
+    // Fill the entries in from the least recently used one, so that the
+    // replacement policy sees them in the same order as before.
+    std::sort(entries.begin(), entries.end(),
+              [](const TlbEntry &a, const TlbEntry &b) {
+                  return a.lruSeq < b.lruSeq;
+              });
+    for (const auto &entry : entries)
+        insert(entry.vaddr, entry);
 
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        Addr key = buildKey(newEntry->vaddr, newEntry->asid);
-        newEntry->trieHandle = trie.insert(key,
-            TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
-    }
+    UNSERIALIZE_SCALAR(lruSeq);
 }
 
 TLB::TlbStats::TlbStats(statistics::Group *parent)
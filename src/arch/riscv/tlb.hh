@@ -32,8 +32,9 @@
 #ifndef __ARCH_RISCV_TLB_HH__
 #define __ARCH_RISCV_TLB_HH__
 
-#include <list>
+#include <vector>
 
+#include "arch/generic/shared_tlb.hh"
 #include "arch/generic/tlb.hh"
 #include "arch/riscv/isa.hh"
 #include "arch/riscv/pagetable.hh"
@@ -41,6 +42,7 @@
 #include "arch/riscv/regs/misc.hh"
 #include "arch/riscv/utility.hh"
 #include "base/statistics.hh"
+#include "mem/cache/replacement_policies/base.hh"
 #include "mem/request.hh"
 #include "params/RiscvTLB.hh"
 #include "sim/sim_object.hh"
@@ -58,17 +60,24 @@ class Walker;
 
 class TLB : public BaseTLB
 {
-    typedef std::list<TlbEntry *> EntryList;
-
   protected:
     size_t size;
+    size_t assoc;               // ways per set, contiguous in tlb
+    size_t numSets;
     std::vector<TlbEntry> tlb;  // our TLB
     TlbEntryTrie trie;          // for quick access
-    EntryList freeList;         // free entries
     uint64_t lruSeq;
 
+    replacement_policy::Base *replacementPolicy;
+    std::vector<ReplaceableEntry> replEntries;  // indexed like tlb
+    ReplacementCandidates candidates;
+
     Walker *walker;
 
+    /** The last level TLB shared with other TLBs, if any */
+    SharedTLB *sharedTLB;
+    std::vector<Addr> prefetchVpns;
+
     struct TlbStats : public statistics::Group
     {
         TlbStats(statistics::Group *parent);
@@ -97,7 +106,14 @@ class TLB : public BaseTLB
 
     void takeOverFrom(BaseTLB *old) override {}
 
-    TlbEntry *insert(Addr vpn, const TlbEntry &entry);
+    /**
+     * Insert an entry.
+     *
+     * @param tc Thread context the entry was walked for. If set, the
+     * entry is filled into the shared TLB as well.
+     */
+    TlbEntry *insert(Addr vpn, const TlbEntry &entry,
+                     ThreadContext *tc = nullptr);
     void flushAll() override;
     void demapPage(Addr vaddr, uint64_t asn) override;
 
@@ -140,7 +156,13 @@ class TLB : public BaseTLB
 
     TlbEntry *lookup(Addr vpn, uint16_t asid, BaseMMU::Mode mode, bool hidden);
 
-    void evictLRU();
+    /** Refill this TLB from the shared one if it has the entry. */
+    TlbEntry *lookupShared(Addr vaddr, uint16_t asid);
+    /** Walk the pages the shared TLB predicts will miss next. */
+    void prefetch(Addr vaddr, uint16_t asid, ThreadContext *tc);
+
+    /** Pick the entry to fill a page into, freeing it if needed. */
+    size_t findVictim(Addr vpn, unsigned logBytes);
     void remove(size_t idx);
 
     Fault translate(const RequestPtr &req, ThreadContext *tc,
@@ -34,7 +34,7 @@ namespace gem5
 namespace SparcISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
+GenericISA::BasicDecodeCache<Decoder, ExtMachInst, 2> Decoder::defaultCache;
 
 } // namespace SparcISA
 } // namespace gem5
@@ -49,7 +49,7 @@ namespace gem5
 
 namespace SparcISA {
 
-class MMU : public BaseMMU
+class MMU final : public BaseMMU
 {
   public:
     MMU(const SparcMMUParams &p)
@@ -38,6 +38,7 @@ from m5.proxy import *
 
 from m5.objects.BaseTLB import BaseTLB
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.ReplacementPolicies import LRURP
 
 class X86PagetableWalker(ClockedObject):
     type = 'X86PagetableWalker'
@@ -48,6 +49,11 @@ class X86PagetableWalker(ClockedObject):
     system = Param.System(Parent.any, "system object")
     num_squash_per_cycle = Param.Unsigned(4,
             "Number of outstanding walks that can be squashed per cycle")
+    pwc_entries = Param.Unsigned(0, "Number of upper level page table "
+            "entries cached by the page walk cache (0 disables it)")
+    pwc_latency = Param.Cycles(1, "Latency of a page walk cache hit")
+    coalesce_walks = Param.Bool(False, "Complete the waiting walks to a "
+            "page another walk just translated through the TLB")
 
 class X86TLB(BaseTLB):
     type = 'X86TLB'
@@ -58,3 +64,8 @@ class X86TLB(BaseTLB):
     system = Param.System(Parent.any, "system object")
     walker = Param.X86PagetableWalker(\
             X86PagetableWalker(), "page table walker")
+    assoc = Param.Unsigned(0, "TLB associativity (0 for fully associative)")
+    replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+            "Replacement policy")
+    shared_tlb = Param.SharedTLB(NULL, "Last level TLB shared with other "
+            "TLBs, looked up before walking the page table")
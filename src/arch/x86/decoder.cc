@@ -66,7 +66,7 @@ Decoder::doResetState()
     emi.modRM = 0;
     emi.sib = 0;
 
-    if (instBytes->si) {
+    if (instBytes->si || lookupPredecoded()) {
         return FromCacheState;
     } else {
         instBytes->chunks.clear();
@@ -74,6 +74,41 @@ Decoder::doResetState()
     }
 }
 
+bool
+Decoder::lookupPredecoded()
+{
+    const int avail = sizeof(MachInst) - offset;
+    const MachInst window = fetchChunk >> (offset * 8);
+    const PredecodeEntry &entry = predecodeCache[predecodeIndex(window)];
+    if (!entry.si || entry.m5Reg != m5RegKey || entry.size > avail ||
+            (window & mask(entry.size * 8)) != entry.bytes) {
+        return false;
+    }
+
+    DPRINTF(Decoder, "Found %d byte predecoded instruction.\n",
+            entry.size);
+
+    // Set the entry up as if the instruction had been predecoded at
+    // this address, and let the cache state check the bytes as usual.
+    const MachInst inst_mask = mask(entry.size * 8) << (offset * 8);
+    instBytes->chunks.assign(1, fetchChunk & inst_mask);
+    instBytes->masks.assign(1, inst_mask);
+    instBytes->lastOffset = offset + entry.size;
+    instBytes->si = entry.si;
+    return true;
+}
+
+void
+Decoder::insertPredecoded(int first_offset)
+{
+    const MachInst window = fetchChunk >> (first_offset * 8);
+    PredecodeEntry &entry = predecodeCache[predecodeIndex(window)];
+    entry.m5Reg = m5RegKey;
+    entry.size = instBytes->lastOffset - first_offset;
+    entry.bytes = window & mask(entry.size * 8);
+    entry.si = instBytes->si;
+}
+
 void
 Decoder::process()
 {
@@ -733,6 +768,11 @@ Decoder::decode(PCStateBase &next_pc)
     }
 
     si = decode(emi, origPC);
+
+    // The fetch chunk still holds the bytes of instructions that didn't
+    // span chunks.
+    if (instBytes->chunks.size() == 1)
+        insertPredecoded(firstOffset);
     return si;
 }
 
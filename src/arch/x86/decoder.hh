@@ -29,6 +29,7 @@
 #ifndef __ARCH_X86_DECODER_HH__
 #define __ARCH_X86_DECODER_HH__
 
+#include <array>
 #include <cassert>
 #include <unordered_map>
 #include <vector>
@@ -245,6 +246,42 @@ class Decoder : public InstDecoder
             CacheKey, decode_cache::InstMap<ExtMachInst> *> InstCacheMap;
     static InstCacheMap instCacheMap;
 
+    /// The m5Reg the decode caches above are selected with.
+    CacheKey m5RegKey = 0;
+
+    /// A direct mapped cache of the instructions that fit in a single
+    /// chunk, keyed on their raw bytes and the decoder mode. When an
+    /// instruction it has already seen shows up at a new address, the
+    /// decoder uses it to skip the predecode state machine.
+    struct PredecodeEntry
+    {
+        CacheKey m5Reg = 0;
+        MachInst bytes = 0;
+        int size = 0;
+        StaticInstPtr si;
+    };
+    static constexpr int NumPredecodeEntries = 1024;
+    std::array<PredecodeEntry, NumPredecodeEntries> predecodeCache;
+
+    /// Index of the predecoded instruction starting at the bottom of
+    /// window. Only the first bytes are used, since the length of the
+    /// instruction isn't known yet.
+    static int
+    predecodeIndex(MachInst window)
+    {
+        const MachInst head = window & mask(24);
+        return (head ^ (head >> 10) ^ (head >> 20)) &
+            (NumPredecodeEntries - 1);
+    }
+
+    /// Fill the address cache entry of the instruction at offset from
+    /// the predecode cache, if the cache has it.
+    bool lookupPredecoded();
+
+    /// Record the instruction just predecoded in the predecode cache.
+    /// @param first_offset The offset in fetchChunk it started at.
+    void insertPredecoded(int first_offset);
+
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
     /// Decode a machine instruction.
@@ -277,6 +314,7 @@ class Decoder : public InstDecoder
         altAddr = m5Reg.altAddr;
         defAddr = m5Reg.defAddr;
         stack = m5Reg.stack;
+        m5RegKey = m5Reg;
 
         AddrCacheMap::iterator amIter = addrCacheMap.find(m5Reg);
         if (amIter != addrCacheMap.end()) {
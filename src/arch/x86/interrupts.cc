@@ -55,6 +55,7 @@
 #include "arch/x86/intmessage.hh"
 #include "arch/x86/regs/apic.hh"
 #include "arch/x86/regs/misc.hh"
+#include "base/intmath.hh"
 #include "cpu/base.hh"
 #include "debug/LocalApic.hh"
 #include "dev/x86/i82094aa.hh"
@@ -417,20 +418,7 @@ X86ISA::Interrupts::readReg(ApicRegIndex reg)
         regs[APIC_INTERNAL_STATE] &= ~0x1ULL;
         break;
       case APIC_CURRENT_COUNT:
-        {
-            if (apicTimerEvent.scheduled()) {
-                // Compute how many m5 ticks happen per count.
-                uint64_t ticksPerCount = clockPeriod() *
-                    divideFromConf(regs[APIC_DIVIDE_CONFIGURATION]);
-                // Compute how many m5 ticks are left.
-                uint64_t val = apicTimerEvent.when() - curTick();
-                // Turn that into a count.
-                val = (val + ticksPerCount - 1) / ticksPerCount;
-                return val;
-            } else {
-                return 0;
-            }
-        }
+        return apicTimerCurrentCount();
       default:
         break;
     }
@@ -600,21 +588,7 @@ X86ISA::Interrupts::setReg(ApicRegIndex reg, uint32_t val)
       case APIC_INITIAL_COUNT:
         {
             newVal = bits(val, 31, 0);
-            // Compute how many timer ticks we're being programmed for.
-            uint64_t newCount = newVal *
-                (divideFromConf(regs[APIC_DIVIDE_CONFIGURATION]));
-            // Schedule on the edge of the next tick plus the new count.
-            Tick offset = curTick() % clockPeriod();
-            if (offset) {
-                reschedule(apicTimerEvent,
-                           curTick() + (newCount + 1) *
-                           clockPeriod() - offset, true);
-            } else {
-                if (newCount)
-                    reschedule(apicTimerEvent,
-                               curTick() + newCount *
-                               clockPeriod(), true);
-            }
+            startApicTimer(newVal);
         }
         break;
       case APIC_CURRENT_COUNT:
@@ -627,10 +601,83 @@ X86ISA::Interrupts::setReg(ApicRegIndex reg, uint32_t val)
         break;
     }
     regs[reg] = newVal;
+    // Masking or unmasking the timer decides whether its expiries need
+    // an event.
+    if (reg == APIC_LVT_TIMER)
+        updateApicTimer();
     return;
 }
 
 
+void
+X86ISA::Interrupts::startApicTimer(uint32_t count)
+{
+    apicTimerTicksPerCount = clockPeriod() *
+        divideFromConf(regs[APIC_DIVIDE_CONFIGURATION]);
+    if (apicTimerEvent.scheduled())
+        deschedule(apicTimerEvent);
+
+    // Writing a count of zero stops the timer.
+    if (!count) {
+        apicTimerPeriod = 0;
+        return;
+    }
+
+    // Start counting on the edge of the next tick.
+    Tick offset = curTick() % clockPeriod();
+    apicTimerStart = curTick() + (offset ? clockPeriod() - offset : 0);
+    apicTimerPeriod = count * apicTimerTicksPerCount;
+    updateApicTimer();
+}
+
+void
+X86ISA::Interrupts::updateApicTimer()
+{
+    LVTEntry entry = regs[APIC_LVT_TIMER];
+    if (!apicTimerPeriod || (entry.periodic && entry.masked)) {
+        if (apicTimerEvent.scheduled())
+            deschedule(apicTimerEvent);
+        return;
+    }
+    if (apicTimerEvent.scheduled())
+        return;
+
+    Tick end = apicTimerStart + apicTimerPeriod;
+    if (entry.periodic && curTick() >= apicTimerStart) {
+        // Pick up at the next period boundary after the ones that went
+        // by while the timer was masked.
+        Tick elapsed = curTick() - apicTimerStart;
+        end = apicTimerStart +
+            (elapsed / apicTimerPeriod + 1) * apicTimerPeriod;
+    }
+    if (end > curTick())
+        schedule(apicTimerEvent, end);
+    else
+        apicTimerPeriod = 0;
+}
+
+uint32_t
+X86ISA::Interrupts::apicTimerCurrentCount() const
+{
+    if (!apicTimerPeriod)
+        return 0;
+
+    // Compute how many m5 ticks are left.
+    Tick left;
+    if (apicTimerEvent.scheduled()) {
+        left = apicTimerEvent.when() - curTick();
+    } else if (curTick() < apicTimerStart) {
+        left = apicTimerStart + apicTimerPeriod - curTick();
+    } else {
+        // A masked periodic timer, which reloads every period.
+        left = apicTimerPeriod -
+            (curTick() - apicTimerStart) % apicTimerPeriod;
+    }
+    // Turn that into a count.
+    return divCeil(left, apicTimerTicksPerCount);
+}
+
+
 X86ISA::Interrupts::Interrupts(const Params &p)
     : BaseInterrupts(p), sys(p.system), clockDomain(*p.clk_domain),
       apicTimerEvent([this]{ processApicTimerEvent(); }, name()),
@@ -664,11 +711,15 @@ X86ISA::Interrupts::Interrupts(const Params &p)
 bool
 X86ISA::Interrupts::checkInterrupts() const
 {
-    RFLAGS rflags = tc->readMiscRegNoEffect(misc_reg::Rflags);
     if (pendingUnmaskableInt) {
         DPRINTF(LocalApic, "Reported pending unmaskable interrupt.\n");
         return true;
     }
+    // This is polled by the CPU all the time and usually nothing is
+    // pending, so only go to the thread context for RFLAGS when needed.
+    if (!checkInterruptsRaw())
+        return false;
+    RFLAGS rflags = tc->readMiscRegNoEffect(misc_reg::Rflags);
     if (rflags.intf) {
         if (pendingExtInt) {
             DPRINTF(LocalApic, "Reported pending external interrupt.\n");
@@ -783,6 +834,9 @@ X86ISA::Interrupts::serialize(CheckpointOut &cp) const
     SERIALIZE_SCALAR(apicTimerEventScheduled);
     Tick apicTimerEventTick = apicTimerEvent.when();
     SERIALIZE_SCALAR(apicTimerEventTick);
+    SERIALIZE_SCALAR(apicTimerStart);
+    SERIALIZE_SCALAR(apicTimerPeriod);
+    SERIALIZE_SCALAR(apicTimerTicksPerCount);
 }
 
 void
@@ -815,13 +869,30 @@ X86ISA::Interrupts::unserialize(CheckpointIn &cp)
             schedule(apicTimerEvent, apicTimerEventTick);
         }
     }
+    if (!UNSERIALIZE_OPT_SCALAR(apicTimerPeriod)) {
+        // Older checkpoints only have the event, which was scheduled
+        // for as long as the timer ran.
+        apicTimerTicksPerCount = clockPeriod() *
+            divideFromConf(regs[APIC_DIVIDE_CONFIGURATION]);
+        apicTimerPeriod = apicTimerEvent.scheduled() ?
+            regs[APIC_INITIAL_COUNT] * apicTimerTicksPerCount : 0;
+        apicTimerStart = apicTimerEvent.scheduled() ?
+            apicTimerEvent.when() - apicTimerPeriod : 0;
+    } else {
+        UNSERIALIZE_SCALAR(apicTimerStart);
+        UNSERIALIZE_SCALAR(apicTimerTicksPerCount);
+    }
 }
 
 void
 X86ISA::Interrupts::processApicTimerEvent()
 {
+    // A periodic timer reloads the count it was started with, so the
+    // next expiry is just a period away.
     if (triggerTimerInterrupt())
-        setReg(APIC_INITIAL_COUNT, readReg(APIC_INITIAL_COUNT));
+        schedule(apicTimerEvent, curTick() + apicTimerPeriod);
+    else
+        apicTimerPeriod = 0;
 }
 
 } // namespace gem5
@@ -101,6 +101,21 @@ class Interrupts : public BaseInterrupts
     EventFunctionWrapper apicTimerEvent;
     void processApicTimerEvent();
 
+    /*
+     * The timer count is derived from the tick it started counting down
+     * from and the length of a full count, rather than being kept up to
+     * date. The event is only scheduled when an expiry has something to
+     * deliver, so a masked periodic timer doesn't wake the simulation up
+     * every period.
+     */
+    Tick apicTimerStart = 0;
+    Tick apicTimerPeriod = 0;
+    Tick apicTimerTicksPerCount = 0;
+
+    void startApicTimer(uint32_t count);
+    void updateApicTimer();
+    uint32_t apicTimerCurrentCount() const;
+
     /*
      * A set of variables to keep track of interrupts that don't go through
      * the IRR.
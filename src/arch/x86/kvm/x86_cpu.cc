@@ -692,12 +692,22 @@ X86KvmCPU::dumpMSRs() const
 void
 X86KvmCPU::updateKvmState()
 {
-    updateKvmStateRegs();
-    updateKvmStateSRegs();
-    updateKvmStateFPU();
-    updateKvmStateMSRs();
+    updateKvmStateGroups(AllRegGroups);
+}
+
+void
+X86KvmCPU::updateKvmStateGroups(RegGroups groups)
+{
+    if (groups & RegGroupRegs) {
+        updateKvmStateRegs();
+        updateKvmStateSRegs();
+    }
+    if (groups & RegGroupFPU)
+        updateKvmStateFPU();
+    if (groups & RegGroupMSRs)
+        updateKvmStateMSRs();
 
-    DPRINTF(KvmContext, "X86KvmCPU::updateKvmState():\n");
+    DPRINTF(KvmContext, "X86KvmCPU::updateKvmState(%#x):\n", groups);
     if (debug::KvmContext)
         dump();
 }
@@ -950,30 +960,41 @@ X86KvmCPU::updateKvmStateMSRs()
 void
 X86KvmCPU::updateThreadContext()
 {
-    struct kvm_regs regs;
-    struct kvm_sregs sregs;
-
-    getRegisters(regs);
-    getSpecialRegisters(sregs);
+    updateThreadContextGroups(AllRegGroups);
+}
 
-    DPRINTF(KvmContext, "X86KvmCPU::updateThreadContext():\n");
+void
+X86KvmCPU::updateThreadContextGroups(RegGroups groups)
+{
+    DPRINTF(KvmContext, "X86KvmCPU::updateThreadContext(%#x):\n", groups);
     if (debug::KvmContext)
         dump();
 
-    updateThreadContextRegs(regs, sregs);
-    updateThreadContextSRegs(sregs);
-    if (useXSave) {
-        struct kvm_xsave xsave;
-        getXSave(xsave);
+    if (groups & RegGroupRegs) {
+        struct kvm_regs regs;
+        struct kvm_sregs sregs;
 
-       updateThreadContextXSave(xsave);
-    } else {
-        struct kvm_fpu fpu;
-        getFPUState(fpu);
+        getRegisters(regs);
+        getSpecialRegisters(sregs);
 
-        updateThreadContextFPU(fpu);
+        updateThreadContextRegs(regs, sregs);
+        updateThreadContextSRegs(sregs);
     }
-    updateThreadContextMSRs();
+    if (groups & RegGroupFPU) {
+        if (useXSave) {
+            struct kvm_xsave xsave;
+            getXSave(xsave);
+
+            updateThreadContextXSave(xsave);
+        } else {
+            struct kvm_fpu fpu;
+            getFPUState(fpu);
+
+            updateThreadContextFPU(fpu);
+        }
+    }
+    if (groups & RegGroupMSRs)
+        updateThreadContextMSRs();
 
     // The M5 misc reg caches some values from other
     // registers. Writing to it with side effects causes it to be
@@ -1145,8 +1166,6 @@ X86KvmCPU::deliverInterrupts()
 {
     Fault fault;
 
-    syncThreadContext();
-
     {
         // Migrate to the interrupt controller's thread to get the
         // interrupt. Even though the individual methods are safe to
@@ -1164,10 +1183,11 @@ X86KvmCPU::deliverInterrupts()
         kvmNonMaskableInterrupt();
     } else if (dynamic_cast<InitInterrupt *>(fault.get())) {
         DPRINTF(KvmInt, "INIT interrupt\n");
+        syncThreadContext();
         fault.get()->invoke(tc);
         // Delay the kvm state update since we won't enter KVM on this
         // tick.
-        threadContextDirty = true;
+        threadContextDirty = AllRegGroups;
         // HACK: gem5 doesn't actually have any BIOS code, which means
         // that we need to halt the thread and wait for a startup
         // interrupt before restarting the thread. The simulated CPUs
@@ -1175,6 +1195,7 @@ X86KvmCPU::deliverInterrupts()
         thread->suspend();
     } else if (dynamic_cast<StartupInterrupt *>(fault.get())) {
         DPRINTF(KvmInt, "STARTUP interrupt\n");
+        syncThreadContext();
         fault.get()->invoke(tc);
         // The kvm state is assumed to have been updated when entering
         // kvmRun(), so we need to update manually it here.
@@ -1204,15 +1225,15 @@ X86KvmCPU::kvmRun(Tick ticks)
         if (lapic->hasPendingUnmaskable()) {
             DPRINTF(KvmInt,
                     "Delivering unmaskable interrupt.\n");
-            syncThreadContext();
             deliverInterrupts();
         } else if (kvm_run.ready_for_interrupt_injection) {
             // KVM claims that it is ready for an interrupt. It might
             // be lying if we just updated rflags and disabled
             // interrupts (e.g., by doing a CPU handover). Let's sync
             // the thread context and check if there are /really/
-            // interrupts that should be delivered now.
-            syncThreadContext();
+            // interrupts that should be delivered now. Checking them
+            // only needs rflags.
+            syncThreadContext(RegGroupRegs);
             if (lapic->checkInterrupts()) {
                 DPRINTF(KvmInt,
                         "M5 has pending interrupts, delivering interrupt.\n");
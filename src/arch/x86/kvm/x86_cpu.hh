@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "arch/x86/pcstate.hh"
+#include "arch/x86/x86_traits.hh"
 #include "cpu/kvm/base.hh"
 #include "cpu/kvm/vm.hh"
 #include "params/X86KvmCPU.hh"
@@ -149,6 +150,35 @@ class X86KvmCPU : public BaseKvmCPU
     void updateKvmState() override;
     void updateThreadContext() override;
 
+    /**
+     * Register groups of the x86 state. The regular and special
+     * registers are kept together since the PC depends on the base of
+     * the code segment.
+     */
+    enum : RegGroups
+    {
+        /** Integer, segment and control registers */
+        RegGroupRegs = 1 << 0,
+        /** FPU and SIMD registers */
+        RegGroupFPU = 1 << 1,
+        /** Model specific registers */
+        RegGroupMSRs = 1 << 2,
+    };
+
+    RegGroups expandRegGroups(RegGroups groups) const override
+    {
+        return groups;
+    }
+    void updateKvmStateGroups(RegGroups groups) override;
+    void updateThreadContextGroups(RegGroups groups) override;
+
+    /**
+     * The local APIC base, which is the only register needed to
+     * translate MMIO addresses, is synchronized on every entry and
+     * exit through the kvm_run structure.
+     */
+    RegGroups mmioRegGroups() const override { return 0; }
+
     /**
      * Inject pending interrupts from gem5 into the virtual CPU.
      */
@@ -159,6 +189,12 @@ class X86KvmCPU : public BaseKvmCPU
      */
     Tick handleKvmExitIO() override;
 
+    Addr
+    pioAddress(Addr port) override
+    {
+        return X86ISA::x86IOAddress(port);
+    }
+
     Tick handleKvmExitIRQWindowOpen() override;
 
     /**
@@ -49,7 +49,7 @@ namespace gem5
 
 namespace X86ISA {
 
-class MMU : public BaseMMU
+class MMU final : public BaseMMU
 {
   public:
     MMU(const X86MMUParams &p)
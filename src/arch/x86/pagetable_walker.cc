@@ -50,6 +50,7 @@
 #include "arch/x86/pagetable_walker.hh"
 
 #include <memory>
+#include <vector>
 
 #include "arch/x86/faults.hh"
 #include "arch/x86/pagetable.hh"
@@ -124,6 +125,7 @@ Walker::recvTimingResp(PacketPtr pkt)
                 break;
             }
         }
+        coalesceWalks(senderWalk);
         delete senderWalk;
         // Since we block requests when another is outstanding, we
         // need to check if there is a waiting request to be serviced
@@ -157,7 +159,14 @@ bool Walker::sendTiming(WalkerState* sendingState, PacketPtr pkt)
 {
     WalkerSenderState* walker_state = new WalkerSenderState(sendingState);
     pkt->pushSenderState(walker_state);
-    if (port.sendTimingReq(pkt)) {
+    if (pwcAccess(pkt)) {
+        // The page walk cache answers after its own latency.
+        Tick when = clockEdge(pwcLatency);
+        pwcResponses.emplace_back(when, pkt);
+        if (!pwcResponseEvent.scheduled())
+            schedule(pwcResponseEvent, when);
+        return true;
+    } else if (port.sendTimingReq(pkt)) {
         return true;
     } else {
         // undo the adding of the sender state and delete it, as we
@@ -169,6 +178,106 @@ bool Walker::sendTiming(WalkerState* sendingState, PacketPtr pkt)
 
 }
 
+void
+Walker::sendAtomic(PacketPtr pkt)
+{
+    if (!pwcAccess(pkt))
+        port.sendAtomic(pkt);
+}
+
+bool
+Walker::pwcAccess(PacketPtr pkt)
+{
+    if (!pwc.enabled() || !pkt->isRead())
+        return false;
+
+    uint64_t pte;
+    if (!pwc.lookup(pkt->getAddr(), pte)) {
+        stats.pwcMisses++;
+        return false;
+    }
+
+    DPRINTF(PageTableWalker, "Page walk cache hit for PTE at %#x\n",
+            pkt->getAddr());
+    stats.pwcHits++;
+    if (pkt->getSize() == 8)
+        pkt->setLE<uint64_t>(pte);
+    else
+        pkt->setLE<uint32_t>(pte);
+    pkt->makeResponse();
+    return true;
+}
+
+void
+Walker::pwcInsert(PacketPtr pkt, uint64_t pte)
+{
+    if (pwc.enabled() && !pkt->req->isUncacheable())
+        pwc.insert(pkt->getAddr(), pte);
+}
+
+void
+Walker::sendPWCResponses()
+{
+    while (!pwcResponses.empty() &&
+           pwcResponses.front().first <= curTick()) {
+        PacketPtr pkt = pwcResponses.front().second;
+        pwcResponses.pop_front();
+        recvTimingResp(pkt);
+    }
+    if (!pwcResponses.empty() && !pwcResponseEvent.scheduled())
+        schedule(pwcResponseEvent, pwcResponses.front().first);
+}
+
+void
+Walker::coalesceWalks(WalkerState *done)
+{
+    if (!coalescing || done->squashed || done->timingFault != NoFault)
+        return;
+
+    const Addr page_mask = ~mask(done->entry.logBytes);
+    const Addr page = done->entry.vaddr & page_mask;
+
+    // Take the walks out of the queue first, as translating them again
+    // may queue new walks.
+    std::vector<WalkerState *> coalesced;
+    for (auto iter = currStates.begin(); iter != currStates.end();) {
+        WalkerState *walkerState = *iter;
+        if (!walkerState->wasStarted() && walkerState->tc == done->tc &&
+            !walkerState->translation->squashed() &&
+            (walkerState->req->getVaddr() & page_mask) == page) {
+            coalesced.push_back(walkerState);
+            iter = currStates.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+
+    for (WalkerState *walkerState : coalesced) {
+        DPRINTF(PageTableWalker, "Coalescing table walk for address %#x\n",
+                walkerState->req->getVaddr());
+        stats.coalescedWalks++;
+        // The page is in the TLB now, so this normally finishes the
+        // translation right away.
+        tlb->translateTiming(walkerState->req, walkerState->tc,
+                             walkerState->translation, walkerState->mode);
+        delete walkerState;
+    }
+}
+
+Walker::WalkerStats::WalkerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(pwcHits, statistics::units::Count::get(),
+               "Number of page table entries read from the page walk "
+               "cache"),
+      ADD_STAT(pwcMisses, statistics::units::Count::get(),
+               "Number of page table entry reads that missed in the page "
+               "walk cache"),
+      ADD_STAT(coalescedWalks, statistics::units::Count::get(),
+               "Number of walks completed by an earlier walk to the same "
+               "page")
+{
+}
+
 Port &
 Walker::getPort(const std::string &if_name, PortID idx)
 {
@@ -240,7 +349,7 @@ Walker::WalkerState::startWalk()
         sendPackets();
     } else {
         do {
-            walker->port.sendAtomic(read);
+            walker->sendAtomic(read);
             PacketPtr write = NULL;
             fault = stepWalk(write);
             assert(fault == NoFault || read == NULL);
@@ -505,10 +614,14 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     if (doEndWalk) {
         if (doTLBInsert)
             if (!functional)
-                walker->tlb->insert(entry.vaddr, entry);
+                walker->tlb->insert(entry.vaddr, entry, tc);
         endWalk();
     } else {
         PacketPtr oldRead = read;
+        // Upper level entries can be found in the page walk cache on
+        // the following walks.
+        if (!functional)
+            walker->pwcInsert(oldRead, pte);
         //If we didn't return, we're setting up another read.
         Request::Flags flags = oldRead->req->getFlags();
         flags.set(Request::UNCACHEABLE, uncacheable);
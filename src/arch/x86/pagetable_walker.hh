@@ -38,11 +38,15 @@
 #ifndef __ARCH_X86_PAGE_TABLE_WALKER_HH__
 #define __ARCH_X86_PAGE_TABLE_WALKER_HH__
 
+#include <deque>
+#include <utility>
 #include <vector>
 
 #include "arch/generic/mmu.hh"
+#include "arch/generic/page_walk_cache.hh"
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/X86PagetableWalker.hh"
@@ -190,6 +194,37 @@ namespace X86ISA
         bool recvTimingResp(PacketPtr pkt);
         void recvReqRetry();
         bool sendTiming(WalkerState * sendingState, PacketPtr pkt);
+        void sendAtomic(PacketPtr pkt);
+
+        // Cache of the upper level page table entries.
+        PageWalkCache pwc;
+        // The latency of a page walk cache hit.
+        const Cycles pwcLatency;
+        // Page walk cache hits waiting for their latency, in order.
+        std::deque<std::pair<Tick, PacketPtr>> pwcResponses;
+        EventFunctionWrapper pwcResponseEvent;
+
+        // Turn a read into a response if the page walk cache has the
+        // entry.
+        bool pwcAccess(PacketPtr pkt);
+        // Cache an upper level entry read by pkt.
+        void pwcInsert(PacketPtr pkt, uint64_t pte);
+        // Deliver the page walk cache hits that are due.
+        void sendPWCResponses();
+
+        // Complete the waiting walks to the page a finished walk just
+        // put in the TLB, instead of walking the page table again.
+        const bool coalescing;
+        void coalesceWalks(WalkerState *done);
+
+        struct WalkerStats : public statistics::Group
+        {
+            WalkerStats(statistics::Group *parent);
+
+            statistics::Scalar pwcHits;
+            statistics::Scalar pwcMisses;
+            statistics::Scalar coalescedWalks;
+        } stats;
 
       public:
 
@@ -198,6 +233,9 @@ namespace X86ISA
             tlb = _tlb;
         }
 
+        // Invalidate the page walk cache along with the TLB.
+        void flushPWC() { pwc.flush(); }
+
         using Params = X86PagetableWalkerParams;
 
         Walker(const Params &params) :
@@ -205,7 +243,11 @@ namespace X86ISA
             funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
             requestorId(sys->getRequestorId(this)),
             numSquashable(params.num_squash_per_cycle),
-            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
+            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name()),
+            pwc(params.pwc_entries), pwcLatency(params.pwc_latency),
+            pwcResponseEvent([this]{ sendPWCResponses(); },
+                             name() + ".pwcResponse"),
+            coalescing(params.coalesce_walks), stats(this)
         {
         }
     };
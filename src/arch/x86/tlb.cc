@@ -37,11 +37,13 @@
 
 #include "arch/x86/tlb.hh"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
 #include "arch/x86/faults.hh"
 #include "arch/x86/insts/microldstop.hh"
+#include "arch/x86/page_size.hh"
 #include "arch/x86/pagetable_walker.hh"
 #include "arch/x86/pseudo_inst_abi.hh"
 #include "arch/x86/regs/misc.hh"
@@ -64,41 +66,101 @@ namespace X86ISA {
 
 TLB::TLB(const Params &p)
     : BaseTLB(p), configAddress(0), size(p.size),
-      tlb(size), lruSeq(0), m5opRange(p.system->m5opRange()), stats(this)
+      assoc(p.assoc ? p.assoc : p.size), numSets(assoc ? size / assoc : 0),
+      tlb(size), replacementPolicy(p.replacement_policy), replEntries(size),
+      lruSeq(0), m5opRange(p.system->m5opRange()), stats(this)
 {
     if (!size)
         fatal("TLBs must have a non-zero size.\n");
+    fatal_if(size % assoc,
+             "TLB size must be a multiple of its associativity.\n");
 
     for (int x = 0; x < size; x++) {
         tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
+        replEntries[x].setPosition(x / assoc, x % assoc);
+        replEntries[x].replacementData =
+            replacementPolicy->instantiateEntry();
     }
+    candidates.reserve(assoc);
 
     walker = p.walker;
     walker->setTLB(this);
+    sharedTLB = p.shared_tlb;
 }
 
-void
-TLB::evictLRU()
+namespace
+{
+
+/*
+ * The TLB isn't tagged, so the entries in the shared TLB are tagged with
+ * the page table they come from instead. The PCID and the cache control
+ * bits of CR3 don't take part.
+ */
+uint64_t
+sharedContext(ThreadContext *tc)
 {
-    // Find the entry with the lowest (and hence least recently updated)
-    // sequence number.
+    return tc->readMiscRegNoEffect(misc_reg::Cr3) & ~mask(PageShift);
+}
+
+enum SharedAttributes
+{
+    SharedWritable = 0x1,
+    SharedUser = 0x2,
+    SharedUncacheable = 0x4,
+    SharedPatBit = 0x8,
+    SharedNoExec = 0x10
+};
+
+} // anonymous namespace
 
-    unsigned lru = 0;
-    for (unsigned i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
+TlbEntry *
+TLB::findVictim(Addr vpn, unsigned logBytes)
+{
+    // Pages are placed by their own page number, so the small pages
+    // that make up a large one don't all compete for one set.
+    TlbEntry *set = &tlb[((vpn >> logBytes) % numSets) * assoc];
+    candidates.clear();
+    for (uint32_t way = 0; way < assoc; way++) {
+        if (!set[way].trieHandle)
+            return &set[way];
+        candidates.push_back(&replEntries[&set[way] - tlb.data()]);
     }
 
-    assert(tlb[lru].trieHandle);
-    trie.remove(tlb[lru].trieHandle);
-    tlb[lru].trieHandle = NULL;
-    freeList.push_back(&tlb[lru]);
+    ReplaceableEntry *repl = replacementPolicy->getVictim(candidates);
+    TlbEntry *victim = &tlb[repl - replEntries.data()];
+    DPRINTF(TLB, "Evicting the entry for %#x.\n", victim->vaddr);
+    remove(victim);
+    return victim;
+}
+
+void
+TLB::remove(TlbEntry *entry)
+{
+    assert(entry->trieHandle);
+    trie.remove(entry->trieHandle);
+    entry->trieHandle = NULL;
+    replacementPolicy->invalidate(
+        replEntries[entry - tlb.data()].replacementData);
 }
 
 TlbEntry *
-TLB::insert(Addr vpn, const TlbEntry &entry)
+TLB::insert(Addr vpn, const TlbEntry &entry, ThreadContext *tc)
 {
+    if (sharedTLB && tc) {
+        SharedTLB::Entry shared;
+        shared.vaddr = vpn;
+        shared.logBytes = entry.logBytes;
+        shared.context = sharedContext(tc);
+        shared.global = entry.global;
+        shared.paddr = entry.paddr;
+        shared.attributes = (entry.writable ? SharedWritable : 0) |
+            (entry.user ? SharedUser : 0) |
+            (entry.uncacheable ? SharedUncacheable : 0) |
+            (entry.patBit ? SharedPatBit : 0) |
+            (entry.noExec ? SharedNoExec : 0);
+        sharedTLB->insert(shared);
+    }
+
     // If somebody beat us to it, just use that existing entry.
     TlbEntry *newEntry = trie.lookup(vpn);
     if (newEntry) {
@@ -106,26 +168,69 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
         return newEntry;
     }
 
-    if (freeList.empty())
-        evictLRU();
-
-    newEntry = freeList.front();
-    freeList.pop_front();
+    newEntry = findVictim(vpn, entry.logBytes);
 
     *newEntry = entry;
     newEntry->lruSeq = nextSeq();
     newEntry->vaddr = vpn;
     newEntry->trieHandle =
     trie.insert(vpn, TlbEntryTrie::MaxBits - entry.logBytes, newEntry);
+    replacementPolicy->reset(
+        replEntries[newEntry - tlb.data()].replacementData);
     return newEntry;
 }
 
+TlbEntry *
+TLB::lookupShared(Addr va, ThreadContext *tc)
+{
+    const SharedTLB::Entry *shared = sharedTLB->lookup(va, sharedContext(tc));
+    if (!shared)
+        return NULL;
+
+    TlbEntry entry;
+    entry.paddr = shared->paddr;
+    entry.vaddr = shared->vaddr;
+    entry.logBytes = shared->logBytes;
+    entry.global = shared->global;
+    entry.writable = shared->attributes & SharedWritable;
+    entry.user = shared->attributes & SharedUser;
+    entry.uncacheable = shared->attributes & SharedUncacheable;
+    entry.patBit = shared->attributes & SharedPatBit;
+    entry.noExec = shared->attributes & SharedNoExec;
+    return insert(entry.vaddr, entry);
+}
+
+void
+TLB::prefetch(Addr va, ThreadContext *tc)
+{
+    sharedTLB->prefetchCandidates(tc->contextId(), va >> PageShift,
+                                  prefetchVpns);
+    for (Addr vpn : prefetchVpns) {
+        Addr pf_va = vpn << PageShift;
+        if (lookup(pf_va, false) ||
+            sharedTLB->lookup(pf_va, sharedContext(tc), true)) {
+            continue;
+        }
+
+        DPRINTF(TLB, "Prefetching the translation of %#x.\n", pf_va);
+        auto req = std::make_shared<Request>(
+            pf_va, 1, Request::PREFETCH | (3 << AddrSizeFlagShift),
+            Request::funcRequestorId, 0, tc->contextId());
+        auto *translation = new SharedTLB::PrefetchTranslation(*sharedTLB);
+        if (walker->start(tc, translation, req, BaseMMU::Read) != NoFault)
+            delete translation;
+    }
+}
+
 TlbEntry *
 TLB::lookup(Addr va, bool update_lru)
 {
     TlbEntry *entry = trie.lookup(va);
-    if (entry && update_lru)
+    if (entry && update_lru) {
         entry->lruSeq = nextSeq();
+        replacementPolicy->touch(
+            replEntries[entry - tlb.data()].replacementData);
+    }
     return entry;
 }
 
@@ -134,12 +239,12 @@ TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
     for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
+        if (tlb[i].trieHandle)
+            remove(&tlb[i]);
     }
+    walker->flushPWC();
+    if (sharedTLB)
+        sharedTLB->flushAll();
 }
 
 void
@@ -153,23 +258,23 @@ TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
     for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle && !tlb[i].global) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
+        if (tlb[i].trieHandle && !tlb[i].global)
+            remove(&tlb[i]);
     }
+    walker->flushPWC();
+    if (sharedTLB)
+        sharedTLB->flushNonGlobal();
 }
 
 void
 TLB::demapPage(Addr va, uint64_t asn)
 {
     TlbEntry *entry = trie.lookup(va);
-    if (entry) {
-        trie.remove(entry->trieHandle);
-        entry->trieHandle = NULL;
-        freeList.push_back(entry);
-    }
+    if (entry)
+        remove(entry);
+    walker->flushPWC();
+    if (sharedTLB)
+        sharedTLB->demap(va);
 }
 
 namespace
@@ -405,8 +510,23 @@ TLB::translate(const RequestPtr &req,
                 } else {
                     stats.wrMisses++;
                 }
-                if (FullSystem) {
+                if (FullSystem && sharedTLB)
+                    entry = lookupShared(vaddr, tc);
+                if (entry && timing) {
+                    // Finish once the shared TLB has answered, the entry
+                    // is in this TLB by then.
+                    sharedTLB->respond([this, req, tc, translation, mode] {
+                        translateTiming(req, tc, translation, mode);
+                    });
+                    delayedResponse = true;
+                    return NoFault;
+                }
+                if (entry) {
+                    DPRINTF(TLB, "Miss was serviced by the shared TLB.\n");
+                } else if (FullSystem) {
                     Fault fault = walker->start(tc, translation, req, mode);
+                    if (sharedTLB && timing)
+                        prefetch(vaddr, tc);
                     if (timing || fault != NoFault) {
                         // This gets ignored in atomic mode.
                         delayedResponse = true;
@@ -556,7 +676,11 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = 0;
+    for (uint32_t x = 0; x < size; x++) {
+        if (tlb[x].trieHandle != NULL)
+            _size++;
+    }
     SERIALIZE_SCALAR(_size);
     SERIALIZE_SCALAR(lruSeq);
 
@@ -577,16 +701,20 @@ TLB::unserialize(CheckpointIn &cp)
         fatal("TLB size less than the one in checkpoint!");
     }
 
-    UNSERIALIZE_SCALAR(lruSeq);
+    std::vector<TlbEntry> entries(_size);
+    for (uint32_t x = 0; x < _size; x++)
+        entries[x].unserializeSection(cp, csprintf("Entry%d", x));
 
-    for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
+    // Fill the entries in from the least recently used one, so that the
+    // replacement policy sees them in the same order as before.
+    std::sort(entries.begin(), entries.end(),
+              [](const TlbEntry &a, const TlbEntry &b) {
+                  return a.lruSeq < b.lruSeq;
+              });
+    for (const auto &entry : entries)
+        insert(entry.vaddr, entry);
 
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        newEntry->trieHandle = trie.insert(newEntry->vaddr,
-            TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
-    }
+    UNSERIALIZE_SCALAR(lruSeq);
 }
 
 Port *
@@ -41,9 +41,11 @@
 #include <list>
 #include <vector>
 
+#include "arch/generic/shared_tlb.hh"
 #include "arch/generic/tlb.hh"
 #include "arch/x86/pagetable.hh"
 #include "base/trie.hh"
+#include "mem/cache/replacement_policies/base.hh"
 #include "mem/request.hh"
 #include "params/X86TLB.hh"
 #include "sim/stats.hh"
@@ -83,6 +85,10 @@ namespace X86ISA
 
         Walker * walker;
 
+        /** The last level TLB shared with other TLBs, if any */
+        SharedTLB *sharedTLB;
+        std::vector<Addr> prefetchVpns;
+
       public:
         Walker *getWalker();
 
@@ -94,10 +100,16 @@ namespace X86ISA
 
       protected:
         uint32_t size;
+        /** Ways per set, the ways of a set are contiguous in tlb */
+        uint32_t assoc;
+        uint32_t numSets;
 
         std::vector<TlbEntry> tlb;
 
-        EntryList freeList;
+        replacement_policy::Base *replacementPolicy;
+        /** Replacement state of the entries, indexed like tlb */
+        std::vector<ReplaceableEntry> replEntries;
+        ReplacementCandidates candidates;
 
         TlbEntryTrie trie;
         uint64_t lruSeq;
@@ -120,9 +132,18 @@ namespace X86ISA
                 BaseMMU::Translation *translation, BaseMMU::Mode mode,
                 bool &delayedResponse, bool timing);
 
+        /** Refills this TLB from the shared one if it has the entry. */
+        TlbEntry *lookupShared(Addr va, ThreadContext *tc);
+
+        /** Walks the pages the shared TLB predicts will miss next. */
+        void prefetch(Addr va, ThreadContext *tc);
+
       public:
 
-        void evictLRU();
+        /** Pick the entry to fill a page into, freeing it if needed. */
+        TlbEntry *findVictim(Addr vpn, unsigned logBytes);
+
+        void remove(TlbEntry *entry);
 
         uint64_t
         nextSeq()
@@ -156,7 +177,14 @@ namespace X86ISA
         Fault finalizePhysical(const RequestPtr &req, ThreadContext *tc,
                                BaseMMU::Mode mode) const override;
 
-        TlbEntry *insert(Addr vpn, const TlbEntry &entry);
+        /**
+         * Insert an entry.
+         *
+         * @param tc Thread context the entry was walked for. If set, the
+         * entry is filled into the shared TLB as well.
+         */
+        TlbEntry *insert(Addr vpn, const TlbEntry &entry,
+                         ThreadContext *tc = nullptr);
 
         // Checkpointing
         void serialize(CheckpointOut &cp) const override;
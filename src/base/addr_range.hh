@@ -283,6 +283,41 @@ class AddrRange
      */
     bool interleaved() const { return masks.size() > 0; }
 
+    /**
+     * Get the value the interleaving bits of an address must have to
+     * be part of this range.
+     *
+     * @return The interleaving match value
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t getIntlvMatch() const { return intlvMatch; }
+
+    /**
+     * Determine the value of the interleaving bits of an address, that
+     * is which of the ranges interleaved with this one the address
+     * belongs to. The address is not checked against the range bounds.
+     *
+     * @param a Address to select the interleaved range for
+     * @return The interleaving match value the address selects
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t
+    intlvSelect(Addr a) const
+    {
+        uint8_t sel = 0;
+        for (unsigned int i = 0; i < masks.size(); i++) {
+            Addr masked = a & masks[i];
+            // The result of an xor operation is 1 if the number
+            // of bits set is odd or 0 othersize, thefore it
+            // suffices to count the number of bits set to
+            // determine the i-th bit of sel.
+            sel |= (popCount(masked) % 2) << i;
+        }
+        return sel;
+    }
+
     /**
      * Determing the interleaving granularity of the range.
      *
@@ -474,19 +509,7 @@ class AddrRange
         // no interleaving, or with interleaving also if the selected
         // bits from the address match the interleaving value
         bool in_range = a >= _start && a < _end;
-        if (in_range) {
-            auto sel = 0;
-            for (unsigned int i = 0; i < masks.size(); i++) {
-                Addr masked = a & masks[i];
-                // The result of an xor operation is 1 if the number
-                // of bits set is odd or 0 othersize, thefore it
-                // suffices to count the number of bits set to
-                // determine the i-th bit of sel.
-                sel |= (popCount(masked) % 2) << i;
-            }
-            return sel == intlvMatch;
-        }
-        return false;
+        return in_range && intlvSelect(a) == intlvMatch;
     }
 
     /**
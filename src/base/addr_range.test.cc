@@ -835,6 +835,26 @@ TEST(AddrRangeTest, InterleavingAddressesGetOffset)
     EXPECT_EQ(expected_output, r.getOffset(value));
 }
 
+TEST(AddrRangeTest, InterleavingSelect)
+{
+    std::vector<Addr> masks;
+    masks.push_back((1 << 6) | (1 << 12));
+    masks.push_back(1 << 7);
+
+    for (uint8_t match = 0; match < 4; match++) {
+        AddrRange r(0x0, 0x10000, masks, match);
+        EXPECT_EQ(match, r.getIntlvMatch());
+        for (Addr addr = 0; addr < 0x10000; addr += 0x40) {
+            EXPECT_EQ(r.contains(addr), r.intlvSelect(addr) == match);
+        }
+    }
+
+    AddrRange r(0x0, 0x10000, masks, 0);
+    EXPECT_EQ(0, r.intlvSelect(0x1040));
+    EXPECT_EQ(1, r.intlvSelect(0x1000));
+    EXPECT_EQ(3, r.intlvSelect(0x00c0));
+}
+
 TEST(AddrRangeTest, InterleavingLessThanStartEquals)
 {
     Addr start1 = 0x0000FFFF;
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "base/addr_range_map.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * Look up addresses in a map of equally sized ranges with gaps between
+ * them, as in a system memory map. Half of the lookups miss.
+ */
+void
+BM_Contains(benchmark::State &state)
+{
+    const Addr range_size = 0x1000;
+    AddrRangeMap<int> map;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        const Addr start = 2 * i * range_size;
+        map.insert(AddrRange(start, start + range_size), i);
+    }
+
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<Addr> addr(0,
+        2 * state.range(0) * range_size - 1);
+    std::vector<Addr> addrs(4096);
+    for (auto &a : addrs)
+        a = addr(rng);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.contains(addrs[i]));
+        i = (i + 1) % addrs.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Contains)->Range(1, 1 << 10);
+
+/** Look up the same address repeatedly, which the map caches. */
+void
+BM_ContainsRepeated(benchmark::State &state)
+{
+    AddrRangeMap<int> map;
+    for (int i = 0; i < 64; i++)
+        map.insert(AddrRange(i * 0x2000, i * 0x2000 + 0x1000), i);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(map.contains(0x20010));
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ContainsRepeated);
+
+} // anonymous namespace
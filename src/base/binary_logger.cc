@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_logger.hh"
+
+#include <atomic>
+#include <cstring>
+#include <streambuf>
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+/** The messages of one thread waiting to be written to the stream. */
+struct BinaryLogger::Buffer
+{
+    std::vector<uint8_t> data;
+
+    /** The ids this thread has already looked up. */
+    std::unordered_map<std::string, uint32_t> strings;
+    std::unordered_map<const char *, uint32_t> formats;
+
+    template <typename T>
+    void
+    put(const T &value)
+    {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(&value);
+        data.insert(data.end(), p, p + sizeof(value));
+    }
+
+    void
+    put(const std::string &str)
+    {
+        put((uint32_t)str.size());
+        data.insert(data.end(), str.begin(), str.end());
+    }
+};
+
+namespace
+{
+
+/** Turn every line written to a stream into a call to logMessage(). */
+class LineBuf : public std::streambuf
+{
+  private:
+    Logger &logger;
+    std::string line;
+
+  protected:
+    int_type
+    overflow(int_type c) override
+    {
+        if (c == traits_type::eof())
+            return traits_type::not_eof(c);
+        line += traits_type::to_char_type(c);
+        if (c == '\n') {
+            logger.logMessage(MaxTick, "", "", line);
+            line.clear();
+        }
+        return c;
+    }
+
+    int
+    sync() override
+    {
+        if (!line.empty()) {
+            logger.logMessage(MaxTick, "", "", line);
+            line.clear();
+        }
+        return 0;
+    }
+
+  public:
+    LineBuf(Logger &l) : logger(l) {}
+};
+
+/** An ostream that owns its LineBuf. */
+class LineStream : public std::ostream
+{
+  private:
+    LineBuf buf;
+
+  public:
+    LineStream(Logger &logger) : std::ostream(nullptr), buf(logger)
+    {
+        rdbuf(&buf);
+    }
+};
+
+std::atomic<uint64_t> binaryLoggers(0);
+
+} // anonymous namespace
+
+BinaryLogger::BinaryLogger(std::ostream &_stream)
+    : stream(_stream), text(new LineStream(*this)), serial(++binaryLoggers)
+{
+    binary = true;
+    stream.write((const char *)&Magic, sizeof(Magic));
+    stream.write((const char *)&Version, sizeof(Version));
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    text->flush();
+    flush();
+}
+
+BinaryLogger::Buffer &
+BinaryLogger::buffer()
+{
+    thread_local uint64_t owner = 0;
+    thread_local Buffer *cached = nullptr;
+    if (owner != serial) {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.emplace_back(new Buffer);
+        cached = buffers.back().get();
+        cached->data.reserve(BufferBytes);
+        owner = serial;
+    }
+    return *cached;
+}
+
+void
+BinaryLogger::writeString(uint32_t id, const char *str, uint32_t size)
+{
+    const uint8_t type = StringRecord;
+    stream.write((const char *)&type, sizeof(type));
+    stream.write((const char *)&id, sizeof(id));
+    stream.write((const char *)&size, sizeof(size));
+    stream.write(str, size);
+}
+
+uint32_t
+BinaryLogger::stringId(Buffer &buf, const std::string &str)
+{
+    auto local = buf.strings.find(str);
+    if (local != buf.strings.end())
+        return local->second;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = strings.find(str);
+    if (it == strings.end()) {
+        it = strings.emplace(str, nextId++).first;
+        writeString(it->second, str.data(), str.size());
+    }
+    buf.strings.emplace(str, it->second);
+    return it->second;
+}
+
+uint32_t
+BinaryLogger::formatId(Buffer &buf, const char *fmt)
+{
+    // Format strings are literals, so they are told apart by address
+    auto local = buf.formats.find(fmt);
+    if (local != buf.formats.end())
+        return local->second;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = formats.find(fmt);
+    if (it == formats.end()) {
+        it = formats.emplace(fmt, nextId++).first;
+        writeString(it->second, fmt, std::strlen(fmt));
+    }
+    buf.formats.emplace(fmt, it->second);
+    return it->second;
+}
+
+void
+BinaryLogger::write(Buffer &buf)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stream.write((const char *)buf.data.data(), buf.data.size());
+    buf.data.clear();
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    Buffer &buf = buffer();
+    buf.put((uint8_t)TextRecord);
+    buf.put((uint64_t)when);
+    buf.put(stringId(buf, name));
+    buf.put(stringId(buf, flag));
+    buf.put(message);
+    if (buf.data.size() >= BufferBytes)
+        write(buf);
+}
+
+void
+BinaryLogger::logBinary(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const BinaryArgs &args)
+{
+    Buffer &buf = buffer();
+    buf.put((uint8_t)MessageRecord);
+    buf.put((uint64_t)when);
+    buf.put(stringId(buf, name));
+    buf.put(stringId(buf, flag));
+    buf.put(formatId(buf, fmt));
+    buf.put(args.count);
+    buf.put((uint32_t)args.bytes.size());
+    buf.data.insert(buf.data.end(), args.bytes.begin(), args.bytes.end());
+    if (buf.data.size() >= BufferBytes)
+        write(buf);
+}
+
+void
+BinaryLogger::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &buf : buffers) {
+        stream.write((const char *)buf->data.data(), buf->data.size());
+        buf->data.clear();
+    }
+    stream.flush();
+}
+
+} // namespace Trace
+} // namespace gem5
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_LOGGER_HH__
+#define __BASE_BINARY_LOGGER_HH__
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/trace.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace Trace {
+
+/**
+ * Logger that writes messages in a compact binary format without
+ * formatting them. A message is recorded as its tick, the ids of its
+ * object name, flag and format string, and its raw arguments, see
+ * BinaryArgs. Each string is written once, the first time it is seen.
+ * Every thread collects its messages in a buffer of its own, which is
+ * written out when it is full, so threads only synchronize once per
+ * buffer. util/decode_debug_trace.py turns the file back into text.
+ *
+ * Text written to getOstream() is recorded as preformatted messages, one
+ * per line.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    static constexpr uint64_t Magic = 0x43525444354d4547ULL; // "GEM5DTRC"
+    static constexpr uint32_t Version = 1;
+
+    enum Record : uint8_t
+    {
+        StringRecord = 1,
+        MessageRecord = 2,
+        TextRecord = 3,
+    };
+
+    /** The number of bytes each thread buffers before writing them. */
+    static constexpr size_t BufferBytes = 1 << 20;
+
+    BinaryLogger(std::ostream &stream);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    void logBinary(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const BinaryArgs &args) override;
+
+    std::ostream &getOstream() override { return *text; }
+
+    /** Write the buffers of all threads to the stream. */
+    void flush();
+
+  protected:
+    struct Buffer;
+
+    /** The buffer of the current thread, with its string ids. */
+    Buffer &buffer();
+
+    /** The id of a string, writing it to the stream if it is new. */
+    uint32_t stringId(Buffer &buf, const std::string &str);
+    uint32_t formatId(Buffer &buf, const char *fmt);
+
+    /** Write what a buffer holds to the stream. */
+    void write(Buffer &buf);
+
+    /** Write a string record, with the mutex held. */
+    void writeString(uint32_t id, const char *str, uint32_t size);
+
+    std::ostream &stream;
+    std::unique_ptr<std::ostream> text;
+
+    /** Protects the stream and the string tables. */
+    std::mutex mutex;
+    std::unordered_map<std::string, uint32_t> strings;
+    std::unordered_map<const char *, uint32_t> formats;
+    uint32_t nextId = 0;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+
+    /** Tells loggers apart in the per-thread buffer caches. */
+    const uint64_t serial;
+};
+
+} // namespace Trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_LOGGER_HH__
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "base/binary_logger.hh"
+#include "base/gtest/cur_tick_fake.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** Reads back the records of a binary trace. */
+class Reader
+{
+  private:
+    std::string data;
+    size_t pos = 0;
+
+  public:
+    Reader(const std::string &_data) : data(_data) {}
+
+    bool done() const { return pos >= data.size(); }
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        std::memcpy(&value, data.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return value;
+    }
+
+    std::string
+    getString()
+    {
+        uint32_t size = get<uint32_t>();
+        std::string str = data.substr(pos, size);
+        pos += size;
+        return str;
+    }
+};
+
+struct Opaque
+{
+    int value;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Opaque &o)
+{
+    return os << "opaque" << o.value;
+}
+
+} // anonymous namespace
+
+/** Test that arguments are encoded with their types. */
+TEST(BinaryArgsTest, EncodeArgs)
+{
+    Trace::BinaryArgs args;
+    const char *fmt = "%d %#x %c %s %s";
+    args.add(fmt, -5);
+    args.add(fmt, (uint16_t)0x10);
+    args.add(fmt, 'z');
+    args.add(fmt, "str");
+    args.add(fmt, std::string("ing"));
+    ASSERT_EQ(args.count, 5);
+
+    Reader reader(std::string(args.bytes.begin(), args.bytes.end()));
+    ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryArgs::Signed);
+    ASSERT_EQ(reader.get<uint8_t>(), sizeof(int));
+    ASSERT_EQ((int64_t)reader.get<uint64_t>(), -5);
+    ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryArgs::Unsigned);
+    ASSERT_EQ(reader.get<uint8_t>(), sizeof(uint16_t));
+    ASSERT_EQ(reader.get<uint64_t>(), 0x10);
+    ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryArgs::Char);
+    ASSERT_EQ(reader.get<uint8_t>(), 'z');
+    ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryArgs::String);
+    ASSERT_EQ(reader.getString(), "str");
+    ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryArgs::String);
+    ASSERT_EQ(reader.getString(), "ing");
+    ASSERT_TRUE(reader.done());
+}
+
+/**
+ * Test that other arguments are formatted with their own conversion,
+ * counting the arguments taken by '*' widths.
+ */
+TEST(BinaryArgsTest, EncodeFormatted)
+{
+    Trace::BinaryArgs args;
+    const char *fmt = "%*d %-8s|%%";
+    args.add(fmt, 3);
+    args.add(fmt, 4);
+    args.add(fmt, Opaque{7});
+
+    Reader reader(std::string(args.bytes.begin(), args.bytes.end()));
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryArgs::Signed);
+        reader.get<uint8_t>();
+        reader.get<uint64_t>();
+    }
+    ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryArgs::Formatted);
+    ASSERT_EQ(reader.getString(), "opaque7 ");
+    ASSERT_TRUE(reader.done());
+}
+
+/** Test the records a logger writes, and that strings are only sent once. */
+TEST(BinaryLoggerTest, Records)
+{
+    std::stringstream ss;
+    {
+        Trace::BinaryLogger logger(ss);
+        logger.dprintf_flag(10, "obj", "Flag", "value %d\n", 42);
+        logger.dprintf_flag(20, "obj", "Flag", "value %d\n", 43);
+        logger.getOstream() << "plain text\n";
+    }
+
+    Reader reader(ss.str());
+    ASSERT_EQ(reader.get<uint64_t>(), Trace::BinaryLogger::Magic);
+    ASSERT_EQ(reader.get<uint32_t>(), Trace::BinaryLogger::Version);
+
+    // The strings of the first message
+    std::string strings[3];
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryLogger::StringRecord);
+        uint32_t id = reader.get<uint32_t>();
+        ASSERT_LT(id, 3);
+        strings[id] = reader.getString();
+    }
+    ASSERT_EQ(strings[0], "obj");
+    ASSERT_EQ(strings[1], "Flag");
+    ASSERT_EQ(strings[2], "value %d\n");
+
+    // The empty name and flag of the text
+    ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryLogger::StringRecord);
+    ASSERT_EQ(reader.get<uint32_t>(), 3);
+    ASSERT_EQ(reader.getString(), "");
+
+    for (uint64_t tick : {10, 20}) {
+        ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryLogger::MessageRecord);
+        ASSERT_EQ(reader.get<uint64_t>(), tick);
+        ASSERT_EQ(reader.get<uint32_t>(), 0);
+        ASSERT_EQ(reader.get<uint32_t>(), 1);
+        ASSERT_EQ(reader.get<uint32_t>(), 2);
+        ASSERT_EQ(reader.get<uint8_t>(), 1);
+        ASSERT_EQ(reader.get<uint32_t>(), 10);
+        ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryArgs::Signed);
+        ASSERT_EQ(reader.get<uint8_t>(), sizeof(int));
+        ASSERT_EQ(reader.get<uint64_t>(), tick / 10 + 41);
+    }
+
+    ASSERT_EQ(reader.get<uint8_t>(), Trace::BinaryLogger::TextRecord);
+    ASSERT_EQ(reader.get<uint64_t>(), MaxTick);
+    ASSERT_EQ(reader.get<uint32_t>(), 3);
+    ASSERT_EQ(reader.get<uint32_t>(), 3);
+    ASSERT_EQ(reader.getString(), "plain text\n");
+    ASSERT_TRUE(reader.done());
+}
+
+/** Test that messages of ignored objects aren't recorded. */
+TEST(BinaryLoggerTest, Ignore)
+{
+    std::stringstream ss;
+    {
+        Trace::BinaryLogger logger(ss);
+        logger.addIgnore(ObjectMatch("obj"));
+        logger.dprintf_flag(10, "obj", "Flag", "value %d\n", 42);
+    }
+    ASSERT_EQ(ss.str().size(), sizeof(uint64_t) + sizeof(uint32_t));
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "base/circular_queue.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Push to and pop from a queue kept half full. */
+void
+BM_PushPop(benchmark::State &state)
+{
+    const size_t capacity = state.range(0);
+    CircularQueue<uint64_t> queue(capacity);
+    for (size_t i = 0; i < capacity / 2; i++)
+        queue.push_back(i);
+
+    uint64_t value = 0;
+    for (auto _ : state) {
+        queue.push_back(value++);
+        benchmark::DoNotOptimize(queue.front());
+        queue.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PushPop)->Range(8, 8 << 10);
+
+/** Walk the queue from the head to the tail with iterators. */
+void
+BM_Iterate(benchmark::State &state)
+{
+    const size_t capacity = state.range(0);
+    CircularQueue<uint64_t> queue(capacity);
+    // Make the contents wrap around the end of the storage
+    for (size_t i = 0; i < capacity / 2; i++) {
+        queue.push_back(i);
+        queue.pop_front();
+    }
+    while (!queue.full())
+        queue.push_back(queue.size());
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto v : queue)
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+
+BENCHMARK(BM_Iterate)->Range(8, 8 << 10);
+
+} // anonymous namespace
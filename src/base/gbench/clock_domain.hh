@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_GBENCH_CLOCK_DOMAIN_HH__
+#define __BASE_GBENCH_CLOCK_DOMAIN_HH__
+
+#include <string>
+
+#include "base/types.hh"
+#include "params/SrcClockDomain.hh"
+#include "params/VoltageDomain.hh"
+#include "sim/clock_domain.hh"
+#include "sim/voltage_domain.hh"
+
+namespace gem5
+{
+
+/**
+ * Create a clock domain, and the voltage domain it needs, for the
+ * clocked objects a benchmark creates outside of a simulated system.
+ *
+ * @param name Name of the clock domain
+ * @param period Clock period in ticks
+ */
+inline SrcClockDomain *
+makeBenchClockDomain(const std::string &name, Tick period)
+{
+    // SimObjects keep a reference to their parameters, which therefore
+    // live as long as the objects
+    auto *voltage_params = new VoltageDomainParams;
+    voltage_params->name = name + ".voltage_domain";
+    voltage_params->eventq_index = 0;
+    voltage_params->voltage = {1.0};
+
+    auto *clock_params = new SrcClockDomainParams;
+    clock_params->name = name;
+    clock_params->eventq_index = 0;
+    clock_params->clock = {period};
+    clock_params->domain_id = -1;
+    clock_params->init_perf_level = 0;
+    clock_params->voltage_domain = new VoltageDomain(*voltage_params);
+    return new SrcClockDomain(*clock_params);
+}
+
+} // namespace gem5
+
+#endif // __BASE_GBENCH_CLOCK_DOMAIN_HH__
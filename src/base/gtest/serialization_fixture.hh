@@ -109,6 +109,7 @@ class SerializationFixture : public ::testing::Test
         // There may be a cpt file inside, so try to remove it; otherwise,
         // rmdir does not work
         std::remove(getCptPath().c_str());
+        std::remove((getDirName() + CheckpointIn::binaryFilename).c_str());
         // Remove the directory we created on SetUp
         M5_VAR_USED int success = rmdir(dirName.c_str());
         assert(success == 0);
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/host_counters.hh"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace gem5
+{
+
+HostCounters::HostCounters()
+    : numOpen(0)
+{
+    for (int i = 0; i < NumCounters; i++) {
+        fds[i] = -1;
+        slots[i] = -1;
+    }
+}
+
+HostCounters::~HostCounters()
+{
+    close();
+}
+
+bool
+HostCounters::open()
+{
+#ifdef __linux__
+    static const uint64_t configs[NumCounters] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+    };
+
+    close();
+    for (int i = 0; i < NumCounters; i++) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        // The cycle counter leads the group, the others are optional.
+        int fd = syscall(__NR_perf_event_open, &attr, 0, -1,
+                         i == Cycles ? -1 : fds[Cycles], 0);
+        if (fd < 0) {
+            if (i == Cycles)
+                return false;
+            continue;
+        }
+        fds[i] = fd;
+        slots[i] = numOpen++;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+HostCounters::close()
+{
+#ifdef __linux__
+    // Close the group leader last.
+    for (int i = NumCounters - 1; i >= 0; i--) {
+        if (fds[i] >= 0)
+            ::close(fds[i]);
+        fds[i] = -1;
+        slots[i] = -1;
+    }
+#endif
+    numOpen = 0;
+}
+
+void
+HostCounters::read(uint64_t values[NumCounters]) const
+{
+    // A group read returns the number of counters followed by their
+    // values.
+    uint64_t buf[NumCounters + 1] = {};
+#ifdef __linux__
+    if (isOpen() && ::read(fds[Cycles], buf, sizeof(buf)) <= 0)
+        buf[0] = 0;
+#endif
+    for (int i = 0; i < NumCounters; i++) {
+        values[i] = slots[i] >= 0 && slots[i] < (int)buf[0] ?
+            buf[slots[i] + 1] : 0;
+    }
+}
+
+} // namespace gem5
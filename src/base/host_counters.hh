@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_HOST_COUNTERS_HH__
+#define __BASE_HOST_COUNTERS_HH__
+
+#include <cstdint>
+
+namespace gem5
+{
+
+/**
+ * A small set of host hardware performance counters (cycles, retired
+ * instructions and last level cache misses) counting the user space
+ * work of the calling thread. The counters are opened as a single
+ * perf_event group so all of them are read with one system call.
+ *
+ * Counters are only available on Linux hosts that allow unprivileged
+ * access to perf events. A counter the host doesn't support reads as
+ * zero.
+ */
+class HostCounters
+{
+  public:
+    enum Counter
+    {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        NumCounters
+    };
+
+    HostCounters();
+    ~HostCounters();
+
+    HostCounters(const HostCounters &) = delete;
+    HostCounters &operator=(const HostCounters &) = delete;
+
+    /**
+     * Start counting for the calling thread.
+     *
+     * @return true if at least the cycle counter could be opened.
+     */
+    bool open();
+
+    /** Stop counting and release the counters. */
+    void close();
+
+    bool isOpen() const { return fds[Cycles] >= 0; }
+
+    /**
+     * Read the current value of all counters.
+     *
+     * @param values Set to the counter values, indexed by Counter.
+     */
+    void read(uint64_t values[NumCounters]) const;
+
+  private:
+    /** File descriptor of each counter, negative if not open. */
+    int fds[NumCounters];
+    /** Position of each counter in a group read, negative if not open. */
+    int slots[NumCounters];
+    /** Number of counters in the group. */
+    int numOpen;
+};
+
+} // namespace gem5
+
+#endif // __BASE_HOST_COUNTERS_HH__
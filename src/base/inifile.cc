@@ -29,8 +29,10 @@
 #include "base/inifile.hh"
 
 #include <algorithm>
+#include <cctype>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -39,6 +41,25 @@
 namespace gem5
 {
 
+namespace
+{
+
+/// Strip the leading and trailing spaces in the manner of eat_white(),
+/// without copying the string.
+std::string_view
+trimSpaces(std::string_view s)
+{
+    auto first = s.find_first_not_of(' ');
+    if (first != std::string_view::npos)
+        s.remove_prefix(first);
+    auto last = s.find_last_not_of(' ');
+    if (last != std::string_view::npos)
+        s.remove_suffix(s.size() - last - 1);
+    return s;
+}
+
+} // anonymous namespace
+
 IniFile::IniFile()
 {}
 
@@ -78,11 +99,11 @@ IniFile::Section::addEntry(const std::string &entryName,
                            const std::string &value,
                            bool append)
 {
-    EntryTable::iterator ei = table.find(entryName);
+    auto [ei, inserted] = table.try_emplace(entryName, nullptr);
 
-    if (ei == table.end()) {
+    if (inserted) {
         // new entry
-        table[entryName] = new Entry(value);
+        ei->second = new Entry(value);
     }
     else if (append) {
         // append new reult to old entry
@@ -96,23 +117,21 @@ IniFile::Section::addEntry(const std::string &entryName,
 
 
 bool
-IniFile::Section::add(const std::string &assignment)
+IniFile::Section::add(std::string_view assignment)
 {
-    std::string::size_type offset = assignment.find('=');
-    if (offset == std::string::npos) {
+    std::string_view::size_type offset = assignment.find('=');
+    if (offset == std::string_view::npos) {
         // no '=' found
         std::cerr << "Can't parse .ini line " << assignment << std::endl;
         return false;
     }
 
     // if "+=" rather than just "=" then append value
-    bool append = (assignment[offset-1] == '+');
+    bool append = (offset > 0 && assignment[offset-1] == '+');
 
-    std::string entryName = assignment.substr(0, append ? offset-1 : offset);
-    std::string value = assignment.substr(offset + 1);
-
-    eat_white(entryName);
-    eat_white(value);
+    std::string entryName(
+        trimSpaces(assignment.substr(0, append ? offset-1 : offset)));
+    std::string value(trimSpaces(assignment.substr(offset + 1)));
 
     addEntry(entryName, value, append);
     return true;
@@ -133,17 +152,13 @@ IniFile::Section::findEntry(const std::string &entryName) const
 IniFile::Section *
 IniFile::addSection(const std::string &sectionName)
 {
-    SectionTable::iterator i = table.find(sectionName);
+    auto [i, inserted] = table.try_emplace(sectionName, nullptr);
 
-    if (i != table.end()) {
-        return i->second;
-    }
-    else {
+    if (inserted) {
         // new entry
-        Section *sec = new Section();
-        table[sectionName] = sec;
-        return sec;
+        i->second = new Section();
     }
+    return i->second;
 }
 
 
@@ -180,23 +195,33 @@ IniFile::load(std::istream &f)
 {
     Section *section = NULL;
 
-    while (!f.eof()) {
-        f >> std::ws; // Eat whitespace
-        if (f.eof()) {
-            break;
+    // Read the whole file in one go and split it in place, rather than
+    // copying it out line by line. A config.ini of a large system runs
+    // into megabytes.
+    const std::string buf((std::istreambuf_iterator<char>(f)),
+                          std::istreambuf_iterator<char>());
+    const std::string_view text(buf);
+
+    std::string_view::size_type pos = 0;
+    while (pos < text.size()) {
+        // Eat whitespace, including any blank lines
+        if (std::isspace(static_cast<unsigned char>(text[pos]))) {
+            pos++;
+            continue;
         }
 
-        std::string line;
-        getline(f, line);
-        if (line.size() == 0)
-            continue;
+        auto eol = text.find('\n', pos);
+        if (eol == std::string_view::npos)
+            eol = text.size();
+        std::string_view line = text.substr(pos, eol - pos);
+        pos = eol + 1;
 
-        eat_end_white(line);
-        int last = line.size() - 1;
+        auto last = line.find_last_not_of(' ');
+        line = line.substr(0, last + 1);
+        last = line.size() - 1;
 
         if (line[0] == '[' && line[last] == ']') {
-            std::string sectionName = line.substr(1, last - 1);
-            eat_white(sectionName);
+            std::string sectionName(trimSpaces(line.substr(1, last - 1)));
             section = addSection(sectionName);
             continue;
         }
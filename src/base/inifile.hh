@@ -29,10 +29,12 @@
 #ifndef __INIFILE_HH__
 #define __INIFILE_HH__
 
+#include <atomic>
 #include <fstream>
 #include <functional>
 #include <list>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -62,7 +64,9 @@ class IniFile
     class Entry
     {
         std::string     value;          ///< The entry value.
-        mutable bool    referenced;     ///< Has this entry been used?
+        /// Has this entry been used? Lookups may come from several
+        /// threads at once, see CxxConfigManager::findAllObjectParams.
+        mutable std::atomic<bool> referenced;
 
       public:
         /// Constructor.
@@ -97,7 +101,8 @@ class IniFile
         typedef std::unordered_map<std::string, Entry *> EntryTable;
 
         EntryTable      table;          ///< Table of entries.
-        mutable bool    referenced;     ///< Has this section been used?
+        /// Has this section been used?
+        mutable std::atomic<bool> referenced;
 
       public:
         /// Constructor.
@@ -121,7 +126,7 @@ class IniFile
         /// "param+=value" (for append).  This funciton parses the
         /// assignment statment and calls addEntry().
         /// @retval True for success, false if parse error.
-        bool add(const std::string &assignment);
+        bool add(std::string_view assignment);
 
         /// Find the entry with the given name.
         /// @retval Pointer to the entry object, or NULL if none.
@@ -92,6 +92,30 @@ TEST(Initest, MatchFound)
     ASSERT_STREQ(value.c_str(), "89");
 }
 
+TEST(Initest, Layout)
+{
+    // Indented and blank lines, entries before any section, spaces
+    // around the names and no newline at the end of the file
+    std::istringstream file("Orphan=1\n\n  [ Sec ]  \n\t a = b c  \n"
+                            "\n\nd+=e\nd += f");
+    IniFile simConfigDB;
+    ASSERT_TRUE(simConfigDB.load(file));
+
+    std::string value;
+    ASSERT_TRUE(simConfigDB.find("Sec", "a", value));
+    ASSERT_EQ(value, "b c");
+    ASSERT_TRUE(simConfigDB.find("Sec", "d", value));
+    ASSERT_EQ(value, "e f");
+    ASSERT_FALSE(simConfigDB.entryExists("Sec", "Orphan"));
+}
+
+TEST(Initest, ParseError)
+{
+    std::istringstream file("[Sec]\nnot an assignment\n");
+    IniFile simConfigDB;
+    ASSERT_FALSE(simConfigDB.load(file));
+}
+
 TEST(Initest, MatchNotFound)
 {
     IniFile simConfigDB;
@@ -298,6 +298,77 @@ log2i(int value)
     return ctz32(value);
 }
 
+/**
+ * Divides by a divisor that rarely changes, such as a clock period, by
+ * multiplying with a pre-computed reciprocal rather than dividing. A
+ * power of 2 divisor is a plain shift.
+ *
+ * @ingroup api_base_utils
+ */
+class InvariantDivider
+{
+  private:
+    uint64_t _divisor;
+
+    /** floor(2^64 / divisor), unused if the divisor is a power of 2 */
+    uint64_t reciprocal;
+
+    /** log2 of the divisor if it is a power of 2, -1 otherwise */
+    int shift;
+
+  public:
+    constexpr InvariantDivider(uint64_t divisor=1)
+        : _divisor(1), reciprocal(0), shift(0)
+    {
+        set(divisor);
+    }
+
+    constexpr void
+    set(uint64_t divisor)
+    {
+        assert(divisor > 0);
+        _divisor = divisor;
+        if (isPowerOf2(divisor)) {
+            shift = floorLog2(divisor);
+            reciprocal = 0;
+        } else {
+            // 2^64 is not a multiple of the divisor, so this is the same
+            // as floor(2^64 / divisor)
+            shift = -1;
+            reciprocal = UINT64_MAX / divisor;
+        }
+    }
+
+    constexpr uint64_t divisor() const { return _divisor; }
+
+    /**
+     * @return floor(n / divisor)
+     */
+    constexpr uint64_t
+    divide(uint64_t n) const
+    {
+        if (shift >= 0)
+            return n >> shift;
+
+        // As the reciprocal is rounded down, the quotient can be at
+        // most one too small
+        uint64_t q = mulUnsigned<uint64_t>(n, reciprocal).first;
+        if (n - q * _divisor >= _divisor)
+            ++q;
+        return q;
+    }
+
+    /**
+     * @return ceil(n / divisor)
+     */
+    constexpr uint64_t
+    divCeil(uint64_t n) const
+    {
+        const uint64_t q = divide(n);
+        return n == q * _divisor ? q : q + 1;
+    }
+};
+
 } // namespace gem5
 
 #endif // __BASE_INTMATH_HH__
@@ -38,6 +38,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <tuple>
 
 #include "base/intmath.hh"
@@ -330,3 +331,43 @@ TEST(IntmathDeathTest, Log2iDeath)
         log2i(value);
     }, "isPowerOf2");
 }
+
+TEST(IntmathTest, InvariantDivider)
+{
+    const uint64_t divisors[] = {1, 2, 3, 7, 64, 250, 333, 500, 1000,
+                                 1ULL << 40, (1ULL << 40) + 1,
+                                 UINT64_MAX / 3, UINT64_MAX};
+    const uint64_t values[] = {0, 1, 2, 3, 499, 500, 501, 999999,
+                               1ULL << 32, (1ULL << 63) - 1, 1ULL << 63,
+                               UINT64_MAX - 1, UINT64_MAX};
+
+    for (auto d : divisors) {
+        InvariantDivider div(d);
+        EXPECT_EQ(d, div.divisor());
+        for (auto n : values) {
+            EXPECT_EQ(n / d, div.divide(n)) << n << " / " << d;
+            EXPECT_EQ(n / d + (n % d != 0), div.divCeil(n))
+                << n << " / " << d;
+        }
+        // Multiples of the divisor and the values just below them
+        const uint64_t quotients[] = {1, std::min<uint64_t>(12345,
+                                                            UINT64_MAX / d),
+                                      UINT64_MAX / d};
+        for (auto q : quotients) {
+            const uint64_t n = q * d;
+            EXPECT_EQ(q, div.divide(n));
+            EXPECT_EQ(q, div.divCeil(n));
+            EXPECT_EQ(q - 1, div.divide(n - 1));
+            EXPECT_EQ(d == 1 ? q - 1 : q, div.divCeil(n - 1));
+        }
+    }
+}
+
+TEST(IntmathTest, InvariantDividerSet)
+{
+    InvariantDivider div(500);
+    EXPECT_EQ(2, div.divCeil(1000));
+    div.set(256);
+    EXPECT_EQ(4, div.divCeil(1000));
+    EXPECT_EQ(3, div.divide(1000));
+}
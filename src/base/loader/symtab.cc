@@ -46,7 +46,8 @@ SymbolTable debugSymbolTable;
 void
 SymbolTable::clear()
 {
-    addrMap.clear();
+    addrIndex.clear();
+    addrIndexValid = true;
     nameMap.clear();
     symbols.clear();
 }
@@ -62,12 +63,18 @@ SymbolTable::insert(const Symbol &symbol)
     if (!nameMap.insert({ symbol.name, idx }).second)
         return false;
 
-    // There can be multiple symbols for the same address, so always
-    // update the addrTable multimap when we see a new symbol name.
-    addrMap.insert({ symbol.address, idx });
-
     symbols.emplace_back(symbol);
 
+    // There can be multiple symbols for the same address. Symbols are
+    // mostly inserted in address order, in which case the index can be
+    // extended in place instead of being sorted again on the next lookup.
+    if (addrIndexValid && (addrIndex.empty() ||
+            symbols[addrIndex.back()].address <= symbol.address)) {
+        addrIndex.push_back(idx);
+    } else {
+        addrIndexValid = false;
+    }
+
     return true;
 }
 
@@ -75,14 +82,12 @@ bool
 SymbolTable::insert(const SymbolTable &other)
 {
     // Check if any symbol in other already exists in our table.
-    NameMap intersection;
-    std::set_intersection(other.nameMap.begin(), other.nameMap.end(),
-                          nameMap.begin(), nameMap.end(),
-                          std::inserter(intersection, intersection.begin()),
-                          nameMap.value_comp());
-    if (!intersection.empty())
-        return false;
+    for (const Symbol &symbol: other) {
+        if (nameMap.count(symbol.name))
+            return false;
+    }
 
+    reserve(symbols.size() + other.symbols.size());
     for (const Symbol &symbol: other)
         insert(symbol);
 
@@ -30,11 +30,12 @@
 #ifndef __BASE_LOADER_SYMTAB_HH__
 #define __BASE_LOADER_SYMTAB_HH__
 
+#include <algorithm>
 #include <functional>
 #include <iosfwd>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/compiler.hh"
@@ -70,15 +71,45 @@ class SymbolTable
   private:
     /** Vector containing all the symbols in the table. */
     typedef std::vector<Symbol> SymbolVector;
-    /** Map addresses to an index into the symbol vector. */
-    typedef std::multimap<Addr, int> AddrMap;
+    /**
+     * Indices into the symbol vector, sorted by address. Symbols that
+     * share an address keep their insertion order.
+     */
+    typedef std::vector<int> AddrIndex;
     /** Map a symbol name to an index into the symbol vector. */
-    typedef std::map<std::string, int> NameMap;
+    typedef std::unordered_map<std::string, int> NameMap;
 
     SymbolVector symbols;
-    AddrMap addrMap;
     NameMap nameMap;
 
+    /**
+     * The address index is only built when an address lookup needs it,
+     * so that loading large binaries does not pay for keeping it sorted
+     * on every insertion, and tables that are never searched by address
+     * never build it at all. Lookups are therefore not safe to run
+     * concurrently with insertions.
+     */
+    mutable AddrIndex addrIndex;
+    mutable bool addrIndexValid = true;
+
+    /** Sort the address index if symbols were inserted since the last
+     * address lookup. */
+    void
+    updateAddrIndex() const
+    {
+        if (addrIndexValid)
+            return;
+
+        addrIndex.resize(symbols.size());
+        for (int i = 0; i < addrIndex.size(); i++)
+            addrIndex[i] = i;
+        std::stable_sort(addrIndex.begin(), addrIndex.end(),
+            [this](int a, int b) {
+                return symbols[a].address < symbols[b].address;
+            });
+        addrIndexValid = true;
+    }
+
     /**
      * Get the first address larger than the given address, if any.
      *
@@ -87,13 +118,16 @@ class SymbolTable
      * @return True if successful; false if no larger addresses exist.
      */
     bool
-    upperBound(Addr addr, AddrMap::const_iterator &iter) const
+    upperBound(Addr addr, AddrIndex::const_iterator &iter) const
     {
+        updateAddrIndex();
+
         // find first key *larger* than desired address
-        iter = addrMap.upper_bound(addr);
+        iter = std::upper_bound(addrIndex.begin(), addrIndex.end(), addr,
+            [this](Addr a, int idx) { return a < symbols[idx].address; });
 
         // if very first key is larger, we're out of luck
-        if (iter == addrMap.begin())
+        if (iter == addrIndex.begin())
             return false;
 
         return true;
@@ -178,6 +212,19 @@ class SymbolTable
     /** Clears the table. */
     void clear();
 
+    /**
+     * Reserve space for a number of symbols, e.g., before loading the
+     * symbol table section of an object file.
+     *
+     * @param count The total number of symbols expected.
+     */
+    void
+    reserve(size_t count)
+    {
+        symbols.reserve(count);
+        nameMap.reserve(count);
+    }
+
     /**
      * Insert a new symbol in the table if it does not already exist. The
      * symbol must have a defined name.
@@ -203,6 +250,9 @@ class SymbolTable
      */
     bool empty() const { return symbols.empty(); }
 
+    /** @return The number of symbols in the table. */
+    size_t size() const { return symbols.size(); }
+
     /**
      * Generate a new table by applying an offset to the symbols of the
      * current table. The current table is not modified.
@@ -321,13 +371,16 @@ class SymbolTable
     const_iterator
     find(Addr address) const
     {
-        AddrMap::const_iterator i = addrMap.find(address);
-        if (i == addrMap.end())
+        updateAddrIndex();
+        auto i = std::lower_bound(addrIndex.begin(), addrIndex.end(),
+            address,
+            [this](int idx, Addr a) { return symbols[idx].address < a; });
+        if (i == addrIndex.end() || symbols[*i].address != address)
             return end();
 
         // There are potentially multiple symbols that map to the same
         // address. For simplicity, just return the first one.
-        return symbols.begin() + i->second;
+        return symbols.begin() + *i;
     }
 
     /**
@@ -360,19 +413,19 @@ class SymbolTable
     const_iterator
     findNearest(Addr addr, Addr &next_addr) const
     {
-        AddrMap::const_iterator i = addrMap.end();
+        AddrIndex::const_iterator i;
         if (!upperBound(addr, i))
             return end();
 
         // If there is no next address, make it 0 since 0 is not larger than
         // any other address, so it is clear that next is not valid
-        if (i == addrMap.end()) {
+        if (i == addrIndex.end()) {
             next_addr = 0;
         } else {
-            next_addr = i->first;
+            next_addr = symbols[*i].address;
         }
         --i;
-        return symbols.begin() + i->second;
+        return symbols.begin() + *i;
     }
 
     /**
@@ -382,12 +435,12 @@ class SymbolTable
     const_iterator
     findNearest(Addr addr) const
     {
-        AddrMap::const_iterator i = addrMap.end();
+        AddrIndex::const_iterator i;
         if (!upperBound(addr, i))
             return end();
 
         --i;
-        return symbols.begin() + i->second;
+        return symbols.begin() + *i;
     }
 };
 
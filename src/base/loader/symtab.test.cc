@@ -640,6 +640,51 @@ TEST(LoaderSymtabTest, FindNearestNonExistent)
     ASSERT_EQ(it, symtab.end());
 }
 
+/**
+ * Test that address searches work when the symbols are not inserted in
+ * address order, including after new symbols are inserted between searches.
+ */
+TEST(LoaderSymtabTest, FindUnorderedInsertion)
+{
+    Loader::SymbolTable symtab;
+
+    Loader::Symbol symbols[] = {
+        {Loader::Symbol::Binding::Local, "symbol", 0x30},
+        {Loader::Symbol::Binding::Local, "symbol2", 0x10},
+        {Loader::Symbol::Binding::Local, "symbol3", 0x30},
+        {Loader::Symbol::Binding::Local, "symbol4", 0x20},
+    };
+    EXPECT_TRUE(symtab.insert(symbols[0]));
+    EXPECT_TRUE(symtab.insert(symbols[1]));
+
+    Addr next_addr;
+    auto it = symtab.findNearest(0x28, next_addr);
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[1]);
+    ASSERT_EQ(next_addr, symbols[0].address);
+
+    EXPECT_TRUE(symtab.insert(symbols[2]));
+    EXPECT_TRUE(symtab.insert(symbols[3]));
+
+    it = symtab.findNearest(0x28, next_addr);
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[3]);
+    ASSERT_EQ(next_addr, symbols[0].address);
+
+    // The first symbol inserted at an address is the one found
+    it = symtab.find(0x30);
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[0]);
+
+    // The nearest lookup, however, returns the last one, as it did when the
+    // address index was kept in a multimap
+    it = symtab.findNearest(0x38);
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[2]);
+
+    ASSERT_EQ(symtab.find(0x18), symtab.end());
+}
+
 /**
  * Test that the insertion of a symbol table's symbols in another table works
  * when any symbol name conflicts.
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_POOL_ALLOCATOR_HH__
+#define __BASE_POOL_ALLOCATOR_HH__
+
+#include <cstddef>
+#include <new>
+
+namespace gem5
+{
+
+/**
+ * Per-thread list of free blocks of a fixed size. Blocks released by a
+ * thread are kept for its next allocations instead of going back to the
+ * heap, up to MaxFree blocks. A block may be released by a different
+ * thread than the one that allocated it, in which case it simply moves
+ * to the releasing thread's list.
+ *
+ * The state of each thread's list is trivially destructible, so it stays
+ * usable while other thread_local and static objects are destroyed.
+ * Blocks released after the thread has started exiting go straight back
+ * to the heap.
+ *
+ * @tparam Size Size of the blocks, in bytes
+ * @tparam Align Alignment of the blocks, in bytes
+ */
+template <std::size_t Size, std::size_t Align>
+class FreeList
+{
+  private:
+    union Node
+    {
+        Node *next;
+        alignas(Align) unsigned char storage[Size];
+    };
+
+    static constexpr std::size_t MaxFree = 4096;
+
+    struct State
+    {
+        Node *head;
+        std::size_t size;
+        bool exiting;
+    };
+
+    static State &
+    state()
+    {
+        static thread_local State _state;
+        return _state;
+    }
+
+    /** Returns the blocks of the thread to the heap when it exits. */
+    struct Cleaner
+    {
+        ~Cleaner()
+        {
+            State &s = state();
+            while (s.head) {
+                Node *node = s.head;
+                s.head = node->next;
+                ::operator delete(node);
+            }
+            s.size = 0;
+            s.exiting = true;
+        }
+    };
+
+  public:
+    static void *
+    allocate()
+    {
+        State &s = state();
+        if (s.head) {
+            Node *node = s.head;
+            s.head = node->next;
+            s.size--;
+            return node;
+        }
+        return ::operator new(sizeof(Node));
+    }
+
+    static void
+    release(void *p)
+    {
+        State &s = state();
+        if (s.exiting || s.size == MaxFree) {
+            ::operator delete(p);
+            return;
+        }
+        if (!s.head) {
+            // Make sure the list is emptied when the thread exits
+            static thread_local Cleaner cleaner;
+            (void)cleaner;
+        }
+        Node *node = static_cast<Node *>(p);
+        node->next = s.head;
+        s.head = node;
+        s.size++;
+    }
+
+    /** Number of free blocks held by the calling thread. */
+    static std::size_t size() { return state().size; }
+};
+
+/**
+ * Standard allocator that recycles single objects through a FreeList.
+ * Allocations of several objects at once are passed to the heap. It is
+ * meant for small objects with a high turnover, and can be given to
+ * std::allocate_shared() so that the control block is recycled along
+ * with the object.
+ *
+ * @tparam T Type of the allocated objects
+ */
+template <class T>
+class PoolAllocator
+{
+  private:
+    using List = FreeList<sizeof(T), alignof(T)>;
+
+  public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        if (n != 1)
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        return static_cast<T *>(List::allocate());
+    }
+
+    void
+    deallocate(T *p, std::size_t n)
+    {
+        if (n != 1)
+            ::operator delete(p);
+        else
+            List::release(p);
+    }
+
+    template <class U>
+    bool operator==(const PoolAllocator<U> &) const { return true; }
+
+    template <class U>
+    bool operator!=(const PoolAllocator<U> &) const { return false; }
+};
+
+} // namespace gem5
+
+#endif // __BASE_POOL_ALLOCATOR_HH__
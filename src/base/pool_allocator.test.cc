@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "base/pool_allocator.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Object
+{
+    uint64_t a;
+    uint64_t b;
+    uint32_t c;
+};
+
+} // anonymous namespace
+
+/** Test that a released object is handed out again. */
+TEST(PoolAllocatorTest, Recycle)
+{
+    PoolAllocator<Object> alloc;
+    Object *first = alloc.allocate(1);
+    alloc.deallocate(first, 1);
+    Object *second = alloc.allocate(1);
+    ASSERT_EQ(first, second);
+    alloc.deallocate(second, 1);
+}
+
+/** Test that objects are recycled in LIFO order. */
+TEST(PoolAllocatorTest, Order)
+{
+    PoolAllocator<Object> alloc;
+    Object *first = alloc.allocate(1);
+    Object *second = alloc.allocate(1);
+    ASSERT_NE(first, second);
+    const std::size_t free = FreeList<sizeof(Object),
+                                      alignof(Object)>::size();
+    alloc.deallocate(first, 1);
+    alloc.deallocate(second, 1);
+    ASSERT_EQ((FreeList<sizeof(Object), alignof(Object)>::size()),
+              free + 2);
+    ASSERT_EQ(alloc.allocate(1), second);
+    ASSERT_EQ(alloc.allocate(1), first);
+    alloc.deallocate(first, 1);
+    alloc.deallocate(second, 1);
+}
+
+/** Test that arrays bypass the free list. */
+TEST(PoolAllocatorTest, Array)
+{
+    using List = FreeList<sizeof(Object), alignof(Object)>;
+    PoolAllocator<Object> alloc;
+    const std::size_t free = List::size();
+    Object *objs = alloc.allocate(4);
+    objs[3].c = 3;
+    alloc.deallocate(objs, 4);
+    ASSERT_EQ(List::size(), free);
+}
+
+/** Test that shared pointers recycle their control block. */
+TEST(PoolAllocatorTest, SharedPtr)
+{
+    const Object *first;
+    {
+        auto ptr = std::allocate_shared<Object>(PoolAllocator<Object>(),
+                                                Object{1, 2, 3});
+        first = ptr.get();
+        ASSERT_EQ(ptr->b, 2);
+    }
+    auto ptr = std::allocate_shared<Object>(PoolAllocator<Object>());
+    ASSERT_EQ(ptr.get(), first);
+}
+
+/** Test that an object released by another thread joins its list. */
+TEST(PoolAllocatorTest, OtherThread)
+{
+    using List = FreeList<sizeof(Object), alignof(Object)>;
+    PoolAllocator<Object> alloc;
+    Object *obj = alloc.allocate(1);
+    const std::size_t free = List::size();
+
+    std::size_t other_free = 0;
+    std::thread other([&]() {
+        alloc.deallocate(obj, 1);
+        other_free = List::size();
+    });
+    other.join();
+
+    ASSERT_EQ(other_free, 1);
+    ASSERT_EQ(List::size(), free);
+}
@@ -98,4 +98,41 @@ Random::unserialize(CheckpointIn &cp)
 
 Random random_mt;
 
+uint64_t RandomStream::streamSeed = 5489;
+
+RandomStream::RandomStream(const std::string &name)
+{
+    init(name, streamSeed);
+}
+
+RandomStream::RandomStream(const std::string &name, uint64_t seed)
+{
+    init(name, seed);
+}
+
+void
+RandomStream::init(const std::string &name, uint64_t seed)
+{
+    // FNV-1a rather than std::hash, which may differ between hosts
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : name)
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    key = mix(hash ^ mix(seed));
+    counter = 0;
+}
+
+void
+RandomStream::serialize(CheckpointOut &cp) const
+{
+    SERIALIZE_SCALAR(key);
+    SERIALIZE_SCALAR(counter);
+}
+
+void
+RandomStream::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_SCALAR(key);
+    UNSERIALIZE_SCALAR(counter);
+}
+
 } // namespace gem5
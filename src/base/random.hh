@@ -45,6 +45,7 @@
 #ifndef __BASE_RANDOM_HH__
 #define __BASE_RANDOM_HH__
 
+#include <cstdint>
 #include <random>
 #include <string>
 #include <type_traits>
@@ -125,6 +126,110 @@ class Random : public Serializable
  */
 extern Random random_mt;
 
+/**
+ * A counter-based random number stream. The n-th number of a stream is
+ * a function of the key of the stream and n alone (SplitMix64), so what
+ * an object draws does not depend on what other objects draw before it,
+ * or on the thread or event queue it runs in. The key is derived from a
+ * name, normally that of the owning SimObject, and the stream seed, and
+ * the only state is the counter, which makes streams cheap to create
+ * and to checkpoint.
+ *
+ * The stream is a UniformRandomBitGenerator, so it can also be used
+ * with the standard distributions.
+ */
+class RandomStream : public Serializable
+{
+  private:
+    /** Seed shared by all the streams created after it is set */
+    static uint64_t streamSeed;
+
+    uint64_t key;
+    uint64_t counter;
+
+    static constexpr uint64_t
+    mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+  public:
+    using result_type = uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    /**
+     * @param name Name the key of the stream is derived from
+     * @param seed Seed to use instead of the stream seed
+     *
+     * @ingroup api_base_utils
+     * @{
+     */
+    explicit RandomStream(const std::string &name);
+    RandomStream(const std::string &name, uint64_t seed);
+    /** @} */ // end of api_base_utils
+
+    /** Restart the stream with a new key. */
+    void init(const std::string &name, uint64_t seed);
+
+    /** Set the seed used by the streams created from now on. */
+    static void setSeed(uint64_t seed) { streamSeed = seed; }
+    static uint64_t seed() { return streamSeed; }
+
+    /** Number of words drawn from the stream so far. */
+    uint64_t position() const { return counter; }
+
+    /**
+     * @ingroup api_base_utils
+     */
+    result_type
+    operator()()
+    {
+        return mix(key + ++counter * 0x9e3779b97f4a7c15ULL);
+    }
+
+    /**
+     * @ingroup api_base_utils
+     */
+    template <typename T>
+    typename std::enable_if_t<std::is_integral_v<T>, T>
+    random()
+    {
+        // [0, max_value] for integer types
+        std::uniform_int_distribution<T> dist;
+        return dist(*this);
+    }
+
+    /**
+     * @ingroup api_base_utils
+     */
+    template <typename T>
+    typename std::enable_if_t<std::is_floating_point_v<T>, T>
+    random()
+    {
+        // [0, 1) for real types
+        std::uniform_real_distribution<T> dist;
+        return dist(*this);
+    }
+
+    /**
+     * @ingroup api_base_utils
+     */
+    template <typename T>
+    typename std::enable_if_t<std::is_integral_v<T>, T>
+    random(T min, T max)
+    {
+        std::uniform_int_distribution<T> dist(min, max);
+        return dist(*this);
+    }
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+};
+
 } // namespace gem5
 
 #endif // __BASE_RANDOM_HH__
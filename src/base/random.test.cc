@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "base/random.hh"
+
+using namespace gem5;
+
+/** Test that a stream only depends on its name and seed. */
+TEST(RandomStreamTest, Reproducible)
+{
+    RandomStream a("system.cpu", 1);
+    RandomStream b("system.cpu", 1);
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQ(a(), b());
+    ASSERT_EQ(a.position(), 100);
+}
+
+/** Test that different names and seeds give different streams. */
+TEST(RandomStreamTest, Keys)
+{
+    RandomStream a("system.cpu0", 1);
+    RandomStream b("system.cpu1", 1);
+    RandomStream c("system.cpu0", 2);
+    uint64_t first = a();
+    ASSERT_NE(first, b());
+    ASSERT_NE(first, c());
+}
+
+/**
+ * Test that what a stream produces does not depend on the use of other
+ * streams in between.
+ */
+TEST(RandomStreamTest, Independent)
+{
+    std::vector<uint64_t> alone;
+    RandomStream a("a", 7);
+    for (int i = 0; i < 16; i++)
+        alone.push_back(a());
+
+    RandomStream x("a", 7);
+    RandomStream y("b", 7);
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < i; j++)
+            y();
+        ASSERT_EQ(x(), alone[i]);
+    }
+}
+
+/** Test that re-initializing a stream restarts it. */
+TEST(RandomStreamTest, Init)
+{
+    RandomStream a("a", 3);
+    uint64_t first = a();
+    a();
+    a.init("a", 3);
+    ASSERT_EQ(a.position(), 0);
+    ASSERT_EQ(a(), first);
+}
+
+/** Test that the streams created use the stream seed. */
+TEST(RandomStreamTest, StreamSeed)
+{
+    const uint64_t old_seed = RandomStream::seed();
+    RandomStream::setSeed(11);
+    RandomStream a("a");
+    RandomStream b("a", 11);
+    ASSERT_EQ(a(), b());
+    RandomStream::setSeed(old_seed);
+}
+
+/** Test the ranges of the helpers. */
+TEST(RandomStreamTest, Ranges)
+{
+    RandomStream a("a", 5);
+    for (int i = 0; i < 1000; i++) {
+        int v = a.random(-3, 3);
+        ASSERT_GE(v, -3);
+        ASSERT_LE(v, 3);
+        double d = a.random<double>();
+        ASSERT_GE(d, 0.0);
+        ASSERT_LT(d, 1.0);
+    }
+}
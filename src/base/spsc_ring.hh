@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SPSC_RING_HH__
+#define __BASE_SPSC_RING_HH__
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * Lock-free ring between a single producer thread and a single consumer
+ * thread. The producer adds elements with push(); the consumer looks at
+ * the oldest elements in place with peek() and releases them with pop(),
+ * so that it can hand them on in bulk without copying them first.
+ *
+ * Both indices increase monotonically and are aliased down to the
+ * storage, whose size is a power of two, when it is accessed. Each side
+ * owns one index, and the two live on different cache lines so that the
+ * threads don't bounce a line between them on every element.
+ *
+ * @tparam T Type of the elements in the ring
+ */
+template <typename T>
+class SpscRing
+{
+  private:
+    static constexpr size_t CacheLine = 64;
+
+    std::vector<T> data;
+    const size_t mask;
+
+    /** The next element the producer writes. */
+    alignas(CacheLine) std::atomic<size_t> head{0};
+    /** The next element the consumer reads. */
+    alignas(CacheLine) std::atomic<size_t> tail{0};
+
+    static size_t
+    roundUp(size_t n)
+    {
+        size_t size = 1;
+        while (size < n)
+            size <<= 1;
+        return size;
+    }
+
+  public:
+    /** Create a ring holding at least capacity elements. */
+    SpscRing(size_t capacity)
+        : data(roundUp(capacity ? capacity : 1)), mask(data.size() - 1)
+    {}
+
+    size_t capacity() const { return data.size(); }
+
+    /** Producer: add an element, or return false if the ring is full. */
+    bool
+    push(const T &value)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == data.size())
+            return false;
+        data[h & mask] = value;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer: the oldest elements that are stored contiguously. Up to
+     * the returned number of elements starting at first can be read.
+     */
+    size_t
+    peek(const T *&first) const
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t avail = head.load(std::memory_order_acquire) - t;
+        const size_t start = t & mask;
+        first = &data[start];
+        return std::min(avail, data.size() - start);
+    }
+
+    /** Consumer: release the n oldest elements. */
+    void
+    pop(size_t n)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        assert(n <= head.load(std::memory_order_acquire) - t);
+        tail.store(t + n, std::memory_order_release);
+    }
+
+    /** Whether the ring is empty, as seen from either side. */
+    bool
+    empty() const
+    {
+        return head.load(std::memory_order_acquire) ==
+            tail.load(std::memory_order_acquire);
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_SPSC_RING_HH__
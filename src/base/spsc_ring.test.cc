@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "base/spsc_ring.hh"
+
+using namespace gem5;
+
+/** Test that the capacity is rounded up to a power of two. */
+TEST(SpscRingTest, Capacity)
+{
+    ASSERT_EQ(SpscRing<int>(0).capacity(), 1);
+    ASSERT_EQ(SpscRing<int>(5).capacity(), 8);
+    ASSERT_EQ(SpscRing<int>(16).capacity(), 16);
+}
+
+/** Test filling the ring and reading elements across the wrap. */
+TEST(SpscRingTest, PushPeekPop)
+{
+    SpscRing<int> ring(4);
+    ASSERT_TRUE(ring.empty());
+    for (int i = 0; i < 4; i++)
+        ASSERT_TRUE(ring.push(i));
+    ASSERT_FALSE(ring.push(4));
+
+    const int *first;
+    ASSERT_EQ(ring.peek(first), 4);
+    ASSERT_EQ(first[0], 0);
+    ring.pop(3);
+
+    ASSERT_TRUE(ring.push(4));
+    ASSERT_TRUE(ring.push(5));
+
+    // Element 3 is at the end of the storage, 4 and 5 wrapped around
+    ASSERT_EQ(ring.peek(first), 1);
+    ASSERT_EQ(first[0], 3);
+    ring.pop(1);
+    ASSERT_EQ(ring.peek(first), 2);
+    ASSERT_EQ(first[0], 4);
+    ASSERT_EQ(first[1], 5);
+    ring.pop(2);
+    ASSERT_TRUE(ring.empty());
+}
+
+/** Test that a consumer thread sees every element in order. */
+TEST(SpscRingTest, Threads)
+{
+    const uint64_t count = 10000;
+    SpscRing<uint64_t> ring(64);
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < count; i++) {
+            while (!ring.push(i))
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    while (expected < count) {
+        const uint64_t *first;
+        size_t n = ring.peek(first);
+        if (!n)
+            std::this_thread::yield();
+        for (size_t i = 0; i < n; i++)
+            ASSERT_EQ(first[i], expected++);
+        ring.pop(n);
+    }
+    producer.join();
+    ASSERT_TRUE(ring.empty());
+}
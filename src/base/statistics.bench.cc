@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "base/statistics.hh"
+#include "base/stats/group.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct BenchStats : public statistics::Group
+{
+    statistics::Scalar scalar;
+    statistics::Vector vector;
+
+    BenchStats()
+        : statistics::Group(nullptr),
+          ADD_STAT(scalar, statistics::units::Count::get(), "A scalar"),
+          ADD_STAT(vector, statistics::units::Count::get(), "A vector")
+    {
+        vector.init(16);
+    }
+};
+
+/** Increment a scalar statistic. */
+void
+BM_ScalarIncrement(benchmark::State &state)
+{
+    BenchStats stats;
+    for (auto _ : state)
+        ++stats.scalar;
+    benchmark::DoNotOptimize(stats.scalar.value());
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ScalarIncrement);
+
+/** Add to a scalar statistic. */
+void
+BM_ScalarAdd(benchmark::State &state)
+{
+    BenchStats stats;
+    int n = 0;
+    for (auto _ : state)
+        stats.scalar += ++n & 7;
+    benchmark::DoNotOptimize(stats.scalar.value());
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ScalarAdd);
+
+/** Increment the elements of a vector statistic in turn. */
+void
+BM_VectorIncrement(benchmark::State &state)
+{
+    BenchStats stats;
+    int i = 0;
+    for (auto _ : state)
+        stats.vector[i++ & 15]++;
+    benchmark::DoNotOptimize(stats.vector.total());
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_VectorIncrement);
+
+} // anonymous namespace
@@ -40,6 +40,7 @@
 
 #include "base/statistics.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <list>
 #include <map>
@@ -142,6 +143,225 @@ InfoAccess::newStyleStats() const
     return _info != nullptr;
 }
 
+FormulaPlan::Operand
+FormulaPlan::alloc(size_type size)
+{
+    Operand slot = { (off_type)values.size(), size };
+    values.resize(values.size() + size);
+    return slot;
+}
+
+FormulaPlan::Operand
+FormulaPlan::constant(const VResult &vec)
+{
+    Operand dst = alloc(vec.size());
+    std::copy(vec.begin(), vec.end(), values.begin() + dst.offset);
+    return dst;
+}
+
+FormulaPlan::Operand
+FormulaPlan::scalar(const ScalarInfo *info)
+{
+    Instr instr = { Op::Scalar, alloc(1) };
+    instr.src.scalar = info;
+    instrs.push_back(instr);
+    return instr.dst;
+}
+
+FormulaPlan::Operand
+FormulaPlan::vector(const VectorInfo *info)
+{
+    Instr instr = { Op::Vector, alloc(info->size()) };
+    instr.src.vector = info;
+    instrs.push_back(instr);
+    return instr.dst;
+}
+
+FormulaPlan::Operand
+FormulaPlan::node(const Node *node)
+{
+    Instr instr = { Op::Node, alloc(node->size()) };
+    instr.src.node = node;
+    instrs.push_back(instr);
+    return instr.dst;
+}
+
+FormulaPlan::Operand
+FormulaPlan::unary(Op op, const Operand &l)
+{
+    assert(l.size > 0);
+    Instr instr = { op, alloc(l.size), l };
+    instrs.push_back(instr);
+    return instr.dst;
+}
+
+FormulaPlan::Operand
+FormulaPlan::binary(Op op, const Operand &l, const Operand &r)
+{
+    assert(l.size > 0 && r.size > 0);
+    assert((l.size == r.size || l.size == 1 || r.size == 1) &&
+           "Node vector sizes are not equal");
+    Instr instr = { op, alloc(std::max(l.size, r.size)), l, r };
+    instrs.push_back(instr);
+    return instr.dst;
+}
+
+FormulaPlan::Operand
+FormulaPlan::sum(const Operand &l)
+{
+    assert(l.size > 0);
+    Instr instr = { Op::Sum, alloc(1), l };
+    instrs.push_back(instr);
+    return instr.dst;
+}
+
+void
+FormulaPlan::clear()
+{
+    instrs.clear();
+    values.clear();
+    root = { 0, 0 };
+    isBuilt = false;
+}
+
+void
+FormulaPlan::finish(const Operand &_root)
+{
+    root = _root;
+    isBuilt = true;
+}
+
+namespace
+{
+
+template <class F>
+void
+broadcast(Result *dst, const Result *l, size_type lsize,
+          const Result *r, size_type rsize, F op)
+{
+    if (lsize == rsize) {
+        for (off_type i = 0; i < lsize; ++i)
+            dst[i] = op(l[i], r[i]);
+    } else if (lsize == 1) {
+        for (off_type i = 0; i < rsize; ++i)
+            dst[i] = op(l[0], r[i]);
+    } else {
+        for (off_type i = 0; i < lsize; ++i)
+            dst[i] = op(l[i], r[0]);
+    }
+}
+
+Result
+apply(FormulaPlan::Op op, Result l, Result r)
+{
+    switch (op) {
+      case FormulaPlan::Op::Add:
+        return l + r;
+      case FormulaPlan::Op::Sub:
+        return l - r;
+      case FormulaPlan::Op::Mul:
+        return l * r;
+      case FormulaPlan::Op::Div:
+        return l / r;
+      default:
+        panic("Not a binary formula operation");
+    }
+}
+
+} // anonymous namespace
+
+bool
+FormulaPlan::evaluate() const
+{
+    assert(isBuilt);
+
+    Result *v = values.data();
+    for (const auto &instr : instrs) {
+        Result *dst = v + instr.dst.offset;
+        const Result *l = v + instr.l.offset;
+        const Result *r = v + instr.r.offset;
+
+        switch (instr.op) {
+          case Op::Scalar:
+            dst[0] = instr.src.scalar->result();
+            break;
+          case Op::Vector:
+          case Op::Node: {
+            const VResult &vec = instr.op == Op::Vector ?
+                instr.src.vector->result() : instr.src.node->result();
+            if (vec.size() != instr.dst.size)
+                return false;
+            std::copy(vec.begin(), vec.end(), dst);
+            break;
+          }
+          case Op::Add:
+            broadcast(dst, l, instr.l.size, r, instr.r.size,
+                      std::plus<Result>());
+            break;
+          case Op::Sub:
+            broadcast(dst, l, instr.l.size, r, instr.r.size,
+                      std::minus<Result>());
+            break;
+          case Op::Mul:
+            broadcast(dst, l, instr.l.size, r, instr.r.size,
+                      std::multiplies<Result>());
+            break;
+          case Op::Div:
+            broadcast(dst, l, instr.l.size, r, instr.r.size,
+                      std::divides<Result>());
+            break;
+          case Op::Neg:
+            for (off_type i = 0; i < instr.l.size; ++i)
+                dst[i] = -l[i];
+            break;
+          case Op::Sum:
+            dst[0] = sum(instr.l);
+            break;
+        }
+    }
+
+    return true;
+}
+
+Result
+FormulaPlan::sum(const Operand &l) const
+{
+    Result total = 0.0;
+    for (off_type i = 0; i < l.size; ++i)
+        total += values[l.offset + i];
+    return total;
+}
+
+Result
+FormulaPlan::total() const
+{
+    // Only the last instruction can produce the root, constants have none
+    const Instr *last = instrs.empty() ? nullptr : &instrs.back();
+    if (!last || last->dst.offset != root.offset)
+        return sum(root);
+
+    switch (last->op) {
+      case Op::Node:
+        return last->src.node->total();
+      case Op::Add:
+      case Op::Sub:
+      case Op::Mul:
+      case Op::Div:
+        // If vectors are the same divide their sums (x0+x1)/(y0+y1)
+        if (last->l.size == last->r.size && last->l.size > 1)
+            return apply(last->op, sum(last->l), sum(last->r));
+        return sum(root);
+      default:
+        return sum(root);
+    }
+}
+
+FormulaPlan::Operand
+Node::compile(FormulaPlan &plan) const
+{
+    return plan.node(this);
+}
+
 Formula::Formula(Group *parent, const char *name, const char *desc)
     : DataWrapVec<Formula, FormulaInfoProxy>(
             parent, name, units::Unspecified::get(), desc)
@@ -175,6 +395,7 @@ Formula::operator=(const Temp &r)
 {
     assert(!root && "Can't change formulas");
     root = r.getNodePtr();
+    plan.clear();
     setInit();
     assert(size());
     return *this;
@@ -189,6 +410,7 @@ Formula::operator+=(Temp r)
         root = r.getNodePtr();
         setInit();
     }
+    plan.clear();
 
     assert(size());
     return *this;
@@ -199,23 +421,51 @@ Formula::operator/=(Temp r)
 {
     assert (root);
     root = NodePtr(new BinaryNode<std::divides<Result> >(root, r));
+    plan.clear();
 
     assert(size());
     return *this;
 }
 
 
+void
+Formula::evaluate() const
+{
+    assert(root);
+
+    // Build the plan again if a stat it reads changed its size
+    if (plan.built() && plan.evaluate())
+        return;
+
+    plan.clear();
+    plan.finish(root->compile(plan));
+    [[maybe_unused]] bool ok = plan.evaluate();
+    assert(ok);
+}
+
+void
+Formula::prepare()
+{
+    if (root && !plan.built())
+        plan.finish(root->compile(plan));
+}
+
 void
 Formula::result(VResult &vec) const
 {
-    if (root)
-        vec = root->result();
+    if (root) {
+        evaluate();
+        vec.assign(plan.begin(), plan.end());
+    }
 }
 
 Result
 Formula::total() const
 {
-    return root ? root->total() : 0.0;
+    if (!root)
+        return 0.0;
+    evaluate();
+    return plan.total();
 }
 
 size_type
@@ -235,12 +485,11 @@ Formula::reset()
 bool
 Formula::zero() const
 {
-    VResult vec;
-    result(vec);
-    for (VResult::size_type i = 0; i < vec.size(); ++i)
-        if (vec[i] != 0.0)
-            return false;
-    return true;
+    if (!root)
+        return true;
+    evaluate();
+    return std::all_of(plan.begin(), plan.end(),
+                       [](Result v) { return v == 0.0; });
 }
 
 std::string
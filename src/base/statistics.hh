@@ -71,6 +71,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/cast.hh"
@@ -442,8 +443,11 @@ class DataWrapVec : public DataWrap<Derived, InfoProxyType>
         Info *info = this->info();
 
         size_t size = self.size();
-        for (off_type i = 0; i < size; ++i)
-            self.data(i)->prepare(info->getStorageParams());
+        for (off_type i = 0; i < size; ++i) {
+            // Storage that was never written has nothing to prepare.
+            if (std::as_const(self).data(i))
+                self.data(i)->prepare(info->getStorageParams());
+        }
     }
 
     void
@@ -453,8 +457,10 @@ class DataWrapVec : public DataWrap<Derived, InfoProxyType>
         Info *info = this->info();
 
         size_t size = self.size();
-        for (off_type i = 0; i < size; ++i)
-            self.data(i)->reset(info->getStorageParams());
+        for (off_type i = 0; i < size; ++i) {
+            if (std::as_const(self).data(i))
+                self.data(i)->reset(info->getStorageParams());
+        }
     }
 };
 
@@ -807,13 +813,23 @@ class ScalarProxy
      * Return the current value of this stat as its base type.
      * @return The current value.
      */
-    Counter value() const { return stat.data(index)->value(); }
+    Counter
+    value() const
+    {
+        const auto *stor = std::as_const(stat).data(index);
+        return stor ? stor->value() : Counter();
+    }
 
     /**
      * Return the current value of this statas a result type.
      * @return The current value.
      */
-    Result result() const { return stat.data(index)->result(); }
+    Result
+    result() const
+    {
+        const auto *stor = std::as_const(stat).data(index);
+        return stor ? stor->result() : Result();
+    }
 
   public:
     /**
@@ -936,16 +952,23 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
 
   protected:
     /**
-     * Retrieve the storage.
+     * Retrieve the storage, allocating it if this is its first use.
      * @param index The vector index to access.
      * @return The storage object at the given index.
      */
-    Storage *data(off_type index) { return storage[index]; }
+    Storage *
+    data(off_type index)
+    {
+        if (!storage[index])
+            storage[index] = new Storage(this->info()->getStorageParams());
+        return storage[index];
+    }
 
     /**
      * Retrieve a const pointer to the storage.
      * @param index The vector index to access.
-     * @return A const pointer to the storage object at the given index.
+     * @return A const pointer to the storage object at the given index, or
+     * nullptr if that entry has never been written.
      */
     const Storage *data(off_type index) const { return storage[index]; }
 
@@ -955,9 +978,11 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
         fatal_if(s <= 0, "Storage size must be positive");
         fatal_if(check(), "Stat has already been initialized");
 
-        storage.reserve(s);
-        for (size_type i = 0; i < s; ++i)
-            storage.push_back(new Storage(this->info()->getStorageParams()));
+        storage.resize(s, nullptr);
+        if (!LazyStorage<Storage>::value) {
+            for (size_type i = 0; i < s; ++i)
+                data(i);
+        }
 
         this->setInit();
     }
@@ -968,7 +993,7 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
     {
         vec.resize(size());
         for (off_type i = 0; i < size(); ++i)
-            vec[i] = data(i)->value();
+            vec[i] = data(i) ? data(i)->value() : Counter();
     }
 
     /**
@@ -980,7 +1005,7 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
     {
         vec.resize(size());
         for (off_type i = 0; i < size(); ++i)
-            vec[i] = data(i)->result();
+            vec[i] = data(i) ? data(i)->result() : Result();
     }
 
     /**
@@ -991,8 +1016,10 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
     total() const
     {
         Result total = 0.0;
-        for (off_type i = 0; i < size(); ++i)
-            total += data(i)->result();
+        for (off_type i = 0; i < size(); ++i) {
+            if (data(i))
+                total += data(i)->result();
+        }
         return total;
     }
 
@@ -1005,7 +1032,7 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
     zero() const
     {
         for (off_type i = 0; i < size(); ++i)
-            if (data(i)->zero())
+            if (data(i) && !data(i)->zero())
                 return false;
         return true;
     }
@@ -1079,7 +1106,7 @@ class VectorProxy
     data(off_type index) const
     {
         assert(index < len);
-        return stat.data(offset + index);
+        return std::as_const(stat).data(offset + index);
     }
 
   public:
@@ -1089,7 +1116,7 @@ class VectorProxy
         vec.resize(size());
 
         for (off_type i = 0; i < size(); ++i)
-            vec[i] = data(i)->result();
+            vec[i] = data(i) ? data(i)->result() : Result();
 
         return vec;
     }
@@ -1098,8 +1125,10 @@ class VectorProxy
     total() const
     {
         Result total = 0.0;
-        for (off_type i = 0; i < size(); ++i)
-            total += data(i)->result();
+        for (off_type i = 0; i < size(); ++i) {
+            if (data(i))
+                total += data(i)->result();
+        }
         return total;
     }
 
@@ -1152,7 +1181,15 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
     std::vector<Storage*> storage;
 
   protected:
-    Storage *data(off_type index) { return storage[index]; }
+    Storage *
+    data(off_type index)
+    {
+        if (!storage[index])
+            storage[index] = new Storage(this->info()->getStorageParams());
+        return storage[index];
+    }
+
+    /** @return The storage at index, or nullptr if it was never written. */
     const Storage *data(off_type index) const { return storage[index]; }
 
   public:
@@ -1184,9 +1221,11 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
         info->x = _x;
         info->y = _y;
 
-        storage.reserve(x * y);
-        for (size_type i = 0; i < x * y; ++i)
-            storage.push_back(new Storage(this->info()->getStorageParams()));
+        storage.resize(x * y, nullptr);
+        if (!LazyStorage<Storage>::value) {
+            for (size_type i = 0; i < x * y; ++i)
+                data(i);
+        }
 
         this->setInit();
 
@@ -1211,7 +1250,10 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
     bool
     zero() const
     {
-        return data(0)->zero();
+        for (off_type i = 0; i < size(); ++i)
+            if (data(i) && !data(i)->zero())
+                return false;
+        return true;
     }
 
     /**
@@ -1222,8 +1264,10 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
     total() const
     {
         Result total = 0.0;
-        for (off_type i = 0; i < size(); ++i)
-            total += data(i)->result();
+        for (off_type i = 0; i < size(); ++i) {
+            if (data(i))
+                total += data(i)->result();
+        }
         return total;
     }
 
@@ -1233,12 +1277,15 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
         Info *info = this->info();
         size_type size = this->size();
 
-        for (off_type i = 0; i < size; ++i)
-            data(i)->prepare(info->getStorageParams());
-
         info->cvec.resize(size);
-        for (off_type i = 0; i < size; ++i)
-            info->cvec[i] = data(i)->value();
+        for (off_type i = 0; i < size; ++i) {
+            if (!storage[i]) {
+                info->cvec[i] = Counter();
+                continue;
+            }
+            storage[i]->prepare(info->getStorageParams());
+            info->cvec[i] = storage[i]->value();
+        }
     }
 
     /**
@@ -1249,8 +1296,10 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
     {
         Info *info = this->info();
         size_type size = this->size();
-        for (off_type i = 0; i < size; ++i)
-            data(i)->reset(info->getStorageParams());
+        for (off_type i = 0; i < size; ++i) {
+            if (storage[i])
+                storage[i]->reset(info->getStorageParams());
+        }
     }
 
     bool
@@ -1281,32 +1330,41 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
   protected:
     /** The storage for this stat. */
     GEM5_ALIGNED(8) char storage[sizeof(Storage)];
+    /** Whether the storage has been constructed. */
+    bool allocated = false;
 
   protected:
     /**
-     * Retrieve the storage.
+     * Retrieve the storage, constructing it if this is its first use.
      * @return The storage object for this stat.
      */
     Storage *
     data()
     {
+        if (!allocated) {
+            new (storage) Storage(this->info()->getStorageParams());
+            allocated = true;
+        }
         return reinterpret_cast<Storage *>(storage);
     }
 
     /**
      * Retrieve a const pointer to the storage.
-     * @return A const pointer to the storage object for this stat.
+     * @return A const pointer to the storage object for this stat, or
+     * nullptr if nothing has been sampled yet.
      */
     const Storage *
     data() const
     {
-        return reinterpret_cast<const Storage *>(storage);
+        return allocated ? reinterpret_cast<const Storage *>(storage) :
+            nullptr;
     }
 
     void
     doInit()
     {
-        new (storage) Storage(this->info()->getStorageParams());
+        if (!LazyStorage<Storage>::value)
+            data();
         this->setInit();
     }
 
@@ -1318,6 +1376,12 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     {
     }
 
+    ~DistBase()
+    {
+        if (allocated)
+            reinterpret_cast<Storage *>(storage)->~Storage();
+    }
+
     /**
      * Add a value to the distribtion n times. Calls sample on the storage
      * class.
@@ -1331,18 +1395,31 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
      * Return the number of entries in this stat.
      * @return The number of entries.
      */
-    size_type size() const { return data()->size(); }
+    size_type
+    size() const
+    {
+        if (data())
+            return data()->size();
+        return Storage(this->info()->getStorageParams()).size();
+    }
+
     /**
      * Return true if no samples have been added.
      * @return True if there haven't been any samples.
      */
-    bool zero() const { return data()->zero(); }
+    bool zero() const { return !data() || data()->zero(); }
 
     void
     prepare()
     {
         Info *info = this->info();
-        data()->prepare(info->getStorageParams(), info->data);
+        if (allocated) {
+            data()->prepare(info->getStorageParams(), info->data);
+        } else {
+            // Describe the empty distribution without keeping its storage.
+            Storage(info->getStorageParams()).prepare(
+                info->getStorageParams(), info->data);
+        }
     }
 
     /**
@@ -1351,13 +1428,19 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     void
     reset()
     {
-        data()->reset(this->info()->getStorageParams());
+        if (allocated)
+            data()->reset(this->info()->getStorageParams());
     }
 
     /**
      *  Add the argument distribution to the this distribution.
      */
-    void add(DistBase &d) { data()->add(d.data()); }
+    void
+    add(DistBase &d)
+    {
+        if (d.allocated)
+            data()->add(d.data());
+    }
 };
 
 template <class Stat>
@@ -1381,9 +1464,12 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
     Storage *
     data(off_type index)
     {
+        if (!storage[index])
+            storage[index] = new Storage(this->info()->getStorageParams());
         return storage[index];
     }
 
+    /** @return The storage at index, or nullptr if it was never sampled. */
     const Storage *
     data(off_type index) const
     {
@@ -1396,9 +1482,11 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
         fatal_if(s <= 0, "Storage size must be positive");
         fatal_if(check(), "Stat has already been initialized");
 
-        storage.reserve(s);
-        for (size_type i = 0; i < s; ++i)
-            storage.push_back(new Storage(this->info()->getStorageParams()));
+        storage.resize(s, nullptr);
+        if (!LazyStorage<Storage>::value) {
+            for (size_type i = 0; i < s; ++i)
+                data(i);
+        }
 
         this->setInit();
     }
@@ -1434,7 +1522,7 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
     zero() const
     {
         for (off_type i = 0; i < size(); ++i)
-            if (!data(i)->zero())
+            if (data(i) && !data(i)->zero())
                 return false;
         return true;
     }
@@ -1445,8 +1533,19 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
         Info *info = this->info();
         size_type size = this->size();
         info->data.resize(size);
-        for (off_type i = 0; i < size; ++i)
-            data(i)->prepare(info->getStorageParams(), info->data[i]);
+
+        // Entries that were never sampled share one empty storage that
+        // only lives for the duration of the dump.
+        std::unique_ptr<Storage> empty;
+        for (off_type i = 0; i < size; ++i) {
+            Storage *stor = storage[i];
+            if (!stor) {
+                if (!empty)
+                    empty.reset(new Storage(info->getStorageParams()));
+                stor = empty.get();
+            }
+            stor->prepare(info->getStorageParams(), info->data[i]);
+        }
     }
 
     bool
@@ -1465,7 +1564,12 @@ class DistProxy
 
   protected:
     typename Stat::Storage *data() { return stat.data(index); }
-    const typename Stat::Storage *data() const { return stat.data(index); }
+
+    const typename Stat::Storage *
+    data() const
+    {
+        return std::as_const(stat).data(index);
+    }
 
   public:
     DistProxy(Stat &s, off_type i)
@@ -1501,7 +1605,7 @@ class DistProxy
     bool
     zero() const
     {
-        return data()->zero();
+        return !data() || data()->zero();
     }
 
     /**
@@ -1516,6 +1620,92 @@ class DistProxy
 //
 //////////////////////////////////////////////////////////////////////
 
+class Node;
+
+/**
+ * A formula tree flattened into a list of instructions. Every node of the
+ * tree gets a fixed slot of results when the plan is built, so evaluating
+ * the formula is a single pass over the instructions that neither
+ * allocates nor goes through the nodes. Constants are stored in their slots
+ * once and for all. Nodes that the plan doesn't know about are evaluated
+ * through Node::result() and copied to their slot.
+ */
+class FormulaPlan
+{
+  public:
+    enum class Op
+    {
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Neg,
+        Sum,
+        Scalar,
+        Vector,
+        Node,
+    };
+
+    /** The slot holding the result of a node. */
+    struct Operand
+    {
+        off_type offset;
+        size_type size;
+    };
+
+    Operand constant(const VResult &values);
+    Operand scalar(const ScalarInfo *info);
+    Operand vector(const VectorInfo *info);
+    Operand node(const Node *node);
+    Operand unary(Op op, const Operand &l);
+    Operand binary(Op op, const Operand &l, const Operand &r);
+    Operand sum(const Operand &l);
+
+    /** Forget all instructions before the plan is built again. */
+    void clear();
+
+    /** Set the result of the plan, which marks it as built. */
+    void finish(const Operand &root);
+    bool built() const { return isBuilt; }
+
+    /**
+     * Run the instructions.
+     * @return False if a stat no longer has the size the plan was built
+     * for, in which case the plan should be built again.
+     */
+    bool evaluate() const;
+
+    /** The result of the last evaluation. */
+    const Result *begin() const { return values.data() + root.offset; }
+    const Result *end() const { return begin() + root.size; }
+
+    /** The total of the last evaluation, see Formula::total(). */
+    Result total() const;
+
+  protected:
+    struct Instr
+    {
+        Op op;
+        Operand dst;
+        Operand l;
+        Operand r;
+        union
+        {
+            const ScalarInfo *scalar;
+            const VectorInfo *vector;
+            const Node *node;
+        } src;
+    };
+
+    Operand alloc(size_type size);
+    Result sum(const Operand &l) const;
+
+    std::vector<Instr> instrs;
+    mutable VResult values;
+    Operand root = { 0, 0 };
+    bool isBuilt = false;
+};
+
 /**
  * Base class for formula statistic node. These nodes are used to build a tree
  * that represents the formula.
@@ -1544,6 +1734,12 @@ class Node
      */
     virtual std::string str() const = 0;
 
+    /**
+     * Add the instructions that evaluate this subtree to a plan.
+     * @return The slot that holds the result of this subtree.
+     */
+    virtual FormulaPlan::Operand compile(FormulaPlan &plan) const;
+
     virtual ~Node() {};
 };
 
@@ -1574,6 +1770,12 @@ class ScalarStatNode : public Node
      *
      */
     std::string str() const { return data->name; }
+
+    FormulaPlan::Operand
+    compile(FormulaPlan &plan) const override
+    {
+        return plan.scalar(data);
+    }
 };
 
 template <class Stat>
@@ -1630,6 +1832,12 @@ class VectorStatNode : public Node
     size_type size() const { return data->size(); }
 
     std::string str() const { return data->name; }
+
+    FormulaPlan::Operand
+    compile(FormulaPlan &plan) const override
+    {
+        return plan.vector(data);
+    }
 };
 
 template <class T>
@@ -1644,6 +1852,12 @@ class ConstNode : public Node
     Result total() const { return vresult[0]; };
     size_type size() const { return 1; }
     std::string str() const { return std::to_string(vresult[0]); }
+
+    FormulaPlan::Operand
+    compile(FormulaPlan &plan) const override
+    {
+        return plan.constant(vresult);
+    }
 };
 
 template <class T>
@@ -1677,6 +1891,12 @@ class ConstVectorNode : public Node
         tmp += ")";
         return tmp;
     }
+
+    FormulaPlan::Operand
+    compile(FormulaPlan &plan) const override
+    {
+        return plan.constant(vresult);
+    }
 };
 
 template <class Op>
@@ -1718,6 +1938,49 @@ struct OpString<std::negate<Result> >
     static std::string str() { return "-"; }
 };
 
+/** The FormulaPlan instruction of an operation, if it has one. */
+template <class Op>
+struct PlanOp
+{
+    static constexpr bool known = false;
+    static constexpr FormulaPlan::Op op = FormulaPlan::Op::Node;
+};
+
+template<>
+struct PlanOp<std::plus<Result> >
+{
+    static constexpr bool known = true;
+    static constexpr FormulaPlan::Op op = FormulaPlan::Op::Add;
+};
+
+template<>
+struct PlanOp<std::minus<Result> >
+{
+    static constexpr bool known = true;
+    static constexpr FormulaPlan::Op op = FormulaPlan::Op::Sub;
+};
+
+template<>
+struct PlanOp<std::multiplies<Result> >
+{
+    static constexpr bool known = true;
+    static constexpr FormulaPlan::Op op = FormulaPlan::Op::Mul;
+};
+
+template<>
+struct PlanOp<std::divides<Result> >
+{
+    static constexpr bool known = true;
+    static constexpr FormulaPlan::Op op = FormulaPlan::Op::Div;
+};
+
+template<>
+struct PlanOp<std::negate<Result> >
+{
+    static constexpr bool known = true;
+    static constexpr FormulaPlan::Op op = FormulaPlan::Op::Neg;
+};
+
 template <class Op>
 class UnaryNode : public Node
 {
@@ -1761,6 +2024,14 @@ class UnaryNode : public Node
     {
         return OpString<Op>::str() + l->str();
     }
+
+    FormulaPlan::Operand
+    compile(FormulaPlan &plan) const override
+    {
+        if (!PlanOp<Op>::known)
+            return Node::compile(plan);
+        return plan.unary(PlanOp<Op>::op, l->compile(plan));
+    }
 };
 
 template <class Op>
@@ -1858,6 +2129,16 @@ class BinaryNode : public Node
     {
         return csprintf("(%s %s %s)", l->str(), OpString<Op>::str(), r->str());
     }
+
+    FormulaPlan::Operand
+    compile(FormulaPlan &plan) const override
+    {
+        if (!PlanOp<Op>::known)
+            return Node::compile(plan);
+        const FormulaPlan::Operand lop = l->compile(plan);
+        const FormulaPlan::Operand rop = r->compile(plan);
+        return plan.binary(PlanOp<Op>::op, lop, rop);
+    }
 };
 
 template <class Op>
@@ -1909,6 +2190,14 @@ class SumNode : public Node
     {
         return csprintf("total(%s)", l->str());
     }
+
+    FormulaPlan::Operand
+    compile(FormulaPlan &plan) const override
+    {
+        if (PlanOp<Op>::op != FormulaPlan::Op::Add)
+            return Node::compile(plan);
+        return plan.sum(l->compile(plan));
+    }
 };
 
 
@@ -2543,6 +2832,12 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
     NodePtr root;
     friend class Temp;
 
+    /** The tree flattened for evaluation, built on first use. */
+    mutable FormulaPlan plan;
+
+    /** Evaluate the plan, building it first if needed. */
+    void evaluate() const;
+
   public:
     /**
      * Create and initialize thie formula, and register it with the database.
@@ -2613,7 +2908,11 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
      */
     size_type size() const;
 
-    void prepare() { }
+    /**
+     * Flatten the tree before the formula is dumped, so that its
+     * evaluation doesn't have to walk the tree.
+     */
+    void prepare();
 
     /**
      * Formulas don't need to be reset
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <cassert>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+namespace
+{
+
+/** The column names of a distribution, relative to the stat name. */
+void
+distColumnNames(const std::string &base, const DistData &data,
+                std::vector<std::string> &names)
+{
+    for (const char *field : { "samples", "sum", "squares", "min_value",
+                               "max_value", "underflows", "overflows" }) {
+        names.push_back(base + "::" + field);
+    }
+    for (size_t i = 0; i < data.cvec.size(); ++i)
+        names.push_back(csprintf("%s::%g", base,
+                                 data.min + i * data.bucket_size));
+}
+
+std::string
+subname(const std::vector<std::string> &subnames, size_t i)
+{
+    return i < subnames.size() && !subnames[i].empty() ?
+        subnames[i] : std::to_string(i);
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(OutputStream *stream, bool desc)
+    : outputStream(stream), stream(stream->stream()),
+      enableDescriptions(desc)
+{
+    writeWord(Magic);
+}
+
+Columnar::Columnar(std::ostream &stream, bool desc)
+    : outputStream(nullptr), stream(&stream), enableDescriptions(desc)
+{
+    writeWord(Magic);
+}
+
+Columnar::~Columnar()
+{
+    if (outputStream)
+        simout.close(outputStream);
+}
+
+void
+Columnar::begin()
+{
+    prefixes.assign(1, "");
+    path.assign(1, 0);
+    stats.clear();
+    values.clear();
+}
+
+void
+Columnar::end()
+{
+    assert(valid());
+
+    // only describe the columns again if the stats have changed since
+    // the previous dump
+    if (stats != schema)
+        writeSchema();
+
+    writeWord(RowBlock);
+    writeWord(curTick());
+    stream->write((const char *)values.data(),
+                  values.size() * sizeof(double));
+    stream->flush();
+}
+
+bool
+Columnar::valid() const
+{
+    return stream->good();
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    prefixes.push_back(prefixes[path.back()] + name + ".");
+    path.push_back(prefixes.size() - 1);
+}
+
+void
+Columnar::endGroup()
+{
+    assert(path.size() > 1);
+    path.pop_back();
+}
+
+void
+Columnar::addStat(const Info &info, const double *data, size_t count)
+{
+    stats.push_back({ &info, path.back(), count });
+    values.insert(values.end(), data, data + count);
+}
+
+size_t
+Columnar::addDist(const DistData &data)
+{
+    const size_t start = values.size();
+    for (Counter v : { data.samples, data.sum, data.squares, data.min_val,
+                       data.max_val, data.underflow, data.overflow }) {
+        values.push_back(v);
+    }
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+    return values.size() - start;
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    const double value = info.result();
+    addStat(info, &value, 1);
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    const VResult &vr(info.result());
+    addStat(info, vr.data(), vr.size());
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    const size_t count = addDist(info.data);
+    stats.push_back({ &info, path.back(), count });
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    size_t count = 0;
+    for (const auto &data : info.data)
+        count += addDist(data);
+    stats.push_back({ &info, path.back(), count });
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    addStat(info, info.cvec.data(), info.cvec.size());
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    const VResult &vr(info.result());
+    addStat(info, vr.data(), vr.size());
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    warn_once("Columnar stat files don't support sparse histograms.\n");
+}
+
+void
+Columnar::columnNames(const Stat &stat, std::vector<std::string> &names) const
+{
+    const Info &info = *stat.info;
+    const std::string base = prefixes[stat.prefix] + info.name;
+    const size_t start = names.size();
+
+    if (auto *dist = dynamic_cast<const DistInfo *>(&info)) {
+        distColumnNames(base, dist->data, names);
+    } else if (auto *vdist = dynamic_cast<const VectorDistInfo *>(&info)) {
+        for (size_t i = 0; i < vdist->data.size(); ++i) {
+            distColumnNames(base + "::" + subname(vdist->subnames, i),
+                            vdist->data[i], names);
+        }
+    } else if (auto *v2d = dynamic_cast<const Vector2dInfo *>(&info)) {
+        for (size_t x = 0; x < v2d->x; ++x) {
+            for (size_t y = 0; y < v2d->y; ++y) {
+                names.push_back(base + "::" + subname(v2d->subnames, x) +
+                                "::" + subname(v2d->y_subnames, y));
+            }
+        }
+    } else if (auto *vec = dynamic_cast<const VectorInfo *>(&info)) {
+        for (size_t i = 0; i < stat.columns; ++i)
+            names.push_back(base + "::" + subname(vec->subnames, i));
+    } else {
+        names.push_back(base);
+    }
+
+    panic_if(names.size() - start != stat.columns,
+             "Mismatched number of columns for stat %s\n", base);
+}
+
+void
+Columnar::writeSchema()
+{
+    std::vector<std::string> names;
+    for (const auto &stat : stats)
+        columnNames(stat, names);
+
+    writeWord(SchemaBlock);
+    writeWord(names.size());
+    size_t column = 0;
+    for (const auto &stat : stats) {
+        const std::string unit = stat.info->unit->getUnitString();
+        const std::string &desc =
+            enableDescriptions ? stat.info->desc : std::string();
+        for (size_t i = 0; i < stat.columns; ++i, ++column) {
+            writeString(names[column]);
+            writeString(unit);
+            writeString(desc);
+        }
+    }
+
+    schema = stats;
+}
+
+void
+Columnar::writeWord(uint64_t word)
+{
+    stream->write((const char *)&word, sizeof(word));
+}
+
+void
+Columnar::writeString(const std::string &str)
+{
+    writeWord(str.size());
+    stream->write(str.data(), str.size());
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, bool desc)
+{
+    return std::make_unique<Columnar>(simout.create(filename, true), desc);
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+/**
+ * A compact binary stats format, where the name, unit and description
+ * of each value (a column) are written once and every dump then only
+ * appends a row of raw values. This avoids formatting the stats as
+ * text on every dump.
+ *
+ * The file starts with a magic word followed by a sequence of
+ * blocks. A schema block lists the columns, and is repeated whenever
+ * the set of dumped stats changes. A row block holds the tick of the
+ * dump and a double per column of the latest schema. All words are
+ * in host byte order.
+ */
+class Columnar : public Output
+{
+  public:
+    static constexpr uint64_t Magic = 0x4c435453354d4547ULL; // "GEM5STCL"
+    static constexpr uint64_t SchemaBlock = 1;
+    static constexpr uint64_t RowBlock = 2;
+
+    Columnar(OutputStream *stream, bool desc);
+    /** Write to a stream that is owned by the caller. */
+    Columnar(std::ostream &stream, bool desc);
+    ~Columnar();
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** A stat in the current dump and the columns it occupies. */
+    struct Stat
+    {
+        const Info *info;
+        size_t prefix;
+        size_t columns;
+
+        bool
+        operator==(const Stat &other) const
+        {
+            return info == other.info && columns == other.columns;
+        }
+    };
+
+    /** Record a stat and the values of its columns. */
+    void addStat(const Info &info, const double *data, size_t count);
+
+    /** Append the values of a distribution, returning their number. */
+    size_t addDist(const DistData &data);
+
+    /** Get the names of the columns of a stat. */
+    void columnNames(const Stat &stat, std::vector<std::string> &names) const;
+
+    /** Write a schema block for the stats of the current dump. */
+    void writeSchema();
+
+    void writeWord(uint64_t word);
+    void writeString(const std::string &str);
+
+  protected:
+    OutputStream *const outputStream;
+    std::ostream *const stream;
+    const bool enableDescriptions;
+
+    /** Group path prefixes seen in this dump, with the current one. */
+    std::vector<std::string> prefixes;
+    std::vector<size_t> path;
+
+    /** Stats and values of the current dump. */
+    std::vector<Stat> stats;
+    std::vector<double> values;
+
+    /** Stats of the latest schema block. */
+    std::vector<Stat> schema;
+};
+
+std::unique_ptr<Output> initColumnar(const std::string &filename,
+                                     bool desc = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_COLUMNAR_HH__
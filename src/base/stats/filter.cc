@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/filter.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/stats/info.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+namespace
+{
+
+void
+appendDist(const DistData &data, std::vector<double> &values)
+{
+    for (Counter v : { data.samples, data.sum, data.squares, data.logs,
+                       data.min_val, data.max_val, data.underflow,
+                       data.overflow }) {
+        values.push_back(v);
+    }
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+} // anonymous namespace
+
+bool
+ChangedFilter::changed(const Info &info, std::vector<double> &values)
+{
+    // NaNs (e.g., formulas dividing by zero) compare equal to each
+    // other here, otherwise they would be forwarded on every dump
+    auto same = [](double a, double b) {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    };
+
+    auto it = last.find(&info);
+    if (it != last.end() && it->second.size() == values.size() &&
+        std::equal(values.begin(), values.end(), it->second.begin(), same)) {
+        return false;
+    }
+
+    if (it == last.end())
+        last.emplace(&info, values);
+    else
+        it->second.swap(values);
+    return true;
+}
+
+void
+ChangedFilter::visit(const ScalarInfo &info)
+{
+    current.assign(1, info.result());
+    if (changed(info, current))
+        output.visit(info);
+}
+
+void
+ChangedFilter::visit(const VectorInfo &info)
+{
+    const VResult &vr(info.result());
+    current.assign(vr.begin(), vr.end());
+    if (changed(info, current))
+        output.visit(info);
+}
+
+void
+ChangedFilter::visit(const DistInfo &info)
+{
+    current.clear();
+    appendDist(info.data, current);
+    if (changed(info, current))
+        output.visit(info);
+}
+
+void
+ChangedFilter::visit(const VectorDistInfo &info)
+{
+    current.clear();
+    for (const auto &data : info.data)
+        appendDist(data, current);
+    if (changed(info, current))
+        output.visit(info);
+}
+
+void
+ChangedFilter::visit(const Vector2dInfo &info)
+{
+    current.assign(info.cvec.begin(), info.cvec.end());
+    if (changed(info, current))
+        output.visit(info);
+}
+
+void
+ChangedFilter::visit(const FormulaInfo &info)
+{
+    const VResult &vr(info.result());
+    current.assign(vr.begin(), vr.end());
+    if (changed(info, current))
+        output.visit(info);
+}
+
+void
+ChangedFilter::visit(const SparseHistInfo &info)
+{
+    current.clear();
+    current.push_back(info.data.samples);
+    for (const auto &[key, count] : info.data.cmap) {
+        current.push_back(key);
+        current.push_back(count);
+    }
+    if (changed(info, current))
+        output.visit(info);
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_FILTER_HH__
+#define __BASE_STATS_FILTER_HH__
+
+#include <unordered_map>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/stats/output.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+class Info;
+
+/**
+ * An output that forwards stats to another output only if their
+ * values have changed since they were last forwarded, such that
+ * frequent dumps don't pay for formatting stats that are unchanged.
+ * Groups are always forwarded.
+ */
+class ChangedFilter : public Output
+{
+  public:
+    ChangedFilter(Output &output) : output(output) {}
+
+  public: // Output interface
+    void begin() override { output.begin(); }
+    void end() override { output.end(); }
+    bool valid() const override { return output.valid(); }
+
+    void beginGroup(const char *name) override { output.beginGroup(name); }
+    void endGroup() override { output.endGroup(); }
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /**
+     * Check if the current values of a stat differ from the ones it
+     * was last forwarded with, and remember them if so.
+     */
+    bool changed(const Info &info, std::vector<double> &values);
+
+    Output &output;
+
+    /** The values each stat was last forwarded with. */
+    std::unordered_map<const Info *, std::vector<double>> last;
+
+    /** Scratch space for the current values of a stat. */
+    std::vector<double> current;
+};
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_FILTER_HH__
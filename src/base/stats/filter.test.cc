@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "base/stats/filter.hh"
+#include "base/stats/info.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class TestScalarInfo : public statistics::ScalarInfo
+{
+  public:
+    double v = 0;
+
+    statistics::Counter value() const override { return v; }
+    statistics::Result result() const override { return v; }
+    statistics::Result total() const override { return v; }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { v = 0; }
+    bool zero() const override { return v == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+/** An output that records the names of the stats it is handed. */
+class RecordingOutput : public statistics::Output
+{
+  public:
+    std::vector<std::string> visited;
+
+    void begin() override { visited.clear(); }
+    void end() override {}
+    bool valid() const override { return true; }
+
+    void beginGroup(const char *name) override {}
+    void endGroup() override {}
+
+    void
+    visit(const statistics::ScalarInfo &info) override
+    {
+        visited.push_back(info.name);
+    }
+    void visit(const statistics::VectorInfo &info) override {}
+    void visit(const statistics::DistInfo &info) override {}
+    void visit(const statistics::VectorDistInfo &info) override {}
+    void visit(const statistics::Vector2dInfo &info) override {}
+    void visit(const statistics::FormulaInfo &info) override {}
+    void visit(const statistics::SparseHistInfo &info) override {}
+};
+
+} // anonymous namespace
+
+/** Test that only the stats that changed since their last dump pass. */
+TEST(StatsChangedFilterTest, OnlyChanged)
+{
+    RecordingOutput recorder;
+    statistics::ChangedFilter filter(recorder);
+
+    TestScalarInfo a, b;
+    a.name = "a";
+    b.name = "b";
+
+    auto dump = [&]() {
+        filter.begin();
+        a.visit(filter);
+        b.visit(filter);
+        filter.end();
+        return recorder.visited;
+    };
+
+    // Everything is new on the first dump
+    ASSERT_EQ(dump(), std::vector<std::string>({ "a", "b" }));
+
+    // Nothing changed
+    ASSERT_TRUE(dump().empty());
+
+    b.v = 5;
+    ASSERT_EQ(dump(), std::vector<std::string>({ "b" }));
+    ASSERT_TRUE(dump().empty());
+
+    a.v = 1;
+    b.v = 0;
+    ASSERT_EQ(dump(), std::vector<std::string>({ "a", "b" }));
+}
+
+/** Test that a NaN is not considered a change from a NaN. */
+TEST(StatsChangedFilterTest, NaN)
+{
+    RecordingOutput recorder;
+    statistics::ChangedFilter filter(recorder);
+
+    TestScalarInfo a;
+    a.name = "a";
+    a.v = NAN;
+
+    filter.begin();
+    a.visit(filter);
+    ASSERT_EQ(recorder.visited.size(), 1);
+
+    filter.begin();
+    a.visit(filter);
+    ASSERT_TRUE(recorder.visited.empty());
+}
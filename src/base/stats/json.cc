@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/json.hh"
+
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <ostream>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+namespace
+{
+
+/**
+ * Format a double like Python's repr() does, which is what the Python
+ * JSON encoder uses: the shortest digits that round trip, in fixed
+ * notation unless the exponent is very small or large.
+ */
+std::string
+formatDouble(double v)
+{
+    if (std::isnan(v))
+        return "NaN";
+    if (std::isinf(v))
+        return v > 0 ? "Infinity" : "-Infinity";
+
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), v,
+                             std::chars_format::scientific);
+    assert(res.ec == std::errc());
+    const std::string sci(buf, res.ptr);
+
+    const size_t e = sci.find('e');
+    const int exp = std::atoi(sci.c_str() + e + 1);
+    std::string out = std::signbit(v) ? "-" : "";
+    std::string digits;
+    for (size_t i = out.size(); i < e; ++i) {
+        if (sci[i] != '.')
+            digits += sci[i];
+    }
+
+    const int decpt = exp + 1;
+    if (decpt > -4 && decpt <= 16) {
+        if (decpt <= 0) {
+            out += "0." + std::string(-decpt, '0') + digits;
+        } else if (decpt >= (int)digits.size()) {
+            out += digits + std::string(decpt - digits.size(), '0') + ".0";
+        } else {
+            out += digits.substr(0, decpt) + "." + digits.substr(decpt);
+        }
+    } else {
+        out += digits.substr(0, 1);
+        if (digits.size() > 1)
+            out += "." + digits.substr(1);
+        out += csprintf("e%c%02d", exp < 0 ? '-' : '+', std::abs(exp));
+    }
+    return out;
+}
+
+std::string
+escape(const std::string &str)
+{
+    std::string out;
+    for (char c : str) {
+        switch (c) {
+          case '"': out += "\\\""; break;
+          case '\\': out += "\\\\"; break;
+          case '\n': out += "\\n"; break;
+          case '\r': out += "\\r"; break;
+          case '\t': out += "\\t"; break;
+          case '\b': out += "\\b"; break;
+          case '\f': out += "\\f"; break;
+          default:
+            if ((unsigned char)c < 0x20)
+                out += csprintf("\\u%04x", (unsigned)c);
+            else
+                out += c;
+        }
+    }
+    return out;
+}
+
+std::string
+subname(const std::vector<std::string> &subnames, size_t i)
+{
+    return i < subnames.size() && !subnames[i].empty() ?
+        subnames[i] : std::to_string(i);
+}
+
+} // anonymous namespace
+
+Json::Json(const std::string &_filename)
+    : filename(_filename), file(filename), stream(&file),
+      headerDone(false), finalTick(0), simTicks(0)
+{
+    fatal_if(!file.good(), "Cannot open JSON stats file %s\n", filename);
+}
+
+Json::Json(std::ostream &_stream)
+    : stream(&_stream), headerDone(false), finalTick(0), simTicks(0)
+{
+}
+
+void
+Json::begin()
+{
+    // Every dump overwrites the previous one
+    if (!filename.empty()) {
+        file.close();
+        file.open(filename, std::ios::trunc);
+    }
+
+    // Unless the root stats say otherwise
+    finalTick = curTick();
+    simTicks = curTick();
+    headerDone = false;
+
+    empty.clear();
+    open('{');
+}
+
+void
+Json::end()
+{
+    assert(valid());
+    assert(empty.size() == 1);
+
+    header();
+    endObject();
+    stream->flush();
+}
+
+bool
+Json::valid() const
+{
+    return stream->good();
+}
+
+void
+Json::key(const std::string &name)
+{
+    element();
+    *stream << "\"" << escape(name) << "\": ";
+}
+
+void
+Json::element()
+{
+    if (!empty.back())
+        *stream << ",";
+    empty.back() = false;
+    *stream << "\n" << std::string(4 * empty.size(), ' ');
+}
+
+void
+Json::open(char bracket)
+{
+    *stream << bracket;
+    empty.push_back(true);
+}
+
+void
+Json::close(char bracket)
+{
+    const bool was_empty = empty.back();
+    empty.pop_back();
+    if (!was_empty)
+        *stream << "\n" << std::string(4 * empty.size(), ' ');
+    *stream << bracket;
+}
+
+void
+Json::beginObject(const std::string &name)
+{
+    key(name);
+    open('{');
+}
+
+void
+Json::value(double v)
+{
+    *stream << formatDouble(v);
+}
+
+void
+Json::value(const std::string &str)
+{
+    *stream << "\"" << escape(str) << "\"";
+}
+
+void
+Json::header()
+{
+    if (headerDone)
+        return;
+    headerDone = true;
+
+    char created[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(created, sizeof(created), "%Y-%m-%dT%H:%M:%S",
+                  std::localtime(&now));
+
+    key("creation_time");
+    value(created);
+    key("time_conversion");
+    *stream << "null";
+    key("simulated_begin_time");
+    *stream << finalTick - simTicks;
+    key("simulated_end_time");
+    *stream << finalTick;
+}
+
+void
+Json::beginGroup(const char *name)
+{
+    if (empty.size() == 1)
+        header();
+
+    beginObject(name);
+    key("type");
+    value("Group");
+    key("time_conversion");
+    *stream << "null";
+}
+
+void
+Json::endGroup()
+{
+    assert(empty.size() > 1);
+    endObject();
+}
+
+void
+Json::statFields(const char *type, const Info &info, const std::string &desc)
+{
+    key("type");
+    value(type);
+    key("unit");
+    value(info.unit->getUnitString());
+    key("description");
+    value(desc);
+    key("datatype");
+    value("f64");
+}
+
+void
+Json::visit(const ScalarInfo &info)
+{
+    // The stats of the root group only provide the simulated times
+    if (empty.size() == 1) {
+        if (info.name == "finalTick")
+            finalTick = info.value();
+        else if (info.name == "simTicks")
+            simTicks = info.value();
+        return;
+    }
+
+    beginObject(info.name);
+    key("value");
+    value(info.value());
+    statFields("Scalar", info, info.desc);
+    endObject();
+}
+
+void
+Json::visit(const VectorInfo &info)
+{
+    if (empty.size() == 1)
+        return;
+
+    const VCounter &vec = info.value();
+    beginObject(info.name);
+    key("type");
+    value("Vector");
+    key("time_conversion");
+    *stream << "null";
+    for (size_t i = 0; i < vec.size(); ++i) {
+        beginObject(subname(info.subnames, i));
+        key("value");
+        value(vec[i]);
+        statFields("Scalar", info,
+                   i < info.subdescs.size() ? info.subdescs[i] : "");
+        endObject();
+    }
+    endObject();
+}
+
+void
+Json::visit(const DistInfo &info)
+{
+    if (empty.size() == 1)
+        return;
+
+    const DistData &data = info.data;
+    beginObject(info.name);
+    key("value");
+    open('[');
+    for (Counter c : data.cvec) {
+        element();
+        value(c);
+    }
+    close(']');
+
+    statFields("Distribution", info, info.desc);
+    key("min");
+    value(data.min_val);
+    key("max");
+    value(data.max_val);
+    key("num_bins");
+    *stream << data.cvec.size();
+    key("bin_size");
+    value(data.bucket_size);
+    key("sum");
+    value(data.sum);
+    key("underflow");
+    value(data.underflow);
+    key("overflow");
+    value(data.overflow);
+    key("logs");
+    value(data.logs);
+    key("sum_squared");
+    value(data.squares);
+    endObject();
+}
+
+void
+Json::visit(const VectorDistInfo &info)
+{
+}
+
+void
+Json::visit(const Vector2dInfo &info)
+{
+}
+
+void
+Json::visit(const FormulaInfo &info)
+{
+}
+
+void
+Json::visit(const SparseHistInfo &info)
+{
+}
+
+std::unique_ptr<Output>
+initJson(const std::string &filename)
+{
+    return std::make_unique<Json>(filename);
+}
+
+} // namespace statistics
+} // namespace gem5
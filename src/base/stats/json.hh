@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_JSON_HH__
+#define __BASE_STATS_JSON_HH__
+
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+/**
+ * Write stats as JSON while they are visited, using the schema of the
+ * Python SimStat objects (m5.ext.pystats), so the output can be loaded
+ * with m5.ext.pystats.jsonloader. Every dump replaces the content of
+ * the file.
+ *
+ * Like the Python implementation, only the stats of groups are
+ * written, and formulas, vector distributions, 2d vectors and sparse
+ * histograms are left out. The simulated begin and end times are taken
+ * from the finalTick and simTicks stats of the root group when they are
+ * part of the dump.
+ */
+class Json : public Output
+{
+  public:
+    Json(const std::string &filename);
+    /** Write to a stream that is owned by the caller. */
+    Json(std::ostream &stream);
+
+    Json() = delete;
+    Json(const Json &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** Start a member of the current object, or an element of a list. */
+    void key(const std::string &name);
+    void element();
+
+    /** Open or close an object ('{') or a list ('['). */
+    void open(char bracket);
+    void close(char bracket);
+
+    void beginObject(const std::string &name);
+    void endObject() { close('}'); }
+
+    void value(double v);
+    void value(const std::string &str);
+
+    /** Write the members describing a stat of the given type. */
+    void statFields(const char *type, const Info &info,
+                    const std::string &desc);
+
+    /** Write the SimStat members preceding the groups. */
+    void header();
+
+  protected:
+    const std::string filename;
+    std::ofstream file;
+    std::ostream *stream;
+
+    /** For every open object or list, whether it has no member yet. */
+    std::vector<bool> empty;
+    bool headerDone;
+
+    Tick finalTick;
+    Tick simTicks;
+};
+
+std::unique_ptr<Output> initJson(const std::string &filename);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_JSON_HH__
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "base/stats/info.hh"
+#include "base/stats/json.hh"
+#include "base/stats/units.hh"
+#include "sim/cur_tick.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class TestScalarInfo : public statistics::ScalarInfo
+{
+  public:
+    double v = 0;
+
+    statistics::Counter value() const override { return v; }
+    statistics::Result result() const override { return v; }
+    statistics::Result total() const override { return v; }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { v = 0; }
+    bool zero() const override { return v == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class TestVectorInfo : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter v;
+    statistics::VResult r;
+
+    statistics::size_type size() const override { return v.size(); }
+    const statistics::VCounter &value() const override { return v; }
+    const statistics::VResult &result() const override { return r; }
+    statistics::Result total() const override { return 0; }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class TestDistInfo : public statistics::DistInfo
+{
+  public:
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class StatsJsonTest : public testing::Test
+{
+  protected:
+    Tick tick = 1000;
+
+    void
+    SetUp() override
+    {
+        Gem5Internal::_curTickPtr = &tick;
+    }
+
+    void
+    TearDown() override
+    {
+        Gem5Internal::_curTickPtr = nullptr;
+    }
+
+    /** Get the output, without the line of the creation time. */
+    static std::string
+    output(const std::ostringstream &os)
+    {
+        std::string str = os.str();
+        const size_t start = str.find("\n    \"creation_time\"");
+        if (start == std::string::npos)
+            return str;
+        return str.erase(start, str.find('\n', start + 1) - start);
+    }
+};
+
+} // anonymous namespace
+
+/** Test the groups and scalars, and the times taken from the root stats. */
+TEST_F(StatsJsonTest, Scalar)
+{
+    std::ostringstream os;
+    statistics::Json json(os);
+
+    TestScalarInfo final_tick, sim_ticks, ipc;
+    final_tick.name = "finalTick";
+    final_tick.v = 1000;
+    sim_ticks.name = "simTicks";
+    sim_ticks.v = 400;
+    ipc.name = "ipc";
+    ipc.desc = "IPC \"per\" cycle";
+    ipc.unit = statistics::units::Count::get();
+    ipc.v = 1.5;
+
+    json.begin();
+    final_tick.visit(json);
+    sim_ticks.visit(json);
+    json.beginGroup("system");
+    json.beginGroup("cpu");
+    ipc.visit(json);
+    json.endGroup();
+    json.endGroup();
+    json.end();
+
+    ASSERT_EQ(output(os),
+        "{\n"
+        "    \"time_conversion\": null,\n"
+        "    \"simulated_begin_time\": 600,\n"
+        "    \"simulated_end_time\": 1000,\n"
+        "    \"system\": {\n"
+        "        \"type\": \"Group\",\n"
+        "        \"time_conversion\": null,\n"
+        "        \"cpu\": {\n"
+        "            \"type\": \"Group\",\n"
+        "            \"time_conversion\": null,\n"
+        "            \"ipc\": {\n"
+        "                \"value\": 1.5,\n"
+        "                \"type\": \"Scalar\",\n"
+        "                \"unit\": \"Count\",\n"
+        "                \"description\": \"IPC \\\"per\\\" cycle\",\n"
+        "                \"datatype\": \"f64\"\n"
+        "            }\n"
+        "        }\n"
+        "    }\n"
+        "}");
+}
+
+/** Test that vectors are groups of scalars named after their entries. */
+TEST_F(StatsJsonTest, Vector)
+{
+    std::ostringstream os;
+    statistics::Json json(os);
+
+    TestVectorInfo hits;
+    hits.name = "hits";
+    hits.v = { 3, 4 };
+    hits.subnames = { "", "cpu1" };
+    hits.subdescs = { "first", "" };
+
+    json.begin();
+    json.beginGroup("cache");
+    hits.visit(json);
+    json.endGroup();
+    json.end();
+
+    ASSERT_EQ(output(os),
+        "{\n"
+        "    \"time_conversion\": null,\n"
+        "    \"simulated_begin_time\": 0,\n"
+        "    \"simulated_end_time\": 1000,\n"
+        "    \"cache\": {\n"
+        "        \"type\": \"Group\",\n"
+        "        \"time_conversion\": null,\n"
+        "        \"hits\": {\n"
+        "            \"type\": \"Vector\",\n"
+        "            \"time_conversion\": null,\n"
+        "            \"0\": {\n"
+        "                \"value\": 3.0,\n"
+        "                \"type\": \"Scalar\",\n"
+        "                \"unit\": \"Unspecified\",\n"
+        "                \"description\": \"first\",\n"
+        "                \"datatype\": \"f64\"\n"
+        "            },\n"
+        "            \"cpu1\": {\n"
+        "                \"value\": 4.0,\n"
+        "                \"type\": \"Scalar\",\n"
+        "                \"unit\": \"Unspecified\",\n"
+        "                \"description\": \"\",\n"
+        "                \"datatype\": \"f64\"\n"
+        "            }\n"
+        "        }\n"
+        "    }\n"
+        "}");
+}
+
+/** Test the fields of a distribution. */
+TEST_F(StatsJsonTest, Distribution)
+{
+    std::ostringstream os;
+    statistics::Json json(os);
+
+    TestDistInfo lat;
+    lat.name = "lat";
+    lat.desc = "latency";
+    lat.data.cvec = { 1, 2 };
+    lat.data.min_val = 4;
+    lat.data.max_val = 12;
+    lat.data.bucket_size = 5;
+    lat.data.sum = 28;
+    lat.data.squares = 200;
+    lat.data.underflow = 0;
+    lat.data.overflow = 0;
+    lat.data.logs = 0.5;
+
+    json.begin();
+    json.beginGroup("mem");
+    lat.visit(json);
+    json.endGroup();
+    json.end();
+
+    ASSERT_EQ(output(os),
+        "{\n"
+        "    \"time_conversion\": null,\n"
+        "    \"simulated_begin_time\": 0,\n"
+        "    \"simulated_end_time\": 1000,\n"
+        "    \"mem\": {\n"
+        "        \"type\": \"Group\",\n"
+        "        \"time_conversion\": null,\n"
+        "        \"lat\": {\n"
+        "            \"value\": [\n"
+        "                1.0,\n"
+        "                2.0\n"
+        "            ],\n"
+        "            \"type\": \"Distribution\",\n"
+        "            \"unit\": \"Unspecified\",\n"
+        "            \"description\": \"latency\",\n"
+        "            \"datatype\": \"f64\",\n"
+        "            \"min\": 4.0,\n"
+        "            \"max\": 12.0,\n"
+        "            \"num_bins\": 2,\n"
+        "            \"bin_size\": 5.0,\n"
+        "            \"sum\": 28.0,\n"
+        "            \"underflow\": 0.0,\n"
+        "            \"overflow\": 0.0,\n"
+        "            \"logs\": 0.5,\n"
+        "            \"sum_squared\": 200.0\n"
+        "        }\n"
+        "    }\n"
+        "}");
+}
+
+/** Test that numbers are spelled as the Python JSON encoder does. */
+TEST_F(StatsJsonTest, Numbers)
+{
+    const std::pair<double, const char *> numbers[] = {
+        { 0, "0.0" },
+        { -0.0, "-0.0" },
+        { 100000, "100000.0" },
+        { 1e16, "1e+16" },
+        { 1.5e16, "1.5e+16" },
+        { 123456789012345678.0, "1.2345678901234568e+17" },
+        { 0.0001, "0.0001" },
+        { 1e-05, "1e-05" },
+        { -2.5e-300, "-2.5e-300" },
+        { 1.0 / 3, "0.3333333333333333" },
+        { NAN, "NaN" },
+        { INFINITY, "Infinity" },
+        { -INFINITY, "-Infinity" },
+    };
+
+    for (const auto &number : numbers) {
+        std::ostringstream os;
+        statistics::Json json(os);
+
+        TestScalarInfo stat;
+        stat.name = "stat";
+        stat.v = number.first;
+
+        json.begin();
+        json.beginGroup("group");
+        stat.visit(json);
+        json.endGroup();
+        json.end();
+
+        const std::string expected =
+            std::string("\"value\": ") + number.second + ",";
+        EXPECT_NE(os.str().find(expected), std::string::npos)
+            << expected << " not found in:\n" << os.str();
+    }
+}
+
+/** Test that the stats outside of groups are left out. */
+TEST_F(StatsJsonTest, NoGroups)
+{
+    std::ostringstream os;
+    statistics::Json json(os);
+
+    TestScalarInfo legacy;
+    legacy.name = "legacy";
+
+    json.begin();
+    legacy.visit(json);
+    json.end();
+
+    ASSERT_EQ(output(os),
+        "{\n"
+        "    \"time_conversion\": null,\n"
+        "    \"simulated_begin_time\": 0,\n"
+        "    \"simulated_end_time\": 1000\n"
+        "}");
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/prometheus.hh"
+
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <ostream>
+
+#include "base/cprintf.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+namespace
+{
+
+/** Replace the characters Prometheus doesn't allow in a metric name. */
+std::string
+metricName(const std::string &name)
+{
+    std::string metric = "gem5_" + name;
+    for (char &c : metric) {
+        if (!std::isalnum((unsigned char)c) && c != '_' && c != ':')
+            c = '_';
+    }
+    return metric;
+}
+
+/** Escape a label value or the text of a HELP line. */
+std::string
+escape(const std::string &str, bool quotes)
+{
+    std::string out;
+    for (char c : str) {
+        if (c == '\\')
+            out += "\\\\";
+        else if (c == '\n')
+            out += "\\n";
+        else if (c == '"' && quotes)
+            out += "\\\"";
+        else
+            out += c;
+    }
+    return out;
+}
+
+std::string
+label(const std::string &name, const std::string &value)
+{
+    return name + "=\"" + escape(value, true) + "\"";
+}
+
+std::string
+subname(const std::vector<std::string> &subnames, size_t i)
+{
+    return i < subnames.size() && !subnames[i].empty() ?
+        subnames[i] : std::to_string(i);
+}
+
+} // anonymous namespace
+
+Prometheus::Prometheus(std::ostream &_stream, bool desc)
+    : stream(_stream), enableDescriptions(desc)
+{
+}
+
+void
+Prometheus::begin()
+{
+    path.assign(1, "");
+    if (enableDescriptions)
+        ccprintf(stream, "# HELP gem5_tick Current simulated tick\n");
+    ccprintf(stream, "# TYPE gem5_tick counter\n");
+    ccprintf(stream, "gem5_tick %d\n", curTick());
+}
+
+void
+Prometheus::end()
+{
+    assert(valid());
+    stream.flush();
+}
+
+bool
+Prometheus::valid() const
+{
+    return stream.good();
+}
+
+void
+Prometheus::beginGroup(const char *name)
+{
+    path.push_back(path.back() + name + ".");
+}
+
+void
+Prometheus::endGroup()
+{
+    assert(path.size() > 1);
+    path.pop_back();
+}
+
+std::string
+Prometheus::header(const Info &info)
+{
+    const std::string metric = metricName(path.back() + info.name);
+    if (enableDescriptions && !info.desc.empty())
+        ccprintf(stream, "# HELP %s %s\n", metric, escape(info.desc, false));
+    ccprintf(stream, "# TYPE %s gauge\n", metric);
+    return metric;
+}
+
+void
+Prometheus::sample(const std::string &metric, const std::string &labels,
+                   double value)
+{
+    stream << metric;
+    if (!labels.empty())
+        stream << "{" << labels << "}";
+
+    if (std::isnan(value))
+        stream << " NaN\n";
+    else if (std::isinf(value))
+        stream << (value > 0 ? " +Inf\n" : " -Inf\n");
+    else
+        ccprintf(stream, " %.17g\n", value);
+}
+
+void
+Prometheus::dist(const std::string &metric, const std::string &labels,
+                 const DistData &data)
+{
+    const std::string sep = labels.empty() ? "" : labels + ",";
+    const std::pair<const char *, Counter> fields[] = {
+        { "samples", data.samples },
+        { "sum", data.sum },
+        { "squares", data.squares },
+        { "min_value", data.min_val },
+        { "max_value", data.max_val },
+        { "underflows", data.underflow },
+        { "overflows", data.overflow },
+    };
+    for (const auto &field : fields)
+        sample(metric, sep + label("field", field.first), field.second);
+
+    for (size_t i = 0; i < data.cvec.size(); ++i) {
+        sample(metric,
+               sep + label("bucket",
+                           csprintf("%g", data.min + i * data.bucket_size)),
+               data.cvec[i]);
+    }
+}
+
+void
+Prometheus::visit(const ScalarInfo &info)
+{
+    sample(header(info), "", info.result());
+}
+
+void
+Prometheus::visit(const VectorInfo &info)
+{
+    const std::string metric = header(info);
+    const VResult &vr(info.result());
+    for (size_t i = 0; i < vr.size(); ++i)
+        sample(metric, label("index", subname(info.subnames, i)), vr[i]);
+}
+
+void
+Prometheus::visit(const DistInfo &info)
+{
+    dist(header(info), "", info.data);
+}
+
+void
+Prometheus::visit(const VectorDistInfo &info)
+{
+    const std::string metric = header(info);
+    for (size_t i = 0; i < info.data.size(); ++i)
+        dist(metric, label("index", subname(info.subnames, i)), info.data[i]);
+}
+
+void
+Prometheus::visit(const Vector2dInfo &info)
+{
+    const std::string metric = header(info);
+    for (size_t x = 0; x < info.x; ++x) {
+        for (size_t y = 0; y < info.y; ++y) {
+            sample(metric,
+                   label("x", subname(info.subnames, x)) + "," +
+                   label("y", subname(info.y_subnames, y)),
+                   info.cvec[x * info.y + y]);
+        }
+    }
+}
+
+void
+Prometheus::visit(const FormulaInfo &info)
+{
+    const std::string metric = header(info);
+    const VResult &vr(info.result());
+    if (vr.size() == 1) {
+        sample(metric, "", vr[0]);
+        return;
+    }
+    for (size_t i = 0; i < vr.size(); ++i)
+        sample(metric, label("index", subname(info.subnames, i)), vr[i]);
+}
+
+void
+Prometheus::visit(const SparseHistInfo &info)
+{
+    const std::string metric = header(info);
+    sample(metric, label("field", "samples"), info.data.samples);
+    for (const auto &entry : info.data.cmap)
+        sample(metric, label("value", csprintf("%g", entry.first)),
+               entry.second);
+}
+
+} // namespace statistics
+} // namespace gem5
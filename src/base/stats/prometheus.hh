@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_PROMETHEUS_HH__
+#define __BASE_STATS_PROMETHEUS_HH__
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+/**
+ * Write stats in the Prometheus text exposition format. Every stat
+ * becomes a gauge named after its full path, with the dots (and any
+ * other character Prometheus doesn't allow) replaced by underscores
+ * and a "gem5_" prefix. Entries of vectors and fields of distributions
+ * are told apart by labels, so system.cpu.ipc becomes gem5_system_cpu_ipc
+ * and an entry of a vector becomes metric{index="name"}.
+ */
+class Prometheus : public Output
+{
+  public:
+    Prometheus(std::ostream &stream, bool desc = true);
+
+    Prometheus() = delete;
+    Prometheus(const Prometheus &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** Write the HELP and TYPE lines of a stat, returning its metric. */
+    std::string header(const Info &info);
+
+    /** Write a sample of a metric, with optional comma separated labels. */
+    void sample(const std::string &metric, const std::string &labels,
+                double value);
+
+    /** Write the fields of a distribution. */
+    void dist(const std::string &metric, const std::string &labels,
+              const DistData &data);
+
+  protected:
+    std::ostream &stream;
+    const bool enableDescriptions;
+
+    /** Metric name prefixes of the enclosing groups. */
+    std::vector<std::string> path;
+};
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_PROMETHEUS_HH__
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "base/stats/info.hh"
+#include "base/stats/prometheus.hh"
+#include "sim/cur_tick.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class TestScalarInfo : public statistics::ScalarInfo
+{
+  public:
+    double v = 0;
+
+    statistics::Counter value() const override { return v; }
+    statistics::Result result() const override { return v; }
+    statistics::Result total() const override { return v; }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { v = 0; }
+    bool zero() const override { return v == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class StatsPrometheusTest : public testing::Test
+{
+  protected:
+    Tick tick = 1000;
+
+    void
+    SetUp() override
+    {
+        Gem5Internal::_curTickPtr = &tick;
+    }
+
+    void
+    TearDown() override
+    {
+        Gem5Internal::_curTickPtr = nullptr;
+    }
+};
+
+} // anonymous namespace
+
+/** Test that a stat is named after its group path and described. */
+TEST_F(StatsPrometheusTest, Scalar)
+{
+    std::ostringstream os;
+    statistics::Prometheus output(os);
+
+    TestScalarInfo ipc;
+    ipc.name = "ipc";
+    ipc.desc = "IPC: \\ per\ncycle";
+    ipc.v = 1.5;
+
+    output.begin();
+    output.beginGroup("system");
+    output.beginGroup("cpu-0");
+    ipc.visit(output);
+    output.endGroup();
+    output.endGroup();
+    output.end();
+
+    ASSERT_EQ(os.str(),
+        "# HELP gem5_tick Current simulated tick\n"
+        "# TYPE gem5_tick counter\n"
+        "gem5_tick 1000\n"
+        "# HELP gem5_system_cpu_0_ipc IPC: \\\\ per\\ncycle\n"
+        "# TYPE gem5_system_cpu_0_ipc gauge\n"
+        "gem5_system_cpu_0_ipc 1.5\n");
+}
+
+/** Test the spelling of values that aren't finite numbers. */
+TEST_F(StatsPrometheusTest, NotFinite)
+{
+    std::ostringstream os;
+    statistics::Prometheus output(os, false);
+
+    TestScalarInfo a, b;
+    a.name = "a";
+    a.v = NAN;
+    b.name = "b";
+    b.v = -INFINITY;
+
+    output.begin();
+    a.visit(output);
+    b.visit(output);
+    output.end();
+
+    ASSERT_EQ(os.str(),
+        "# TYPE gem5_tick counter\n"
+        "gem5_tick 1000\n"
+        "# TYPE gem5_a gauge\n"
+        "gem5_a NaN\n"
+        "# TYPE gem5_b gauge\n"
+        "gem5_b -Inf\n");
+}
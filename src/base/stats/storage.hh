@@ -32,6 +32,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <type_traits>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
@@ -216,6 +217,19 @@ class AvgStor
 
 };
 
+/**
+ * Whether the storage of a vector or distribution may be allocated the first
+ * time it is written instead of when the stat is initialized. Storage that
+ * never gets written then costs nothing beyond a null pointer. AvgStor
+ * accumulates over the ticks since the last reset, so it must exist from the
+ * start.
+ */
+template <class Stor>
+struct LazyStorage : std::true_type {};
+
+template <>
+struct LazyStorage<AvgStor> : std::false_type {};
+
 /** The parameters for a distribution stat. */
 struct DistParams : public StorageParams
 {
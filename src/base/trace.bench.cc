@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/named.hh"
+#include "base/trace.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace gem5
+{
+namespace debug
+{
+/** Debug flag used by the benchmarks in this file. */
+SimpleFlag TraceBenchDebugFlag("TraceBenchDebugFlag",
+    "Exclusive debug flag for the trace benchmarks");
+} // namespace debug
+} // namespace gem5
+
+namespace
+{
+
+/**
+ * Cost of a DPRINTF whose flag is disabled, which is what every model
+ * pays on its hot paths in a regular run.
+ */
+void
+BM_DPRINTFDisabled(benchmark::State &state)
+{
+    Named named("bench");
+    debug::changeFlag("TraceBenchDebugFlag", false);
+
+    int value = 0;
+    for (auto _ : state) {
+        DPRINTFS(TraceBenchDebugFlag, &named, "Value %d\n", value);
+        benchmark::DoNotOptimize(++value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_DPRINTFDisabled);
+
+} // anonymous namespace
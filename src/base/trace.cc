@@ -32,6 +32,7 @@
 #include "base/trace.hh"
 
 #include <cctype>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -170,5 +171,50 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     }
 }
 
+void
+BinaryArgs::putString(Tag tag, const std::string &str)
+{
+    putTag(tag);
+    putBytes((uint32_t)str.size());
+    bytes.insert(bytes.end(), str.begin(), str.end());
+}
+
+std::string
+BinaryArgs::spec(const char *fmt, int index)
+{
+    // Find the conversion of the argument the same way cprintf does,
+    // where a '*' width or precision takes an argument of its own.
+    int arg = 0;
+    for (const char *p = fmt; *p; ++p) {
+        if (*p != '%')
+            continue;
+        if (p[1] == '%') {
+            ++p;
+            continue;
+        }
+
+        std::string conv = "%";
+        for (++p; *p; ++p) {
+            if (*p == '*') {
+                if (arg++ == index)
+                    return "%d";
+            } else if (*p == 'l' || *p == 'h') {
+                continue;
+            } else if (std::strchr("#-+ .0123456789", *p)) {
+                conv += *p;
+            } else {
+                conv += *p;
+                break;
+            }
+        }
+
+        if (arg++ == index)
+            return conv;
+        if (!*p)
+            break;
+    }
+    return "%s";
+}
+
 } // namespace Trace
 } // namespace gem5
@@ -32,9 +32,12 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -53,6 +56,90 @@ namespace gem5
 
 namespace Trace {
 
+/**
+ * The arguments of a message in the binary trace format, encoded as a
+ * type tag followed by the raw value. Arguments that aren't a number, a
+ * character, a string or a pointer are formatted on the spot with their
+ * own conversion, and are stored pre-formatted.
+ */
+class BinaryArgs
+{
+  public:
+    enum Tag : uint8_t
+    {
+        Signed = 'i',
+        Unsigned = 'u',
+        Char = 'c',
+        Bool = 'b',
+        Double = 'f',
+        Pointer = 'p',
+        String = 's',
+        Formatted = 'F',
+    };
+
+    /** The encoded arguments. */
+    std::vector<uint8_t> bytes;
+    /** The number of arguments. */
+    uint8_t count = 0;
+
+    void
+    clear()
+    {
+        bytes.clear();
+        count = 0;
+    }
+
+    template <typename T>
+    void
+    add(const char *fmt, const T &arg)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            putTag(Bool);
+            putBytes((uint8_t)arg);
+        } else if constexpr (std::is_same_v<U, char> ||
+                             std::is_same_v<U, signed char> ||
+                             std::is_same_v<U, unsigned char>) {
+            putTag(Char);
+            putBytes((uint8_t)arg);
+        } else if constexpr (std::is_integral_v<U>) {
+            putTag(std::is_signed_v<U> ? Signed : Unsigned);
+            putBytes((uint8_t)sizeof(U));
+            putBytes((uint64_t)arg);
+        } else if constexpr (std::is_floating_point_v<U>) {
+            putTag(Double);
+            putBytes((double)arg);
+        } else if constexpr (std::is_same_v<U, const char *> ||
+                             std::is_same_v<U, char *>) {
+            putString(String, arg ? arg : "(null)");
+        } else if constexpr (std::is_same_v<U, std::string>) {
+            putString(String, arg);
+        } else if constexpr (std::is_pointer_v<U>) {
+            putTag(Pointer);
+            putBytes((uint64_t)(uintptr_t)arg);
+        } else {
+            putString(Formatted, csprintf(spec(fmt, count), arg));
+        }
+        ++count;
+    }
+
+  protected:
+    void putTag(Tag tag) { bytes.push_back(tag); }
+
+    template <typename T>
+    void
+    putBytes(const T &value)
+    {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(&value);
+        bytes.insert(bytes.end(), p, p + sizeof(value));
+    }
+
+    void putString(Tag tag, const std::string &str);
+
+    /** The conversion of an argument in a format string, like "%#x". */
+    static std::string spec(const char *fmt, int index);
+};
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -61,6 +148,12 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /**
+     * Whether messages should be handed to logBinary() with their
+     * arguments instead of being formatted first.
+     */
+    bool binary = false;
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -78,6 +171,13 @@ class Logger
     {
         if (!name.empty() && ignore.match(name))
             return;
+        if (binary) {
+            thread_local BinaryArgs encoded;
+            encoded.clear();
+            (encoded.add(fmt, args), ...);
+            logBinary(when, name, flag, fmt, encoded);
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -91,6 +191,13 @@ class Logger
     virtual void logMessage(Tick when, const std::string &name,
             const std::string &flag, const std::string &message) = 0;
 
+    /** Log a message that hasn't been formatted, see BinaryLogger */
+    virtual void
+    logBinary(Tick when, const std::string &name, const std::string &flag,
+              const char *fmt, const BinaryArgs &args)
+    {
+    }
+
     /** Return an ostream that can be used to send messages to
      *  the 'same place' as formatted logMessage messages.  This
      *  can be implemented to use a logger's underlying ostream,
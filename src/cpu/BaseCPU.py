@@ -218,6 +218,15 @@ class BaseCPU(ClockedObject):
     def addCheckerCpu(self):
         pass
 
+    def addSimPointProbe(self, interval):
+        # CPUs without a Commit probe of their own report the retired
+        # instructions through the PMU probe points.
+        from m5.objects.SimPoint import SimPoint
+        simpoint = SimPoint()
+        simpoint.interval = interval
+        simpoint.probe_source = 'Retired'
+        self.probeListener = simpoint
+
     def createPhandleKey(self, thread):
         # This method creates a unique key for this cpu as a function of a
         # certain thread
@@ -33,6 +33,15 @@ class ExeTracer(InstTracer):
     cxx_class = 'gem5::Trace::ExeTracer'
     cxx_header = "cpu/exetrace.hh"
 
+class BinaryInstTracer(InstTracer):
+    type = 'BinaryInstTracer'
+    cxx_class = 'gem5::Trace::BinaryInstTracer'
+    cxx_header = "cpu/binary_inst_trace.hh"
+    file_name = Param.String("",
+        "Trace file, the tracer's name with .bin.gz added if empty")
+    ring_records = Param.Unsigned(65536,
+        "Number of records buffered between the CPU and the writer thread")
+
 class IntelTrace(InstTracer):
     type = 'IntelTrace'
     cxx_class = 'gem5::Trace::IntelTrace'
@@ -90,6 +90,11 @@ class ActivityRecorder
     /** Returns if the CPU should be active. */
     bool active() { return activityCount; }
 
+    /** Returns if any time buffer communication is still in flight,
+     *  rather than just active stages.
+     */
+    bool communicating() const;
+
     /** Clears the time buffer and the activity count. */
     void reset();
 
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/binary_inst_trace.hh"
+
+#include <chrono>
+#include <ostream>
+
+#include "base/output.hh"
+#include "cpu/static_inst.hh"
+#include "cpu/thread_context.hh"
+#include "debug/ExecEnable.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+namespace Trace {
+
+namespace
+{
+
+uint32_t
+packReg(const RegId &reg)
+{
+    return ((uint32_t)reg.classValue() << 24) | (reg.index() & 0xffffff);
+}
+
+} // anonymous namespace
+
+void
+BinaryInstTraceRecord::dump()
+{
+    BinaryInstTracer::Record rec{};
+    rec.tick = when;
+    rec.pc = pc->instAddr();
+    rec.cpuId = thread->cpuId();
+    rec.opClass = staticInst->opClass();
+
+    if (mem_valid) {
+        rec.flags |= BinaryInstTracer::MemValid;
+        rec.memAddr = addr;
+        rec.memSize = size;
+    }
+    if (faulting)
+        rec.flags |= BinaryInstTracer::Faulting;
+    if (!predicate)
+        rec.flags |= BinaryInstTracer::PredicateFalse;
+    if (staticInst->isMicroop())
+        rec.flags |= BinaryInstTracer::Microop;
+    if (staticInst->isLastMicroop())
+        rec.flags |= BinaryInstTracer::LastMicroop;
+
+    const int num_src = staticInst->numSrcRegs();
+    const int num_dest = staticInst->numDestRegs();
+    int n = 0;
+    for (int i = 0; i < num_src && n < BinaryInstTracer::MaxRegs; i++)
+        rec.regs[n++] = packReg(staticInst->srcRegIdx(i));
+    rec.numSrcRegs = n;
+    for (int i = 0; i < num_dest && n < BinaryInstTracer::MaxRegs; i++)
+        rec.regs[n++] = packReg(staticInst->destRegIdx(i));
+    rec.numDestRegs = n - rec.numSrcRegs;
+    if (n < num_src + num_dest)
+        rec.flags |= BinaryInstTracer::RegsTruncated;
+
+    tracer.record(rec);
+}
+
+BinaryInstTracer::BinaryInstTracer(const BinaryInstTracerParams &p)
+    : InstTracer(p), ring(p.ring_records),
+      file(simout.create(p.file_name.empty() ?
+                         name() + ".bin.gz" : p.file_name, true))
+{
+    const Header header{Magic, Version, sizeof(Record), sim_clock::Frequency};
+    file->stream()->write((const char *)&header, sizeof(header));
+
+    writer = std::thread([this]() { writeRecords(); });
+
+    registerExitCallback([this]() { close(); });
+}
+
+BinaryInstTracer::~BinaryInstTracer()
+{
+    close();
+}
+
+InstRecord *
+BinaryInstTracer::getInstRecord(Tick when, ThreadContext *tc,
+        const StaticInstPtr si, const PCStateBase &pc,
+        const StaticInstPtr mi)
+{
+    if (!debug::ExecEnable)
+        return nullptr;
+
+    return new BinaryInstTraceRecord(*this, when, tc, si, pc, mi);
+}
+
+void
+BinaryInstTracer::writeRecords()
+{
+    std::ostream &os = *file->stream();
+    while (true) {
+        // Check before looking at the ring, so nothing added before
+        // close() is left behind.
+        const bool last = stopping.load(std::memory_order_acquire);
+
+        const Record *first;
+        size_t n = ring.peek(first);
+        if (n) {
+            os.write((const char *)first, n * sizeof(Record));
+            ring.pop(n);
+        } else if (last) {
+            break;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
+
+void
+BinaryInstTracer::close()
+{
+    if (!writer.joinable())
+        return;
+
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+    simout.close(file);
+    file = nullptr;
+}
+
+} // namespace Trace
+} // namespace gem5
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_BINARY_INST_TRACE_HH__
+#define __CPU_BINARY_INST_TRACE_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "base/spsc_ring.hh"
+#include "base/types.hh"
+#include "cpu/static_inst_fwd.hh"
+#include "params/BinaryInstTracer.hh"
+#include "sim/insttracer.hh"
+
+namespace gem5
+{
+
+class OutputStream;
+class ThreadContext;
+
+namespace Trace {
+
+class BinaryInstTracer;
+
+class BinaryInstTraceRecord : public InstRecord
+{
+  public:
+    BinaryInstTraceRecord(BinaryInstTracer &_tracer, Tick when,
+                          ThreadContext *tc, const StaticInstPtr si,
+                          const PCStateBase &pc,
+                          const StaticInstPtr mi = nullptr)
+        : InstRecord(when, tc, si, pc, mi), tracer(_tracer)
+    {}
+
+    /** Pack the instruction into a record and hand it to the tracer. */
+    void dump() override;
+
+  protected:
+    BinaryInstTracer &tracer;
+};
+
+/**
+ * Instruction tracer that writes a fixed size binary record for every
+ * committed instruction. The CPU only fills in a record and adds it to a
+ * lock-free ring; a writer thread of the tracer drains the ring and
+ * compresses the records into the trace file, so that formatting and
+ * compressing stay off the simulation thread. When the ring is full the
+ * CPU waits for the writer rather than dropping records. The ring has a
+ * single producer, so CPUs that run in different threads need tracers of
+ * their own.
+ *
+ * The file starts with a Header, followed by the Records.
+ * util/decode_binary_inst_trace.py prints a trace as text.
+ */
+class BinaryInstTracer : public InstTracer
+{
+  public:
+    static constexpr uint64_t Magic = 0x43525449354d4547ULL; // "GEM5ITRC"
+    static constexpr uint32_t Version = 1;
+
+    /** The number of registers a record holds, sources first. */
+    static constexpr int MaxRegs = 8;
+
+    struct Header
+    {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t recordSize;
+        uint64_t tickFrequency;
+    };
+
+    enum RecordFlags : uint8_t
+    {
+        MemValid = 0x01,
+        Faulting = 0x02,
+        PredicateFalse = 0x04,
+        Microop = 0x08,
+        LastMicroop = 0x10,
+        /** The instruction used more registers than a record holds. */
+        RegsTruncated = 0x20,
+    };
+
+    /**
+     * One committed instruction. Registers are stored as their class in
+     * the top byte and their index in the lower three.
+     */
+    struct Record
+    {
+        uint64_t tick;
+        uint64_t pc;
+        uint64_t memAddr;
+        uint32_t regs[MaxRegs];
+        uint16_t memSize;
+        uint16_t cpuId;
+        uint8_t opClass;
+        uint8_t flags;
+        uint8_t numSrcRegs;
+        uint8_t numDestRegs;
+    };
+
+    static_assert(sizeof(Record) == 64, "Records should be a cache line");
+
+    BinaryInstTracer(const BinaryInstTracerParams &p);
+    ~BinaryInstTracer();
+
+    InstRecord *getInstRecord(Tick when, ThreadContext *tc,
+            const StaticInstPtr si, const PCStateBase &pc,
+            const StaticInstPtr mi=nullptr) override;
+
+    /** Add a record to the ring, waiting for room if it is full. */
+    void
+    record(const Record &rec)
+    {
+        while (!ring.push(rec))
+            std::this_thread::yield();
+    }
+
+  protected:
+    SpscRing<Record> ring;
+    OutputStream *file;
+
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+
+    /** Body of the writer thread. */
+    void writeRecords();
+
+    /** Write what is left in the ring and close the file. */
+    void close();
+};
+
+} // namespace Trace
+} // namespace gem5
+
+#endif // __CPU_BINARY_INST_TRACE_HH__
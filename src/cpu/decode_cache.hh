@@ -46,17 +46,23 @@ namespace decode_cache
 template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
-/// A sparse map from an Addr to a Value, stored in page chunks.
-template<class Value, Addr CacheChunkShift = 12>
+/// A sparse map from an Addr to a Value, stored in page chunks. Each
+/// chunk is a dense array with one Value per instruction slot, where
+/// instructions are assumed to be aligned to 1 << InstShift bytes.
+template<class Value, Addr CacheChunkShift = 12, Addr InstShift = 0>
 class AddrMap
 {
   protected:
+    static_assert(InstShift < CacheChunkShift,
+                  "Instructions must be smaller than a cache chunk");
+
     static constexpr Addr CacheChunkBytes = 1ULL << CacheChunkShift;
+    static constexpr Addr CacheChunkItems = CacheChunkBytes >> InstShift;
 
     static constexpr Addr
     chunkOffset(Addr addr)
     {
-        return addr & (CacheChunkBytes - 1);
+        return (addr & (CacheChunkBytes - 1)) >> InstShift;
     }
 
     static constexpr Addr
@@ -68,21 +74,26 @@ class AddrMap
     // A chunk of cache entries.
     struct CacheChunk
     {
-        Value items[CacheChunkBytes];
+        Value items[CacheChunkItems];
     };
     // A map of cache chunks which allows a sparse mapping.
     typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
     typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
+    // Mini cache of recent lookups. Chunks are never freed while the
+    // map is alive, so plain pointers are enough.
+    Addr recentAddr[2];
+    CacheChunk *recent[2];
     ChunkMap chunkMap;
 
     /// Update the mini cache of recent lookups.
+    /// @param chunk_addr The start address of the most recent result.
     /// @param recentest The most recent result;
     void
-    update(ChunkIt recentest)
+    update(Addr chunk_addr, CacheChunk *recentest)
     {
+        recentAddr[1] = recentAddr[0];
         recent[1] = recent[0];
+        recentAddr[0] = chunk_addr;
         recent[0] = recentest;
     }
 
@@ -95,37 +106,41 @@ class AddrMap
     {
         Addr chunk_addr = chunkStart(addr);
 
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
+        // Check against recent lookups, the same page as last time
+        // being by far the most common case.
+        if (GEM5_LIKELY(recent[0] && recentAddr[0] == chunk_addr))
+            return recent[0];
+        if (recent[1] && recentAddr[1] == chunk_addr) {
+            update(chunk_addr, recent[1]);
+            // recent[1] has just become recent[0].
+            return recent[0];
         }
 
         // Actually look in the hash_map.
         ChunkIt it = chunkMap.find(chunk_addr);
         if (it != chunkMap.end()) {
-            update(it);
+            update(chunk_addr, it->second);
             return it->second;
         }
 
         // Didn't find an existing chunk, so add a new one.
         CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
+        chunkMap.emplace(chunk_addr, newChunk);
+        update(chunk_addr, newChunk);
         return newChunk;
     }
 
   public:
     /// Constructor
-    AddrMap()
+    AddrMap() : recentAddr{0, 0}, recent{nullptr, nullptr} {}
+
+    AddrMap(const AddrMap &) = delete;
+    AddrMap &operator=(const AddrMap &) = delete;
+
+    ~AddrMap()
     {
-        recent[0] = recent[1] = chunkMap.end();
+        for (auto &chunk : chunkMap)
+            delete chunk.second;
     }
 
     Value &
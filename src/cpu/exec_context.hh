@@ -77,6 +77,21 @@ class ExecContext
     virtual RegVal getRegOperand(const StaticInst *si, int idx) = 0;
     virtual void getRegOperand(const StaticInst *si, int idx, void *val) = 0;
     virtual void *getWritableRegOperand(const StaticInst *si, int idx) = 0;
+
+    /**
+     * Get a pointer to the value of a source operand, so large
+     * registers can be read where they are instead of being copied.
+     * The value must not change while the instruction executes, so a
+     * CPU model returns nullptr when it can't promise that, e.g. when
+     * the register is also one of the destinations and there is no
+     * renaming, and the operand then has to be read with
+     * getRegOperand().
+     */
+    virtual const void *
+    getReadableRegOperand(const StaticInst *si, int idx)
+    {
+        return nullptr;
+    }
     virtual void setRegOperand(const StaticInst *si, int idx, RegVal val) = 0;
     virtual void setRegOperand(const StaticInst *si, int idx,
             const void *val) = 0;
@@ -68,5 +68,9 @@ class BaseKvmCPU(BaseCPU):
     alwaysSyncTC = Param.Bool(False,
                               "Always sync thread contexts on entry/exit")
 
+    minRunLength = Param.Latency("0ns",
+        "Minimum time to run in KVM before exiting to service events. "
+        "Larger values reduce timer exits at the cost of event timing.")
+
     hostFreq = Param.Clock("2GHz", "Host clock frequency")
     hostFactor = Param.Float(1.0, "Cycle scale factor")
@@ -45,5 +45,8 @@ class KvmVM(SimObject):
 
     coalescedMMIO = \
       VectorParam.AddrRange([], "memory ranges for coalesced MMIO")
+    coalescedPIO = VectorParam.AddrRange([],
+        "IO port ranges for coalesced PIO (writes only, must not include "
+        "ports whose writes have side effects the guest waits for)")
 
     system = Param.System(Parent.any, "system this VM belongs to")
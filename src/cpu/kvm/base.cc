@@ -42,6 +42,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <csignal>
 #include <ostream>
@@ -54,6 +55,7 @@
 #include "debug/KvmRun.hh"
 #include "params/BaseKvmCPU.hh"
 #include "sim/process.hh"
+#include "sim/pseudo_inst.hh"
 #include "sim/system.hh"
 
 /* Used by some KVM macros */
@@ -69,8 +71,9 @@ BaseKvmCPU::BaseKvmCPU(const BaseKvmCPUParams &params)
       dataPort(name() + ".dcache_port", this),
       instPort(name() + ".icache_port", this),
       alwaysSyncTC(params.alwaysSyncTC),
-      threadContextDirty(true),
-      kvmStateDirty(false),
+      minRunLength(params.minRunLength),
+      threadContextDirty(AllRegGroups),
+      kvmStateDirty(0),
       vcpuID(-1), vcpuFD(-1), vcpuMMapSize(0),
       _kvmRun(NULL), mmioRing(NULL),
       pageSize(sysconf(_SC_PAGE_SIZE)),
@@ -304,7 +307,7 @@ BaseKvmCPU::unserializeThread(CheckpointIn &cp, ThreadID tid)
     assert(tid == 0);
     assert(_status == Idle);
     thread->unserialize(cp);
-    threadContextDirty = true;
+    threadContextDirty = AllRegGroups;
 }
 
 DrainState
@@ -464,7 +467,7 @@ BaseKvmCPU::takeOverFrom(BaseCPU *cpu)
     // view, but it makes debugging easier as it allows meaningful KVM
     // state to be dumped before and after a takeover.
     updateKvmState();
-    threadContextDirty = false;
+    threadContextDirty = 0;
 }
 
 void
@@ -590,6 +593,10 @@ BaseKvmCPU::tick()
         // handleKvmExit() will determine the next state of the CPU
         delay = handleKvmExit();
 
+        // Pick up the m5 ops the guest queued while it was running
+        if (system->params().m5ops_ring_base)
+            pseudo_inst::ringdrain(thread->getTC());
+
         if (tryDrain())
             _status = Idle;
         break;
@@ -603,10 +610,11 @@ BaseKvmCPU::tick()
           // have an instruction event pending.
           const Tick ticksToExecute(
               nextInstEvent > ctrInsts ?
-              curEventQueue()->nextTick() - curTick() : 0);
+              std::max(curEventQueue()->nextTick() - curTick(),
+                       minRunLength) : 0);
 
           if (alwaysSyncTC)
-              threadContextDirty = true;
+              threadContextDirty = AllRegGroups;
 
           // We might need to update the KVM state.
           syncKvmState();
@@ -637,7 +645,7 @@ BaseKvmCPU::tick()
           // Entering into KVM implies that we'll have to reload the thread
           // context from KVM if we want to access it. Flag the KVM state as
           // dirty with respect to the cached thread context.
-          kvmStateDirty = true;
+          kvmStateDirty = AllRegGroups;
 
           if (alwaysSyncTC)
               syncThreadContext();
@@ -933,27 +941,41 @@ BaseKvmCPU::getAndFormatOneReg(uint64_t id) const
 }
 
 void
-BaseKvmCPU::syncThreadContext()
+BaseKvmCPU::updateKvmStateGroups(RegGroups groups)
+{
+    updateKvmState();
+}
+
+void
+BaseKvmCPU::updateThreadContextGroups(RegGroups groups)
+{
+    updateThreadContext();
+}
+
+void
+BaseKvmCPU::syncThreadContext(RegGroups groups)
 {
-    if (!kvmStateDirty)
+    groups = expandRegGroups(groups) & kvmStateDirty;
+    if (!groups)
         return;
 
-    assert(!threadContextDirty);
+    assert(!(threadContextDirty & groups));
 
-    updateThreadContext();
-    kvmStateDirty = false;
+    updateThreadContextGroups(groups);
+    kvmStateDirty &= ~groups;
 }
 
 void
 BaseKvmCPU::syncKvmState()
 {
-    if (!threadContextDirty)
+    const RegGroups groups = threadContextDirty;
+    if (!groups)
         return;
 
-    assert(!kvmStateDirty);
+    assert(!(kvmStateDirty & groups));
 
-    updateKvmState();
-    threadContextDirty = false;
+    updateKvmStateGroups(groups);
+    threadContextDirty = 0;
 }
 
 Tick
@@ -1084,7 +1106,10 @@ Tick
 BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
 {
     ThreadContext *tc(thread->getTC());
-    syncThreadContext();
+    // Only the registers needed to translate the address are brought
+    // up to date here, as most accesses go to devices that do not see
+    // the register state.
+    syncThreadContext(mmioRegGroups());
 
     RequestPtr mmio_req = std::make_shared<Request>(
         paddr, size, Request::UNCACHEABLE, dataRequestorId());
@@ -1105,6 +1130,9 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
     pkt->dataStatic(data);
 
     if (mmio_req->isLocalAccess()) {
+        // Local accessors, such as m5ops, may use any register
+        syncThreadContext();
+
         // Since the PC has already been advanced by KVM, set the next
         // PC to the current PC. KVM doesn't use that value, and that
         // way any gem5 op or syscall which needs to know what the next
@@ -1120,7 +1148,7 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
         // different event queue when doing local accesses. Currently, they
         // are only used for m5ops, so it should be a valid assumption.
         const Cycles ipr_delay = mmio_req->localAccessor(tc, pkt);
-        threadContextDirty = true;
+        threadContextDirty = AllRegGroups;
         delete pkt;
         return clockPeriod() * ipr_delay;
     } else {
@@ -1171,18 +1199,24 @@ BaseKvmCPU::flushCoalescedMMIO()
 
     DPRINTF(KvmIO, "KVM: Flushing the coalesced MMIO ring buffer\n");
 
-    // TODO: We might need to do synchronization when we start to
-    // support multiple CPUs
+    // The ring is shared by all vCPUs in the VM
+    std::lock_guard<std::mutex> lock(vm->coalescedMMIOLock);
     Tick ticks(0);
     while (mmioRing->first != mmioRing->last) {
         struct kvm_coalesced_mmio &ent(
             mmioRing->coalesced_mmio[mmioRing->first]);
 
-        DPRINTF(KvmIO, "KVM: Handling coalesced MMIO (addr: 0x%x, len: %u)\n",
-                ent.phys_addr, ent.len);
+#ifdef KVM_CAP_COALESCED_PIO
+        const bool pio(ent.pio);
+#else
+        const bool pio(false);
+#endif
+        DPRINTF(KvmIO, "KVM: Handling coalesced %s (addr: 0x%x, len: %u)\n",
+                pio ? "PIO" : "MMIO", ent.phys_addr, ent.len);
 
         ++stats.numCoalescedMMIO;
-        ticks += doMMIOAccess(ent.phys_addr, ent.data, ent.len, true);
+        const Addr paddr(pio ? pioAddress(ent.phys_addr) : ent.phys_addr);
+        ticks += doMMIOAccess(paddr, ent.data, ent.len, true);
 
         mmioRing->first = (mmioRing->first + 1) % KVM_COALESCED_MMIO_MAX;
     }
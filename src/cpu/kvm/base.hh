@@ -75,7 +75,10 @@ struct BaseKvmCPUParams;
  * All architecture specific KVM implementation should inherit from
  * this class. The most basic CPU models only need to override the
  * updateKvmState() and updateThreadContext() methods to implement
- * state synchronization between gem5 and KVM.
+ * state synchronization between gem5 and KVM. Implementations that can
+ * synchronize groups of registers independently also override
+ * updateKvmStateGroups() and updateThreadContextGroups(), so that exit
+ * handlers only synchronize the registers they use.
  *
  * The architecture specific implementation is also responsible for
  * delivering interrupts into the VM. This is typically done by
@@ -431,10 +434,49 @@ class BaseKvmCPU : public BaseCPU
     virtual void updateThreadContext() = 0;
 
     /**
-     * Update a thread context if the KVM state is dirty with respect
-     * to the cached thread context.
+     * Groups of registers that are synchronized between KVM and the
+     * thread context independently of each other, a bit per group. The
+     * groups are defined by the architecture dependent code.
      */
-    void syncThreadContext();
+    typedef uint32_t RegGroups;
+    static constexpr RegGroups AllRegGroups = ~RegGroups(0);
+
+    /**
+     * Extend a set of register groups to the groups that have to be
+     * synchronized along with them. By default, all the registers are
+     * synchronized together.
+     */
+    virtual RegGroups
+    expandRegGroups(RegGroups groups) const
+    {
+        return groups ? AllRegGroups : 0;
+    }
+
+    /**
+     * Update the KVM state of some register groups from the thread
+     * context. Defaults to updateKvmState().
+     */
+    virtual void updateKvmStateGroups(RegGroups groups);
+
+    /**
+     * Update some register groups of the thread context with the KVM
+     * state. Defaults to updateThreadContext().
+     */
+    virtual void updateThreadContextGroups(RegGroups groups);
+
+    /**
+     * Register groups the address translation of an MMIO access reads
+     * from the thread context.
+     */
+    virtual RegGroups mmioRegGroups() const { return AllRegGroups; }
+
+    /**
+     * Update the register groups of a thread context for which the
+     * KVM state is dirty with respect to the cached thread context.
+     *
+     * @param groups Register groups the caller is going to use
+     */
+    void syncThreadContext(RegGroups groups = AllRegGroups);
 
     /**
      * Get a pointer to the event queue owning devices.
@@ -447,7 +489,8 @@ class BaseKvmCPU : public BaseCPU
     EventQueue *deviceEventQueue() { return vm->eventQueue(); }
 
     /**
-     * Update the KVM if the thread context is dirty.
+     * Update the KVM state with the register groups that are dirty in
+     * the thread context.
      */
     void syncKvmState();
     /** @} */
@@ -551,6 +594,19 @@ class BaseKvmCPU : public BaseCPU
      */
     Tick doMMIOAccess(Addr paddr, void *data, int size, bool write);
 
+    /**
+     * Translate an IO port number into the physical address gem5 uses
+     * for it. Used when servicing coalesced PIO writes.
+     *
+     * @param port IO port number
+     * @return Physical address of the IO port
+     */
+    virtual Addr
+    pioAddress(Addr port)
+    {
+        panic("KVM: Coalesced PIO not supported on this architecture\n");
+    }
+
     /** @{ */
     /**
      * Set the signal mask used in kvmRun()
@@ -642,16 +698,25 @@ class BaseKvmCPU : public BaseCPU
     const bool alwaysSyncTC;
 
     /**
-     * Is the gem5 context dirty? Set to true to force an update of
-     * the KVM vCPU state upon the next call to kvmRun().
+     * Minimum number of ticks to execute in KVM when entering it to
+     * run guest code. Pending events are serviced late if they fall
+     * within this window, which trades timing accuracy for fewer
+     * timer exits.
+     */
+    const Tick minRunLength;
+
+    /**
+     * Register groups for which the gem5 context is dirty. Set to
+     * force an update of the KVM vCPU state upon the next call to
+     * kvmRun().
      */
-    bool threadContextDirty;
+    RegGroups threadContextDirty;
 
     /**
-     * Is the KVM state dirty? Set to true to force an update of
-     * the KVM vCPU state upon the next call to kvmRun().
+     * Register groups for which the KVM state is dirty. Set to force
+     * an update of the thread context when it is next used.
      */
-    bool kvmStateDirty;
+    RegGroups kvmStateDirty;
 
     /** KVM internal ID of the vCPU */
     long vcpuID;
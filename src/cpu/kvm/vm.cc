@@ -138,6 +138,16 @@ Kvm::capCoalescedMMIO() const
     return checkExtension(KVM_CAP_COALESCED_MMIO);
 }
 
+bool
+Kvm::capCoalescedPIO() const
+{
+#ifdef KVM_CAP_COALESCED_PIO
+    return checkExtension(KVM_CAP_COALESCED_PIO) != 0;
+#else
+    return false;
+#endif
+}
+
 int
 Kvm::capNumMemSlots() const
 {
@@ -329,6 +339,13 @@ KvmVM::KvmVM(const KvmVMParams &params)
     /* Setup the coalesced MMIO regions */
     for (int i = 0; i < params.coalescedMMIO.size(); ++i)
         coalesceMMIO(params.coalescedMMIO[i]);
+
+    if (!params.coalescedPIO.empty() && !kvm->capCoalescedPIO()) {
+        warn("KVM: Coalesced PIO not supported by host OS\n");
+    } else {
+        for (const auto &range : params.coalescedPIO)
+            coalescePIO(range);
+    }
 }
 
 KvmVM::~KvmVM()
@@ -367,6 +384,10 @@ KvmVM::cpuStartup()
 void
 KvmVM::delayedStartup()
 {
+    // The guest writes to the backing store directly, so the memories
+    // can't tell which pages it has written.
+    system->getPhysMem().disableDirtyTracking();
+
     const std::vector<memory::BackingStoreEntry> &memories(
         system->getPhysMem().getBackingStore());
 
@@ -499,6 +520,26 @@ KvmVM::coalesceMMIO(Addr start, int size)
               errno);
 }
 
+void
+KvmVM::coalescePIO(const AddrRange &range)
+{
+#ifdef KVM_CAP_COALESCED_PIO
+    struct kvm_coalesced_mmio_zone zone;
+
+    zone.addr = range.start();
+    zone.size = range.size();
+    zone.pio = 1;
+
+    DPRINTF(Kvm, "KVM: Registering coalesced PIO ports [0x%x, 0x%x]\n",
+            zone.addr, zone.addr + zone.size - 1);
+    if (ioctl(KVM_REGISTER_COALESCED_MMIO, (void *)&zone) == -1)
+        panic("KVM: Failed to register coalesced PIO region (%i)\n",
+              errno);
+#else
+    panic("KVM: Coalesced PIO not supported by host OS\n");
+#endif
+}
+
 void
 KvmVM::setTSSAddress(Addr tss_address)
 {
@@ -39,6 +39,7 @@
 #ifndef __CPU_KVM_KVMVM_HH__
 #define __CPU_KVM_KVMVM_HH__
 
+#include <mutex>
 #include <vector>
 
 #include "base/addr_range.hh"
@@ -114,6 +115,9 @@ class Kvm
      */
     int capCoalescedMMIO() const;
 
+    /** Support for KvmVM::coalescePIO() */
+    bool capCoalescedPIO() const;
+
     /**
      * Attempt to determine how many memory slots are available. If it can't
      * be determined, this function returns 0.
@@ -333,6 +337,17 @@ class KvmVM : public SimObject
     void coalesceMMIO(const AddrRange &range);
     /** @} */
 
+    /**
+     * Request coalescing of writes to a range of IO ports. Writes to
+     * the ports are buffered in the coalesced MMIO ring instead of
+     * causing an exit, reads still exit.
+     *
+     * @note The presence of this call depends on Kvm::capCoalescedPIO().
+     *
+     * @param range Range of IO port numbers
+     */
+    void coalescePIO(const AddrRange &range);
+
     /**
      * @addtogroup KvmInterrupts
      * @{
@@ -545,6 +560,13 @@ class KvmVM : public SimObject
     /** Next unallocated vCPU ID */
     long nextVCPUID;
 
+    /**
+     * Lock protecting the coalesced MMIO ring. KVM keeps a single
+     * ring per VM, so vCPUs running in different threads must not
+     * drain it concurrently.
+     */
+    std::mutex coalescedMMIOLock;
+
     /**
      *  Structures tracking memory slots.
      */
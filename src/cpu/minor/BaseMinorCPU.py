@@ -224,6 +224,9 @@ class BaseMinorCPU(BaseCPU):
     fetch2CycleInput = Param.Bool(True,
         "Allow Fetch2 to cross input lines to generate full output each"
         " cycle")
+    fetch2LineBranches = Param.Bool(False,
+        "Let Fetch2 follow predicted taken branches whose target is in the"
+        " line being decoded, without redirecting Fetch1")
 
     decodeInputBufferSize = Param.Unsigned(3,
         "Size of input buffer to Decode in cycles-worth of insts.")
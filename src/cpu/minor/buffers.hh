@@ -48,6 +48,7 @@
 #include <queue>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "base/logging.hh"
 #include "base/named.hh"
@@ -444,6 +445,22 @@ class Queue : public Named, public Reservable
         }
     }
 
+    /** As push but taking the element's contents rather than copying
+     *  them.  The moved-from element must be left as a bubble */
+    void
+    push(ElemType &&data)
+    {
+        if (!BubbleTraits::isBubble(data)) {
+            freeReservation();
+            queue.push_back(std::move(data));
+
+            if (queue.size() > capacity) {
+                warn("%s: No space to push data into queue of capacity"
+                    " %u, pushing anyway\n", name(), capacity);
+            }
+        }
+    }
+
     /** Clear all allocated space.  Be careful how this is used */
     void clearReservedSpace() { numReservedSlots = 0; }
 
@@ -627,12 +644,22 @@ class InputBuffer : public Reservable
 
     /** Push the single element (if any) into the queue proper.  If the
      *  element's reference points to a transient object, remember to
-     *  always do this before the end of that object's life */
+     *  always do this before the end of that object's life.
+     *
+     *  The element is normally a latch slot which is not looked at again
+     *  before the latch advances and recycles it, so its contents are
+     *  moved rather than copied.  MinorTrace reports the latch slots
+     *  after this has been called so, when tracing, take a copy to keep
+     *  the reported slot intact */
     void
     pushTail() const
     {
-        if (elementPtr)
-            queue.push(*elementPtr);
+        if (elementPtr) {
+            if (debug::MinorTrace)
+                queue.push(*elementPtr);
+            else
+                queue.push(std::move(*elementPtr));
+        }
         elementPtr = NULL;
     }
 
@@ -77,6 +77,38 @@ operator <<(std::ostream &os, const InstId &id)
     return os;
 }
 
+namespace
+{
+
+/** Deleted MinorDynInsts, ready for reuse, chained through their first
+ *  word.  This is per thread as CPUs may be simulated on different host
+ *  threads */
+thread_local void *freeInsts = nullptr;
+
+} // anonymous namespace
+
+void *
+MinorDynInst::operator new(std::size_t size)
+{
+    if (size != sizeof(MinorDynInst) || !freeInsts)
+        return ::operator new(size);
+
+    void *ptr = freeInsts;
+    freeInsts = *static_cast<void **>(ptr);
+    return ptr;
+}
+
+void
+MinorDynInst::operator delete(void *ptr, std::size_t size)
+{
+    if (size != sizeof(MinorDynInst)) {
+        ::operator delete(ptr);
+    } else {
+        *static_cast<void **>(ptr) = freeInsts;
+        freeInsts = ptr;
+    }
+}
+
 MinorDynInstPtr MinorDynInst::bubbleInst = []() {
     auto *inst = new MinorDynInst(nullStaticInstPtr);
     assert(inst->isBubble());
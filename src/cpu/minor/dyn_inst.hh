@@ -46,6 +46,7 @@
 #ifndef __CPU_MINOR_DYN_INST_HH__
 #define __CPU_MINOR_DYN_INST_HH__
 
+#include <cstddef>
 #include <iostream>
 
 #include "arch/generic/isa.hh"
@@ -284,6 +285,12 @@ class MinorDynInst : public RefCounted
     void setMemAccPredicate(bool val) { memAccPredicate = val; }
 
     ~MinorDynInst();
+
+    /** One MinorDynInst is made for every fetched instruction and
+     *  micro-op so they are recycled through a free list rather than
+     *  going back to the heap */
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size);
 };
 
 /** Print a summary of the instruction */
@@ -70,7 +70,7 @@ class Execute;
  *  separates that interface from other classes such as Pipeline, MinorCPU
  *  and DynMinorInst and makes it easier to see what state is accessed by it.
  */
-class ExecContext : public gem5::ExecContext
+class ExecContext final : public gem5::ExecContext
 {
   public:
     MinorCPU &cpu;
@@ -148,9 +148,16 @@ class ExecContext : public gem5::ExecContext
     getRegOperand(const StaticInst *si, int idx) override
     {
         const RegId &reg = si->srcRegIdx(idx);
-        if (reg.is(InvalidRegClass))
+        switch (reg.classValue()) {
+          case IntRegClass:
+            return thread.getRegFast<IntRegClass>(reg.index());
+          case FloatRegClass:
+            return thread.getRegFast<FloatRegClass>(reg.index());
+          case InvalidRegClass:
             return 0;
-        return thread.getReg(reg);
+          default:
+            return thread.getReg(reg);
+        }
     }
 
     void
@@ -165,13 +172,36 @@ class ExecContext : public gem5::ExecContext
         return thread.getWritableReg(si->destRegIdx(idx));
     }
 
+    const void *
+    getReadableRegOperand(const StaticInst *si, int idx) override
+    {
+        const RegId &reg = si->srcRegIdx(idx);
+        // Without renaming the register is written in place if it is
+        // also a destination.
+        for (int i = 0; i < si->numDestRegs(); i++) {
+            if (si->destRegIdx(i) == reg)
+                return nullptr;
+        }
+        return thread.getWritableReg(reg);
+    }
+
     void
     setRegOperand(const StaticInst *si, int idx, RegVal val) override
     {
         const RegId &reg = si->destRegIdx(idx);
-        if (reg.is(InvalidRegClass))
-            return;
-        thread.setReg(si->destRegIdx(idx), val);
+        switch (reg.classValue()) {
+          case IntRegClass:
+            thread.setRegFast<IntRegClass>(reg.index(), val);
+            break;
+          case FloatRegClass:
+            thread.setRegFast<FloatRegClass>(reg.index(), val);
+            break;
+          case InvalidRegClass:
+            break;
+          default:
+            thread.setReg(reg, val);
+            break;
+        }
     }
 
     void
@@ -73,6 +73,7 @@ Fetch2::Fetch2(const std::string &name,
     nextStageReserve(next_stage_input_buffer),
     outputWidth(params.decodeInputWidth),
     processMoreThanOneInput(params.fetch2CycleInput),
+    lineBranches(params.fetch2LineBranches),
     branchPredictor(*params.branchPred),
     fetchInfo(params.numThreads),
     threadPriority(0), stats(&cpu_)
@@ -188,8 +189,9 @@ Fetch2::updateBranchPrediction(const BranchData &branch)
     }
 }
 
-void
-Fetch2::predictBranch(MinorDynInstPtr inst, BranchData &branch)
+bool
+Fetch2::predictBranch(MinorDynInstPtr inst, BranchData &branch,
+    const ForwardLineData &line)
 {
     Fetch2ThreadInfo &thread = fetchInfo[inst->id.threadId];
 
@@ -214,6 +216,29 @@ Fetch2::predictBranch(MinorDynInstPtr inst, BranchData &branch)
         DPRINTF(Branch, "Not attempting prediction for inst: %s\n", *inst);
     }
 
+    /* A target in the line being decoded needs no new line from Fetch1.
+     *  Control flow from there reaches the following lines sequentially,
+     *  so neither the lines behind this one nor the ones Fetch1 is
+     *  fetching are made stale, and the sequence numbers stay as they
+     *  are.  Execute checks the prediction as for any other branch */
+    if (inst->predictedTaken && lineBranches &&
+        inst->predictedTarget->microPC() == 0)
+    {
+        InstDecoder *decoder =
+            cpu.getContext(inst->id.threadId)->getDecoderPtr();
+        Addr target = inst->predictedTarget->instAddr() & decoder->pcMask();
+
+        if (target >= line.lineBaseAddr &&
+            target < line.lineBaseAddr + line.lineWidth)
+        {
+            DPRINTF(Branch, "Branch predicted taken inst: %s target: %s"
+                " within line %s\n", *inst, *inst->predictedTarget,
+                line.id);
+            stats.lineBranches++;
+            return true;
+        }
+    }
+
     /* If we predict taken, set branch and update sequence numbers */
     if (inst->predictedTaken) {
         /* Update the predictionSeqNum and remember the streamSeqNum that it
@@ -234,6 +259,8 @@ Fetch2::predictBranch(MinorDynInstPtr inst, BranchData &branch)
             " new predictionSeqNum: %d\n",
             *inst, *inst->predictedTarget, thread.predictionSeqNum);
     }
+
+    return false;
 }
 
 void
@@ -377,6 +404,9 @@ Fetch2::evaluate()
             } else {
                 uint8_t *line = line_in->line;
 
+                /* Set if a predicted branch target is in this line */
+                bool branch_in_line = false;
+
                 /* The instruction is wholly in the line, can just copy. */
                 memcpy(decoder->moreBytesPtr(), line + fetch_info.inputIndex,
                         decoder->moreBytesSize());
@@ -454,7 +484,8 @@ Fetch2::evaluate()
 
                     /* Predict any branches and issue a branch if
                      *  necessary */
-                    predictBranch(dyn_inst, prediction);
+                    branch_in_line =
+                        predictBranch(dyn_inst, prediction, *line_in);
                 } else {
                     DPRINTF(Fetch, "Inst not ready yet\n");
                 }
@@ -469,6 +500,19 @@ Fetch2::evaluate()
                     *line_in->pc, fetch_info.inputIndex, line_in->lineBaseAddr,
                     line_in->lineWidth);
                 }
+
+                /* Carry on from the branch target, as if it was a
+                 *  new PC for this line */
+                if (branch_in_line) {
+                    set(fetch_info.pc, dyn_inst->predictedTarget);
+                    fetch_info.inputIndex =
+                        (fetch_info.pc->instAddr() & decoder->pcMask()) -
+                        line_in->lineBaseAddr;
+                    decoder->reset();
+                    DPRINTF(Fetch, "Following branch within line, PC: %s"
+                        " inputIndex: 0x%x\n", *fetch_info.pc,
+                        fetch_info.inputIndex);
+                }
             }
 
             if (dyn_inst) {
@@ -614,7 +658,10 @@ Fetch2::Fetch2Stats::Fetch2Stats(MinorCPU *cpu)
       ADD_STAT(storeInstructions, statistics::units::Count::get(),
                "Number of memory store instructions successfully decoded"),
       ADD_STAT(amoInstructions, statistics::units::Count::get(),
-               "Number of memory atomic instructions successfully decoded")
+               "Number of memory atomic instructions successfully decoded"),
+      ADD_STAT(lineBranches, statistics::units::Count::get(),
+               "Number of predicted taken branches followed without "
+               "redirecting Fetch1 as the target was in the current line")
 {
         intInstructions
             .flags(statistics::total);
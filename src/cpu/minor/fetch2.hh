@@ -92,6 +92,11 @@ class Fetch2 : public Named
      *  there is room in the output to contain its processed data */
     bool processMoreThanOneInput;
 
+    /** If true, a predicted taken branch to a target in the line being
+     *  decoded is followed inside that line.  Fetch1 is not redirected
+     *  and keeps fetching the following lines, which also remain valid */
+    bool lineBranches;
+
     /** Branch predictor passed from Python configuration */
     branch_prediction::BPredUnit &branchPredictor;
 
@@ -171,6 +176,7 @@ class Fetch2 : public Named
         statistics::Scalar loadInstructions;
         statistics::Scalar storeInstructions;
         statistics::Scalar amoInstructions;
+        statistics::Scalar lineBranches;
     } stats;
 
   protected:
@@ -191,8 +197,12 @@ class Fetch2 : public Named
 
     /** Predicts branches for the given instruction.  Updates the
      *  instruction's predicted... fields and also the branch which
-     *  carries the prediction to Fetch1 */
-    void predictBranch(MinorDynInstPtr inst, BranchData &branch);
+     *  carries the prediction to Fetch1.  If lineBranches is set and
+     *  a taken branch's target lies in line, no branch is generated
+     *  and true is returned so the caller can continue decoding from
+     *  the target */
+    bool predictBranch(MinorDynInstPtr inst, BranchData &branch,
+        const ForwardLineData &line);
 
     /** Use the current threading policy to determine the next thread to
      *  fetch from. */
@@ -247,6 +247,25 @@ ForwardInstData::operator =(const ForwardInstData &src)
     return *this;
 }
 
+ForwardInstData::ForwardInstData(ForwardInstData &&src)
+{
+    *this = std::move(src);
+}
+
+ForwardInstData &
+ForwardInstData::operator =(ForwardInstData &&src)
+{
+    numInsts = src.numInsts;
+    threadId = src.threadId;
+
+    for (unsigned int i = 0; i < src.numInsts; i++)
+        insts[i] = std::move(src.insts[i]);
+
+    src.numInsts = 0;
+
+    return *this;
+}
+
 bool
 ForwardInstData::isBubble() const
 {
@@ -50,6 +50,8 @@
 #ifndef __CPU_MINOR_PIPE_DATA_HH__
 #define __CPU_MINOR_PIPE_DATA_HH__
 
+#include <utility>
+
 #include "cpu/minor/buffers.hh"
 #include "cpu/minor/dyn_inst.hh"
 #include "cpu/base.hh"
@@ -244,8 +246,45 @@ class ForwardLineData /* : public ReportIF, public BubbleIF */
         return *this;
     }
 
+    /** Moving leaves other as a bubble which doesn't refer to the line
+     *  data */
+    ForwardLineData(ForwardLineData &&other) :
+        bubbleFlag(other.bubbleFlag), lineBaseAddr(other.lineBaseAddr),
+        pc(std::move(other.pc)), fetchAddr(other.fetchAddr),
+        lineWidth(other.lineWidth), fault(std::move(other.fault)),
+        id(other.id), line(other.line), packet(other.packet)
+    {
+        other.makeBubble();
+    }
+    ForwardLineData &
+    operator=(ForwardLineData &&other)
+    {
+        bubbleFlag = other.bubbleFlag;
+        lineBaseAddr = other.lineBaseAddr;
+        pc = std::move(other.pc);
+        fetchAddr = other.fetchAddr;
+        lineWidth = other.lineWidth;
+        fault = std::move(other.fault);
+        id = other.id;
+        line = other.line;
+        packet = other.packet;
+        other.makeBubble();
+        return *this;
+    }
+
     ~ForwardLineData() { line = NULL; }
 
+  private:
+    /** Turn a moved-from line back into a bubble */
+    void
+    makeBubble()
+    {
+        bubbleFlag = true;
+        fault = NoFault;
+        line = nullptr;
+        packet = nullptr;
+    }
+
   public:
     /** This is a fault, not a line */
     bool isFault() const { return fault != NoFault; }
@@ -299,6 +338,9 @@ class ForwardInstData /* : public ReportIF, public BubbleIF */
 
     ForwardInstData(const ForwardInstData &src);
 
+    /** Moving leaves src as an empty bubble */
+    ForwardInstData(ForwardInstData &&src);
+
   public:
     /** Number of instructions carried by this object */
     unsigned int width() const { return numInsts; }
@@ -306,6 +348,9 @@ class ForwardInstData /* : public ReportIF, public BubbleIF */
     /** Copy the inst array only as far as numInsts */
     ForwardInstData &operator =(const ForwardInstData &src);
 
+    /** Move the inst array only as far as numInsts */
+    ForwardInstData &operator =(ForwardInstData &&src);
+
     /** Resize a bubble/empty ForwardInstData and fill with bubbles */
     void resize(unsigned int width);
 
@@ -72,6 +72,8 @@ class BaseO3CPU(BaseCPU):
         return True
 
     activity = Param.Unsigned(0, "Initial count")
+    skipIdleStages = Param.Bool(False, "Don't tick inactive stages while no "
+                                "time buffer communication is in flight")
 
     cacheStorePorts = Param.Unsigned(200, "Cache Ports. "
           "Constrains stores only.")
@@ -87,6 +89,15 @@ class BaseO3CPU(BaseCPU):
     fetchBufferSize = Param.Unsigned(64, "Fetch buffer size in bytes")
     fetchQueueSize = Param.Unsigned(32, "Fetch queue size in micro-ops "
                                     "per-thread")
+    decoupledFrontEnd = Param.Bool(False, "Run a basic block branch "
+        "predictor ahead of fetch through a fetch target queue")
+    ftqSize = Param.Unsigned(8, "Fetch target queue size in fetch blocks "
+                             "per-thread")
+    ftqBTBEntries = Param.Unsigned(2048, "Number of entries of the basic "
+                                   "block BTB of the decoupled front end")
+    ftqPrefetch = Param.Bool(True, "Prefetch the fetch target queue blocks "
+        "into the I-cache (requires software prefetch support in the "
+        "I-cache)")
 
     renameToDecodeDelay = Param.Cycles(1, "Rename to decode delay")
     iewToDecodeDelay = Param.Cycles(1, "Issue/Execute/Writeback to decode "
@@ -100,6 +111,9 @@ class BaseO3CPU(BaseCPU):
     commitToRenameDelay = Param.Cycles(1, "Commit to rename delay")
     decodeToRenameDelay = Param.Cycles(1, "Decode to rename delay")
     renameWidth = Param.Unsigned(8, "Rename width")
+    numRenameCheckpoints = Param.Unsigned(0, "Number of rename map "
+                                          "checkpoints per thread taken at "
+                                          "predicted branches, 0 for none")
 
     commitToIEWDelay = Param.Cycles(1, "Commit to "
                "Issue/Execute/Writeback delay")
@@ -151,6 +165,9 @@ class BaseO3CPU(BaseCPU):
     # most ISAs don't use condition-code regs, so default is 0
     numPhysCCRegs = Param.Unsigned(0, "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
+    iqWakeupMatrix = Param.Bool(False, "Track the dependences of the "
+                                "instruction queue in a bit matrix instead "
+                                "of per register lists")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
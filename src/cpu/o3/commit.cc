@@ -63,7 +63,6 @@
 #include "debug/Drain.hh"
 #include "debug/ExecFaulting.hh"
 #include "debug/HtmCpu.hh"
-#include "debug/O3PipeView.hh"
 #include "params/BaseO3CPU.hh"
 #include "sim/faults.hh"
 #include "sim/full_system.hh"
@@ -1007,7 +1006,9 @@ Commit::commitInsts()
             rob->retireHead(commit_thread);
 
             ++stats.commitSquashedInsts;
-            // Notify potential listeners that this instruction is squashed
+            // Notify potential listeners that this instruction is squashed,
+            // after the instructions committed before it
+            notifyCommitted();
             ppSquash->notify(head_inst);
 
             // Record that the number of ROB entries has changed.
@@ -1021,7 +1022,8 @@ Commit::commitInsts()
             if (commit_success) {
                 ++num_committed;
                 stats.committedInstType[tid][head_inst->opClass()]++;
-                ppCommit->notify(head_inst);
+                if (ppCommit->hasListeners())
+                    committedBatch.push_back(head_inst);
 
                 // hardware transactional memory
 
@@ -1132,6 +1134,8 @@ Commit::commitInsts()
         }
     }
 
+    notifyCommitted();
+
     DPRINTF(CommitRate, "%i\n", num_committed);
     stats.numCommittedDist.sample(num_committed);
 
@@ -1140,6 +1144,15 @@ Commit::commitInsts()
     }
 }
 
+void
+Commit::notifyCommitted()
+{
+    if (committedBatch.empty())
+        return;
+    ppCommit->notifyBatch(committedBatch.data(), committedBatch.size());
+    committedBatch.clear();
+}
+
 bool
 Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
 {
@@ -1312,11 +1325,9 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
     // Finally clear the head ROB entry.
     rob->retireHead(tid);
 
-#if TRACING_ON
-    if (debug::O3PipeView) {
+    if (cpu->tracingPipeline()) {
         head_inst->commitTick = curTick() - head_inst->fetchTick;
     }
-#endif
 
     // If this was a store, record it for this cycle.
     if (head_inst->isStore() || head_inst->isAtomic())
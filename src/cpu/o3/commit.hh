@@ -127,6 +127,16 @@ class Commit
     /** To probe when an instruction is squashed */
     ProbePointArg<DynInstPtr> *ppSquash;
 
+    /**
+     * Instructions committed this cycle that have not been passed to
+     * the Commit probe yet. They are delivered as one batch, only
+     * collected while the probe has listeners.
+     */
+    std::vector<DynInstPtr> committedBatch;
+
+    /** Deliver the committed instructions collected so far. */
+    void notifyCommitted();
+
     /** Mark the thread as processing a trap. */
     void processTrapEvent(ThreadID tid);
 
@@ -110,6 +110,7 @@ CPU::CPU(const BaseO3CPUParams &params)
       activityRec(name(), NumStages,
                   params.backComSize + params.forwardComSize,
                   params.activity),
+      skipIdleStages(params.skipIdleStages),
 
       globalSeqNum(1),
       system(params.system),
@@ -329,6 +330,9 @@ CPU::CPUStats::CPUStats(CPU *cpu)
       ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
                "Total number of cycles that CPU has spent quiesced or waiting "
                "for an interrupt"),
+      ADD_STAT(skippedStageCycles, statistics::units::Cycle::get(),
+               "Number of cycles each stage was not ticked because it had "
+               "nothing to do"),
       ADD_STAT(committedInsts, statistics::units::Count::get(),
                "Number of Instructions Simulated"),
       ADD_STAT(committedOps, statistics::units::Count::get(),
@@ -380,6 +384,15 @@ CPU::CPUStats::CPUStats(CPU *cpu)
     quiesceCycles
         .prereq(quiesceCycles);
 
+    skippedStageCycles
+        .init(NumStages)
+        .subname(FetchIdx, "fetch")
+        .subname(DecodeIdx, "decode")
+        .subname(RenameIdx, "rename")
+        .subname(IEWIdx, "iew")
+        .subname(CommitIdx, "commit")
+        .flags(statistics::total | statistics::nozero);
+
     // Number of Instructions simulated
     // --------------------------------
     // Should probably be in Base CPU but need templated
@@ -458,15 +471,20 @@ CPU::tick()
 //    activity = false;
 
     //Tick each of the stages
-    fetch.tick();
+    if (!canSkipStage(FetchIdx))
+        fetch.tick();
 
-    decode.tick();
+    if (!canSkipStage(DecodeIdx))
+        decode.tick();
 
-    rename.tick();
+    if (!canSkipStage(RenameIdx))
+        rename.tick();
 
-    iew.tick();
+    if (!canSkipStage(IEWIdx))
+        iew.tick();
 
-    commit.tick();
+    if (!canSkipStage(CommitIdx))
+        commit.tick();
 
     // Now advance the time buffers
     timeBuffer.advance();
@@ -478,6 +496,11 @@ CPU::tick()
 
     activityRec.advance();
 
+    if (activityRec.communicating())
+        quietCycles = 0;
+    else if (quietCycles < 2)
+        quietCycles++;
+
     if (removeInstsThisCycle) {
         cleanUpRemovedInsts();
     }
@@ -503,6 +526,23 @@ CPU::tick()
     tryDrain();
 }
 
+bool
+CPU::canSkipStage(StageIdx idx)
+{
+    if (!skipIdleStages || quietCycles < 2 ||
+        activityRec.getStageActive(idx)) {
+        return false;
+    }
+
+    // Memory instructions waiting on a translation or a cache retry do
+    // not keep IEW active, but are only picked up again when it ticks.
+    if (idx == IEWIdx && iew.instQueue.hasPendingMemInsts())
+        return false;
+
+    cpuStats.skippedStageCycles[idx]++;
+    return true;
+}
+
 void
 CPU::init()
 {
@@ -973,6 +1013,7 @@ CPU::switchOut()
     BaseCPU::switchOut();
 
     activityRec.reset();
+    quietCycles = 0;
 
     _status = SwitchedOut;
 
@@ -1396,6 +1437,10 @@ CPU::wakeDependents(const DynInstPtr &inst)
 void
 CPU::wakeCPU()
 {
+    // Whatever woke the CPU may have to be handled by a stage that is
+    // otherwise inactive, so tick all of them again.
+    quietCycles = 0;
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
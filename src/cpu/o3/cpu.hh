@@ -68,6 +68,7 @@
 #include "cpu/base.hh"
 #include "cpu/simple_thread.hh"
 #include "cpu/timebuf.hh"
+#include "debug/O3PipeView.hh"
 #include "params/BaseO3CPU.hh"
 #include "sim/process.hh"
 
@@ -94,7 +95,7 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
+    typedef DynInstList::iterator ListIt;
 
     friend class ThreadContext;
 
@@ -177,6 +178,24 @@ class CPU : public BaseCPU
     /** Register probe points. */
     void regProbePoints() override;
 
+    /**
+     * Whether the stages record when the instructions reach them, for
+     * the O3PipeView debug flag or a pipeline tracer.
+     */
+    bool
+    tracingPipeline() const
+    {
+        return numPipeTracers > 0 || (TRACING_ON && debug::O3PipeView);
+    }
+
+    /** Record the stage ticks for a pipeline tracer. */
+    void addPipeTracer() { numPipeTracers++; }
+
+  private:
+    /** Number of pipeline tracers attached to the CPU. */
+    unsigned numPipeTracers = 0;
+
+  public:
     void
     demapPage(Addr vaddr, uint64_t asn)
     {
@@ -318,6 +337,32 @@ class CPU : public BaseCPU
     void setReg(PhysRegIdPtr phys_reg, RegVal val);
     void setReg(PhysRegIdPtr phys_reg, const void *val);
 
+    /**
+     * Inline versions of getReg and setReg for integer and float
+     * registers, which the dynamic instructions use for their operands.
+     */
+    template <RegClassType Cls>
+    RegVal
+    getRegFast(PhysRegIdPtr phys_reg)
+    {
+        if constexpr (Cls == IntRegClass)
+            cpuStats.intRegfileReads++;
+        else
+            cpuStats.fpRegfileReads++;
+        return regFile.getReg<Cls>(phys_reg->index());
+    }
+
+    template <RegClassType Cls>
+    void
+    setRegFast(PhysRegIdPtr phys_reg, RegVal val)
+    {
+        if constexpr (Cls == IntRegClass)
+            cpuStats.intRegfileWrites++;
+        else
+            cpuStats.fpRegfileWrites++;
+        regFile.setReg<Cls>(phys_reg->index(), val);
+    }
+
     /** Architectural register accessors.  Looks up in the commit
      * rename table to obtain the true physical index of the
      * architected register first, then accesses that physical
@@ -379,7 +424,7 @@ class CPU : public BaseCPU
 #endif
 
     /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    DynInstList instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -502,6 +547,26 @@ class CPU : public BaseCPU
     /** Wakes the CPU, rescheduling the CPU if it's not already active. */
     void wakeCPU();
 
+  private:
+    /** Whether inactive stages are skipped once the time buffers are
+     *  quiet.
+     */
+    const bool skipIdleStages;
+
+    /** Number of consecutive cycles without any time buffer
+     *  communication or wake up of the CPU.
+     */
+    int quietCycles = 0;
+
+    /** Returns if a stage has nothing to do this cycle.  A stage is
+     *  only skipped if it is inactive and has seen a cycle with all of
+     *  its inputs quiet since the last communication, so ticking it
+     *  would not change its state.
+     */
+    bool canSkipStage(StageIdx idx);
+
+  public:
+
     virtual void wakeup(ThreadID tid) override;
 
     /** Gets a free thread id. Use if thread ids change across system. */
@@ -582,6 +647,8 @@ class CPU : public BaseCPU
         /** Stat for total number of cycles the CPU spends descheduled due to a
          * quiesce operation or waiting for an interrupt. */
         statistics::Scalar quiesceCycles;
+        /** Stat for the number of cycles each stage was not ticked. */
+        statistics::Vector skippedStageCycles;
         /** Stat for the number of committed instructions per thread. */
         statistics::Vector committedInsts;
         /** Stat for the number of committed ops (including micro ops) per
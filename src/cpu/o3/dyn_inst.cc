@@ -41,8 +41,12 @@
 #include "cpu/o3/dyn_inst.hh"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
 
 #include "base/intmath.hh"
+#include "base/pool_allocator.hh"
 #include "debug/DynInst.hh"
 #include "debug/IQ.hh"
 #include "debug/O3PipeView.hh"
@@ -53,6 +57,63 @@ namespace gem5
 namespace o3
 {
 
+namespace
+{
+
+/*
+ * A DynInst is allocated for every fetched instruction, with its
+ * register arrays in the same buffer, so the size of the buffer depends
+ * on the instruction. The buffers are recycled through free lists of
+ * blocks in multiples of BlockGranule bytes. Each block starts with a
+ * header holding its size class, so that it can be returned to the
+ * right list. Larger buffers go to the heap.
+ */
+constexpr size_t BlockAlign = alignof(std::max_align_t);
+constexpr size_t BlockGranule = 64;
+constexpr size_t NumSizeClasses = 64;
+constexpr size_t HeaderSize = roundUp(sizeof(size_t), BlockAlign);
+
+struct SizeClassOps
+{
+    void *(*allocate)();
+    void (*release)(void *);
+};
+
+template <std::size_t... I>
+constexpr std::array<SizeClassOps, sizeof...(I)>
+makeSizeClassOps(std::index_sequence<I...>)
+{
+    return {{{&FreeList<(I + 1) * BlockGranule, BlockAlign>::allocate,
+              &FreeList<(I + 1) * BlockGranule, BlockAlign>::release}...}};
+}
+
+constexpr auto sizeClassOps =
+    makeSizeClassOps(std::make_index_sequence<NumSizeClasses>());
+
+void *
+allocateBuffer(size_t size)
+{
+    size_t size_class = divCeil(size + HeaderSize, BlockGranule) - 1;
+    void *block = size_class < NumSizeClasses ?
+        sizeClassOps[size_class].allocate() :
+        ::operator new(size + HeaderSize);
+    *static_cast<size_t *>(block) = size_class;
+    return static_cast<uint8_t *>(block) + HeaderSize;
+}
+
+void
+releaseBuffer(void *buf)
+{
+    void *block = static_cast<uint8_t *>(buf) - HeaderSize;
+    size_t size_class = *static_cast<size_t *>(block);
+    if (size_class < NumSizeClasses)
+        sizeClassOps[size_class].release(block);
+    else
+        ::operator delete(block);
+}
+
+} // anonymous namespace
+
 DynInst::DynInst(const Arrays &arrays, const StaticInstPtr &static_inst,
         const StaticInstPtr &_macroop, InstSeqNum seq_num, CPU *_cpu)
     : seqNum(seq_num), staticInst(static_inst), cpu(_cpu),
@@ -168,7 +229,7 @@ DynInst::operator new(size_t count, Arrays &arrays)
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
     // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    uint8_t *buf = (uint8_t *)allocateBuffer(total_size);
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -187,6 +248,12 @@ DynInst::operator new(size_t count, Arrays &arrays)
     return buf;
 }
 
+void
+DynInst::operator delete(void *ptr)
+{
+    releaseBuffer(ptr);
+}
+
 DynInst::~DynInst()
 {
     /*
@@ -73,7 +73,7 @@ class Packet;
 namespace o3
 {
 
-class DynInst : public ExecContext, public RefCounted
+class DynInst final : public ExecContext, public RefCounted
 {
   private:
     DynInst(const StaticInstPtr &staticInst, const StaticInstPtr &macroop,
@@ -81,7 +81,7 @@ class DynInst : public ExecContext, public RefCounted
 
   public:
     // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename DynInstList::iterator ListIt;
 
     struct Arrays
     {
@@ -96,6 +96,7 @@ class DynInst : public ExecContext, public RefCounted
     };
 
     static void *operator new(size_t count, Arrays &arrays);
+    static void operator delete(void *ptr);
 
     /** BaseDynInst constructor given a binary instruction. */
     DynInst(const Arrays &arrays, const StaticInstPtr &staticInst,
@@ -319,6 +320,9 @@ class DynInst : public ExecContext, public RefCounted
     /** Iterator pointing to this BaseDynInst in the list of all insts. */
     ListIt instListIt;
 
+    /** Slot of this instruction in the IQ wakeup matrix, if any. */
+    int iqSlot = -1;
+
     ////////////////////// Branch Data ///////////////
     /** Predicted PC state after this instruction. */
     std::unique_ptr<PCStateBase> predPC;
@@ -983,7 +987,6 @@ class DynInst : public ExecContext, public RefCounted
     uint64_t htmDepth = 0;
 
   public:
-#if TRACING_ON
     // Value -1 indicates that particular phase
     // hasn't happened (yet).
     /** Tick records used for the pipeline activity viewer. */
@@ -995,7 +998,6 @@ class DynInst : public ExecContext, public RefCounted
     int32_t completeTick = -1;
     int32_t commitTick = -1;
     int32_t storeTick = -1;
-#endif
 
     /* Values used by LoadToUse stat */
     Tick firstIssue = -1;
@@ -1133,9 +1135,16 @@ class DynInst : public ExecContext, public RefCounted
     getRegOperand(const StaticInst *si, int idx) override
     {
         const PhysRegIdPtr reg = renamedSrcIdx(idx);
-        if (reg->is(InvalidRegClass))
+        switch (reg->classValue()) {
+          case IntRegClass:
+            return cpu->getRegFast<IntRegClass>(reg);
+          case FloatRegClass:
+            return cpu->getRegFast<FloatRegClass>(reg);
+          case InvalidRegClass:
             return 0;
-        return cpu->getReg(reg);
+          default:
+            return cpu->getReg(reg);
+        }
     }
 
     void
@@ -1153,6 +1162,17 @@ class DynInst : public ExecContext, public RefCounted
         return cpu->getWritableReg(renamedDestIdx(idx));
     }
 
+    const void *
+    getReadableRegOperand(const StaticInst *si, int idx) override
+    {
+        // Sources and destinations are always different physical
+        // registers once renamed.
+        const PhysRegIdPtr reg = renamedSrcIdx(idx);
+        if (reg->is(InvalidRegClass))
+            return nullptr;
+        return cpu->getWritableReg(reg);
+    }
+
     /** @todo: Make results into arrays so they can handle multiple dest
      *  registers.
      */
@@ -1160,9 +1180,19 @@ class DynInst : public ExecContext, public RefCounted
     setRegOperand(const StaticInst *si, int idx, RegVal val) override
     {
         const PhysRegIdPtr reg = renamedDestIdx(idx);
-        if (reg->is(InvalidRegClass))
+        switch (reg->classValue()) {
+          case IntRegClass:
+            cpu->setRegFast<IntRegClass>(reg, val);
+            break;
+          case FloatRegClass:
+            cpu->setRegFast<FloatRegClass>(reg, val);
+            break;
+          case InvalidRegClass:
             return;
-        cpu->setReg(reg, val);
+          default:
+            cpu->setReg(reg, val);
+            break;
+        }
         setResult(val);
     }
 
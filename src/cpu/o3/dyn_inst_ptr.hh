@@ -42,6 +42,9 @@
 #ifndef __CPU_O3_DYN_INST_PTR_HH__
 #define __CPU_O3_DYN_INST_PTR_HH__
 
+#include <list>
+
+#include "base/pool_allocator.hh"
 #include "base/refcnt.hh"
 
 namespace gem5
@@ -55,6 +58,12 @@ class DynInst;
 using DynInstPtr = RefCountingPtr<DynInst>;
 using DynInstConstPtr = RefCountingPtr<const DynInst>;
 
+/**
+ * List of in-flight instructions. Every instruction goes through several
+ * of them, so their nodes are recycled instead of going to the heap.
+ */
+using DynInstList = std::list<DynInstPtr, PoolAllocator<DynInstPtr>>;
+
 } // namespace o3
 } // namespace gem5
 
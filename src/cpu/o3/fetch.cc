@@ -61,7 +61,6 @@
 #include "debug/Drain.hh"
 #include "debug/Fetch.hh"
 #include "debug/O3CPU.hh"
-#include "debug/O3PipeView.hh"
 #include "mem/packet.hh"
 #include "params/BaseO3CPU.hh"
 #include "sim/byteswap.hh"
@@ -100,7 +99,13 @@ Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
       numThreads(params.numThreads),
       numFetchingThreads(params.smtNumFetchingThreads),
       icachePort(this, _cpu),
-      finishTranslationEvent(this), fetchStats(_cpu, this)
+      finishTranslationEvent(this),
+      decoupledFrontEnd(params.decoupledFrontEnd),
+      ftqSize(params.ftqSize),
+      ftqPrefetch(params.ftqPrefetch),
+      bbBTB(params.ftqBTBEntries),
+      ftqPendingTranslations(0),
+      fetchStats(_cpu, this)
 {
     if (numThreads > MaxThreads)
         fatal("numThreads (%d) is larger than compiled limit (%d),\n"
@@ -131,6 +136,9 @@ Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
         fetchBufferValid[i] = false;
         lastIcacheStall[i] = 0;
         issuePipelinedIfetch[i] = false;
+        ftqPredPC[i] = 0;
+        ftqBlockStart[i] = 0;
+        ftqLastPrefetch[i] = MaxAddr;
     }
 
     branchPred = params.branchPred;
@@ -197,6 +205,15 @@ Fetch::FetchStatGroup::FetchStatGroup(CPU *cpu, Fetch *fetch)
              "Number of outstanding Icache misses that were squashed"),
     ADD_STAT(tlbSquashes, statistics::units::Count::get(),
              "Number of outstanding ITLB misses that were squashed"),
+    ADD_STAT(ftqBlocks, statistics::units::Count::get(),
+             "Number of fetch blocks the decoupled predictor predicted"),
+    ADD_STAT(ftqBTBHits, statistics::units::Count::get(),
+             "Number of fetch blocks predicted with a basic block BTB hit"),
+    ADD_STAT(ftqRedirects, statistics::units::Count::get(),
+             "Number of times fetch diverged from the fetch target queue"),
+    ADD_STAT(ftqPrefetches, statistics::units::Count::get(),
+             "Number of I-cache prefetches sent by the decoupled front "
+             "end"),
     ADD_STAT(nisnDist, statistics::units::Count::get(),
              "Number of instructions fetched each cycle (Total)"),
     ADD_STAT(idleRate, statistics::units::Ratio::get(),
@@ -246,6 +263,14 @@ Fetch::FetchStatGroup::FetchStatGroup(CPU *cpu, Fetch *fetch)
             .prereq(icacheSquashes);
         tlbSquashes
             .prereq(tlbSquashes);
+        ftqBlocks
+            .prereq(ftqBlocks);
+        ftqBTBHits
+            .prereq(ftqBTBHits);
+        ftqRedirects
+            .prereq(ftqRedirects);
+        ftqPrefetches
+            .prereq(ftqPrefetches);
         nisnDist
             .init(/* base value */ 0,
               /* last value */ fetch->fetchWidth,
@@ -308,6 +333,8 @@ Fetch::clearStates(ThreadID tid)
     fetchBufferPC[tid] = 0;
     fetchBufferValid[tid] = false;
     fetchQueue[tid].clear();
+    ftqBlockStart[tid] = pc[tid]->instAddr();
+    ftqRedirect(tid, pc[tid]->instAddr());
 
     // TODO not sure what to do with priorityList for now
     // priorityList.push_back(tid);
@@ -340,6 +367,9 @@ Fetch::resetStage()
 
         fetchQueue[tid].clear();
 
+        ftqBlockStart[tid] = pc[tid]->instAddr();
+        ftqRedirect(tid, pc[tid]->instAddr());
+
         priorityList.push_back(tid);
     }
 
@@ -443,7 +473,8 @@ Fetch::isDrained() const
      * cycle if the finish translation event is scheduled, so make
      * sure that's not the case.
      */
-    return !finishTranslationEvent.scheduled();
+    return !finishTranslationEvent.scheduled() &&
+        ftqPendingTranslations == 0;
 }
 
 void
@@ -582,7 +613,7 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = Request::create(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instRequestorId(), pc,
         cpu->thread[tid]->contextId());
@@ -599,6 +630,153 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     return true;
 }
 
+void
+Fetch::ftqRedirect(ThreadID tid, Addr pc)
+{
+    ftq[tid].clear();
+    ftqPredPC[tid] = pc;
+}
+
+void
+Fetch::ftqPredict(ThreadID tid)
+{
+    if (ftq[tid].size() >= ftqSize || stalls[tid].drain)
+        return;
+
+    FetchTarget target;
+    target.start = ftqPredPC[tid];
+    const BasicBlockBTB::Entry *entry = bbBTB.lookup(target.start, tid);
+    if (entry) {
+        ++fetchStats.ftqBTBHits;
+        target.end = entry->end;
+        target.next = entry->taken() ? entry->target : entry->end;
+    } else {
+        // No branch is known in this block, so predict fetch to fall
+        // through to the next fetch buffer block.
+        target.end = fetchBufferAlignPC(target.start) + fetchBufferSize;
+        target.next = target.end;
+    }
+
+    DPRINTF(Fetch, "[tid:%i] FTQ: predicted fetch block %#x-%#x, next "
+            "%#x\n", tid, target.start, target.end, target.next);
+
+    ftq[tid].push_back(target);
+    ftqPredPC[tid] = target.next;
+    ++fetchStats.ftqBlocks;
+
+    if (ftqPrefetch) {
+        Addr line = target.start & ~Addr(cacheBlkSize - 1);
+        for (; line < target.end; line += cacheBlkSize)
+            prefetchLine(tid, line);
+    }
+}
+
+void
+Fetch::ftqFetched(ThreadID tid, const DynInstPtr &inst,
+                  const PCStateBase &next_pc)
+{
+    const Addr pc = inst->pcState().instAddr();
+    const Addr next = next_pc.instAddr();
+    const bool taken = inst->readPredTaken();
+
+    // Blocks are split at fetch buffer boundaries, the same way the
+    // decoupled predictor walks through the blocks it doesn't know.
+    if (inst->isControl()) {
+        const Addr start = std::max(ftqBlockStart[tid],
+                                    fetchBufferAlignPC(pc));
+        Addr fall_through = next;
+        if (taken) {
+            std::unique_ptr<PCStateBase> npc(inst->pcState().clone());
+            inst->staticInst->advancePC(*npc);
+            fall_through = npc->instAddr();
+        }
+        bbBTB.update(start, fall_through, next, taken, tid);
+        ftqBlockStart[tid] = next;
+    }
+
+    while (!ftq[tid].empty()) {
+        const FetchTarget &head = ftq[tid].front();
+        if (taken) {
+            // A taken branch must end the oldest block and go where
+            // the decoupled predictor expected.
+            if (pc >= head.start && pc < head.end && head.next == next) {
+                ftq[tid].pop_front();
+                return;
+            }
+        } else if (next >= head.start && next < head.end) {
+            // Still going through the oldest block.
+            return;
+        } else if (head.next == head.end && next >= head.end) {
+            // Fell through to the next block, as predicted.
+            ftq[tid].pop_front();
+            continue;
+        }
+
+        DPRINTF(Fetch, "[tid:%i] FTQ: fetch went to %#x instead of %#x, "
+                "redirecting\n", tid, next, head.next);
+        ++fetchStats.ftqRedirects;
+        ftqRedirect(tid, next);
+        return;
+    }
+
+    // Fetch caught up with the decoupled predictor, so restart it from
+    // where fetch is unless it was about to predict that block anyway.
+    if (taken || (next >= ftqPredPC[tid] &&
+                  fetchBufferAlignPC(next) !=
+                  fetchBufferAlignPC(ftqPredPC[tid]))) {
+        ftqRedirect(tid, next);
+    }
+}
+
+void
+Fetch::prefetchLine(ThreadID tid, Addr vaddr)
+{
+    // Fetch is going to read the line it has buffered anyway.
+    const Addr line_mask = ~Addr(cacheBlkSize - 1);
+    if (vaddr == ftqLastPrefetch[tid] || cacheBlocked ||
+        ftqPendingTranslations >= ftqSize ||
+        (fetchBufferValid[tid] && (fetchBufferPC[tid] & line_mask) == vaddr))
+        return;
+
+    ftqLastPrefetch[tid] = vaddr;
+
+    RequestPtr req = Request::create(
+        vaddr, cacheBlkSize, Request::INST_FETCH | Request::PREFETCH,
+        cpu->instRequestorId(), vaddr, cpu->thread[tid]->contextId());
+    req->taskId(cpu->taskId());
+
+    ++ftqPendingTranslations;
+    cpu->mmu->translateTiming(req, cpu->thread[tid]->getTC(),
+                              new PrefetchTranslation(this),
+                              BaseMMU::Execute);
+}
+
+void
+Fetch::finishPrefetchTranslation(const Fault &fault, const RequestPtr &req)
+{
+    assert(ftqPendingTranslations > 0);
+    --ftqPendingTranslations;
+
+    // Prefetches are only hints, so drop the ones that fault or can't
+    // be sent right away.
+    if (fault != NoFault || cpu->switchedOut() || cacheBlocked ||
+        req->isUncacheable() || !cpu->system->isMemAddr(req->getPaddr())) {
+        return;
+    }
+
+    DPRINTF(Fetch, "FTQ: prefetching I-cache line %#x\n", req->getVaddr());
+
+    PacketPtr pkt = new Packet(req, MemCmd::SoftPFReq);
+    if (!icachePort.sendTimingReq(pkt)) {
+        // The cache will ask for a retry, which recvReqRetry() treats
+        // like the retry of a squashed access.
+        delete pkt;
+        cacheBlocked = true;
+        return;
+    }
+    ++fetchStats.ftqPrefetches;
+}
+
 void
 Fetch::finishTranslation(const Fault &fault, const RequestPtr &mem_req)
 {
@@ -747,6 +925,9 @@ Fetch::doSquash(const PCStateBase &new_pc, const DynInstPtr squashInst,
     // Empty fetch queue
     fetchQueue[tid].clear();
 
+    ftqBlockStart[tid] = new_pc.instAddr();
+    ftqRedirect(tid, new_pc.instAddr());
+
     // microops are being squashed, it is not known wheather the
     // youngest non-squashed microop was  marked delayed commit
     // or not. Setting the flag to true ensures that the
@@ -890,6 +1071,12 @@ Fetch::tick()
         }
     }
 
+    // Let the decoupled branch predictor run ahead of fetch.
+    if (decoupledFrontEnd) {
+        for (auto tid : *activeThreads)
+            ftqPredict(tid);
+    }
+
     // Send instructions enqueued into the fetch queue to decode.
     // Limit rate by fetchWidth.  Stall if decode is stalled.
     unsigned insts_to_decode = 0;
@@ -1276,11 +1463,9 @@ Fetch::fetch(bool &status_change)
             ppFetch->notify(instruction);
             numInst++;
 
-#if TRACING_ON
-            if (debug::O3PipeView) {
+            if (cpu->tracingPipeline()) {
                 instruction->fetchTick = curTick();
             }
-#endif
 
             set(next_pc, this_pc);
 
@@ -1288,6 +1473,10 @@ Fetch::fetch(bool &status_change)
             // from the same block.
             predictedBranch |= this_pc.branching();
             predictedBranch |= lookupAndUpdateNextPC(instruction, *next_pc);
+            if (decoupledFrontEnd && (!instruction->isMicroop() ||
+                                      instruction->isLastMicroop())) {
+                ftqFetched(tid, instruction, *next_pc);
+            }
             if (predictedBranch) {
                 DPRINTF(Fetch, "Branch detected with PC = %s\n", this_pc);
             }
@@ -1606,6 +1795,11 @@ bool
 Fetch::IcachePort::recvTimingResp(PacketPtr pkt)
 {
     DPRINTF(O3CPU, "Fetch unit received timing\n");
+    // The prefetches of the decoupled front end don't carry any data
+    if (pkt->cmd == MemCmd::SoftPFResp) {
+        delete pkt;
+        return true;
+    }
     // We shouldn't ever get a cacheable block in Modified state
     assert(pkt->req->isUncacheable() ||
            !(pkt->cacheResponding() && !pkt->hasSharers()));
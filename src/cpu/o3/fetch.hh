@@ -47,6 +47,7 @@
 #include "config/the_isa.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/fetch_target_queue.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/pc_event.hh"
 #include "cpu/pred/bpred_unit.hh"
@@ -122,6 +123,27 @@ class Fetch
         }
     };
 
+    /** Translation of a prefetch of the decoupled front end. */
+    class PrefetchTranslation : public BaseMMU::Translation
+    {
+      protected:
+        Fetch *fetch;
+
+      public:
+        PrefetchTranslation(Fetch *_fetch) : fetch(_fetch) {}
+
+        void markDelayed() {}
+
+        void
+        finish(const Fault &fault, const RequestPtr &req,
+            gem5::ThreadContext *tc, BaseMMU::Mode mode)
+        {
+            assert(mode == BaseMMU::Execute);
+            fetch->finishPrefetchTranslation(fault, req);
+            delete this;
+        }
+    };
+
   private:
     /* Event to delay delivery of a fetch translation result in case of
      * a fault and the nop to carry the fault cannot be generated
@@ -300,6 +322,34 @@ class Fetch
     bool fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc);
     void finishTranslation(const Fault &fault, const RequestPtr &mem_req);
 
+    /**
+     * Discards the fetch targets of a thread and restarts the decoupled
+     * branch predictor at the given address.
+     */
+    void ftqRedirect(ThreadID tid, Addr pc);
+
+    /**
+     * Runs the decoupled branch predictor of a thread for a cycle,
+     * adding the next fetch block to the fetch target queue and
+     * prefetching its cache lines.
+     */
+    void ftqPredict(ThreadID tid);
+
+    /**
+     * Trains the basic block BTB with an instruction fetch has just
+     * predicted, and checks the path fetch took against the fetch
+     * target queue, redirecting the decoupled predictor when they
+     * disagree.
+     * @param next_pc The PC fetch continues at after the instruction.
+     */
+    void ftqFetched(ThreadID tid, const DynInstPtr &inst,
+                    const PCStateBase &next_pc);
+
+    /** Sends a software prefetch for an I-cache line. */
+    void prefetchLine(ThreadID tid, Addr vaddr);
+    void finishPrefetchTranslation(const Fault &fault,
+                                   const RequestPtr &req);
+
 
     /** Check if an interrupt is pending and that we need to handle
      */
@@ -528,6 +578,33 @@ class Fetch
     /** Event used to delay fault generation of translation faults */
     FinishTranslationEvent finishTranslationEvent;
 
+    /** Is the decoupled front end enabled? */
+    const bool decoupledFrontEnd;
+
+    /** Number of fetch blocks the decoupled predictor can run ahead. */
+    const unsigned ftqSize;
+
+    /** Should the decoupled front end prefetch into the I-cache? */
+    const bool ftqPrefetch;
+
+    /** Branch target buffer of the decoupled predictor. */
+    BasicBlockBTB bbBTB;
+
+    /** Fetch blocks predicted ahead of fetch, oldest first. */
+    std::deque<FetchTarget> ftq[MaxThreads];
+
+    /** Where the decoupled predictor continues. */
+    Addr ftqPredPC[MaxThreads];
+
+    /** Start of the block fetch is in, used to train the BTB. */
+    Addr ftqBlockStart[MaxThreads];
+
+    /** The last line prefetched, to avoid prefetching it twice. */
+    Addr ftqLastPrefetch[MaxThreads];
+
+    /** Number of prefetch translations in flight. */
+    unsigned ftqPendingTranslations;
+
   protected:
     struct FetchStatGroup : public statistics::Group
     {
@@ -578,6 +655,14 @@ class Fetch
          * due to a squash.
          */
         statistics::Scalar tlbSquashes;
+        /** Number of fetch blocks the decoupled predictor predicted. */
+        statistics::Scalar ftqBlocks;
+        /** Number of fetch blocks predicted with a BTB hit. */
+        statistics::Scalar ftqBTBHits;
+        /** Number of times fetch diverged from the fetch targets. */
+        statistics::Scalar ftqRedirects;
+        /** Number of I-cache prefetches the decoupled front end sent. */
+        statistics::Scalar ftqPrefetches;
         /** Distribution of number of instructions fetched each cycle. */
         statistics::Distribution nisnDist;
         /** Rate of how often fetch was idle. */
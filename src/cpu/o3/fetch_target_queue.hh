@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_FETCH_TARGET_QUEUE_HH__
+#define __CPU_O3_FETCH_TARGET_QUEUE_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * One entry of the fetch target queue: a block of sequential
+ * instructions the decoupled branch predictor expects fetch to go
+ * through, and the address it expects fetch to continue at.
+ */
+struct FetchTarget
+{
+    /** Address of the first instruction of the block. */
+    Addr start = 0;
+    /** Address just past the last instruction of the block. */
+    Addr end = 0;
+    /** Predicted start of the following block. */
+    Addr next = 0;
+};
+
+/**
+ * Branch target buffer indexed by the start address of a fetch block
+ * rather than by the address of a branch. A block starts at a branch
+ * target, after a branch or at a fetch buffer boundary, and each entry
+ * records where the block's terminating branch ends, where the branch
+ * goes when taken and a two bit counter predicting its direction. This
+ * lets the decoupled front end predict a whole block with one lookup.
+ */
+class BasicBlockBTB
+{
+  public:
+    struct Entry
+    {
+        bool valid = false;
+        ThreadID tid = 0;
+        /** Start address of the block, used as the tag. */
+        Addr start = 0;
+        /** Fall through address of the branch ending the block. */
+        Addr end = 0;
+        /** Target of the branch when taken. */
+        Addr target = 0;
+        /** Saturating direction counter, taken when >= 2. */
+        uint8_t counter = 0;
+
+        bool taken() const { return counter >= 2; }
+    };
+
+    explicit BasicBlockBTB(unsigned num_entries)
+        : entries(num_entries), mask(num_entries - 1),
+          indexBits(floorLog2(num_entries))
+    {
+        fatal_if(!isPowerOf2(num_entries), "Number of basic block BTB "
+                 "entries (%u) must be a power of 2\n", num_entries);
+    }
+
+    /** Returns the entry of the block starting at start, if any. */
+    const Entry *
+    lookup(Addr start, ThreadID tid) const
+    {
+        const Entry &entry = entries[index(start)];
+        if (entry.valid && entry.start == start && entry.tid == tid)
+            return &entry;
+        return nullptr;
+    }
+
+    /**
+     * Records the branch ending the block starting at start.
+     * @param end The fall through address of the branch.
+     * @param target Where the branch went, only used when taken.
+     * @param taken Whether the branch was taken.
+     */
+    void
+    update(Addr start, Addr end, Addr target, bool taken, ThreadID tid)
+    {
+        if (end <= start)
+            return;
+
+        Entry &entry = entries[index(start)];
+        if (!entry.valid || entry.start != start || entry.tid != tid ||
+            entry.end != end) {
+            entry.valid = true;
+            entry.tid = tid;
+            entry.start = start;
+            entry.end = end;
+            entry.target = target;
+            entry.counter = taken ? 2 : 1;
+            return;
+        }
+
+        if (taken) {
+            entry.target = target;
+            if (entry.counter < 3)
+                entry.counter++;
+        } else if (entry.counter > 0) {
+            entry.counter--;
+        }
+    }
+
+  private:
+    unsigned
+    index(Addr start) const
+    {
+        return (start ^ (start >> indexBits)) & mask;
+    }
+
+    std::vector<Entry> entries;
+    const unsigned mask;
+    const unsigned indexBits;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif //__CPU_O3_FETCH_TARGET_QUEUE_HH__
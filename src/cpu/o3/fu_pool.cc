@@ -41,7 +41,10 @@
 #include "cpu/o3/fu_pool.hh"
 
 #include <sstream>
+#include <utility>
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "cpu/func_unit.hh"
 
 namespace gem5
@@ -55,24 +58,6 @@ namespace o3
 //  A pool of function units
 //
 
-inline void
-FUPool::FUIdxQueue::addFU(int fu_idx)
-{
-    funcUnitsIdx.push_back(fu_idx);
-    ++size;
-}
-
-inline int
-FUPool::FUIdxQueue::getFU()
-{
-    int retval = funcUnitsIdx[idx++];
-
-    if (idx == size)
-        idx = 0;
-
-    return retval;
-}
-
 FUPool::~FUPool()
 {
     fuListIterator i = funcUnits.begin();
@@ -93,6 +78,10 @@ FUPool::FUPool(const Params &p)
     maxOpLatencies.fill(Cycles(0));
     pipelined.fill(true);
 
+    // The units of each capability, added to the masks once the
+    // number of units is known
+    std::vector<std::pair<OpClass, int>> capable_units;
+
     //
     //  Iterate through the list of FUDescData structures
     //
@@ -121,7 +110,7 @@ FUPool::FUPool(const Params &p)
                 // Add each of the FU's that will have this capability to the
                 // appropriate queue.
                 for (int k = 0; k < (*i)->number; ++k)
-                    fuPerCapList[(*j)->opClass].addFU(numFU + k);
+                    capable_units.emplace_back((*j)->opClass, numFU + k);
 
                 // indicate that this FU has the capability
                 fu->addCapability((*j)->opClass, (*j)->opLat, (*j)->pipelined);
@@ -151,11 +140,34 @@ FUPool::FUPool(const Params &p)
         }
     }
 
-    unitBusy.resize(numFU);
+    numWords = std::max(divCeil(numFU, 64), 1);
+    unitBusy.assign(numWords, 0);
+    unitsToBeFreed.assign(numWords, 0);
+    for (auto &mask : fuPerCapList)
+        mask.assign(numWords, 0);
+    for (const auto &[op_class, fu_idx] : capable_units)
+        fuPerCapList[op_class][fu_idx / 64] |= 1ULL << (fu_idx % 64);
 
-    for (int i = 0; i < numFU; i++) {
-        unitBusy[i] = false;
+    for (int c = 0; c < Num_OpClasses; ++c)
+        nextFU[c] = std::max(findUnit(fuPerCapList[c], 0, false), 0);
+}
+
+int
+FUPool::findUnit(const FUMask &mask, int start, bool busy) const
+{
+    if (start >= numFU)
+        start = 0;
+    int word = start / 64;
+    uint64_t bits = mask[word] & ~gem5::mask(start % 64);
+    for (int n = 0; n <= numWords; ++n) {
+        if (busy)
+            bits &= ~unitBusy[word];
+        if (bits)
+            return word * 64 + findLsbSet(bits);
+        word = (word + 1) % numWords;
+        bits = mask[word];
     }
+    return -1;
 }
 
 int
@@ -166,22 +178,20 @@ FUPool::getUnit(OpClass capability)
     if (!capabilityList[capability])
         return -2;
 
-    int fu_idx = fuPerCapList[capability].getFU();
-    int start_idx = fu_idx;
+    const FUMask &capable = fuPerCapList[capability];
+    int start_idx = nextFU[capability];
+    int fu_idx = findUnit(capable, start_idx, true);
 
-    // Iterate through the circular queue if needed, stopping if we've reached
-    // the first element again.
-    while (unitBusy[fu_idx]) {
-        fu_idx = fuPerCapList[capability].getFU();
-        if (fu_idx == start_idx) {
-            // No FU available
-            return -1;
-        }
+    if (fu_idx < 0) {
+        // No FU available, the next search starts one unit further
+        nextFU[capability] = findUnit(capable, start_idx + 1, false);
+        return -1;
     }
 
     assert(fu_idx < numFU);
 
-    unitBusy[fu_idx] = true;
+    unitBusy[fu_idx / 64] |= 1ULL << (fu_idx % 64);
+    nextFU[capability] = findUnit(capable, fu_idx + 1, false);
 
     return fu_idx;
 }
@@ -189,20 +199,17 @@ FUPool::getUnit(OpClass capability)
 void
 FUPool::freeUnitNextCycle(int fu_idx)
 {
-    assert(unitBusy[fu_idx]);
-    unitsToBeFreed.push_back(fu_idx);
+    assert(isBusy(fu_idx));
+    unitsToBeFreed[fu_idx / 64] |= 1ULL << (fu_idx % 64);
 }
 
 void
 FUPool::processFreeUnits()
 {
-    while (!unitsToBeFreed.empty()) {
-        int fu_idx = unitsToBeFreed.back();
-        unitsToBeFreed.pop_back();
-
-        assert(unitBusy[fu_idx]);
-
-        unitBusy[fu_idx] = false;
+    for (int w = 0; w < numWords; ++w) {
+        assert((unitBusy[w] & unitsToBeFreed[w]) == unitsToBeFreed[w]);
+        unitBusy[w] &= ~unitsToBeFreed[w];
+        unitsToBeFreed[w] = 0;
     }
 }
 
@@ -214,7 +221,7 @@ FUPool::dump()
     std::cout << "Free List:\n";
 
     for (int i = 0; i < numFU; ++i) {
-        if (unitBusy[i]) {
+        if (isBusy(i)) {
             continue;
         }
 
@@ -228,7 +235,7 @@ FUPool::dump()
     std::cout << "======================================\n";
     std::cout << "Busy List:\n";
     for (int i = 0; i < numFU; ++i) {
-        if (!unitBusy[i]) {
+        if (!isBusy(i)) {
             continue;
         }
 
@@ -243,11 +250,11 @@ FUPool::dump()
 bool
 FUPool::isDrained() const
 {
-    bool is_drained = true;
-    for (int i = 0; i < numFU; i++)
-        is_drained = is_drained && !unitBusy[i];
-
-    return is_drained;
+    for (uint64_t busy : unitBusy) {
+        if (busy)
+            return false;
+    }
+    return true;
 }
 
 } // namespace o3
@@ -83,47 +83,45 @@ class FUPool : public SimObject
     /** Bitvector listing capabilities of this FU pool. */
     std::bitset<Num_OpClasses> capabilityList;
 
-    /** Bitvector listing which FUs are busy. */
-    std::vector<bool> unitBusy;
-
-    /** List of units to be freed at the end of this cycle. */
-    std::vector<int> unitsToBeFreed;
-
     /**
-     * Class that implements a circular queue to hold FU indices. The hope is
-     * that FUs that have been just used will be moved to the end of the queue
-     * by iterating through it, thus leaving free units at the head of the
-     * queue.
+     * Sets of FUs, as bitmasks indexed by FU number, so that a free unit
+     * of an op class is found with a few word operations.
      */
-    class FUIdxQueue
-    {
-      public:
-        /** Constructs a circular queue of FU indices. */
-        FUIdxQueue()
-            : idx(0), size(0)
-        { }
+    typedef std::vector<uint64_t> FUMask;
 
-        /** Adds a FU to the queue. */
-        inline void addFU(int fu_idx);
+    /** Number of 64 bit words in a FUMask. */
+    int numWords;
 
-        /** Returns the index of the FU at the head of the queue, and changes
-         *  the index to the next element.
-         */
-        inline int getFU();
+    /** Bitmask listing which FUs are busy. */
+    FUMask unitBusy;
 
-      private:
-        /** Circular queue index. */
-        int idx;
+    /** Bitmask of the units to be freed at the end of this cycle. */
+    FUMask unitsToBeFreed;
 
-        /** Size of the queue. */
-        int size;
+    /** Per op class bitmasks of FUs that provide that capability. */
+    std::array<FUMask, Num_OpClasses> fuPerCapList;
+
+    /**
+     * Per op class FU to try first. The units of an op class are used
+     * round robin, searching from the one after the unit last returned.
+     */
+    std::array<int, Num_OpClasses> nextFU;
 
-        /** Queue of FU indices. */
-        std::vector<int> funcUnitsIdx;
-    };
+    /**
+     * Find the first unit set in a mask from a unit onwards, wrapping
+     * around at the end.
+     * @param mask The units to consider.
+     * @param start The unit to start from.
+     * @param busy Whether to skip the busy units.
+     * @return The unit, or -1 if there is none.
+     */
+    int findUnit(const FUMask &mask, int start, bool busy) const;
 
-    /** Per op class queues of FUs that provide that capability. */
-    FUIdxQueue fuPerCapList[Num_OpClasses];
+    bool
+    isBusy(int fu_idx) const
+    {
+        return unitBusy[fu_idx / 64] & (1ULL << (fu_idx % 64));
+    }
 
     /** Number of FUs. */
     int numFU;
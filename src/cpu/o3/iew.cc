@@ -56,7 +56,6 @@
 #include "debug/Activity.hh"
 #include "debug/Drain.hh"
 #include "debug/IEW.hh"
-#include "debug/O3PipeView.hh"
 #include "params/BaseO3CPU.hh"
 
 namespace gem5
@@ -1089,9 +1088,7 @@ IEW::dispatchInsts(ThreadID tid)
 
         ++iewStats.dispatchedInsts;
 
-#if TRACING_ON
         inst->dispatchTick = curTick() - inst->fetchTick;
-#endif
         ppDispatch->notify(inst);
     }
 
@@ -1564,11 +1561,9 @@ IEW::updateExeInstStats(const DynInstPtr& inst)
 
     iewStats.executedInstStats.numInsts++;
 
-#if TRACING_ON
-    if (debug::O3PipeView) {
+    if (cpu->tracingPipeline()) {
         inst->completeTick = curTick() - inst->fetchTick;
     }
-#endif
 
     //
     //  Control operations
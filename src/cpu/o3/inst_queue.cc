@@ -63,32 +63,12 @@ namespace gem5
 namespace o3
 {
 
-InstructionQueue::FUCompletion::FUCompletion(const DynInstPtr &_inst,
-    int fu_idx, InstructionQueue *iq_ptr)
-    : Event(Stat_Event_Pri, AutoDelete),
-      inst(_inst), fuIdx(fu_idx), iqPtr(iq_ptr), freeFU(false)
-{
-}
-
-void
-InstructionQueue::FUCompletion::process()
-{
-    iqPtr->processFUCompletion(inst, freeFU ? fuIdx : -1);
-    inst = NULL;
-}
-
-
-const char *
-InstructionQueue::FUCompletion::description() const
-{
-    return "Functional unit completion";
-}
-
 InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
         const BaseO3CPUParams &params)
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params.fuPool),
+      useWakeupMatrix(params.iqWakeupMatrix),
       iqPolicy(params.smtIQPolicy),
       numThreads(params.numThreads),
       numEntries(params.numIQEntries),
@@ -112,7 +92,10 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
 
     //Create an entry for each physical register within the
     //dependency graph.
-    dependGraph.resize(numPhysRegs);
+    if (useWakeupMatrix)
+        wakeupMatrix.resize(numPhysRegs, numEntries);
+    else
+        dependGraph.resize(numPhysRegs);
 
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
@@ -164,6 +147,7 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
 InstructionQueue::~InstructionQueue()
 {
     dependGraph.reset();
+    wakeupMatrix.reset();
 #ifdef DEBUG
     cprintf("Nodes traversed: %i, removed: %i\n",
             dependGraph.nodesTraversed, dependGraph.nodesRemoved);
@@ -451,7 +435,7 @@ InstructionQueue::setTimeBuffer(TimeBuffer<TimeStruct> *tb_ptr)
 bool
 InstructionQueue::isDrained() const
 {
-    bool drained = dependGraph.empty() &&
+    bool drained = dependGraph.empty() && wakeupMatrix.empty() &&
                    instsToExecute.empty() &&
                    wbOutstanding == 0;
     for (ThreadID tid = 0; tid < numThreads; ++tid)
@@ -464,6 +448,7 @@ void
 InstructionQueue::drainSanityCheck() const
 {
     assert(dependGraph.empty());
+    assert(wakeupMatrix.empty());
     assert(instsToExecute.empty());
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         memDepUnit[tid].drainSanityCheck();
@@ -558,6 +543,13 @@ InstructionQueue::hasReadyInsts()
     return false;
 }
 
+bool
+InstructionQueue::hasPendingMemInsts() const
+{
+    return !deferredMemInsts.empty() || !blockedMemInsts.empty() ||
+           !retryMemInsts.empty();
+}
+
 void
 InstructionQueue::insert(const DynInstPtr &new_inst)
 {
@@ -842,22 +834,25 @@ InstructionQueue::scheduleReadyInsts()
                     fuPool->freeUnitNextCycle(idx);
             } else {
                 bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
+                // If FU isn't pipelined, then it must be freed upon the
+                // execution completing. Otherwise, add the FU onto the
+                // list of FU's to be freed next cycle.
+                int free_idx = -1;
                 if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
+                    free_idx = idx;
                 } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
                     fuPool->freeUnitNextCycle(idx);
                 }
+
+                // Generate completion event for the FU
+                ++wbOutstanding;
+                cpu->schedulePooled(
+                    [this, issuing_inst, free_idx]{
+                        processFUCompletion(issuing_inst, free_idx);
+                    },
+                    "Functional unit completion",
+                    cpu->clockEdge(Cycles(op_latency - 1)),
+                    Event::Stat_Event_Pri);
             }
 
             DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
@@ -877,9 +872,7 @@ InstructionQueue::scheduleReadyInsts()
             issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
             issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
 
             if (issuing_inst->firstIssue == -1)
                 issuing_inst->firstIssue = curTick();
@@ -1032,9 +1025,19 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
 
         //Go through the dependency chain, marking the registers as
         //ready within the waiting instructions.
-        DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
+        RegIndex dest_idx = dest_reg->flatIndex();
+        DynInstPtr dep_inst = useWakeupMatrix ?
+            wakeupMatrix.pop(dest_idx) : dependGraph.pop(dest_idx);
 
         while (dep_inst) {
+            // Squashed instructions are left in the dependency graph
+            // until they are popped, see doSquash().
+            if (dep_inst->isSquashed()) {
+                dep_inst = useWakeupMatrix ?
+                    wakeupMatrix.pop(dest_idx) : dependGraph.pop(dest_idx);
+                continue;
+            }
+
             DPRINTF(IQ, "Waking up a dependent instruction, [sn:%llu] "
                     "PC %s.\n", dep_inst->seqNum, dep_inst->pcState());
 
@@ -1046,15 +1049,21 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
 
             addIfReady(dep_inst);
 
-            dep_inst = dependGraph.pop(dest_reg->flatIndex());
+            dep_inst = useWakeupMatrix ?
+                wakeupMatrix.pop(dest_idx) : dependGraph.pop(dest_idx);
 
             ++dependents;
         }
 
         // Reset the head node now that all of its dependents have
         // been woken up.
-        assert(dependGraph.empty(dest_reg->flatIndex()));
-        dependGraph.clearInst(dest_reg->flatIndex());
+        if (useWakeupMatrix) {
+            assert(wakeupMatrix.empty(dest_idx));
+            wakeupMatrix.clearInst(dest_idx);
+        } else {
+            assert(dependGraph.empty(dest_idx));
+            dependGraph.clearInst(dest_idx);
+        }
 
         // Mark the scoreboard as having that register ready.
         regScoreboard[dest_reg->flatIndex()] = true;
@@ -1242,16 +1251,19 @@ InstructionQueue::doSquash(ThreadID tid)
                     // Only remove it from the dependency graph if it
                     // was placed there in the first place.
 
-                    // Instead of doing a linked list traversal, we
-                    // can just remove these squashed instructions
-                    // either at issue time, or when the register is
-                    // overwritten.  The only downside to this is it
-                    // leaves more room for error.
+                    // Instead of doing a linked list traversal, the
+                    // squashed instruction is left in the dependency
+                    // graph.  It is skipped when the producer wakes up
+                    // its dependents, or dropped when the producer is
+                    // squashed as well.  The wakeup matrix removes it
+                    // right away, as that only clears a bit and frees
+                    // its slot.
 
-                    if (!squashed_inst->readySrcIdx(src_reg_idx) &&
+                    if (useWakeupMatrix &&
+                        !squashed_inst->readySrcIdx(src_reg_idx) &&
                         !src_reg->isFixedMapping()) {
-                        dependGraph.remove(src_reg->flatIndex(),
-                                           squashed_inst);
+                        wakeupMatrix.remove(src_reg->flatIndex(),
+                                            squashed_inst);
                     }
 
                     ++iqStats.squashedOperandsExamined;
@@ -1314,8 +1326,19 @@ InstructionQueue::doSquash(ThreadID tid)
             if (dest_reg->isFixedMapping()){
                 continue;
             }
-            assert(dependGraph.empty(dest_reg->flatIndex()));
-            dependGraph.clearInst(dest_reg->flatIndex());
+            if (useWakeupMatrix) {
+                assert(wakeupMatrix.empty(dest_reg->flatIndex()));
+                wakeupMatrix.clearInst(dest_reg->flatIndex());
+            } else {
+                // Any dependents left are younger, so they have been
+                // squashed already.
+                RegIndex dest_idx = dest_reg->flatIndex();
+                for (DynInstPtr dep_inst = dependGraph.pop(dest_idx);
+                     dep_inst; dep_inst = dependGraph.pop(dest_idx)) {
+                    assert(dep_inst->isSquashed());
+                }
+                dependGraph.clearInst(dest_idx);
+            }
         }
         instList[tid].erase(squash_it--);
         ++iqStats.squashedInstsExamined;
@@ -1357,7 +1380,10 @@ InstructionQueue::addToDependents(const DynInstPtr &new_inst)
                         new_inst->pcState(), src_reg->index(),
                         src_reg->className());
 
-                dependGraph.insert(src_reg->flatIndex(), new_inst);
+                if (useWakeupMatrix)
+                    wakeupMatrix.insert(src_reg->flatIndex(), new_inst);
+                else
+                    dependGraph.insert(src_reg->flatIndex(), new_inst);
 
                 // Change the return value to indicate that something
                 // was added to the dependency graph.
@@ -1397,14 +1423,25 @@ InstructionQueue::addToProducers(const DynInstPtr &new_inst)
             continue;
         }
 
-        if (!dependGraph.empty(dest_reg->flatIndex())) {
-            dependGraph.dump();
-            panic("Dependency graph %i (%s) (flat: %i) not empty!",
-                  dest_reg->index(), dest_reg->className(),
-                  dest_reg->flatIndex());
-        }
+        if (useWakeupMatrix) {
+            if (!wakeupMatrix.empty(dest_reg->flatIndex())) {
+                wakeupMatrix.dump();
+                panic("Wakeup matrix row %i (%s) (flat: %i) not empty!",
+                      dest_reg->index(), dest_reg->className(),
+                      dest_reg->flatIndex());
+            }
 
-        dependGraph.setInst(dest_reg->flatIndex(), new_inst);
+            wakeupMatrix.setInst(dest_reg->flatIndex(), new_inst);
+        } else {
+            if (!dependGraph.empty(dest_reg->flatIndex())) {
+                dependGraph.dump();
+                panic("Dependency graph %i (%s) (flat: %i) not empty!",
+                      dest_reg->index(), dest_reg->className(),
+                      dest_reg->flatIndex());
+            }
+
+            dependGraph.setInst(dest_reg->flatIndex(), new_inst);
+        }
 
         // Mark the scoreboard to say it's not yet ready.
         regScoreboard[dest_reg->flatIndex()] = false;
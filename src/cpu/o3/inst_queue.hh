@@ -56,6 +56,7 @@
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
 #include "cpu/o3/store_set.hh"
+#include "cpu/o3/wakeup_matrix.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
 #include "enums/SMTQueuePolicy.hh"
@@ -99,35 +100,7 @@ class InstructionQueue
 {
   public:
     // Typedef of iterator through the list of instructions.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
-
-    /** FU completion event class. */
-    class FUCompletion : public Event
-    {
-      private:
-        /** Executing instruction. */
-        DynInstPtr inst;
-
-        /** Index of the FU used for executing. */
-        int fuIdx;
-
-        /** Pointer back to the instruction queue. */
-        InstructionQueue *iqPtr;
-
-        /** Should the FU be added to the list to be freed upon
-         * completing this event.
-         */
-        bool freeFU;
-
-      public:
-        /** Construct a FU completion event. */
-        FUCompletion(const DynInstPtr &_inst, int fu_idx,
-                     InstructionQueue *iq_ptr);
-
-        virtual void process();
-        virtual const char *description() const;
-        void setFreeFU() { freeFU = true; }
-    };
+    typedef typename DynInstList::iterator ListIt;
 
     /** Constructs an IQ. */
     InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
@@ -181,6 +154,11 @@ class InstructionQueue
     /** Returns if there are any ready instructions in the IQ. */
     bool hasReadyInsts();
 
+    /** Returns if there are memory instructions waiting on a
+     *  translation, a retry or a replay.
+     */
+    bool hasPendingMemInsts() const;
+
     /** Inserts a new instruction into the IQ. */
     void insert(const DynInstPtr &new_inst);
 
@@ -318,23 +296,23 @@ class InstructionQueue
     //////////////////////////////////////
 
     /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[MaxThreads];
+    DynInstList instList[MaxThreads];
 
     /** List of instructions that are ready to be executed. */
-    std::list<DynInstPtr> instsToExecute;
+    DynInstList instsToExecute;
 
     /** List of instructions waiting for their DTB translation to
      *  complete (hw page table walk in progress).
      */
-    std::list<DynInstPtr> deferredMemInsts;
+    DynInstList deferredMemInsts;
 
     /** List of instructions that have been cache blocked. */
-    std::list<DynInstPtr> blockedMemInsts;
+    DynInstList blockedMemInsts;
 
     /** List of instructions that were cache blocked, but a retry has been seen
      * since, so they can now be retried. May fail again go on the blocked list.
      */
-    std::list<DynInstPtr> retryMemInsts;
+    DynInstList retryMemInsts;
 
     /**
      * Struct for comparing entries to be added to the priority queue.
@@ -404,6 +382,13 @@ class InstructionQueue
 
     DependencyGraph<DynInstPtr> dependGraph;
 
+    /** Wakeup matrix used instead of the dependency graph if
+     *  useWakeupMatrix is set. */
+    WakeupMatrix<DynInstPtr> wakeupMatrix;
+
+    /** Whether the dependences are tracked by the wakeup matrix. */
+    const bool useWakeupMatrix;
+
     //////////////////////////////////////
     // Various parameters
     //////////////////////////////////////
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_LSQ_ADDR_FILTER_HH__
+#define __CPU_O3_LSQ_ADDR_FILTER_HH__
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Counting filter over the address ranges held by the entries of a load
+ * or store queue.  Ranges are tracked at the granularity of 1 << shift
+ * bytes and hashed into a fixed number of buckets, so a lookup can only
+ * report false positives.  The LSQ unit uses it to skip walking a queue
+ * when no entry can overlap the address range of interest, and keeps
+ * doing the exact search otherwise.
+ */
+class LSQAddrFilter
+{
+  public:
+    /** Ranges spanning more granules than this are not hashed. */
+    static constexpr unsigned MaxGranules = 4;
+
+    explicit LSQAddrFilter(unsigned shift=0) : shift(shift) { reset(); }
+
+    /** Adds the range [addr, addr + size) to the filter. */
+    void
+    insert(Addr addr, unsigned size)
+    {
+        update(addr, size, 1);
+    }
+
+    /** Removes a range previously passed to insert(). */
+    void
+    remove(Addr addr, unsigned size)
+    {
+        update(addr, size, -1);
+    }
+
+    /** Returns false if no range in the filter overlaps [addr, addr +
+     *  size). */
+    bool
+    mayOverlap(Addr addr, unsigned size) const
+    {
+        if (numRanges == 0)
+            return false;
+        if (size == 0)
+            return true;
+        Addr first = addr >> shift;
+        Addr last = (addr + size - 1) >> shift;
+        if (numWide || last - first >= MaxGranules)
+            return true;
+        for (Addr g = first; g <= last; g++) {
+            if (counts[g % NumBuckets])
+                return true;
+        }
+        return false;
+    }
+
+    bool empty() const { return numRanges == 0; }
+
+    void
+    reset()
+    {
+        counts.fill(0);
+        numWide = 0;
+        numRanges = 0;
+    }
+
+  private:
+    static constexpr unsigned NumBuckets = 256;
+
+    void
+    update(Addr addr, unsigned size, int delta)
+    {
+        assert(size);
+        numRanges += delta;
+        Addr first = addr >> shift;
+        Addr last = (addr + size - 1) >> shift;
+        if (last - first >= MaxGranules) {
+            numWide += delta;
+            return;
+        }
+        for (Addr g = first; g <= last; g++)
+            counts[g % NumBuckets] += delta;
+    }
+
+    /** Number of granules of the hashed ranges per bucket. */
+    std::array<uint32_t, NumBuckets> counts;
+
+    /** Number of ranges that were too wide to hash. */
+    unsigned numWide;
+
+    /** Number of ranges in the filter. */
+    unsigned numRanges;
+
+    unsigned shift;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_LSQ_ADDR_FILTER_HH__
@@ -42,6 +42,7 @@
 #include "cpu/o3/lsq_unit.hh"
 
 #include "arch/generic/debugfaults.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
@@ -52,7 +53,6 @@
 #include "debug/HtmCpu.hh"
 #include "debug/IEW.hh"
 #include "debug/LSQUnit.hh"
-#include "debug/O3PipeView.hh"
 #include "mem/packet.hh"
 #include "mem/request.hh"
 
@@ -240,6 +240,24 @@ LSQUnit::resetState()
     stalled = false;
 
     cacheBlockMask = ~(cpu->cacheLineSize() - 1);
+
+    // Loads are checked for violations at the granularity of
+    // depCheckShift, so their filter must not be any finer.
+    unsigned line_shift = floorLog2(cpu->cacheLineSize());
+    loadAddrs = LSQAddrFilter(std::max(line_shift, depCheckShift));
+    storeAddrs = LSQAddrFilter(line_shift);
+}
+
+void
+LSQUnit::setFilterRange(LSQAddrFilter &filter, LSQEntry &entry,
+                        Addr addr, unsigned size)
+{
+    if (entry.filterSize())
+        filter.remove(entry.filterAddr(), entry.filterSize());
+    if (size)
+        filter.insert(addr, size);
+    entry.filterAddr() = addr;
+    entry.filterSize() = size;
 }
 
 std::string
@@ -519,6 +537,9 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
      * all instructions that will execute before the store writes back. Thus,
      * like the implementation that came before it, we're overly conservative.
      */
+    if (!loadAddrs.mayOverlap(inst->effAddr, inst->effSize))
+        return NoFault;
+
     while (loadIt != loadQueue.end()) {
         DynInstPtr ld_inst = loadIt->instruction();
         if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered()) {
@@ -735,6 +756,7 @@ LSQUnit::commitLoad()
                     inst->lastWakeDependents - inst->firstIssue));
     }
 
+    setFilterRange(loadAddrs, loadQueue.front(), 0, 0);
     loadQueue.front().clear();
     loadQueue.pop_front();
 }
@@ -955,6 +977,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         }
         // Clear the smart pointer to make sure it is decremented.
         loadQueue.back().instruction()->setSquashed();
+        setFilterRange(loadAddrs, loadQueue.back(), 0, 0);
         loadQueue.back().clear();
 
         loadQueue.pop_back();
@@ -1026,6 +1049,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         // Must delete request now that it wasn't handed off to
         // memory.  This is quite ugly.  @todo: Figure out the proper
         // place to really handle request deletes.
+        setFilterRange(storeAddrs, storeQueue.back(), 0, 0);
         storeQueue.back().clear();
 
         storeQueue.pop_back();
@@ -1150,6 +1174,7 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            setFilterRange(storeAddrs, storeQueue.front(), 0, 0);
             storeQueue.front().clear();
             storeQueue.pop_front();
         } while (storeQueue.front().completed() &&
@@ -1162,12 +1187,10 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
             "idx:%i\n",
             store_inst->seqNum, store_idx.idx() - 1, storeQueue.head() - 1);
 
-#if TRACING_ON
-    if (debug::O3PipeView) {
+    if (cpu->tracingPipeline()) {
         store_inst->storeTick =
             curTick() - store_inst->fetchTick;
     }
-#endif
 
     if (isStalled() &&
         store_inst->seqNum == stallingStoreIsn) {
@@ -1323,6 +1346,9 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     load_entry.setRequest(request);
     assert(load_inst);
 
+    setFilterRange(loadAddrs, load_entry, load_inst->effAddr,
+                   load_inst->effSize);
+
     assert(!load_inst->isExecuted());
 
     // Make sure this isn't a strictly ordered load
@@ -1386,8 +1412,12 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     // Check the SQ for any previous stores that might lead to forwarding
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
+    // Skip the search if no store in the SQ can overlap the load
+    bool may_forward = storeAddrs.mayOverlap(
+        request->mainReq()->getVaddr(), request->mainReq()->getSize());
     // End once we've reached the top of the LSQ
-    while (store_it != storeWBIt && !load_inst->isDataPrefetch()) {
+    while (may_forward && store_it != storeWBIt &&
+           !load_inst->isDataPrefetch()) {
         // Move the index to one younger
         store_it--;
         assert(store_it->valid());
@@ -1612,6 +1642,8 @@ LSQUnit::write(LSQRequest *request, uint8_t *data, ssize_t store_idx)
     storeQueue[store_idx].setRequest(request);
     unsigned size = request->_size;
     storeQueue[store_idx].size() = size;
+    setFilterRange(storeAddrs, storeQueue[store_idx],
+                   storeQueue[store_idx].instruction()->effAddr, size);
     bool store_no_data =
         request->mainReq()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
@@ -58,6 +58,7 @@
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq.hh"
+#include "cpu/o3/lsq_addr_filter.hh"
 #include "cpu/timebuf.hh"
 #include "debug/HtmCpu.hh"
 #include "debug/LSQUnit.hh"
@@ -104,6 +105,10 @@ class LSQUnit
         uint32_t _size = 0;
         /** Valid entry. */
         bool _valid = false;
+        /** The address range of the entry in the address filter of its
+         *  queue, if its size is not zero. */
+        Addr _filterAddr = 0;
+        unsigned _filterSize = 0;
 
       public:
         ~LSQEntry()
@@ -124,6 +129,7 @@ class LSQUnit
             _request = nullptr;
             _valid = false;
             _size = 0;
+            assert(_filterSize == 0);
         }
 
         void
@@ -144,6 +150,8 @@ class LSQUnit
         uint32_t& size() { return _size; }
         const uint32_t& size() const { return _size; }
         const DynInstPtr& instruction() const { return _inst; }
+        Addr& filterAddr() { return _filterAddr; }
+        unsigned& filterSize() { return _filterSize; }
         /** @} */
     };
 
@@ -461,6 +469,16 @@ class LSQUnit
     /** Should loads be checked for dependency issues */
     bool checkLoads;
 
+    /** Address filters over the loads with a valid address and the
+     *  stores with data in the queues, used to skip searching them.
+     */
+    LSQAddrFilter loadAddrs;
+    LSQAddrFilter storeAddrs;
+
+    /** Sets the address range of an entry in an address filter. */
+    void setFilterRange(LSQAddrFilter &filter, LSQEntry &entry,
+                        Addr addr, unsigned size);
+
     /** The number of store instructions in the SQ waiting to writeback. */
     int storesToWB;
 
@@ -59,3 +59,9 @@ class ElasticTrace(ProbeListenerObject):
     # Whether to trace virtual addresses for memory accesses
     traceVirtAddr = Param.Bool(False, "Set to true if virtual addresses are " \
                                 "to be traced.")
+    # Write the data dependency trace in a compact binary record format
+    # from a background thread, which also compresses it
+    binaryFormat = Param.Bool(False, "Set to true to write the data "
+                              "dependency trace in the binary record format")
+    ringSize = Param.Unsigned(1 << 20, "Words of binary records buffered "
+                              "for the writer thread")
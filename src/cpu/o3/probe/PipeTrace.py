@@ -0,0 +1,46 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+from m5.objects.Probe import *
+
+class PipeTrace(ProbeListenerObject):
+    type = 'PipeTrace'
+    cxx_class = 'gem5::o3::PipeTrace'
+    cxx_header = 'cpu/o3/probe/pipe_trace.hh'
+
+    # The trace is created in the output directory, prefixed with the
+    # name of the probe listener. It is read by util/o3-pipeview.py.
+    traceFile = Param.String("pipetrace.bin", "Binary pipeline trace "
+                             "file name")
+    blockRecords = Param.Unsigned(4096, "Number of instructions in each "
+                                  "indexed block of the trace")
+    # Committed stores are recorded once they write back, which keeps the
+    # instructions committed after them alive until then
+    maxPendingStores = Param.Unsigned(256, "Number of instructions which "
+                                      "may wait for a committed store to "
+                                      "write back before it is recorded "
+                                      "without its store completion")
@@ -37,6 +37,9 @@
 
 #include "cpu/o3/probe/elastic_trace.hh"
 
+#include <chrono>
+#include <cstring>
+
 #include "base/callback.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
@@ -59,6 +62,9 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
        depWindowSize(params.depWindowSize),
        dataTraceStream(nullptr),
        instTraceStream(nullptr),
+       binaryFile(nullptr),
+       firstWinLeft(params.depWindowSize),
+       numFilteredSinceWrite(0),
        startTraceInst(params.startTraceInst),
        allProbesReg(false),
        traceVirtAddr(params.traceVirtAddr),
@@ -83,19 +89,29 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
                                             params.instFetchTraceFile);
     instTraceStream = new ProtoOutputStream(filename);
     filename = simout.resolve(name() + "." + params.dataDepTraceFile);
-    dataTraceStream = new ProtoOutputStream(filename);
     // Create a protobuf message for the header and write it to the stream
     ProtoMessage::PacketHeader inst_pkt_header;
     inst_pkt_header.set_obj_id(name());
     inst_pkt_header.set_tick_freq(sim_clock::Frequency);
     instTraceStream->write(inst_pkt_header);
-    // Create a protobuf message for the header and write it to
-    // the stream
-    ProtoMessage::InstDepRecordHeader data_rec_header;
-    data_rec_header.set_obj_id(name());
-    data_rec_header.set_tick_freq(sim_clock::Frequency);
-    data_rec_header.set_window_size(depWindowSize);
-    dataTraceStream->write(data_rec_header);
+    if (params.binaryFormat) {
+        ring.reset(new SpscRing<uint64_t>(params.ringSize));
+        // simout compresses the file if the name ends with .gz
+        binaryFile = simout.create(filename, true);
+        const elastic_trace::Header header{elastic_trace::Magic,
+            elastic_trace::Version, depWindowSize, sim_clock::Frequency};
+        binaryFile->stream()->write((const char *)&header, sizeof(header));
+        writer = std::thread([this]() { writeRecords(); });
+    } else {
+        dataTraceStream = new ProtoOutputStream(filename);
+        // Create a protobuf message for the header and write it to
+        // the stream
+        ProtoMessage::InstDepRecordHeader data_rec_header;
+        data_rec_header.set_obj_id(name());
+        data_rec_header.set_tick_freq(sim_clock::Frequency);
+        data_rec_header.set_window_size(depWindowSize);
+        dataTraceStream->write(data_rec_header);
+    }
     // Register a callback to flush trace records and close the output streams.
     registerExitCallback([this]() {  flushTraces(); });
 }
@@ -502,20 +518,13 @@ ElasticTrace::addDepTraceRecord(const DynInstConstPtr& head_inst,
     DPRINTF(ElasticTrace, "Added %s inst %lli to DepTrace.\n",
             (commit ? "committed" : "squashed"), new_record->instNum);
 
-    // To process the number of records specified by depWindowSize in the
-    // forward direction, the depTrace must have twice as many records
-    // to check for dependencies.
-    if (depTrace.size() == 2 * depWindowSize) {
-
+    // Dependencies are looked up at most depWindowSize records back, so
+    // once there are more records than that the oldest one is complete.
+    // Write it out and remove it from the depTrace right away rather
+    // than holding on to it.
+    if (depTrace.size() > depWindowSize) {
         DPRINTF(ElasticTrace, "Writing out trace...\n");
-
-        // Write out the records which have been processed to the trace
-        // and remove them from the depTrace.
-        writeDepTrace(depWindowSize);
-
-        // After the first window, writeDepTrace() must check for valid
-        // compDelay.
-        firstWin = false;
+        writeDepTrace(depTrace.size() - depWindowSize);
     }
 }
 
@@ -791,11 +800,8 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
     // Computational delay with respect to last completed dependency
     // List of physical register RAW dependencies - optional, repeated
     // Weight of a node equal to no. of filtered nodes before it - optional
-    uint16_t num_filtered_nodes = 0;
-    depTraceItr dep_trace_itr(depTrace.begin());
-    depTraceItr dep_trace_itr_start = dep_trace_itr;
     while (num_to_write > 0) {
-        TraceInfo* temp_ptr = *dep_trace_itr;
+        TraceInfo* temp_ptr = depTrace.front();
         assert(temp_ptr->type != Record::INVALID);
         // If no node dependends on a comp node then there is no reason to
         // track the comp node in the dependency graph. We filter out such
@@ -824,62 +830,147 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
             assert(temp_ptr->compDelay != -1);
             DPRINTFR(ElasticTrace, "\thas computational delay %lli\n",
                      temp_ptr->compDelay);
-
-            // Create a protobuf message for the dependency record
-            ProtoMessage::InstDepRecord dep_pkt;
-            dep_pkt.set_seq_num(temp_ptr->instNum);
-            dep_pkt.set_type(temp_ptr->type);
-            dep_pkt.set_pc(temp_ptr->pc);
-            if (temp_ptr->isLoad() || temp_ptr->isStore()) {
-                dep_pkt.set_flags(temp_ptr->reqFlags);
-                dep_pkt.set_p_addr(temp_ptr->physAddr);
-                // If tracing of virtual addresses is enabled, set the optional
-                // field for it
-                if (traceVirtAddr)
-                    dep_pkt.set_v_addr(temp_ptr->virtAddr);
-                dep_pkt.set_size(temp_ptr->size);
-            }
-            dep_pkt.set_comp_delay(temp_ptr->compDelay);
             if (temp_ptr->robDepList.empty()) {
                 DPRINTFR(ElasticTrace, "\thas no order (rob) dependencies\n");
             }
-            while (!temp_ptr->robDepList.empty()) {
+            for (InstSeqNum dep : temp_ptr->robDepList) {
                 DPRINTFR(ElasticTrace, "\thas order (rob) dependency on %lli\n",
-                         temp_ptr->robDepList.front());
-                dep_pkt.add_rob_dep(temp_ptr->robDepList.front());
-                temp_ptr->robDepList.pop_front();
+                         dep);
             }
             if (temp_ptr->physRegDepList.empty()) {
                 DPRINTFR(ElasticTrace, "\thas no register dependencies\n");
             }
-            while (!temp_ptr->physRegDepList.empty()) {
+            for (InstSeqNum dep : temp_ptr->physRegDepList) {
                 DPRINTFR(ElasticTrace, "\thas register dependency on %lli\n",
-                         temp_ptr->physRegDepList.front());
-                dep_pkt.add_reg_dep(temp_ptr->physRegDepList.front());
-                temp_ptr->physRegDepList.pop_front();
+                         dep);
             }
-            if (num_filtered_nodes != 0) {
-                // Set the weight of this node as the no. of filtered nodes
-                // between this node and the last node that we wrote to output
-                // stream. The weight will be used during replay to model ROB
-                // occupancy of filtered nodes.
-                dep_pkt.set_weight(num_filtered_nodes);
-                num_filtered_nodes = 0;
+            // The weight of this node is the no. of filtered nodes between
+            // this node and the last node that we wrote to output stream.
+            // The weight will be used during replay to model ROB occupancy
+            // of filtered nodes.
+            if (ring) {
+                writeBinaryRecord(temp_ptr, numFilteredSinceWrite);
+            } else {
+                // Create a protobuf message for the dependency record
+                ProtoMessage::InstDepRecord dep_pkt;
+                dep_pkt.set_seq_num(temp_ptr->instNum);
+                dep_pkt.set_type(temp_ptr->type);
+                dep_pkt.set_pc(temp_ptr->pc);
+                if (temp_ptr->isLoad() || temp_ptr->isStore()) {
+                    dep_pkt.set_flags(temp_ptr->reqFlags);
+                    dep_pkt.set_p_addr(temp_ptr->physAddr);
+                    // If tracing of virtual addresses is enabled, set the
+                    // optional field for it
+                    if (traceVirtAddr)
+                        dep_pkt.set_v_addr(temp_ptr->virtAddr);
+                    dep_pkt.set_size(temp_ptr->size);
+                }
+                dep_pkt.set_comp_delay(temp_ptr->compDelay);
+                for (InstSeqNum dep : temp_ptr->robDepList)
+                    dep_pkt.add_rob_dep(dep);
+                for (InstSeqNum dep : temp_ptr->physRegDepList)
+                    dep_pkt.add_reg_dep(dep);
+                if (numFilteredSinceWrite != 0)
+                    dep_pkt.set_weight(numFilteredSinceWrite);
+                // Write the message to the protobuf output stream
+                dataTraceStream->write(dep_pkt);
             }
-            // Write the message to the protobuf output stream
-            dataTraceStream->write(dep_pkt);
+            numFilteredSinceWrite = 0;
         } else {
             // Don't write the node to the trace but note that we have filtered
             // out a node.
             ++stats.numFilteredNodes;
-            ++num_filtered_nodes;
+            ++numFilteredSinceWrite;
         }
-        dep_trace_itr++;
+        // Records of the first window without a dependency carry their
+        // absolute tick as computational delay
+        if (firstWin && --firstWinLeft == 0)
+            firstWin = false;
+        depTrace.pop_front();
         traceInfoMap.erase(temp_ptr->instNum);
         delete temp_ptr;
         num_to_write--;
     }
-    depTrace.erase(dep_trace_itr_start, dep_trace_itr);
+}
+
+void
+ElasticTrace::writeBinaryRecord(const TraceInfo *record, uint16_t weight)
+{
+    panic_if(record->robDepList.size() + record->physRegDepList.size() >
+             UINT8_MAX, "Too many dependencies of [sn:%lli] for the binary "
+             "elastic trace format.\n", record->instNum);
+
+    elastic_trace::Record rec = {};
+    rec.seqNum = record->instNum;
+    rec.pc = record->pc;
+    rec.compDelay = record->compDelay;
+    rec.weight = weight;
+    rec.type = record->type;
+    rec.numRobDeps = record->robDepList.size();
+    rec.numRegDeps = record->physRegDepList.size();
+    rec.hasAccess = record->isLoad() || record->isStore();
+
+    uint64_t words[sizeof(rec) / sizeof(uint64_t)];
+    std::memcpy(words, &rec, sizeof(rec));
+    for (uint64_t word : words)
+        pushWord(word);
+
+    if (rec.hasAccess) {
+        elastic_trace::MemAccess access = {};
+        access.physAddr = record->physAddr;
+        // Virtual addresses are only recorded when requested
+        access.virtAddr = traceVirtAddr ? record->virtAddr : 0;
+        access.flags = record->reqFlags;
+        access.size = record->size;
+
+        uint64_t access_words[sizeof(access) / sizeof(uint64_t)];
+        std::memcpy(access_words, &access, sizeof(access));
+        for (uint64_t word : access_words)
+            pushWord(word);
+    }
+
+    // Dependencies are stored as distances to the record, two per word
+    uint64_t word = 0;
+    unsigned num_deps = 0;
+    auto add_dep = [&](InstSeqNum dep) {
+        InstSeqNum dist = record->instNum - dep;
+        panic_if(dist > UINT32_MAX, "Dependency of [sn:%lli] on [sn:%lli] "
+                 "is too far for the binary elastic trace format.\n",
+                 record->instNum, dep);
+        word |= dist << (32 * (num_deps++ % 2));
+        if (num_deps % 2 == 0) {
+            pushWord(word);
+            word = 0;
+        }
+    };
+    for (InstSeqNum dep : record->robDepList)
+        add_dep(dep);
+    for (InstSeqNum dep : record->physRegDepList)
+        add_dep(dep);
+    if (num_deps % 2)
+        pushWord(word);
+}
+
+void
+ElasticTrace::writeRecords()
+{
+    std::ostream &os = *binaryFile->stream();
+    while (true) {
+        // Check before looking at the ring, so nothing added before
+        // flushTraces() is left behind.
+        const bool last = stopping.load(std::memory_order_acquire);
+
+        const uint64_t *first;
+        size_t n = ring->peek(first);
+        if (n) {
+            os.write((const char *)first, n * sizeof(uint64_t));
+            ring->pop(n);
+        } else if (last) {
+            break;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
 }
 
 ElasticTrace::ElasticTraceStats::ElasticTraceStats(statistics::Group *parent)
@@ -920,8 +1011,16 @@ ElasticTrace::flushTraces()
 {
     // Write to trace all records in the depTrace.
     writeDepTrace(depTrace.size());
+    if (ring) {
+        // Let the writer drain the ring before closing the file
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+        simout.close(binaryFile);
+        binaryFile = nullptr;
+    }
     // Delete the stream objects
-    delete dataTraceStream;
+    if (dataTraceStream)
+        delete dataTraceStream;
     delete instTraceStream;
 }
 
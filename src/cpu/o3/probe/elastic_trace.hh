@@ -46,13 +46,22 @@
 #ifndef __CPU_O3_PROBE_ELASTIC_TRACE_HH__
 #define __CPU_O3_PROBE_ELASTIC_TRACE_HH__
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "base/pool_allocator.hh"
+#include "base/spsc_ring.hh"
 #include "base/statistics.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/reg_class.hh"
+#include "cpu/trace/elastic_trace_format.hh"
 #include "mem/request.hh"
 #include "params/ElasticTrace.hh"
 #include "proto/inst_dep_record.pb.h"
@@ -64,6 +73,8 @@
 namespace gem5
 {
 
+class OutputStream;
+
 namespace o3
 {
 
@@ -85,8 +96,11 @@ class CPU;
  * trace is processed in chunks to evaluate order dependencies and computational
  * delay in case an instruction does not have any register dependencies. By this
  * we achieve a simpler algorithm during replay because every record in the
- * trace can be hooked onto a record in its past. The trace is written out as
- * a protobuf format output file.
+ * trace can be hooked onto a record in its past. A record is written out as
+ * soon as depWindowSize younger records were added, so only a window of
+ * records is held at any time. The trace is written out as a protobuf
+ * format output file, or with binaryFormat, in the compact records of
+ * elastic_trace_format.hh, which a writer thread compresses and writes.
  *
  * The output trace can be read in and played back by the TraceCPU.
  */
@@ -219,6 +233,21 @@ class ElasticTrace : public ProbeListenerObject
           : executeTick(MaxTick),
             toCommitTick(MaxTick)
         { }
+
+        /** One is created for every instruction, so recycle them. */
+        static void *
+        operator new(std::size_t size)
+        {
+            assert(size == sizeof(InstExecInfo));
+            return PoolAllocator<InstExecInfo>().allocate(1);
+        }
+
+        static void
+        operator delete(void *p)
+        {
+            PoolAllocator<InstExecInfo>().deallocate(
+                static_cast<InstExecInfo *>(p), 1);
+        }
     };
 
     /**
@@ -272,9 +301,9 @@ class ElasticTrace : public ProbeListenerObject
         /* If instruction was committed, as against squashed. */
         bool commit;
         /* List of order dependencies. */
-        std::list<InstSeqNum> robDepList;
+        std::vector<InstSeqNum> robDepList;
         /* List of physical register RAW dependencies. */
-        std::list<InstSeqNum> physRegDepList;
+        std::vector<InstSeqNum> physRegDepList;
         /**
          * Computational delay after the last dependent inst. completed.
          * A value of -1 which means instruction has no dependencies.
@@ -296,6 +325,19 @@ class ElasticTrace : public ProbeListenerObject
         TraceInfo()
           : type(Record::INVALID)
         { }
+        /** One is created for every instruction, so recycle them. */
+        static void *
+        operator new(std::size_t size)
+        {
+            assert(size == sizeof(TraceInfo));
+            return PoolAllocator<TraceInfo>().allocate(1);
+        }
+        static void
+        operator delete(void *p)
+        {
+            PoolAllocator<TraceInfo>().deallocate(
+                static_cast<TraceInfo *>(p), 1);
+        }
         /** Is the record a load */
         bool isLoad() const { return (type == Record::LOAD); }
         /** Is the record a store */
@@ -326,7 +368,7 @@ class ElasticTrace : public ProbeListenerObject
      * i.e. adding children as records are read from the trace in an efficient
      * manner.
      */
-    std::vector<TraceInfo*> depTrace;
+    std::deque<TraceInfo*> depTrace;
 
     /**
      * Map where the instruction sequence number is mapped to the pointer to
@@ -335,7 +377,7 @@ class ElasticTrace : public ProbeListenerObject
     std::unordered_map<InstSeqNum, TraceInfo*> traceInfoMap;
 
     /** Typedef of iterator to the instruction dependency trace. */
-    typedef typename std::vector<TraceInfo*>::iterator depTraceItr;
+    typedef typename std::deque<TraceInfo*>::iterator depTraceItr;
 
     /** Typedef of the reverse iterator to the instruction dependency trace. */
     typedef typename std::reverse_iterator<depTraceItr> depTraceRevItr;
@@ -354,6 +396,41 @@ class ElasticTrace : public ProbeListenerObject
     /** Protobuf output stream for instruction fetch trace. */
     ProtoOutputStream* instTraceStream;
 
+    /**
+     * Ring of the words of the binary records and the file the writer
+     * thread drains it to, used instead of dataTraceStream
+     */
+    std::unique_ptr<SpscRing<uint64_t>> ring;
+    OutputStream *binaryFile;
+
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+
+    /** Number of records of the first window that are still to write */
+    uint32_t firstWinLeft;
+
+    /** Nodes filtered out since the last record that was written. */
+    uint16_t numFilteredSinceWrite;
+
+    /** Body of the writer thread of the binary format. */
+    void writeRecords();
+
+    /** Add a word of a binary record to the ring. */
+    void
+    pushWord(uint64_t word)
+    {
+        while (!ring->push(word))
+            std::this_thread::yield();
+    }
+
+    /**
+     * Add a record to the binary trace.
+     *
+     * @param record The record to write
+     * @param weight Number of records filtered out before it
+     */
+    void writeBinaryRecord(const TraceInfo *record, uint16_t weight);
+
     /** Number of instructions after which to enable tracing. */
     const InstSeqNum startTraceInst;
 
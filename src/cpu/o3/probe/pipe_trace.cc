@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/probe/pipe_trace.hh"
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst.hh"
+#include "sim/core.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+PipeTrace::PipeTrace(const PipeTraceParams &params)
+    : ProbeListenerObject(params),
+      cpu(dynamic_cast<CPU *>(params.manager)),
+      traceStream(nullptr),
+      blockRecords(params.blockRecords),
+      maxPending(params.maxPendingStores),
+      offset(0),
+      flushed(false)
+{
+    fatal_if(!cpu, "Manager of %s is not of type O3CPU and thus does not "
+             "support pipeline tracing.\n", name());
+    fatal_if(blockRecords == 0, "%s: blockRecords must be non-zero.\n",
+             name());
+    fatal_if(params.traceFile == "", "Assign the pipeline trace file "
+             "name to traceFile");
+
+    // The stages only record their ticks when somebody looks at them
+    cpu->addPipeTracer();
+
+    // The viewer seeks in the trace, so it is never compressed
+    traceStream = simout.create(name() + "." + params.traceFile, true,
+                                true);
+    const pipe_trace::Header header{pipe_trace::Magic, pipe_trace::Version,
+        0, sim_clock::Frequency};
+    traceStream->stream()->write((const char *)&header, sizeof(header));
+    offset = sizeof(header);
+
+    records.reserve(blockRecords);
+    blockHeader = pipe_trace::BlockHeader();
+
+    registerExitCallback([this]() { flushTrace(); });
+}
+
+void
+PipeTrace::regProbeListeners()
+{
+    typedef ProbeListenerArg<PipeTrace, DynInstPtr> DynInstListener;
+    listeners.push_back(new DynInstListener(this, "Commit",
+                &PipeTrace::traceCommit));
+    listeners.push_back(new DynInstListener(this, "Squash",
+                &PipeTrace::traceSquash));
+}
+
+void
+PipeTrace::traceCommit(const DynInstPtr &inst)
+{
+    queueInst(inst);
+}
+
+void
+PipeTrace::traceSquash(const DynInstPtr &inst)
+{
+    queueInst(inst);
+}
+
+void
+PipeTrace::queueInst(const DynInstPtr &inst)
+{
+    // Instructions fetched before the tracer started have no ticks
+    if (flushed || inst->fetchTick == -1)
+        return;
+
+    pending.push_back(inst);
+    while (!pending.empty()) {
+        const DynInstPtr &head = pending.front();
+        bool waiting = head->isCommitted() && head->isStore() &&
+            head->storeTick == -1;
+        if (waiting && pending.size() <= maxPending)
+            break;
+        record(head);
+        pending.pop_front();
+    }
+}
+
+void
+PipeTrace::record(const DynInstPtr &inst)
+{
+    const PCStateBase &pc = inst->pcState();
+    const std::string &disasm = inst->staticInst->disassemble(
+        pc.instAddr());
+
+    auto it = stringIds.find(disasm);
+    if (it == stringIds.end()) {
+        it = stringIds.emplace(disasm, strings.size()).first;
+        strings.push_back(disasm);
+        blockHeader.stringBytes += sizeof(uint16_t) +
+            std::min<size_t>(disasm.size(),
+                             std::numeric_limits<uint16_t>::max());
+    }
+
+    pipe_trace::Record rec{};
+    rec.seqNum = inst->seqNum;
+    rec.pc = pc.instAddr();
+    rec.fetchTick = inst->fetchTick;
+    rec.disasm = it->second;
+    rec.upc = pc.microPC();
+    rec.flags = (inst->isCommitted() ? pipe_trace::Committed : 0) |
+        (inst->isStore() ? pipe_trace::Store : 0);
+    rec.stageTicks[pipe_trace::Decode] = inst->decodeTick;
+    rec.stageTicks[pipe_trace::Rename] = inst->renameTick;
+    rec.stageTicks[pipe_trace::Dispatch] = inst->dispatchTick;
+    rec.stageTicks[pipe_trace::Issue] = inst->issueTick;
+    rec.stageTicks[pipe_trace::Complete] = inst->completeTick;
+    rec.stageTicks[pipe_trace::Commit] = inst->commitTick;
+    rec.stageTicks[pipe_trace::StoreComplete] = inst->storeTick;
+
+    if (records.empty()) {
+        blockHeader.minFetchTick = blockHeader.maxFetchTick = rec.fetchTick;
+        blockHeader.minSeqNum = blockHeader.maxSeqNum = rec.seqNum;
+    } else {
+        blockHeader.minFetchTick = std::min(blockHeader.minFetchTick,
+                                            rec.fetchTick);
+        blockHeader.maxFetchTick = std::max(blockHeader.maxFetchTick,
+                                            rec.fetchTick);
+        blockHeader.minSeqNum = std::min(blockHeader.minSeqNum, rec.seqNum);
+        blockHeader.maxSeqNum = std::max(blockHeader.maxSeqNum, rec.seqNum);
+    }
+    records.push_back(rec);
+
+    if (records.size() == blockRecords)
+        writeBlock();
+}
+
+void
+PipeTrace::writeBlock()
+{
+    if (records.empty())
+        return;
+
+    std::ostream *os = traceStream->stream();
+    blockHeader.numRecords = records.size();
+    blockHeader.numStrings = strings.size();
+    index.push_back({offset, blockHeader.minFetchTick,
+        blockHeader.maxFetchTick, blockHeader.minSeqNum,
+        blockHeader.maxSeqNum});
+
+    os->write((const char *)&blockHeader, sizeof(blockHeader));
+    for (const std::string &str : strings) {
+        uint16_t len = std::min<size_t>(str.size(),
+                                        std::numeric_limits<uint16_t>::max());
+        os->write((const char *)&len, sizeof(len));
+        os->write(str.data(), len);
+    }
+    os->write((const char *)records.data(),
+              records.size() * sizeof(pipe_trace::Record));
+
+    offset += sizeof(blockHeader) + blockHeader.stringBytes +
+        records.size() * sizeof(pipe_trace::Record);
+
+    records.clear();
+    strings.clear();
+    stringIds.clear();
+    blockHeader = pipe_trace::BlockHeader();
+}
+
+void
+PipeTrace::flushTrace()
+{
+    if (flushed)
+        return;
+    flushed = true;
+
+    for (const DynInstPtr &inst : pending)
+        record(inst);
+    pending.clear();
+    writeBlock();
+
+    std::ostream *os = traceStream->stream();
+    os->write((const char *)index.data(),
+              index.size() * sizeof(pipe_trace::IndexEntry));
+    const pipe_trace::Trailer trailer{index.size(), pipe_trace::IndexMagic};
+    os->write((const char *)&trailer, sizeof(trailer));
+    simout.close(traceStream);
+    traceStream = nullptr;
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file This file describes a probe listener which records the tick at
+ * which every instruction the O3 CPU commits or squashes at the head of
+ * the ROB went through each stage of the pipeline, and writes them as
+ * an indexed binary trace (see pipe_trace_format.hh) for the pipeline
+ * viewer. Unlike the O3PipeView debug flag, it does not format any text
+ * while simulating and works in fast builds.
+ */
+
+#ifndef __CPU_O3_PROBE_PIPE_TRACE_HH__
+#define __CPU_O3_PROBE_PIPE_TRACE_HH__
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/probe/pipe_trace_format.hh"
+#include "params/PipeTrace.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+class OutputStream;
+
+namespace o3
+{
+
+class CPU;
+
+class PipeTrace : public ProbeListenerObject
+{
+  public:
+    PipeTrace(const PipeTraceParams &params);
+
+    /** Register the probe listeners. */
+    void regProbeListeners() override;
+
+    /** Write the remaining records and the index of the blocks. */
+    void flushTrace();
+
+  private:
+    void traceCommit(const DynInstPtr &inst);
+    void traceSquash(const DynInstPtr &inst);
+
+    /**
+     * Queue an instruction and record the ones at the head of the queue
+     * which are done. Committed stores are only done once they have
+     * written back, or when too many instructions are waiting for them.
+     */
+    void queueInst(const DynInstPtr &inst);
+
+    /** Add the record of an instruction to the current block. */
+    void record(const DynInstPtr &inst);
+
+    /** Write the current block to the trace. */
+    void writeBlock();
+
+    CPU *cpu;
+
+    OutputStream *traceStream;
+
+    const unsigned blockRecords;
+
+    const unsigned maxPending;
+
+    /** Instructions left to record, in the order they left the ROB */
+    std::deque<DynInstPtr> pending;
+
+    /** Records and disassembly strings of the current block */
+    pipe_trace::BlockHeader blockHeader;
+    std::vector<pipe_trace::Record> records;
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIds;
+
+    std::vector<pipe_trace::IndexEntry> index;
+
+    /** Offset in the trace at which the next block starts */
+    uint64_t offset;
+
+    bool flushed;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_PROBE_PIPE_TRACE_HH__
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Binary format of the pipeline traces written by the o3 PipeTrace
+ * probe and read by util/o3-pipeview.py.
+ *
+ * A trace starts with a Header and is followed by blocks of records.
+ * Each block has a BlockHeader, then numStrings disassembly strings,
+ * each a 16 bit length followed by the characters, and then numRecords
+ * Records which refer to the strings by their index in the block. The
+ * trace ends with an IndexEntry per block and a Trailer, so that a
+ * reader can seek straight to the blocks of a tick or instruction
+ * range. All the fields are in host byte order.
+ */
+
+#ifndef __CPU_O3_PROBE_PIPE_TRACE_FORMAT_HH__
+#define __CPU_O3_PROBE_PIPE_TRACE_FORMAT_HH__
+
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace pipe_trace
+{
+
+constexpr uint64_t Magic = 0x45504950354d4547ULL; // "GEM5PIPE"
+constexpr uint64_t IndexMagic = 0x58444950354d4547ULL; // "GEM5PIDX"
+constexpr uint32_t Version = 1;
+
+struct Header
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t tickFrequency;
+};
+
+struct BlockHeader
+{
+    uint32_t numRecords;
+    uint32_t numStrings;
+    /** Size of the strings in bytes */
+    uint64_t stringBytes;
+    uint64_t minFetchTick;
+    uint64_t maxFetchTick;
+    uint64_t minSeqNum;
+    uint64_t maxSeqNum;
+};
+
+enum RecordFlags : uint16_t
+{
+    Committed = 0x1,
+    Store = 0x2,
+};
+
+/** Stages of an instruction, after the fetch */
+enum Stage
+{
+    Decode,
+    Rename,
+    Dispatch,
+    Issue,
+    Complete,
+    Commit,
+    StoreComplete,
+    NumStages
+};
+
+struct Record
+{
+    uint64_t seqNum;
+    uint64_t pc;
+    uint64_t fetchTick;
+    /** Index of the disassembly in the strings of the block */
+    uint32_t disasm;
+    uint16_t upc;
+    uint16_t flags;
+    /** Ticks after the fetch of each Stage, -1 if it never happened */
+    int32_t stageTicks[NumStages];
+    uint32_t reserved;
+};
+
+struct IndexEntry
+{
+    /** File offset of the BlockHeader */
+    uint64_t offset;
+    uint64_t minFetchTick;
+    uint64_t maxFetchTick;
+    uint64_t minSeqNum;
+    uint64_t maxSeqNum;
+};
+
+struct Trailer
+{
+    uint64_t numBlocks;
+    uint64_t magic;
+};
+
+static_assert(sizeof(Header) == 24 && sizeof(BlockHeader) == 48 &&
+              sizeof(Record) == 64 && sizeof(IndexEntry) == 40 &&
+              sizeof(Trailer) == 16, "Records should be packed");
+
+} // namespace pipe_trace
+} // namespace gem5
+
+#endif // __CPU_O3_PROBE_PIPE_TRACE_FORMAT_HH__
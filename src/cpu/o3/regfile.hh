@@ -194,6 +194,37 @@ class PhysRegFile
         }
     }
 
+    /**
+     * Typed accessors for integer and floating point registers, for
+     * callers which know the register class at compile time. They skip
+     * the dispatch on the class of a PhysRegId.
+     */
+    template <RegClassType Cls>
+    RegVal
+    getReg(RegIndex idx) const
+    {
+        static_assert(Cls == IntRegClass || Cls == FloatRegClass,
+                "Only integer and float registers have a typed accessor.");
+        const RegFile &reg_file =
+            Cls == IntRegClass ? intRegFile : floatRegFile;
+        RegVal val = reg_file.reg(idx);
+        DPRINTF(IEW, "RegFile: Access to %s register %i has data %#x\n",
+                Cls == IntRegClass ? "int" : "float", idx, val);
+        return val;
+    }
+
+    template <RegClassType Cls>
+    void
+    setReg(RegIndex idx, RegVal val)
+    {
+        static_assert(Cls == IntRegClass || Cls == FloatRegClass,
+                "Only integer and float registers have a typed accessor.");
+        RegFile &reg_file = Cls == IntRegClass ? intRegFile : floatRegFile;
+        reg_file.reg(idx) = val;
+        DPRINTF(IEW, "RegFile: Setting %s register %i to %#x\n",
+                Cls == IntRegClass ? "int" : "float", idx, val);
+    }
+
     void
     getReg(PhysRegIdPtr phys_reg, void *val) const
     {
@@ -48,7 +48,6 @@
 #include "cpu/o3/limits.hh"
 #include "cpu/reg_class.hh"
 #include "debug/Activity.hh"
-#include "debug/O3PipeView.hh"
 #include "debug/Rename.hh"
 #include "params/BaseO3CPU.hh"
 
@@ -64,6 +63,7 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
       decodeToRenameDelay(params.decodeToRenameDelay),
       commitToRenameDelay(params.commitToRenameDelay),
       renameWidth(params.renameWidth),
+      numCheckpoints(params.numRenameCheckpoints),
       numThreads(params.numThreads),
       stats(_cpu)
 {
@@ -122,6 +122,11 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
                "Number of times rename has blocked due to SQ full"),
       ADD_STAT(fullRegistersEvents, statistics::units::Count::get(),
                "Number of times there has been no free registers"),
+      ADD_STAT(fullCheckpointsEvents, statistics::units::Count::get(),
+               "Number of times there has been no free checkpoint for a "
+               "branch"),
+      ADD_STAT(checkpointRestores, statistics::units::Count::get(),
+               "Number of squashes that restored a rename map checkpoint"),
       ADD_STAT(renamedOperands, statistics::units::Count::get(),
                "Number of destination operands rename has renamed"),
       ADD_STAT(lookups, statistics::units::Count::get(),
@@ -242,6 +247,7 @@ Rename::clearStates(ThreadID tid)
     storesInProgress[tid] = 0;
 
     serializeOnNextInst[tid] = false;
+    checkpoints[tid].clear();
 }
 
 void
@@ -272,6 +278,7 @@ Rename::resetStage()
         storesInProgress[tid] = 0;
 
         serializeOnNextInst[tid] = false;
+        checkpoints[tid].clear();
     }
 }
 
@@ -307,6 +314,7 @@ Rename::isDrained() const
     for (ThreadID tid = 0; tid < numThreads; tid++) {
         if (instsInProgress[tid] != 0 ||
             !historyBuffer[tid].empty() ||
+            !checkpoints[tid].empty() ||
             !skidBuffer[tid].empty() ||
             !insts[tid].empty() ||
             (renameStatus[tid] != Idle && renameStatus[tid] != Running))
@@ -326,6 +334,7 @@ Rename::drainSanityCheck() const
 {
     for (ThreadID tid = 0; tid < numThreads; tid++) {
         assert(historyBuffer[tid].empty());
+        assert(checkpoints[tid].empty());
         assert(insts[tid].empty());
         assert(skidBuffer[tid].empty());
         assert(instsInProgress[tid] == 0);
@@ -667,6 +676,18 @@ Rename::renameInsts(ThreadID tid)
             break;
         }
 
+        // Likewise, branches need a free checkpoint.
+        if (needsCheckpoint(inst) &&
+            checkpoints[tid].size() >= numCheckpoints) {
+            DPRINTF(Rename,
+                    "Blocking due to lack of free checkpoints.\n");
+            blockThisCycle = true;
+            insts_to_rename.push_front(inst);
+            ++stats.fullCheckpointsEvents;
+
+            break;
+        }
+
         // Handle serializeAfter/serializeBefore instructions.
         // serializeAfter marks the next instruction as serializeBefore.
         // serializeBefore makes the instruction wait in rename until the ROB
@@ -711,6 +732,12 @@ Rename::renameInsts(ThreadID tid)
 
         renameDestRegs(inst, inst->threadNumber);
 
+        if (needsCheckpoint(inst)) {
+            DPRINTF(Rename, "[tid:%i] Taking a checkpoint at [sn:%llu].\n",
+                    tid, inst->seqNum);
+            checkpoints[tid].push_back({inst->seqNum, *renameMap[tid]});
+        }
+
         if (inst->isAtomic() || inst->isStore()) {
             storesInProgress[tid]++;
         } else if (inst->isLoad()) {
@@ -793,11 +820,9 @@ Rename::sortInsts()
     for (int i = 0; i < insts_from_decode; ++i) {
         const DynInstPtr &inst = fromDecode->insts[i];
         insts[inst->threadNumber].push_back(inst);
-#if TRACING_ON
-        if (debug::O3PipeView) {
+        if (cpu->tracingPipeline()) {
             inst->renameTick = curTick() - inst->fetchTick;
         }
-#endif
     }
 }
 
@@ -908,9 +933,26 @@ Rename::unblock(ThreadID tid)
     return false;
 }
 
+bool
+Rename::needsCheckpoint(const DynInstPtr &inst) const
+{
+    return numCheckpoints && (inst->isCondCtrl() || inst->isIndirectCtrl());
+}
+
 void
 Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
+    // Drop the checkpoints of the squashed branches.  If the squash goes
+    // back to a branch with a checkpoint, its map is restored at once
+    // instead of undoing each of the younger mappings.
+    auto &thread_checkpoints = checkpoints[tid];
+    while (!thread_checkpoints.empty() &&
+           thread_checkpoints.back().instSeqNum > squashed_seq_num) {
+        thread_checkpoints.pop_back();
+    }
+    bool restore = !thread_checkpoints.empty() &&
+        thread_checkpoints.back().instSeqNum == squashed_seq_num;
+
     auto hb_it = historyBuffer[tid].begin();
 
     // After a syscall squashes everything, the history buffer may be empty
@@ -935,7 +977,8 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         if (hb_it->newPhysReg != hb_it->prevPhysReg) {
             // Tell the rename map to set the architected register to the
             // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            if (!restore)
+                renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
 
             // Put the renamed physical register back on the free list.
             freeList->addReg(hb_it->newPhysReg);
@@ -951,6 +994,11 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 
         ++stats.undoneMaps;
     }
+
+    if (restore) {
+        *renameMap[tid] = thread_checkpoints.back().map;
+        ++stats.checkpointRestores;
+    }
 }
 
 void
@@ -960,6 +1008,12 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
             "history buffer %u (size=%i), until [sn:%llu].\n",
             tid, tid, historyBuffer[tid].size(), inst_seq_num);
 
+    // The checkpoints of committed branches are no longer needed.
+    while (!checkpoints[tid].empty() &&
+           checkpoints[tid].front().instSeqNum <= inst_seq_num) {
+        checkpoints[tid].pop_front();
+    }
+
     auto hb_it = historyBuffer[tid].end();
 
     --hb_it;
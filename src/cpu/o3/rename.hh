@@ -42,6 +42,7 @@
 #ifndef __CPU_O3_RENAME_HH__
 #define __CPU_O3_RENAME_HH__
 
+#include <deque>
 #include <list>
 #include <utility>
 
@@ -52,6 +53,7 @@
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/rename_map.hh"
 #include "cpu/timebuf.hh"
 #include "sim/probe/probe.hh"
 
@@ -320,6 +322,22 @@ class Rename
      */
     std::list<RenameHistory> historyBuffer[MaxThreads];
 
+    /** Copy of the rename map taken right after a branch renamed. */
+    struct RenameCheckpoint
+    {
+        InstSeqNum instSeqNum;
+        UnifiedRenameMap map;
+    };
+
+    /** Per-thread checkpoints of the in-flight branches, oldest first.
+     *  A squash back to one of those branches restores its map in one
+     *  go instead of undoing the renames one by one.
+     */
+    std::deque<RenameCheckpoint> checkpoints[MaxThreads];
+
+    /** Returns if an instruction takes a rename map checkpoint. */
+    bool needsCheckpoint(const DynInstPtr &inst) const;
+
     /** Pointer to CPU. */
     CPU *cpu;
 
@@ -437,6 +455,9 @@ class Rename
     /** Rename width, in instructions. */
     unsigned renameWidth;
 
+    /** Maximum number of checkpoints per thread. */
+    const unsigned numCheckpoints;
+
     /** The index of the instruction in the time buffer to IEW that rename is
      * currently using.
      */
@@ -513,6 +534,12 @@ class Rename
         /** Stat for total number of times that rename runs out of free
          *  registers to use to rename. */
         statistics::Scalar fullRegistersEvents;
+        /** Stat for total number of times that rename runs out of
+         *  checkpoints to take at branches. */
+        statistics::Scalar fullCheckpointsEvents;
+        /** Stat for total number of squashes that restored a
+         *  checkpoint. */
+        statistics::Scalar checkpointRestores;
         /** Stat for total number of renamed destination registers. */
         statistics::Scalar renamedOperands;
         /** Stat for total number of source register rename lookups. */
@@ -65,7 +65,7 @@ namespace o3
  * must be taken when using this interface (such as squashing all
  * in-flight instructions when doing a write to this interface).
  */
-class ThreadContext : public gem5::ThreadContext
+class ThreadContext final : public gem5::ThreadContext
 {
   public:
    /** Pointer to the CPU. */
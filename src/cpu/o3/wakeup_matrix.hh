@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_WAKEUP_MATRIX_HH__
+#define __CPU_O3_WAKEUP_MATRIX_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "cpu/o3/comm.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/** Bit matrix that maintains the dependencies between producing
+ * instructions and consuming instructions.  It offers the same
+ * interface as DependencyGraph, but instead of a linked list of
+ * dependents, each physical register has a row with one bit for every
+ * instruction queue slot.  An instruction gets a slot the first time
+ * it is made dependent on a register and gives it back once all of
+ * its dependences have been woken up or removed.  Waking up the
+ * dependents of a register then only scans the words of its row, and
+ * no memory is allocated while instructions move through the IQ.
+*/
+template <class DynInstPtr>
+class WakeupMatrix
+{
+  public:
+    /** Default construction.  Must call resize() prior to use. */
+    WakeupMatrix() = default;
+
+    /** Resize the matrix to have num_regs registers and num_slots
+     *  instruction slots. */
+    void resize(int num_regs, int num_slots);
+
+    /** Clears all of the rows and slots. */
+    void reset();
+
+    /** Inserts an instruction to be dependent on the given index. */
+    void insert(RegIndex idx, const DynInstPtr &new_inst);
+
+    /** Sets the producing instruction of a given register. */
+    void setInst(RegIndex idx, const DynInstPtr &new_inst)
+    { producers[idx] = new_inst; }
+
+    /** Clears the producing instruction. */
+    void clearInst(RegIndex idx) { producers[idx] = nullptr; }
+
+    /** Removes an instruction from a single row. */
+    void remove(RegIndex idx, const DynInstPtr &inst_to_remove);
+
+    /** Removes and returns the dependent in the lowest slot of a
+     *  specific register. */
+    DynInstPtr pop(RegIndex idx);
+
+    /** Checks if the entire matrix is empty. */
+    bool empty() const { return numDeps == 0; }
+
+    /** Checks if there are any dependents on a specific register. */
+    bool empty(RegIndex idx) const;
+
+    /** Debugging function to dump out the matrix. */
+    void dump();
+
+  private:
+    struct Slot
+    {
+        DynInstPtr inst;
+        /** Number of set bits, and duplicates, of this slot. */
+        int numDeps = 0;
+    };
+
+    uint64_t *row(RegIndex idx) { return &bits[idx * wordsPerRow]; }
+    const uint64_t *
+    row(RegIndex idx) const
+    {
+        return &bits[idx * wordsPerRow];
+    }
+
+    static uint64_t
+    dupKey(RegIndex idx, int slot)
+    {
+        return (uint64_t(idx) << 32) | unsigned(slot);
+    }
+
+    /** Drops one dependence from a slot, freeing it at the last one. */
+    void release(int slot);
+
+    /** One row of wordsPerRow words per register. */
+    std::vector<uint64_t> bits;
+
+    /** The producing instruction of each register. */
+    std::vector<DynInstPtr> producers;
+
+    std::vector<Slot> slots;
+
+    /** Slots without an instruction. */
+    std::vector<int> freeSlots;
+
+    /** Extra dependences of an instruction that sources the same
+     *  register more than once, keyed by register and slot. */
+    std::unordered_map<uint64_t, int> duplicates;
+
+    int numRegs = 0;
+    int wordsPerRow = 0;
+
+    /** Number of dependences in the matrix. */
+    uint64_t numDeps = 0;
+};
+
+template <class DynInstPtr>
+void
+WakeupMatrix<DynInstPtr>::resize(int num_regs, int num_slots)
+{
+    numRegs = num_regs;
+    wordsPerRow = (num_slots + 63) / 64;
+    bits.assign(size_t(numRegs) * wordsPerRow, 0);
+    producers.resize(numRegs);
+    slots.resize(num_slots);
+    reset();
+}
+
+template <class DynInstPtr>
+void
+WakeupMatrix<DynInstPtr>::reset()
+{
+    std::fill(bits.begin(), bits.end(), 0);
+    std::fill(producers.begin(), producers.end(), nullptr);
+    freeSlots.clear();
+    for (int i = slots.size() - 1; i >= 0; --i) {
+        if (slots[i].inst)
+            slots[i].inst->iqSlot = -1;
+        slots[i].inst = nullptr;
+        slots[i].numDeps = 0;
+        freeSlots.push_back(i);
+    }
+    duplicates.clear();
+    numDeps = 0;
+}
+
+template <class DynInstPtr>
+void
+WakeupMatrix<DynInstPtr>::insert(RegIndex idx, const DynInstPtr &new_inst)
+{
+    int slot = new_inst->iqSlot;
+    if (slot < 0) {
+        panic_if(freeSlots.empty(), "No free slot in the wakeup matrix "
+                 "for [sn:%lli].", new_inst->seqNum);
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        slots[slot].inst = new_inst;
+        new_inst->iqSlot = slot;
+    }
+    assert(slots[slot].inst == new_inst);
+
+    uint64_t &word = row(idx)[slot / 64];
+    uint64_t mask = uint64_t(1) << (slot % 64);
+    if (word & mask)
+        duplicates[dupKey(idx, slot)]++;
+    else
+        word |= mask;
+
+    slots[slot].numDeps++;
+    numDeps++;
+}
+
+template <class DynInstPtr>
+void
+WakeupMatrix<DynInstPtr>::release(int slot)
+{
+    numDeps--;
+    if (--slots[slot].numDeps == 0) {
+        slots[slot].inst->iqSlot = -1;
+        slots[slot].inst = nullptr;
+        freeSlots.push_back(slot);
+    }
+}
+
+template <class DynInstPtr>
+void
+WakeupMatrix<DynInstPtr>::remove(RegIndex idx,
+                                 const DynInstPtr &inst_to_remove)
+{
+    // As with the dependency graph, the instruction may already have
+    // been woken up.
+    int slot = inst_to_remove->iqSlot;
+    if (slot < 0)
+        return;
+
+    auto dup = duplicates.find(dupKey(idx, slot));
+    if (dup != duplicates.end()) {
+        if (--dup->second == 0)
+            duplicates.erase(dup);
+    } else {
+        uint64_t &word = row(idx)[slot / 64];
+        uint64_t mask = uint64_t(1) << (slot % 64);
+        if (!(word & mask))
+            return;
+        word &= ~mask;
+    }
+    release(slot);
+}
+
+template <class DynInstPtr>
+DynInstPtr
+WakeupMatrix<DynInstPtr>::pop(RegIndex idx)
+{
+    uint64_t *words = row(idx);
+    for (int i = 0; i < wordsPerRow; ++i) {
+        if (!words[i])
+            continue;
+
+        int slot = i * 64 + ctz64(words[i]);
+        DynInstPtr inst = slots[slot].inst;
+
+        auto dup = duplicates.find(dupKey(idx, slot));
+        if (dup != duplicates.end()) {
+            if (--dup->second == 0)
+                duplicates.erase(dup);
+        } else {
+            words[i] &= words[i] - 1;
+        }
+        release(slot);
+        return inst;
+    }
+    return nullptr;
+}
+
+template <class DynInstPtr>
+bool
+WakeupMatrix<DynInstPtr>::empty(RegIndex idx) const
+{
+    const uint64_t *words = row(idx);
+    for (int i = 0; i < wordsPerRow; ++i) {
+        if (words[i])
+            return false;
+    }
+    return true;
+}
+
+template <class DynInstPtr>
+void
+WakeupMatrix<DynInstPtr>::dump()
+{
+    for (int i = 0; i < numRegs; ++i) {
+        if (producers[i]) {
+            cprintf("wakeupMatrix[%i]: producer: %s [sn:%lli] consumer: ",
+                    i, producers[i]->pcState(), producers[i]->seqNum);
+        } else {
+            cprintf("wakeupMatrix[%i]: No producer. consumer: ", i);
+        }
+
+        const uint64_t *words = row(i);
+        for (int j = 0; j < wordsPerRow; ++j) {
+            for (uint64_t w = words[j]; w; w &= w - 1) {
+                const DynInstPtr &inst = slots[j * 64 + ctz64(w)].inst;
+                cprintf("%s [sn:%lli] ", inst->pcState(), inst->seqNum);
+            }
+        }
+
+        cprintf("\n");
+    }
+    cprintf("free slots: %i\n", freeSlots.size());
+}
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_WAKEUP_MATRIX_HH__
@@ -71,6 +71,10 @@ BPredUnit::BPredUnit(const Params &params)
 {
     for (auto& r : RAS)
         r.init(params.RASSize);
+
+    // The history grows on demand to the number of branches in flight
+    for (auto& hist : predHist)
+        hist = std::make_unique<History>(64);
 }
 
 BPredUnit::BPredUnitStats::BPredUnitStats(statistics::Group *parent)
@@ -124,7 +128,24 @@ BPredUnit::drainSanityCheck() const
     // We shouldn't have any outstanding requests when we resume from
     // a drained system.
     for ([[maybe_unused]] const auto& ph : predHist)
-        assert(ph.empty());
+        assert(ph->empty());
+}
+
+BPredUnit::PredictorHistory &
+BPredUnit::newHistory(ThreadID tid)
+{
+    std::unique_ptr<History> &hist = predHist[tid];
+    if (hist->full()) {
+        // Move the branches in flight to a queue twice the size
+        auto bigger = std::make_unique<History>(hist->capacity() * 2);
+        for (auto &entry : *hist) {
+            bigger->advance_tail();
+            bigger->back() = std::move(entry);
+        }
+        hist = std::move(bigger);
+    }
+    hist->advance_tail();
+    return hist->back();
 }
 
 bool
@@ -169,8 +190,9 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
             "[tid:%i] [sn:%llu] Creating prediction history for PC %s\n",
             tid, seqNum, pc);
 
-    PredictorHistory predict_record(seqNum, pc.instAddr(), pred_taken,
-                                    bp_history, indirect_history, tid, inst);
+    PredictorHistory &predict_record = newHistory(tid);
+    predict_record.init(seqNum, pc.instAddr(), pred_taken, bp_history,
+                        indirect_history, tid, inst);
 
     // Now lookup in the BTB or RAS.
     if (pred_taken) {
@@ -186,7 +208,7 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
             // Record the top entry of the RAS, and its index.
             predict_record.usedRAS = true;
             predict_record.RASIndex = RAS[tid].topIdx();
-            set(predict_record.RASTarget, ras_top);
+            predict_record.setRASTarget(ras_top);
 
             RAS[tid].pop();
 
@@ -290,12 +312,10 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
         iPred->updateDirectionInfo(tid, orig_pred_taken);
     }
 
-    predHist[tid].push_front(predict_record);
-
     DPRINTF(Branch,
             "[tid:%i] [sn:%llu] History entry added. "
             "predHist.size(): %i\n",
-            tid, seqNum, predHist[tid].size());
+            tid, seqNum, predHist[tid]->size());
 
     return pred_taken;
 }
@@ -306,74 +326,75 @@ BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
     DPRINTF(Branch, "[tid:%i] Committing branches until "
             "sn:%llu]\n", tid, done_sn);
 
-    while (!predHist[tid].empty() &&
-           predHist[tid].back().seqNum <= done_sn) {
+    History &pred_hist = *predHist[tid];
+    while (!pred_hist.empty() &&
+           pred_hist.front().seqNum <= done_sn) {
         // Update the branch predictor with the correct results.
-        update(tid, predHist[tid].back().pc,
-                    predHist[tid].back().predTaken,
-                    predHist[tid].back().bpHistory, false,
-                    predHist[tid].back().inst,
-                    predHist[tid].back().target);
+        update(tid, pred_hist.front().pc,
+                    pred_hist.front().predTaken,
+                    pred_hist.front().bpHistory, false,
+                    pred_hist.front().inst,
+                    pred_hist.front().target);
 
         if (iPred) {
-            iPred->commit(done_sn, tid, predHist[tid].back().indirectHistory);
+            iPred->commit(done_sn, tid, pred_hist.front().indirectHistory);
         }
 
-        predHist[tid].pop_back();
+        pred_hist.pop_front();
     }
 }
 
 void
 BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
 {
-    History &pred_hist = predHist[tid];
+    History &pred_hist = *predHist[tid];
 
     if (iPred) {
         iPred->squash(squashed_sn, tid);
     }
 
     while (!pred_hist.empty() &&
-           pred_hist.front().seqNum > squashed_sn) {
-        if (pred_hist.front().usedRAS) {
-            if (pred_hist.front().RASTarget != nullptr) {
+           pred_hist.back().seqNum > squashed_sn) {
+        if (pred_hist.back().usedRAS) {
+            if (pred_hist.back().rasTarget() != nullptr) {
                 DPRINTF(Branch, "[tid:%i] [squash sn:%llu]"
                         " Restoring top of RAS to: %i,"
                         " target: %s\n", tid, squashed_sn,
-                        pred_hist.front().RASIndex,
-                        *pred_hist.front().RASTarget);
+                        pred_hist.back().RASIndex,
+                        *pred_hist.back().rasTarget());
             }
             else {
                 DPRINTF(Branch, "[tid:%i] [squash sn:%llu]"
                         " Restoring top of RAS to: %i,"
                         " target: INVALID_TARGET\n", tid, squashed_sn,
-                        pred_hist.front().RASIndex);
+                        pred_hist.back().RASIndex);
             }
 
-            RAS[tid].restore(pred_hist.front().RASIndex,
-                             pred_hist.front().RASTarget.get());
-        } else if (pred_hist.front().wasCall && pred_hist.front().pushedRAS) {
+            RAS[tid].restore(pred_hist.back().RASIndex,
+                             pred_hist.back().rasTarget());
+        } else if (pred_hist.back().wasCall && pred_hist.back().pushedRAS) {
              // Was a call but predicated false. Pop RAS here
              DPRINTF(Branch, "[tid:%i] [squash sn:%llu] Squashing"
                      "  Call [sn:%llu] PC: %s Popping RAS\n", tid, squashed_sn,
-                     pred_hist.front().seqNum, pred_hist.front().pc);
+                     pred_hist.back().seqNum, pred_hist.back().pc);
              RAS[tid].pop();
         }
 
         // This call should delete the bpHistory.
-        squash(tid, pred_hist.front().bpHistory);
+        squash(tid, pred_hist.back().bpHistory);
         if (iPred) {
-            iPred->deleteIndirectInfo(tid, pred_hist.front().indirectHistory);
+            iPred->deleteIndirectInfo(tid, pred_hist.back().indirectHistory);
         }
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] "
                 "Removing history for [sn:%llu] "
-                "PC %#x\n", tid, squashed_sn, pred_hist.front().seqNum,
-                pred_hist.front().pc);
+                "PC %#x\n", tid, squashed_sn, pred_hist.back().seqNum,
+                pred_hist.back().pc);
 
-        pred_hist.pop_front();
+        pred_hist.pop_back();
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] predHist.size(): %i\n",
-                tid, squashed_sn, predHist[tid].size());
+                tid, squashed_sn, pred_hist.size());
     }
 }
 
@@ -393,7 +414,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
     //     PC-relative, branch was predicted incorrectly. If so, a signal
     //     to the fetch stage is sent to squash history after the mispredict
 
-    History &pred_hist = predHist[tid];
+    History &pred_hist = *predHist[tid];
 
     ++stats.condIncorrect;
     ppMisses->notify(1);
@@ -409,16 +430,16 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
     // fix up the entry.
     if (!pred_hist.empty()) {
 
-        auto hist_it = pred_hist.begin();
+        PredictorHistory *hist_it = &pred_hist.back();
         //HistoryIt hist_it = find(pred_hist.begin(), pred_hist.end(),
         //                       squashed_sn);
 
         //assert(hist_it != pred_hist.end());
-        if (pred_hist.front().seqNum != squashed_sn) {
+        if (pred_hist.back().seqNum != squashed_sn) {
             DPRINTF(Branch, "Front sn %i != Squash sn %i\n",
-                    pred_hist.front().seqNum, squashed_sn);
+                    pred_hist.back().seqNum, squashed_sn);
 
-            assert(pred_hist.front().seqNum == squashed_sn);
+            assert(pred_hist.back().seqNum == squashed_sn);
         }
 
 
@@ -439,16 +460,16 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
         // the branch actually commits.
 
         // Remember the correct direction for the update at commit.
-        pred_hist.front().predTaken = actually_taken;
-        pred_hist.front().target = corr_target.instAddr();
+        pred_hist.back().predTaken = actually_taken;
+        pred_hist.back().target = corr_target.instAddr();
 
         update(tid, (*hist_it).pc, actually_taken,
-               pred_hist.front().bpHistory, true, pred_hist.front().inst,
+               pred_hist.back().bpHistory, true, pred_hist.back().inst,
                corr_target.instAddr());
 
         if (iPred) {
             iPred->changeDirectionPrediction(tid,
-                pred_hist.front().indirectHistory, actually_taken);
+                pred_hist.back().indirectHistory, actually_taken);
         }
 
         if (actually_taken) {
@@ -465,7 +486,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
                 ++stats.indirectMispredicted;
                 if (iPred) {
                     iPred->recordTarget(
-                        hist_it->seqNum, pred_hist.front().indirectHistory,
+                        hist_it->seqNum, pred_hist.back().indirectHistory,
                         corr_target, tid);
                 }
             } else {
@@ -487,8 +508,8 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
                 DPRINTF(Branch,
                         "[tid:%i] [squash sn:%llu] Restoring top of RAS "
                         "to: %i, target: %s\n", tid, squashed_sn,
-                        hist_it->RASIndex, *hist_it->RASTarget);
-                RAS[tid].restore(hist_it->RASIndex, hist_it->RASTarget.get());
+                        hist_it->RASIndex, *hist_it->rasTarget());
+                RAS[tid].restore(hist_it->RASIndex, hist_it->rasTarget());
                 hist_it->usedRAS = false;
            } else if (hist_it->wasCall && hist_it->pushedRAS) {
                  //Was a Call but predicated false. Pop RAS here
@@ -513,12 +534,12 @@ BPredUnit::dump()
 {
     int i = 0;
     for (const auto& ph : predHist) {
-        if (!ph.empty()) {
-            auto pred_hist_it = ph.begin();
+        if (!ph->empty()) {
+            auto pred_hist_it = ph->begin();
 
-            cprintf("predHist[%i].size(): %i\n", i++, ph.size());
+            cprintf("predHist[%i].size(): %i\n", i++, ph->size());
 
-            while (pred_hist_it != ph.end()) {
+            while (pred_hist_it != ph->end()) {
                 cprintf("sn:%llu], PC:%#x, tid:%i, predTaken:%i, "
                         "bpHistory:%#x\n",
                         pred_hist_it->seqNum, pred_hist_it->pc,
@@ -42,8 +42,10 @@
 #ifndef __CPU_PRED_BPRED_UNIT_HH__
 #define __CPU_PRED_BPRED_UNIT_HH__
 
-#include <deque>
+#include <memory>
+#include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/pred/btb.hh"
@@ -201,27 +203,46 @@ class BPredUnit : public SimObject
     struct PredictorHistory
     {
         /**
-         * Makes a predictor history struct that contains any
-         * information needed to update the predictor, BTB, and RAS.
+         * Fills in a history entry with any information needed to
+         * update the predictor, BTB, and RAS. Entries are recycled,
+         * so everything is reset apart from the storage of the RAS
+         * target.
          */
-        PredictorHistory(const InstSeqNum &seq_num, Addr instPC,
-                         bool pred_taken, void *bp_history,
-                         void *indirect_history, ThreadID _tid,
-                         const StaticInstPtr & inst)
-            : seqNum(seq_num), pc(instPC), bpHistory(bp_history),
-              indirectHistory(indirect_history), tid(_tid),
-              predTaken(pred_taken), inst(inst)
-        {}
-
-        PredictorHistory(const PredictorHistory &other) :
-            seqNum(other.seqNum), pc(other.pc), bpHistory(other.bpHistory),
-            indirectHistory(other.indirectHistory), RASIndex(other.RASIndex),
-            tid(other.tid), predTaken(other.predTaken), usedRAS(other.usedRAS),
-            pushedRAS(other.pushedRAS), wasCall(other.wasCall),
-            wasReturn(other.wasReturn), wasIndirect(other.wasIndirect),
-            target(other.target), inst(other.inst)
+        void
+        init(const InstSeqNum &seq_num, Addr instPC, bool pred_taken,
+             void *bp_history, void *indirect_history, ThreadID _tid,
+             const StaticInstPtr &_inst)
         {
-            set(RASTarget, other.RASTarget);
+            seqNum = seq_num;
+            pc = instPC;
+            bpHistory = bp_history;
+            indirectHistory = indirect_history;
+            hasRASTarget = false;
+            RASIndex = 0;
+            tid = _tid;
+            predTaken = pred_taken;
+            usedRAS = false;
+            pushedRAS = false;
+            wasCall = false;
+            wasReturn = false;
+            wasIndirect = false;
+            target = MaxAddr;
+            inst = _inst;
+        }
+
+        /** The RAS target, or nullptr if there is none. */
+        const PCStateBase *
+        rasTarget() const
+        {
+            return hasRASTarget ? RASTarget.get() : nullptr;
+        }
+
+        void
+        setRASTarget(const PCStateBase *ras_target)
+        {
+            if (ras_target)
+                set(RASTarget, *ras_target);
+            hasRASTarget = ras_target != nullptr;
         }
 
         bool
@@ -231,10 +252,10 @@ class BPredUnit : public SimObject
         }
 
         /** The sequence number for the predictor history entry. */
-        InstSeqNum seqNum;
+        InstSeqNum seqNum = 0;
 
         /** The PC associated with the sequence number. */
-        Addr pc;
+        Addr pc = 0;
 
         /** Pointer to the history object passed back from the branch
          * predictor.  It is used to update or restore state of the
@@ -244,17 +265,23 @@ class BPredUnit : public SimObject
 
         void *indirectHistory = nullptr;
 
-        /** The RAS target (only valid if a return). */
+        /**
+         * Storage for the RAS target (only valid if a return and
+         * hasRASTarget is set).
+         */
         std::unique_ptr<PCStateBase> RASTarget;
 
+        /** Whether RASTarget holds a valid target. */
+        bool hasRASTarget = false;
+
         /** The RAS index of the instruction (only valid if a call). */
         unsigned RASIndex = 0;
 
         /** The thread id. */
-        ThreadID tid;
+        ThreadID tid = 0;
 
         /** Whether or not it was predicted taken. */
-        bool predTaken;
+        bool predTaken = false;
 
         /** Whether or not the RAS was used. */
         bool usedRAS = false;
@@ -277,10 +304,21 @@ class BPredUnit : public SimObject
         Addr target = MaxAddr;
 
         /** The branch instrction */
-        const StaticInstPtr inst;
+        StaticInstPtr inst;
     };
 
-    typedef std::deque<PredictorHistory> History;
+    /**
+     * Branches in flight, oldest at the front. Entries are reused in
+     * place, so predictions don't allocate once the queue has grown
+     * to the number of branches the CPU keeps in flight.
+     */
+    typedef CircularQueue<PredictorHistory> History;
+
+    /**
+     * Get a fresh entry at the back of a thread's history, growing the
+     * history if it is full.
+     */
+    PredictorHistory &newHistory(ThreadID tid);
 
     /** Number of the threads for which the branch history is maintained. */
     const unsigned numThreads;
@@ -291,7 +329,7 @@ class BPredUnit : public SimObject
      * as instructions are committed, or restore it to the proper state after
      * a squash.
      */
-    std::vector<History> predHist;
+    std::vector<std::unique_ptr<History>> predHist;
 
     /** The BTB. */
     DefaultBTB BTB;
@@ -142,9 +142,13 @@ class LoopPredictor : public SimObject
         BranchInfo()
             : loopTag(0), currentIter(0),
               loopPred(false),
-              loopPredValid(false), loopIndex(0), loopIndexB(0), loopHit(0),
+              loopPredValid(false), loopPredUsed(false),
+              loopIndex(0), loopIndexB(0), loopHit(0),
               predTaken(false)
         {}
+
+        /** Prepare a recycled branch info for a new prediction */
+        void reset() { *this = BranchInfo(); }
     };
 
     /**
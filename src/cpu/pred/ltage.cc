@@ -55,6 +55,12 @@ LTAGE::LTAGE(const LTAGEParams &params)
 {
 }
 
+TAGE::TageBranchInfo *
+LTAGE::makeTageBranchInfo()
+{
+    return new LTageBranchInfo(*tage, *loopPredictor);
+}
+
 void
 LTAGE::init()
 {
@@ -65,7 +71,7 @@ LTAGE::init()
 bool
 LTAGE::predict(ThreadID tid, Addr branch_pc, bool cond_branch, void* &b)
 {
-    LTageBranchInfo *bi = new LTageBranchInfo(*tage, *loopPredictor);
+    LTageBranchInfo *bi = static_cast<LTageBranchInfo *>(allocBranchInfo());
     b = (void*)(bi);
 
     bool pred_taken = tage->tagePredict(tid, branch_pc, cond_branch,
@@ -132,7 +138,7 @@ LTAGE::update(ThreadID tid, Addr branch_pc, bool taken, void* bp_history,
     tage->updateHistories(tid, branch_pc, taken, bi->tageBranchInfo, false,
                           inst, corrTarget);
 
-    delete bi;
+    freeBranchInfo(bi);
 }
 
 void
@@ -99,8 +99,17 @@ class LTAGE : public TAGE
         {
             delete lpBranchInfo;
         }
+
+        void
+        reset() override
+        {
+            TageBranchInfo::reset();
+            lpBranchInfo->reset();
+        }
     };
 
+    TageBranchInfo *makeTageBranchInfo() override;
+
     /**
      * Get a branch prediction from LTAGE. *NOT* an override of
      * BpredUnit::predict().
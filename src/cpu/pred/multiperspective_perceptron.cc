@@ -38,6 +38,8 @@
 
 #include "cpu/pred/multiperspective_perceptron.hh"
 
+#include <algorithm>
+
 #include "base/random.hh"
 #include "debug/Branch.hh"
 
@@ -114,6 +116,10 @@ MultiperspectivePerceptron::ThreadData::ThreadData(int num_filters,
             }
         }
     }
+
+    indices.resize(table_sizes.size());
+    bestPreds.resize(table_sizes.size());
+    isBest.resize(table_sizes.size());
 }
 
 MultiperspectivePerceptron::MultiperspectivePerceptron(
@@ -306,11 +312,23 @@ MultiperspectivePerceptron::getIndex(ThreadID tid, const MPPBranchInfo &bi,
     return h;
 }
 
+const std::vector<unsigned int> &
+MultiperspectivePerceptron::computeIndices(ThreadID tid,
+                                           const MPPBranchInfo &bi) const
+{
+    std::vector<unsigned int> &indices = threadData[tid]->indices;
+    for (int i = 0; i < specs.size(); i += 1) {
+        indices[i] = getIndex(tid, bi, *specs[i], i);
+    }
+    return indices;
+}
+
 int
 MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
 {
     // list of best predictors
-    std::vector<int> best_preds(specs.size(), -1);
+    std::vector<int> &best_preds = threadData[tid]->bestPreds;
+    std::fill(best_preds.begin(), best_preds.end(), -1);
 
     // initialize sum
     bi.yout = 0;
@@ -332,38 +350,48 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     // branch
     findBest(tid, best_preds);
 
+    // mark the good features so that the sum doesn't need to search
+    // the list for every table
+    std::vector<uint8_t> &is_best = threadData[tid]->isBest;
+    std::fill(is_best.begin(), is_best.end(), 0);
+    if (threshold >= 0) {
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size()); j += 1) {
+            if (best_preds[j] >= 0) {
+                is_best[best_preds[j]] = 1;
+            }
+        }
+    }
+
+    // get the hashes to index the tables before summing up the weights,
+    // so that the sum is a tight loop over the tables
+    const std::vector<unsigned int> &indices = computeIndices(tid, bi);
+    const std::vector<std::vector<short int>> &tables =
+        threadData[tid]->tables;
+    const std::vector<std::vector<std::array<bool, 2>>> &sign_bits =
+        threadData[tid]->sign_bits;
+    const unsigned int sign_idx = bi.getHPC() % n_sign_bits;
+
     // begin computation of the sum for low-confidence branch
     int bestval = 0;
+    int yout = 0;
 
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
-        // get the hash to index the table
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
         // add the weight; first get the weight's magnitude
-        int counter = threadData[tid]->tables[i][hashed_idx];
+        int counter = tables[i][indices[i]];
         // get the sign
-        bool sign =
-          threadData[tid]->sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        bool sign = sign_bits[i][indices[i]][sign_idx];
         // apply the transfer function and multiply by a coefficient
         int weight = spec.coeff * ((spec.width == 5) ?
                                    xlat4[counter] : xlat[counter]);
         // apply the sign
         int val = sign ? -weight : weight;
         // add the value
-        bi.yout += val;
+        yout += val;
         // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
-            }
-        }
+        bestval += is_best[i] ? val : 0;
     }
+    bi.yout += yout;
     // apply a fudge factor to affect when training is triggered
     bi.yout *= fudge;
     return bestval;
@@ -413,6 +441,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     std::vector<std::vector<std::array<bool, 2>>> &sign_bits =
             threadData[tid]->sign_bits;
     std::vector<int> &mpreds = threadData[tid]->mpreds;
+    // the histories don't change while training, so the table indices
+    // are only computed once
+    const std::vector<unsigned int> &indices = computeIndices(tid, bi);
     // was the prediction correct?
     bool correct = (bi.yout >= 1) == taken;
     // what is the magnitude of yout?
@@ -425,7 +456,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
         for (int i = 0; i < specs.size(); i += 1) {
             HistorySpec const &spec = *specs[i];
             // get the hash to index the table
-            unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+            unsigned int hashed_idx = indices[i];
             bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
             int counter = tables[i][hashed_idx];
             int weight = spec.coeff * ((spec.width == 5) ?
@@ -473,7 +504,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
         // get the magnitude
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+        unsigned int hashed_idx = indices[i];
         int counter = tables[i][hashed_idx];
         // get the sign
         bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
@@ -507,7 +538,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 for (int j = 0; j < specs.size(); j += 1) {
                     int i = (nrand + j) % specs.size();
                     HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = indices[i];
                     int counter = tables[i][hashed_idx];
                     bool sign =
                         sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
@@ -525,7 +556,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 if (besti != -1) {
                     int i = besti;
                     HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = indices[i];
                     int counter = tables[i][hashed_idx];
                     bool sign =
                         sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
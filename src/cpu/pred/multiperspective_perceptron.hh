@@ -355,6 +355,13 @@ class MultiperspectivePerceptron : public BPredUnit
         std::vector<int> mpreds;
         std::vector<std::vector<short int>> tables;
         std::vector<std::vector<std::array<bool, 2>>> sign_bits;
+
+        /** Scratch storage for the table indices of a branch */
+        std::vector<unsigned int> indices;
+        /** Scratch storage for the best subset of features */
+        std::vector<int> bestPreds;
+        /** Scratch storage marking the features in bestPreds */
+        std::vector<uint8_t> isBest;
     };
     std::vector<ThreadData *> threadData;
 
@@ -456,6 +463,18 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     void findBest(ThreadID tid, std::vector<int> &best_preds) const;
 
+    /**
+     * Computes the indices of all the predictor tables for a branch.
+     * The indices only depend on the histories, so they remain valid
+     * while only the tables are updated.
+     * @param tid Thread ID of the branch
+     * @param bi branch informaiton data
+     * @return the index of each predictor table, valid until the next
+     * call for the same thread
+     */
+    const std::vector<unsigned int> &computeIndices(ThreadID tid,
+            const MPPBranchInfo &bi) const;
+
     /**
      * Computes the output of the predictor for a given branch and the
      * resulting best value in case the prediction has low confidence
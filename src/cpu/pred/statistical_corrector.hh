@@ -216,6 +216,9 @@ class StatisticalCorrector : public SimObject
         int thres;
         bool predBeforeSC;
         bool usedScPred;
+
+        /** Prepare a recycled branch info for a new prediction */
+        void reset() { *this = BranchInfo(); }
     };
 
     StatisticalCorrector(const StatisticalCorrectorParams &p);
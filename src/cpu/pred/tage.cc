@@ -54,6 +54,36 @@ TAGE::TAGE(const TAGEParams &params) : BPredUnit(params), tage(params.tage)
 {
 }
 
+TAGE::~TAGE()
+{
+    for (auto *bi : freeBranchInfos)
+        delete bi;
+}
+
+TAGE::TageBranchInfo *
+TAGE::makeTageBranchInfo()
+{
+    return new TageBranchInfo(*tage);
+}
+
+TAGE::TageBranchInfo *
+TAGE::allocBranchInfo()
+{
+    if (freeBranchInfos.empty())
+        return makeTageBranchInfo();
+
+    TageBranchInfo *bi = freeBranchInfos.back();
+    freeBranchInfos.pop_back();
+    bi->reset();
+    return bi;
+}
+
+void
+TAGE::freeBranchInfo(TageBranchInfo *bi)
+{
+    freeBranchInfos.push_back(bi);
+}
+
 // PREDICTOR UPDATE
 void
 TAGE::update(ThreadID tid, Addr branch_pc, bool taken, void* bp_history,
@@ -83,7 +113,7 @@ TAGE::update(ThreadID tid, Addr branch_pc, bool taken, void* bp_history,
     // optional non speculative update of the histories
     tage->updateHistories(tid, branch_pc, taken, tage_bi, false, inst,
                           corrTarget);
-    delete bi;
+    freeBranchInfo(bi);
 }
 
 void
@@ -91,13 +121,13 @@ TAGE::squash(ThreadID tid, void *bp_history)
 {
     TageBranchInfo *bi = static_cast<TageBranchInfo*>(bp_history);
     DPRINTF(Tage, "Deleting branch info: %lx\n", bi->tageBranchInfo->branchPC);
-    delete bi;
+    freeBranchInfo(bi);
 }
 
 bool
 TAGE::predict(ThreadID tid, Addr branch_pc, bool cond_branch, void* &b)
 {
-    TageBranchInfo *bi = new TageBranchInfo(*tage);//nHistoryTables+1);
+    TageBranchInfo *bi = allocBranchInfo();
     b = (void*)(bi);
     return tage->tagePredict(tid, branch_pc, cond_branch, bi->tageBranchInfo);
 }
@@ -77,14 +77,38 @@ class TAGE: public BPredUnit
         {
             delete tageBranchInfo;
         }
+
+        /** Prepare a recycled branch info for a new prediction */
+        virtual void
+        reset()
+        {
+            tageBranchInfo->reset();
+        }
     };
 
+    /** Create a branch info of the type used by this predictor */
+    virtual TageBranchInfo *makeTageBranchInfo();
+
+    /**
+     * Get the branch info for a new prediction. Branch infos that are
+     * no longer in flight are reused, so predictions don't allocate
+     * once the pool has grown to the number of branches in flight.
+     */
+    TageBranchInfo *allocBranchInfo();
+
+    /** Return a branch info that is no longer in flight to the pool */
+    void freeBranchInfo(TageBranchInfo *bi);
+
+    /** Branch infos that are not in flight */
+    std::vector<TageBranchInfo *> freeBranchInfos;
+
     virtual bool predict(ThreadID tid, Addr branch_pc, bool cond_branch,
                          void* &b);
 
   public:
 
     TAGE(const TAGEParams &params);
+    ~TAGE();
 
     // Base class methods.
     void uncondBranch(ThreadID tid, Addr br_pc, void* &bp_history) override;
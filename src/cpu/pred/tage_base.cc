@@ -144,9 +144,27 @@ TAGEBase::init()
 
     tableIndices = new int [nHistoryTables+1];
     tableTags = new int [nHistoryTables+1];
+    initHashConstants();
     initialized = true;
 }
 
+void
+TAGEBase::initHashConstants()
+{
+    indexMasks.resize(nHistoryTables + 1, 0);
+    tagMasks.resize(nHistoryTables + 1, 0);
+    pathHistMasks.resize(nHistoryTables + 1, 0);
+    indexPcShifts.resize(nHistoryTables + 1, 0);
+    for (int i = 1; i <= nHistoryTables; i++) {
+        const int hlen = (histLengths[i] > pathHistBits) ? pathHistBits :
+                                                           histLengths[i];
+        indexMasks[i] = (1ULL << logTagTableSizes[i]) - 1;
+        tagMasks[i] = (1ULL << tagTableTagWidths[i]) - 1;
+        pathHistMasks[i] = (1ULL << hlen) - 1;
+        indexPcShifts[i] = abs(logTagTableSizes[i] - i) + 1;
+    }
+}
+
 void
 TAGEBase::initFoldedHistories(ThreadHistory & history)
 {
@@ -229,17 +247,7 @@ TAGEBase::F(int A, int size, int bank) const
 int
 TAGEBase::gindex(ThreadID tid, Addr pc, int bank) const
 {
-    int index;
-    int hlen = (histLengths[bank] > pathHistBits) ? pathHistBits :
-                                                    histLengths[bank];
-    const unsigned int shiftedPc = pc >> instShiftAmt;
-    index =
-        shiftedPc ^
-        (shiftedPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
-        threadHistory[tid].computeIndices[bank].comp ^
-        F(threadHistory[tid].pathHist, hlen, bank);
-
-    return (index & ((1ULL << (logTagTableSizes[bank])) - 1));
+    return baseIndex(threadHistory[tid], pc >> instShiftAmt, bank);
 }
 
 
@@ -247,11 +255,7 @@ TAGEBase::gindex(ThreadID tid, Addr pc, int bank) const
 uint16_t
 TAGEBase::gtag(ThreadID tid, Addr pc, int bank) const
 {
-    int tag = (pc >> instShiftAmt) ^
-              threadHistory[tid].computeTags[0][bank].comp ^
-              (threadHistory[tid].computeTags[1][bank].comp << 1);
-
-    return (tag & ((1ULL << tagTableTagWidths[bank]) - 1));
+    return baseTag(threadHistory[tid], pc >> instShiftAmt, bank);
 }
 
 
@@ -341,10 +345,12 @@ TAGEBase::calculateIndicesAndTags(ThreadID tid, Addr branch_pc,
                                   BranchInfo* bi)
 {
     // computes the table addresses and the partial tags
+    const ThreadHistory &hist = threadHistory[tid];
+    const unsigned shifted_pc = branch_pc >> instShiftAmt;
     for (int i = 1; i <= nHistoryTables; i++) {
-        tableIndices[i] = gindex(tid, branch_pc, i);
+        tableIndices[i] = baseIndex(hist, shifted_pc, i);
         bi->tableIndices[i] = tableIndices[i];
-        tableTags[i] = gtag(tid, branch_pc, i);
+        tableTags[i] = baseTag(hist, shifted_pc, i);
         bi->tableTags[i] = tableTags[i];
     }
 }
@@ -181,6 +181,30 @@ class TAGEBase : public SimObject
         {
             delete[] storage;
         }
+
+        /**
+         * Prepare a recycled branch info for a new prediction. The
+         * saved indices and histories are overwritten by the
+         * prediction, so only the scalar state is reset.
+         */
+        virtual void
+        reset()
+        {
+            pathHist = 0;
+            ptGhist = 0;
+            hitBank = 0;
+            hitBankIndex = 0;
+            altBank = 0;
+            altBankIndex = 0;
+            bimodalIndex = 0;
+            tagePred = false;
+            altTaken = false;
+            condBranch = false;
+            longestMatchPred = false;
+            pseudoNewAlloc = false;
+            branchPC = 0;
+            provider = -1;
+        }
     };
 
     virtual BranchInfo *makeBranchInfo();
@@ -361,7 +385,10 @@ class TAGEBase : public SimObject
 
     /**
      * On a prediction, calculates the TAGE indices and tags for
-     * all the different history lengths
+     * all the different history lengths. The base implementation
+     * computes the hashes of gindex() and gtag() in one loop over the
+     * tables, so subclasses that override gindex(), F() or gtag() also
+     * need to override this method.
      */
     virtual void calculateIndicesAndTags(
         ThreadID tid, Addr branch_pc, BranchInfo* bi);
@@ -468,10 +495,61 @@ class TAGEBase : public SimObject
      */
     virtual void initFoldedHistories(ThreadHistory & history);
 
+    /**
+     * Computes the per table constants used by baseIndex() and
+     * baseTag(), once the table geometry is known.
+     */
+    void initHashConstants();
+
+    /**
+     * The index hash of gindex() (including the path history
+     * shuffle of F()), using precomputed per table constants.
+     * @param hist The global histories to use.
+     * @param shifted_pc The branch PC shifted by instShiftAmt.
+     * @param bank The partially tagged table to access.
+     */
+    int
+    baseIndex(const ThreadHistory &hist, unsigned shifted_pc, int bank) const
+    {
+        const int log_size = logTagTableSizes[bank];
+        const int mask = indexMasks[bank];
+        int a = hist.pathHist & pathHistMasks[bank];
+        int a1 = a & mask;
+        int a2 = a >> log_size;
+        a2 = ((a2 << bank) & mask) + (a2 >> (log_size - bank));
+        a = a1 ^ a2;
+        a = ((a << bank) & mask) + (a >> (log_size - bank));
+        int index = shifted_pc ^ (shifted_pc >> indexPcShifts[bank]) ^
+                    hist.computeIndices[bank].comp ^ a;
+        return index & mask;
+    }
+
+    /**
+     * The tag hash of gtag(), using precomputed per table constants.
+     * @param hist The global histories to use.
+     * @param shifted_pc The branch PC shifted by instShiftAmt.
+     * @param bank The partially tagged table to access.
+     */
+    uint16_t
+    baseTag(const ThreadHistory &hist, unsigned shifted_pc, int bank) const
+    {
+        int tag = shifted_pc ^ hist.computeTags[0][bank].comp ^
+                  (hist.computeTags[1][bank].comp << 1);
+        return tag & tagMasks[bank];
+    }
+
     int *histLengths;
     int *tableIndices;
     int *tableTags;
 
+    /** @{ */
+    /** Per table constants of the index and tag hashes */
+    std::vector<unsigned> indexMasks;
+    std::vector<unsigned> tagMasks;
+    std::vector<unsigned> pathHistMasks;
+    std::vector<int> indexPcShifts;
+    /** @} */
+
     std::vector<int8_t> useAltPredForNewlyAllocated;
     int64_t tCounter;
     uint64_t logUResetPeriod;
@@ -361,12 +361,18 @@ TAGE_SC_L_TAGE::extraAltCalc(TAGEBase::BranchInfo* bi)
     tage_scl_bi->altConf = (abs(2*ctr + 1) > 1);
 }
 
+TAGE::TageBranchInfo *
+TAGE_SC_L::makeTageBranchInfo()
+{
+    return new TageSCLBranchInfo(*tage, *statisticalCorrector,
+                                 *loopPredictor);
+}
+
 bool
 TAGE_SC_L::predict(ThreadID tid, Addr branch_pc, bool cond_branch, void* &b)
 {
-    TageSCLBranchInfo *bi = new TageSCLBranchInfo(*tage,
-                                                  *statisticalCorrector,
-                                                  *loopPredictor);
+    TageSCLBranchInfo *bi =
+        static_cast<TageSCLBranchInfo *>(allocBranchInfo());
     b = (void*)(bi);
 
     bool pred_taken = tage->tagePredict(tid, branch_pc, cond_branch,
@@ -462,7 +468,7 @@ TAGE_SC_L::update(ThreadID tid, Addr branch_pc, bool taken, void *bp_history,
                               inst, corrTarget);
     }
 
-    delete bi;
+    freeBranchInfo(bi);
 }
 
 } // namespace branch_prediction
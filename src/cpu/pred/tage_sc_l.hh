@@ -80,6 +80,16 @@ class TAGE_SC_L_TAGE : public TAGEBase
         {}
         virtual ~BranchInfo()
         {}
+
+        void
+        reset() override
+        {
+            TAGEBase::BranchInfo::reset();
+            lowConf = false;
+            highConf = false;
+            altConf = false;
+            medConf = false;
+        }
     };
 
     virtual TAGEBase::BranchInfo *makeBranchInfo() override;
@@ -181,8 +191,17 @@ class TAGE_SC_L: public LTAGE
         {
             delete scBranchInfo;
         }
+
+        void
+        reset() override
+        {
+            LTageBranchInfo::reset();
+            scBranchInfo->reset();
+        }
     };
 
+    TageBranchInfo *makeTageBranchInfo() override;
+
     // more provider types
     enum
     {
@@ -0,0 +1,69 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import *
+from m5.objects.Probe import ProbeListenerObject
+
+class LoopPointManager(SimObject):
+    """Counts loop entries across all the cores of a multi-threaded
+    workload. It either profiles the run into regions delimited by
+    (PC, count) markers, or makes the simulation exit whenever one of the
+    markers it is given is reached."""
+
+    type = 'LoopPointManager'
+    cxx_header = "cpu/probes/looppoint.hh"
+    cxx_class = 'gem5::LoopPointManager'
+
+    cxx_exports = [
+        PyBindMethod("getCurrentPc"),
+        PyBindMethod("getCurrentCount"),
+        PyBindMethod("numMarkersLeft"),
+    ]
+
+    target_pcs = VectorParam.Addr([], "PCs of the markers to exit at")
+    target_counts = VectorParam.UInt64([], "Global entry counts of the "
+        "markers to exit at, one per target PC")
+
+    profile = Param.Bool(False, "Split the run into regions and write "
+        "their BBVs and markers")
+    region_length = Param.UInt64(100000000, "Minimum number of "
+        "instructions, summed over all the cores, in a region")
+    profile_file = Param.String("looppoint.bb.gz", "BBV (output) file")
+    marker_file = Param.String("looppoint.markers", "Region marker "
+        "(output) file")
+
+class LoopPoint(ProbeListenerObject):
+    """Per core probe feeding the retired instructions of a CPU to a
+    LoopPointManager."""
+
+    type = 'LoopPoint'
+    cxx_header = "cpu/probes/looppoint.hh"
+    cxx_class = 'gem5::LoopPoint'
+
+    looppoint_manager = Param.LoopPointManager("Global loop entry counter")
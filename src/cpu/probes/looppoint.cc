@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/looppoint.hh"
+
+#include <algorithm>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+LoopPointManager::LoopPointManager(const Params &p)
+    : SimObject(p),
+      profiling(p.profile),
+      regionLength(p.region_length),
+      markersLeft(0),
+      currentMarker(0, 0),
+      numCores(0),
+      regionInsts(0),
+      regionStart(0, 0),
+      bbvRegions(0),
+      profileStream(nullptr),
+      markerStream(nullptr)
+{
+    fatal_if(p.target_pcs.size() != p.target_counts.size(),
+             "%s: target_pcs and target_counts must have the same length",
+             name());
+
+    for (size_t i = 0; i < p.target_pcs.size(); i++) {
+        fatal_if(p.target_counts[i] == 0,
+                 "%s: the entry counts of the markers start at 1", name());
+        targets[p.target_pcs[i]].push_back(p.target_counts[i]);
+    }
+    // Keep the next count to reach of every PC at the back
+    for (auto &target : targets) {
+        auto &counts = target.second;
+        std::sort(counts.begin(), counts.end(), std::greater<uint64_t>());
+        counts.erase(std::unique(counts.begin(), counts.end()),
+                     counts.end());
+        markersLeft += counts.size();
+    }
+
+    if (profiling) {
+        profileStream = simout.create(p.profile_file, false);
+        markerStream = simout.create(p.marker_file, false);
+        fatal_if(!profileStream || !markerStream,
+                 "%s: unable to open the profile files", name());
+        *markerStream->stream() <<
+            "# region start_pc start_count end_pc end_count insts\n";
+    }
+}
+
+LoopPointManager::~LoopPointManager()
+{
+    if (!profiling)
+        return;
+
+    // The last region runs to the end of the simulation
+    if (regionInsts)
+        endRegion(0, 0);
+    simout.close(profileStream);
+    simout.close(markerStream);
+}
+
+unsigned
+LoopPointManager::addCore()
+{
+    return numCores++;
+}
+
+void
+LoopPointManager::loopEntry(Addr pc)
+{
+    uint64_t count = ++entryCounts[pc];
+
+    auto target = targets.find(pc);
+    if (target != targets.end()) {
+        auto &counts = target->second;
+        if (!counts.empty() && counts.back() == count) {
+            counts.pop_back();
+            markersLeft--;
+            currentMarker = std::make_pair(pc, count);
+            exitSimLoop("looppoint marker reached");
+        }
+    }
+
+    if (profiling && regionInsts >= regionLength)
+        endRegion(pc, count);
+}
+
+void
+LoopPointManager::countBlock(unsigned core,
+                             const std::pair<Addr, Addr> &range,
+                             uint64_t insts)
+{
+    uint64_t id = bbIds.emplace(range, bbIds.size() + 1).first->second;
+    regionCounts[std::make_pair(id, core)] += insts;
+    regionInsts += insts;
+}
+
+void
+LoopPointManager::endRegion(Addr pc, uint64_t count)
+{
+    // The region BBV concatenates the BBVs of the cores
+    std::vector<std::pair<uint64_t, uint64_t>> counts;
+    counts.reserve(regionCounts.size());
+    for (const auto &entry : regionCounts) {
+        uint64_t dim = (entry.first.first - 1) * numCores +
+            entry.first.second + 1;
+        counts.push_back(std::make_pair(dim, entry.second));
+    }
+    std::sort(counts.begin(), counts.end());
+
+    std::ostream &os = *profileStream->stream();
+    os << "T";
+    for (const auto &cnt : counts)
+        os << ":" << cnt.first << ":" << cnt.second << " ";
+    os << "\n";
+
+    ccprintf(*markerStream->stream(), "%d %#x %d %#x %d %d\n",
+             bbvRegions++, regionStart.first, regionStart.second,
+             pc, count, regionInsts);
+
+    regionCounts.clear();
+    regionInsts = 0;
+    regionStart = std::make_pair(pc, count);
+}
+
+LoopPoint::LoopPoint(const LoopPointParams &p)
+    : ProbeListenerObject(p),
+      loopManager(p.looppoint_manager),
+      core(p.looppoint_manager->addCore()),
+      lastPC(0),
+      afterBranch(false),
+      currentBB(0, 0),
+      currentBBInsts(0)
+{
+}
+
+void
+LoopPoint::regProbeListeners()
+{
+    typedef ProbeListenerArg<LoopPoint, uint64_t> RetiredListener;
+    listeners.push_back(new RetiredListener(this, "RetiredInstsPC",
+                                            &LoopPoint::retiredPC));
+    listeners.push_back(new RetiredListener(this, "RetiredBranches",
+                                            &LoopPoint::retiredBranch));
+}
+
+void
+LoopPoint::retiredPC(const uint64_t &pc)
+{
+    // Arriving at or before the branch means the branch went backwards
+    if (afterBranch && pc <= lastPC && loopManager->isTracked(pc))
+        loopManager->loopEntry(pc);
+    afterBranch = false;
+
+    if (loopManager->isProfiling()) {
+        if (!currentBBInsts)
+            currentBB.first = pc;
+        ++currentBBInsts;
+    }
+    lastPC = pc;
+}
+
+void
+LoopPoint::retiredBranch(const uint64_t &count)
+{
+    afterBranch = true;
+
+    if (loopManager->isProfiling() && currentBBInsts) {
+        currentBB.second = lastPC;
+        loopManager->countBlock(core, currentBB, currentBBInsts);
+        currentBBInsts = 0;
+    }
+}
+
+} // namespace gem5
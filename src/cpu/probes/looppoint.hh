@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * LoopPoint style region selection for multi-threaded workloads.
+ *
+ * A loop entry is the arrival at a PC through a backward branch. The
+ * LoopPointManager counts entries to each loop head globally, over all
+ * the cores it is attached to, so a (PC, count) pair names the same
+ * point in the execution no matter how the threads interleave. When
+ * profiling, the run is cut into regions at loop entries once enough
+ * instructions have retired, and the BBV of each region is the
+ * concatenation of the per core BBVs. When replaying, the simulation
+ * exits with the cause "looppoint marker reached" at each of the
+ * (PC, count) markers the manager is given.
+ */
+
+#ifndef __CPU_PROBES_LOOPPOINT_HH__
+#define __CPU_PROBES_LOOPPOINT_HH__
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/types.hh"
+#include "params/LoopPoint.hh"
+#include "params/LoopPointManager.hh"
+#include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class LoopPointManager : public SimObject
+{
+  public:
+    PARAMS(LoopPointManager);
+    LoopPointManager(const Params &p);
+    ~LoopPointManager();
+
+    /** Attach a core, returning its index in the region BBVs */
+    unsigned addCore();
+
+    /** Whether entries to pc need to be reported to loopEntry() */
+    bool
+    isTracked(Addr pc) const
+    {
+        return profiling || targets.count(pc);
+    }
+
+    /** A core entered the loop headed by pc */
+    void loopEntry(Addr pc);
+
+    /** Core core retired the basic block range, of insts instructions */
+    void countBlock(unsigned core, const std::pair<Addr, Addr> &range,
+                    uint64_t insts);
+
+    /** Whether the cores need to report their basic blocks */
+    bool isProfiling() const { return profiling; }
+
+    /** The marker reached last, for the exit event handlers */
+    Addr getCurrentPc() const { return currentMarker.first; }
+    uint64_t getCurrentCount() const { return currentMarker.second; }
+
+    /** The number of target markers that have not been reached yet */
+    uint64_t numMarkersLeft() const { return markersLeft; }
+
+  private:
+    struct PairHash
+    {
+        size_t
+        operator()(const std::pair<Addr, Addr> &p) const
+        {
+            return std::hash<Addr>()(p.first * 31 + p.second);
+        }
+    };
+
+    /** End the current region at the given loop entry */
+    void endRegion(Addr pc, uint64_t count);
+
+    const bool profiling;
+    const uint64_t regionLength;
+
+    /** Remaining entry counts to exit at, sorted, for each target PC */
+    std::unordered_map<Addr, std::vector<uint64_t>> targets;
+    uint64_t markersLeft;
+    std::pair<Addr, uint64_t> currentMarker;
+
+    /** Global entry count of each loop head seen so far */
+    std::unordered_map<Addr, uint64_t> entryCounts;
+
+    unsigned numCores;
+
+    /** Ids of all the basic blocks seen so far, starting at 1 */
+    std::unordered_map<std::pair<Addr, Addr>, uint64_t, PairHash> bbIds;
+    /** Region BBV, keyed by (basic block id, core) */
+    std::unordered_map<std::pair<Addr, Addr>, uint64_t, PairHash>
+        regionCounts;
+    /** Instructions retired by all the cores in the current region */
+    uint64_t regionInsts;
+    /** Marker the current region started at, (0, 0) for the start */
+    std::pair<Addr, uint64_t> regionStart;
+    /** Number of regions written so far */
+    uint64_t bbvRegions;
+
+    OutputStream *profileStream;
+    OutputStream *markerStream;
+};
+
+class LoopPoint : public ProbeListenerObject
+{
+  public:
+    LoopPoint(const LoopPointParams &p);
+
+    void regProbeListeners() override;
+
+    /** Called for every retired macro inst with its PC */
+    void retiredPC(const uint64_t &pc);
+    /** Called for every retired branch, right after its PC */
+    void retiredBranch(const uint64_t &count);
+
+  private:
+    LoopPointManager *const loopManager;
+    /** Index of this core in the region BBVs */
+    const unsigned core;
+
+    /** PC of the last retired inst */
+    Addr lastPC;
+    /** Whether the last retired inst was a branch */
+    bool afterBranch;
+
+    /** Currently executing basic block and its inst count */
+    std::pair<Addr, Addr> currentBB;
+    uint64_t currentBBInsts;
+};
+
+} // namespace gem5
+
+#endif // __CPU_PROBES_LOOPPOINT_HH__
@@ -60,6 +60,12 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    fetch_line_buffer = Param.Bool(False, "Fetch whole cache lines and "
+        "decode from them until control leaves the line, rather than "
+        "accessing instruction memory for every instruction")
+    fetch_translation_cache = Param.Bool(False, "Reuse the last instruction "
+        "fetch translation while fetch stays in the same page, rather than "
+        "translating every instruction")
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
@@ -40,3 +40,7 @@ class BaseTimingSimpleCPU(BaseSimpleCPU):
     @classmethod
     def support_take_over(cls):
         return True
+
+    inline_responses = Param.Bool(False, "Process memory responses which "
+        "arrive on a clock edge straight away rather than through an event "
+        "for the same tick")
@@ -79,6 +79,9 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      fetch_line_buffer(p.fetch_line_buffer),
+      fetch_translation_cache(p.fetch_translation_cache),
+      fetchCaches(numThreads),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
@@ -146,6 +149,9 @@ AtomicSimpleCPU::drainResume()
     if (switchedOut())
         return;
 
+    // Memory may have been changed while drained
+    invalidateFetchCaches();
+
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
@@ -207,6 +213,8 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *old_cpu)
 
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
+
+    invalidateFetchCaches();
 }
 
 void
@@ -225,6 +233,7 @@ AtomicSimpleCPU::activateContext(ThreadID thread_num)
     assert(thread_num < numThreads);
 
     threadInfo[thread_num]->execContextStats.notIdleFraction = 1;
+    fetchCaches[thread_num].invalidate();
     Cycles delta = ticksToCycles(threadInfo[thread_num]->thread->lastActivate -
                                  threadInfo[thread_num]->thread->lastSuspend);
     baseStats.numCycles += delta;
@@ -297,6 +306,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
     if (pkt->isInvalidate() || pkt->isWrite()) {
         DPRINTF(SimpleCPU, "received invalidation for addr:%#x\n",
                 pkt->getAddr());
+        cpu->snoopFetchBuffer(pkt->getAddr(), pkt->getSize());
         for (auto &t_info : cpu->threadInfo) {
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
@@ -320,6 +330,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
         }
     }
 
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->snoopFetchBuffer(pkt->getAddr(), pkt->getSize());
+
     // if snoop invalidates, release any associated locks
     if (pkt->isInvalidate()) {
         DPRINTF(SimpleCPU, "received invalidation for addr:%#x\n",
@@ -507,6 +520,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+                    snoopFetchBuffer(pkt.getAddr(), pkt.getSize());
                 }
                 dcache_access = true;
                 panic_if(pkt.isError(), "Data write (%s) failed: %s",
@@ -594,6 +608,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            snoopFetchBuffer(pkt.getAddr(), pkt.getSize());
         }
 
         dcache_access = true;
@@ -639,6 +654,9 @@ AtomicSimpleCPU::tick()
         updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
         if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
+            // Taking an interrupt may change the instruction mappings
+            if (checkInterrupts(curThread))
+                fetchCaches[curThread].invalidate();
             checkForInterrupts();
             checkPcEventQueue();
         }
@@ -656,11 +674,18 @@ AtomicSimpleCPU::tick()
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+        bool buffered_fetch = false;
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
-            fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
-                                                 BaseMMU::Execute);
+            buffered_fetch = fetch_line_buffer && fetchFromBuffer();
+            if (!buffered_fetch &&
+                    !(fetch_translation_cache && translateFromCache())) {
+                fault = thread->mmu->translateAtomic(ifetch_req,
+                        thread->getTC(), BaseMMU::Execute);
+                if (fault == NoFault && fetch_translation_cache)
+                    cacheTranslation();
+            }
         }
 
         if (fault == NoFault) {
@@ -668,7 +693,7 @@ AtomicSimpleCPU::tick()
             bool icache_access = false;
             dcache_access = false; // assume no dcache access
 
-            if (needToFetch) {
+            if (needToFetch && !buffered_fetch) {
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -677,7 +702,8 @@ AtomicSimpleCPU::tick()
                 //if (decoder.needMoreBytes())
                 //{
                     icache_access = true;
-                    icache_latency = fetchInstMem();
+                    icache_latency = fetch_line_buffer ?
+                        fetchInstLine() : fetchInstMem();
                 //}
             }
 
@@ -704,6 +730,16 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                // Instructions which may change the instruction mappings
+                // or the instructions themselves, including TLB flushes,
+                // refetch and retranslate
+                if (curStaticInst->isNonSpeculative() ||
+                        curStaticInst->isSerializeAfter() ||
+                        curStaticInst->isSquashAfter() ||
+                        curStaticInst->isSyscall()) {
+                    invalidateFetchCaches();
+                }
             }
 
             // @todo remove me after debugging with legion done
@@ -727,6 +763,8 @@ AtomicSimpleCPU::tick()
             }
 
         }
+        if (fault != NoFault)
+            fetchCaches[curThread].invalidate();
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
     }
@@ -760,6 +798,117 @@ AtomicSimpleCPU::fetchInstMem()
     return latency;
 }
 
+bool
+AtomicSimpleCPU::fetchFromBuffer()
+{
+    FetchCache &fc = fetchCaches[curThread];
+    if (!fc.lineValid)
+        return false;
+
+    Addr vaddr = ifetch_req->getVaddr();
+    unsigned size = ifetch_req->getSize();
+    if (vaddr < fc.lineVAddr || vaddr + size > fc.lineVAddr + fc.line.size())
+        return false;
+
+    auto &decoder = threadInfo[curThread]->thread->decoder;
+    Addr offset = vaddr - fc.lineVAddr;
+    ifetch_req->setPaddr(fc.linePAddr + offset);
+    memcpy(decoder->moreBytesPtr(), fc.line.data() + offset, size);
+    return true;
+}
+
+Tick
+AtomicSimpleCPU::fetchInstLine()
+{
+    FetchCache &fc = fetchCaches[curThread];
+    Addr line_size = cacheLineSize();
+    Addr vaddr = ifetch_req->getVaddr();
+    Addr offset = vaddr & (line_size - 1);
+
+    // Only buffer ordinary memory
+    if (ifetch_req->isUncacheable() || ifetch_req->isLocalAccess() ||
+            offset + ifetch_req->getSize() > line_size) {
+        fc.lineValid = false;
+        return fetchInstMem();
+    }
+
+    auto line_req = std::make_shared<Request>(
+        ifetch_req->getPaddr() - offset, line_size,
+        ifetch_req->getFlags(), ifetch_req->requestorId());
+    line_req->setContext(ifetch_req->contextId());
+    line_req->taskId(ifetch_req->taskId());
+
+    fc.line.resize(line_size);
+    Packet pkt = Packet(line_req, MemCmd::ReadReq);
+    pkt.dataStatic(fc.line.data());
+
+    Tick latency = sendPacket(icachePort, &pkt);
+    panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
+            pkt.getAddrRange().to_string(), pkt.print());
+
+    fc.lineVAddr = vaddr - offset;
+    fc.linePAddr = line_req->getPaddr();
+    fc.lineValid = true;
+
+    auto &decoder = threadInfo[curThread]->thread->decoder;
+    memcpy(decoder->moreBytesPtr(), fc.line.data() + offset,
+           ifetch_req->getSize());
+    return latency;
+}
+
+bool
+AtomicSimpleCPU::translateFromCache()
+{
+    FetchCache &fc = fetchCaches[curThread];
+    if (!fc.pageValid)
+        return false;
+
+    Addr vaddr = ifetch_req->getVaddr();
+    Addr last = vaddr + ifetch_req->getSize() - 1;
+    Addr page_mask = fetchPageBytes - 1;
+    if ((vaddr & ~page_mask) != fc.pageVAddr ||
+            (last & ~page_mask) != fc.pageVAddr) {
+        return false;
+    }
+
+    ifetch_req->setPaddr(fc.pagePAddr | (vaddr & page_mask));
+    ifetch_req->setFlags(fc.pageFlags);
+    return true;
+}
+
+void
+AtomicSimpleCPU::cacheTranslation()
+{
+    FetchCache &fc = fetchCaches[curThread];
+    Addr vaddr = ifetch_req->getVaddr();
+    Addr page_mask = fetchPageBytes - 1;
+
+    fc.pageValid = !ifetch_req->isLocalAccess() &&
+        ((vaddr + ifetch_req->getSize() - 1) & ~page_mask) ==
+            (vaddr & ~page_mask);
+    fc.pageVAddr = vaddr & ~page_mask;
+    fc.pagePAddr = ifetch_req->getPaddr() & ~page_mask;
+    fc.pageFlags = ifetch_req->getFlags();
+}
+
+void
+AtomicSimpleCPU::invalidateFetchCaches()
+{
+    for (auto &fc : fetchCaches)
+        fc.invalidate();
+}
+
+void
+AtomicSimpleCPU::snoopFetchBuffer(Addr addr, unsigned size)
+{
+    for (auto &fc : fetchCaches) {
+        if (fc.lineValid && addr < fc.linePAddr + fc.line.size() &&
+                fc.linePAddr < addr + size) {
+            fc.lineValid = false;
+        }
+    }
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
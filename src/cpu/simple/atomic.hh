@@ -41,6 +41,8 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <vector>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
@@ -67,6 +69,52 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /**
+     * Fetch a cache line at a time and feed the decoder from it while
+     * control stays in the line, rather than accessing instruction
+     * memory for every instruction.
+     */
+    const bool fetch_line_buffer;
+
+    /**
+     * Reuse the last instruction fetch translation while fetch stays in
+     * the same page, rather than going through the MMU for every
+     * instruction.
+     */
+    const bool fetch_translation_cache;
+
+    /**
+     * Granule of the fetch translation cache.  This is the smallest page
+     * size of the supported ISAs so it never spans two pages.
+     */
+    static constexpr Addr fetchPageBytes = 4096;
+
+    /** Instruction fetch state kept across the instructions of a thread */
+    struct FetchCache
+    {
+        /** The buffered instruction line */
+        std::vector<uint8_t> line;
+        Addr lineVAddr = 0;
+        Addr linePAddr = 0;
+        bool lineValid = false;
+
+        /** The last translated fetch page */
+        Addr pageVAddr = 0;
+        Addr pagePAddr = 0;
+        Request::Flags pageFlags = 0;
+        bool pageValid = false;
+
+        void
+        invalidate()
+        {
+            lineValid = false;
+            pageValid = false;
+        }
+    };
+
+    /** Per-thread fetch state */
+    std::vector<FetchCache> fetchCaches;
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -106,6 +154,41 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     virtual Tick sendPacket(RequestPort &port, const PacketPtr &pkt);
     virtual Tick fetchInstMem();
 
+    /**
+     * Feed the decoder the bytes ifetch_req asks for from the fetch
+     * buffer.
+     *
+     * @return true if the bytes were in the buffer.
+     */
+    bool fetchFromBuffer();
+
+    /**
+     * Translate ifetch_req with the thread's last fetch translation.
+     *
+     * @return true if the request is in the last translated page.
+     */
+    bool translateFromCache();
+
+    /** Remember the translation of ifetch_req for the following fetches */
+    void cacheTranslation();
+
+    /**
+     * Drop the buffered lines and translations of all threads.  Called
+     * whenever the instruction mappings or memory may have changed.
+     */
+    void invalidateFetchCaches();
+
+    /**
+     * Fill the fetch buffer with the line holding the translated
+     * ifetch_req and feed the decoder from it.
+     *
+     * @return the latency of the fetch.
+     */
+    Tick fetchInstLine();
+
+    /** Drop the buffered lines overlapping [addr, addr + size) */
+    void snoopFetchBuffer(Addr addr, unsigned size);
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
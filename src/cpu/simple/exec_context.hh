@@ -57,7 +57,7 @@ namespace gem5
 
 class BaseSimpleCPU;
 
-class SimpleExecContext : public ExecContext
+class SimpleExecContext final : public ExecContext
 {
   public:
     BaseSimpleCPU *cpu;
@@ -311,8 +311,18 @@ class SimpleExecContext : public ExecContext
     getRegOperand(const StaticInst *si, int idx) override
     {
         const RegId &reg = si->srcRegIdx(idx);
-        if (reg.is(InvalidRegClass))
+        switch (reg.classValue()) {
+          case IntRegClass:
+            (*execContextStats.numRegReads[IntRegClass])++;
+            return thread->getRegFast<IntRegClass>(reg.index());
+          case FloatRegClass:
+            (*execContextStats.numRegReads[FloatRegClass])++;
+            return thread->getRegFast<FloatRegClass>(reg.index());
+          case InvalidRegClass:
             return 0;
+          default:
+            break;
+        }
         (*execContextStats.numRegReads[reg.classValue()])++;
         return thread->getReg(reg);
     }
@@ -333,12 +343,38 @@ class SimpleExecContext : public ExecContext
         return thread->getWritableReg(reg);
     }
 
+    const void *
+    getReadableRegOperand(const StaticInst *si, int idx) override
+    {
+        const RegId &reg = si->srcRegIdx(idx);
+        // Without renaming the register is written in place if it is
+        // also a destination.
+        for (int i = 0; i < si->numDestRegs(); i++) {
+            if (si->destRegIdx(i) == reg)
+                return nullptr;
+        }
+        (*execContextStats.numRegReads[reg.classValue()])++;
+        return thread->getWritableReg(reg);
+    }
+
     void
     setRegOperand(const StaticInst *si, int idx, RegVal val) override
     {
         const RegId &reg = si->destRegIdx(idx);
-        if (reg.is(InvalidRegClass))
+        switch (reg.classValue()) {
+          case IntRegClass:
+            (*execContextStats.numRegWrites[IntRegClass])++;
+            thread->setRegFast<IntRegClass>(reg.index(), val);
+            return;
+          case FloatRegClass:
+            (*execContextStats.numRegWrites[FloatRegClass])++;
+            thread->setRegFast<FloatRegClass>(reg.index(), val);
             return;
+          case InvalidRegClass:
+            return;
+          default:
+            break;
+        }
         (*execContextStats.numRegWrites[reg.classValue()])++;
         thread->setReg(reg, val);
     }
@@ -36,6 +36,15 @@
 from m5.params import *
 from m5.objects.Probe import ProbeListenerObject
 
+class SimPointProbe(Enum):
+    vals = [
+        # The Commit probe of the atomic simple CPU
+        'Commit',
+        # The RetiredInstsPC and RetiredBranches PMU probes every CPU
+        # model that retires instructions fires, e.g. O3 and Minor
+        'Retired',
+    ]
+
 class SimPoint(ProbeListenerObject):
     """Probe for collecting SimPoint Basic Block Vectors (BBVs)."""
 
@@ -45,3 +54,7 @@ class SimPoint(ProbeListenerObject):
 
     interval = Param.UInt64(100000000, "Interval Size (insts)")
     profile_file = Param.String("simpoint.bb.gz", "BBV (output) file")
+    probe_source = Param.SimPointProbe('Commit',
+        "Probe points the basic blocks are collected from")
+    binary_output = Param.Bool(False, "Write the BBVs in a binary format "
+        "rather than the text format SimPoint reads")
@@ -44,16 +44,26 @@ namespace gem5
 
 SimPoint::SimPoint(const SimPointParams &p)
     : ProbeListenerObject(p),
+      probeSource(p.probe_source),
+      binaryOutput(p.binary_output),
       intervalSize(p.interval),
       intervalCount(0),
       intervalDrift(0),
       simpointStream(NULL),
       currentBBV(0, 0),
-      currentBBVInstCount(0)
+      currentBBVInstCount(0),
+      lastRetiredPC(0)
 {
-    simpointStream = simout.create(p.profile_file, false);
+    simpointStream = simout.create(p.profile_file, binaryOutput);
     if (!simpointStream)
         fatal("unable to open SimPoint profile_file");
+
+    if (binaryOutput) {
+        std::ostream &os = *simpointStream->stream();
+        os.write("GEM5BBV", 8);
+        os.write(reinterpret_cast<const char *>(&BinaryVersion),
+                 sizeof(BinaryVersion));
+    }
 }
 
 SimPoint::~SimPoint()
@@ -68,6 +78,15 @@ SimPoint::init()
 void
 SimPoint::regProbeListeners()
 {
+    if (probeSource == enums::SimPointProbe::Retired) {
+        typedef ProbeListenerArg<SimPoint, uint64_t> RetiredListener;
+        listeners.push_back(new RetiredListener(this, "RetiredInstsPC",
+                                                &SimPoint::profileRetired));
+        listeners.push_back(new RetiredListener(this, "RetiredBranches",
+                                                &SimPoint::profileBranch));
+        return;
+    }
+
     typedef ProbeListenerArg<SimPoint, std::pair<SimpleThread*,StaticInstPtr>>
         SimPointListener;
     listeners.push_back(new SimPointListener(this, "Commit",
@@ -83,63 +102,109 @@ SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
     if (inst->isMicroop() && !inst->isLastMicroop())
         return;
 
+    profileInst(thread->pcState().instAddr(), inst->isControl());
+}
+
+void
+SimPoint::profileRetired(const uint64_t &pc)
+{
+    lastRetiredPC = pc;
+    profileInst(pc, false);
+}
+
+void
+SimPoint::profileBranch(const uint64_t &count)
+{
+    // The CPU reports a retired branch right after its PC
+    if (currentBBVInstCount)
+        endBasicBlock(lastRetiredPC);
+}
+
+void
+SimPoint::profileInst(Addr pc, bool is_control)
+{
     if (!currentBBVInstCount)
-        currentBBV.first = thread->pcState().instAddr();
+        currentBBV.first = pc;
 
     ++intervalCount;
     ++currentBBVInstCount;
 
     // If inst is control inst, assume end of basic block.
-    if (inst->isControl()) {
-        currentBBV.second = thread->pcState().instAddr();
+    if (is_control)
+        endBasicBlock(pc);
+}
+
+void
+SimPoint::endBasicBlock(Addr pc)
+{
+    currentBBV.second = pc;
 
+    BBCacheEntry &entry = bbCache[
+        ((currentBBV.first >> 2) ^ (currentBBV.second >> 4)) %
+        BBCacheSize];
+    if (!entry.info || entry.range != currentBBV) {
         auto map_itr = bbMap.find(currentBBV);
-        if (map_itr == bbMap.end()){
+        if (map_itr == bbMap.end()) {
             // If a new (previously unseen) basic block is found,
             // add a new unique id, record num of insts and insert
             // into bbMap.
             BBInfo info;
             info.id = bbMap.size() + 1;
             info.insts = currentBBVInstCount;
-            info.count = currentBBVInstCount;
-            bbMap.insert(std::make_pair(currentBBV, info));
-        } else {
-            // If basic block is seen before, just increment the count by the
-            // number of insts in basic block.
-            BBInfo& info = map_itr->second;
-            info.count += currentBBVInstCount;
+            info.count = 0;
+            map_itr = bbMap.insert(std::make_pair(currentBBV, info)).first;
         }
-        currentBBVInstCount = 0;
-
-        // Reached end of interval if the sum of the current inst count
-        // (intervalCount) and the excessive inst count from the previous
-        // interval (intervalDrift) is greater than/equal to the interval size.
-        if (intervalCount + intervalDrift >= intervalSize) {
-            // summarize interval and display BBV info
-            std::vector<std::pair<uint64_t, uint64_t> > counts;
-            for (auto map_itr = bbMap.begin(); map_itr != bbMap.end();
-                    ++map_itr) {
-                BBInfo& info = map_itr->second;
-                if (info.count != 0) {
-                    counts.push_back(std::make_pair(info.id, info.count));
-                    info.count = 0;
-                }
-            }
-            std::sort(counts.begin(), counts.end());
-
-            // Print output BBV info
-            *simpointStream->stream() << "T";
-            for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
-                    ++cnt_itr) {
-                *simpointStream->stream() << ":" << cnt_itr->first
-                                << ":" << cnt_itr->second << " ";
-            }
-            *simpointStream->stream() << "\n";
-
-            intervalDrift = (intervalCount + intervalDrift) - intervalSize;
-            intervalCount = 0;
+        entry.range = currentBBV;
+        entry.info = &map_itr->second;
+    }
+
+    // Increment the count by the number of insts in basic block.
+    BBInfo &info = *entry.info;
+    if (info.count == 0)
+        intervalBBs.push_back(&info);
+    info.count += currentBBVInstCount;
+    currentBBVInstCount = 0;
+
+    // Reached end of interval if the sum of the current inst count
+    // (intervalCount) and the excessive inst count from the previous
+    // interval (intervalDrift) is greater than/equal to the interval size.
+    if (intervalCount + intervalDrift >= intervalSize) {
+        dumpInterval();
+        intervalDrift = (intervalCount + intervalDrift) - intervalSize;
+        intervalCount = 0;
+    }
+}
+
+void
+SimPoint::dumpInterval()
+{
+    // summarize interval and display BBV info
+    std::vector<std::pair<uint64_t, uint64_t> > counts;
+    counts.reserve(intervalBBs.size());
+    for (BBInfo *info : intervalBBs) {
+        counts.push_back(std::make_pair(info->id, info->count));
+        info->count = 0;
+    }
+    intervalBBs.clear();
+    std::sort(counts.begin(), counts.end());
+
+    std::ostream &os = *simpointStream->stream();
+    if (binaryOutput) {
+        uint32_t num_entries = counts.size();
+        os.write(reinterpret_cast<const char *>(&num_entries),
+                 sizeof(num_entries));
+        for (const auto &cnt : counts) {
+            uint64_t fields[2] = { cnt.first, cnt.second };
+            os.write(reinterpret_cast<const char *>(fields), sizeof(fields));
         }
+        return;
     }
+
+    // Print output BBV info
+    os << "T";
+    for (const auto &cnt : counts)
+        os << ":" << cnt.first << ":" << cnt.second << " ";
+    os << "\n";
 }
 
 } // namespace gem5
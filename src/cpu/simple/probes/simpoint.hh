@@ -38,7 +38,9 @@
 #ifndef __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 #define __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 
+#include <array>
 #include <unordered_map>
+#include <vector>
 
 #include "base/output.hh"
 #include "cpu/simple_thread.hh"
@@ -50,6 +52,14 @@ namespace gem5
 
 /**
  * Probe for SimPoints BBV generation
+ *
+ * The BBVs are either written as text, in the format SimPoint 3.2
+ * reads, or in a binary format with one record per interval:
+ *  - header: the magic "GEM5BBV" plus a NUL, then a uint32_t version
+ *  - per interval: a uint32_t number of entries, followed by that many
+ *    pairs of uint64_t basic block id and instruction count, sorted by
+ *    id.
+ * All the fields are in host byte order.
  */
 
 /**
@@ -96,7 +106,27 @@ class SimPoint : public ProbeListenerObject
      */
     void profile(const std::pair<SimpleThread*, StaticInstPtr>&);
 
+    /** Record a retired macro inst, from the RetiredInstsPC probe. */
+    void profileRetired(const uint64_t &pc);
+    /** End the current basic block, from the RetiredBranches probe. */
+    void profileBranch(const uint64_t &count);
+
+    /** Version written in the header of binary BBV files */
+    static constexpr uint32_t BinaryVersion = 1;
+
   private:
+    /** Count a macro inst, ending the basic block if it is a control */
+    void profileInst(Addr pc, bool is_control);
+    /** The current basic block ends with the inst at pc */
+    void endBasicBlock(Addr pc);
+    /** Write the BBV of the interval that just ended */
+    void dumpInterval();
+
+    /** Probe points the BBVs are collected from */
+    const enums::SimPointProbe probeSource;
+    /** Whether the BBVs are written in the binary format */
+    const bool binaryOutput;
+
     /** SimPoint profiling interval size in instructions */
     const uint64_t intervalSize;
 
@@ -120,10 +150,28 @@ class SimPoint : public ProbeListenerObject
 
     /** Hash table containing all previously seen basic blocks */
     std::unordered_map<BasicBlockRange, BBInfo> bbMap;
+
+    /**
+     * Direct-mapped cache in front of bbMap. The map never erases
+     * entries, so the pointers it holds stay valid.
+     */
+    struct BBCacheEntry
+    {
+        BasicBlockRange range;
+        BBInfo *info = nullptr;
+    };
+    static constexpr size_t BBCacheSize = 4096;
+    std::array<BBCacheEntry, BBCacheSize> bbCache;
+
+    /** Basic blocks that executed in the current interval */
+    std::vector<BBInfo *> intervalBBs;
+
     /** Currently executing basic block */
     BasicBlockRange currentBBV;
     /** inst count in current basic block */
     uint64_t currentBBVInstCount;
+    /** PC of the last inst seen through the RetiredInstsPC probe */
+    Addr lastRetiredPC;
 };
 
 } // namespace gem5
@@ -77,6 +77,7 @@ TimingSimpleCPU::TimingCPUPort::TickEvent::schedule(PacketPtr _pkt, Tick t)
 TimingSimpleCPU::TimingSimpleCPU(const BaseTimingSimpleCPUParams &p)
     : BaseSimpleCPU(p), fetchTranslation(this), icachePort(this),
       dcachePort(this), ifetch_pkt(NULL), dcache_pkt(NULL), previousCycle(0),
+      inlineResponses(p.inline_responses),
       fetchEvent([this]{ fetch(); }, name())
 {
     _status = Idle;
@@ -464,7 +465,7 @@ TimingSimpleCPU::initiateMemRead(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -546,7 +547,7 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -602,7 +603,7 @@ TimingSimpleCPU::initiateMemAMO(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(addr, size, flags,
+    RequestPtr req = Request::create(addr, size, flags,
                             dataRequestorId(), pc, thread->contextId(),
                             std::move(amo_op));
 
@@ -699,7 +700,7 @@ TimingSimpleCPU::fetch()
 
     if (needToFetch) {
         _status = BaseSimpleCPU::Running;
-        RequestPtr ifetch_req = std::make_shared<Request>();
+        RequestPtr ifetch_req = Request::create();
         ifetch_req->taskId(taskId());
         ifetch_req->setContext(thread->contextId());
         setupFetchRequest(ifetch_req);
@@ -920,6 +921,16 @@ TimingSimpleCPU::IcachePort::recvTimingResp(PacketPtr pkt)
     // we should only ever see one response per cycle since we only
     // issue a new request once this response is sunk
     assert(!tickEvent.scheduled());
+
+    // A response on a clock edge would be processed in this tick anyway.
+    // The status check falls back to the event for a response sent from
+    // within our own request.
+    if (cpu->inlineResponses && cpu->clockEdge() == curTick() &&
+            cpu->_status == IcacheWaitResponse) {
+        cpu->completeIfetch(pkt);
+        return true;
+    }
+
     // delay processing of returned data until next CPU clock edge
     tickEvent.schedule(pkt, cpu->clockEdge());
 
@@ -1143,6 +1154,14 @@ TimingSimpleCPU::DcachePort::recvTimingResp(PacketPtr pkt)
     // The timing CPU is not really ticked, instead it relies on the
     // memory system (fetch and load/store) to set the pace.
     if (!tickEvent.scheduled()) {
+        // As for fetches, a response on a clock edge can be processed
+        // straight away
+        if (cpu->inlineResponses && cpu->clockEdge() == curTick() &&
+                cpu->_status == DcacheWaitResponse) {
+            cpu->completeDataAccess(pkt);
+            return true;
+        }
+
         // Delay processing of returned data until next CPU clock edge
         tickEvent.schedule(pkt, cpu->clockEdge());
         return true;
@@ -1245,7 +1264,7 @@ TimingSimpleCPU::initiateMemMgmtCmd(Request::Flags flags)
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
@@ -1300,7 +1319,7 @@ TimingSimpleCPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
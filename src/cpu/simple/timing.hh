@@ -263,6 +263,13 @@ class TimingSimpleCPU : public BaseSimpleCPU
 
     Cycles previousCycle;
 
+    /**
+     * Complete fetches and data accesses whose response arrives on a
+     * clock edge while the CPU waits for it straight away, rather than
+     * through the port's tick event scheduled for the same tick.
+     */
+    const bool inlineResponses;
+
   protected:
 
      /** Return a reference to the data port. */
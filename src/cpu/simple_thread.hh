@@ -92,7 +92,7 @@ class CheckerCPU;
  * examples.
  */
 
-class SimpleThread : public ThreadState, public ThreadContext
+class SimpleThread final : public ThreadState, public ThreadContext
 {
   public:
     typedef ThreadContext::Status Status;
@@ -333,6 +333,37 @@ class SimpleThread : public ThreadState, public ThreadContext
         return val;
     }
 
+    /**
+     * Typed accessors for callers which know both that they have a
+     * SimpleThread and the class of the register at compile time, like
+     * the exec contexts of the simple and minor CPUs. Flattening and the
+     * register file lookup fold down to the minimum for the class.
+     */
+    template <RegClassType Cls>
+    RegVal
+    getRegFast(RegIndex arch_idx) const
+    {
+        const RegIndex idx = isa->flattenRegId(RegId(Cls, arch_idx)).index();
+        const auto &reg_file = regFiles[Cls];
+
+        RegVal val = reg_file.reg(idx);
+        DPRINTFV(reg_file.regClass.debug(), "Reading %s reg %d as %#x.\n",
+                RegId(Cls, idx).className(), idx, val);
+        return val;
+    }
+
+    template <RegClassType Cls>
+    void
+    setRegFast(RegIndex arch_idx, RegVal val)
+    {
+        const RegIndex idx = isa->flattenRegId(RegId(Cls, arch_idx)).index();
+        auto &reg_file = regFiles[Cls];
+
+        DPRINTFV(reg_file.regClass.debug(), "Setting %s register %d to %#x.\n",
+                RegId(Cls, idx).className(), idx, val);
+        reg_file.reg(idx) = val;
+    }
+
     RegVal
     getRegFlat(const RegId &reg) const override
     {
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/branch_trace/branch_trace_driver.hh"
+
+#include <chrono>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/BranchTrace.hh"
+#include "proto/branch.pb.h"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+BranchTraceDriver::BranchInst::BranchInst(bool cond, bool direct, bool call,
+                                          bool ret)
+    : StaticInst("branch", No_OpClass)
+{
+    flags[IsControl] = true;
+    flags[IsCondControl] = cond;
+    flags[IsUncondControl] = !cond;
+    flags[IsDirectControl] = direct;
+    flags[IsIndirectControl] = !direct;
+    flags[IsCall] = call;
+    flags[IsReturn] = ret;
+}
+
+Fault
+BranchTraceDriver::BranchInst::execute(ExecContext *xc,
+                                       Trace::InstRecord *traceData) const
+{
+    panic("Traced branches can't be executed\n");
+}
+
+std::unique_ptr<PCStateBase>
+BranchTraceDriver::BranchInst::buildRetPC(const PCStateBase &cur_pc,
+                                          const PCStateBase &call_pc) const
+{
+    std::unique_ptr<PCStateBase> ret_pc(call_pc.clone());
+    ret_pc->uReset();
+    ret_pc->advance();
+    return ret_pc;
+}
+
+std::string
+BranchTraceDriver::BranchInst::generateDisassembly(
+        Addr pc, const loader::SymbolTable *symtab) const
+{
+    return csprintf("%-10s", mnemonic);
+}
+
+BranchTraceDriver::BranchTraceDriver(const Params &p)
+    : SimObject(p),
+      trace(p.trace_file),
+      predictors(p.predictors),
+      maxBranches(p.max_branches),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+    fatal_if(predictors.empty(), "%s: No branch predictors to drive\n",
+             name());
+
+    using T = ProtoMessage::Branch;
+    branchInsts[T::CondDirect] = new BranchInst(true, true, false, false);
+    branchInsts[T::UncondDirect] = new BranchInst(false, true, false, false);
+    branchInsts[T::CondIndirect] = new BranchInst(true, false, false, false);
+    branchInsts[T::UncondIndirect] =
+        new BranchInst(false, false, false, false);
+    branchInsts[T::CallDirect] = new BranchInst(false, true, true, false);
+    branchInsts[T::CallIndirect] = new BranchInst(false, false, true, false);
+    branchInsts[T::Return] = new BranchInst(false, false, false, true);
+
+    ProtoMessage::BranchHeader header;
+    fatal_if(!trace.read(header), "%s: Failed to read branch trace header "
+             "from %s\n", name(), p.trace_file);
+    DPRINTF(BranchTrace, "Replaying branch trace recorded by %s\n",
+            header.obj_id());
+}
+
+void
+BranchTraceDriver::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+bool
+BranchTraceDriver::readBranch(TraceBranch &branch)
+{
+    ProtoMessage::Branch msg;
+    if (!trace.read(msg))
+        return false;
+
+    branch.pc = msg.pc();
+    branch.target = msg.target();
+    branch.size = msg.size();
+    branch.insts = msg.insts();
+    branch.taken = msg.taken();
+    branch.type = msg.type();
+    return true;
+}
+
+void
+BranchTraceDriver::replay()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    TraceBranch branch;
+    InstSeqNum seq_num = 0;
+    while ((!maxBranches || seq_num < maxBranches) && readBranch(branch)) {
+        ++seq_num;
+        const StaticInstPtr &inst = branchInsts[branch.type];
+        const Addr actual = branch.taken ?
+            branch.target : branch.pc + branch.size;
+
+        for (int i = 0; i < predictors.size(); ++i) {
+            TracePCState pc(branch.pc, branch.size);
+            predictors[i]->predict(inst, seq_num, pc, 0);
+            if (pc.instAddr() != actual) {
+                DPRINTF(BranchTrace, "%s mispredicted %#x: %#x instead "
+                        "of %#x\n", predictors[i]->name(), branch.pc,
+                        pc.instAddr(), actual);
+                ++stats.mispredicts[i];
+                predictors[i]->squash(seq_num,
+                                      TracePCState(actual, branch.size),
+                                      branch.taken, 0);
+            }
+            predictors[i]->update(seq_num, 0);
+        }
+
+        ++stats.branches;
+        stats.insts += branch.insts;
+    }
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    stats.hostSeconds += elapsed.count();
+
+    inform("%s: Replayed %d branches into %d predictors in %.2fs\n",
+           name(), seq_num, predictors.size(), elapsed.count());
+    exitSimLoop("branch trace replay complete");
+}
+
+BranchTraceDriver::DriverStats::DriverStats(BranchTraceDriver *driver)
+    : statistics::Group(driver), driver(*driver),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of branches replayed"),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions covered by the trace"),
+      ADD_STAT(mispredicts, statistics::units::Count::get(),
+               "Number of mispredicted branches per predictor"),
+      ADD_STAT(mpki, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Count>::get(),
+               "Mispredictions per thousand instructions per predictor",
+               mispredicts * 1000 / insts),
+      ADD_STAT(hostSeconds, statistics::units::Second::get(),
+               "Host time spent replaying the trace"),
+      ADD_STAT(hostBranchRate, statistics::units::Rate<
+                    statistics::units::Count,
+                    statistics::units::Second>::get(),
+               "Branches replayed per host second",
+               branches / hostSeconds)
+{
+}
+
+void
+BranchTraceDriver::DriverStats::regStats()
+{
+    statistics::Group::regStats();
+
+    mispredicts.init(driver.predictors.size());
+    for (int i = 0; i < driver.predictors.size(); ++i) {
+        const std::string &name = driver.predictors[i]->name();
+        mispredicts.subname(i, name.substr(name.rfind('.') + 1));
+    }
+}
+
+} // namespace gem5
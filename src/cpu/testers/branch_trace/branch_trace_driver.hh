@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a driver that replays a branch trace into one or
+ * more branch predictors without a CPU model.
+ */
+
+#ifndef __CPU_TESTERS_BRANCH_TRACE_BRANCH_TRACE_DRIVER_HH__
+#define __CPU_TESTERS_BRANCH_TRACE_BRANCH_TRACE_DRIVER_HH__
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/statistics.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/static_inst.hh"
+#include "params/BranchTraceDriver.hh"
+#include "proto/protoio.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * The branch trace driver reads a protobuf trace of committed control
+ * instructions and feeds every branch to each of its predictors in
+ * turn. A branch is predicted, squashed if the prediction was wrong
+ * and then committed, just like a CPU with no other branches in
+ * flight would do. Once the trace is exhausted the driver exits the
+ * simulation loop.
+ */
+class BranchTraceDriver : public SimObject
+{
+  public:
+    PARAMS(BranchTraceDriver);
+    BranchTraceDriver(const Params &p);
+
+    void startup() override;
+
+  private:
+    /** Number of branch types in the trace format */
+    static constexpr int NumBranchTypes = 7;
+
+    /**
+     * PC state for traced instructions. Instructions can be of any
+     * size, so the size of the current instruction is carried along
+     * to compute the fall-through address.
+     */
+    class TracePCState : public GenericISA::PCStateWithNext
+    {
+      protected:
+        Addr size = 4;
+
+      public:
+        TracePCState(Addr pc, Addr inst_size) : size(inst_size)
+        {
+            set(pc);
+        }
+        TracePCState(const TracePCState &other) = default;
+
+        PCStateBase *
+        clone() const override
+        {
+            return new TracePCState(*this);
+        }
+
+        void
+        set(Addr val)
+        {
+            pc(val);
+            npc(val + size);
+        }
+
+        void
+        update(const PCStateBase &other) override
+        {
+            PCStateWithNext::update(other);
+            size = other.as<TracePCState>().size;
+        }
+
+        bool branching() const override { return npc() != pc() + size; }
+
+        void
+        advance() override
+        {
+            _pc = _npc;
+            _npc += size;
+        }
+    };
+
+    /**
+     * Stand-in for a decoded branch. Predictors only inspect the
+     * control flags and use the instruction to advance the PC, so
+     * there is one instance per branch type.
+     */
+    class BranchInst : public StaticInst
+    {
+      public:
+        BranchInst(bool cond, bool direct, bool call, bool ret);
+
+        Fault execute(ExecContext *xc,
+                      Trace::InstRecord *traceData) const override;
+
+        void
+        advancePC(PCStateBase &pc) const override
+        {
+            pc.as<TracePCState>().advance();
+        }
+
+        std::unique_ptr<PCStateBase> buildRetPC(
+                const PCStateBase &cur_pc,
+                const PCStateBase &call_pc) const override;
+
+        std::string generateDisassembly(
+                Addr pc, const loader::SymbolTable *symtab) const override;
+    };
+
+    /** A branch as read from the trace */
+    struct TraceBranch
+    {
+        Addr pc;
+        Addr target;
+        Addr size;
+        uint32_t insts;
+        bool taken;
+        int type;
+    };
+
+    /** Read the next branch, returns false at the end of the trace */
+    bool readBranch(TraceBranch &branch);
+
+    /** Feed the whole trace to the predictors */
+    void replay();
+
+    /** Input stream used for reading the trace */
+    ProtoInputStream trace;
+
+    /** Predictors the trace is replayed into */
+    std::vector<branch_prediction::BPredUnit *> predictors;
+
+    /** Stop after this many branches, 0 to replay the whole trace */
+    const uint64_t maxBranches;
+
+    /** One static instruction per branch type */
+    std::array<StaticInstPtr, NumBranchTypes> branchInsts;
+
+    EventFunctionWrapper replayEvent;
+
+    struct DriverStats : public statistics::Group
+    {
+        DriverStats(BranchTraceDriver *driver);
+
+        void regStats() override;
+
+        const BranchTraceDriver &driver;
+
+        /** Number of branches replayed */
+        statistics::Scalar branches;
+        /** Number of instructions represented by the trace */
+        statistics::Scalar insts;
+        /** Mispredicted branches per predictor */
+        statistics::Vector mispredicts;
+        /** Mispredictions per thousand instructions per predictor */
+        statistics::Formula mpki;
+        /** Host time spent replaying the trace */
+        statistics::Scalar hostSeconds;
+        /** Branches replayed per predictor and host second */
+        statistics::Formula hostBranchRate;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TESTERS_BRANCH_TRACE_BRANCH_TRACE_DRIVER_HH__
@@ -70,6 +70,15 @@ GarnetSyntheticTraffic::sendPkt(PacketPtr pkt)
         retryPkt = pkt; // RubyPort will retry sending
     }
     numPacketsSent++;
+    stats.numPackets++;
+}
+
+GarnetSyntheticTraffic::GarnetSyntheticTrafficStats::
+GarnetSyntheticTrafficStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(numPackets, statistics::units::Count::get(),
+               "Number of packets injected into the network")
+{
 }
 
 GarnetSyntheticTraffic::GarnetSyntheticTraffic(const Params &p)
@@ -91,7 +100,8 @@ GarnetSyntheticTraffic::GarnetSyntheticTraffic(const Params &p)
       injVnet(p.inj_vnet),
       precision(p.precision),
       responseLimit(p.response_limit),
-      requestorId(p.system->getRequestorId(this))
+      requestorId(p.system->getRequestorId(this)),
+      stats(this)
 {
     // set up counters
     noResponseCycles = 0;
@@ -135,6 +135,12 @@ class GarnetSyntheticTraffic : public ClockedObject
 
     RequestorID requestorId;
 
+    struct GarnetSyntheticTrafficStats : public statistics::Group
+    {
+        GarnetSyntheticTrafficStats(statistics::Group *parent);
+        statistics::Scalar numPackets;
+    } stats;
+
     void completeRequest(PacketPtr pkt);
 
     void generatePkt();
@@ -44,6 +44,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/MemTest.hh"
@@ -174,6 +175,9 @@ class MemTest : public ClockedObject
     const bool atomic;
 
     const bool suppressFuncErrors;
+
+    /** Random accesses of this tester, independent of other testers */
+    RandomStream rng;
   protected:
     struct MemTestStats : public statistics::Group
     {
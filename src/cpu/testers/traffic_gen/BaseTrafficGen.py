@@ -80,6 +80,11 @@ class BaseTrafficGen(ClockedObject):
     progress_check = Param.Latency('1ms', "Time before exiting " \
                                    "due to lack of progress")
 
+    # Packets due on the same tick are issued by one update event, up
+    # to this many, instead of scheduling an event per packet.
+    max_packets_per_update = Param.Unsigned(1,
+        "Maximum number of packets issued by a single update event")
+
     # Generator type used for applying Stream and/or Substream IDs to requests
     stream_gen = Param.StreamGenType('none',
         "Generator for adding Stream and/or Substream ID's to requests")
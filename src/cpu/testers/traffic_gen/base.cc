@@ -48,6 +48,7 @@
 #include "cpu/testers/traffic_gen/hybrid_gen.hh"
 #include "cpu/testers/traffic_gen/idle_gen.hh"
 #include "cpu/testers/traffic_gen/linear_gen.hh"
+#include "cpu/testers/traffic_gen/multi_stream_gen.hh"
 #include "cpu/testers/traffic_gen/nvm_gen.hh"
 #include "cpu/testers/traffic_gen/random_gen.hh"
 #include "cpu/testers/traffic_gen/stream_gen.hh"
@@ -76,6 +77,7 @@ BaseTrafficGen::BaseTrafficGen(const BaseTrafficGenParams &p)
       nextTransitionTick(0),
       nextPacketTick(0),
       maxOutstandingReqs(p.max_outstanding_reqs),
+      maxPacketsPerUpdate(p.max_packets_per_update),
       port(name() + ".port", *this),
       retryPkt(NULL),
       retryPktTick(0), blockedWaitingResp(false),
@@ -165,6 +167,49 @@ BaseTrafficGen::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(nextPacketTick);
 }
 
+void
+BaseTrafficGen::issuePacket()
+{
+    // get the next packet and try to send it
+    PacketPtr pkt = activeGenerator->getNextPacket();
+
+    // If generating stream/substream IDs are enabled,
+    // try to pick and assign them to the new packet
+    if (streamGenerator) {
+        auto sid = streamGenerator->pickStreamID();
+        auto ssid = streamGenerator->pickSubstreamID();
+
+        pkt->req->setStreamId(sid);
+
+        if (streamGenerator->ssidValid()) {
+            pkt->req->setSubstreamId(ssid);
+        }
+    }
+
+    // suppress packets that are not destined for a memory, such as
+    // device accesses that could be part of a trace
+    if (pkt && system->isMemAddr(pkt->getAddr())) {
+        stats.numPackets++;
+        // Only attempts to send if not blocked by pending responses
+        blockedWaitingResp = allocateWaitingRespSlot(pkt);
+        if (blockedWaitingResp || !port.sendTimingReq(pkt)) {
+            retryPkt = pkt;
+            retryPktTick = curTick();
+        }
+    } else if (pkt) {
+        DPRINTF(TrafficGen, "Suppressed packet %s 0x%x\n",
+                pkt->cmdString(), pkt->getAddr());
+
+        ++stats.numSuppressed;
+        if (!(static_cast<int>(stats.numSuppressed.value()) % 10000))
+            warn("%s suppressed %d packets with non-memory addresses\n",
+                 name(), stats.numSuppressed.value());
+
+        BaseGen::releasePacket(pkt);
+        pkt = nullptr;
+    }
+}
+
 void
 BaseTrafficGen::update()
 {
@@ -177,49 +222,27 @@ BaseTrafficGen::update()
         transition();
     } else {
         assert(curTick() >= nextPacketTick);
-        // get the next packet and try to send it
-        PacketPtr pkt = activeGenerator->getNextPacket();
-
-        // If generating stream/substream IDs are enabled,
-        // try to pick and assign them to the new packet
-        if (streamGenerator) {
-            auto sid = streamGenerator->pickStreamID();
-            auto ssid = streamGenerator->pickSubstreamID();
-
-            pkt->req->setStreamId(sid);
-
-            if (streamGenerator->ssidValid()) {
-                pkt->req->setSubstreamId(ssid);
+        // keep sending while the next packet is already due, rather
+        // than scheduling an event for each of them
+        for (unsigned issued = 1; ; ++issued) {
+            issuePacket();
+            if (retryPkt)
+                return;
+
+            nextPacketTick = activeGenerator->nextPacketTick(elasticReq, 0);
+            if (issued >= maxPacketsPerUpdate ||
+                nextPacketTick > curTick() ||
+                curTick() >= nextTransitionTick) {
+                break;
             }
         }
-
-        // suppress packets that are not destined for a memory, such as
-        // device accesses that could be part of a trace
-        if (pkt && system->isMemAddr(pkt->getAddr())) {
-            stats.numPackets++;
-            // Only attempts to send if not blocked by pending responses
-            blockedWaitingResp = allocateWaitingRespSlot(pkt);
-            if (blockedWaitingResp || !port.sendTimingReq(pkt)) {
-                retryPkt = pkt;
-                retryPktTick = curTick();
-            }
-        } else if (pkt) {
-            DPRINTF(TrafficGen, "Suppressed packet %s 0x%x\n",
-                    pkt->cmdString(), pkt->getAddr());
-
-            ++stats.numSuppressed;
-            if (!(static_cast<int>(stats.numSuppressed.value()) % 10000))
-                warn("%s suppressed %d packets with non-memory addresses\n",
-                     name(), stats.numSuppressed.value());
-
-            delete pkt;
-            pkt = nullptr;
-        }
+        scheduleUpdate();
+        return;
     }
 
     // if we are waiting for a retry or for a response, do not schedule any
-    // further events, in the case of a transition or a successful send, go
-    // ahead and determine when the next update should take place
+    // further events, in the case of a transition go ahead and determine
+    // when the next update should take place
     if (retryPkt == NULL) {
         nextPacketTick = activeGenerator->nextPacketTick(elasticReq, 0);
         scheduleUpdate();
@@ -542,6 +565,28 @@ BaseTrafficGen::createStrided(Tick duration,
                                                   read_percent, data_limit));
 }
 
+std::shared_ptr<BaseGen>
+BaseTrafficGen::createMultiStream(Tick duration,
+                                 Addr start_addr, Addr end_addr,
+                                 Addr blocksize,
+                                 Tick min_period, Tick max_period,
+                                 uint8_t read_percent, Addr data_limit,
+                                 unsigned int num_streams,
+                                 unsigned int burst_len,
+                                 const std::vector<double> &period_curve)
+{
+    return std::shared_ptr<BaseGen>(new MultiStreamGen(*this, requestorId,
+                                                       duration, start_addr,
+                                                       end_addr, blocksize,
+                                                       system->cacheLineSize(),
+                                                       min_period, max_period,
+                                                       read_percent,
+                                                       data_limit,
+                                                       num_streams,
+                                                       burst_len,
+                                                       period_curve));
+}
+
 std::shared_ptr<BaseGen>
 BaseTrafficGen::createTrace(Tick duration,
                             const std::string& trace_file, Addr addr_offset)
@@ -577,7 +622,7 @@ BaseTrafficGen::recvTimingResp(PacketPtr pkt)
 
     waitingResp.erase(iter);
 
-    delete pkt;
+    BaseGen::releasePacket(pkt);
 
     // Sends up the request if we were blocked
     if (blockedWaitingResp) {
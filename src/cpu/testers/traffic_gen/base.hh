@@ -41,6 +41,7 @@
 #include <memory>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "enums/AddrMap.hh"
@@ -125,6 +126,9 @@ class BaseTrafficGen : public ClockedObject
 
     const int maxOutstandingReqs;
 
+    /** Most packets issued by a single update event. */
+    const unsigned maxPacketsPerUpdate;
+
 
     /** Request port specialisation for the traffic generator */
     class TrafficGenPort : public RequestPort
@@ -160,6 +164,9 @@ class BaseTrafficGen : public ClockedObject
      */
     void update();
 
+    /** Get a packet from the active generator and try to send it. */
+    void issuePacket();
+
     /** The instance of request port used by the traffic generator. */
     TrafficGenPort port;
 
@@ -325,6 +332,14 @@ class BaseTrafficGen : public ClockedObject
         Tick min_period, Tick max_period,
         uint8_t read_percent, Addr data_limit);
 
+    std::shared_ptr<BaseGen> createMultiStream(
+        Tick duration,
+        Addr start_addr, Addr end_addr, Addr blocksize,
+        Tick min_period, Tick max_period,
+        uint8_t read_percent, Addr data_limit,
+        unsigned int num_streams, unsigned int burst_len,
+        const std::vector<double> &period_curve);
+
     std::shared_ptr<BaseGen> createTrace(
         Tick duration,
         const std::string& trace_file, Addr addr_offset);
@@ -38,6 +38,9 @@
 #include "cpu/testers/traffic_gen/base_gen.hh"
 
 #include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "base/logging.hh"
 #include "cpu/testers/traffic_gen/base.hh"
@@ -45,6 +48,22 @@
 namespace gem5
 {
 
+namespace
+{
+
+/**
+ * Data buffers of the packets that came back, by size. A generator
+ * running at line rate otherwise allocates and frees a buffer per
+ * request.
+ */
+thread_local std::unordered_map<unsigned,
+    std::vector<std::unique_ptr<uint8_t[]>>> dataPool;
+
+/** Buffers kept per size, beyond which they are freed */
+constexpr size_t maxPooledBuffers = 4096;
+
+} // anonymous namespace
+
 BaseGen::BaseGen(SimObject &obj, RequestorID requestor_id, Tick _duration)
     : _name(obj.name()), requestorId(requestor_id),
       duration(_duration)
@@ -65,8 +84,21 @@ BaseGen::getPacket(Addr addr, unsigned size, const MemCmd& cmd,
     // Embed it in a packet
     PacketPtr pkt = new Packet(req, cmd);
 
-    uint8_t* pkt_data = new uint8_t[req->getSize()];
-    pkt->dataDynamic(pkt_data);
+    // Only the packets coming back to releasePacket use pooled data
+    uint8_t* pkt_data;
+    if (cmd.needsResponse()) {
+        auto &pool = dataPool[size];
+        if (pool.empty()) {
+            pkt_data = new uint8_t[size];
+        } else {
+            pkt_data = pool.back().release();
+            pool.pop_back();
+        }
+        pkt->dataStatic(pkt_data);
+    } else {
+        pkt_data = new uint8_t[size];
+        pkt->dataDynamic(pkt_data);
+    }
 
     if (cmd.isWrite()) {
         std::fill_n(pkt_data, req->getSize(), (uint8_t)requestorId);
@@ -75,6 +107,18 @@ BaseGen::getPacket(Addr addr, unsigned size, const MemCmd& cmd,
     return pkt;
 }
 
+void
+BaseGen::releasePacket(PacketPtr pkt)
+{
+    if (pkt->isResponse() || pkt->needsResponse()) {
+        std::unique_ptr<uint8_t[]> data(pkt->getPtr<uint8_t>());
+        auto &pool = dataPool[pkt->req->getSize()];
+        if (pool.size() < maxPooledBuffers)
+            pool.push_back(std::move(data));
+    }
+    delete pkt;
+}
+
 StochasticGen::StochasticGen(SimObject &obj,
                              RequestorID requestor_id, Tick _duration,
                              Addr start_addr, Addr end_addr,
@@ -83,6 +83,17 @@ class BaseGen
     PacketPtr getPacket(Addr addr, unsigned size, const MemCmd& cmd,
                         Request::FlagsType flags = 0);
 
+  public:
+
+    /**
+     * Delete a packet created by getPacket, handing its data buffer
+     * back to the pool the buffers of requests needing a response are
+     * taken from.
+     *
+     * @param pkt Packet to delete
+     */
+    static void releasePacket(PacketPtr pkt);
+
   public:
 
     /** Time to spend in this state */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/traffic_gen/multi_stream_gen.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/TrafficGen.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+MultiStreamGen::MultiStreamGen(SimObject &obj,
+                               RequestorID requestor_id, Tick _duration,
+                               Addr start_addr, Addr end_addr,
+                               Addr _blocksize, Addr cacheline_size,
+                               Tick min_period, Tick max_period,
+                               uint8_t read_percent, Addr data_limit,
+                               unsigned num_streams, unsigned burst_len,
+                               const std::vector<double> &period_curve)
+    : StochasticGen(obj, requestor_id, _duration, start_addr, end_addr,
+                    _blocksize, cacheline_size, min_period, max_period,
+                    read_percent, data_limit),
+      numStreams(num_streams),
+      burstLen(burst_len),
+      periodCurve(period_curve),
+      sliceSize(0),
+      nextStream(0),
+      burstCount(0),
+      enterTick(0),
+      dataManipulated(0)
+{
+    fatal_if(numStreams == 0, "%s: need at least one stream", name());
+    fatal_if(burstLen == 0, "%s: bursts need at least one packet", name());
+
+    sliceSize = (endAddr - startAddr + 1) / numStreams;
+    sliceSize -= sliceSize % blocksize;
+    fatal_if(sliceSize == 0, "%s: range too small for %d streams of %d "
+             "byte blocks", name(), numStreams, blocksize);
+}
+
+void
+MultiStreamGen::enter()
+{
+    // every stream starts at the beginning of its slice
+    nextAddr.resize(numStreams);
+    for (unsigned i = 0; i < numStreams; i++)
+        nextAddr[i] = startAddr + i * sliceSize;
+    nextStream = 0;
+    burstCount = 0;
+    enterTick = curTick();
+    dataManipulated = 0;
+}
+
+PacketPtr
+MultiStreamGen::getNextPacket()
+{
+    // choose if we generate a read or a write here
+    bool isRead = readPercent != 0 &&
+        (readPercent == 100 || random_mt.random(0, 100) < readPercent);
+
+    Addr &addr = nextAddr[nextStream];
+
+    DPRINTF(TrafficGen, "MultiStreamGen::getNextPacket: stream %d, %c to "
+            "addr %x, size %d\n", nextStream, isRead ? 'r' : 'w', addr,
+            blocksize);
+
+    // Add the amount of data manipulated to the total
+    dataManipulated += blocksize;
+
+    PacketPtr pkt = getPacket(addr, blocksize,
+                              isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
+
+    // advance the stream, wrapping to the start of its slice
+    const Addr slice_start = startAddr + nextStream * sliceSize;
+    addr += blocksize;
+    if (addr >= slice_start + sliceSize)
+        addr = slice_start;
+
+    nextStream = (nextStream + 1) % numStreams;
+    burstCount = (burstCount + 1) % burstLen;
+
+    return pkt;
+}
+
+Tick
+MultiStreamGen::nextPacketTick(bool elastic, Tick delay) const
+{
+    // Check to see if we have reached the data limit. If dataLimit is
+    // zero we do not have a data limit and therefore we will keep
+    // generating requests for the entire residency in this state.
+    if (dataLimit && dataManipulated >= dataLimit) {
+        DPRINTF(TrafficGen, "Data limit for MultiStreamGen reached.\n");
+        return MaxTick;
+    }
+
+    // the rest of a burst follows right away
+    if (burstCount != 0)
+        return curTick();
+
+    Tick wait = random_mt.random(minPeriod, maxPeriod);
+
+    if (!periodCurve.empty()) {
+        size_t phase = 0;
+        if (duration != 0 && duration != MaxTick) {
+            phase = std::min<size_t>(periodCurve.size() - 1,
+                (curTick() - enterTick) * periodCurve.size() / duration);
+        }
+        wait = wait * periodCurve[phase];
+    }
+
+    // compensate for the delay experienced to not be elastic, by
+    // default the value we generate is from the time we are
+    // asked, so the elasticity happens automatically
+    if (!elastic) {
+        if (wait < delay)
+            wait = 0;
+        else
+            wait -= delay;
+    }
+
+    return curTick() + wait;
+}
+
+} // namespace gem5
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a generator interleaving several linear address
+ * streams, issued in bursts.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_MULTI_STREAM_GEN_HH__
+#define __CPU_TRAFFIC_GEN_MULTI_STREAM_GEN_HH__
+
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/testers/traffic_gen/base_gen.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+/**
+ * The address range is split in num_streams slices of equal size, and
+ * each stream walks its slice linearly. The requests go round robin
+ * over the streams, so a memory controller sees as many concurrent
+ * sequential streams. Requests are issued in bursts of burst_len
+ * packets on the same tick, with a random wait between min and max
+ * period between the bursts. The wait can be scaled along the state:
+ * its duration is split in as many phases as period_curve has
+ * entries, and the wait in phase i is multiplied by period_curve[i].
+ * With no duration the first entry applies throughout.
+ */
+class MultiStreamGen : public StochasticGen
+{
+
+  public:
+
+    MultiStreamGen(SimObject &obj,
+                   RequestorID requestor_id, Tick _duration,
+                   Addr start_addr, Addr end_addr,
+                   Addr _blocksize, Addr cacheline_size,
+                   Tick min_period, Tick max_period,
+                   uint8_t read_percent, Addr data_limit,
+                   unsigned num_streams, unsigned burst_len,
+                   const std::vector<double> &period_curve);
+
+    void enter();
+
+    PacketPtr getNextPacket();
+
+    Tick nextPacketTick(bool elastic, Tick delay) const;
+
+  private:
+
+    /** Number of address streams */
+    const unsigned numStreams;
+
+    /** Packets issued back to back in a burst */
+    const unsigned burstLen;
+
+    /** Scale of the wait between bursts in each phase */
+    const std::vector<double> periodCurve;
+
+    /** Size of the slice of the range each stream walks */
+    Addr sliceSize;
+
+    /** Address of the next request of each stream */
+    std::vector<Addr> nextAddr;
+
+    /** Stream the next request comes from */
+    unsigned nextStream;
+
+    /** Packets issued in the current burst */
+    unsigned burstCount;
+
+    /** Tick the state was entered */
+    Tick enterTick;
+
+    /** Bytes read or written since the state was entered */
+    Addr dataManipulated;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TRAFFIC_GEN_MULTI_STREAM_GEN_HH__
@@ -50,17 +50,60 @@ namespace gem5
 {
 
 TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+    : binaryTrace(nullptr), nextRecord(0), filename(filename)
 {
+    // gzread reads uncompressed files as they are, so this works for
+    // both compressed and plain binary traces
+    binaryTrace = gzopen(filename.c_str(), "rb");
+    uint64_t magic = 0;
+    if (!binaryTrace ||
+        gzread(binaryTrace, &magic, sizeof(magic)) != sizeof(magic) ||
+        magic != MemTraceProbe::Magic) {
+        if (binaryTrace)
+            gzclose(binaryTrace);
+        binaryTrace = nullptr;
+        trace.reset(new ProtoInputStream(filename));
+    }
     init();
 }
 
+TraceGen::InputStream::~InputStream()
+{
+    if (binaryTrace)
+        gzclose(binaryTrace);
+}
+
 void
 TraceGen::InputStream::init()
 {
+    if (binaryTrace) {
+        gzrewind(binaryTrace);
+        records.clear();
+        nextRecord = 0;
+
+        MemTraceProbe::Header header;
+        if (gzread(binaryTrace, &header, sizeof(header)) != sizeof(header))
+            panic("Failed to read packet header from trace %s\n", filename);
+        panic_if(header.version != MemTraceProbe::Version ||
+                 header.recordSize != sizeof(MemTraceProbe::Record),
+                 "Trace %s has an unsupported binary format\n", filename);
+        panic_if(header.tickFrequency != sim_clock::Frequency,
+                 "Trace was recorded with a different tick frequency %d\n",
+                 header.tickFrequency);
+
+        // Skip the requestor names
+        for (uint32_t i = 0; i < header.numRequestors; i++) {
+            uint32_t len;
+            if (gzread(binaryTrace, &len, sizeof(len)) != sizeof(len) ||
+                gzseek(binaryTrace, len, SEEK_CUR) < 0)
+                panic("Truncated header in trace %s\n", filename);
+        }
+        return;
+    }
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!trace->read(header_msg)) {
         panic("Failed to read packet header from trace\n");
     } else if (header_msg.tick_freq() != sim_clock::Frequency) {
         panic("Trace was recorded with a different tick frequency %d\n",
@@ -71,15 +114,38 @@ TraceGen::InputStream::init()
 void
 TraceGen::InputStream::reset()
 {
-    trace.reset();
+    if (trace)
+        trace->reset();
     init();
 }
 
 bool
 TraceGen::InputStream::read(TraceElement& element)
 {
+    if (binaryTrace) {
+        if (nextRecord == records.size()) {
+            // Read ahead in batches rather than record by record
+            records.resize(4096);
+            int bytes = gzread(binaryTrace, records.data(),
+                records.size() * sizeof(MemTraceProbe::Record));
+            records.resize(std::max(bytes, 0) /
+                sizeof(MemTraceProbe::Record));
+            nextRecord = 0;
+            if (records.empty())
+                return false;
+        }
+
+        const MemTraceProbe::Record &rec = records[nextRecord++];
+        element.cmd = rec.cmd;
+        element.addr = rec.addr;
+        element.blocksize = rec.size;
+        element.tick = rec.tick;
+        element.flags = rec.flags;
+        return true;
+    }
+
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (trace->read(pkt_msg)) {
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
@@ -44,10 +44,16 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <zlib.h>
+
+#include <memory>
+#include <vector>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
 #include "mem/packet.hh"
+#include "mem/probes/mem_trace.hh"
 #include "proto/protoio.hh"
 
 namespace gem5
@@ -112,17 +118,30 @@ class TraceGen : public BaseGen
       private:
 
         /// Input file stream for the protobuf trace
-        ProtoInputStream trace;
+        std::unique_ptr<ProtoInputStream> trace;
+
+        /// Input file of a trace in the MemTraceProbe binary format,
+        /// used instead of trace
+        gzFile binaryTrace;
+
+        /// Records read ahead from binaryTrace
+        std::vector<MemTraceProbe::Record> records;
+        size_t nextRecord;
+
+        const std::string filename;
 
       public:
 
         /**
-         * Create a trace input stream for a given file name.
+         * Create a trace input stream for a given file name. The
+         * format of the trace is detected from its contents.
          *
          * @param filename Path to the file to read from
          */
         InputStream(const std::string& filename);
 
+        ~InputStream();
+
         /**
          * Reset the stream such that it can be played once
          * again.
@@ -84,3 +84,8 @@ class TraceCPU(BaseCPU):
     progressMsgInterval = Param.Unsigned(0, "Interval of committed "\
                                          "instructions at which to print a"\
                                          " progress msg")
+
+    # If set to a non-zero value, a background thread decodes up to this
+    # many nodes of the data dependency trace ahead of the replay.
+    readAheadNodes = Param.Unsigned(0, "Number of data trace nodes to "\
+                                    "decode ahead in a background thread")
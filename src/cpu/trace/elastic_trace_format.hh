@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Binary record format of the data dependency traces written by the
+ * o3 ElasticTrace probe and replayed by the TraceCPU.
+ *
+ * A trace starts with a Header and is followed by the records, each a
+ * Record, a MemAccess for loads and stores, and then numRobDeps order
+ * dependencies followed by numRegDeps register dependencies. The
+ * dependencies are stored as 32 bit distances from the sequence number
+ * of the record, and padded to a multiple of 8 bytes, so that every
+ * record is made of whole 64 bit words. The trace is usually gzipped.
+ */
+
+#ifndef __CPU_TRACE_ELASTIC_TRACE_FORMAT_HH__
+#define __CPU_TRACE_ELASTIC_TRACE_FORMAT_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace elastic_trace
+{
+
+constexpr uint64_t Magic = 0x43525445354d4547ULL; // "GEM5ETRC"
+constexpr uint32_t Version = 1;
+
+struct Header
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t windowSize;
+    uint64_t tickFrequency;
+};
+
+struct Record
+{
+    uint64_t seqNum;
+    uint64_t pc;
+    uint64_t compDelay;
+    /** Number of filtered records between this one and the last */
+    uint16_t weight;
+    /** A ProtoMessage::InstDepRecord::RecordType */
+    uint8_t type;
+    uint8_t numRobDeps;
+    uint8_t numRegDeps;
+    /** Whether a MemAccess follows */
+    uint8_t hasAccess;
+    uint16_t reserved;
+};
+
+struct MemAccess
+{
+    uint64_t physAddr;
+    uint64_t virtAddr;
+    uint64_t flags;
+    uint32_t size;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(Header) % 8 == 0 && sizeof(Record) % 8 == 0 &&
+              sizeof(MemAccess) % 8 == 0, "Records should be packed");
+
+/** Number of 64 bit words of the dependencies of a record */
+constexpr size_t
+depWords(const Record &rec)
+{
+    return (rec.numRobDeps + rec.numRegDeps + 1) / 2;
+}
+
+} // namespace elastic_trace
+} // namespace gem5
+
+#endif // __CPU_TRACE_ELASTIC_TRACE_FORMAT_HH__
@@ -37,7 +37,10 @@
 
 #include "cpu/trace/trace_cpu.hh"
 
+#include <chrono>
+
 #include "base/compiler.hh"
+#include "cpu/trace/elastic_trace_format.hh"
 #include "sim/sim_exit.hh"
 
 namespace gem5
@@ -311,13 +314,11 @@ TraceCPU::ElasticDataGen::readNextWindow()
     uint32_t num_read = 0;
     while (num_read != windowSize) {
 
-        // Create a new graph node
-        GraphNode* new_node = new GraphNode;
-
-        // Read the next line to get the next record. If that fails then end of
-        // trace has been reached and traceComplete needs to be set in addition
-        // to returning false.
-        if (!trace.read(new_node)) {
+        // Read the next line to get the next record as a new graph node. If
+        // that fails then end of trace has been reached and traceComplete
+        // needs to be set in addition to returning false.
+        GraphNode* new_node = trace.read();
+        if (!new_node) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
             traceComplete = true;
             return false;
@@ -330,8 +331,8 @@ TraceCPU::ElasticDataGen::readNextWindow()
         addDepsOnParent(new_node, new_node->regDep);
 
         num_read++;
-        // Add to map
-        depGraph[new_node->seqNum] = new_node;
+        // Add to graph
+        depGraph.insert(new_node);
         if (new_node->robDep.empty() && new_node->regDep.empty()) {
             // Source dependencies are already complete, check if resources
             // are available and issue. The execution time is approximated
@@ -352,13 +353,13 @@ TraceCPU::ElasticDataGen::addDepsOnParent(GraphNode *new_node, T& dep_list)
     auto dep_it = dep_list.begin();
     while (dep_it != dep_list.end()) {
         // We look up the valid dependency, i.e. the parent of this node
-        auto parent_itr = depGraph.find(*dep_it);
-        if (parent_itr != depGraph.end()) {
+        GraphNode *parent = depGraph.find(*dep_it);
+        if (parent) {
             // If the parent is found, it is yet to be executed. Append a
             // pointer to the new node to the dependents list of the parent
             // node.
-            parent_itr->second->dependents.push_back(new_node);
-            auto num_depts = parent_itr->second->dependents.size();
+            parent->dependents.push_back(new_node);
+            auto num_depts = parent->dependents.size();
             elasticStats.maxDependents = std::max<double>(num_depts,
                                         elasticStats.maxDependents.value());
             dep_it++;
@@ -401,16 +402,14 @@ TraceCPU::ElasticDataGen::execute()
         }
     }
     // Proceed to execute from readyList
-    auto graph_itr = depGraph.begin();
     auto free_itr = readyList.begin();
     // Iterate through readyList until the next free node has its execute
     // tick later than curTick or the end of readyList is reached
     while (free_itr->execTick <= curTick() && free_itr != readyList.end()) {
 
         // Get pointer to the node to be executed
-        graph_itr = depGraph.find(free_itr->seqNum);
-        assert(graph_itr != depGraph.end());
-        GraphNode* node_ptr = graph_itr->second;
+        GraphNode* node_ptr = depGraph.find(free_itr->seqNum);
+        assert(node_ptr);
 
         // If there is a retryPkt send that else execute the load
         if (retryPkt) {
@@ -509,10 +508,10 @@ TraceCPU::ElasticDataGen::execute()
             (node_ptr->dependents).clear();
             // Update the stat for numOps simulated
             owner.updateNumOps(node_ptr->robNum);
+            // remove from graph
+            depGraph.erase(node_ptr->seqNum);
             // delete node
             delete node_ptr;
-            // remove from graph
-            depGraph.erase(graph_itr);
         }
         // Point to first node to continue to next iteration of while loop
         free_itr = readyList.begin();
@@ -697,9 +696,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
     } else {
         // If it is a load response then release the dependents waiting on it.
         // Get pointer to the completed load
-        auto graph_itr = depGraph.find(pkt->req->getReqInstSeqNum());
-        assert(graph_itr != depGraph.end());
-        GraphNode* node_ptr = graph_itr->second;
+        GraphNode* node_ptr = depGraph.find(pkt->req->getReqInstSeqNum());
+        assert(node_ptr);
 
         // Release resources occupied by the load
         hwResource.release(node_ptr);
@@ -717,10 +715,10 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
         (node_ptr->dependents).clear();
         // Update the stat for numOps completed
         owner.updateNumOps(node_ptr->robNum);
+        // remove from graph
+        depGraph.erase(node_ptr->seqNum);
         // delete node
         delete node_ptr;
-        // remove from graph
-        depGraph.erase(graph_itr);
     }
 
     if (debug::TraceCPUData) {
@@ -820,8 +818,7 @@ TraceCPU::ElasticDataGen::printReadyList()
     }
     DPRINTF(TraceCPUData, "Printing readyList:\n");
     while (itr != readyList.end()) {
-        auto graph_itr = depGraph.find(itr->seqNum);
-        [[maybe_unused]] GraphNode* node_ptr = graph_itr->second;
+        [[maybe_unused]] GraphNode* node_ptr = depGraph.find(itr->seqNum);
         DPRINTFR(TraceCPUData, "\t%lld(%s), %lld\n", itr->seqNum,
             node_ptr->typeToStr(), itr->execTick);
         itr++;
@@ -1194,15 +1191,65 @@ TraceCPU::DcachePort::recvReqRetry()
     owner->dcacheRetryRecvd();
 }
 
+void
+TraceCPU::ElasticDataGen::DepGraph::insert(GraphNode *node)
+{
+    if (slots.empty())
+        base = node->seqNum;
+
+    panic_if(node->seqNum < base + slots.size(),
+             "Trace node %lli is older than the nodes read before it.\n",
+             node->seqNum);
+
+    // Leave the slots of sequence numbers missing from the trace empty
+    slots.resize(node->seqNum - base, nullptr);
+    slots.push_back(node);
+    numNodes++;
+}
+
+void
+TraceCPU::ElasticDataGen::DepGraph::erase(NodeSeqNum seq_num)
+{
+    assert(find(seq_num));
+    slots[seq_num - base] = nullptr;
+    numNodes--;
+
+    // Drop the empty slots in front of the oldest node
+    while (!slots.empty() && !slots.front()) {
+        slots.pop_front();
+        base++;
+    }
+}
+
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
-    trace(filename),
+        const std::string& filename, const double time_multiplier,
+        unsigned read_ahead) :
+    binaryTrace(nullptr),
+    filename(filename),
     timeMultiplier(time_multiplier),
-    microOpCount(0)
+    microOpCount(0),
+    decodedOpCount(0),
+    ring(read_ahead ? new SpscRing<GraphNode *>(read_ahead) : nullptr),
+    decodeDone(false)
 {
+    // gzread reads uncompressed files as they are, so this works for
+    // both compressed and plain binary traces
+    binaryTrace = gzopen(filename.c_str(), "rb");
+    uint64_t magic = 0;
+    if (binaryTrace &&
+        gzread(binaryTrace, &magic, sizeof(magic)) == sizeof(magic) &&
+        magic == elastic_trace::Magic) {
+        readBinaryHeader();
+        return;
+    }
+    if (binaryTrace)
+        gzclose(binaryTrace);
+    binaryTrace = nullptr;
+    trace.reset(new ProtoInputStream(filename));
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::InstDepRecordHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!trace->read(header_msg)) {
         panic("Failed to read packet header from %s\n", filename);
 
         if (header_msg.tick_freq() != sim_clock::Frequency) {
@@ -1216,17 +1263,122 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
     }
 }
 
+TraceCPU::ElasticDataGen::InputStream::~InputStream()
+{
+    stopDecoder();
+    if (binaryTrace)
+        gzclose(binaryTrace);
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::readBinaryHeader()
+{
+    gzrewind(binaryTrace);
+    elastic_trace::Header header;
+    if (gzread(binaryTrace, &header, sizeof(header)) != sizeof(header))
+        panic("Failed to read packet header from %s\n", filename);
+    panic_if(header.version != elastic_trace::Version,
+             "Trace %s has an unsupported binary format\n", filename);
+    panic_if(header.tickFrequency != sim_clock::Frequency,
+             "Trace %s was recorded with a different tick frequency %d\n",
+             filename, header.tickFrequency);
+    windowSize = header.windowSize;
+}
+
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
-    trace.reset();
+    // The decode thread is restarted by the next read
+    stopDecoder();
+    if (binaryTrace)
+        readBinaryHeader();
+    else
+        trace->reset();
+    decodeDone = false;
+}
+
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::InputStream::read()
+{
+    GraphNode *node;
+    if (!ring) {
+        node = new GraphNode;
+        if (!decode(node)) {
+            delete node;
+            return nullptr;
+        }
+    } else {
+        if (decodeDone)
+            return nullptr;
+        if (!decoder.joinable()) {
+            stopping.store(false, std::memory_order_relaxed);
+            decoder = std::thread([this]() { decodeNodes(); });
+        }
+
+        GraphNode *const *first;
+        while (!ring->peek(first))
+            std::this_thread::yield();
+        node = *first;
+        ring->pop(1);
+
+        if (!node) {
+            decodeDone = true;
+            return nullptr;
+        }
+    }
+
+    microOpCount = node->robNum;
+    return node;
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::decodeNodes()
+{
+    while (true) {
+        GraphNode *node = new GraphNode;
+        if (!decode(node)) {
+            delete node;
+            node = nullptr;
+        }
+
+        while (!ring->push(node)) {
+            if (stopping.load(std::memory_order_acquire)) {
+                delete node;
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        if (!node || stopping.load(std::memory_order_acquire))
+            return;
+    }
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::stopDecoder()
+{
+    if (!decoder.joinable())
+        return;
+
+    stopping.store(true, std::memory_order_release);
+    decoder.join();
+
+    GraphNode *const *first;
+    while (size_t n = ring->peek(first)) {
+        for (size_t i = 0; i < n; i++)
+            delete first[i];
+        ring->pop(n);
+    }
 }
 
 bool
-TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
+TraceCPU::ElasticDataGen::InputStream::decode(GraphNode* element)
 {
+    if (binaryTrace)
+        return decodeBinary(element);
+
     ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (trace->read(pkt_msg)) {
         // Required fields
         element->seqNum = pkt_msg.seq_num();
         element->type = pkt_msg.type();
@@ -1280,11 +1432,11 @@ TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
             element->pc = 0;
 
         // ROB occupancy number
-        ++microOpCount;
+        ++decodedOpCount;
         if (pkt_msg.has_weight()) {
-            microOpCount += pkt_msg.weight();
+            decodedOpCount += pkt_msg.weight();
         }
-        element->robNum = microOpCount;
+        element->robNum = decodedOpCount;
         return true;
     }
 
@@ -1292,6 +1444,66 @@ TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
     return false;
 }
 
+bool
+TraceCPU::ElasticDataGen::InputStream::decodeBinary(GraphNode* element)
+{
+    elastic_trace::Record rec;
+    int bytes = gzread(binaryTrace, &rec, sizeof(rec));
+    if (bytes <= 0) {
+        // We have reached the end of the file
+        return false;
+    }
+    panic_if(bytes != sizeof(rec), "Truncated record in trace %s\n",
+             filename);
+
+    element->seqNum = rec.seqNum;
+    element->type = static_cast<RecordType>(rec.type);
+    // Scale the compute delay to effectively scale the Trace CPU frequency
+    element->compDelay = rec.compDelay * timeMultiplier;
+    element->pc = rec.pc;
+
+    elastic_trace::MemAccess access = {};
+    if (rec.hasAccess &&
+        gzread(binaryTrace, &access, sizeof(access)) != sizeof(access))
+        panic("Truncated record in trace %s\n", filename);
+    element->physAddr = access.physAddr;
+    element->virtAddr = access.virtAddr;
+    element->size = access.size;
+    element->flags = access.flags;
+
+    // The dependencies are distances to the record, two per word
+    depWords.resize(elastic_trace::depWords(rec));
+    int dep_bytes = depWords.size() * sizeof(uint64_t);
+    if (dep_bytes &&
+        gzread(binaryTrace, depWords.data(), dep_bytes) != dep_bytes)
+        panic("Truncated record in trace %s\n", filename);
+    auto dep = [&](unsigned i) -> NodeSeqNum {
+        return rec.seqNum - uint32_t(depWords[i / 2] >> (32 * (i % 2)));
+    };
+
+    element->robDep.clear();
+    for (unsigned i = 0; i < rec.numRobDeps; i++)
+        element->robDep.push_back(dep(i));
+
+    element->regDep.clear();
+    for (unsigned i = rec.numRobDeps; i < rec.numRobDeps + rec.numRegDeps;
+         i++) {
+        // As for the protobuf trace, a register dependency that is also
+        // an order dependency is omitted
+        NodeSeqNum reg_dep = dep(i);
+        bool duplicate = false;
+        for (auto &rob_dep: element->robDep)
+            duplicate |= (reg_dep == rob_dep);
+        if (!duplicate)
+            element->regDep.push_back(reg_dep);
+    }
+
+    // ROB occupancy number
+    decodedOpCount += 1 + rec.weight;
+    element->robNum = decodedOpCount;
+    return true;
+}
+
 bool
 TraceCPU::ElasticDataGen::GraphNode::removeRegDep(NodeSeqNum reg_dep)
 {
@@ -38,12 +38,19 @@
 #ifndef __CPU_TRACE_TRACE_CPU_HH__
 #define __CPU_TRACE_TRACE_CPU_HH__
 
+#include <zlib.h>
+
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
-#include <unordered_map>
+#include <thread>
+#include <vector>
 
+#include "base/spsc_ring.hh"
 #include "base/statistics.hh"
 #include "cpu/base.hh"
 #include "debug/TraceCPUData.hh"
@@ -643,6 +650,47 @@ class TraceCPU : public BaseCPU
             std::string typeToStr() const;
         };
 
+        /**
+         * The dependency graph, i.e. the nodes which are read in but not
+         * yet complete, indexed by sequence number. The nodes are read in
+         * program order and complete roughly in order, so they are kept
+         * in a flat window of slots from the oldest node onwards rather
+         * than in a node based map. Sequence numbers missing from the
+         * trace leave empty slots.
+         */
+        class DepGraph
+        {
+          private:
+            /** Slot i holds the node with sequence number base + i */
+            std::deque<GraphNode *> slots;
+
+            /** Sequence number of the first slot */
+            NodeSeqNum base = 0;
+
+            /** Number of nodes in the graph */
+            size_t numNodes = 0;
+
+          public:
+            /** The node with the given sequence number, or nullptr */
+            GraphNode *
+            find(NodeSeqNum seq_num) const
+            {
+                if (seq_num < base || seq_num - base >= slots.size())
+                    return nullptr;
+                return slots[seq_num - base];
+            }
+
+            /** Add a node younger than all the nodes in the graph */
+            void insert(GraphNode *node);
+
+            /** Remove the node with the given sequence number */
+            void erase(NodeSeqNum seq_num);
+
+            size_t size() const { return numNodes; }
+
+            bool empty() const { return numNodes == 0; }
+        };
+
         /** Struct to store a ready-to-execute node and its execution tick. */
         struct ReadyNode
         {
@@ -756,13 +804,25 @@ class TraceCPU : public BaseCPU
         /**
          * The InputStream encapsulates a trace file and the
          * internal buffers and populates GraphNodes based on
-         * the input.
+         * the input. The nodes can be decoded ahead of the replay by a
+         * background thread, which hands them over through a lock-free
+         * ring so that decompressing and parsing the trace stay off the
+         * simulation thread.
          */
         class InputStream
         {
           private:
             /** Input file stream for the protobuf trace */
-            ProtoInputStream trace;
+            std::unique_ptr<ProtoInputStream> trace;
+
+            /** The binary trace, used instead of trace if not null */
+            gzFile binaryTrace;
+
+            /** Dependency distances of the binary record being decoded */
+            std::vector<uint64_t> depWords;
+
+            /** Name of the trace file */
+            const std::string filename;
 
             /**
              * A multiplier for the compute delays in the trace to modulate
@@ -775,6 +835,42 @@ class TraceCPU : public BaseCPU
             /** Count of committed ops read from trace plus the filtered ops */
             uint64_t microOpCount;
 
+            /** The same count for the nodes decoded so far */
+            uint64_t decodedOpCount;
+
+            /** Decoded nodes, followed by nullptr at the end of the trace;
+             *  only used with a decode thread */
+            std::unique_ptr<SpscRing<GraphNode *>> ring;
+
+            /** The decode thread, started by the first read */
+            std::thread decoder;
+
+            /** Set to make the decode thread stop */
+            std::atomic<bool> stopping{false};
+
+            /** The end of the trace was taken from the ring */
+            bool decodeDone;
+
+            /**
+             * Decode the next record of the trace.
+             *
+             * @param element Trace element to populate
+             * @return True if an element could be read successfully
+             */
+            bool decode(GraphNode* element);
+
+            /** Body of the decode thread. */
+            void decodeNodes();
+
+            /** Stop the decode thread and drop what it decoded. */
+            void stopDecoder();
+
+            /** Read and check the header of the binary trace. */
+            void readBinaryHeader();
+
+            /** Decode the next record of the binary trace. */
+            bool decodeBinary(GraphNode* element);
+
             /**
              * The window size that is read from the header of the protobuf
              * trace and used to process the dependency trace
@@ -787,9 +883,14 @@ class TraceCPU : public BaseCPU
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param read_ahead number of nodes a background thread
+             *                   decodes ahead, 0 for no thread
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        unsigned read_ahead);
+
+            ~InputStream();
 
             /**
              * Reset the stream such that it can be played once
@@ -802,11 +903,10 @@ class TraceCPU : public BaseCPU
              * and also notify the caller if the end of the file
              * was reached.
              *
-             * @param element Trace element to populate
-             * @param size of register dependency array stored in the element
-             * @return True if an element could be read successfully
+             * @return The next node, owned by the caller, or nullptr at
+             *         the end of the trace
              */
-            bool read(GraphNode* element);
+            GraphNode *read();
 
             /** Get window size from trace */
             uint32_t getWindowSize() const { return windowSize; }
@@ -824,7 +924,8 @@ class TraceCPU : public BaseCPU
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier,
+                  params.readAheadNodes),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
@@ -991,7 +1092,7 @@ class TraceCPU : public BaseCPU
         HardwareResource hwResource;
 
         /** Store the depGraph of GraphNodes */
-        std::unordered_map<NodeSeqNum, GraphNode*> depGraph;
+        DepGraph depGraph;
 
         /**
          * Queue of dependency-free nodes that are pending issue because
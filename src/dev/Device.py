@@ -96,6 +96,12 @@ class DmaDevice(PioDevice):
         "Substream identifier used by an IOMMU to distinguish amongst "
         "several devices attached to it")
 
+    dma_burst_size = Param.MemorySize('0B',
+        "Largest packet the DMA engine sends, a power of two no smaller "
+        "than a cache line. Larger bursts need fewer packets but are only "
+        "safe when no cache can hold the data. The default of 0 issues "
+        "cache line sized, coherent accesses")
+
     def addIommuProperty(self, state, node):
         """
         This method takes an FdtState and a FdtNode as parameters, and
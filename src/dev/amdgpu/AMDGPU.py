@@ -98,6 +98,11 @@ class SDMAEngine(DmaVirtDevice):
     gpu_device = Param.AMDGPUDevice(NULL, 'GPU Controller')
     walker = Param.VegaPagetableWalker("Page table walker")
 
+    bulk_copy = Param.Bool(False, "Perform copy packets functionally and "
+        "only model the time they take at copy_bandwidth")
+    copy_bandwidth = Param.MemoryBandwidth('16GiB/s', "Bandwidth of a copy "
+        "when bulk_copy is set")
+
 class PM4PacketProcessor(DmaVirtDevice):
     type = 'PM4PacketProcessor'
     cxx_header = "dev/amdgpu/pm4_packet_processor.hh"
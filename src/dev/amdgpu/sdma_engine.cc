@@ -47,7 +47,8 @@ SDMAEngine::SDMAEngine(const SDMAEngineParams &p)
     : DmaVirtDevice(p), id(0), gfxBase(0), gfxRptr(0),
       gfxDoorbell(0), gfxDoorbellOffset(0), gfxWptr(0), pageBase(0),
       pageRptr(0), pageDoorbell(0), pageDoorbellOffset(0),
-      pageWptr(0), gpuDevice(nullptr), walker(p.walker)
+      pageWptr(0), gpuDevice(nullptr), walker(p.walker),
+      bulkCopy(p.bulk_copy), copyBandwidth(p.copy_bandwidth)
 {
     gfx.ib(&gfxIb);
     gfxIb.parent(&gfx);
@@ -537,6 +538,12 @@ SDMAEngine::copy(SDMAQueue *q, sdmaCopy *pkt)
 
     // first we have to read needed data from the source address
     uint8_t *dmaBuffer = new uint8_t[pkt->count];
+    if (bulkCopy) {
+        dmaVirtFunctional(MemCmd::ReadReq, pkt->source, pkt->count,
+                          dmaBuffer);
+        copyReadData(q, pkt, dmaBuffer);
+        return;
+    }
     auto cb = new DmaVirtCallback<uint64_t>(
         [ = ] (const uint64_t &) { copyReadData(q, pkt, dmaBuffer); });
     dmaReadVirt(pkt->source, pkt->count, cb, (void *)dmaBuffer);
@@ -548,12 +555,14 @@ SDMAEngine::copyReadData(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer)
 {
     // lastly we write read data to the destination address
     DPRINTF(SDMAEngine, "Copy packet data:\n");
-    uint64_t *dmaBuffer64 = new uint64_t[pkt->count/8];
-    memcpy(dmaBuffer64, dmaBuffer, pkt->count);
-    for (int i = 0; i < pkt->count/8; ++i) {
-        DPRINTF(SDMAEngine, "%016lx\n", dmaBuffer64[i]);
+    if (debug::SDMAEngine) {
+        uint64_t *dmaBuffer64 = new uint64_t[pkt->count/8];
+        memcpy(dmaBuffer64, dmaBuffer, pkt->count);
+        for (int i = 0; i < pkt->count/8; ++i) {
+            DPRINTF(SDMAEngine, "%016lx\n", dmaBuffer64[i]);
+        }
+        delete [] dmaBuffer64;
     }
-    delete [] dmaBuffer64;
 
     // Aperture is unknown until translating. Do a dummy translation.
     auto tgen = translate(pkt->dest, 64);
@@ -573,8 +582,16 @@ SDMAEngine::copyReadData(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer)
         DPRINTF(SDMAEngine, "Copying to MMHUB address %#lx\n", mmhubAddr);
         gpuDevice->getMemMgr()->writeRequest(mmhubAddr, dmaBuffer, pkt->count);
 
-        delete pkt;
-        decodeNext(q);
+        // the memory manager keeps a copy of the data
+        if (bulkCopy) {
+            bulkCopyDone(q, pkt, dmaBuffer);
+        } else {
+            copyDone(q, pkt, dmaBuffer);
+        }
+    } else if (bulkCopy) {
+        dmaVirtFunctional(MemCmd::WriteReq, pkt->dest, pkt->count,
+                          dmaBuffer);
+        bulkCopyDone(q, pkt, dmaBuffer);
     } else {
         auto cb = new DmaVirtCallback<uint64_t>(
             [ = ] (const uint64_t &) { copyDone(q, pkt, dmaBuffer); });
@@ -593,6 +610,19 @@ SDMAEngine::copyDone(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer)
     decodeNext(q);
 }
 
+/* Completion of a bulk copy packet, once the copy would have finished. */
+void
+SDMAEngine::bulkCopyDone(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer)
+{
+    Tick delay = pkt->count * copyBandwidth;
+    DPRINTF(SDMAEngine, "Bulk copy of %d bytes completes in %d ticks\n",
+            pkt->count, delay);
+    schedule(new EventFunctionWrapper(
+                 [ = ]{ copyDone(q, pkt, dmaBuffer); },
+                 name() + ".bulkCopyDone", true),
+             curTick() + delay);
+}
+
 /* Implements an indirect buffer packet. */
 void
 SDMAEngine::indirectBuffer(SDMAQueue *q, sdmaIndirectBuffer *pkt)
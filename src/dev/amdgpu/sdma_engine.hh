@@ -133,6 +133,11 @@ class SDMAEngine : public DmaVirtDevice
     AMDGPUDevice *gpuDevice;
     VegaISA::Walker *walker;
 
+    // copy packets are done functionally, taking copyBandwidth ticks
+    // per byte
+    const bool bulkCopy;
+    const double copyBandwidth;
+
     /* processRLC will select the correct queue for the doorbell */
     std::unordered_map<Addr, int> rlcMap;
     void processRLC0(Addr wptrOffset);
@@ -198,6 +203,7 @@ class SDMAEngine : public DmaVirtDevice
     void copy(SDMAQueue *q, sdmaCopy *pkt);
     void copyReadData(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer);
     void copyDone(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer);
+    void bulkCopyDone(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer);
     void indirectBuffer(SDMAQueue *q, sdmaIndirectBuffer *pkt);
     void fence(SDMAQueue *q, sdmaFence *pkt);
     void fenceDone(SDMAQueue *q, sdmaFence *pkt);
@@ -290,9 +290,10 @@ ArchTimer::counterLimitReached()
 void
 ArchTimer::updateCounter()
 {
-    if (_counterLimitReachedEvent.scheduled())
-        _parent.deschedule(_counterLimitReachedEvent);
-    if (value() >= _counterLimit) {
+    const uint64_t cur_val = value();
+    if (cur_val >= _counterLimit) {
+        if (_counterLimitReachedEvent.scheduled())
+            _parent.deschedule(_counterLimitReachedEvent);
         counterLimitReached();
     } else {
         // Clear the interurpt when timers conditions are not met
@@ -303,9 +304,18 @@ ArchTimer::updateCounter()
 
         _control.istatus = 0;
 
-        if (scheduleEvents()) {
-            _parent.schedule(_counterLimitReachedEvent,
-                             whenValue(_counterLimit));
+        // A disabled timer ignores the limit, so there is nothing to wait
+        // for until it gets enabled again. Guests reprogram timers often,
+        // so leave the event alone when its tick does not change.
+        if (_control.enable && scheduleEvents()) {
+            const Tick when =
+                _systemCounter.whenValue(cur_val, _counterLimit);
+            if (!_counterLimitReachedEvent.scheduled() ||
+                _counterLimitReachedEvent.when() != when) {
+                _parent.reschedule(_counterLimitReachedEvent, when, true);
+            }
+        } else if (_counterLimitReachedEvent.scheduled()) {
+            _parent.deschedule(_counterLimitReachedEvent);
         }
     }
 }
@@ -42,6 +42,7 @@
 
 #include <algorithm>
 
+#include "base/bitfield.hh"
 #include "base/compiler.hh"
 #include "base/intmath.hh"
 #include "debug/GIC.hh"
@@ -85,6 +86,7 @@ Gicv3Distributor::Gicv3Distributor(Gicv3 * gic, uint32_t it_lines)
       irqGrpmod(it_lines, 0),
       irqNsacr(it_lines, 0),
       irqAffinityRouting(it_lines, 0),
+      spiCandidates(divCeil(it_lines, 64), 0),
       gicdTyper(0),
       gicdPidr0(0x92),
       gicdPidr1(0xb4),
@@ -559,6 +561,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqEnabled[int_id] = true;
+                updateCandidate(int_id);
             }
         }
 
@@ -588,6 +591,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqEnabled[int_id] = false;
+                updateCandidate(int_id);
             }
         }
 
@@ -618,6 +622,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                         "int_id %d (SPI) pending bit set\n", int_id);
                 irqPending[int_id] = true;
                 irqPendingIspendr[int_id] = true;
+                updateCandidate(int_id);
             }
         }
 
@@ -646,6 +651,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
 
             if (clear && treatAsEdgeTriggered(int_id)) {
                 irqPending[int_id] = false;
+                updateCandidate(int_id);
                 clearIrqCpuInterface(int_id);
             }
         }
@@ -672,6 +678,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
 
             if (active) {
                 irqActive[int_id] = 1;
+                updateCandidate(int_id);
             }
         }
 
@@ -701,6 +708,7 @@ Gicv3Distributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqActive[int_id] = false;
+                updateCandidate(int_id);
             }
         }
 
@@ -1011,6 +1019,7 @@ Gicv3Distributor::sendInt(uint32_t int_id)
     panic_if(int_id > itLines, "Invalid SPI!");
     irqPending[int_id] = true;
     irqPendingIspendr[int_id] = false;
+    updateCandidate(int_id);
     DPRINTF(GIC, "Gicv3Distributor::sendInt(): "
             "int_id %d (SPI) pending bit set\n", int_id);
     update();
@@ -1032,6 +1041,7 @@ Gicv3Distributor::deassertSPI(uint32_t int_id)
     panic_if(int_id < Gicv3::SGI_MAX + Gicv3::PPI_MAX, "Invalid SPI!");
     panic_if(int_id > itLines, "Invalid SPI!");
     irqPending[int_id] = false;
+    updateCandidate(int_id);
     clearIrqCpuInterface(int_id);
 
     update();
@@ -1088,14 +1098,15 @@ Gicv3Distributor::update()
     if (gic->blockIntUpdate())
         return;
 
-    // Find the highest priority pending SPI
-    for (int int_id = Gicv3::SGI_MAX + Gicv3::PPI_MAX; int_id < itLines;
-         int_id++) {
-        Gicv3::GroupId int_group = getIntGroup(int_id);
-        bool group_enabled = groupEnabled(int_group);
+    // Find the highest priority pending SPI, visiting the candidates in
+    // increasing id order so that ties go to the lower id
+    for (int word = 0; word < spiCandidates.size(); word++) {
+        for (uint64_t bits = spiCandidates[word]; bits; bits &= bits - 1) {
+            const int int_id = word * 64 + ctz64(bits);
+            Gicv3::GroupId int_group = getIntGroup(int_id);
 
-        if (irqPending[int_id] && irqEnabled[int_id] &&
-            !irqActive[int_id] && group_enabled) {
+            if (!groupEnabled(int_group))
+                continue;
 
             // Find the cpu interface where to route the interrupt
             Gicv3CPUInterface *target_cpu_interface = route(int_id);
@@ -1173,12 +1184,14 @@ Gicv3Distributor::activateIRQ(uint32_t int_id)
         irqPending[int_id] = false;
     }
     irqActive[int_id] = true;
+    updateCandidate(int_id);
 }
 
 void
 Gicv3Distributor::deactivateIRQ(uint32_t int_id)
 {
     irqActive[int_id] = false;
+    updateCandidate(int_id);
 }
 
 void
@@ -1242,6 +1255,11 @@ Gicv3Distributor::unserialize(CheckpointIn & cp)
     UNSERIALIZE_CONTAINER(irqGrpmod);
     UNSERIALIZE_CONTAINER(irqNsacr);
     UNSERIALIZE_CONTAINER(irqAffinityRouting);
+
+    for (uint32_t int_id = Gicv3::SGI_MAX + Gicv3::PPI_MAX; int_id < itLines;
+         int_id++) {
+        updateCandidate(int_id);
+    }
 }
 
 } // namespace gem5
@@ -165,6 +165,13 @@ class Gicv3Distributor : public Serializable
     std::vector <uint8_t> irqNsacr;
     std::vector <IROUTER> irqAffinityRouting;
 
+    /**
+     * One bit per SPI that is pending, enabled and not active, which are
+     * the only ones update() has to consider. Kept in sync by
+     * updateCandidate() wherever one of those states changes.
+     */
+    std::vector <uint64_t> spiCandidates;
+
     uint32_t gicdTyper;
     uint32_t gicdPidr0;
     uint32_t gicdPidr1;
@@ -182,6 +189,17 @@ class Gicv3Distributor : public Serializable
     void activateIRQ(uint32_t int_id);
     void deactivateIRQ(uint32_t int_id);
     void fullUpdate();
+
+    inline void
+    updateCandidate(uint32_t int_id)
+    {
+        const uint64_t mask = 1ULL << (int_id % 64);
+        if (irqPending[int_id] && irqEnabled[int_id] && !irqActive[int_id])
+            spiCandidates[int_id / 64] |= mask;
+        else
+            spiCandidates[int_id / 64] &= ~mask;
+    }
+
     Gicv3::GroupId getIntGroup(int int_id) const;
 
     inline bool
@@ -1292,6 +1292,8 @@ Gicv3Its::moveAllPendingState(
         rd1->lpiPendingTablePtr,
         0, sizeof(lpi_pending_table));
 
+    rd1->invalidateLPIPending();
+    rd2->invalidateLPIPending();
     rd2->updateDistributor();
 }
 
@@ -77,6 +77,7 @@ Gicv3Redistributor::Gicv3Redistributor(Gicv3 * gic, uint32_t cpu_id)
       lpiConfigurationTablePtr(0),
       lpiIDBits(0),
       lpiPendingTablePtr(0),
+      lpiPendingValid(false),
       addrRangeSize(gic->params().gicv4 ? 0x40000 : 0x20000)
 {
 }
@@ -414,6 +415,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
       case GICR_CTLR: {
           // GICR_TYPER.LPIS is 0 so EnableLPIs is RES0
           EnableLPIs = data & GICR_CTLR_ENABLE_LPIS;
+          invalidateLPIPending();
           DPG1S = data & GICR_CTLR_DPG1S;
           DPG1NS = data & GICR_CTLR_DPG1NS;
           DPG0 = data & GICR_CTLR_DPG0;
@@ -674,6 +676,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
               lpiIDBits = 0xf;
           }
 
+          invalidateLPIPending();
           break;
       }
 
@@ -691,6 +694,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
         // InnerCache, bits [9:7]
         //   000 Device-nGnRnE
         lpiPendingTablePtr = data & 0xFFFFFFFFF0000;
+        invalidateLPIPending();
         break;
 
       case GICR_INVLPIR: { // Redistributor Invalidate LPI Register
@@ -829,29 +833,35 @@ Gicv3Redistributor::update()
     if (EnableLPIs) {
 
         const uint32_t largest_lpi_id = 1 << (lpiIDBits + 1);
-        const uint32_t number_lpis = largest_lpi_id - SMALLEST_LPI_ID + 1;
 
-        uint8_t lpi_pending_table[largest_lpi_id / 8];
-        uint8_t lpi_config_table[number_lpis];
+        if (!lpiPendingValid) {
+            uint8_t lpi_pending_table[largest_lpi_id / 8];
 
-        memProxy->readBlob(lpiPendingTablePtr,
-                           lpi_pending_table,
-                           sizeof(lpi_pending_table));
+            memProxy->readBlob(lpiPendingTablePtr,
+                               lpi_pending_table,
+                               sizeof(lpi_pending_table));
 
-        memProxy->readBlob(lpiConfigurationTablePtr,
-                           lpi_config_table,
-                           sizeof(lpi_config_table));
+            lpiPending.clear();
+            for (uint32_t lpi_id = SMALLEST_LPI_ID; lpi_id < largest_lpi_id;
+                 lpi_id++) {
+                if (lpi_pending_table[lpi_id / 8] & (1 << (lpi_id % 8)))
+                    lpiPending.insert(lpi_id);
+            }
+            lpiPendingValid = true;
+        }
 
-        for (int lpi_id = SMALLEST_LPI_ID; lpi_id < largest_lpi_id;
-             lpi_id++) {
-            uint32_t lpi_pending_entry_byte = lpi_id / 8;
-            uint8_t lpi_pending_entry_bit_position = lpi_id % 8;
-            bool lpi_is_pending = lpi_pending_table[lpi_pending_entry_byte] &
-                                  1 << lpi_pending_entry_bit_position;
-            uint32_t lpi_configuration_entry_index = lpi_id - SMALLEST_LPI_ID;
+        // The configuration table is read at every update as it is owned
+        // by software, and changes to it are not always followed by an
+        // invalidation.
+        for (auto it = lpiPending.lower_bound(SMALLEST_LPI_ID);
+             it != lpiPending.end() && *it < largest_lpi_id; ++it) {
+            const uint32_t lpi_id = *it;
+            uint8_t lpi_config_byte;
+            memProxy->readBlob(
+                lpiConfigurationTablePtr + (lpi_id - SMALLEST_LPI_ID),
+                &lpi_config_byte, sizeof(lpi_config_byte));
 
-            LPIConfigurationTableEntry config_entry =
-                lpi_config_table[lpi_configuration_entry_index];
+            LPIConfigurationTableEntry config_entry = lpi_config_byte;
 
             bool lpi_is_enable = config_entry.enable;
 
@@ -860,7 +870,7 @@ Gicv3Redistributor::update()
             Gicv3::GroupId lpi_group = Gicv3::G1NS;
             bool group_enabled = distributor->groupEnabled(lpi_group);
 
-            if (lpi_is_pending && lpi_is_enable && group_enabled) {
+            if (lpi_is_enable && group_enabled) {
                 uint8_t lpi_priority = config_entry.priority << 2;
 
                 if ((lpi_priority < cpuInterface->hppi.prio) ||
@@ -966,6 +976,13 @@ Gicv3Redistributor::setClrLPI(uint64_t data, bool set)
 
     writeEntryLPI(lpi_id, lpi_pending_entry);
 
+    if (lpiPendingValid) {
+        if (set)
+            lpiPending.insert(lpi_id);
+        else
+            lpiPending.erase(lpi_id);
+    }
+
     updateDistributor();
 }
 
@@ -1113,6 +1130,7 @@ Gicv3Redistributor::unserialize(CheckpointIn & cp)
     UNSERIALIZE_SCALAR(lpiConfigurationTablePtr);
     UNSERIALIZE_SCALAR(lpiIDBits);
     UNSERIALIZE_SCALAR(lpiPendingTablePtr);
+    invalidateLPIPending();
 }
 
 } // namespace gem5
@@ -41,6 +41,8 @@
 #ifndef __DEV_ARM_GICV3_REDISTRIBUTOR_H__
 #define __DEV_ARM_GICV3_REDISTRIBUTOR_H__
 
+#include <set>
+
 #include "base/addr_range.hh"
 #include "dev/arm/gic_v3.hh"
 #include "sim/serialize.hh"
@@ -175,6 +177,15 @@ class Gicv3Redistributor : public Serializable
     uint8_t lpiIDBits;
     Addr lpiPendingTablePtr;
 
+    /**
+     * Pending LPIs, mirroring the pending table in memory so that update()
+     * only has to look at the configuration of those. It is rebuilt from
+     * the table whenever lpiPendingValid is cleared, which happens when
+     * the table may have been changed behind the back of setClrLPI.
+     */
+    std::set<uint32_t> lpiPending;
+    bool lpiPendingValid;
+
     BitUnion8(LPIConfigurationTableEntry)
         Bitfield<7, 2> priority;
         Bitfield<1> res1;
@@ -222,6 +233,7 @@ class Gicv3Redistributor : public Serializable
     void writeEntryLPI(uint32_t intid, uint8_t lpi_entry);
     bool isPendingLPI(uint32_t intid);
     void setClrLPI(uint64_t data, bool set);
+    void invalidateLPIPending() { lpiPendingValid = false; }
     void sendSGI(uint32_t int_id, Gicv3::GroupId group, bool ns);
     void serialize(CheckpointOut & cp) const override;
     void unserialize(CheckpointIn & cp) override;
@@ -124,12 +124,82 @@ SMMUv3DeviceInterface::schedAtsTimingResp(PacketPtr pkt)
     }
 }
 
+bool
+SMMUv3DeviceInterface::recvAtomicFast(PacketPtr pkt, Tick &delay)
+{
+    const Addr addr = pkt->getAddr();
+    const unsigned size = pkt->getSize();
+    const Addr next4k = (addr + 0x1000ULL) & ~0xfffULL;
+
+    // Leave anything unusual, including the faults, to the process
+    if (!(smmu->regs.cr0 & CR0_SMMUEN_MASK) || addr + size > next4k ||
+        !xlateSlotsRemaining) {
+        return false;
+    }
+
+    const uint32_t sid = pkt->req->streamId();
+    const uint32_t ssid = pkt->req->hasSubstreamId() ?
+        pkt->req->substreamId() : 0;
+
+    // Peek first, so that a miss is only counted once, by the process
+    const SMMUTLB::Entry *e = microTLBEnable ?
+        microTLB->lookup(sid, ssid, addr, false) : nullptr;
+    const bool micro_hit = e;
+    Cycles cycles = pkt->isWrite() ?
+        Cycles((size + (portWidth - 1)) / portWidth) : Cycles(1);
+    if (microTLBEnable)
+        cycles += microTLBLat;
+
+    if (micro_hit) {
+        microTLB->lookup(sid, ssid, addr);
+    } else {
+        e = mainTLBEnable ? mainTLB->lookup(sid, ssid, addr, false) :
+            nullptr;
+        if (!e)
+            return false;
+        if (microTLBEnable)
+            microTLB->lookup(sid, ssid, addr);
+        mainTLB->lookup(sid, ssid, addr);
+        cycles += mainTLBLat;
+    }
+
+    DPRINTF(SMMUv3, "[a] fast %s TLB hit vaddr=%#x amask=%#x sid=%#x "
+            "ssid=%#x paddr=%#x\n", micro_hit ? "micro" : "main", addr,
+            e->vaMask, sid, ssid, e->pa);
+
+    const Addr paddr = e->pa + (addr & ~e->vaMask);
+    if (!micro_hit && microTLBEnable) {
+        SMMUTLB::Entry ue = *e;
+        ue.prefetched = false;
+        microTLB->store(ue, SMMUTLB::ALLOC_ANY_WAY);
+    }
+
+    cycles += pkt->isWrite() ?
+        Cycles((size + (smmu->requestPortWidth - 1)) /
+               smmu->requestPortWidth) :
+        Cycles(1);
+
+    smmu->stats.translationTimeDist.sample(0);
+    smmu->scheduleDeviceRetries();
+
+    pkt->setAddr(paddr);
+    pkt->req->setPaddr(paddr);
+    delay = cycles * smmu->clockPeriod() + smmu->requestPort.sendAtomic(pkt);
+    pkt->setAddr(addr);
+
+    return true;
+}
+
 Tick
 SMMUv3DeviceInterface::recvAtomic(PacketPtr pkt)
 {
     DPRINTF(SMMUv3, "[a] req from %s addr=%#x size=%#x\n",
             devicePort->getPeer(), pkt->getAddr(), pkt->getSize());
 
+    Tick delay;
+    if (recvAtomicFast(pkt, delay))
+        return delay;
+
     std::string proc_name = csprintf("%s.port", name());
     SMMUTranslationProcess proc(proc_name, *smmu, *this);
     proc.beginTransaction(SMMUTranslRequest::fromPacket(pkt));
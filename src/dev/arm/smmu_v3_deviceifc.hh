@@ -96,6 +96,18 @@ class SMMUv3DeviceInterface : public ClockedObject
     std::list<SMMUTranslationProcess *> dependentWrites[SMMU_MAX_TRANS_ID];
     SMMUSignal dependentReqRemoved;
 
+    /**
+     * Translate an atomic request that hits in the micro or main TLB
+     * without going through a translation process. The timing is the one
+     * the process would model, as nothing can contend with an atomic
+     * request.
+     *
+     * @param pkt Request from the device
+     * @param delay Set to the latency of the access on success
+     * @return Whether the request was handled
+     */
+    bool recvAtomicFast(PacketPtr pkt, Tick &delay);
+
     // Receiving translation requests from the requestor device
     Tick recvAtomic(PacketPtr pkt);
     bool recvTimingReq(PacketPtr pkt);
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dev/dma_coroutine.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/Drain.hh"
+
+namespace gem5
+{
+
+DmaCoroutine::DmaCoroutine(DmaPort &_port, const std::string &name,
+                           std::function<void()> _body, size_t stack_size)
+    : Fiber(stack_size), port(_port), _name(name), body(std::move(_body)),
+      caller(nullptr), _active(false),
+      resumeEvent([this]{ resume(); }, name)
+{
+}
+
+DmaCoroutine::~DmaCoroutine()
+{
+    if (resumeEvent.scheduled())
+        port.device->deschedule(resumeEvent);
+}
+
+void
+DmaCoroutine::start()
+{
+    panic_if(currentFiber() == this, "%s: Started from its own body.\n",
+             name());
+    if (_active)
+        return;
+    _active = true;
+    resume();
+}
+
+void
+DmaCoroutine::resume()
+{
+    caller = currentFiber();
+    run();
+}
+
+void
+DmaCoroutine::suspend()
+{
+    panic_if(currentFiber() != this, "%s: Waiting outside of its body.\n",
+             name());
+    caller->run();
+}
+
+void
+DmaCoroutine::read(Addr addr, int size, void *data, Tick delay,
+                   Request::Flags flag)
+{
+    port.dmaAction(MemCmd::ReadReq, addr, size, &resumeEvent,
+                   (uint8_t *)data, delay, flag);
+    suspend();
+}
+
+void
+DmaCoroutine::write(Addr addr, int size, const void *data, Tick delay,
+                    Request::Flags flag)
+{
+    port.dmaAction(MemCmd::WriteReq, addr, size, &resumeEvent,
+                   (uint8_t *)data, delay, flag);
+    suspend();
+}
+
+void
+DmaCoroutine::wait(Tick delay)
+{
+    port.device->schedule(resumeEvent, curTick() + delay);
+    suspend();
+}
+
+void
+DmaCoroutine::main()
+{
+    // The fiber never finishes, so that its stack is reused by every
+    // run of the body.
+    while (true) {
+        body();
+        _active = false;
+        if (drainState() == DrainState::Draining) {
+            DPRINTF(Drain, "%s done draining\n", name());
+            signalDrainDone();
+        }
+        suspend();
+    }
+}
+
+DrainState
+DmaCoroutine::drain()
+{
+    return _active ? DrainState::Draining : DrainState::Drained;
+}
+
+} // namespace gem5
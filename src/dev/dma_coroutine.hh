@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __DEV_DMA_COROUTINE_HH__
+#define __DEV_DMA_COROUTINE_HH__
+
+#include <functional>
+#include <string>
+
+#include "base/fiber.hh"
+#include "dev/dma_device.hh"
+#include "sim/drain.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+/**
+ * Runs the multi-step transactions of a device, such as a descriptor
+ * fetch followed by the data transfer and a status write back, as
+ * straight-line code rather than as a chain of completion events and
+ * states.
+ *
+ * The body is run on its own stack when the coroutine is started, and
+ * is suspended whenever it waits for a DMA access or a delay. A single
+ * event resumes it, and the stack is allocated once, so a step costs no
+ * events or allocations besides those of the DMA port itself. The body
+ * may only have one access or delay outstanding.
+ *
+ * The coroutine is drained once its body returns. A body that runs for
+ * long should check drainState() between its steps, and return after
+ * recording in the device where to continue once resumed, as the state
+ * of the body is not checkpointed.
+ */
+class DmaCoroutine : public Fiber, public Drainable
+{
+  public:
+    DmaCoroutine(DmaPort &port, const std::string &name,
+                 std::function<void()> body,
+                 size_t stack_size=DefaultStackSize);
+
+    ~DmaCoroutine();
+
+    const std::string &name() const { return _name; }
+
+    /** Start running the body, unless it is already running. */
+    void start();
+
+    /** Whether the body is running or waiting. */
+    bool active() const { return _active; }
+
+    /** Read from memory, and wait until the data is available. */
+    void read(Addr addr, int size, void *data, Tick delay=0,
+              Request::Flags flag=0);
+
+    /** Write to memory, and wait until the write completes. */
+    void write(Addr addr, int size, const void *data, Tick delay=0,
+               Request::Flags flag=0);
+
+    /** Wait for the given number of ticks. */
+    void wait(Tick delay);
+
+    DrainState drain() override;
+
+  protected:
+    void main() override;
+
+  private:
+    /** Switch to the body, until it waits or returns. */
+    void resume();
+
+    /** Switch back to the caller of resume(), from the body. */
+    void suspend();
+
+    DmaPort &port;
+
+    const std::string _name;
+
+    std::function<void()> body;
+
+    /** Fiber which last resumed the body */
+    Fiber *caller;
+
+    bool _active;
+
+    EventFunctionWrapper resumeEvent;
+};
+
+} // namespace gem5
+
+#endif // __DEV_DMA_COROUTINE_HH__
@@ -45,6 +45,7 @@
 #include <cstring>
 #include <utility>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/DMA.hh"
@@ -56,12 +57,17 @@ namespace gem5
 {
 
 DmaPort::DmaPort(ClockedObject *dev, System *s,
-                 uint32_t sid, uint32_t ssid)
+                 uint32_t sid, uint32_t ssid, Addr burst_size)
     : RequestPort(dev->name() + ".dma", dev),
       device(dev), sys(s), requestorId(s->getRequestorId(dev)),
       sendEvent([this]{ sendDma(); }, dev->name()),
-      defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize())
-{ }
+      defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize()),
+      burstSize(burst_size ? burst_size : cacheLineSize)
+{
+    fatal_if(!isPowerOf2(burstSize) || burstSize < cacheLineSize,
+             "%s: DMA burst size %d must be a power of two and at least a "
+             "cache line", name(), burstSize);
+}
 
 void
 DmaPort::handleRespPacket(PacketPtr pkt, Tick delay)
@@ -113,7 +119,7 @@ DmaPort::handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay)
 PacketPtr
 DmaPort::DmaReqState::createPacket()
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             gen.addr(), gen.size(), flags, id);
     req->setStreamId(sid);
     req->setSubstreamId(ssid);
@@ -141,7 +147,7 @@ DmaPort::recvTimingResp(PacketPtr pkt)
 }
 
 DmaDevice::DmaDevice(const Params &p)
-    : PioDevice(p), dmaPort(this, sys, p.sid, p.ssid)
+    : PioDevice(p), dmaPort(this, sys, p.sid, p.ssid, p.dma_burst_size)
 { }
 
 void
@@ -179,10 +185,10 @@ DmaPort::dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
             event ? event->scheduled() : -1);
 
     // One DMA request sender state for every action, that is then
-    // split into many requests and packets based on the block size,
-    // i.e. cache line size.
+    // split into many requests and packets based on the burst size,
+    // by default the cache line size.
     transmitList.push_back(
-            new DmaReqState(cmd, addr, cacheLineSize, size,
+            new DmaReqState(cmd, addr, burstSize, size,
                 data, flag, requestorId, sid, ssid, event, delay));
     pendingCount++;
 
@@ -200,6 +206,25 @@ DmaPort::dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
               defaultSid, defaultSSid, delay, flag);
 }
 
+void
+DmaPort::dmaFunctional(Packet::Command cmd, Addr addr, int size,
+                       uint8_t *data, Request::Flags flag)
+{
+    DPRINTF(DMA, "Functional DMA for addr: %#x size: %d\n", addr, size);
+
+    for (ChunkGenerator gen(addr, size, burstSize); !gen.done(); gen.next()) {
+        RequestPtr req = Request::create(
+                gen.addr(), gen.size(), flag, requestorId);
+        req->setStreamId(defaultSid);
+        req->setSubstreamId(defaultSSid);
+        req->taskId(context_switch_task_id::DMA);
+
+        Packet pkt(req, cmd);
+        pkt.dataStatic(data + gen.complete());
+        sendFunctional(&pkt);
+    }
+}
+
 void
 DmaPort::trySendTimingReq()
 {
@@ -177,6 +177,9 @@ class DmaPort : public RequestPort, public Drainable
 
     const int cacheLineSize;
 
+    /** Largest chunk a DMA request is split into. */
+    const Addr burstSize;
+
   protected:
 
     bool recvTimingResp(PacketPtr pkt) override;
@@ -184,7 +187,13 @@ class DmaPort : public RequestPort, public Drainable
 
   public:
 
-    DmaPort(ClockedObject *dev, System *s, uint32_t sid=0, uint32_t ssid=0);
+    /**
+     * @param burst_size Largest packet to send. Zero, the default, sends
+     *                   cache line sized packets, which is the only safe
+     *                   choice when the port talks to coherent caches.
+     */
+    DmaPort(ClockedObject *dev, System *s, uint32_t sid=0, uint32_t ssid=0,
+            Addr burst_size=0);
 
     void
     dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
@@ -195,6 +204,13 @@ class DmaPort : public RequestPort, public Drainable
               uint8_t *data, uint32_t sid, uint32_t ssid, Tick delay,
               Request::Flags flag=0);
 
+    /**
+     * Perform a transfer functionally, in zero time, e.g., for a device
+     * that models the duration of a bulk transfer itself.
+     */
+    void dmaFunctional(Packet::Command cmd, Addr addr, int size,
+                       uint8_t *data, Request::Flags flag=0);
+
     bool dmaPending() const { return pendingCount > 0; }
 
     DrainState drain() override;
@@ -71,4 +71,19 @@ DmaVirtDevice::dmaVirt(DmaFnPtr dmaFn, Addr addr, unsigned size,
     }
 }
 
+void
+DmaVirtDevice::dmaVirtFunctional(Packet::Command cmd, Addr addr,
+                                 unsigned size, void *data)
+{
+    uint8_t *loc_data = (uint8_t*)data;
+
+    TranslationGenPtr gen = translate(addr, size);
+    for (const auto &range: *gen) {
+        fatal_if(range.fault, "Failed translation: vaddr 0x%x", range.vaddr);
+
+        dmaPort.dmaFunctional(cmd, range.paddr, range.size, loc_data);
+        loc_data += range.size;
+    }
+}
+
 } // namespace gem5
@@ -96,6 +96,18 @@ class DmaVirtDevice : public DmaDevice
     void dmaWriteVirt(Addr host_addr, unsigned size, DmaCallback *b,
                       void *data, Tick delay = 0);
 
+    /**
+     * Read or write virtual address host_addr functionally, for devices
+     * which model the time a bulk transfer takes themselves.
+     *
+     * @param cmd Read or write command
+     * @param host_addr Virtual starting address for DMA transfer
+     * @param size Number of bytes to transfer
+     * @param data Pointer to the data to be transfered
+     */
+    void dmaVirtFunctional(Packet::Command cmd, Addr host_addr,
+                           unsigned size, void *data);
+
     // Typedefing dmaRead and dmaWrite function pointer
     typedef void (DmaDevice::*DmaFnPtr)(Addr, int, Event*, uint8_t*, Tick);
 
@@ -78,9 +78,18 @@ class DistEtherLink(SimObject):
     dist_rank = Param.UInt32('0', "Rank of this gem5 process (dist run)")
     dist_size = Param.UInt32('1', "Number of gem5 processes (dist run)")
     sync_start = Param.Latency('5200000000000t', "first dist sync barrier")
-    sync_repeat = Param.Latency('10us', "dist sync barrier repeat")
+    sync_repeat = Param.Latency('0us', "dist sync barrier repeat "
+        "(0 uses the link delay, the longest exact interval)")
+    sync_max_stretch = Param.Unsigned(1, "Maximum number of sync "
+        "intervals the switch may skip while no packets are in flight "
+        "(1 disables it; packets sent during a skipped interval may be "
+        "delivered late)")
     server_name = Param.String('localhost', "Message server name")
     server_port = Param.UInt32('2200', "Message server port")
+    dist_transport = Param.String('tcp', "Transport to the peer gem5 "
+        "processes: tcp, or shm when they all run on this host")
+    shm_ring_size = Param.MemorySize('4MiB',
+        "Size of each direction of a link with the shm transport")
     is_switch = Param.Bool(False, "true if this a link in etherswitch")
     dist_sync_on_pseudo_op = Param.Bool(False, "Start sync with pseudo_op")
     num_nodes = Param.UInt32('2', "Number of simulate nodes")
@@ -144,6 +153,44 @@ class EtherDump(SimObject):
     file = Param.String("dump file")
     maxlen = Param.Int(96, "max portion of packet data to dump")
 
+class EtherTrafficGen(SimObject):
+    type = 'EtherTrafficGen'
+    cxx_header = "dev/net/ethertrafficgen.hh"
+    cxx_class = 'gem5::EtherTrafficGen'
+
+    interface = EtherInt("Ethernet interface to the network under test")
+    dump = Param.EtherDump(NULL, "dump object")
+
+    trace = Param.String("", "pcap trace to replay, instead of the "
+        "synthetic flows")
+    trace_loop = Param.Bool(False, "Start the trace over at its end")
+    trace_timing = Param.Bool(True, "Replay the trace at its recorded "
+        "times rather than at rate")
+    trace_time_scale = Param.Float(1.0, "Factor the recorded gaps between "
+        "the frames of the trace are stretched by")
+
+    rate = Param.NetworkBandwidth('1Gbps', "Rate of the synthetic flows, "
+        "or of the trace when not replayed with its own timing")
+    random_gaps = Param.Bool(False, "Space the frames out randomly "
+        "(Poisson arrivals) instead of evenly at rate")
+    packet_size = Param.Unsigned(1514, "Size of the synthetic frames")
+    num_flows = Param.Unsigned(1, "Number of synthetic UDP flows, each "
+        "with its own source port")
+    src_mac = Param.EthernetAddr("00:90:00:00:00:02",
+        "Source address of the synthetic frames")
+    dst_mac = Param.EthernetAddr("00:90:00:00:00:01",
+        "Destination address of the synthetic frames")
+    src_ip = Param.IpAddress("10.0.0.2", "Source address of the synthetic "
+        "flows")
+    dst_ip = Param.IpAddress("10.0.0.1", "Destination address of the "
+        "synthetic flows")
+    src_port = Param.UInt16(1024, "Source port of the first synthetic flow")
+    dst_port = Param.UInt16(9, "Destination port of the synthetic flows")
+
+    start_time = Param.Latency('0ns', "Time the first frame is sent at")
+    max_packets = Param.UInt64(0, "Number of frames to send (0 for no "
+        "limit)")
+
 class EtherDevice(PciDevice):
     type = 'EtherDevice'
     abstract = True
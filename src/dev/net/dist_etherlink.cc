@@ -50,6 +50,7 @@
 #include <string>
 #include <vector>
 
+#include "base/logging.hh"
 #include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/DistEthernet.hh"
@@ -60,6 +61,7 @@
 #include "dev/net/etherint.hh"
 #include "dev/net/etherlink.hh"
 #include "dev/net/etherpkt.hh"
+#include "dev/net/shm_iface.hh"
 #include "dev/net/tcp_iface.hh"
 #include "params/EtherLink.hh"
 #include "sim/cur_tick.hh"
@@ -81,20 +83,34 @@ DistEtherLink::DistEtherLink(const Params &p)
 
     Tick sync_repeat;
     if (p.sync_repeat != 0) {
-        if (p.sync_repeat != p.delay)
+        if (p.sync_repeat > p.delay)
             warn("DistEtherLink(): sync_repeat is %lu and linkdelay is %lu",
                  p.sync_repeat, p.delay);
         sync_repeat = p.sync_repeat;
     } else {
         sync_repeat = p.delay;
     }
-
-    // create the dist (TCP) interface to talk to the peer gem5 processes.
-    distIface = new TCPIface(p.server_name, p.server_port,
-                             p.dist_rank, p.dist_size,
-                             p.sync_start, sync_repeat, this,
-                             p.dist_sync_on_pseudo_op, p.is_switch,
-                             p.num_nodes);
+    fatal_if(sync_repeat == 0, "%s: sync_repeat and delay can't both be 0\n",
+             name());
+
+    // create the dist interface to talk to the peer gem5 processes.
+    if (p.dist_transport == "tcp") {
+        distIface = new TCPIface(p.server_name, p.server_port,
+                                 p.dist_rank, p.dist_size,
+                                 p.sync_start, sync_repeat, this,
+                                 p.dist_sync_on_pseudo_op, p.is_switch,
+                                 p.num_nodes);
+    } else if (p.dist_transport == "shm") {
+        distIface = new ShmIface(p.server_port, p.shm_ring_size,
+                                 p.dist_rank, p.dist_size,
+                                 p.sync_start, sync_repeat, this,
+                                 p.dist_sync_on_pseudo_op, p.is_switch,
+                                 p.num_nodes);
+    } else {
+        fatal("%s: unknown dist transport '%s'\n", name(),
+              p.dist_transport);
+    }
+    distIface->setSyncMaxStretch(p.sync_max_stretch);
 
     localIface = new LocalIface(name() + ".int0", txLink, rxLink, distIface);
 }
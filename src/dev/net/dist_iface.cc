@@ -41,6 +41,7 @@
 
 #include "dev/net/dist_iface.hh"
 
+#include <algorithm>
 #include <queue>
 #include <thread>
 
@@ -63,11 +64,13 @@ System *DistIface::sys = nullptr;
 DistIface::SyncEvent *DistIface::syncEvent = nullptr;
 unsigned DistIface::distIfaceNum = 0;
 unsigned DistIface::recvThreadsNum = 0;
+std::atomic<unsigned> DistIface::packetsSent(0);
 DistIface *DistIface::primary = nullptr;
 bool DistIface::isSwitch = false;
 
 void
-DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
+DistIface::Sync::init(Tick start_tick, Tick repeat_tick,
+                      unsigned max_stretch)
 {
     if (start_tick < nextAt) {
         nextAt = start_tick;
@@ -82,6 +85,9 @@ DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
         inform("Dist synchronisation interval is changed to %lu.\n",
                nextRepeat);
     }
+
+    if (max_stretch > maxStretch)
+        maxStretch = max_stretch;
 }
 
 void
@@ -101,6 +107,7 @@ DistIface::SyncSwitch::SyncSwitch(int num_nodes)
     numExitReq = 0;
     numCkptReq = 0;
     numStopSyncReq = 0;
+    numPackets = 0;
     doExit = false;
     doCkpt = false;
     doStopSync = false;
@@ -136,6 +143,7 @@ DistIface::SyncNode::run(bool same_tick)
     header.msgType = MsgType::cmdSyncReq;
     header.sendTick = curTick();
     header.syncRepeat = nextRepeat;
+    header.syncCount = DistIface::packetsSent.exchange(0);
     header.needCkpt = needCkpt;
     header.needStopSync = needStopSync;
     if (needCkpt != ReqType::none)
@@ -174,6 +182,16 @@ DistIface::SyncSwitch::run(bool same_tick)
     header.msgType = MsgType::cmdSyncAck;
     header.sendTick = nextAt;
     header.syncRepeat = nextRepeat;
+    // Postpone the next sync further for every sync interval in a row
+    // with no packets in flight, and go back to the link delay as soon
+    // as there is traffic again.
+    numPackets += DistIface::packetsSent.exchange(0);
+    if (numPackets == 0)
+        nextStretch = std::min(nextStretch * 2, maxStretch);
+    else
+        nextStretch = 1;
+    numPackets = 0;
+    header.syncCount = nextStretch;
     if (doCkpt || numCkptReq == numNodes) {
         doCkpt = true;
         header.needCkpt = ReqType::immediate;
@@ -201,6 +219,7 @@ DistIface::SyncSwitch::run(bool same_tick)
 bool
 DistIface::SyncSwitch::progress(Tick send_tick,
                                  Tick sync_repeat,
+                                 unsigned num_packets,
                                  ReqType need_ckpt,
                                  ReqType need_exit,
                                  ReqType need_stop_sync)
@@ -214,6 +233,7 @@ DistIface::SyncSwitch::progress(Tick send_tick,
         nextAt = send_tick;
     if (nextRepeat > sync_repeat)
         nextRepeat = sync_repeat;
+    numPackets += num_packets;
 
     if (need_ckpt == ReqType::collective)
         numCkptReq++;
@@ -242,6 +262,7 @@ DistIface::SyncSwitch::progress(Tick send_tick,
 bool
 DistIface::SyncNode::progress(Tick max_send_tick,
                                Tick next_repeat,
+                               unsigned next_stretch,
                                ReqType do_ckpt,
                                ReqType do_exit,
                                ReqType do_stop_sync)
@@ -253,6 +274,7 @@ DistIface::SyncNode::progress(Tick max_send_tick,
 
     nextAt = max_send_tick;
     nextRepeat = next_repeat;
+    nextStretch = next_stretch;
     doCkpt = (do_ckpt != ReqType::none);
     doExit = (do_exit != ReqType::none);
     doStopSync = (do_stop_sync != ReqType::none);
@@ -424,7 +446,7 @@ DistIface::SyncEvent::process()
         return;
     }
     // schedule the next periodic sync
-    repeat = DistIface::sync->nextRepeat;
+    repeat = DistIface::sync->nextRepeat * DistIface::sync->nextStretch;
     schedule(curTick() + repeat);
 }
 
@@ -446,6 +468,13 @@ DistIface::RecvScheduler::calcReceiveTick(Tick send_tick,
                                           Tick prev_recv_tick)
 {
     Tick recv_tick = send_tick + send_delay + linkDelay;
+    if (recv_tick <= curTick() && primary->syncEvent->stretched()) {
+        // The sender got ahead of us during a stretched sync interval,
+        // so deliver the packet as soon as we can.
+        DPRINTF(DistEthernetPkt, "Late packet (recv_tick: %lu), received "
+                "%lu ticks late\n", recv_tick, curTick() + 1 - recv_tick);
+        recv_tick = std::max(curTick() + 1, prev_recv_tick + send_delay);
+    }
     // sanity check (we need atleast a send delay long window)
     assert(recv_tick >= prev_recv_tick + send_delay);
     panic_if(prev_recv_tick + send_delay > recv_tick,
@@ -509,7 +538,8 @@ DistIface::RecvScheduler::pushPacket(EthPacketPtr new_packet,
     assert(send_tick > primary->syncEvent->when() -
            primary->syncEvent->repeat);
     // No packet may be scheduled for receive in the arrival quantum
-    assert(send_tick + send_delay + linkDelay > primary->syncEvent->when());
+    assert(primary->syncEvent->stretched() ||
+           send_tick + send_delay + linkDelay > primary->syncEvent->when());
 
     // Now we are about to schedule a recvDone event for the new data packet.
     // We use the same recvDone object for all incoming data packets. Packet
@@ -609,7 +639,7 @@ DistIface::DistIface(unsigned dist_rank,
                      EventManager *em,
                      bool use_pseudo_op,
                      bool is_switch, int num_nodes) :
-    syncStart(sync_start), syncRepeat(sync_repeat),
+    syncStart(sync_start), syncRepeat(sync_repeat), syncMaxStretch(1),
     recvThread(nullptr), recvScheduler(em), syncStartOnPseudoOp(use_pseudo_op),
     rank(dist_rank), size(dist_size)
 {
@@ -662,6 +692,7 @@ DistIface::packetOut(EthPacketPtr pkt, Tick send_delay)
 
     // Send out the packet and the meta info.
     sendPacket(header, pkt);
+    packetsSent++;
 
     DPRINTF(DistEthernetPkt,
             "DistIface::sendDataPacket() done size:%d send_delay:%llu\n",
@@ -705,6 +736,7 @@ DistIface::recvThreadFunc(Event *recv_done, Tick link_delay)
             // everything else must be synchronisation related command
             if (!sync->progress(header.sendTick,
                                 header.syncRepeat,
+                                header.syncCount,
                                 header.needCkpt,
                                 header.needExit,
                                 header.needStopSync))
@@ -800,7 +832,7 @@ DistIface::init(const Event *done_event, Tick link_delay)
     // might have different requirements. The singleton sync object
     // will select the minimum values for both params.
     assert(sync != nullptr);
-    sync->init(syncStart, syncRepeat);
+    sync->init(syncStart, syncRepeat, syncMaxStretch);
 
     // Initialize the seed for random generator to avoid the same sequence
     // in all gem5 peer processes
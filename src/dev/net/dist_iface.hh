@@ -76,6 +76,7 @@
 #define __DEV_DIST_IFACE_HH__
 
 #include <array>
+#include <atomic>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -149,6 +150,17 @@ class DistIface : public Drainable, public Serializable
          * The repeat value for the next periodic sync
          */
         Tick nextRepeat;
+        /**
+         * Number of repeat intervals until the next periodic sync. This
+         * is more than one only while no packets are in flight and
+         * stretching is enabled.
+         */
+        unsigned nextStretch = 1;
+        /**
+         * Upper bound for nextStretch (only used by the switch, which
+         * decides the stretch for everyone)
+         */
+        unsigned maxStretch = 1;
         /**
          * Tick for the next periodic sync (if the event is not scheduled yet)
          */
@@ -166,9 +178,11 @@ class DistIface : public Drainable, public Serializable
          *
          * @param start Start tick for dist synchronisation
          * @param repeat Frequency of dist synchronisation
+         * @param max_stretch Number of repeat intervals the sync may be
+         * stretched to while the network is idle
          *
          */
-        void init(Tick start, Tick repeat);
+        void init(Tick start, Tick repeat, unsigned max_stretch);
         /**
          *  Core method to perform a full dist sync.
          *
@@ -183,6 +197,7 @@ class DistIface : public Drainable, public Serializable
          */
         virtual bool progress(Tick send_tick,
                               Tick next_repeat,
+                              unsigned sync_count,
                               ReqType do_ckpt,
                               ReqType do_exit,
                               ReqType do_stop_sync) = 0;
@@ -225,6 +240,7 @@ class DistIface : public Drainable, public Serializable
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
                       Tick next_repeat,
+                      unsigned sync_count,
                       ReqType do_ckpt,
                       ReqType do_exit,
                       ReqType do_stop_sync) override;
@@ -256,6 +272,10 @@ class DistIface : public Drainable, public Serializable
          *  Number of connected simulated nodes
          */
         unsigned numNodes;
+        /**
+         * Data packets the nodes sent during the last sync interval
+         */
+        unsigned numPackets;
 
       public:
         SyncSwitch(int num_nodes);
@@ -264,6 +284,7 @@ class DistIface : public Drainable, public Serializable
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
                       Tick next_repeat,
+                      unsigned sync_count,
                       ReqType do_ckpt,
                       ReqType do_exit,
                       ReqType do_stop_sync) override;
@@ -322,6 +343,16 @@ class DistIface : public Drainable, public Serializable
 
         bool draining() const { return _draining; }
         void draining(bool fl) { _draining = fl; }
+
+        /**
+         * Is the current sync interval longer than the link delay
+         * allows (see Sync::nextStretch)?
+         */
+        bool
+        stretched() const
+        {
+            return repeat > DistIface::sync->nextRepeat;
+        }
     };
     /**
      * Class to encapsulate information about data packets received.
@@ -461,6 +492,11 @@ class DistIface : public Drainable, public Serializable
      * Frequency of dist sync events in ticks.
      */
     Tick syncRepeat;
+    /**
+     * Number of sync intervals a sync may be postponed by while no
+     * packets are in flight.
+     */
+    unsigned syncMaxStretch;
     /**
      * Receiver thread pointer.
      * Each DistIface object must have exactly one receiver thread.
@@ -500,6 +536,10 @@ class DistIface : public Drainable, public Serializable
      * Number of receiver threads (in this gem5 process)
      */
     static unsigned recvThreadsNum;
+    /**
+     * Data packets sent by this gem5 process since the last sync.
+     */
+    static std::atomic<unsigned> packetsSent;
     /**
      * The singleton Sync object to perform dist synchronisation.
      */
@@ -603,6 +643,19 @@ class DistIface : public Drainable, public Serializable
     void drainResume() override;
     void init(const Event *e, Tick link_delay);
     void startup();
+    /**
+     * Allow the periodic sync to be postponed by up to max_stretch sync
+     * intervals while no packets are in flight. A packet sent during a
+     * postponed interval may reach a peer that has already simulated
+     * past its arrival tick, in which case it is received as soon as
+     * possible instead. This trades accuracy for fewer barriers, so it
+     * is off (1) by default. Only the setting of the switch matters.
+     */
+    void
+    setSyncMaxStretch(unsigned max_stretch)
+    {
+        syncMaxStretch = max_stretch;
+    }
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
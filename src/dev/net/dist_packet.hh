@@ -87,11 +87,20 @@ class DistHeaderPkt
          */
         MsgType msgType;
         Tick sendTick;
-        /**
-         * Length used for modeling timing in the simulator.
-         * (from EthPacketData::simLength).
-         */
-        unsigned simLength;
+        union
+        {
+            /**
+             * Length used for modeling timing in the simulator.
+             * (from EthPacketData::simLength).
+             */
+            unsigned simLength;
+            /**
+             * Sync requests carry the number of data packets the sender
+             * sent since the previous sync, sync acks the number of sync
+             * intervals until the next sync.
+             */
+            unsigned syncCount;
+        };
         union
         {
             Tick sendDelay;
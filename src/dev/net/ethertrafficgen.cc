@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dev/net/ethertrafficgen.hh"
+
+#include <cmath>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/EtherTrafficGen.hh"
+#include "dev/net/etherdump.hh"
+#include "sim/byteswap.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+#include "sim/serialize.hh"
+#include "sim/stats.hh"
+
+namespace gem5
+{
+
+using namespace networking;
+
+namespace
+{
+
+constexpr uint32_t PcapMagic = 0xa1b2c3d4;
+constexpr uint32_t PcapMagicNsec = 0xa1b23c4d;
+constexpr uint32_t PcapLinkEthernet = 1;
+constexpr size_t PcapFileHeaderLen = 24;
+constexpr size_t PcapRecordHeaderLen = 16;
+
+constexpr unsigned SyntheticHeaderLen = ETH_HDR_LEN + IP_HDR_LEN + UDP_HDR_LEN;
+
+} // anonymous namespace
+
+EtherTrafficGen::EtherTrafficGen(const Params &p)
+    : SimObject(p), interface(name() + ".interface", this), dump(p.dump),
+      traceNsec(false), traceSwapped(false), traceStart(0), tracePos(0),
+      traceFirstTs(0),
+      traceBase(0), traceLastTs(0),
+      traceLoop(p.trace_loop), traceTiming(p.trace_timing),
+      traceTimeScale(p.trace_time_scale),
+      ticksPerByte(p.rate), randomGaps(p.random_gaps),
+      packetSize(p.packet_size), numFlows(p.num_flows),
+      srcMac(p.src_mac), dstMac(p.dst_mac),
+      srcIp(p.src_ip.ip()), dstIp(p.dst_ip.ip()),
+      srcPort(p.src_port), dstPort(p.dst_port),
+      startTick(p.start_time), maxPackets(p.max_packets),
+      numGenerated(0), txTick(0),
+      txEvent([this]{ transmit(); }, name()),
+      stats(this)
+{
+    fatal_if(traceTimeScale <= 0, "%s: trace_time_scale must be positive\n",
+             name());
+    fatal_if(numFlows == 0, "%s: num_flows must be at least 1\n", name());
+    fatal_if(numFlows > 0x10000u - srcPort,
+             "%s: %d flows don't fit in the ports after %d\n", name(),
+             numFlows, srcPort);
+
+    if (!p.trace.empty()) {
+        openTrace(p.trace);
+    } else {
+        fatal_if(packetSize < SyntheticHeaderLen + sizeof(uint64_t) ||
+                 packetSize > ETH_LEN_MAX,
+                 "%s: packet_size must be between %d and %d bytes\n", name(),
+                 SyntheticHeaderLen + sizeof(uint64_t), ETH_LEN_MAX);
+    }
+}
+
+Port &
+EtherTrafficGen::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "interface")
+        return interface;
+    return SimObject::getPort(if_name, idx);
+}
+
+uint32_t
+EtherTrafficGen::traceWord(const uint8_t *bytes) const
+{
+    uint32_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return traceSwapped ? swap_byte(word) : word;
+}
+
+void
+EtherTrafficGen::openTrace(const std::string &file)
+{
+    trace.open(file, std::ios::in | std::ios::binary);
+    fatal_if(!trace, "%s: can't open trace %s\n", name(), file);
+
+    uint8_t hdr[PcapFileHeaderLen];
+    fatal_if(!trace.read((char *)hdr, sizeof(hdr)),
+             "%s: %s is too short to be a pcap trace\n", name(), file);
+
+    uint32_t magic;
+    std::memcpy(&magic, hdr, sizeof(magic));
+    if (magic == swap_byte(PcapMagic) || magic == swap_byte(PcapMagicNsec)) {
+        traceSwapped = true;
+        magic = swap_byte(magic);
+    }
+    fatal_if(magic != PcapMagic && magic != PcapMagicNsec,
+             "%s: %s is not a pcap trace\n", name(), file);
+    traceNsec = magic == PcapMagicNsec;
+    fatal_if(traceWord(hdr + 20) != PcapLinkEthernet,
+             "%s: %s is not an Ethernet trace\n", name(), file);
+
+    traceStart = trace.tellg();
+    tracePos = traceStart;
+
+    // Replay times are relative to the first frame
+    uint8_t rec[PcapRecordHeaderLen];
+    if (trace.read((char *)rec, sizeof(rec))) {
+        traceFirstTs = traceWord(rec) * sim_clock::as_int::s +
+            traceWord(rec + 4) *
+            (traceNsec ? sim_clock::as_int::ns : sim_clock::as_int::us);
+    }
+    traceLastTs = traceFirstTs;
+    trace.clear();
+    trace.seekg(traceStart);
+}
+
+EthPacketPtr
+EtherTrafficGen::readTrace(Tick &due)
+{
+    uint8_t rec[PcapRecordHeaderLen];
+    if (!trace.read((char *)rec, sizeof(rec))) {
+        if (!traceLoop)
+            return nullptr;
+        // Start the next pass where the last frame of this one ends
+        trace.clear();
+        trace.seekg(traceStart);
+        traceBase += (traceLastTs - traceFirstTs) * traceTimeScale +
+            std::ceil(txPacket ? txPacket->simLength * ticksPerByte : 0);
+        traceLastTs = traceFirstTs;
+        if (!trace.read((char *)rec, sizeof(rec)))
+            return nullptr;
+    }
+
+    Tick ts = traceWord(rec) * sim_clock::as_int::s + traceWord(rec + 4) *
+        (traceNsec ? sim_clock::as_int::ns : sim_clock::as_int::us);
+    uint32_t caplen = traceWord(rec + 8);
+    uint32_t len = traceWord(rec + 12);
+    fatal_if(caplen > len || len > 0xffff,
+             "%s: bad frame length %d (%d captured) in the trace\n",
+             name(), len, caplen);
+
+    // Frames captured truncated, as EtherDump writes them, are padded
+    // back to their length on the wire.
+    EthPacketPtr pkt = std::make_shared<EthPacketData>(len);
+    fatal_if(!trace.read((char *)pkt->data, caplen),
+             "%s: the trace is truncated\n", name());
+    std::memset(pkt->data + caplen, 0, len - caplen);
+    pkt->length = len;
+    pkt->simLength = len;
+
+    tracePos = trace.tellg();
+    if (ts > traceLastTs)
+        traceLastTs = ts;
+    due = startTick + traceBase +
+        Tick((ts > traceFirstTs ? ts - traceFirstTs : 0) * traceTimeScale);
+    return pkt;
+}
+
+EthPacketPtr
+EtherTrafficGen::makeSynthetic()
+{
+    EthPacketPtr pkt = std::make_shared<EthPacketData>(packetSize);
+    std::memset(pkt->data, 0, packetSize);
+    pkt->length = packetSize;
+    pkt->simLength = packetSize;
+
+    // One UDP flow per source port, so that receive side scaling in
+    // the NIC under test spreads them out.
+    uint16_t flow = numGenerated % numFlows;
+    uint8_t *hdr = pkt->data;
+    std::memcpy(hdr, dstMac.bytes(), ETH_ADDR_LEN);
+    std::memcpy(hdr + ETH_ADDR_LEN, srcMac.bytes(), ETH_ADDR_LEN);
+    ((eth_hdr *)hdr)->eth_type = htons(ETH_TYPE_IP);
+
+    hdr += ETH_HDR_LEN;
+    ip_pack_hdr(hdr, 0, packetSize - ETH_HDR_LEN, numGenerated, 0,
+                IP_TTL_DEFAULT, IP_PROTO_UDP, htonl(srcIp), htonl(dstIp));
+    ((ip_hdr *)hdr)->ip_sum = 0;
+
+    hdr += IP_HDR_LEN;
+    udp_pack_hdr(hdr, srcPort + flow, dstPort,
+                 packetSize - ETH_HDR_LEN - IP_HDR_LEN);
+    // A zero UDP checksum means there is none
+    ((udp_hdr *)hdr)->uh_sum = 0;
+
+    // Sequence number, for matching the frames up in a dump
+    uint64_t seq = htobe(numGenerated);
+    std::memcpy(hdr + UDP_HDR_LEN, &seq, sizeof(seq));
+
+    IpPtr ip(pkt);
+    ip->sum(cksum(ip));
+    return pkt;
+}
+
+void
+EtherTrafficGen::generate()
+{
+    Tick gap = 0;
+    if (txPacket) {
+        double mean = txPacket->simLength * ticksPerByte;
+        if (randomGaps)
+            mean *= -std::log(1.0 - random_mt.random<double>());
+        gap = std::ceil(mean);
+    }
+
+    EthPacketPtr pkt;
+    Tick due = numGenerated ? txTick + gap : startTick;
+    if (maxPackets == 0 || numGenerated < maxPackets) {
+        if (trace.is_open()) {
+            Tick trace_due;
+            pkt = readTrace(trace_due);
+            if (traceTiming)
+                due = trace_due;
+        } else {
+            pkt = makeSynthetic();
+        }
+    }
+
+    txPacket = pkt;
+    if (!txPacket) {
+        DPRINTF(EtherTrafficGen, "Done after %d frames\n", numGenerated);
+        return;
+    }
+    numGenerated++;
+    txTick = due;
+}
+
+void
+EtherTrafficGen::scheduleTransmit()
+{
+    if (txPacket && !txEvent.scheduled())
+        schedule(txEvent, std::max(txTick, curTick()));
+}
+
+void
+EtherTrafficGen::startup()
+{
+    // After a checkpoint restore the next frame is already set up
+    if (numGenerated == 0) {
+        generate();
+        scheduleTransmit();
+    }
+}
+
+void
+EtherTrafficGen::transmit()
+{
+    assert(txPacket);
+
+    if (!interface.sendPacket(txPacket)) {
+        // Wait for the link to be done with the previous frame
+        DPRINTF(EtherTrafficGen, "Link busy, holding frame %d\n",
+                numGenerated - 1);
+        stats.txStalls++;
+        return;
+    }
+
+    DPRINTF(EtherTrafficGen, "Sent frame %d, %d bytes, %d ticks late\n",
+            numGenerated - 1, txPacket->length, curTick() - txTick);
+    if (dump)
+        dump->dump(txPacket);
+    stats.txPackets++;
+    stats.txBytes += txPacket->length;
+    stats.txDelay += curTick() - txTick;
+
+    generate();
+    scheduleTransmit();
+}
+
+void
+EtherTrafficGen::sendDone()
+{
+    scheduleTransmit();
+}
+
+bool
+EtherTrafficGen::recvPacket(EthPacketPtr pkt)
+{
+    DPRINTF(EtherTrafficGen, "Absorbed a %d byte frame\n", pkt->length);
+    if (dump)
+        dump->dump(pkt);
+    stats.rxPackets++;
+    stats.rxBytes += pkt->length;
+    return true;
+}
+
+void
+EtherTrafficGen::serialize(CheckpointOut &cp) const
+{
+    SERIALIZE_SCALAR(numGenerated);
+    SERIALIZE_SCALAR(txTick);
+    SERIALIZE_SCALAR(traceBase);
+    SERIALIZE_SCALAR(traceLastTs);
+
+    SERIALIZE_SCALAR(tracePos);
+
+    bool txPacketExists = txPacket != nullptr;
+    SERIALIZE_SCALAR(txPacketExists);
+    if (txPacketExists)
+        txPacket->serialize("txPacket", cp);
+
+    bool txEventScheduled = txEvent.scheduled();
+    SERIALIZE_SCALAR(txEventScheduled);
+    if (txEventScheduled) {
+        Tick txEventTime = txEvent.when();
+        SERIALIZE_SCALAR(txEventTime);
+    }
+}
+
+void
+EtherTrafficGen::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_SCALAR(numGenerated);
+    UNSERIALIZE_SCALAR(txTick);
+    UNSERIALIZE_SCALAR(traceBase);
+    UNSERIALIZE_SCALAR(traceLastTs);
+
+    UNSERIALIZE_SCALAR(tracePos);
+    if (trace.is_open()) {
+        trace.clear();
+        trace.seekg(tracePos);
+    }
+
+    bool txPacketExists;
+    UNSERIALIZE_SCALAR(txPacketExists);
+    txPacket = nullptr;
+    if (txPacketExists) {
+        txPacket = std::make_shared<EthPacketData>();
+        txPacket->unserialize("txPacket", cp);
+    }
+
+    bool txEventScheduled;
+    UNSERIALIZE_SCALAR(txEventScheduled);
+    if (txEventScheduled) {
+        Tick txEventTime;
+        UNSERIALIZE_SCALAR(txEventTime);
+        schedule(txEvent, txEventTime);
+    }
+}
+
+EtherTrafficGen::TrafficGenStats::TrafficGenStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(txPackets, statistics::units::Count::get(),
+               "Number of frames sent"),
+      ADD_STAT(txBytes, statistics::units::Byte::get(),
+               "Number of bytes sent"),
+      ADD_STAT(txStalls, statistics::units::Count::get(),
+               "Number of times a frame was held because the link was busy"),
+      ADD_STAT(txDelay, statistics::units::Tick::get(),
+               "Total time the sent frames were held past their schedule"),
+      ADD_STAT(rxPackets, statistics::units::Count::get(),
+               "Number of frames absorbed"),
+      ADD_STAT(rxBytes, statistics::units::Byte::get(),
+               "Number of bytes absorbed"),
+      ADD_STAT(txBandwidth, statistics::units::Rate<
+                    statistics::units::Bit, statistics::units::Second>::get(),
+               "Transmit bandwidth",
+               txBytes * statistics::constant(8) / simSeconds),
+      ADD_STAT(rxBandwidth, statistics::units::Rate<
+                    statistics::units::Bit, statistics::units::Second>::get(),
+               "Receive bandwidth",
+               rxBytes * statistics::constant(8) / simSeconds),
+      ADD_STAT(avgTxDelay, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average time a frame was held past its schedule",
+               txDelay / txPackets)
+{
+}
+
+} // namespace gem5
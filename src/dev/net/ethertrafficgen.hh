@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Ethernet traffic generator that replays a pcap trace or synthetic
+ * UDP flows into a simulated network and absorbs the responses.
+ */
+
+#ifndef __DEV_NET_ETHERTRAFFICGEN_HH__
+#define __DEV_NET_ETHERTRAFFICGEN_HH__
+
+#include <fstream>
+#include <string>
+
+#include "base/inet.hh"
+#include "base/statistics.hh"
+#include "dev/net/etherint.hh"
+#include "dev/net/etherpkt.hh"
+#include "params/EtherTrafficGen.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class EtherDump;
+
+/**
+ * Stand-in for the clients of a network bound workload. Instead of
+ * simulating the client systems, the generator injects their frames
+ * directly: either the frames of a pcap trace, at the recorded times or
+ * at a given rate, or synthetic UDP frames spread over a number of
+ * flows. Everything sent back to the generator is counted and dropped.
+ *
+ * The generator is open loop. A frame that can't be sent because the
+ * link is busy is held until the link is done, and the ones after it
+ * keep their schedule.
+ */
+class EtherTrafficGen : public SimObject
+{
+  public:
+    using Params = EtherTrafficGenParams;
+    EtherTrafficGen(const Params &p);
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void startup() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+  protected:
+    class Interface : public EtherInt
+    {
+      private:
+        EtherTrafficGen *gen;
+
+      public:
+        Interface(const std::string &name, EtherTrafficGen *_gen)
+            : EtherInt(name), gen(_gen)
+        {}
+
+        bool recvPacket(EthPacketPtr pkt) override
+        { return gen->recvPacket(pkt); }
+        void sendDone() override { gen->sendDone(); }
+    };
+
+    Interface interface;
+    EtherDump *dump;
+
+    /** Trace to replay, not open for synthetic traffic */
+    std::ifstream trace;
+    /** The trace uses nanosecond rather than microsecond timestamps */
+    bool traceNsec;
+    /** The trace was written with the other byte order */
+    bool traceSwapped;
+    /** Offset of the first record in the trace */
+    std::streamoff traceStart;
+    /** Offset of the record after the one of txPacket */
+    std::streamoff tracePos;
+    /** Timestamp of the first record of the trace */
+    Tick traceFirstTs;
+    /** Tick the current pass over the trace started at */
+    Tick traceBase;
+    /** Timestamp of the last record read, to start the next pass */
+    Tick traceLastTs;
+
+    const bool traceLoop;
+    const bool traceTiming;
+    const double traceTimeScale;
+
+    const float ticksPerByte;
+    const bool randomGaps;
+    const unsigned packetSize;
+    const unsigned numFlows;
+    const networking::EthAddr srcMac;
+    const networking::EthAddr dstMac;
+    const uint32_t srcIp;
+    const uint32_t dstIp;
+    const uint16_t srcPort;
+    const uint16_t dstPort;
+
+    const Tick startTick;
+    const uint64_t maxPackets;
+
+    /** Frames generated so far, including txPacket */
+    uint64_t numGenerated;
+
+    /** Next frame to send and the tick it is due at */
+    EthPacketPtr txPacket;
+    Tick txTick;
+
+    void transmit();
+    EventFunctionWrapper txEvent;
+
+    void openTrace(const std::string &file);
+    uint32_t traceWord(const uint8_t *bytes) const;
+    /** Read the next frame of the trace, or return null at its end */
+    EthPacketPtr readTrace(Tick &due);
+    EthPacketPtr makeSynthetic();
+
+    /**
+     * Generate the frame after txPacket and find out when it is due,
+     * leaving txPacket null when there is nothing left to send.
+     */
+    void generate();
+    void scheduleTransmit();
+
+    bool recvPacket(EthPacketPtr pkt);
+    void sendDone();
+
+    struct TrafficGenStats : public statistics::Group
+    {
+        TrafficGenStats(statistics::Group *parent);
+
+        statistics::Scalar txPackets;
+        statistics::Scalar txBytes;
+        statistics::Scalar txStalls;
+        statistics::Scalar txDelay;
+        statistics::Scalar rxPackets;
+        statistics::Scalar rxBytes;
+        statistics::Formula txBandwidth;
+        statistics::Formula rxBandwidth;
+        statistics::Formula avgTxDelay;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_ETHERTRAFFICGEN_HH__
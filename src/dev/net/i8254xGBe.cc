@@ -827,13 +827,19 @@ template<class T>
 IGbE::DescCache<T>::DescCache(IGbE *i, const std::string n, int s)
     : igbe(i), _name(n), cachePnt(0), size(s), curFetching(0),
       wbOut(0), moreToWb(false), wbAlignment(0), pktPtr(NULL),
+      fetchPartsOut(0),
       wbDelayEvent([this]{ writeback1(); }, n),
       fetchDelayEvent([this]{ fetchDescriptors1(); }, n),
-      fetchEvent([this]{ fetchComplete(); }, n),
+      fetchEvent([this]{ fetchPartComplete(); }, n),
+      fetchWrapEvent([this]{ fetchPartComplete(); }, n),
       wbEvent([this]{ wbComplete(); }, n)
 {
     fetchBuf = new T[size];
     wbBuf = new T[size];
+    descPool = new T[size];
+    freeDescs.reserve(size);
+    for (int x = size - 1; x >= 0; x--)
+        freeDescs.push_back(&descPool[x]);
 }
 
 template<class T>
@@ -842,6 +848,7 @@ IGbE::DescCache<T>::~DescCache()
     reset();
     delete[] fetchBuf;
     delete[] wbBuf;
+    delete[] descPool;
 }
 
 template<class T>
@@ -899,7 +906,10 @@ IGbE::DescCache<T>::writeback(Addr aMask)
     wbOut = max_to_wb;
 
     assert(!wbDelayEvent.scheduled());
-    igbe->schedule(wbDelayEvent, curTick() + igbe->wbDelay);
+    if (igbe->wbDelay)
+        igbe->schedule(wbDelayEvent, curTick() + igbe->wbDelay);
+    else
+        writeback1();
 }
 
 template<class T>
@@ -908,7 +918,8 @@ IGbE::DescCache<T>::writeback1()
 {
     // If we're draining delay issuing this DMA
     if (igbe->drainState() != DrainState::Running) {
-        igbe->schedule(wbDelayEvent, curTick() + igbe->wbDelay);
+        igbe->schedule(wbDelayEvent, curTick() +
+                       std::max(igbe->wbDelay, igbe->clockPeriod()));
         return;
     }
 
@@ -939,10 +950,12 @@ IGbE::DescCache<T>::fetchDescriptors()
         return;
     }
 
+    // Descriptors past the end of the ring are fetched along with the
+    // ones at its start, rather than in a second round
     if (descTail() >= cachePnt)
         max_to_fetch = descTail() - cachePnt;
     else
-        max_to_fetch = descLen() - cachePnt;
+        max_to_fetch = descLen() - cachePnt + descTail();
 
     size_t free_cache = size - usedCache.size() - unusedCache.size();
 
@@ -962,7 +975,10 @@ IGbE::DescCache<T>::fetchDescriptors()
     curFetching = max_to_fetch;
 
     assert(!fetchDelayEvent.scheduled());
-    igbe->schedule(fetchDelayEvent, curTick() + igbe->fetchDelay);
+    if (igbe->fetchDelay)
+        igbe->schedule(fetchDelayEvent, curTick() + igbe->fetchDelay);
+    else
+        fetchDescriptors1();
 }
 
 template<class T>
@@ -971,18 +987,37 @@ IGbE::DescCache<T>::fetchDescriptors1()
 {
     // If we're draining delay issuing this DMA
     if (igbe->drainState() != DrainState::Running) {
-        igbe->schedule(fetchDelayEvent, curTick() + igbe->fetchDelay);
+        igbe->schedule(fetchDelayEvent, curTick() +
+                       std::max(igbe->fetchDelay, igbe->clockPeriod()));
         return;
     }
 
+    assert(curFetching);
+    int to_end = std::min<int>(curFetching, descLen() - cachePnt);
+
     DPRINTF(EthernetDesc, "Fetching descriptors at %#x (%#x), size: %#x\n",
             descBase() + cachePnt * sizeof(T),
             pciToDma(descBase() + cachePnt * sizeof(T)),
             curFetching * sizeof(T));
-    assert(curFetching);
+    fetchPartsOut = 1;
     igbe->dmaRead(pciToDma(descBase() + cachePnt * sizeof(T)),
-                  curFetching * sizeof(T), &fetchEvent, (uint8_t *)fetchBuf,
+                  to_end * sizeof(T), &fetchEvent, (uint8_t *)fetchBuf,
                   igbe->fetchCompDelay);
+    if (curFetching > to_end) {
+        fetchPartsOut++;
+        igbe->dmaRead(pciToDma(descBase()),
+                      (curFetching - to_end) * sizeof(T), &fetchWrapEvent,
+                      (uint8_t *)(fetchBuf + to_end), igbe->fetchCompDelay);
+    }
+}
+
+template<class T>
+void
+IGbE::DescCache<T>::fetchPartComplete()
+{
+    assert(fetchPartsOut > 0);
+    if (--fetchPartsOut == 0)
+        fetchComplete();
 }
 
 template<class T>
@@ -991,7 +1026,7 @@ IGbE::DescCache<T>::fetchComplete()
 {
     T *newDesc;
     for (int x = 0; x < curFetching; x++) {
-        newDesc = new T;
+        newDesc = allocDesc();
         memcpy(newDesc, &fetchBuf[x], sizeof(T));
         unusedCache.push_back(newDesc);
     }
@@ -1000,9 +1035,9 @@ IGbE::DescCache<T>::fetchComplete()
     int oldCp = cachePnt;
 
     cachePnt += curFetching;
-    assert(cachePnt <= descLen());
-    if (cachePnt == descLen())
-        cachePnt = 0;
+    if (cachePnt >= descLen())
+        cachePnt -= descLen();
+    assert(cachePnt < descLen());
 
     curFetching = 0;
 
@@ -1023,7 +1058,7 @@ IGbE::DescCache<T>::wbComplete()
 
     for (int x = 0; x < wbOut; x++) {
         assert(usedCache.size());
-        delete usedCache[0];
+        freeDesc(usedCache[0]);
         usedCache.pop_front();
     }
 
@@ -1058,9 +1093,9 @@ IGbE::DescCache<T>::reset()
 {
     DPRINTF(EthernetDesc, "Reseting descriptor cache\n");
     for (typename CacheType::size_type x = 0; x < usedCache.size(); x++)
-        delete usedCache[x];
+        freeDesc(usedCache[x]);
     for (typename CacheType::size_type x = 0; x < unusedCache.size(); x++)
-        delete unusedCache[x];
+        freeDesc(unusedCache[x]);
 
     usedCache.clear();
     unusedCache.clear();
@@ -1118,7 +1153,7 @@ IGbE::DescCache<T>::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(usedCacheSize);
     T *temp;
     for (typename CacheType::size_type x = 0; x < usedCacheSize; x++) {
-        temp = new T;
+        temp = allocDesc();
         arrayParamIn(cp, csprintf("usedCache_%d", x),
                      (uint8_t *)temp, sizeof(T));
         usedCache.push_back(temp);
@@ -1127,7 +1162,7 @@ IGbE::DescCache<T>::unserialize(CheckpointIn &cp)
     typename CacheType::size_type unusedCacheSize;
     UNSERIALIZE_SCALAR(unusedCacheSize);
     for (typename CacheType::size_type x = 0; x < unusedCacheSize; x++) {
-        temp = new T;
+        temp = allocDesc();
         arrayParamIn(cp, csprintf("unusedCache_%d", x),
                      (uint8_t *)temp, sizeof(T));
         unusedCache.push_back(temp);
@@ -1468,8 +1503,8 @@ IGbE::RxDescCache::packetDone()
 bool
 IGbE::RxDescCache::hasOutstandingEvents()
 {
-    return pktEvent.scheduled() || wbEvent.scheduled() ||
-        fetchEvent.scheduled() || pktHdrEvent.scheduled() ||
+    return DescCache<RxDesc>::hasOutstandingEvents() ||
+        pktEvent.scheduled() || pktHdrEvent.scheduled() ||
         pktDataEvent.scheduled();
 
 }
@@ -1994,8 +2029,8 @@ IGbE::TxDescCache::enableSm()
 bool
 IGbE::TxDescCache::hasOutstandingEvents()
 {
-    return pktEvent.scheduled() || wbEvent.scheduled() ||
-        fetchEvent.scheduled();
+    return DescCache<TxDesc>::hasOutstandingEvents() ||
+        pktEvent.scheduled();
 }
 
 
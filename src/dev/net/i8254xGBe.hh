@@ -36,6 +36,7 @@
 #include <cstdint>
 #include <deque>
 #include <string>
+#include <vector>
 
 #include "base/inet.hh"
 #include "base/trace.hh"
@@ -197,6 +198,26 @@ class IGbE : public EtherDevice
         T *fetchBuf;
         T *wbBuf;
 
+        /** Storage of the cached descriptors, which are handed out from a
+         * free list rather than allocated one by one */
+        T *descPool;
+        std::vector<T *> freeDescs;
+
+        T *
+        allocDesc()
+        {
+            assert(!freeDescs.empty());
+            T *desc = freeDescs.back();
+            freeDescs.pop_back();
+            return desc;
+        }
+
+        void freeDesc(T *desc) { freeDescs.push_back(desc); }
+
+        /** Number of DMAs of the current fetch still outstanding, as a
+         * fetch that wraps around the end of the ring is made of two */
+        int fetchPartsOut;
+
         // Pointer to the device we cache for
         IGbE *igbe;
 
@@ -258,7 +279,9 @@ class IGbE : public EtherDevice
         /** Called by event when dma to read descriptors is completed
          */
         void fetchComplete();
+        void fetchPartComplete();
         EventFunctionWrapper fetchEvent;
+        EventFunctionWrapper fetchWrapEvent;
 
         /** Called by event when dma to writeback descriptors is completed
          */
@@ -296,7 +319,8 @@ class IGbE : public EtherDevice
         void unserialize(CheckpointIn &cp) override;
 
         virtual bool hasOutstandingEvents() {
-            return wbEvent.scheduled() || fetchEvent.scheduled();
+            return wbEvent.scheduled() || fetchEvent.scheduled() ||
+                fetchWrapEvent.scheduled();
         }
 
     };
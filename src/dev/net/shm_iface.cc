@@ -0,0 +1,410 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs.
+ */
+
+#include "dev/net/shm_iface.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+              std::atomic<uint64_t>::is_always_lock_free,
+              "Shared memory rings need address-free atomics");
+
+/** Sleep as long as word holds val, or until woken up. */
+void
+futexWait(std::atomic<uint32_t> &word, uint32_t val)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, &word, FUTEX_WAIT, val, nullptr, nullptr, 0);
+#else
+    if (word.load() == val)
+        std::this_thread::yield();
+#endif
+}
+
+/** Wake up the sleepers on word, in any process. */
+void
+futexWake(std::atomic<uint32_t> &word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, &word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+} // anonymous namespace
+
+/**
+ * Single producer, single consumer byte ring. The positions only ever
+ * grow and wrap around naturally; the ring size is a power of two.
+ */
+struct ShmIface::Ring
+{
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> readerWaiting;
+    std::atomic<uint32_t> writerWaiting;
+    std::atomic<uint32_t> closed;
+    uint32_t size;
+
+    uint8_t *data() { return reinterpret_cast<uint8_t *>(this + 1); }
+};
+
+struct ShmIface::Segment
+{
+    static const uint64_t Magic = 0x6435736d69666163ULL;
+
+    /** Set by the node once the rest of the segment is valid */
+    std::atomic<uint64_t> magic;
+    /** Link info of the node */
+    uint32_t rank;
+    uint32_t distIfaceId;
+    uint32_t distIfaceNum;
+    uint32_t ringSize;
+    /** Set by the switch once it is attached */
+    std::atomic<uint32_t> ack;
+    uint32_t switchIfaceId;
+
+    static size_t
+    ringOffset(int idx, uint32_t ring_size)
+    {
+        return roundUp(sizeof(Segment), 64) +
+            idx * roundUp(sizeof(Ring) + ring_size, 64);
+    }
+
+    Ring *
+    ring(int idx)
+    {
+        return reinterpret_cast<Ring *>(
+            reinterpret_cast<uint8_t *>(this) + ringOffset(idx, ringSize));
+    }
+};
+
+std::vector<ShmIface *> ShmIface::registry;
+
+ShmIface::ShmIface(unsigned server_port, uint64_t ring_size,
+                   unsigned dist_rank, unsigned dist_size,
+                   Tick sync_start, Tick sync_repeat,
+                   EventManager *em, bool use_pseudo_op, bool is_switch,
+                   int num_nodes) :
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
+              is_switch, num_nodes), serverPort(server_port),
+    ringSize(ring_size), isSwitch(is_switch), segment(nullptr),
+    segmentSize(Segment::ringOffset(2, ring_size)),
+    txRing(nullptr), rxRing(nullptr)
+{
+    fatal_if(!isPowerOf2(ring_size) || ring_size > (1ULL << 31),
+             "ShmIface: ring size %d must be a power of two of at most 2GiB",
+             ring_size);
+}
+
+ShmIface::~ShmIface()
+{
+    if (!segment)
+        return;
+
+    // Let both sides notice that this end is gone
+    for (Ring *r : {txRing, rxRing}) {
+        r->closed.store(1);
+        futexWake(r->head);
+        futexWake(r->tail);
+    }
+
+    if (!isSwitch)
+        shm_unlink(segmentName(rank, distIfaceId).c_str());
+
+    [[maybe_unused]] int ret = munmap(segment, segmentSize);
+    assert(ret == 0);
+}
+
+std::string
+ShmIface::segmentName(unsigned rank, unsigned iface_id) const
+{
+    return csprintf("/gem5-dist.%d.%d.%d", serverPort, rank, iface_id);
+}
+
+void
+ShmIface::map(int fd)
+{
+    void *ptr = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+    panic_if(ptr == MAP_FAILED, "mmap() of dist segment failed: %s",
+             strerror(errno));
+    close(fd);
+    segment = static_cast<Segment *>(ptr);
+}
+
+void
+ShmIface::create()
+{
+    const std::string seg_name = segmentName(rank, distIfaceId);
+
+    int fd = shm_open(seg_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        // Left behind by a run that didn't shut down cleanly
+        shm_unlink(seg_name.c_str());
+        fd = shm_open(seg_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    }
+    panic_if(fd < 0, "shm_open(%s) failed: %s", seg_name, strerror(errno));
+    panic_if(ftruncate(fd, segmentSize) != 0,
+             "Setting size of %s failed: %s", seg_name, strerror(errno));
+    map(fd);
+
+    // A new object is zero filled, so only the sizes need setting up.
+    segment->rank = rank;
+    segment->distIfaceId = distIfaceId;
+    segment->distIfaceNum = distIfaceNum;
+    segment->ringSize = ringSize;
+    txRing = segment->ring(0);
+    rxRing = segment->ring(1);
+    txRing->size = ringSize;
+    rxRing->size = ringSize;
+    segment->magic.store(Segment::Magic);
+
+    DPRINTF(DistEthernet, "Created %s, waiting for ack (distIfaceId:%d)\n",
+            seg_name, distIfaceId);
+    while (!segment->ack.load())
+        futexWait(segment->ack, 0);
+    inform("Link okay  (iface:%d -> switch iface:%d)", distIfaceId,
+           segment->switchIfaceId);
+}
+
+void
+ShmIface::attach()
+{
+    // The nodes are attached to the switch ports in the same order as
+    // TCPIface connects them.
+    static unsigned cur_rank = 0;
+    static unsigned cur_id = 0;
+
+    const std::string seg_name = segmentName(cur_rank, cur_id);
+    DPRINTF(DistEthernet, "Waiting for %s\n", seg_name);
+
+    int fd;
+    while ((fd = shm_open(seg_name.c_str(), O_RDWR, 0)) < 0) {
+        panic_if(errno != ENOENT, "shm_open(%s) failed: %s", seg_name,
+                 strerror(errno));
+        usleep(1000);
+    }
+    // The node may not have sized the segment yet
+    struct stat st;
+    for (;;) {
+        panic_if(fstat(fd, &st) != 0, "fstat(%s) failed: %s", seg_name,
+                 strerror(errno));
+        if (st.st_size != 0)
+            break;
+        usleep(1000);
+    }
+    fatal_if((size_t)st.st_size != segmentSize,
+             "%s was created with a different ring size", seg_name);
+    map(fd);
+
+    while (segment->magic.load() != Segment::Magic)
+        usleep(1000);
+    assert(segment->rank == cur_rank);
+    assert(segment->distIfaceId == cur_id);
+
+    inform("Link okay  (iface:%d -> (node:%d, iface:%d))",
+           distIfaceId, segment->rank, segment->distIfaceId);
+    if (segment->distIfaceId < segment->distIfaceNum - 1) {
+        cur_id++;
+    } else {
+        cur_rank++;
+        cur_id = 0;
+    }
+
+    txRing = segment->ring(1);
+    rxRing = segment->ring(0);
+
+    segment->switchIfaceId = distIfaceId;
+    segment->ack.store(1);
+    futexWake(segment->ack);
+
+    // Both ends have it mapped now, so the name is no longer needed.
+    shm_unlink(seg_name.c_str());
+}
+
+void
+ShmIface::sendShm(const void *buf, unsigned length)
+{
+    Ring &r = *txRing;
+    const uint8_t *src = static_cast<const uint8_t *>(buf);
+
+    while (length) {
+        if (r.closed.load()) {
+            exitSimLoop("Message server closed connection, simulation "
+                        "is exiting");
+            return;
+        }
+
+        const uint32_t head = r.head.load(std::memory_order_relaxed);
+        const uint32_t tail = r.tail.load();
+        const uint32_t space = r.size - (head - tail);
+        if (space == 0) {
+            r.writerWaiting.store(1);
+            if (r.tail.load() == tail && !r.closed.load())
+                futexWait(r.tail, tail);
+            r.writerWaiting.store(0);
+            continue;
+        }
+
+        const uint32_t n = std::min(length, space);
+        const uint32_t off = head & (r.size - 1);
+        const uint32_t first = std::min(n, r.size - off);
+        memcpy(r.data() + off, src, first);
+        memcpy(r.data(), src + first, n - first);
+        r.head.store(head + n);
+        if (r.readerWaiting.load())
+            futexWake(r.head);
+
+        src += n;
+        length -= n;
+    }
+}
+
+bool
+ShmIface::recvShm(void *buf, unsigned length)
+{
+    Ring &r = *rxRing;
+    uint8_t *dst = static_cast<uint8_t *>(buf);
+
+    while (length) {
+        const uint32_t tail = r.tail.load(std::memory_order_relaxed);
+        const uint32_t head = r.head.load();
+        const uint32_t avail = head - tail;
+        if (avail == 0) {
+            if (r.closed.load()) {
+                inform("recvShm(): Connection closed");
+                return false;
+            }
+            r.readerWaiting.store(1);
+            if (r.head.load() == head && !r.closed.load())
+                futexWait(r.head, head);
+            r.readerWaiting.store(0);
+            continue;
+        }
+
+        const uint32_t n = std::min(length, avail);
+        const uint32_t off = tail & (r.size - 1);
+        const uint32_t first = std::min(n, r.size - off);
+        memcpy(dst, r.data() + off, first);
+        memcpy(dst + first, r.data(), n - first);
+        r.tail.store(tail + n);
+        if (r.writerWaiting.load())
+            futexWake(r.tail);
+
+        dst += n;
+        length -= n;
+    }
+    return true;
+}
+
+void
+ShmIface::sendPacket(const Header &header, const EthPacketPtr &packet)
+{
+    std::lock_guard<std::mutex> lock(txLock);
+    sendShm(&header, sizeof(header));
+    sendShm(packet->data, packet->length);
+}
+
+void
+ShmIface::sendCmd(const Header &header)
+{
+    DPRINTF(DistEthernetCmd, "ShmIface::sendCmd() type: %d\n",
+            static_cast<int>(header.msgType));
+    // Global commands (i.e. sync request) are always sent by the primary
+    // DistIface, to every link of this process.
+    for (auto iface : registry) {
+        std::lock_guard<std::mutex> lock(iface->txLock);
+        iface->sendShm(&header, sizeof(header));
+    }
+}
+
+bool
+ShmIface::recvHeader(Header &header)
+{
+    bool ret = recvShm(&header, sizeof(header));
+    DPRINTF(DistEthernetCmd, "ShmIface::recvHeader() type: %d ret: %d\n",
+            static_cast<int>(header.msgType), ret);
+    return ret;
+}
+
+void
+ShmIface::recvPacket(const Header &header, EthPacketPtr &packet)
+{
+    packet = std::make_shared<EthPacketData>(header.dataPacketLength);
+    bool ret = recvShm(packet->data, header.dataPacketLength);
+    panic_if(!ret, "Error while reading dist segment");
+    packet->simLength = header.simLength;
+    packet->length = header.dataPacketLength;
+}
+
+void
+ShmIface::initTransport()
+{
+    // As with TCPIface, the segments can only be set up once the number
+    // of dist interfaces in each process is known.
+    if (isSwitch)
+        attach();
+    else
+        create();
+    registry.push_back(this);
+}
+
+} // namespace gem5
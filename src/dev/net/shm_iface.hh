@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs where all the
+ * gem5 processes share a host.
+ */
+
+#ifndef __DEV_NET_SHM_IFACE_HH__
+#define __DEV_NET_SHM_IFACE_HH__
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dev/net/dist_iface.hh"
+
+namespace gem5
+{
+
+class EventManager;
+
+/**
+ * Dist transport exchanging messages through shared memory.
+ *
+ * Every link between a compute node and the switch gets a shared memory
+ * segment with one single producer, single consumer byte ring for each
+ * direction. Messages are copied in and out of the rings, and a side
+ * that finds its ring empty (or full) sleeps on a futex until the other
+ * side has made progress. Synchronisation barriers use the same
+ * messages as over TCP, so they complete in a couple of ring round
+ * trips.
+ *
+ * The compute nodes create the segments; the switch attaches to them in
+ * the same (rank, link) order TCPIface accepts connections in, and
+ * removes their names once both sides are connected.
+ */
+class ShmIface : public DistIface
+{
+  private:
+    struct Ring;
+    struct Segment;
+
+    /** Port of the dist run, used to name the segments */
+    const unsigned serverPort;
+    /** Size of each ring in bytes */
+    const uint32_t ringSize;
+
+    bool isSwitch;
+
+    Segment *segment;
+    size_t segmentSize;
+
+    /** Ring this side writes to */
+    Ring *txRing;
+    /** Ring this side reads from */
+    Ring *rxRing;
+
+    /** Serialises the writers of txRing */
+    std::mutex txLock;
+
+    /** All the interfaces of this process, for global commands */
+    static std::vector<ShmIface *> registry;
+
+  private:
+    std::string segmentName(unsigned rank, unsigned iface_id) const;
+
+    void create();
+    void attach();
+    void map(int fd);
+
+    void sendShm(const void *buf, unsigned length);
+    bool recvShm(void *buf, unsigned length);
+
+  protected:
+
+    void sendPacket(const Header &header,
+                    const EthPacketPtr &packet) override;
+
+    void sendCmd(const Header &header) override;
+
+    bool recvHeader(Header &header) override;
+
+    void recvPacket(const Header &header, EthPacketPtr &packet) override;
+
+    void initTransport() override;
+
+  public:
+    /**
+     * @param server_port Port of the dist run, which keeps the segments
+     *                    of concurrent runs apart.
+     * @param ring_size Size of each ring, a power of two.
+     */
+    ShmIface(unsigned server_port, uint64_t ring_size,
+             unsigned dist_rank, unsigned dist_size,
+             Tick sync_start, Tick sync_repeat, EventManager *em,
+             bool use_pseudo_op, bool is_switch, int num_nodes);
+
+    ~ShmIface() override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_SHM_IFACE_HH__
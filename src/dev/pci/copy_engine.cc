@@ -49,7 +49,6 @@
 #include "base/compiler.hh"
 #include "base/trace.hh"
 #include "debug/DMACopyEngine.hh"
-#include "debug/Drain.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
 #include "params/CopyEngine.hh"
@@ -86,11 +85,7 @@ CopyEngine::CopyEngineChannel::CopyEngineChannel(CopyEngine *_ce, int cid)
       refreshNext(false), latBeforeBegin(ce->params().latBeforeBegin),
       latAfterCompletion(ce->params().latAfterCompletion),
       completionDataReg(0), nextState(Idle),
-      fetchCompleteEvent([this]{ fetchDescComplete(); }, name()),
-      addrCompleteEvent([this]{ fetchAddrComplete(); }, name()),
-      readCompleteEvent([this]{ readCopyBytesComplete(); }, name()),
-      writeCompleteEvent([this]{ writeCopyBytesComplete(); }, name()),
-      statusCompleteEvent([this]{ writeStatusComplete(); }, name())
+      coroutine(cePort, name(), [this]{ processChain(); })
 
 {
         cr.status.dma_transfer_status(3);
@@ -146,12 +141,12 @@ CopyEngine::CopyEngineChannel::recvCommand()
         nextState = DescriptorFetch;
         fetchAddress = cr.descChainAddr;
         if (ce->drainState() == DrainState::Running)
-            fetchDescriptor(cr.descChainAddr);
+            coroutine.start();
     } else if (cr.command.append_dma()) {
         if (!busy) {
             nextState = AddressFetch;
             if (ce->drainState() == DrainState::Running)
-                fetchNextAddr(lastDescriptorAddr);
+                coroutine.start();
         } else
             refreshNext = true;
     } else if (cr.command.reset_dma()) {
@@ -450,8 +445,21 @@ CopyEngineStats::CopyEngineStats(statistics::Group *parent,
 }
 
 void
-CopyEngine::CopyEngineChannel::fetchDescriptor(Addr address)
+CopyEngine::CopyEngineChannel::processChain()
+{
+    while (nextState != Idle) {
+        // Stop between the steps while draining, drainResume() carries
+        // on from nextState
+        if (coroutine.drainState() != DrainState::Running)
+            return;
+        processStep();
+    }
+}
+
+void
+CopyEngine::CopyEngineChannel::fetchDescriptor()
 {
+    Addr address = fetchAddress;
     DPRINTF(DMACopyEngine, "Reading descriptor from at memory location %#x(%#x)\n",
            address, ce->pciToDma(address));
     assert(address);
@@ -460,30 +468,18 @@ CopyEngine::CopyEngineChannel::fetchDescriptor(Addr address)
     DPRINTF(DMACopyEngine, "dmaAction: %#x, %d bytes, to addr %#x\n",
             ce->pciToDma(address), sizeof(DmaDesc), curDmaDesc);
 
-    cePort.dmaAction(MemCmd::ReadReq, ce->pciToDma(address),
-                     sizeof(DmaDesc), &fetchCompleteEvent,
-                     (uint8_t*)curDmaDesc, latBeforeBegin);
     lastDescriptorAddr = address;
-}
+    coroutine.read(ce->pciToDma(address), sizeof(DmaDesc), curDmaDesc,
+                   latBeforeBegin);
 
-void
-CopyEngine::CopyEngineChannel::fetchDescComplete()
-{
     DPRINTF(DMACopyEngine, "Read of descriptor complete\n");
 
     if ((curDmaDesc->command & DESC_CTRL_NULL)) {
         DPRINTF(DMACopyEngine, "Got NULL descriptor, skipping\n");
-        assert(!(curDmaDesc->command & DESC_CTRL_CP_STS));
-        if (curDmaDesc->command & DESC_CTRL_CP_STS) {
-            panic("Shouldn't be able to get here\n");
-            nextState = CompletionWrite;
-            if (inDrain()) return;
-            writeCompletionStatus();
-        } else {
-            busy = false;
-            nextState = Idle;
-            inDrain();
-        }
+        panic_if(curDmaDesc->command & DESC_CTRL_CP_STS,
+                 "Shouldn't be able to get here\n");
+        busy = false;
+        nextState = Idle;
         return;
     }
 
@@ -491,8 +487,6 @@ CopyEngine::CopyEngineChannel::fetchDescComplete()
         panic("Descriptor has flag other that completion status set\n");
 
     nextState = DMARead;
-    if (inDrain()) return;
-    readCopyBytes();
 }
 
 void
@@ -501,18 +495,12 @@ CopyEngine::CopyEngineChannel::readCopyBytes()
     DPRINTF(DMACopyEngine, "Reading %d bytes from buffer to memory location %#x(%#x)\n",
            curDmaDesc->len, curDmaDesc->dest,
            ce->pciToDma(curDmaDesc->src));
-    cePort.dmaAction(MemCmd::ReadReq, ce->pciToDma(curDmaDesc->src),
-                     curDmaDesc->len, &readCompleteEvent, copyBuffer, 0);
-}
+    coroutine.read(ce->pciToDma(curDmaDesc->src), curDmaDesc->len,
+                   copyBuffer);
 
-void
-CopyEngine::CopyEngineChannel::readCopyBytesComplete()
-{
     DPRINTF(DMACopyEngine, "Read of bytes to copy complete\n");
 
     nextState = DMAWrite;
-    if (inDrain()) return;
-    writeCopyBytes();
 }
 
 void
@@ -522,16 +510,12 @@ CopyEngine::CopyEngineChannel::writeCopyBytes()
            curDmaDesc->len, curDmaDesc->dest,
            ce->pciToDma(curDmaDesc->dest));
 
-    cePort.dmaAction(MemCmd::WriteReq, ce->pciToDma(curDmaDesc->dest),
-                     curDmaDesc->len, &writeCompleteEvent, copyBuffer, 0);
-
     ce->copyEngineStats.bytesCopied[channelId] += curDmaDesc->len;
     ce->copyEngineStats.copiesProcessed[channelId]++;
-}
 
-void
-CopyEngine::CopyEngineChannel::writeCopyBytesComplete()
-{
+    coroutine.write(ce->pciToDma(curDmaDesc->dest), curDmaDesc->len,
+                    copyBuffer);
+
     DPRINTF(DMACopyEngine, "Write of bytes to copy complete user1: %#x\n",
             curDmaDesc->user1);
 
@@ -540,8 +524,6 @@ CopyEngine::CopyEngineChannel::writeCopyBytesComplete()
 
     if (curDmaDesc->command & DESC_CTRL_CP_STS) {
         nextState = CompletionWrite;
-        if (inDrain()) return;
-        writeCompletionStatus();
         return;
     }
 
@@ -564,15 +546,10 @@ CopyEngine::CopyEngineChannel::continueProcessing()
     if (curDmaDesc->next) {
         nextState = DescriptorFetch;
         fetchAddress = curDmaDesc->next;
-        if (inDrain()) return;
-        fetchDescriptor(curDmaDesc->next);
     } else if (refreshNext) {
         nextState = AddressFetch;
         refreshNext = false;
-        if (inDrain()) return;
-        fetchNextAddr(lastDescriptorAddr);
     } else {
-        inDrain();
         nextState = Idle;
     }
 }
@@ -584,68 +561,40 @@ CopyEngine::CopyEngineChannel::writeCompletionStatus()
             completionDataReg, cr.completionAddr,
             ce->pciToDma(cr.completionAddr));
 
-    cePort.dmaAction(MemCmd::WriteReq,
-                     ce->pciToDma(cr.completionAddr),
-                     sizeof(completionDataReg), &statusCompleteEvent,
-                     (uint8_t*)&completionDataReg, latAfterCompletion);
-}
+    coroutine.write(ce->pciToDma(cr.completionAddr),
+                    sizeof(completionDataReg), &completionDataReg,
+                    latAfterCompletion);
 
-void
-CopyEngine::CopyEngineChannel::writeStatusComplete()
-{
     DPRINTF(DMACopyEngine, "Writing completion status complete\n");
     continueProcessing();
 }
 
 void
-CopyEngine::CopyEngineChannel::fetchNextAddr(Addr address)
+CopyEngine::CopyEngineChannel::fetchNextAddr()
 {
     DPRINTF(DMACopyEngine, "Fetching next address...\n");
     busy = true;
-    cePort.dmaAction(MemCmd::ReadReq,
-                     ce->pciToDma(address + offsetof(DmaDesc, next)),
-                     sizeof(Addr), &addrCompleteEvent,
-                     (uint8_t*)curDmaDesc + offsetof(DmaDesc, next), 0);
-}
+    coroutine.read(ce->pciToDma(lastDescriptorAddr + offsetof(DmaDesc, next)),
+                   sizeof(Addr),
+                   (uint8_t*)curDmaDesc + offsetof(DmaDesc, next));
 
-void
-CopyEngine::CopyEngineChannel::fetchAddrComplete()
-{
     DPRINTF(DMACopyEngine, "Fetching next address complete: %#x\n",
             curDmaDesc->next);
     if (!curDmaDesc->next) {
         DPRINTF(DMACopyEngine, "Got NULL descriptor, nothing more to do\n");
         busy = false;
         nextState = Idle;
-        inDrain();
         return;
     }
     nextState = DescriptorFetch;
     fetchAddress = curDmaDesc->next;
-    if (inDrain()) return;
-    fetchDescriptor(curDmaDesc->next);
-}
-
-bool
-CopyEngine::CopyEngineChannel::inDrain()
-{
-    if (drainState() == DrainState::Draining) {
-        DPRINTF(Drain, "CopyEngine done draining, processing drain event\n");
-        signalDrainDone();
-    }
-
-    return ce->drainState() != DrainState::Running;
 }
 
 DrainState
 CopyEngine::CopyEngineChannel::drain()
 {
-    if (nextState == Idle || ce->drainState() != DrainState::Running) {
-        return DrainState::Drained;
-    } else {
-        DPRINTF(Drain, "CopyEngineChannel not drained\n");
-        return DrainState::Draining;
-    }
+    // The coroutine drains once it stops between two steps
+    return DrainState::Drained;
 }
 
 void
@@ -703,14 +652,14 @@ CopyEngine::CopyEngineChannel::unserialize(CheckpointIn &cp)
 }
 
 void
-CopyEngine::CopyEngineChannel::restartStateMachine()
+CopyEngine::CopyEngineChannel::processStep()
 {
     switch(nextState) {
       case AddressFetch:
-        fetchNextAddr(lastDescriptorAddr);
+        fetchNextAddr();
         break;
       case DescriptorFetch:
-        fetchDescriptor(fetchAddress);
+        fetchDescriptor();
         break;
       case DMARead:
         readCopyBytes();
@@ -732,7 +681,8 @@ void
 CopyEngine::CopyEngineChannel::drainResume()
 {
     DPRINTF(DMACopyEngine, "Restarting state machine at state %d\n", nextState);
-    restartStateMachine();
+    if (nextState != Idle)
+        coroutine.start();
 }
 
 } // namespace gem5
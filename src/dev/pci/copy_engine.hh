@@ -49,6 +49,7 @@
 #include <vector>
 
 #include "base/statistics.hh"
+#include "dev/dma_coroutine.hh"
 #include "dev/pci/copy_engine_defs.hh"
 #include "dev/pci/device.hh"
 #include "params/CopyEngine.hh"
@@ -93,6 +94,9 @@ class CopyEngine : public PciDevice
 
         ChannelState nextState;
 
+        /** Runs the steps of the descriptor chain */
+        DmaCoroutine coroutine;
+
       public:
         CopyEngineChannel(CopyEngine *_ce, int cid);
         virtual ~CopyEngineChannel();
@@ -120,31 +124,22 @@ class CopyEngine : public PciDevice
         void unserialize(CheckpointIn &cp) override;
 
       private:
-        void fetchDescriptor(Addr address);
-        void fetchDescComplete();
-        EventFunctionWrapper fetchCompleteEvent;
-
-        void fetchNextAddr(Addr address);
-        void fetchAddrComplete();
-        EventFunctionWrapper addrCompleteEvent;
-
+        /**
+         * Body of the coroutine, which runs the steps from nextState
+         * until the channel is idle or draining. Each step waits for its
+         * DMA access and then sets the next state.
+         */
+        void processChain();
+
+        void fetchDescriptor();
+        void fetchNextAddr();
         void readCopyBytes();
-        void readCopyBytesComplete();
-        EventFunctionWrapper readCompleteEvent;
-
         void writeCopyBytes();
-        void writeCopyBytesComplete();
-        EventFunctionWrapper writeCompleteEvent;
-
         void writeCompletionStatus();
-        void writeStatusComplete();
-        EventFunctionWrapper statusCompleteEvent;
-
 
         void continueProcessing();
         void recvCommand();
-        bool inDrain();
-        void restartStateMachine();
+        void processStep();
     };
 
   private:
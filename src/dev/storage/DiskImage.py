@@ -47,3 +47,13 @@ class CowDiskImage(DiskImage):
                             "child image")
     table_size = Param.Int(65536, "initial table size")
     image_file = ""
+
+class SparseCowDiskImage(DiskImage):
+    type = 'SparseCowDiskImage'
+    cxx_header = "dev/storage/disk_image.hh"
+    cxx_class = 'gem5::SparseCowDiskImage'
+    child = Param.DiskImage(RawDiskImage(read_only=True),
+                            "child image")
+    block_size = Param.MemorySize('64KiB',
+                                  "copy-on-write granularity of the overlay")
+    image_file = ""
@@ -32,16 +32,23 @@
 
 #include "dev/storage/disk_image.hh"
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "base/callback.hh"
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/DiskImageRead.hh"
@@ -53,6 +60,34 @@
 namespace gem5
 {
 
+std::streampos
+DiskImage::readSectors(uint8_t *data, std::streampos offset, int count) const
+{
+    const std::streamoff sector = offset;
+    std::streampos bytes = 0;
+    for (int i = 0; i < count; i++) {
+        std::streampos n = read(data + i * SectorSize, sector + i);
+        bytes += n;
+        if (n != SectorSize)
+            break;
+    }
+    return bytes;
+}
+
+std::streampos
+DiskImage::writeSectors(const uint8_t *data, std::streampos offset, int count)
+{
+    const std::streamoff sector = offset;
+    std::streampos bytes = 0;
+    for (int i = 0; i < count; i++) {
+        std::streampos n = write(data + i * SectorSize, sector + i);
+        bytes += n;
+        if (n != SectorSize)
+            break;
+    }
+    return bytes;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Raw Disk image
@@ -161,6 +196,62 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     return stream.tellp() - pos;
 }
 
+std::streampos
+RawDiskImage::readSectors(uint8_t *data, std::streampos offset,
+                          int count) const
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (!stream.is_open())
+        panic("file not open!\n");
+
+    stream.seekg(offset * SectorSize, std::ios::beg);
+    if (!stream.good())
+        panic("Could not seek to location in file");
+
+    std::streampos pos = stream.tellg();
+    stream.read((char *)data, count * SectorSize);
+
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", (uint64_t)offset,
+            count);
+    DDUMP(DiskImageRead, data, count * SectorSize);
+
+    // a short read leaves the stream at the end of the file
+    if (!stream.good()) {
+        std::streampos bytes = stream.gcount();
+        stream.clear();
+        return bytes;
+    }
+    return stream.tellg() - pos;
+}
+
+std::streampos
+RawDiskImage::writeSectors(const uint8_t *data, std::streampos offset,
+                           int count)
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (readonly)
+        panic("Cannot write to a read only disk image");
+
+    if (!stream.is_open())
+        panic("file not open!\n");
+
+    stream.seekp(offset * SectorSize, std::ios::beg);
+    if (!stream.good())
+        panic("Could not seek to location in file");
+
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n", (uint64_t)offset,
+            count);
+    DDUMP(DiskImageWrite, data, count * SectorSize);
+
+    std::streampos pos = stream.tellp();
+    stream.write((const char *)data, count * SectorSize);
+    return stream.tellp() - pos;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Copy on Write Disk image
@@ -397,6 +488,47 @@ CowDiskImage::read(uint8_t *data, std::streampos offset) const
     }
 }
 
+std::streampos
+CowDiskImage::readSectors(uint8_t *data, std::streampos offset,
+                          int count) const
+{
+    if (!initialized)
+        panic("CowDiskImage not initialized");
+
+    const std::streamoff sector = offset;
+    if (sector + count > size())
+        panic("access out of bounds");
+
+    // Copy the sectors that were written from the table, and read each
+    // run of the others from the child with a single access
+    std::streampos bytes = 0;
+    int i = 0;
+    while (i < count) {
+        SectorTable::const_iterator s = table->find(sector + i);
+        if (s != table->end()) {
+            memcpy(data + i * SectorSize, s->second->data, SectorSize);
+            bytes += SectorSize;
+            i++;
+            continue;
+        }
+
+        int run = 1;
+        while (i + run < count &&
+               table->find(sector + i + run) == table->end()) {
+            run++;
+        }
+        std::streampos n = child->readSectors(data + i * SectorSize,
+                                              sector + i, run);
+        bytes += n;
+        if (n != run * SectorSize)
+            break;
+        i += run;
+    }
+
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", sector, count);
+    return bytes;
+}
+
 std::streampos
 CowDiskImage::write(const uint8_t *data, std::streampos offset)
 {
@@ -438,4 +570,327 @@ CowDiskImage::unserialize(CheckpointIn &cp)
     open(cowFilename);
 }
 
+////////////////////////////////////////////////////////////////////////
+//
+// Sparse Copy on Write Disk image
+//
+const uint32_t SparseCowDiskImage::VersionMajor = 1;
+const uint32_t SparseCowDiskImage::VersionMinor = 0;
+
+namespace
+{
+
+void
+safePread(int fd, void *data, size_t count, off_t offset)
+{
+    panic_if(pread(fd, data, count, offset) != (ssize_t)count,
+             "error reading sparse cowdisk overlay: %s", strerror(errno));
+}
+
+void
+safePwrite(int fd, const void *data, size_t count, off_t offset)
+{
+    panic_if(pwrite(fd, data, count, offset) != (ssize_t)count,
+             "error writing sparse cowdisk overlay: %s", strerror(errno));
+}
+
+void
+safeResize(int fd, off_t size)
+{
+    // Dropping the old contents first leaves a file without any
+    // allocated blocks
+    panic_if(ftruncate(fd, 0) == -1 || ftruncate(fd, size) == -1,
+             "error resizing sparse cowdisk overlay: %s", strerror(errno));
+}
+
+} // anonymous namespace
+
+SparseCowDiskImage::SparseCowDiskImage(const Params &p)
+    : DiskImage(p), child(p.child), readonly(p.read_only),
+      blockSize(p.block_size), blockSectors(blockSize / SectorSize),
+      numSectors((std::streamoff)child->size()),
+      numBlocks(divCeil(numSectors, blockSectors)),
+      dataStart(roundUp(sizeof(Header) + divCeil(numBlocks, 8), blockSize)),
+      fd(-1), overlay(nullptr)
+{
+    fatal_if(blockSize < SectorSize || !isPowerOf2(blockSize),
+             "%s: block_size must be a power of two of at least %d bytes",
+             name(), SectorSize);
+
+    const std::string &file = p.image_file;
+    int existing = -1;
+    if (!file.empty())
+        existing = ::open(file.c_str(), readonly ? O_RDONLY : O_RDWR);
+
+    if (readonly || file.empty()) {
+        fatal_if(!file.empty() && existing == -1,
+                 "could not open read-only file %s", file);
+        fd = createTempFile();
+        if (existing != -1) {
+            checkOverlay(existing, file);
+            loadOverlay(existing);
+            ::close(existing);
+        } else {
+            initOverlay(fd);
+        }
+    } else if (existing != -1) {
+        checkOverlay(existing, file);
+        fd = existing;
+    } else {
+        fd = ::open(file.c_str(), O_RDWR | O_CREAT, 0644);
+        fatal_if(fd == -1, "could not create %s: %s", file, strerror(errno));
+        initOverlay(fd);
+    }
+
+    mapOverlay();
+    initialized = true;
+}
+
+SparseCowDiskImage::~SparseCowDiskImage()
+{
+    unmapOverlay();
+    if (fd != -1)
+        ::close(fd);
+}
+
+int
+SparseCowDiskImage::createTempFile() const
+{
+    const char *tmpdir = getenv("TMPDIR");
+    std::string path = csprintf("%s/gem5-%s-XXXXXX",
+                                tmpdir ? tmpdir : "/tmp", name());
+    std::vector<char> tmpl(path.begin(), path.end());
+    tmpl.push_back('\0');
+
+    int file = mkstemp(tmpl.data());
+    fatal_if(file == -1, "%s: could not create overlay file: %s", name(),
+             strerror(errno));
+    unlink(tmpl.data());
+    return file;
+}
+
+void
+SparseCowDiskImage::initOverlay(int file) const
+{
+    safeResize(file, overlaySize());
+
+    Header header;
+    memcpy(&header.magic, "SPARSCOW", sizeof(header.magic));
+    header.majorVersion = htole(VersionMajor);
+    header.minorVersion = htole(VersionMinor);
+    header.blockSize = htole(blockSize);
+    header.numBlocks = htole(numBlocks);
+    safePwrite(file, &header, sizeof(header), 0);
+}
+
+void
+SparseCowDiskImage::checkOverlay(int file, const std::string &path) const
+{
+    Header header;
+    safePread(file, &header, sizeof(header), 0);
+
+    if (memcmp(&header.magic, "SPARSCOW", sizeof(header.magic)) != 0)
+        fatal("Could not open %s: Invalid magic", path);
+    if (letoh(header.majorVersion) != VersionMajor)
+        fatal("Could not open %s: invalid version %d.%d != %d.%d", path,
+              letoh(header.majorVersion), letoh(header.minorVersion),
+              VersionMajor, VersionMinor);
+    if (letoh(header.blockSize) != blockSize ||
+        letoh(header.numBlocks) != numBlocks) {
+        fatal("Could not open %s: overlay of %d blocks of %d bytes doesn't "
+              "match %d blocks of %d bytes", path, letoh(header.numBlocks),
+              letoh(header.blockSize), numBlocks, blockSize);
+    }
+}
+
+void
+SparseCowDiskImage::saveOverlay(int file) const
+{
+    safeResize(file, overlaySize());
+    safePwrite(file, overlay, dataStart, 0);
+    for (uint64_t block = 0; block < numBlocks; block++) {
+        if (isWritten(block)) {
+            safePwrite(file, blockData(block), blockSize,
+                       dataStart + block * blockSize);
+        }
+    }
+}
+
+void
+SparseCowDiskImage::loadOverlay(int file)
+{
+    std::vector<uint8_t> meta(dataStart);
+    safePread(file, meta.data(), dataStart, 0);
+    safeResize(fd, overlaySize());
+    safePwrite(fd, meta.data(), dataStart, 0);
+
+    std::vector<uint8_t> data(blockSize);
+    for (uint64_t block = 0; block < numBlocks; block++) {
+        if (!(meta[sizeof(Header) + block / 8] & (1 << (block % 8))))
+            continue;
+        off_t offset = dataStart + block * blockSize;
+        safePread(file, data.data(), blockSize, offset);
+        safePwrite(fd, data.data(), blockSize, offset);
+    }
+}
+
+void
+SparseCowDiskImage::mapOverlay()
+{
+    void *ptr = mmap(nullptr, overlaySize(), PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+    fatal_if(ptr == MAP_FAILED, "%s: could not map overlay: %s", name(),
+             strerror(errno));
+    overlay = (uint8_t *)ptr;
+}
+
+void
+SparseCowDiskImage::unmapOverlay()
+{
+    if (overlay)
+        munmap(overlay, overlaySize());
+    overlay = nullptr;
+}
+
+void
+SparseCowDiskImage::notifyFork()
+{
+    // Move the overlay of the forked child to a private file, so that it
+    // doesn't change the one it shares with the parent
+    int file = createTempFile();
+    saveOverlay(file);
+    unmapOverlay();
+    ::close(fd);
+    fd = file;
+    mapOverlay();
+}
+
+std::streampos
+SparseCowDiskImage::size() const
+{ return numSectors; }
+
+std::streampos
+SparseCowDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    return readSectors(data, offset, 1);
+}
+
+std::streampos
+SparseCowDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    return writeSectors(data, offset, 1);
+}
+
+std::streampos
+SparseCowDiskImage::readSectors(uint8_t *data, std::streampos offset,
+                                int count) const
+{
+    if (!initialized)
+        panic("SparseCowDiskImage not initialized");
+
+    const uint64_t sector = (std::streamoff)offset;
+    if (sector + count > numSectors)
+        panic("access out of bounds");
+
+    // Copy the written blocks from the overlay, and read each run of the
+    // others from the child with a single access
+    const uint64_t sectors = count;
+    uint64_t i = 0;
+    while (i < sectors) {
+        uint64_t block = (sector + i) / blockSectors;
+        uint64_t first = (sector + i) % blockSectors;
+        uint64_t n = std::min(sectors - i, blockSectors - first);
+
+        if (isWritten(block)) {
+            memcpy(data + i * SectorSize,
+                   blockData(block) + first * SectorSize, n * SectorSize);
+        } else {
+            while (i + n < sectors && !isWritten(++block))
+                n += std::min(sectors - i - n, blockSectors);
+            std::streampos bytes = child->readSectors(data + i * SectorSize,
+                                                      sector + i, n);
+            if ((uint64_t)(std::streamoff)bytes != n * SectorSize)
+                return i * SectorSize + (std::streamoff)bytes;
+        }
+        i += n;
+    }
+
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", sector, count);
+    DDUMP(DiskImageRead, data, count * SectorSize);
+
+    return count * SectorSize;
+}
+
+std::streampos
+SparseCowDiskImage::writeSectors(const uint8_t *data, std::streampos offset,
+                                 int count)
+{
+    if (!initialized)
+        panic("SparseCowDiskImage not initialized");
+
+    const uint64_t sector = (std::streamoff)offset;
+    if (sector + count > numSectors)
+        panic("access out of bounds");
+
+    const uint64_t sectors = count;
+    uint64_t i = 0;
+    while (i < sectors) {
+        uint64_t block = (sector + i) / blockSectors;
+        uint64_t first = (sector + i) % blockSectors;
+        uint64_t n = std::min(sectors - i, blockSectors - first);
+
+        if (!isWritten(block)) {
+            // copy the parts of the block that aren't overwritten
+            if (n != blockSectors) {
+                uint64_t valid = std::min(blockSectors,
+                    numSectors - block * blockSectors);
+                panic_if((uint64_t)(std::streamoff)child->readSectors(
+                             blockData(block), block * blockSectors,
+                             valid) != valid * SectorSize,
+                         "%s: could not read block %d from child", name(),
+                         block);
+            }
+            overlay[sizeof(Header) + block / 8] |= 1 << (block % 8);
+        }
+        memcpy(blockData(block) + first * SectorSize, data + i * SectorSize,
+               n * SectorSize);
+        i += n;
+    }
+
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n", sector, count);
+    DDUMP(DiskImageWrite, data, count * SectorSize);
+
+    return count * SectorSize;
+}
+
+void
+SparseCowDiskImage::serialize(CheckpointOut &cp) const
+{
+    std::string overlayFilename = name() + ".overlay";
+    SERIALIZE_SCALAR(overlayFilename);
+
+    std::string path = CheckpointIn::dir() + "/" + overlayFilename;
+    int file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    panic_if(file == -1, "Error opening %s", path);
+    saveOverlay(file);
+    ::close(file);
+}
+
+void
+SparseCowDiskImage::unserialize(CheckpointIn &cp)
+{
+    std::string overlayFilename;
+    UNSERIALIZE_SCALAR(overlayFilename);
+
+    std::string path = cp.getCptDir() + "/" + overlayFilename;
+    int file = ::open(path.c_str(), O_RDONLY);
+    panic_if(file == -1, "Error opening %s", path);
+    checkOverlay(file, path);
+
+    unmapOverlay();
+    loadOverlay(file);
+    ::close(file);
+    mapOverlay();
+}
+
 } // namespace gem5
@@ -39,6 +39,7 @@
 #include "params/CowDiskImage.hh"
 #include "params/DiskImage.hh"
 #include "params/RawDiskImage.hh"
+#include "params/SparseCowDiskImage.hh"
 #include "sim/sim_object.hh"
 
 #define SectorSize (512)
@@ -65,6 +66,18 @@ class DiskImage : public SimObject
                                 std::streampos offset) const = 0;
     virtual std::streampos write(const uint8_t *data,
                                  std::streampos offset) = 0;
+
+    /**
+     * Read or write count consecutive sectors starting at sector offset,
+     * which lets images that can do so access the whole range at once.
+     * The default implementations access one sector at a time.
+     *
+     * @return The number of bytes read or written.
+     */
+    virtual std::streampos readSectors(uint8_t *data, std::streampos offset,
+                                       int count) const;
+    virtual std::streampos writeSectors(const uint8_t *data,
+                                        std::streampos offset, int count);
 };
 
 /**
@@ -92,6 +105,11 @@ class RawDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    std::streampos readSectors(uint8_t *data, std::streampos offset,
+                               int count) const override;
+    std::streampos writeSectors(const uint8_t *data, std::streampos offset,
+                                int count) override;
 };
 
 /**
@@ -142,6 +160,97 @@ class CowDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    std::streampos readSectors(uint8_t *data, std::streampos offset,
+                               int count) const override;
+};
+
+/**
+ * Copy-on-write disk image layer that keeps its overlay in a sparse,
+ * memory mapped file instead of a table of sectors. The overlay is
+ * managed in blocks of block_size bytes, and a block is copied from the
+ * child the first time it is partially written. The file holds a
+ * header, a bitmap of the blocks that were written and the blocks
+ * themselves at their offsets in the image, so the host only allocates
+ * space for the blocks that were written.
+ *
+ * If image_file is set, the overlay is kept in that file and persists
+ * across runs. If the image is also read only, the file is only used to
+ * initialize the overlay. Checkpoints store a sparse copy of the
+ * overlay.
+ */
+class SparseCowDiskImage : public DiskImage
+{
+  public:
+    static const uint32_t VersionMajor;
+    static const uint32_t VersionMinor;
+
+  protected:
+    struct Header
+    {
+        uint64_t magic;
+        uint32_t majorVersion;
+        uint32_t minorVersion;
+        uint64_t blockSize;
+        uint64_t numBlocks;
+    };
+
+    DiskImage *child;
+    const bool readonly;
+    const uint64_t blockSize;
+    const uint64_t blockSectors;
+    const uint64_t numSectors;
+    const uint64_t numBlocks;
+
+    /** Offset of the first block in the overlay file */
+    const uint64_t dataStart;
+
+    int fd;
+    uint8_t *overlay;
+
+    uint64_t overlaySize() const { return dataStart + numBlocks * blockSize; }
+
+    bool
+    isWritten(uint64_t block) const
+    {
+        return overlay[sizeof(Header) + block / 8] & (1 << (block % 8));
+    }
+
+    uint8_t *
+    blockData(uint64_t block) const
+    {
+        return overlay + dataStart + block * blockSize;
+    }
+
+    int createTempFile() const;
+    void initOverlay(int file) const;
+    void checkOverlay(int file, const std::string &path) const;
+    /** Write a sparse copy of the overlay to a file */
+    void saveOverlay(int file) const;
+    /** Replace the overlay file contents with those of another file */
+    void loadOverlay(int file);
+    void mapOverlay();
+    void unmapOverlay();
+
+  public:
+    typedef SparseCowDiskImageParams Params;
+    SparseCowDiskImage(const Params &p);
+    ~SparseCowDiskImage();
+
+    void notifyFork() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+    std::streampos size() const override;
+
+    std::streampos read(uint8_t *data, std::streampos offset) const override;
+    std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    std::streampos readSectors(uint8_t *data, std::streampos offset,
+                               int count) const override;
+    std::streampos writeSectors(const uint8_t *data, std::streampos offset,
+                                int count) override;
 };
 
 void SafeRead(std::ifstream &stream, void *data, int count);
@@ -231,7 +231,7 @@ VirtDescriptor::chainSize() const
 VirtQueue::VirtQueue(PortProxy &proxy, ByteOrder bo, uint16_t size)
     : byteOrder(bo), _size(size), _address(0), memProxy(proxy),
       avail(proxy, bo, size), used(proxy, bo, size),
-      _last_avail(0)
+      _last_avail(0), _availFetched(0), _usedIndexValid(true)
 {
     descriptors.reserve(_size);
     for (int i = 0; i < _size; ++i)
@@ -252,6 +252,8 @@ VirtQueue::unserialize(CheckpointIn &cp)
 
     paramIn(cp, "_address", addr_in);
     UNSERIALIZE_SCALAR(_last_avail);
+    _availFetched = _last_avail;
+    _usedIndexValid = false;
 
     // Use the address setter to ensure that the ring buffer addresses
     // are updated as well.
@@ -263,6 +265,8 @@ VirtQueue::reset()
 {
     _address = 0;
     _last_avail = 0;
+    _availFetched = 0;
+    _usedIndexValid = true;
 
     avail.reset();
     used.reset();
@@ -284,12 +288,19 @@ VirtQueue::setAddress(Addr address)
 VirtDescriptor *
 VirtQueue::consumeDescriptor()
 {
-    avail.read();
+    // Only go to the guest once all the descriptors we know about have
+    // been consumed, and then fetch everything new in one go.
+    if (_last_avail == _availFetched) {
+        avail.readHeader();
+        const uint16_t fresh(avail.header.index - _availFetched);
+        if (fresh == 0)
+            return NULL;
+        avail.readElements(_availFetched, fresh);
+        _availFetched = avail.header.index;
+    }
     DPRINTF(VIO, "consumeDescriptor: _last_avail: %i, avail.idx: %i (->%i)\n",
-            _last_avail, avail.header.index,
+            _last_avail, _availFetched,
             avail.ring[_last_avail % used.ring.size()]);
-    if (_last_avail == avail.header.index)
-        return NULL;
 
     VirtDescriptor::Index index(avail.ring[_last_avail % used.ring.size()]);
     ++_last_avail;
@@ -303,15 +314,20 @@ VirtQueue::consumeDescriptor()
 void
 VirtQueue::produceDescriptor(VirtDescriptor *desc, uint32_t len)
 {
-    used.readHeader();
+    if (!_usedIndexValid) {
+        used.readHeader();
+        _usedIndexValid = true;
+    }
     DPRINTF(VIO, "produceDescriptor: dscIdx: %i, len: %i, used.idx: %i\n",
             desc->index(), len, used.header.index);
 
     struct vring_used_elem &e(used.ring[used.header.index % used.ring.size()]);
     e.id = desc->index();
     e.len = len;
+    // The element has to be visible before the index that publishes it.
+    used.writeElement(used.header.index);
     used.header.index += 1;
-    used.write();
+    used.writeIndex();
 }
 
 void
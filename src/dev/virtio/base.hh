@@ -38,6 +38,8 @@
 #ifndef __DEV_VIRTIO_BASE_HH__
 #define __DEV_VIRTIO_BASE_HH__
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <vector>
@@ -529,6 +531,54 @@ class VirtQueue : public Serializable
                 ring[i] = gtoh(temp[i], byteOrder);
         }
 
+        /**
+         * Update count elements of the ring, starting with the one at
+         * index first, with data from the guest. The elements are
+         * fetched with at most two accesses, one for each side of the
+         * wrap.
+         */
+        void
+        readElements(Index first, Index count)
+        {
+            assert(_base != 0);
+            assert(count <= ring.size());
+            while (count) {
+                const Index start(first % ring.size());
+                const Index n(std::min<Index>(count, ring.size() - start));
+                T temp[n];
+                _proxy.readBlob(_base + sizeof(header) + sizeof(T) * start,
+                                temp, sizeof(T) * n);
+                for (int i = 0; i < n; ++i)
+                    ring[start + i] = gtoh(temp[i], byteOrder);
+                first += n;
+                count -= n;
+            }
+        }
+
+        /** Write a single element of the ring to the guest. */
+        void
+        writeElement(Index idx)
+        {
+            assert(_base != 0);
+            const Index pos(idx % ring.size());
+            const T out(htog(ring[pos], byteOrder));
+            _proxy.writeBlob(_base + sizeof(header) + sizeof(T) * pos,
+                             &out, sizeof(out));
+        }
+
+        /**
+         * Write the index in the header to the guest, leaving the
+         * flags, which belong to the other side, untouched.
+         */
+        void
+        writeIndex()
+        {
+            assert(_base != 0);
+            const Index out(htog(header.index, byteOrder));
+            _proxy.writeBlob(_base + offsetof(Header, index),
+                             &out, sizeof(out));
+        }
+
         void
         write()
         {
@@ -569,6 +619,20 @@ class VirtQueue : public Serializable
      * ring */
     uint16_t _last_avail;
 
+    /**
+     * Offset up to which the VirtQueue::avail ring has been read from
+     * the guest. Descriptors between _last_avail and this offset are
+     * consumed without touching guest memory.
+     */
+    uint16_t _availFetched;
+
+    /**
+     * Whether VirtQueue::used has a valid copy of the guest's used
+     * index. The device is the only writer of the index, so it only has
+     * to be read once after a checkpoint is restored.
+     */
+    bool _usedIndexValid;
+
     /** Vector of pre-created descriptors indexed by their index into
      * the queue. */
     std::vector<VirtDescriptor> descriptors;
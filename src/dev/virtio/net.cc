@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dev/virtio/net.hh"
+
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/VIONet.hh"
+#include "params/VirtIONet.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+VirtIONet::VirtIONet(const Params &params)
+    : VirtIODeviceBase(params, ID_NET, sizeof(Config),
+                       F_MAC | F_STATUS |
+                       (params.queuePairs > 1 ? F_CTRL_VQ | F_MQ : 0)),
+      activePairs(1),
+      interface(name() + ".interface", *this),
+      rxFifoPackets(params.rxFifoPackets),
+      txNext(0), txPacketQueue(nullptr), txPacketDesc(nullptr),
+      stats(this)
+{
+    fatal_if(params.queuePairs < 1 || params.queuePairs > 0x8000,
+             "%s: queuePairs must be between 1 and 32768\n", name());
+
+    for (unsigned i = 0; i < params.queuePairs; ++i) {
+        rxQueues.emplace_back(new RxQueue(params.system->physProxy,
+                                          byteOrder, params.queueSize,
+                                          *this, i));
+        txQueues.emplace_back(new TxQueue(params.system->physProxy,
+                                          byteOrder, params.queueSize,
+                                          *this, i));
+        registerQueue(*rxQueues.back());
+        registerQueue(*txQueues.back());
+    }
+
+    if (params.queuePairs > 1) {
+        ctrlQueue.reset(new CtrlQueue(params.system->physProxy, byteOrder,
+                                      params.ctrlQueueSize, *this));
+        registerQueue(*ctrlQueue);
+    }
+
+    memcpy(config.mac, params.hardware_address.bytes(), ETH_ADDR_LEN);
+    config.status = S_LINK_UP;
+    config.maxVirtqueuePairs = params.queuePairs;
+}
+
+VirtIONet::~VirtIONet()
+{
+}
+
+void
+VirtIONet::readConfig(PacketPtr pkt, Addr cfgOffset)
+{
+    Config cfg_out;
+    memcpy(cfg_out.mac, config.mac, ETH_ADDR_LEN);
+    cfg_out.status = htog(config.status, byteOrder);
+    cfg_out.maxVirtqueuePairs = htog(config.maxVirtqueuePairs, byteOrder);
+
+    readConfigBlob(pkt, cfgOffset, (uint8_t *)&cfg_out);
+}
+
+void
+VirtIONet::reset()
+{
+    VirtIODeviceBase::reset();
+
+    activePairs = 1;
+    rxFifo.clear();
+    txNext = 0;
+    txPacket = nullptr;
+    txPacketQueue = nullptr;
+    txPacketDesc = nullptr;
+}
+
+Port &
+VirtIONet::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "interface")
+        return interface;
+    return VirtIODeviceBase::getPort(if_name, idx);
+}
+
+void
+VirtIONet::interrupt()
+{
+    stats.interrupts++;
+    kick();
+}
+
+VirtIONet::RxQueue &
+VirtIONet::rxQueueFor(const EthPacketPtr &pkt) const
+{
+    if (activePairs == 1)
+        return *rxQueues[0];
+
+    // Keep the packets of a flow on one queue, so the guest sees them
+    // in order.
+    uint64_t hash = 0;
+    networking::IpPtr ip(pkt);
+    if (ip) {
+        hash = ((uint64_t)ip->src() << 32) | ip->dst();
+        networking::TcpPtr tcp(ip);
+        networking::UdpPtr udp(ip);
+        if (tcp)
+            hash ^= (tcp->sport() << 16) | tcp->dport();
+        else if (udp)
+            hash ^= (udp->sport() << 16) | udp->dport();
+    }
+    hash *= 0x9e3779b97f4a7c15ULL;
+    return *rxQueues[(hash >> 32) % activePairs];
+}
+
+bool
+VirtIONet::recvPacket(EthPacketPtr pkt)
+{
+    DPRINTF(VIONet, "Received packet (len: %i)\n", pkt->length);
+
+    if (!getDeviceStatus().driver_ok) {
+        DPRINTF(VIONet, "Driver not ready, packet dropped\n");
+        return true;
+    }
+
+    stats.rxPackets++;
+    stats.rxBytes += pkt->length;
+
+    if (rxFifo.size() >= rxFifoPackets) {
+        DPRINTF(VIONet, "No receive buffers, packet dropped\n");
+        stats.rxDropped++;
+        return false;
+    }
+
+    rxFifo.push_back(pkt);
+    rxKick();
+    return true;
+}
+
+void
+VirtIONet::rxKick()
+{
+    bool delivered = false;
+    while (!rxFifo.empty()) {
+        EthPacketPtr pkt = rxFifo.front();
+        RxQueue &queue = rxQueueFor(pkt);
+        VirtDescriptor *desc =
+            queue.getAddress() ? queue.consumeDescriptor() : nullptr;
+        if (!desc)
+            break;
+
+        const size_t size = sizeof(NetHeader) + pkt->length;
+        if (desc->chainSize() < size) {
+            warn_once("%s: receive buffer too small for a %i byte packet\n",
+                      name(), pkt->length);
+            stats.rxDropped++;
+            queue.produceDescriptor(desc, 0);
+        } else {
+            DPRINTF(VIONet, "Delivering packet to %s (len: %i)\n",
+                    queue.name(), pkt->length);
+            const NetHeader hdr{};
+            desc->chainWrite(0, (const uint8_t *)&hdr, sizeof(hdr));
+            desc->chainWrite(sizeof(hdr), pkt->data, pkt->length);
+            queue.produceDescriptor(desc, size);
+        }
+        rxFifo.pop_front();
+        delivered = true;
+    }
+
+    if (delivered)
+        interrupt();
+}
+
+bool
+VirtIONet::txDrain()
+{
+    // Still waiting for the wire to take the last packet
+    if (txPacket)
+        return false;
+
+    // Serve the active queues round robin, one packet at a time, until
+    // all of them are empty.
+    bool produced = false;
+    int idle = 0;
+    while (idle < activePairs) {
+        if (txNext >= activePairs)
+            txNext = 0;
+        TxQueue &queue = *txQueues[txNext++];
+        VirtDescriptor *desc =
+            queue.getAddress() ? queue.consumeDescriptor() : nullptr;
+        if (!desc) {
+            idle++;
+            continue;
+        }
+        idle = 0;
+
+        const size_t size = desc->chainSize();
+        if (size < sizeof(NetHeader)) {
+            warn_once("%s: transmit chain shorter than the packet header\n",
+                      name());
+            queue.produceDescriptor(desc, 0);
+            produced = true;
+            continue;
+        }
+
+        const size_t len = size - sizeof(NetHeader);
+        EthPacketPtr pkt = std::make_shared<EthPacketData>(len);
+        desc->chainRead(sizeof(NetHeader), pkt->data, len);
+        pkt->length = len;
+        pkt->simLength = len;
+
+        DPRINTF(VIONet, "Sending packet from %s (len: %i)\n",
+                queue.name(), len);
+        stats.txPackets++;
+        stats.txBytes += len;
+
+        if (!interface.sendPacket(pkt)) {
+            DPRINTF(VIONet, "Wire busy, waiting\n");
+            txPacket = pkt;
+            txPacketQueue = &queue;
+            txPacketDesc = desc;
+            break;
+        }
+        queue.produceDescriptor(desc, 0);
+        produced = true;
+    }
+
+    return produced;
+}
+
+void
+VirtIONet::txKick()
+{
+    if (txDrain())
+        interrupt();
+}
+
+void
+VirtIONet::transferDone()
+{
+    if (txPacket) {
+        if (!interface.sendPacket(txPacket))
+            return;
+        txPacketQueue->produceDescriptor(txPacketDesc, 0);
+        txPacket = nullptr;
+        txPacketQueue = nullptr;
+        txPacketDesc = nullptr;
+
+        txDrain();
+        interrupt();
+    } else {
+        txKick();
+    }
+}
+
+void
+VirtIONet::CtrlQueue::onNotifyDescriptor(VirtDescriptor *desc)
+{
+    CtrlHeader hdr;
+    desc->chainRead(0, (uint8_t *)&hdr, sizeof(hdr));
+
+    CtrlAck ack = ACK_ERR;
+    if (hdr.cls == CTRL_MQ && hdr.command == CTRL_MQ_VQ_PAIRS_SET) {
+        uint16_t pairs;
+        desc->chainRead(sizeof(hdr), (uint8_t *)&pairs, sizeof(pairs));
+        pairs = gtoh(pairs, byteOrder);
+        if (pairs >= 1 && pairs <= parent.rxQueues.size()) {
+            DPRINTF(VIONet, "Using %i queue pairs\n", pairs);
+            parent.activePairs = pairs;
+            ack = ACK_OK;
+        }
+    } else {
+        warn("%s: unsupported control command %i.%i\n", name(), hdr.cls,
+             hdr.command);
+    }
+
+    desc->chainWrite(desc->chainSize() - sizeof(ack), &ack, sizeof(ack));
+    produceDescriptor(desc, sizeof(ack));
+    parent.interrupt();
+
+    // Packets may be waiting for queues that just became active
+    parent.rxKick();
+    parent.txKick();
+}
+
+void
+VirtIONet::serialize(CheckpointOut &cp) const
+{
+    VirtIODeviceBase::serialize(cp);
+
+    SERIALIZE_SCALAR(activePairs);
+    SERIALIZE_SCALAR(txNext);
+
+    const size_t rxFifoCount = rxFifo.size();
+    SERIALIZE_SCALAR(rxFifoCount);
+    for (size_t i = 0; i < rxFifoCount; ++i)
+        rxFifo[i]->serialize(csprintf("rxFifo%i", i), cp);
+
+    int txPacketPair = -1;
+    if (txPacket) {
+        for (size_t i = 0; i < txQueues.size(); ++i) {
+            if (txQueues[i].get() == txPacketQueue)
+                txPacketPair = i;
+        }
+        paramOut(cp, "txPacketDesc", txPacketDesc->index());
+        txPacket->serialize("txPacket", cp);
+    }
+    SERIALIZE_SCALAR(txPacketPair);
+}
+
+void
+VirtIONet::unserialize(CheckpointIn &cp)
+{
+    VirtIODeviceBase::unserialize(cp);
+
+    UNSERIALIZE_SCALAR(activePairs);
+    UNSERIALIZE_SCALAR(txNext);
+
+    size_t rxFifoCount;
+    UNSERIALIZE_SCALAR(rxFifoCount);
+    rxFifo.clear();
+    for (size_t i = 0; i < rxFifoCount; ++i) {
+        EthPacketPtr pkt = std::make_shared<EthPacketData>();
+        pkt->unserialize(csprintf("rxFifo%i", i), cp);
+        rxFifo.push_back(pkt);
+    }
+
+    int txPacketPair;
+    UNSERIALIZE_SCALAR(txPacketPair);
+    if (txPacketPair >= 0) {
+        VirtDescriptor::Index index;
+        paramIn(cp, "txPacketDesc", index);
+        txPacketQueue = txQueues[txPacketPair].get();
+        txPacketDesc = txPacketQueue->getDescriptor(index);
+        txPacket = std::make_shared<EthPacketData>();
+        txPacket->unserialize("txPacket", cp);
+    }
+}
+
+VirtIONet::NetStats::NetStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(rxPackets, statistics::units::Count::get(),
+               "Number of packets received from the wire"),
+      ADD_STAT(rxBytes, statistics::units::Byte::get(),
+               "Number of bytes received from the wire"),
+      ADD_STAT(rxDropped, statistics::units::Count::get(),
+               "Number of received packets dropped for lack of buffers"),
+      ADD_STAT(txPackets, statistics::units::Count::get(),
+               "Number of packets transmitted"),
+      ADD_STAT(txBytes, statistics::units::Byte::get(),
+               "Number of bytes transmitted"),
+      ADD_STAT(interrupts, statistics::units::Count::get(),
+               "Number of interrupts raised for the guest")
+{
+}
+
+} // namespace gem5
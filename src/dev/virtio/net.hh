@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __DEV_VIRTIO_NET_HH__
+#define __DEV_VIRTIO_NET_HH__
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/cprintf.hh"
+#include "base/inet.hh"
+#include "base/statistics.hh"
+#include "dev/net/etherint.hh"
+#include "dev/net/etherpkt.hh"
+#include "dev/virtio/base.hh"
+
+namespace gem5
+{
+
+struct VirtIONetParams;
+
+/**
+ * VirtIO network device
+ *
+ * The network device uses the following queues:
+ *  -# Receive queue 0
+ *  -# Transmit queue 0
+ *  -# ...
+ *  -# Receive queue N-1
+ *  -# Transmit queue N-1
+ *  -# Control queue (only with more than one queue pair)
+ *
+ * Every packet in either direction is a descriptor chain that starts
+ * with a NetHeader followed by the frame. No offloads are offered, so
+ * the header is all zeros on receive and ignored on transmit.
+ *
+ * With more than one queue pair the device offers the multiqueue
+ * feature. The guest selects how many pairs it uses through the
+ * control queue, and received packets are steered to one of the
+ * active receive queues using a hash of their flow. Packets arriving
+ * while the guest hasn't posted receive buffers are held in a small
+ * FIFO.
+ *
+ * Each notification is handled by draining its queue completely and
+ * interrupting the guest once for the whole batch.
+ *
+ * @see http://docs.oasis-open.org/virtio/virtio/v1.0/virtio-v1.0.html
+ */
+class VirtIONet : public VirtIODeviceBase
+{
+  public:
+    typedef VirtIONetParams Params;
+    VirtIONet(const Params &params);
+    virtual ~VirtIONet();
+
+    void readConfig(PacketPtr pkt, Addr cfgOffset) override;
+
+    void reset() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+  protected:
+    static const DeviceId ID_NET = 0x01;
+
+    /**
+     * Network device configuration structure
+     *
+     * @note This needs to be changed if the supported feature set
+     * changes!
+     */
+    struct GEM5_PACKED Config
+    {
+        uint8_t mac[ETH_ADDR_LEN];
+        uint16_t status;
+        uint16_t maxVirtqueuePairs;
+    };
+    Config config;
+
+    /** @{
+     * @name Feature bits
+     */
+    static const FeatureBits F_MAC = (1 << 5);
+    static const FeatureBits F_STATUS = (1 << 16);
+    static const FeatureBits F_CTRL_VQ = (1 << 17);
+    static const FeatureBits F_MQ = (1 << 22);
+    /** @} */
+
+    /** Link is up */
+    static const uint16_t S_LINK_UP = 1;
+
+    /** Header preceding every packet */
+    struct GEM5_PACKED NetHeader
+    {
+        uint8_t flags;
+        uint8_t gsoType;
+        uint16_t hdrLen;
+        uint16_t gsoSize;
+        uint16_t csumStart;
+        uint16_t csumOffset;
+    };
+
+    /** @{
+     * @name Control queue commands
+     */
+    struct GEM5_PACKED CtrlHeader
+    {
+        uint8_t cls;
+        uint8_t command;
+    };
+
+    typedef uint8_t CtrlAck;
+    static const CtrlAck ACK_OK = 0;
+    static const CtrlAck ACK_ERR = 1;
+
+    static const uint8_t CTRL_MQ = 4;
+    static const uint8_t CTRL_MQ_VQ_PAIRS_SET = 0;
+    /** @} */
+
+    /**
+     * Virtqueue for packets going from the network to the guest.
+     */
+    class RxQueue
+        : public VirtQueue
+    {
+      public:
+        RxQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                VirtIONet &_parent, int _pair)
+            : VirtQueue(proxy, bo, size), parent(_parent), pair(_pair) {}
+
+        void onNotify() override { parent.rxKick(); }
+
+        std::string
+        name() const
+        {
+            return csprintf("%s.rxQueue%d", parent.name(), pair);
+        }
+
+      protected:
+        VirtIONet &parent;
+        const int pair;
+    };
+
+    /**
+     * Virtqueue for packets going from the guest to the network.
+     */
+    class TxQueue
+        : public VirtQueue
+    {
+      public:
+        TxQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                VirtIONet &_parent, int _pair)
+            : VirtQueue(proxy, bo, size), parent(_parent), pair(_pair) {}
+
+        void onNotify() override { parent.txKick(); }
+
+        std::string
+        name() const
+        {
+            return csprintf("%s.txQueue%d", parent.name(), pair);
+        }
+
+      protected:
+        VirtIONet &parent;
+        const int pair;
+    };
+
+    /**
+     * Virtqueue for device configuration commands.
+     */
+    class CtrlQueue
+        : public VirtQueue
+    {
+      public:
+        CtrlQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                  VirtIONet &_parent)
+            : VirtQueue(proxy, bo, size), parent(_parent) {}
+
+        void onNotifyDescriptor(VirtDescriptor *desc) override;
+
+        std::string name() const { return parent.name() + ".ctrlQueue"; }
+
+      protected:
+        VirtIONet &parent;
+    };
+
+    class Interface : public EtherInt
+    {
+      public:
+        Interface(const std::string &name, VirtIONet &_parent)
+            : EtherInt(name), parent(_parent) {}
+
+        bool recvPacket(EthPacketPtr pkt) override
+        {
+            return parent.recvPacket(pkt);
+        }
+        void sendDone() override { parent.transferDone(); }
+
+      protected:
+        VirtIONet &parent;
+    };
+
+    /** Called by the interface when a packet arrives from the wire. */
+    bool recvPacket(EthPacketPtr pkt);
+    /** Called by the interface when the wire is free again. */
+    void transferDone();
+
+    /**
+     * Deliver as many held packets as there are receive buffers
+     * for.
+     */
+    void rxKick();
+    /**
+     * Send packets from the active transmit queues until they are
+     * empty or the wire is busy, and interrupt the guest if any
+     * descriptors were returned.
+     */
+    void txKick();
+    /**
+     * Send packets like txKick() without interrupting the guest.
+     *
+     * @return true if any descriptors were returned to the guest.
+     */
+    bool txDrain();
+
+    /** Interrupt the guest once for a batch of returned descriptors. */
+    void interrupt();
+
+    /** Receive queue a packet is steered to */
+    RxQueue &rxQueueFor(const EthPacketPtr &pkt) const;
+
+    /** Number of queue pairs currently used by the guest */
+    int activePairs;
+
+    std::vector<std::unique_ptr<RxQueue>> rxQueues;
+    std::vector<std::unique_ptr<TxQueue>> txQueues;
+    std::unique_ptr<CtrlQueue> ctrlQueue;
+
+    Interface interface;
+
+    /** Received packets waiting for a guest buffer */
+    std::deque<EthPacketPtr> rxFifo;
+    /** Maximum number of packets in rxFifo */
+    const unsigned rxFifoPackets;
+
+    /** Transmit queue served next */
+    int txNext;
+    /** Packet (if any) waiting for the wire to become free */
+    EthPacketPtr txPacket;
+    /** Queue and descriptor chain txPacket was taken from */
+    TxQueue *txPacketQueue;
+    VirtDescriptor *txPacketDesc;
+
+    struct NetStats : public statistics::Group
+    {
+        NetStats(statistics::Group *parent);
+
+        statistics::Scalar rxPackets;
+        statistics::Scalar rxBytes;
+        statistics::Scalar rxDropped;
+        statistics::Scalar txPackets;
+        statistics::Scalar txBytes;
+        statistics::Scalar interrupts;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __DEV_VIRTIO_NET_HH__
@@ -267,6 +267,18 @@ class GPUDispatcher(SimObject):
     cxx_class = 'gem5::GPUDispatcher'
     cxx_header = 'gpu-compute/dispatcher.hh'
 
+    # Kernel sampling. Kernels that are not sampled are not executed at
+    # all: their completion is signalled after the latency recorded for
+    # the same code, and memory is left as it was.
+    kernel_sample_period = Param.Unsigned(1, "Run every Nth kernel launch "
+        "in detail and skip the others")
+    kernel_sample_offset = Param.Unsigned(0, "Number of kernel launches to "
+        "skip before the first one run in detail")
+    detailed_kernels = VectorParam.Int([], "Dispatch IDs that are always "
+        "run in detail")
+    skipped_kernel_latency = Param.Latency('10us', "Time a skipped kernel "
+        "takes if no kernel with the same code has run in detail yet")
+
 class GPUCommandProcessor(DmaVirtDevice):
     type = 'GPUCommandProcessor'
     cxx_class = 'gem5::GPUCommandProcessor'
@@ -31,6 +31,7 @@
 
 #include "gpu-compute/compute_unit.hh"
 
+#include <algorithm>
 #include <limits>
 
 #include "arch/amdgpu/common/gpu_translation_state.hh"
@@ -80,7 +81,9 @@ ComputeUnit::ComputeUnit(const Params &p) : ClockedObject(p),
     scalarMemoryPipe(p, *this),
     tickEvent([this]{ exec(); }, "Compute unit tick event",
           false, Event::CPU_Tick_Pri),
-    cu_id(p.cu_id),
+    scheduledAddEvent([this]{ execScheduledAdds(); },
+          "Compute unit scheduled adds event", false, Event::CPU_Tick_Pri),
+    sa_n(0), cu_id(p.cu_id),
     vrf(p.vector_register_file), srf(p.scalar_register_file),
     simdWidth(p.simd_width),
     spBypassPipeLength(p.spbypass_pipe_length),
@@ -389,7 +392,7 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
 void
 ComputeUnit::doInvalidate(RequestPtr req, int kernId){
     GPUDynInstPtr gpuDynInst
-        = std::make_shared<GPUDynInst>(this, nullptr,
+        = GPUDynInst::create(this, nullptr,
             new KernelLaunchStaticInst(), getAndIncSeqNum());
 
     // kern_id will be used in inv responses
@@ -755,6 +758,52 @@ ComputeUnit::exec()
     }
 }
 
+void
+ComputeUnit::execScheduledAdds()
+{
+    assert(!sa_when.empty());
+
+    // apply any scheduled adds
+    for (int i = 0; i < sa_n; ++i) {
+        if (sa_when[i] <= curTick()) {
+            *sa_val[i] += sa_x[i];
+            panic_if(*sa_val[i] < 0, "Negative counter value\n");
+            sa_val.erase(sa_val.begin() + i);
+            sa_x.erase(sa_x.begin() + i);
+            sa_when.erase(sa_when.begin() + i);
+            --sa_n;
+            --i;
+        }
+    }
+    if (!sa_when.empty()) {
+        Tick wakeup = *std::max_element(sa_when.begin(), sa_when.end());
+        DPRINTF(GPUDisp, "CU%d: Scheduling scheduled adds at %lu\n", cu_id,
+                wakeup);
+        schedule(scheduledAddEvent, wakeup);
+    } else {
+        DPRINTF(GPUDisp, "CU%d: No more scheduled adds\n", cu_id);
+    }
+}
+
+void
+ComputeUnit::ScheduleAdd(int *val, Tick when, int x)
+{
+    sa_val.push_back(val);
+    when += curTick();
+    sa_when.push_back(when);
+    sa_x.push_back(x);
+    ++sa_n;
+    if (!scheduledAddEvent.scheduled() ||
+        (when < scheduledAddEvent.when())) {
+        DPRINTF(GPUDisp, "CU%d: New scheduled add; scheduling it at %lu\n",
+                cu_id, when);
+        reschedule(scheduledAddEvent, when, true);
+    } else {
+        DPRINTF(GPUDisp, "CU%d: New scheduled add; adds already scheduled "
+                "at %lu\n", cu_id, when);
+    }
+}
+
 void
 ComputeUnit::init()
 {
@@ -1149,7 +1198,7 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
                 new ComputeUnit::DataPort::SenderState(gpuDynInst, index,
                     nullptr);
 
-            gpuDynInst->memStatusVector[pkt->getAddr()].push_back(index);
+            gpuDynInst->memStatusVector.push(pkt->getAddr(), index);
             gpuDynInst->tlbHitLevel[index] = hit_level;
 
             // translation is done. Schedule the mem_req_event at the
@@ -1369,25 +1418,18 @@ ComputeUnit::DataPort::processMemRespEvent(PacketPtr pkt)
     }
 
     // this is for read, write and atomic
-    int index = gpuDynInst->memStatusVector[paddr].back();
+    int index = gpuDynInst->memStatusVector.pop(paddr);
 
     DPRINTF(GPUMem, "Response for addr %#x, index %d\n",
             pkt->req->getPaddr(), id);
 
-    gpuDynInst->memStatusVector[paddr].pop_back();
     gpuDynInst->pAddr = pkt->req->getPaddr();
 
     gpuDynInst->decrementStatusVector(index);
     DPRINTF(GPUMem, "bitvector is now %s\n", gpuDynInst->printStatusVector());
 
     if (gpuDynInst->allLanesZero()) {
-        auto iter = gpuDynInst->memStatusVector.begin();
-        auto end = gpuDynInst->memStatusVector.end();
-
-        while (iter != end) {
-            assert(iter->second.empty());
-            ++iter;
-        }
+        assert(gpuDynInst->memStatusVector.empty());
 
         // Calculate the difference between the arrival of the first cache
         // block and the last cache block to arrive if we have the time
@@ -1468,7 +1510,7 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
     GPUDynInstPtr gpuDynInst = sender_state->_gpuDynInst;
     PortID mp_index = sender_state->portIndex;
     Addr vaddr = pkt->req->getVaddr();
-    gpuDynInst->memStatusVector[line].push_back(mp_index);
+    gpuDynInst->memStatusVector.push(line, mp_index);
     gpuDynInst->tlbHitLevel[mp_index] = hit_level;
 
     MemCmd requestCmd;
@@ -1887,8 +1929,7 @@ ComputeUnit::updateInstStats(GPUDynInstPtr gpuDynInst)
         }
     } else {
         if (gpuDynInst->isALU()) {
-            shader->total_valu_insts++;
-            if (shader->total_valu_insts == shader->max_valu_insts) {
+            if (++shader->total_valu_insts == shader->max_valu_insts) {
                 exitSimLoop("max vALU insts");
             }
             stats.vALUInsts++;
@@ -287,6 +287,21 @@ class ComputeUnit : public ClockedObject
 
     EventFunctionWrapper tickEvent;
 
+    // Scheduled adds to the counters of the wavefronts. The CU keeps
+    // them rather than the shader, so that they are applied on the
+    // event queue of the CU.
+    EventFunctionWrapper scheduledAddEvent;
+
+    // Size of scheduled add queue
+    uint32_t sa_n;
+
+    // Pointer to value to be increments
+    std::vector<int*> sa_val;
+    // When to do the increment
+    std::vector<uint64_t> sa_when;
+    // Amount to increment by
+    std::vector<int32_t> sa_x;
+
     typedef ComputeUnitParams Params;
     std::vector<std::vector<Wavefront*>> wfList;
     int cu_id;
@@ -394,6 +409,13 @@ class ComputeUnit : public ClockedObject
     int wfSize() const { return wavefrontSize; }
 
     void exec();
+
+    // Run scheduled adds
+    void execScheduledAdds();
+
+    // Schedule a 32-bit value to be incremented some time in the future
+    void ScheduleAdd(int *val, Tick when, int x);
+
     void initiateFetch(Wavefront *wavefront);
     void fetch(PacketPtr pkt, Wavefront *wavefront);
     void fillKernelState(Wavefront *w, HSAQueueEntry *task);
@@ -50,8 +50,16 @@ GPUDispatcher::GPUDispatcher(const Params &p)
     : SimObject(p), shader(nullptr), gpuCmdProc(nullptr),
       tickEvent([this]{ exec(); },
           "GPU Dispatcher tick", false, Event::CPU_Tick_Pri),
-      dispatchActive(false), stats(this)
+      dispatchActive(false),
+      kernelSamplePeriod(p.kernel_sample_period),
+      kernelSampleOffset(p.kernel_sample_offset),
+      detailedKernels(p.detailed_kernels.begin(), p.detailed_kernels.end()),
+      skippedKernelLatency(p.skipped_kernel_latency), numLaunches(0),
+      stats(this)
 {
+    fatal_if(!kernelSamplePeriod, "%s: kernel_sample_period must be at "
+             "least 1\n", name());
+
     schedule(&tickEvent, 0);
 }
 
@@ -120,6 +128,12 @@ GPUDispatcher::dispatch(HSAQueueEntry *task)
     DPRINTF(GPUAgentDisp, "launching kernel: %s, dispatch ID: %d\n",
             task->kernelName(), task->dispatchId());
 
+    if (!sampleKernel(task)) {
+        skipKernel(task);
+        return;
+    }
+    launchTicks[task->dispatchId()] = curTick();
+
     execIds.push(task->dispatchId());
     dispatchActive = true;
     hsaQueueEntries.emplace(task->dispatchId(), task);
@@ -129,6 +143,44 @@ GPUDispatcher::dispatch(HSAQueueEntry *task)
     }
 }
 
+/**
+ * Kernel sampling: decide whether a launch runs in detail. Launches
+ * before the sample offset are fast-forwarded, after that only every
+ * Nth one runs in detail.
+ */
+bool
+GPUDispatcher::sampleKernel(HSAQueueEntry *task)
+{
+    uint64_t launch = numLaunches++;
+    if (detailedKernels.count(task->dispatchId()))
+        return true;
+    return launch >= kernelSampleOffset &&
+        (launch - kernelSampleOffset) % kernelSamplePeriod == 0;
+}
+
+/**
+ * A skipped kernel is not dispatched to the CUs. It completes after the
+ * mean latency of the detailed runs of the same code object, or after
+ * the configured latency if the code has not run in detail yet.
+ */
+void
+GPUDispatcher::skipKernel(HSAQueueEntry *task)
+{
+    ++stats.numKernelSkipped;
+
+    Tick latency = skippedKernelLatency;
+    auto it = kernelLatencies.find(task->codeAddr());
+    if (it != kernelLatencies.end())
+        latency = it->second.first / it->second.second;
+
+    DPRINTF(GPUDisp, "skipping kernel: %s, dispatch ID: %d, completes in "
+            "%d ticks\n", task->kernelName(), task->dispatchId(), latency);
+
+    schedule(new EventFunctionWrapper([this, task]{ finishKernel(task); },
+                                      "GPU Dispatcher skipped kernel", true),
+             curTick() + latency);
+}
+
 void
 GPUDispatcher::exec()
 {
@@ -245,6 +297,8 @@ GPUDispatcher::isReachingKernelEnd(Wavefront *wf)
 void
 GPUDispatcher::updateInvCounter(int kern_id, int val) {
     assert(val == -1 || val == 1);
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
 
     auto task = hsaQueueEntries[kern_id];
     task->updateOutstandingInvs(val);
@@ -265,6 +319,8 @@ GPUDispatcher::updateInvCounter(int kern_id, int val) {
 bool
 GPUDispatcher::updateWbCounter(int kern_id, int val) {
     assert(val == -1 || val == 1);
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
 
     auto task = hsaQueueEntries[kern_id];
     task->updateOutstandingWbs(val);
@@ -294,6 +350,8 @@ GPUDispatcher::getOutstandingWbs(int kernId) {
 void
 GPUDispatcher::notifyWgCompl(Wavefront *wf)
 {
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
     int kern_id = wf->kernId;
     DPRINTF(GPUDisp, "notify WgCompl %d\n", wf->wgId);
     auto task = hsaQueueEntries[kern_id];
@@ -304,32 +362,15 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
         curTick(), wf->wgId, kern_id, wf->computeUnit->cu_id);
 
     if (task->numWgCompleted() == task->numWgTotal()) {
-        // Notify the HSA PP that this kernel is complete
-        gpuCmdProc->hsaPacketProc()
-            .finishPkt(task->dispPktPtr(), task->queueId());
-        if (task->completionSignal()) {
-            /**
-            * HACK: The semantics of the HSA signal is to decrement
-            * the current signal value. We cheat here and read out
-            * he value from main memory using functional access and
-            * then just DMA the decremented value.
-            */
-            uint64_t signal_value =
-                gpuCmdProc->functionalReadHsaSignal(task->completionSignal());
-
-            DPRINTF(GPUDisp, "HSA AQL Kernel Complete with completion "
-                    "signal! Addr: %d\n", task->completionSignal());
-
-            gpuCmdProc->updateHsaSignal(task->completionSignal(),
-                                        signal_value - 1);
-        } else {
-            DPRINTF(GPUDisp, "HSA AQL Kernel Complete! No completion "
-                "signal\n");
-        }
-
-        DPRINTF(GPUWgLatency, "Kernel Complete ticks:%d kernel:%d\n",
-                curTick(), kern_id);
-        DPRINTF(GPUKernelInfo, "Completed kernel %d\n", kern_id);
+        // record how long the kernel took for the skipped launches
+        auto it = launchTicks.find(kern_id);
+        assert(it != launchTicks.end());
+        auto &latency = kernelLatencies[task->codeAddr()];
+        latency.first += curTick() - it->second;
+        latency.second++;
+        launchTicks.erase(it);
+
+        finishKernel(task);
     }
 
     if (!tickEvent.scheduled()) {
@@ -337,6 +378,39 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
     }
 }
 
+void
+GPUDispatcher::finishKernel(HSAQueueEntry *task)
+{
+    int kern_id = task->dispatchId();
+
+    // Notify the HSA PP that this kernel is complete
+    gpuCmdProc->hsaPacketProc()
+        .finishPkt(task->dispPktPtr(), task->queueId());
+    if (task->completionSignal()) {
+        /**
+        * HACK: The semantics of the HSA signal is to decrement
+        * the current signal value. We cheat here and read out
+        * he value from main memory using functional access and
+        * then just DMA the decremented value.
+        */
+        uint64_t signal_value =
+            gpuCmdProc->functionalReadHsaSignal(task->completionSignal());
+
+        DPRINTF(GPUDisp, "HSA AQL Kernel Complete with completion "
+                "signal! Addr: %d\n", task->completionSignal());
+
+        gpuCmdProc->updateHsaSignal(task->completionSignal(),
+                                    signal_value - 1);
+    } else {
+        DPRINTF(GPUDisp, "HSA AQL Kernel Complete! No completion "
+            "signal\n");
+    }
+
+    DPRINTF(GPUWgLatency, "Kernel Complete ticks:%d kernel:%d\n",
+            curTick(), kern_id);
+    DPRINTF(GPUKernelInfo, "Completed kernel %d\n", kern_id);
+}
+
 void
 GPUDispatcher::scheduleDispatch()
 {
@@ -349,6 +423,8 @@ GPUDispatcher::GPUDispatcherStats::GPUDispatcherStats(
     statistics::Group *parent)
     : statistics::Group(parent),
       ADD_STAT(numKernelLaunched, "number of kernel launched"),
+      ADD_STAT(numKernelSkipped, "number of kernel launches skipped by "
+               "kernel sampling"),
       ADD_STAT(cyclesWaitingForDispatch, "number of cycles with outstanding "
                "wavefronts that are waiting to be dispatched")
 {
@@ -43,6 +43,8 @@
 
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -82,6 +84,10 @@ class GPUDispatcher : public SimObject
     HSAQueueEntry* hsaTask(int disp_id);
 
   private:
+    bool sampleKernel(HSAQueueEntry *task);
+    void skipKernel(HSAQueueEntry *task);
+    void finishKernel(HSAQueueEntry *task);
+
     Shader *shader;
     GPUCommandProcessor *gpuCmdProc;
     EventFunctionWrapper tickEvent;
@@ -93,12 +99,25 @@ class GPUDispatcher : public SimObject
     // is there a kernel in execution?
     bool dispatchActive;
 
+    // kernel sampling, see GPUDispatcher in GPU.py
+    const unsigned kernelSamplePeriod;
+    const unsigned kernelSampleOffset;
+    const std::unordered_set<int> detailedKernels;
+    const Tick skippedKernelLatency;
+    // number of kernels launched so far
+    uint64_t numLaunches;
+    // launch tick of the kernels running in detail
+    std::unordered_map<int, Tick> launchTicks;
+    // total ticks and number of detailed runs for each kernel code object
+    std::unordered_map<Addr, std::pair<Tick, uint64_t>> kernelLatencies;
+
   protected:
     struct GPUDispatcherStats : public statistics::Group
     {
         GPUDispatcherStats(statistics::Group *parent);
 
         statistics::Scalar numKernelLaunched;
+        statistics::Scalar numKernelSkipped;
         statistics::Scalar cyclesWaitingForDispatch;
     } stats;
 };
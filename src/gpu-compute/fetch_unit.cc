@@ -578,10 +578,10 @@ FetchUnit::FetchBufDesc::decodeInsts()
             assert(readPtr <= bufEnd);
 
             GPUDynInstPtr gpu_dyn_inst
-                = std::make_shared<GPUDynInst>(wavefront->computeUnit,
-                                               wavefront, gpu_static_inst,
-                                               wavefront->computeUnit->
-                                                getAndIncSeqNum());
+                = GPUDynInst::create(wavefront->computeUnit,
+                                     wavefront, gpu_static_inst,
+                                     wavefront->computeUnit->
+                                         getAndIncSeqNum());
             wavefront->instructionBuffer.push_back(gpu_dyn_inst);
 
             DPRINTF(GPUFetch, "WF[%d][%d]: Id%ld decoded %s (%d bytes). "
@@ -618,10 +618,10 @@ FetchUnit::FetchBufDesc::decodeSplitInst()
     assert(readPtr < bufEnd);
 
     GPUDynInstPtr gpu_dyn_inst
-        = std::make_shared<GPUDynInst>(wavefront->computeUnit,
-                                       wavefront, gpu_static_inst,
-                                       wavefront->computeUnit->
-                                           getAndIncSeqNum());
+        = GPUDynInst::create(wavefront->computeUnit,
+                             wavefront, gpu_static_inst,
+                             wavefront->computeUnit->
+                                 getAndIncSeqNum());
     wavefront->instructionBuffer.push_back(gpu_dyn_inst);
 
     DPRINTF(GPUFetch, "WF[%d][%d]: Id%d decoded split inst %s (%#x) "
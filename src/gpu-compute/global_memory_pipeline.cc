@@ -150,17 +150,17 @@ GlobalMemPipeline::exec()
         Tick accessTime = curTick() - m->getAccessTime();
 
         // Decrement outstanding requests count
-        computeUnit.shader->ScheduleAdd(&w->outstandingReqs, m->time, -1);
+        computeUnit.ScheduleAdd(&w->outstandingReqs, m->time, -1);
         if (m->isStore() || m->isAtomic() || m->isMemSync()) {
             computeUnit.shader->sampleStore(accessTime);
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsWrGm,
-                                             m->time, -1);
+            computeUnit.ScheduleAdd(&w->outstandingReqsWrGm,
+                                    m->time, -1);
         }
 
         if (m->isLoad() || m->isAtomic() || m->isMemSync()) {
             computeUnit.shader->sampleLoad(accessTime);
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsRdGm,
-                                             m->time, -1);
+            computeUnit.ScheduleAdd(&w->outstandingReqsRdGm,
+                                    m->time, -1);
         }
 
         w->validateRequestCounters();
@@ -169,7 +169,8 @@ GlobalMemPipeline::exec()
         // going all the way to memory and stats for individual cache
         // blocks generated by the instruction.
         m->profileRoundTripTime(curTick(), InstMemoryHop::Complete);
-        computeUnit.shader->sampleInstRoundTrip(m->getRoundTripTime());
+        computeUnit.shader->sampleInstRoundTrip(
+            m->getRoundTripTime().data(), m->getNumRoundTripHops());
         computeUnit.shader->sampleLineRoundTrip(m->getLineAddressTime());
 
         // Mark write bus busy for appropriate amount of time
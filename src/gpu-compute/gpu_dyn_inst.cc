@@ -31,6 +31,9 @@
 
 #include "gpu-compute/gpu_dyn_inst.hh"
 
+#include <algorithm>
+#include <cstring>
+
 #include "debug/GPUInst.hh"
 #include "debug/GPUMem.hh"
 #include "gpu-compute/gpu_static_inst.hh"
@@ -43,31 +46,24 @@ namespace gem5
 
 GPUDynInst::GPUDynInst(ComputeUnit *_cu, Wavefront *_wf,
                        GPUStaticInst *static_inst, InstSeqNum instSeqNum)
-    : GPUExecContext(_cu, _wf), scalarAddr(0), addr(computeUnit()->wfSize(),
-      (Addr)0), numScalarReqs(0), isSaveRestore(false),
+    : GPUExecContext(_cu, _wf), scalarAddr(0), d_data(dData),
+      scalar_data(scalarData), a_data(aData), x_data(xData),
+      numScalarReqs(0), isSaveRestore(false),
       _staticInst(static_inst), _seqNum(instSeqNum),
       maxSrcVecRegOpSize(-1), maxSrcScalarRegOpSize(-1)
 {
     _staticInst->initOperandInfo();
-    statusVector.assign(TheGpuISA::NumVecElemPerVecReg, 0);
-    tlbHitLevel.assign(computeUnit()->wfSize(), -1);
-    // vector instructions can have up to 4 source/destination operands
-    d_data = new uint8_t[computeUnit()->wfSize() * 4 * sizeof(double)];
-    a_data = new uint8_t[computeUnit()->wfSize() * 8];
-    x_data = new uint8_t[computeUnit()->wfSize() * 8];
-    // scalar loads can read up to 16 Dwords of data (see publicly
-    // available GCN3 ISA manual)
-    scalar_data = new uint8_t[16 * sizeof(uint32_t)];
-    for (int i = 0; i < (16 * sizeof(uint32_t)); ++i) {
-        scalar_data[i] = 0;
-    }
-    for (int i = 0; i < (computeUnit()->wfSize() * 8); ++i) {
-        a_data[i] = 0;
-        x_data[i] = 0;
-    }
-    for (int i = 0; i < (computeUnit()->wfSize() * 4 * sizeof(double)); ++i) {
-        d_data[i] = 0;
-    }
+
+    // only the lanes of this wavefront are ever touched
+    const int wf_size = computeUnit()->wfSize();
+    assert(wf_size <= MaxWfSize);
+    std::fill_n(addr.begin(), wf_size, 0);
+    statusVector.fill(0);
+    std::fill_n(tlbHitLevel.begin(), wf_size, -1);
+    std::memset(d_data, 0, wf_size * 4 * sizeof(double));
+    std::memset(a_data, 0, wf_size * 8);
+    std::memset(x_data, 0, wf_size * 8);
+    std::memset(scalar_data, 0, sizeof(scalarData));
     time = 0;
 
     cu_id = _cu->cu_id;
@@ -95,10 +91,6 @@ GPUDynInst::GPUDynInst(ComputeUnit *_cu, Wavefront *_wf,
 
 GPUDynInst::~GPUDynInst()
 {
-    delete[] d_data;
-    delete[] a_data;
-    delete[] x_data;
-    delete[] scalar_data;
     delete _staticInst;
 }
 
@@ -989,10 +981,11 @@ void
 GPUDynInst::profileRoundTripTime(Tick currentTime, int hopId)
 {
     // Only take the first measurement in the case of coalescing
-    if (roundTripTime.size() > hopId)
+    if (numRoundTripHops > hopId)
         return;
 
-    roundTripTime.push_back(currentTime);
+    assert(numRoundTripHops < InstMemoryHop::InstMemoryHopMax);
+    roundTripTime[numRoundTripHops++] = currentTime;
 }
 
 void
@@ -32,9 +32,12 @@
 #ifndef __GPU_DYN_INST_HH__
 #define __GPU_DYN_INST_HH__
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/amo.hh"
 #include "base/logging.hh"
@@ -113,12 +116,88 @@ class RegisterOperandInfo
     const std::vector<int> physIndices;
 };
 
+/**
+ * Allocator that recycles the storage of dynamic instructions, together
+ * with the shared_ptr control block allocated alongside them, through a
+ * per-thread free list. Every fetched instruction gets a GPUDynInst, so
+ * this keeps the heap out of the steady state of the fetch loop.
+ */
+template <class T>
+class GPUDynInstAllocator
+{
+  public:
+    typedef T value_type;
+
+    GPUDynInstAllocator() = default;
+    template <class U>
+    GPUDynInstAllocator(const GPUDynInstAllocator<U> &) { }
+
+    T *
+    allocate(std::size_t n)
+    {
+        std::vector<T *> &free_list = freeList();
+        if (n == 1 && !free_list.empty()) {
+            T *p = free_list.back();
+            free_list.pop_back();
+            return p;
+        }
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, std::size_t n)
+    {
+        std::vector<T *> &free_list = freeList();
+        if (n == 1 && free_list.size() < maxPooled) {
+            free_list.push_back(p);
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    template <class U>
+    bool operator==(const GPUDynInstAllocator<U> &) const { return true; }
+    template <class U>
+    bool operator!=(const GPUDynInstAllocator<U> &) const { return false; }
+
+  private:
+    // enough for the instruction buffers and memory pipelines of a CU
+    static constexpr std::size_t maxPooled = 4096;
+
+    static std::vector<T *> &
+    freeList()
+    {
+        // never destroyed, instructions may be released during exit
+        static thread_local std::vector<T *> *free_list =
+            new std::vector<T *>;
+        return *free_list;
+    }
+};
+
 class GPUDynInst : public GPUExecContext
 {
   public:
     GPUDynInst(ComputeUnit *_cu, Wavefront *_wf, GPUStaticInst *static_inst,
                uint64_t instSeqNum);
     ~GPUDynInst();
+
+    // the data pointers below refer to the inline storage of the object
+    GPUDynInst(const GPUDynInst &) = delete;
+    GPUDynInst &operator=(const GPUDynInst &) = delete;
+
+    /**
+     * Create a dynamic instruction whose storage comes from the pool of
+     * previously retired ones.
+     */
+    static GPUDynInstPtr
+    create(ComputeUnit *_cu, Wavefront *_wf, GPUStaticInst *static_inst,
+           uint64_t instSeqNum)
+    {
+        return std::allocate_shared<GPUDynInst>(
+            GPUDynInstAllocator<GPUDynInst>(), _cu, _wf, static_inst,
+            instSeqNum);
+    }
+
     void execute(GPUDynInstPtr gpuDynInst);
 
     const std::vector<OperandInfo>& srcVecRegOperands() const;
@@ -168,7 +247,7 @@ class GPUDynInst : public GPUExecContext
     // virtual address for scalar memory operations
     Addr scalarAddr;
     // virtual addressies for vector memory operations
-    std::vector<Addr> addr;
+    std::array<Addr, MaxWfSize> addr;
     Addr pAddr;
 
     // vector data to get written
@@ -448,16 +527,59 @@ class GPUDynInst : public GPUExecContext
         return statusVec_str;
     }
 
-    // Map returned packets and the addresses they satisfy with which lane they
-    // were requested from
-    typedef std::unordered_map<Addr, std::vector<int>> StatusVector;
+    /**
+     * Map returned packets and the addresses they satisfy with which lane
+     * they were requested from. A lane has at most two packets in flight,
+     * so this is a fixed table of (address, lane) pairs. The lanes waiting
+     * on an address are handed back most recent first.
+     */
+    class StatusVector
+    {
+      public:
+        void
+        push(Addr addr, int lane)
+        {
+            panic_if(numEntries == (int)entries.size(),
+                     "Too many outstanding packets for one instruction\n");
+            entries[numEntries++] = {addr, lane};
+        }
+
+        int
+        pop(Addr addr)
+        {
+            for (int i = numEntries - 1; i >= 0; --i) {
+                if (entries[i].addr == addr) {
+                    int lane = entries[i].lane;
+                    std::copy(entries.begin() + i + 1,
+                              entries.begin() + numEntries,
+                              entries.begin() + i);
+                    --numEntries;
+                    return lane;
+                }
+            }
+            panic("No lane is waiting for address %#x\n", addr);
+        }
+
+        bool empty() const { return numEntries == 0; }
+        void clear() { numEntries = 0; }
+
+      private:
+        struct Entry
+        {
+            Addr addr;
+            int lane;
+        };
+
+        std::array<Entry, 2 * MaxWfSize> entries;
+        int numEntries = 0;
+    };
     StatusVector memStatusVector;
 
     // Track the status of memory requests per lane, an int per lane to allow
     // unaligned accesses
-    std::vector<int> statusVector;
+    std::array<int, TheGpuISA::NumVecElemPerVecReg> statusVector;
     // for ld_v# or st_v#
-    std::vector<int> tlbHitLevel;
+    std::array<int, MaxWfSize> tlbHitLevel;
 
     // for misaligned scalar ops we track the number
     // of outstanding reqs here
@@ -468,7 +590,9 @@ class GPUDynInst : public GPUExecContext
     void setAccessTime(Tick currentTime) { accessTime = currentTime; }
 
     void profileRoundTripTime(Tick currentTime, int hopId);
-    std::vector<Tick> getRoundTripTime() const { return roundTripTime; }
+    const std::array<Tick, InstMemoryHop::InstMemoryHopMax> &
+    getRoundTripTime() const { return roundTripTime; }
+    int getNumRoundTripHops() const { return numRoundTripHops; }
 
     void profileLineAddressTime(Addr addr, Tick currentTime, int hopId);
     const std::map<Addr, std::vector<Tick>>& getLineAddressTime() const
@@ -490,9 +614,20 @@ class GPUDynInst : public GPUExecContext
     // the time the request was started
     Tick accessTime = -1;
 
+    // backing storage for the data pointers, sized for the largest
+    // wavefront so the instruction needs no allocations of its own
+    // vector instructions can have up to 4 source/destination operands
+    uint8_t dData[MaxWfSize * 4 * sizeof(double)];
+    uint8_t aData[MaxWfSize * 8];
+    uint8_t xData[MaxWfSize * 8];
+    // scalar loads can read up to 16 Dwords of data (see publicly
+    // available GCN3 ISA manual)
+    uint8_t scalarData[16 * sizeof(uint32_t)];
+
     // hold the tick when the instruction arrives at certain hop points
     // on it's way to main memory
-    std::vector<Tick> roundTripTime;
+    std::array<Tick, InstMemoryHop::InstMemoryHopMax> roundTripTime;
+    int numRoundTripHops = 0;
 
     // hold each cache block address for the instruction and a vector
     // to hold the tick when the block arrives at certain hop points
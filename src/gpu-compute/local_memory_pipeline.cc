@@ -90,16 +90,16 @@ LocalMemPipeline::exec()
         }
 
         // Decrement outstanding request count
-        computeUnit.shader->ScheduleAdd(&w->outstandingReqs, m->time, -1);
+        computeUnit.ScheduleAdd(&w->outstandingReqs, m->time, -1);
 
         if (m->isStore() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsWrLm,
-                                             m->time, -1);
+            computeUnit.ScheduleAdd(&w->outstandingReqsWrLm,
+                                    m->time, -1);
         }
 
         if (m->isLoad() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsRdLm,
-                                             m->time, -1);
+            computeUnit.ScheduleAdd(&w->outstandingReqsRdLm,
+                                    m->time, -1);
         }
 
         // Mark write bus busy for appropriate amount of time
@@ -46,6 +46,8 @@ class GPUDynInst;
 
 typedef std::bitset<std::numeric_limits<unsigned long long>::digits>
     VectorMask;
+// the largest wavefront the CU allows, one lane per bit of the exec mask
+constexpr int MaxWfSize = std::numeric_limits<unsigned long long>::digits;
 typedef std::shared_ptr<GPUDynInst> GPUDynInstPtr;
 
 enum InstMemoryHop : int
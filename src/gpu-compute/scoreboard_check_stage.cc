@@ -31,6 +31,7 @@
 
 #include "gpu-compute/scoreboard_check_stage.hh"
 
+#include "base/bitfield.hh"
 #include "debug/GPUExec.hh"
 #include "debug/GPUSched.hh"
 #include "debug/GPUSync.hh"
@@ -50,8 +51,14 @@ ScoreboardCheckStage::ScoreboardCheckStage(const ComputeUnitParams &p,
                                            ScoreboardCheckToSchedule
                                            &to_schedule)
     : computeUnit(cu), toSchedule(to_schedule),
-      _name(cu.name() + ".ScoreboardCheckStage"), stats(&cu)
+      _name(cu.name() + ".ScoreboardCheckStage"),
+      activeWfs(p.num_SIMDs, mask(p.n_wf)),
+      parkedStatus(p.num_SIMDs,
+                   std::vector<nonrdytype_e>(p.n_wf, NRDY_ILLEGAL)),
+      numParked(NRDY_CONDITIONS, 0), stats(&cu)
 {
+    fatal_if(p.n_wf > 64, "%s: at most 64 WF slots per SIMD are supported",
+             _name);
 }
 
 ScoreboardCheckStage::~ScoreboardCheckStage()
@@ -66,6 +73,14 @@ ScoreboardCheckStage::collectStatistics(nonrdytype_e rdyStatus)
     stats.stallCycles[rdyStatus]++;
 }
 
+void
+ScoreboardCheckStage::park(int simd_id, int wf_slot, nonrdytype_e rdyStatus)
+{
+    activeWfs[simd_id] &= ~(1ULL << wf_slot);
+    parkedStatus[simd_id][wf_slot] = rdyStatus;
+    numParked[rdyStatus]++;
+}
+
 // Return true if this wavefront is ready
 // to execute an instruction of the specified type.
 // It also returns the reason (in rdyStatus) if the instruction is not
@@ -253,9 +268,18 @@ ScoreboardCheckStage::exec()
      */
     toSchedule.reset();
 
-    // Iterate over all WF slots across all SIMDs.
+    // Parked WFs stall for the same reason they did when they were parked
+    for (int i = 0; i < NRDY_CONDITIONS; ++i) {
+        if (numParked[i])
+            stats.stallCycles[i] += numParked[i];
+    }
+
+    // Iterate over the WF slots that are not parked across all SIMDs.
     for (int simdId = 0; simdId < computeUnit.numVectorALUs; ++simdId) {
-        for (int wfSlot = 0; wfSlot < computeUnit.shader->n_wf; ++wfSlot) {
+        uint64_t active = activeWfs[simdId];
+        while (active) {
+            int wfSlot = findLsbSet(active);
+            active &= active - 1;
             // reset the ready status of each wavefront
             Wavefront *curWave = computeUnit.wfList[simdId][wfSlot];
             nonrdytype_e rdyStatus = NRDY_ILLEGAL;
@@ -271,6 +295,11 @@ ScoreboardCheckStage::exec()
                         curWave->nextInstr()->seqNum(),
                         curWave->nextInstr()->disassemble());
                 toSchedule.markWFReady(curWave, exeResType);
+            } else if (rdyStatus == NRDY_WF_STOP ||
+                       (rdyStatus == NRDY_WAIT_CNT &&
+                        curWave->getStatus() == Wavefront::S_WAITCNT)) {
+                // these only change when the WF wakes itself up
+                park(simdId, wfSlot, rdyStatus);
             }
             collectStatistics(rdyStatus);
         }
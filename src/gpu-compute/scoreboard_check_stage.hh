@@ -80,6 +80,23 @@ class ScoreboardCheckStage
     ~ScoreboardCheckStage();
     void exec();
 
+    /**
+     * Waves that are stopped, or waiting on wait counts that are not
+     * satisfied, cannot become ready until their status or wait counts
+     * change, so they are parked and skipped by exec(). The wavefront
+     * calls this whenever one of those changes so the wave is checked
+     * again.
+     */
+    void
+    wakeWave(int simd_id, int wf_slot)
+    {
+        uint64_t bit = 1ULL << wf_slot;
+        if (!(activeWfs[simd_id] & bit)) {
+            activeWfs[simd_id] |= bit;
+            numParked[parkedStatus[simd_id][wf_slot]]--;
+        }
+    }
+
     // Stats related variables and methods
     const std::string& name() const { return _name; }
 
@@ -88,6 +105,7 @@ class ScoreboardCheckStage
     int mapWaveToExeUnit(Wavefront *w);
     bool ready(Wavefront *w, nonrdytype_e *rdyStatus,
                int *exeResType, int wfSlot);
+    void park(int simd_id, int wf_slot, nonrdytype_e rdyStatus);
     ComputeUnit &computeUnit;
 
     /**
@@ -99,6 +117,13 @@ class ScoreboardCheckStage
 
     const std::string _name;
 
+    // per SIMD, a bit for each WF slot that has to be checked each cycle
+    std::vector<uint64_t> activeWfs;
+    // why each parked WF is not ready
+    std::vector<std::vector<nonrdytype_e>> parkedStatus;
+    // number of parked WFs for each not ready condition
+    std::vector<int> numParked;
+
   protected:
     struct ScoreboardCheckStageStats : public statistics::Group
     {
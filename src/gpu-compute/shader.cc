@@ -56,15 +56,13 @@ namespace gem5
 Shader::Shader(const Params &p) : ClockedObject(p),
     _activeCus(0), _lastInactiveTick(0), cpuThread(nullptr),
     gpuTc(nullptr), cpuPointer(p.cpu_pointer),
-    tickEvent([this]{ execScheduledAdds(); }, "Shader scheduled adds event",
-          false, Event::CPU_Tick_Pri),
     timingSim(p.timing), hsail_mode(SIMT),
     impl_kern_launch_acq(p.impl_kern_launch_acq),
     impl_kern_end_rel(p.impl_kern_end_rel),
     coissue_return(1),
     trace_vgpr_all(1), n_cu((p.CUs).size()), n_wf(p.n_wf),
     globalMemSize(p.globalmem),
-    nextSchedCu(0), sa_n(0), gpuCmdProc(*p.gpu_cmd_proc),
+    nextSchedCu(0), gpuCmdProc(*p.gpu_cmd_proc),
     _dispatcher(*p.dispatcher), systemHub(p.system_hub),
     max_valu_insts(p.max_valu_insts), total_valu_insts(0),
     stats(this, p.CUs[0]->wfSize())
@@ -157,33 +155,6 @@ Shader::updateContext(int cid) {
     assert(gpuTc);
 }
 
-void
-Shader::execScheduledAdds()
-{
-    assert(!sa_when.empty());
-
-    // apply any scheduled adds
-    for (int i = 0; i < sa_n; ++i) {
-        if (sa_when[i] <= curTick()) {
-            *sa_val[i] += sa_x[i];
-            panic_if(*sa_val[i] < 0, "Negative counter value\n");
-            sa_val.erase(sa_val.begin() + i);
-            sa_x.erase(sa_x.begin() + i);
-            sa_when.erase(sa_when.begin() + i);
-            --sa_n;
-            --i;
-        }
-    }
-    if (!sa_when.empty()) {
-        Tick shader_wakeup = *std::max_element(sa_when.begin(),
-                 sa_when.end());
-        DPRINTF(GPUDisp, "Scheduling shader wakeup at %lu\n", shader_wakeup);
-        schedule(tickEvent, shader_wakeup);
-    } else {
-        DPRINTF(GPUDisp, "sa_when empty, shader going to sleep!\n");
-    }
-}
-
 /*
  * dispatcher/shader arranges invalidate requests to the CUs
  */
@@ -207,6 +178,9 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
                                              0, -1);
 
         _dispatcher.updateInvCounter(kernId, +1);
+
+        EventQueue::ScopedMigration migrate(cuList[i_cu]->eventQueue(),
+                                            inParallelMode);
         // all necessary INV flags are all set now, call cu to execute
         cuList[i_cu]->doInvalidate(req, task->dispatchId());
 
@@ -220,6 +194,9 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
  */
 void
 Shader::prepareFlush(GPUDynInstPtr gpuDynInst){
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
+
     int kernId = gpuDynInst->kern_id;
     // flush has never been started, performed only once at kernel end
     assert(_dispatcher.getOutstandingWbs(kernId) == 0);
@@ -228,6 +205,9 @@ Shader::prepareFlush(GPUDynInstPtr gpuDynInst){
     // assuming that L2 cache is shared by all cus in the shader
     int i_cu = 0;
     _dispatcher.updateWbCounter(kernId, +1);
+
+    EventQueue::ScopedMigration migrate_cu(cuList[i_cu]->eventQueue(),
+                                           inParallelMode);
     cuList[i_cu]->doFlush(gpuDynInst);
 }
 
@@ -247,17 +227,33 @@ Shader::dispatchWorkgroups(HSAQueueEntry *task)
         // (a) wg_rem is true - there are unassigned workgroups in the grid
         // (b) there are enough free slots in cu cuList[i] for this wg
         int num_wfs_in_wg = 0;
-        bool can_disp = cuList[curCu]->hasDispResources(task, num_wfs_in_wg);
-        if (!task->dispComplete() && can_disp) {
+        bool dispatched = false;
+        bool woke_cu = false;
+        {
+            // The CU may be simulated on another event queue, so look at
+            // it and hand it the workgroup while holding that queue.
+            EventQueue::ScopedMigration migrate(cuList[curCu]->eventQueue(),
+                                                inParallelMode);
+            bool can_disp =
+                cuList[curCu]->hasDispResources(task, num_wfs_in_wg);
+            if (!task->dispComplete() && can_disp) {
+                DPRINTF(GPUDisp, "Dispatching a workgroup to CU %d: WG %d\n",
+                                curCu, task->globalWgId());
+                DPRINTF(GPUAgentDisp, "Dispatching a workgroup to CU %d: "
+                        "WG %d\n", curCu, task->globalWgId());
+                DPRINTF(GPUWgLatency, "WG Begin cycle:%d wg:%d cu:%d\n",
+                        curTick(), task->globalWgId(), curCu);
+
+                woke_cu = !cuList[curCu]->tickEvent.scheduled();
+                cuList[curCu]->dispWorkgroup(task, num_wfs_in_wg);
+                dispatched = true;
+            }
+        }
+
+        if (dispatched) {
             scheduledSomething = true;
-            DPRINTF(GPUDisp, "Dispatching a workgroup to CU %d: WG %d\n",
-                            curCu, task->globalWgId());
-            DPRINTF(GPUAgentDisp, "Dispatching a workgroup to CU %d: WG %d\n",
-                            curCu, task->globalWgId());
-            DPRINTF(GPUWgLatency, "WG Begin cycle:%d wg:%d cu:%d\n",
-                    curTick(), task->globalWgId(), curCu);
-
-            if (!cuList[curCu]->tickEvent.scheduled()) {
+
+            if (woke_cu) {
                 if (!_activeCus)
                     _lastInactiveTick = curTick();
                 _activeCus++;
@@ -265,7 +261,6 @@ Shader::dispatchWorkgroups(HSAQueueEntry *task)
 
             panic_if(_activeCus <= 0 || _activeCus > cuList.size(),
                      "Invalid activeCu size\n");
-            cuList[curCu]->dispWorkgroup(task, num_wfs_in_wg);
 
             task->markWgDispatch();
             ++disp_count;
@@ -353,25 +348,6 @@ Shader::doFunctionalAccess(const RequestPtr &req, MemCmd cmd, void *data,
     }
 }
 
-void
-Shader::ScheduleAdd(int *val,Tick when,int x)
-{
-    sa_val.push_back(val);
-    when += curTick();
-    sa_when.push_back(when);
-    sa_x.push_back(x);
-    ++sa_n;
-    if (!tickEvent.scheduled() || (when < tickEvent.when())) {
-        DPRINTF(GPUDisp, "New scheduled add; scheduling shader wakeup at "
-                "%lu\n", when);
-        reschedule(tickEvent, when, true);
-    } else {
-        assert(tickEvent.scheduled());
-        DPRINTF(GPUDisp, "New scheduled add; wakeup already scheduled at "
-                "%lu\n", when);
-    }
-}
-
 void
 Shader::AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
                   MemCmd cmd, bool suppress_func_errors)
@@ -450,6 +426,8 @@ Shader::functionalTLBAccess(PacketPtr pkt, int cu_id, BaseMMU::Mode mode)
 void
 Shader::sampleStore(const Tick accessTime)
 {
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
     stats.storeLatencyDist.sample(accessTime);
     stats.allLatencyDist.sample(accessTime);
 }
@@ -460,15 +438,19 @@ Shader::sampleStore(const Tick accessTime)
 void
 Shader::sampleLoad(const Tick accessTime)
 {
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
     stats.loadLatencyDist.sample(accessTime);
     stats.allLatencyDist.sample(accessTime);
 }
 
 void
-Shader::sampleInstRoundTrip(std::vector<Tick> roundTripTime)
+Shader::sampleInstRoundTrip(const Tick *roundTripTime, int numHops)
 {
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
     // Only sample instructions that go all the way to main memory
-    if (roundTripTime.size() != InstMemoryHop::InstMemoryHopMax) {
+    if (numHops != InstMemoryHop::InstMemoryHopMax) {
         return;
     }
 
@@ -487,6 +469,8 @@ Shader::sampleInstRoundTrip(std::vector<Tick> roundTripTime)
 void
 Shader::sampleLineRoundTrip(const std::map<Addr, std::vector<Tick>>& lineMap)
 {
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
     stats.coalsrLineAddresses.sample(lineMap.size());
     std::vector<Tick> netTimes;
 
@@ -515,6 +499,8 @@ Shader::sampleLineRoundTrip(const std::map<Addr, std::vector<Tick>>& lineMap)
 
 void
 Shader::notifyCuSleep() {
+    // may be called by compute units on other event queues
+    EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
     // If all CUs attached to his shader are asleep, update shaderActiveTicks
     panic_if(_activeCus <= 0 || _activeCus > cuList.size(),
              "Invalid activeCu size\n");
@@ -32,6 +32,7 @@
 #ifndef __SHADER_HH__
 #define __SHADER_HH__
 
+#include <atomic>
 #include <functional>
 #include <string>
 
@@ -54,6 +55,7 @@
 #include "mem/request.hh"
 #include "params/Shader.hh"
 #include "sim/faults.hh"
+#include "sim/eventq.hh"
 #include "sim/process.hh"
 #include "sim/sim_object.hh"
 
@@ -101,7 +103,7 @@ class Shader : public ClockedObject
     GPUDispatcher &dispatcher();
     void sampleLoad(const Tick accessTime);
     void sampleStore(const Tick accessTime);
-    void sampleInstRoundTrip(std::vector<Tick> roundTripTime);
+    void sampleInstRoundTrip(const Tick *roundTripTime, int numHops);
     void sampleLineRoundTrip(const std::map<Addr,
         std::vector<Tick>> &roundTripTime);
 
@@ -186,8 +188,6 @@ class Shader : public ClockedObject
 
     RequestorID vramRequestorId();
 
-    EventFunctionWrapper tickEvent;
-
     // is this simulation going to be timing mode in the memory?
     bool timingSim;
     hsail_mode_e hsail_mode;
@@ -211,16 +211,6 @@ class Shader : public ClockedObject
     // Tracks CU that rr dispatcher should attempt scheduling
     int nextSchedCu;
 
-    // Size of scheduled add queue
-    uint32_t sa_n;
-
-    // Pointer to value to be increments
-    std::vector<int*> sa_val;
-    // When to do the increment
-    std::vector<uint64_t> sa_when;
-    // Amount to increment by
-    std::vector<int32_t> sa_x;
-
     // List of Compute Units (CU's)
     std::vector<ComputeUnit*> cuList;
 
@@ -229,17 +219,13 @@ class Shader : public ClockedObject
     AMDGPUSystemHub *systemHub;
 
     int64_t max_valu_insts;
-    int64_t total_valu_insts;
+    // counted by all compute units, which may be on other event queues
+    std::atomic<int64_t> total_valu_insts;
 
     Shader(const Params &p);
     ~Shader();
     virtual void init();
 
-    // Run shader scheduled adds
-    void execScheduledAdds();
-
-    // Schedule a 32-bit value to be incremented some time in the future
-    void ScheduleAdd(int *val, Tick when, int x);
     bool processTimingPacket(PacketPtr pkt);
 
     void AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
@@ -276,12 +262,14 @@ class Shader : public ClockedObject
     void
     incVectorInstSrcOperand(int num_operands)
     {
+        EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
         stats.vectorInstSrcOperand[num_operands]++;
     }
 
     void
     incVectorInstDstOperand(int num_operands)
     {
+        EventQueue::ScopedMigration migrate(eventQueue(), inParallelMode);
         stats.vectorInstDstOperand[num_operands]++;
     }
 
@@ -549,6 +549,13 @@ Wavefront::setStatus(status_e newStatus)
         }
     }
     status = newStatus;
+    wakeReadyCheck();
+}
+
+void
+Wavefront::wakeReadyCheck()
+{
+    computeUnit->scoreboardCheckStage.wakeWave(simdId, wfSlotId);
 }
 
 void
@@ -558,6 +565,7 @@ Wavefront::start(uint64_t _wf_dyn_id, Addr init_pc)
     _pc = init_pc;
 
     status = S_RUNNING;
+    wakeReadyCheck();
 
     vecReads.resize(maxVgprs, 0);
 }
@@ -1307,6 +1315,8 @@ Wavefront::setWaitCnts(int vm_wait_cnt, int exp_wait_cnt, int lgkm_wait_cnt)
 
     if (lgkm_wait_cnt != 0x1f)
         lgkmWaitCnt = lgkm_wait_cnt;
+
+    wakeReadyCheck();
 }
 
 void
@@ -1321,6 +1331,7 @@ Wavefront::clearWaitCnts()
 
     // resume running normally
     status = S_RUNNING;
+    wakeReadyCheck();
 }
 
 void
@@ -1345,18 +1356,21 @@ void
 Wavefront::decVMemInstsIssued()
 {
     --vmemInstsIssued;
+    wakeReadyCheck();
 }
 
 void
 Wavefront::decExpInstsIssued()
 {
     --expInstsIssued;
+    wakeReadyCheck();
 }
 
 void
 Wavefront::decLGKMInstsIssued()
 {
     --lgkmInstsIssued;
+    wakeReadyCheck();
 }
 
 Addr
@@ -1371,18 +1385,6 @@ Wavefront::pc(Addr new_pc)
     _pc = new_pc;
 }
 
-VectorMask&
-Wavefront::execMask()
-{
-    return _execMask;
-}
-
-bool
-Wavefront::execMask(int lane) const
-{
-    return _execMask[lane];
-}
-
 void
 Wavefront::freeRegisterFile()
 {
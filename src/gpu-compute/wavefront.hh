@@ -135,6 +135,8 @@ class Wavefront : public SimObject
     GPUDynInstPtr nextInstr();
     void setStatus(status_e newStatus);
     status_e getStatus() { return status; }
+    // have the scoreboard check this WF again
+    void wakeReadyCheck();
     void resizeRegFiles(int num_vregs, int num_sregs);
     bool isGmInstruction(GPUDynInstPtr ii);
     bool isLmInstruction(GPUDynInstPtr ii);
@@ -262,8 +264,10 @@ class Wavefront : public SimObject
     Addr pc() const;
     void pc(Addr new_pc);
 
-    VectorMask& execMask();
-    bool execMask(int lane) const;
+    // Inline, as the lane loops of every vector instruction test the
+    // mask and we want them to stay free of calls.
+    VectorMask& execMask() { return _execMask; }
+    bool execMask(int lane) const { return _execMask[lane]; }
 
 
     void discardFetch();
@@ -104,3 +104,16 @@ class CommMonitor(SimObject):
     read_addr_mask = Param.Addr(MaxAddr, "Address mask for read address")
     write_addr_mask = Param.Addr(MaxAddr, "Address mask for write address")
     disable_addr_dists = Param.Bool(True, "Disable address distributions")
+
+    # Only sample the histograms and distributions for part of the
+    # requests: every sample_one_in'th request, and only those in the
+    # first sample_window of every sample period. The transaction,
+    # byte and outstanding request counts still see every packet.
+    sample_one_in = Param.Unsigned(1, "Sample one in this many requests")
+    sample_window = Param.Latency('0ns', "Part of each sample period "
+                                  "requests are sampled in, 0 for all")
+
+    # Write the bandwidth and the mean latency of every sample period
+    # to a file, as they are measured
+    epoch_file = Param.String("", "File the per sample period bandwidth "
+                              "and latency are written to, empty for none")
@@ -0,0 +1,52 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+# A bridge whose memory side runs on another event queue, so that
+# independent responders (e.g., memory channels) can be simulated by
+# their own thread. The bridge itself, and thus its CPU side, uses the
+# event queue given by eventq_index.
+class CrossQueueBridge(SimObject):
+    type = 'CrossQueueBridge'
+    cxx_header = "mem/cross_queue_bridge.hh"
+    cxx_class = 'gem5::CrossQueueBridge'
+
+    mem_side_port = RequestPort("This port sends requests and "
+                                "receives responses")
+    cpu_side_port = ResponsePort("This port receives requests and "
+                                 "sends responses")
+
+    mem_side_eventq_index = Param.UInt32(Self.eventq_index,
+        "Event queue of the memory side")
+
+    # Must be at least sim_quantum when the two sides are on
+    # different event queues.
+    delay = Param.Latency('0ns', "The latency of this bridge")
+    buffer_size = Param.Unsigned(64,
+        "The number of requests in flight through the bridge")
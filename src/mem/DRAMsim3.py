@@ -51,3 +51,11 @@ class DRAMsim3(AbstractMemory):
                               "The configuration file to use with DRAMSim3")
     filePath = Param.String("ext/dramsim3/DRAMsim3/",
                             "Directory to prepend to file names")
+
+    # DRAMsim3 is not ticked while it has nothing outstanding. When a
+    # request arrives, the model is ticked for the cycles it missed, up to
+    # this bound, so that refresh and power state are roughly where they
+    # would have been. Beyond the bound, the idle time is skipped.
+    idleCatchUpCycles = Param.Unsigned(65536, "Maximum number of missed "
+                                       "cycles DRAMsim3 is ticked for when "
+                                       "a request ends an idle period")
@@ -42,6 +42,11 @@ class MemChecker(SimObject):
     cxx_header = "mem/mem_checker.hh"
     cxx_class = 'gem5::MemChecker'
 
+    max_history = Param.Unsigned(64, "Maximum number of read observations "
+        "and write clusters kept per tracked range, older history is "
+        "dropped and the range accepts any value until written again "
+        "(0 = unbounded)")
+
 class MemCheckerMonitor(SimObject):
     type = 'MemCheckerMonitor'
     cxx_header = "mem/mem_checker_monitor.hh"
@@ -41,6 +41,9 @@
 from m5.params import *
 from m5.proxy import *
 from m5.objects.QoSMemCtrl import *
+from m5.objects.Compressors import BaseCacheCompressor
+from m5.objects.IndexingPolicies import *
+from m5.objects.ReplacementPolicies import *
 
 # Enum for memory scheduling algorithms, currently First-Come
 # First-Served and a First-Row Hit then First-Come First-Served
@@ -93,3 +96,22 @@ class MemCtrl(QoSMemCtrl):
     static_backend_latency = Param.Latency("10ns", "Static backend latency")
 
     command_window = Param.Latency("10ns", "Static backend latency")
+
+    # Lines written as a whole are compressed, and stored in as few
+    # bursts as their compressed size needs. A read only fetches those
+    # bursts if the compressed size is in the metadata cache; on a miss
+    # it fetches the whole line, the metadata being kept with the data.
+    # Compressors that need a cache, such as FrequentValuesCompressor,
+    # cannot be used here.
+    compressor = Param.BaseCacheCompressor(NULL,
+        "Compressor of the lines stored in memory")
+    comp_metadata_entries = Param.MemorySize("4096",
+        "Number of lines the compression metadata cache keeps track of")
+    comp_metadata_assoc = Param.Unsigned(8,
+        "Associativity of the compression metadata cache")
+    comp_metadata_indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(entry_size = 1, assoc = Parent.comp_metadata_assoc,
+        size = Parent.comp_metadata_entries),
+        "Indexing policy of the compression metadata cache")
+    comp_metadata_replacement_policy = Param.BaseReplacementPolicy(LRURP(),
+        "Replacement policy of the compression metadata cache")
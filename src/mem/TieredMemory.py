@@ -0,0 +1,76 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+# A two-tier memory that presents a single address range on its CPU
+# side and places every page of it in either the near memory (e.g.,
+# local DRAM) or the far memory (e.g., a CXL-attached expander). Pages
+# start out identity mapped, near first, and hot far pages found by
+# sampling the accesses are swapped with cold near pages while the
+# simulation runs. The far side is reached over a link with its own
+# latency and bandwidth.
+class TieredMemory(SimObject):
+    type = 'TieredMemory'
+    cxx_header = "mem/tiered_memory.hh"
+    cxx_class = 'gem5::TieredMemory'
+
+    cpu_side_port = ResponsePort("This port receives requests and "
+                                 "sends responses")
+    near_side_port = RequestPort("This port sends requests to the near "
+                                 "memory and receives responses")
+    far_side_port = RequestPort("This port sends requests to the far "
+                                "memory and receives responses")
+
+    system = Param.System(Parent.any, "System the memory belongs to")
+
+    # The size of range must be the sum of the sizes of near_range
+    # and far_range, which are the ranges of the memories behind the
+    # near and far side ports.
+    range = Param.AddrRange("Address range seen by the CPU side")
+    near_range = Param.AddrRange("Address range of the near memory")
+    far_range = Param.AddrRange("Address range of the far memory")
+    page_size = Param.MemorySize('4KiB', "Granularity of page placement")
+
+    far_latency = Param.Latency('70ns', "One-way latency of the far link")
+    far_bandwidth = Param.MemoryBandwidth('32GiB/s',
+        "Bandwidth of the far link in each direction")
+
+    buffer_size = Param.Unsigned(64,
+        "The number of requests in flight through the tiers")
+
+    sample_interval = Param.Unsigned(16,
+        "Sample one in this many accesses for the page heat")
+    hot_threshold = Param.Unsigned(4,
+        "Sampled accesses in the last epoch that make a far page hot")
+    migration_interval = Param.Latency('10us',
+        "Epoch length, at most one migration is started per epoch")
+    migration_block_size = Param.Unsigned(64,
+        "Size of the reads and writes that copy a page")
+    migration_max_outstanding = Param.Unsigned(16,
+        "Copy reads and writes a migration can have in flight")
@@ -46,6 +46,9 @@
 #ifndef __MEM_ABSTRACT_MEMORY_HH__
 #define __MEM_ABSTRACT_MEMORY_HH__
 
+#include <algorithm>
+#include <vector>
+
 #include "mem/backdoor.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
@@ -131,6 +134,28 @@ class AbstractMemory : public ClockedObject
 
     std::list<LockedAddr> lockedAddrList;
 
+    //! Pages written since the dirty state was last cleared, used for
+    //! delta checkpoints. Indexed by offset into the backing store.
+    std::vector<bool> dirtyPages;
+
+    //! Set when a backdoor was handed out, as writes through it can't be
+    //! tracked. All pages are then considered dirty until the backdoor
+    //! is invalidated and the dirty state cleared.
+    bool backdoorDirty = false;
+    bool backdoorHandedOut = false;
+
+    void
+    markDirty(Addr addr, Addr size)
+    {
+        if (dirtyPages.empty() || size == 0)
+            return;
+        const Addr offset = addr - range.start();
+        for (Addr page = offset / DirtyPageBytes;
+             page <= (offset + size - 1) / DirtyPageBytes; page++) {
+            dirtyPages[page] = true;
+        }
+    }
+
     // helper function for checkLockedAddrs(): we really want to
     // inline a quick check for an empty locked addr list (hopefully
     // the common case), and do the full list search (if necessary) in
@@ -211,6 +236,9 @@ class AbstractMemory : public ClockedObject
 
   public:
 
+    //! Granularity of the dirty page tracking.
+    static constexpr Addr DirtyPageBytes = 4096;
+
     PARAMS(AbstractMemory);
 
     AbstractMemory(const Params &p);
@@ -237,8 +265,74 @@ class AbstractMemory : public ClockedObject
     void
     getBackdoor(MemBackdoorPtr &bd_ptr)
     {
-        if (lockedAddrList.empty() && backdoor.ptr())
+        if (lockedAddrList.empty() && backdoor.ptr()) {
             bd_ptr = &backdoor;
+            backdoorDirty = backdoorHandedOut = true;
+        }
+    }
+
+    /**
+     * Revoke the back door, if it has been handed out, so that its holders
+     * go through the ports again.
+     */
+    void
+    invalidateBackdoor()
+    {
+        if (backdoorHandedOut) {
+            backdoor.invalidate();
+            backdoorHandedOut = false;
+        }
+    }
+
+    /**
+     * Get direct host access to a range of this memory for users that
+     * read or write it outside of the memory system, e.g. emulated system
+     * calls. Writes through the pointer are accounted for in the dirty
+     * page tracking, but not in the statistics.
+     *
+     * @param addr Start address of the range.
+     * @param size Size of the range in bytes.
+     * @param write Whether the range is going to be written.
+     * @return Pointer to the host memory, or nullptr if the range can't
+     *         be accessed directly.
+     */
+    uint8_t *
+    hostRange(Addr addr, Addr size, bool write)
+    {
+        if (!pmemAddr || range.interleaved() ||
+            !AddrRange(addr, addr + size).isSubset(range))
+            return nullptr;
+        if (write) {
+            // A store the monitors don't see would break LL/SC
+            if (!lockedAddrList.empty())
+                return nullptr;
+            markDirty(addr, size);
+        }
+        return toHostAddr(addr);
+    }
+
+    /**
+     * Check if a page of the backing store may have been written since
+     * the last call to clearDirty().
+     *
+     * @param page Page index, relative to the start of the memory.
+     */
+    bool
+    isPageDirty(Addr page) const
+    {
+        return backdoorDirty || page >= dirtyPages.size() ||
+            dirtyPages[page];
+    }
+
+    /**
+     * Forget about past writes, e.g., once the memory contents have
+     * been checkpointed.
+     */
+    void
+    clearDirty()
+    {
+        std::fill(dirtyPages.begin(), dirtyPages.end(), false);
+        backdoorDirty = backdoorHandedOut;
     }
 
     /**
@@ -257,6 +351,7 @@ class AbstractMemory : public ClockedObject
     addLockedAddr(LockedAddr addr)
     {
         backdoor.invalidate();
+        backdoorHandedOut = false;
         lockedAddrList.push_back(addr);
     }
 
@@ -126,6 +126,32 @@ class MemBackdoor
 
 typedef MemBackdoor *MemBackdoorPtr;
 
+/**
+ * A request for a back door which is not tied to a packet, and can hence
+ * be made in any memory mode. The requestor becomes responsible for
+ * modelling the latency of the accesses it performs through the back door.
+ */
+class MemBackdoorReq
+{
+  public:
+    MemBackdoorReq(AddrRange r, MemBackdoor::Flags new_flags) :
+        _range(r), _flags(new_flags)
+    {}
+
+    // The range in the guest address space a back door is wanted for.
+    const AddrRange &range() const { return _range; }
+
+    bool readable() const { return _flags & MemBackdoor::Readable; }
+    bool writeable() const { return _flags & MemBackdoor::Writeable; }
+
+    MemBackdoor::Flags flags() const { return _flags; }
+
+  private:
+    const AddrRange _range;
+    const MemBackdoor::Flags _flags;
+};
+
+
 } // namespace gem5
 
 #endif  //__MEM_BACKDOOR_HH__
@@ -134,6 +134,21 @@ class BaseCache(ClockedObject):
     # cache.
     writeback_clean = Param.Bool(False, "Writeback clean lines")
 
+    # CleanEvicts only serve to keep the snoop filters below this
+    # cache up to date. A cache with no snoop filter below it, e.g.
+    # one connected straight to a memory controller, does not need to
+    # create them at all.
+    send_clean_evicts = Param.Bool(True, "Send clean evicts for clean "
+        "lines that are not written back")
+
+    # Writebacks of adjacent lines waiting together in the write
+    # buffer can be merged into a single larger write. Each write then
+    # covers several lines, so this should only be used when the
+    # memory side is a memory controller, and not a coherent crossbar
+    # or cache tracking individual lines.
+    write_coalescing = Param.Unsigned(1, "Max number of adjacent line "
+        "writebacks merged into one write (1 means no merging)")
+
     # Control whether this cache should be mostly inclusive or mostly
     # exclusive with respect to upstream caches. The behaviour on a
     # fill is determined accordingly. For a mostly inclusive cache,
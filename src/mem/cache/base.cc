@@ -45,6 +45,8 @@
 
 #include "mem/cache/base.hh"
 
+#include <cstring>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "debug/Cache.hh"
@@ -87,6 +89,8 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       prefetcher(p.prefetcher),
       writeAllocator(p.write_allocator),
       writebackClean(p.writeback_clean),
+      sendCleanEvicts(p.send_clean_evicts),
+      writeCoalescing(p.write_coalescing),
       tempBlockWriteback(nullptr),
       writebackTempBlockAtomicEvent([this]{ writebackTempBlockAtomic(); },
                                     name(), false,
@@ -245,7 +249,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -347,7 +351,7 @@ BaseCache::handleTimingReqMiss(PacketPtr pkt, MSHR *mshr, CacheBlk *blk,
                 // port and also takes into account the additional
                 // delay of the xbar.
                 mshr->allocateTarget(pkt, forward_time, order++,
-                                     allocOnFill(pkt->cmd));
+                                     allocOnFill(pkt));
                 if (mshr->getNumTargets() >= numTarget) {
                     noTargetMSHR = mshr;
                     setBlocked(Blocked_NoTargets);
@@ -1022,7 +1026,8 @@ BaseCache::updateCompressionData(CacheBlk *&blk, const uint64_t* data,
         CacheBlk *victim = nullptr;
         if (replaceExpansions || is_data_contraction) {
             victim = tags->findVictim(regenerateBlkAddr(blk),
-                blk->isSecure(), compression_size, evict_blks);
+                blk->isSecure(), compression_size, evict_blks,
+                blk->getSrcRequestorId());
 
             // It is valid to return nullptr if there is no victim
             if (!victim) {
@@ -1631,7 +1636,8 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     // Find replacement victim
     std::vector<CacheBlk*> evict_blks;
     CacheBlk *victim = tags->findVictim(addr, is_secure, blk_size_bits,
-                                        evict_blks);
+                                        evict_blks,
+                                        pkt->req->requestorId());
 
     // It is valid to return nullptr if there is no victim
     if (!victim)
@@ -1697,7 +1703,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1740,7 +1746,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1814,7 +1820,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -1972,6 +1978,11 @@ BaseCache::sendWriteQueuePacket(WriteQueueEntry* wq_entry)
     // always a single target for write queue entries
     PacketPtr tgt_pkt = wq_entry->getTarget()->pkt;
 
+    std::vector<WriteQueueEntry*> merged;
+    if (writeCoalescing > 1 && tgt_pkt->cmd == MemCmd::WritebackDirty) {
+        tgt_pkt = coalesceWritebacks(wq_entry, merged);
+    }
+
     DPRINTF(Cache, "%s: write %s\n", __func__, tgt_pkt->print());
 
     // forward as is, both for evictions and uncacheable writes
@@ -1980,14 +1991,85 @@ BaseCache::sendWriteQueuePacket(WriteQueueEntry* wq_entry)
         // schedSendEvent (we will wait for a retry before
         // doing anything), and this is so even if we do not
         // care about this packet and might override it before
-        // it gets retried
+        // it gets retried. A merged write is simply built
+        // again on the retry.
+        if (!merged.empty()) {
+            delete tgt_pkt;
+        }
         return true;
-    } else {
+    } else if (merged.empty()) {
         markInService(wq_entry);
         return false;
+    } else {
+        // The merged write replaces the writebacks of all the entries
+        stats.coalescedWrites++;
+        stats.coalescedWritebacks += merged.size();
+        for (auto entry : merged) {
+            delete entry->getTarget()->pkt;
+            markInService(entry);
+        }
+        return false;
     }
 }
 
+PacketPtr
+BaseCache::coalesceWritebacks(WriteQueueEntry *wq_entry,
+                              std::vector<WriteQueueEntry*> &merged)
+{
+    PacketPtr tgt_pkt = wq_entry->getTarget()->pkt;
+    const bool is_secure = wq_entry->isSecure;
+    const Addr group_size = writeCoalescing * blkSize;
+    const Addr group_start = roundDown(wq_entry->blkAddr, group_size);
+    const Addr group_end = group_start + group_size;
+
+    // A line can join the write if its writeback is waiting and ready,
+    // and no earlier miss to it is pending
+    auto mergeable = [&](Addr blk_addr) -> WriteQueueEntry* {
+        WriteQueueEntry *entry = writeBuffer.findMatch(blk_addr, is_secure);
+        if (!entry || entry->inService ||
+            entry->getTarget()->readyTime > curTick() ||
+            entry->getTarget()->pkt->cmd != MemCmd::WritebackDirty ||
+            mshrQueue.findPending(entry)) {
+            return nullptr;
+        }
+        return entry;
+    };
+
+    // Grow the run of adjacent lines in both directions
+    Addr start = wq_entry->blkAddr;
+    while (start > group_start && mergeable(start - blkSize)) {
+        start -= blkSize;
+    }
+    Addr end = wq_entry->blkAddr + blkSize;
+    while (end < group_end && mergeable(end)) {
+        end += blkSize;
+    }
+
+    if (end - start == blkSize) {
+        return tgt_pkt;
+    }
+
+    RequestPtr req = Request::create(start, end - start,
+        tgt_pkt->req->getFlags(), tgt_pkt->req->requestorId());
+    req->taskId(tgt_pkt->req->taskId());
+    PacketPtr pkt = new Packet(req, MemCmd::WritebackDirty);
+    pkt->allocate();
+
+    for (Addr addr = start; addr < end; addr += blkSize) {
+        WriteQueueEntry *entry = addr == wq_entry->blkAddr ?
+            wq_entry : mergeable(addr);
+        assert(entry);
+        std::memcpy(pkt->getPtr<uint8_t>() + (addr - start),
+                    entry->getTarget()->pkt->getConstPtr<uint8_t>(),
+                    blkSize);
+        merged.push_back(entry);
+    }
+
+    DPRINTF(Cache, "Merged %d writebacks into %s\n", merged.size(),
+            pkt->print());
+    return pkt;
+}
+
 void
 BaseCache::serialize(CheckpointOut &cp) const
 {
@@ -2271,6 +2353,12 @@ BaseCache::CacheStats::CacheStats(BaseCache &c)
              "number of data expansions"),
     ADD_STAT(dataContractions, statistics::units::Count::get(),
              "number of data contractions"),
+    ADD_STAT(bypassedFills, statistics::units::Count::get(),
+             "number of fills not allocated as predicted dead"),
+    ADD_STAT(coalescedWritebacks, statistics::units::Count::get(),
+             "number of writebacks merged into a larger write"),
+    ADD_STAT(coalescedWrites, statistics::units::Count::get(),
+             "number of merged writes sent"),
     cmd(MemCmd::NUM_MEM_CMDS)
 {
     for (int idx = 0; idx < MemCmd::NUM_MEM_CMDS; ++idx)
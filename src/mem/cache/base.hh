@@ -58,6 +58,7 @@
 #include "debug/Cache.hh"
 #include "debug/CachePort.hh"
 #include "enums/Clusivity.hh"
+#include "mem/cache/cache_accessor.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/cache/compressors/base.hh"
 #include "mem/cache/mshr_queue.hh"
@@ -92,7 +93,7 @@ struct BaseCacheParams;
 /**
  * A basic cache interface. Implements some common functions for speed.
  */
-class BaseCache : public ClockedObject
+class BaseCache : public ClockedObject, public CacheAccessor
 {
   protected:
     /**
@@ -448,6 +449,28 @@ class BaseCache : public ClockedObject
             cmd.isLLSC();
     }
 
+    /**
+     * Determine whether we should allocate on a fill for the given
+     * miss. On top of the clusivity based decision above, the tags'
+     * replacement policy may predict that the block will not be reused
+     * and decline to allocate it.
+     *
+     * @param pkt The incoming requesting packet
+     * @return Whether we should allocate on the fill
+     */
+    bool
+    allocOnFill(const PacketPtr pkt)
+    {
+        if (!allocOnFill(pkt->cmd)) {
+            return false;
+        }
+        if (!pkt->isLLSC() && tags->bypassFill(pkt)) {
+            stats.bypassedFills++;
+            return false;
+        }
+        return true;
+    }
+
     /**
      * Regenerate block address using tags.
      * Block address regeneration depends on whether we're using a temporary
@@ -674,6 +697,21 @@ class BaseCache : public ClockedObject
      */
     const bool writebackClean;
 
+    /**
+     * Determine if clean lines that are not written back should be
+     * announced with a CleanEvict. These only matter to the snoop
+     * filters below, so they can be dropped before being created if
+     * there are none.
+     */
+    const bool sendCleanEvicts;
+
+    /**
+     * Max number of writebacks of adjacent lines that can be merged
+     * into a single write when sent. Merging is only attempted if it
+     * is larger than one.
+     */
+    const unsigned writeCoalescing;
+
     /**
      * Writebacks from the tempBlock, resulting on the response path
      * in atomic mode, must happen after the call to recvAtomic has
@@ -1142,6 +1180,18 @@ class BaseCache : public ClockedObject
          */
         statistics::Scalar dataContractions;
 
+        /**
+         * Number of misses whose fill the replacement policy chose not
+         * to allocate.
+         */
+        statistics::Scalar bypassedFills;
+
+        /** Number of writebacks sent merged into a larger write. */
+        statistics::Scalar coalescedWritebacks;
+
+        /** Number of merged writes sent. */
+        statistics::Scalar coalescedWrites;
+
         /** Per-command statistics */
         std::vector<std::unique_ptr<CacheCmdStats>> cmd;
     } stats;
@@ -1174,7 +1224,7 @@ class BaseCache : public ClockedObject
     {
         MSHR *mshr = mshrQueue.allocate(pkt->getBlockAddr(blkSize), blkSize,
                                         pkt, time, order++,
-                                        allocOnFill(pkt->cmd));
+                                        allocOnFill(pkt));
 
         if (mshrQueue.isFull()) {
             setBlocked((BlockedCause)MSHRQueue_MSHRs);
@@ -1276,11 +1326,11 @@ class BaseCache : public ClockedObject
         memSidePort.schedSendEvent(time);
     }
 
-    bool inCache(Addr addr, bool is_secure) const {
+    bool inCache(Addr addr, bool is_secure) const override {
         return tags->findBlock(addr, is_secure);
     }
 
-    bool hasBeenPrefetched(Addr addr, bool is_secure) const {
+    bool hasBeenPrefetched(Addr addr, bool is_secure) const override {
         CacheBlk *block = tags->findBlock(addr, is_secure);
         if (block) {
             return block->wasPrefetched();
@@ -1289,7 +1339,7 @@ class BaseCache : public ClockedObject
         }
     }
 
-    bool inMissQueue(Addr addr, bool is_secure) const {
+    bool inMissQueue(Addr addr, bool is_secure) const override {
         return mshrQueue.findMatch(addr, is_secure);
     }
 
@@ -1315,7 +1365,7 @@ class BaseCache : public ClockedObject
      *
      * @return True if the cache is coalescing writes
      */
-    bool coalesce() const;
+    bool coalesce() const override;
 
 
     /**
@@ -1351,6 +1401,19 @@ class BaseCache : public ClockedObject
      */
     bool sendWriteQueuePacket(WriteQueueEntry* wq_entry);
 
+    /**
+     * Merge the writeback of a write-queue entry with the writebacks of
+     * adjacent lines that are ready in the write buffer. Only lines in
+     * the same aligned group of writeCoalescing lines are merged.
+     *
+     * @param wq_entry The write-queue entry being sent.
+     * @param merged Filled with the merged entries, in address order.
+     * @return The merged writeback, or the entry's own packet if no
+     *         other entry could be merged.
+     */
+    PacketPtr coalesceWritebacks(WriteQueueEntry *wq_entry,
+                                 std::vector<WriteQueueEntry*> &merged);
+
     /**
      * Serialize the state of the caches
      *
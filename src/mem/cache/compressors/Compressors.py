@@ -37,6 +37,10 @@ class BaseCacheCompressor(SimObject):
     cxx_class = 'gem5::compression::Base'
     cxx_header = "mem/cache/compressors/base.hh"
 
+    cxx_exports = [
+        PyBindMethod("compressDump"),
+    ]
+
     block_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
     chunk_size_bits = Param.Unsigned(32,
         "Size of a parsing data chunk (in bits)")
@@ -36,8 +36,11 @@
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
@@ -114,53 +117,73 @@ Base::setCache(BaseCache *_cache)
 std::vector<Base::Chunk>
 Base::toChunks(const uint64_t* data) const
 {
-    // Number of chunks in a 64-bit value
-    const unsigned num_chunks_per_64 =
-        (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
+    std::vector<Chunk> chunks;
+    toChunks(data, chunks);
+    return chunks;
+}
 
-    // Turn a 64-bit array into a chunkSizeBits-array
-    std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits, 0);
-    for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
-        const unsigned start = i % num_chunks_per_64;
-        chunks[i] = bits(data[index_64],
-            (start + 1) * chunkSizeBits - 1, start * chunkSizeBits);
+void
+Base::toChunks(const uint64_t* data, std::vector<Chunk>& chunks) const
+{
+    const std::size_t num_64 = blkSize / sizeof(uint64_t);
+    chunks.resize((blkSize * CHAR_BIT) / chunkSizeBits);
+
+    // Most compressors parse the line at its natural 64-bit granularity
+    if (chunkSizeBits == sizeof(uint64_t) * CHAR_BIT) {
+        std::copy(data, data + num_64, chunks.begin());
+        return;
     }
 
-    return chunks;
+    // Turn a 64-bit array into a chunkSizeBits-array. The chunk size is a
+    // power of two, so a word is split with plain shifts and masks, which
+    // keeps the inner loop free of divisions and branches
+    const unsigned num_chunks_per_64 =
+        (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
+    const uint64_t chunk_mask = mask(chunkSizeBits);
+    for (std::size_t i = 0; i < num_64; i++) {
+        Chunk* dest = &chunks[i * num_chunks_per_64];
+        for (unsigned j = 0; j < num_chunks_per_64; j++) {
+            dest[j] = (data[i] >> (j * chunkSizeBits)) & chunk_mask;
+        }
+    }
 }
 
 void
 Base::fromChunks(const std::vector<Chunk>& chunks, uint64_t* data) const
 {
-    // Number of chunks in a 64-bit value
-    const unsigned num_chunks_per_64 =
-        (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
+    const std::size_t num_64 = blkSize / sizeof(uint64_t);
+    assert(chunks.size() == (blkSize * CHAR_BIT) / chunkSizeBits);
+
+    if (chunkSizeBits == sizeof(uint64_t) * CHAR_BIT) {
+        std::copy(chunks.begin(), chunks.end(), data);
+        return;
+    }
 
     // Turn a chunkSizeBits-array into a 64-bit array
-    std::memset(data, 0, blkSize);
-    for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
-        const unsigned start = i % num_chunks_per_64;
-        replaceBits(data[index_64], (start + 1) * chunkSizeBits - 1,
-            start * chunkSizeBits, chunks[i]);
+    const unsigned num_chunks_per_64 =
+        (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
+    const uint64_t chunk_mask = mask(chunkSizeBits);
+    for (std::size_t i = 0; i < num_64; i++) {
+        const Chunk* src = &chunks[i * num_chunks_per_64];
+        uint64_t word = 0;
+        for (unsigned j = 0; j < num_chunks_per_64; j++) {
+            word |= (src[j] & chunk_mask) << (j * chunkSizeBits);
+        }
+        data[i] = word;
     }
 }
 
-std::unique_ptr<Base::CompressionData>
-Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
+std::size_t
+Base::finishCompression(CompressionData& comp_data, const uint64_t* data,
+    Cycles comp_lat, Cycles decomp_lat)
 {
-    // Apply compression
-    std::unique_ptr<CompressionData> comp_data =
-        compress(toChunks(data), comp_lat, decomp_lat);
-
     // If we are in debug mode apply decompression just after the compression.
     // If the results do not match, we've got an error
     #ifdef DEBUG_COMPRESSION
     uint64_t decomp_data[blkSize/8];
 
     // Apply decompression
-    decompress(comp_data.get(), decomp_data);
+    decompress(&comp_data, decomp_data);
 
     // Check if decompressed line matches original cache line
     fatal_if(std::memcmp(data, decomp_data, blkSize),
@@ -169,10 +192,10 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
 
     // Get compression size. If compressed size is greater than the size
     // threshold, the compression is seen as unsuccessful
-    std::size_t comp_size_bits = comp_data->getSizeBits();
+    std::size_t comp_size_bits = comp_data.getSizeBits();
     if (comp_size_bits > sizeThreshold * CHAR_BIT) {
         comp_size_bits = blkSize * CHAR_BIT;
-        comp_data->setSizeBits(comp_size_bits);
+        comp_data.setSizeBits(comp_size_bits);
         stats.failedCompressions++;
     }
 
@@ -190,9 +213,70 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
             "Compression latency: %llu, decompression latency: %llu\n",
             blkSize*8, comp_size_bits, comp_lat, decomp_lat);
 
+    return comp_size_bits;
+}
+
+std::unique_ptr<Base::CompressionData>
+Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
+{
+    // Apply compression
+    std::unique_ptr<CompressionData> comp_data =
+        compress(toChunks(data), comp_lat, decomp_lat);
+
+    finishCompression(*comp_data, data, comp_lat, decomp_lat);
+
     return comp_data;
 }
 
+void
+Base::compressBatch(const uint64_t* data, std::size_t num_blks,
+    std::size_t* sizes_bits)
+{
+    const std::size_t num_64 = blkSize / sizeof(uint64_t);
+
+    // The chunk buffer is shared by all the lines of the batch
+    std::vector<Chunk> chunks;
+    for (std::size_t i = 0; i < num_blks; i++) {
+        const uint64_t* line = data + i * num_64;
+        toChunks(line, chunks);
+
+        Cycles comp_lat, decomp_lat;
+        std::unique_ptr<CompressionData> comp_data =
+            compress(chunks, comp_lat, decomp_lat);
+        sizes_bits[i] =
+            finishCompression(*comp_data, line, comp_lat, decomp_lat);
+    }
+}
+
+std::map<std::size_t, uint64_t>
+Base::compressDump(const std::string& path)
+{
+    std::ifstream dump(path, std::ios::in | std::ios::binary);
+    fatal_if(!dump, "Could not open memory dump %s.", path);
+
+    // Lines are read and compressed in batches to amortize the I/O
+    const std::size_t batch_blks = 4096;
+    const std::size_t num_64 = blkSize / sizeof(uint64_t);
+    std::vector<uint64_t> lines(batch_blks * num_64);
+    std::vector<std::size_t> sizes_bits(batch_blks);
+
+    std::map<std::size_t, uint64_t> histogram;
+    while (dump) {
+        dump.read(reinterpret_cast<char*>(lines.data()),
+            lines.size() * sizeof(uint64_t));
+        const std::size_t num_blks = dump.gcount() / blkSize;
+        warn_if(dump.gcount() % blkSize,
+            "Ignoring the trailing partial line of memory dump %s.", path);
+
+        compressBatch(lines.data(), num_blks, sizes_bits.data());
+        for (std::size_t i = 0; i < num_blks; i++) {
+            histogram[sizes_bits[i]]++;
+        }
+    }
+
+    return histogram;
+}
+
 Cycles
 Base::getDecompressionLatency(const CacheBlk* blk)
 {
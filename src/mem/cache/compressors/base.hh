@@ -37,6 +37,10 @@
 #define __MEM_CACHE_COMPRESSORS_BASE_HH__
 
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/statistics.hh"
@@ -165,6 +169,15 @@ class Base : public SimObject
      */
     std::vector<Chunk> toChunks(const uint64_t* data) const;
 
+    /**
+     * Same as above, but reuses the given vector instead of allocating a
+     * new one, so that a buffer can be shared by many lines.
+     *
+     * @param data The raw pointer to the data being compressed.
+     * @param chunks Output with the raw data divided into chunks.
+     */
+    void toChunks(const uint64_t* data, std::vector<Chunk>& chunks) const;
+
     /**
      * This function re-joins the chunks to recreate the original data.
      *
@@ -189,6 +202,20 @@ class Base : public SimObject
         const std::vector<Chunk>& chunks, Cycles& comp_lat,
         Cycles& decomp_lat) = 0;
 
+    /**
+     * Apply the size threshold to a freshly compressed line and account
+     * for it in the stats.
+     *
+     * @param comp_data The compression result, which may be marked as
+     *        uncompressed if it does not meet the threshold.
+     * @param data The original cache line.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return The final size of the line, in bits.
+     */
+    std::size_t finishCompression(CompressionData& comp_data,
+        const uint64_t* data, Cycles comp_lat, Cycles decomp_lat);
+
     /**
      * Apply the decompression process to the compressed data.
      *
@@ -206,6 +233,9 @@ class Base : public SimObject
     /** The cache can only be set once. */
     virtual void setCache(BaseCache *_cache);
 
+    /** Uncompressed size of the lines, in bytes. */
+    std::size_t getBlockSize() const { return blkSize; }
+
     /**
      * Apply the compression process to the cache line. Ignores compression
      * cycles.
@@ -218,6 +248,27 @@ class Base : public SimObject
     std::unique_ptr<CompressionData>
     compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat);
 
+    /**
+     * Compress a contiguous array of cache lines, keeping only their
+     * compressed sizes. Stats are updated as if each line had been
+     * compressed individually.
+     *
+     * @param data The cache lines, stored one after another.
+     * @param num_blks The number of lines in data.
+     * @param sizes_bits Output with the compressed size of each line.
+     */
+    void compressBatch(const uint64_t* data, std::size_t num_blks,
+        std::size_t* sizes_bits);
+
+    /**
+     * Compress every line of a raw memory dump. This is meant to evaluate
+     * compressors offline, without simulating a system.
+     *
+     * @param path Path to the dump file.
+     * @return Number of lines compressed to each size, in bits.
+     */
+    std::map<std::size_t, uint64_t> compressDump(const std::string& path);
+
     /**
      * Get the decompression latency if the block is compressed. Latency is 0
      * otherwise.
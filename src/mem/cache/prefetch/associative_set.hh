@@ -29,8 +29,11 @@
 #ifndef __CACHE_PREFETCH_ASSOCIATIVE_SET_HH__
 #define __CACHE_PREFETCH_ASSOCIATIVE_SET_HH__
 
+#include <vector>
+
 #include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
 #include "mem/cache/tags/tagged_entry.hh"
 
 namespace gem5
@@ -61,6 +64,27 @@ class AssociativeSet
     replacement_policy::Base* const replacementPolicy;
     /** Vector containing the entries of the container */
     std::vector<Entry> entries;
+    /**
+     * If the container is indexed by a plain SetAssociative policy, the
+     * ways of each set are contiguous in entries, so lookups can scan
+     * them directly instead of going through the indexing policy. Null
+     * otherwise.
+     */
+    const SetAssociative* flatIndexing;
+    /** Reused buffer holding the result of getPossibleEntries() */
+    mutable std::vector<Entry *> candidates;
+
+    /**
+     * Get the first way of the set of an address in a flat container.
+     * @param addr key element
+     * @return pointer to the first entry of the set
+     */
+    Entry*
+    flatSet(Addr addr) const
+    {
+        return const_cast<Entry*>(entries.data()) +
+            flatIndexing->setIndex(addr) * associativity;
+    }
 
   public:
     /**
@@ -102,9 +126,10 @@ class AssociativeSet
      * Find the set of entries that could be replaced given
      * that we want to add a new entry with the provided key
      * @param addr key to select the set of entries
-     * @result vector of candidates matching with the provided key
+     * @result vector of candidates matching with the provided key. It is
+     *   only valid until the next call.
      */
-    std::vector<Entry *> getPossibleEntries(const Addr addr) const;
+    const std::vector<Entry *> &getPossibleEntries(const Addr addr) const;
 
     /**
      * Indicate that an entry has just been inserted
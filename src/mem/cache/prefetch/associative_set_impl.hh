@@ -29,6 +29,8 @@
 #ifndef __CACHE_PREFETCH_ASSOCIATIVE_SET_IMPL_HH__
 #define __CACHE_PREFETCH_ASSOCIATIVE_SET_IMPL_HH__
 
+#include <typeinfo>
+
 #include "base/intmath.hh"
 #include "mem/cache/prefetch/associative_set.hh"
 
@@ -40,7 +42,8 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
         BaseIndexingPolicy *idx_policy, replacement_policy::Base *rpl_policy,
         Entry const &init_value)
   : associativity(assoc), numEntries(num_entries), indexingPolicy(idx_policy),
-    replacementPolicy(rpl_policy), entries(numEntries, init_value)
+    replacementPolicy(rpl_policy), entries(numEntries, init_value),
+    flatIndexing(nullptr)
 {
     fatal_if(!isPowerOf2(num_entries), "The number of entries of an "
              "AssociativeSet<> must be a power of 2");
@@ -51,6 +54,22 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
         indexingPolicy->setEntry(entry, entry_idx);
         entry->replacementData = replacementPolicy->instantiateEntry();
     }
+
+    // Policies derived from SetAssociative may hash the set differently,
+    // so only the exact type is known to keep the sets contiguous
+    if (typeid(*indexingPolicy) == typeid(SetAssociative)) {
+        bool contiguous = true;
+        for (unsigned int entry_idx = 0; entry_idx < numEntries;
+             entry_idx += 1) {
+            const Entry &entry = entries[entry_idx];
+            contiguous &= (entry.getSet() == entry_idx / associativity) &&
+                (entry.getWay() == entry_idx % associativity);
+        }
+        if (contiguous) {
+            flatIndexing = static_cast<const SetAssociative*>(indexingPolicy);
+        }
+    }
+    candidates.reserve(associativity);
 }
 
 template<class Entry>
@@ -58,7 +77,19 @@ Entry*
 AssociativeSet<Entry>::findEntry(Addr addr, bool is_secure) const
 {
     Addr tag = indexingPolicy->extractTag(addr);
-    const std::vector<ReplaceableEntry*> selected_entries =
+    if (flatIndexing) {
+        Entry* set = flatSet(addr);
+        for (int way = 0; way < associativity; way++) {
+            Entry* entry = &set[way];
+            if ((entry->getTag() == tag) && entry->isValid() &&
+                entry->isSecure() == is_secure) {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    const std::vector<ReplaceableEntry*> &selected_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     for (const auto& location : selected_entries) {
@@ -83,7 +114,7 @@ Entry*
 AssociativeSet<Entry>::findVictim(Addr addr)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> selected_entries =
+    const std::vector<ReplaceableEntry*> &selected_entries =
         indexingPolicy->getPossibleEntries(addr);
     Entry* victim = static_cast<Entry*>(replacementPolicy->getVictim(
                             selected_entries));
@@ -94,18 +125,24 @@ AssociativeSet<Entry>::findVictim(Addr addr)
 
 
 template<class Entry>
-std::vector<Entry *>
+const std::vector<Entry *> &
 AssociativeSet<Entry>::getPossibleEntries(const Addr addr) const
 {
-    std::vector<ReplaceableEntry *> selected_entries =
-        indexingPolicy->getPossibleEntries(addr);
-    std::vector<Entry *> entries(selected_entries.size(), nullptr);
+    candidates.clear();
+    if (flatIndexing) {
+        Entry* set = flatSet(addr);
+        for (int way = 0; way < associativity; way++) {
+            candidates.push_back(&set[way]);
+        }
+        return candidates;
+    }
 
-    unsigned int idx = 0;
+    const std::vector<ReplaceableEntry *> &selected_entries =
+        indexingPolicy->getPossibleEntries(addr);
     for (auto &entry : selected_entries) {
-        entries[idx++] = static_cast<Entry *>(entry);
+        candidates.push_back(static_cast<Entry *>(entry));
     }
-    return entries;
+    return candidates;
 }
 
 template<class Entry>
@@ -94,7 +94,8 @@ Base::PrefetchListener::notify(const PacketPtr &pkt)
 }
 
 Base::Base(const BasePrefetcherParams &p)
-    : ClockedObject(p), listeners(), cache(nullptr), blkSize(p.block_size),
+    : ClockedObject(p), listeners(), cache(nullptr),
+      cacheProbeManager(nullptr), system(p.sys), blkSize(p.block_size),
       lBlkSize(floorLog2(blkSize)), onMiss(p.on_miss), onRead(p.on_read),
       onWrite(p.on_write), onData(p.on_data), onInst(p.on_inst),
       requestorId(p.sys->getRequestorId(this)),
@@ -109,12 +110,21 @@ Base::Base(const BasePrefetcherParams &p)
 
 void
 Base::setCache(BaseCache *_cache)
+{
+    setParentInfo(_cache->getProbeManager(), _cache,
+                  _cache->getBlockSize());
+}
+
+void
+Base::setParentInfo(ProbeManager *pm, CacheAccessor *_cache,
+                    unsigned blk_size)
 {
     assert(!cache);
     cache = _cache;
+    cacheProbeManager = pm;
 
     // If the cache has a different block size from the system's, save it
-    blkSize = cache->getBlockSize();
+    blkSize = blk_size;
     lBlkSize = floorLog2(blkSize);
 }
 
@@ -280,8 +290,8 @@ Base::regProbeListeners()
      * parent cache using the probe "Miss". Also connect to "Hit", if the
      * cache is configured to prefetch on accesses.
      */
-    if (listeners.empty() && cache != nullptr) {
-        ProbeManager *pm(cache->getProbeManager());
+    if (listeners.empty() && cacheProbeManager != nullptr) {
+        ProbeManager *pm(cacheProbeManager);
         listeners.push_back(new PrefetchListener(*this, pm, "Miss", false,
                                                 true));
         listeners.push_back(new PrefetchListener(*this, pm, "Fill", true,
@@ -52,6 +52,7 @@
 #include "base/compiler.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "mem/cache/cache_accessor.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/packet.hh"
 #include "mem/request.hh"
@@ -64,6 +65,7 @@ namespace gem5
 
 class BaseCache;
 struct BasePrefetcherParams;
+class System;
 
 GEM5_DEPRECATED_NAMESPACE(Prefetcher, prefetch);
 namespace prefetch
@@ -263,8 +265,18 @@ class Base : public ClockedObject
 
     // PARAMETERS
 
-    /** Pointr to the parent cache. */
-    BaseCache* cache;
+    /** Accessor to the state of the parent cache. */
+    CacheAccessor *cache;
+
+    /**
+     * Probe manager of the parent cache, whose default probe points are
+     * listened to if no other probes are added. Null if the parent
+     * notifies the prefetcher directly.
+     */
+    ProbeManager *cacheProbeManager;
+
+    /** System this prefetcher belongs to. */
+    System *system;
 
     /** The block size of the parent cache. */
     unsigned blkSize;
@@ -371,7 +383,24 @@ class Base : public ClockedObject
     Base(const BasePrefetcherParams &p);
     virtual ~Base() = default;
 
-    virtual void setCache(BaseCache *_cache);
+    /**
+     * Attach the prefetcher to a classic cache.
+     *
+     * @param _cache The parent cache.
+     */
+    void setCache(BaseCache *_cache);
+
+    /**
+     * Attach the prefetcher to its parent, which need not be a classic
+     * cache.
+     *
+     * @param pm Probe manager of the parent, or nullptr if the parent
+     *        calls probeNotify() and notifyFill() itself.
+     * @param _cache Accessor to the state of the parent.
+     * @param blk_size The block size of the parent.
+     */
+    virtual void setParentInfo(ProbeManager *pm, CacheAccessor *_cache,
+                               unsigned blk_size);
 
     /**
      * Notify prefetcher of cache access (may be any access or just
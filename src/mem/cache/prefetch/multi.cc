@@ -54,10 +54,11 @@ Multi::Multi(const MultiPrefetcherParams &p)
 }
 
 void
-Multi::setCache(BaseCache *_cache)
+Multi::setParentInfo(ProbeManager *pm, CacheAccessor *_cache,
+                     unsigned blk_size)
 {
     for (auto pf : prefetchers)
-        pf->setCache(_cache);
+        pf->setParentInfo(pm, _cache, blk_size);
 }
 
 Tick
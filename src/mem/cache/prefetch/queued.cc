@@ -44,9 +44,9 @@
 #include "base/trace.hh"
 #include "debug/HWPrefetch.hh"
 #include "debug/HWPrefetchQueue.hh"
-#include "mem/cache/base.hh"
 #include "mem/request.hh"
 #include "params/QueuedPrefetcher.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -55,26 +55,26 @@ GEM5_DEPRECATED_NAMESPACE(Prefetcher, prefetch);
 namespace prefetch
 {
 
-void
-Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
-                                            RequestorID requestor_id,
-                                            bool tag_prefetch,
-                                            Tick t) {
+PacketPtr
+Queued::DeferredPacket::createPkt(unsigned blk_size,
+                                  RequestorID requestor_id,
+                                  bool tag_prefetch) const
+{
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
-                                                0, requestor_id);
+    RequestPtr req = Request::create(paddr, blk_size,
+                                     0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
     }
     req->taskId(context_switch_task_id::Prefetcher);
-    pkt = new Packet(req, MemCmd::HardPFReq);
+    PacketPtr pkt = new Packet(req, MemCmd::HardPFReq);
     pkt->allocate();
     if (tag_prefetch && pfInfo.hasPC()) {
         // Tag prefetch packet with  accessing pc
         pkt->req->setPC(pfInfo.getPC());
     }
-    tick = t;
+    return pkt;
 }
 
 void
@@ -109,14 +109,6 @@ Queued::Queued(const QueuedPrefetcherParams &p)
 {
 }
 
-Queued::~Queued()
-{
-    // Delete the queued prefetch packets
-    for (DeferredPacket &p : pfq) {
-        delete p.pkt;
-    }
-}
-
 void
 Queued::printQueue(const std::list<DeferredPacket> &queue) const
 {
@@ -132,10 +124,10 @@ Queued::printQueue(const std::list<DeferredPacket> &queue) const
     for (const_iterator it = queue.cbegin(); it != queue.cend();
                                                             it++, pos++) {
         Addr vaddr = it->pfInfo.getAddr();
-        /* Set paddr to 0 if not yet translated */
-        Addr paddr = it->pkt ? it->pkt->getAddr() : 0;
+        /* paddr is 0 if not yet translated */
         DPRINTF(HWPrefetchQueue, "%s[%d]: Prefetch Req VA: %#x PA: %#x "
-                "prio: %3d\n", queue_name, pos, vaddr, paddr, it->priority);
+                "prio: %3d\n", queue_name, pos, vaddr, it->paddr,
+                it->priority);
     }
 }
 
@@ -176,7 +168,7 @@ Queued::notify(const PacketPtr &pkt, const PrefetchInfo &pfi)
     bool is_secure = pfi.isSecure();
 
     // Squash queued prefetches if demand miss to same line
-    if (queueSquash) {
+    if (queueSquash && mayBeQueued(blk_addr)) {
         auto itr = pfq.begin();
         while (itr != pfq.end()) {
             if (itr->pfInfo.getAddr() == blk_addr &&
@@ -185,8 +177,7 @@ Queued::notify(const PacketPtr &pkt, const PrefetchInfo &pfi)
                         "(cl: %#x), demand request going to the same addr\n",
                         itr->pfInfo.getAddr(),
                         blockAddress(itr->pfInfo.getAddr()));
-                delete itr->pkt;
-                itr = pfq.erase(itr);
+                itr = removeFromQueue(pfq, itr);
                 statsQueued.pfRemovedDemand++;
             } else {
                 ++itr;
@@ -250,8 +241,11 @@ Queued::getPacket()
         return nullptr;
     }
 
-    PacketPtr pkt = pfq.front().pkt;
-    pfq.pop_front();
+    // The packet is only built now, so that prefetches that are squashed
+    // or dropped while queued never allocate one
+    const DeferredPacket &dp = pfq.front();
+    PacketPtr pkt = dp.createPkt(blkSize, requestorId, tagPrefetch);
+    removeFromQueue(pfq, pfq.begin());
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
@@ -323,8 +317,7 @@ Queued::translationComplete(DeferredPacket *dp, bool failed)
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
         } else {
             Tick pf_time = curTick() + clockPeriod() * latency;
-            it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                          pf_time);
+            it->setTarget(target_paddr, pf_time);
             addToQueue(pfq, *it);
         }
     } else {
@@ -332,21 +325,21 @@ Queued::translationComplete(DeferredPacket *dp, bool failed)
                 "prefetch request %#x \n", tlb->name(),
                 it->translationRequest->getVaddr());
     }
-    pfqMissingTranslation.erase(it);
+    removeFromQueue(pfqMissingTranslation, it);
 }
 
 bool
 Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
                                  const PrefetchInfo &pfi, int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
+    iterator it = queue.begin();
+    while (it != queue.end() && !it->pfInfo.sameAddr(pfi)) {
+        it++;
     }
+    const bool found = it != queue.end();
 
     /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
+    if (found) {
         statsQueued.pfBufferHit++;
         if (it->priority < priority) {
             /* Update priority value and position in the queue */
@@ -374,7 +367,7 @@ RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = Request::create(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -385,7 +378,7 @@ void
 Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
                          int32_t priority)
 {
-    if (queueFilter) {
+    if (queueFilter && mayBeQueued(new_pfi.getAddr())) {
         if (alreadyInQueue(pfq, new_pfi, priority)) {
             return;
         }
@@ -464,8 +457,7 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
     DeferredPacket dpp(this, new_pfi, 0, priority);
     if (has_target_pa) {
         Tick pf_time = curTick() + clockPeriod() * latency;
-        dpp.createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                      pf_time);
+        dpp.setTarget(target_paddr, pf_time);
         DPRINTF(HWPrefetch, "Prefetch queued. "
                 "addr:%#x priority: %3d tick:%lld.\n",
                 new_pfi.getAddr(), priority, pf_time);
@@ -473,7 +465,7 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
     } else {
         // Add the translation request and try to resolve it later
         dpp.setTranslationRequest(translation_req);
-        dpp.tc = cache->system->threads[translation_req->contextId()];
+        dpp.tc = system->threads[translation_req->contextId()];
         DPRINTF(HWPrefetch, "Prefetch queued with no translation. "
                 "addr:%#x priority: %3d\n", new_pfi.getAddr(), priority);
         addToQueue(pfqMissingTranslation, dpp);
@@ -508,10 +500,11 @@ Queued::addToQueue(std::list<DeferredPacket> &queue,
         }
         DPRINTF(HWPrefetch, "Prefetch queue full, removing lowest priority "
                             "oldest packet, addr: %#x\n",it->pfInfo.getAddr());
-        delete it->pkt;
-        queue.erase(it);
+        removeFromQueue(queue, it);
     }
 
+    queuedAddrs[dpp.pfInfo.getAddr()]++;
+
     if ((queue.size() == 0) || (dpp <= queue.back())) {
         queue.emplace_back(dpp);
     } else {
@@ -530,5 +523,16 @@ Queued::addToQueue(std::list<DeferredPacket> &queue,
         printQueue(queue);
 }
 
+Queued::iterator
+Queued::removeFromQueue(std::list<DeferredPacket> &queue, iterator it)
+{
+    auto count = queuedAddrs.find(it->pfInfo.getAddr());
+    assert(count != queuedAddrs.end());
+    if (--count->second == 0) {
+        queuedAddrs.erase(count);
+    }
+    return queue.erase(it);
+}
+
 } // namespace prefetch
 } // namespace gem5
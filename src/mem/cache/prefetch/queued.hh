@@ -40,6 +40,7 @@
 
 #include <cstdint>
 #include <list>
+#include <unordered_map>
 #include <utility>
 
 #include "arch/generic/mmu.hh"
@@ -68,8 +69,12 @@ class Queued : public Base
         PrefetchInfo pfInfo;
         /** Time when this prefetch becomes ready */
         Tick tick;
-        /** The memory packet generated by this prefetch */
-        PacketPtr pkt;
+        /**
+         * Physical address of this prefetch, or 0 if it has not been
+         * translated yet. The memory packet itself is only created when
+         * the prefetch is issued.
+         */
+        Addr paddr;
         /** The priority of this prefetch */
         int32_t priority;
         /** Request used when a translation is needed */
@@ -82,11 +87,10 @@ class Queued : public Base
          * @param o QueuedPrefetcher in charge of this request
          * @param pfi PrefechInfo object associated to this packet
          * @param t Time when this prefetch becomes ready
-         * @param p PacketPtr with the memory request of the prefetch
          * @param prio This prefetch priority
          */
         DeferredPacket(Queued *o, PrefetchInfo const &pfi, Tick t,
-            int32_t prio) : owner(o), pfInfo(pfi), tick(t), pkt(nullptr),
+            int32_t prio) : owner(o), pfInfo(pfi), tick(t), paddr(0),
             priority(prio), translationRequest(), tc(nullptr),
             ongoingTranslation(false) {
         }
@@ -104,18 +108,29 @@ class Queued : public Base
             return !(*this > that);
         }
 
+        /**
+         * Set the translated address of this prefetch
+         * @param target_paddr physical address of this prefetch
+         * @param t time when the prefetch becomes ready
+         */
+        void
+        setTarget(Addr target_paddr, Tick t)
+        {
+            paddr = target_paddr;
+            tick = t;
+        }
+
         /**
          * Create the associated memory packet
-         * @param paddr physical address of this packet
          * @param blk_size block size used by the prefetcher
          * @param requestor_id Requestor ID of the access that generated
          * this prefetch
          * @param tag_prefetch flag to indicate if the packet needs to be
          *        tagged
-         * @param t time when the prefetch becomes ready
+         * @return the new memory packet
          */
-        void createPkt(Addr paddr, unsigned blk_size, RequestorID requestor_id,
-                       bool tag_prefetch, Tick t);
+        PacketPtr createPkt(unsigned blk_size, RequestorID requestor_id,
+                            bool tag_prefetch) const;
 
         /**
          * Sets the translation request needed to obtain the physical address
@@ -146,6 +161,13 @@ class Queued : public Base
     using const_iterator = std::list<DeferredPacket>::const_iterator;
     using iterator = std::list<DeferredPacket>::iterator;
 
+    /**
+     * Number of prefetches in pfq and pfqMissingTranslation for each
+     * address. Used to skip scanning the queues for addresses that are
+     * known not to be in them.
+     */
+    std::unordered_map<Addr, unsigned> queuedAddrs;
+
     // PARAMETERS
 
     /** Maximum size of the prefetch queue */
@@ -191,7 +213,7 @@ class Queued : public Base
     using AddrPriority = std::pair<Addr, int32_t>;
 
     Queued(const QueuedPrefetcherParams &p);
-    virtual ~Queued();
+    virtual ~Queued() = default;
 
     void notify(const PacketPtr &pkt, const PrefetchInfo &pfi) override;
 
@@ -217,6 +239,26 @@ class Queued : public Base
      */
     void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
 
+    /**
+     * Removes a DeferredPacket from the specified queue
+     * @param queue selected queue to use
+     * @param it position of the DeferredPacket to remove
+     * @return iterator following the removed element
+     */
+    iterator removeFromQueue(std::list<DeferredPacket> &queue, iterator it);
+
+    /**
+     * Checks whether a prefetch to the given address may be in any of the
+     * queues. A false result is always exact.
+     * @param addr address of the prefetch
+     * @return False if there is no prefetch to the address in the queues
+     */
+    bool
+    mayBeQueued(Addr addr) const
+    {
+        return queuedAddrs.find(addr) != queuedAddrs.end();
+    }
+
     /**
      * Starts the translations of the queued prefetches with a
      * missing translation. It performs a maximum specified number of
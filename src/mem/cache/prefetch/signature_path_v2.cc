@@ -59,7 +59,7 @@ SignaturePathV2::handleSignatureTableMiss(stride_t current_block,
 
     // This should return all entries of the GHR, since it is a fully
     // associative table
-    std::vector<GlobalHistoryEntry *> all_ghr_entries =
+    const std::vector<GlobalHistoryEntry *> &all_ghr_entries =
              globalHistoryRegister.getPossibleEntries(0 /* any value works */);
 
     for (auto gh_entry : all_ghr_entries) {
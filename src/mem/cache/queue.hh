@@ -45,9 +45,12 @@
 #ifndef __MEM_CACHE_QUEUE_HH__
 #define __MEM_CACHE_QUEUE_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "base/logging.hh"
 #include "base/named.hh"
@@ -101,6 +104,30 @@ class Queue : public Drainable, public Named
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /**
+     * The allocated entries of each block address, in the order they
+     * were allocated, so that matching an address doesn't scan every
+     * allocated entry.
+     */
+    std::unordered_map<Addr, std::vector<Entry*>> addrIndex;
+
+    typename Entry::Iterator addToAllocatedList(Entry* entry)
+    {
+        addrIndex[entry->blkAddr].push_back(entry);
+        return allocatedList.insert(allocatedList.end(), entry);
+    }
+
+    void removeFromAddrIndex(Entry* entry)
+    {
+        auto it = addrIndex.find(entry->blkAddr);
+        assert(it != addrIndex.end());
+        auto &bucket = it->second;
+        bucket.erase(std::find(bucket.begin(), bucket.end(), entry));
+        if (bucket.empty()) {
+            addrIndex.erase(it);
+        }
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -140,6 +167,7 @@ class Queue : public Drainable, public Named
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
         }
+        addrIndex.reserve(numEntries);
     }
 
     bool isEmpty() const
@@ -168,7 +196,14 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        // Only entries of the same block can match, and the index keeps
+        // them in allocation order, like the allocated list
+        auto it = addrIndex.find(blk_addr);
+        if (it == addrIndex.end()) {
+            return nullptr;
+        }
+
+        for (const auto& entry : it->second) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -205,6 +240,33 @@ class Queue : public Drainable, public Named
      * @return A pointer to the earliest matching entry.
      */
     Entry* findPending(const QueueEntry* entry) const
+    {
+        // Entries only conflict with entries of the same block
+        auto it = addrIndex.find(entry->blkAddr);
+        if (it == addrIndex.end()) {
+            return nullptr;
+        }
+
+        // The entries that aren't in service are the ones in the ready
+        // list. If several of them conflict, the ready list decides which
+        // comes first.
+        Entry* found = nullptr;
+        for (const auto& ready_entry : it->second) {
+            if (!ready_entry->inService && ready_entry->conflictAddr(entry)) {
+                if (found) {
+                    return findPendingInReadyList(entry);
+                }
+                found = ready_entry;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * Find the earliest entry of the ready list that overlaps the given
+     * entry of a different queue.
+     */
+    Entry* findPendingInReadyList(const QueueEntry* entry) const
     {
         for (const auto& ready_entry : readyList) {
             if (ready_entry->conflictAddr(entry)) {
@@ -241,6 +303,7 @@ class Queue : public Drainable, public Named
     deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        removeFromAddrIndex(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
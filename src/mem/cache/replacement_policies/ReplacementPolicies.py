@@ -124,6 +124,14 @@ class SHiPRP(BRRIPRP):
     # By default any value greater than 0 is enough to change insertion policy
     insertion_threshold = Param.Percent(1,
         "Percentage at which an entry changes insertion policy")
+    # Lines of signatures whose counter was detrained to zero are not
+    # expected to be reused, so they can skip the cache altogether. A
+    # sample is still inserted to notice when the signature changes
+    # behaviour.
+    bypass_dead = Param.Bool(False,
+        "Do not insert fills whose signature predicts no reuse")
+    bypass_sample = Param.Percent(3,
+        "Percentage of fills predicted dead that are still inserted")
     # Always make hits mark entries as last to be evicted
     hit_priority = True
     # Let the predictor decide when to change insertion policy
@@ -29,9 +29,13 @@
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <utility>
 
 #include "base/compiler.hh"
+#include "base/random.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/packet.hh"
 #include "params/BaseReplacementPolicy.hh"
@@ -49,14 +53,75 @@ GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
 namespace replacement_policy
 {
 
+/**
+ * The replacement data of an entry as the type its policy instantiated.
+ * Unlike std::static_pointer_cast this doesn't create a new shared
+ * pointer, so looking at the candidates of a set doesn't touch their
+ * reference counts.
+ */
+template <class T>
+T *
+replData(const std::shared_ptr<ReplacementData> &replacement_data)
+{
+    return static_cast<T *>(replacement_data.get());
+}
+
+/**
+ * Allocates the replacement data of a policy in contiguous chunks. The
+ * entries of a set are instantiated one after the other, so their data
+ * ends up side by side and victim selection walks memory in order
+ * instead of chasing one heap allocation per entry. The pointers handed
+ * out share the ownership of their chunk.
+ */
+template <class T>
+class ReplDataPool
+{
+  private:
+    static constexpr size_t ChunkEntries = 256;
+
+    struct Chunk
+    {
+        alignas(T) unsigned char storage[ChunkEntries * sizeof(T)];
+        size_t used = 0;
+
+        T *at(size_t i) { return reinterpret_cast<T *>(storage) + i; }
+
+        ~Chunk()
+        {
+            for (size_t i = 0; i < used; i++)
+                at(i)->~T();
+        }
+    };
+
+    std::shared_ptr<Chunk> chunk;
+
+  public:
+    /** Construct an entry in the current chunk. */
+    template <typename... Args>
+    std::shared_ptr<ReplacementData>
+    make(Args&&... args)
+    {
+        if (!chunk || chunk->used == ChunkEntries)
+            chunk = std::make_shared<Chunk>();
+        T *data = new (chunk->at(chunk->used)) T(
+            std::forward<Args>(args)...);
+        chunk->used++;
+        return std::shared_ptr<ReplacementData>(chunk, data);
+    }
+};
+
 /**
  * A common base class of cache replacement policy objects.
  */
 class Base : public SimObject
 {
+  protected:
+    /** Random numbers of this policy, independent of other objects */
+    mutable RandomStream rng;
+
   public:
     typedef BaseReplacementPolicyParams Params;
-    Base(const Params &p) : SimObject(p) {}
+    Base(const Params &p) : SimObject(p), rng(name()) {}
     virtual ~Base() = default;
 
     /**
@@ -104,6 +169,16 @@ class Base : public SimObject
     virtual ReplaceableEntry* getVictim(
                            const ReplacementCandidates& candidates) const = 0;
 
+    /**
+     * Predict whether the block a miss brings in will be dead on arrival,
+     * in which case the fill is handed to the requestor without being
+     * inserted at all. By default every fill is inserted.
+     *
+     * @param pkt Packet that generated the miss.
+     * @return True if the fill should bypass the cache.
+     */
+    virtual bool shouldBypass(const PacketPtr pkt) const { return false; }
+
     /**
      * Instantiate a replacement data entry.
      *
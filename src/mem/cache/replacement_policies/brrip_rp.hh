@@ -112,6 +112,9 @@ class BRRIP : public Base
      */
     const unsigned btp;
 
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<BRRIPReplData> replDataPool;
+
   public:
     typedef BRRIPRPParams Params;
     BRRIP(const Params &p);
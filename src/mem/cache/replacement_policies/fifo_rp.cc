@@ -50,7 +50,7 @@ void
 FIFO::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset insertion tick
-    std::static_pointer_cast<FIFOReplData>(
+    replData<FIFOReplData>(
         replacement_data)->tickInserted = Tick(0);
 }
 
@@ -64,7 +64,7 @@ void
 FIFO::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set insertion tick
-    std::static_pointer_cast<FIFOReplData>(
+    replData<FIFOReplData>(
         replacement_data)->tickInserted = curTick();
 }
 
@@ -78,9 +78,9 @@ FIFO::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<FIFOReplData>(
+        if (replData<FIFOReplData>(
                     candidate->replacementData)->tickInserted <
-                std::static_pointer_cast<FIFOReplData>(
+                replData<FIFOReplData>(
                     victim->replacementData)->tickInserted) {
             victim = candidate;
         }
@@ -92,7 +92,7 @@ FIFO::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 FIFO::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new FIFOReplData());
+    return replDataPool.make();
 }
 
 } // namespace replacement_policy
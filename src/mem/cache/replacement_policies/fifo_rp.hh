@@ -63,6 +63,9 @@ class FIFO : public Base
         FIFOReplData() : tickInserted(0) {}
     };
 
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<FIFOReplData> replDataPool;
+
   public:
     typedef FIFORPParams Params;
     FIFO(const Params &p);
@@ -49,21 +49,21 @@ void
 LFU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount = 0;
+    replData<LFUReplData>(replacement_data)->refCount = 0;
 }
 
 void
 LFU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount++;
+    replData<LFUReplData>(replacement_data)->refCount++;
 }
 
 void
 LFU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Reset reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount = 1;
+    replData<LFUReplData>(replacement_data)->refCount = 1;
 }
 
 ReplaceableEntry*
@@ -76,9 +76,9 @@ LFU::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<LFUReplData>(
+        if (replData<LFUReplData>(
                     candidate->replacementData)->refCount <
-                std::static_pointer_cast<LFUReplData>(
+                replData<LFUReplData>(
                     victim->replacementData)->refCount) {
             victim = candidate;
         }
@@ -90,7 +90,7 @@ LFU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 LFU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new LFUReplData());
+    return replDataPool.make();
 }
 
 } // namespace replacement_policy
@@ -63,6 +63,9 @@ class LFU : public Base
         LFUReplData() : refCount(0) {}
     };
 
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<LFUReplData> replDataPool;
+
   public:
     typedef LFURPParams Params;
     LFU(const Params &p);
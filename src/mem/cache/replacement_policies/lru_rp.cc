@@ -50,7 +50,7 @@ void
 LRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
+    replData<LRUReplData>(
         replacement_data)->lastTouchTick = Tick(0);
 }
 
@@ -58,7 +58,7 @@ void
 LRU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
+    replData<LRUReplData>(
         replacement_data)->lastTouchTick = curTick();
 }
 
@@ -66,7 +66,7 @@ void
 LRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
+    replData<LRUReplData>(
         replacement_data)->lastTouchTick = curTick();
 }
 
@@ -80,9 +80,9 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<LRUReplData>(
+        if (replData<LRUReplData>(
                     candidate->replacementData)->lastTouchTick <
-                std::static_pointer_cast<LRUReplData>(
+                replData<LRUReplData>(
                     victim->replacementData)->lastTouchTick) {
             victim = candidate;
         }
@@ -94,7 +94,7 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 LRU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new LRUReplData());
+    return replDataPool.make();
 }
 
 } // namespace replacement_policy
@@ -61,6 +61,9 @@ class LRU : public Base
         LRUReplData() : lastTouchTick(0) {}
     };
 
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<LRUReplData> replDataPool;
+
   public:
     typedef LRURPParams Params;
     LRU(const Params &p);
@@ -63,6 +63,9 @@ class MRU : public Base
         MRUReplData() : lastTouchTick(0) {}
     };
 
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<MRUReplData> replDataPool;
+
   public:
     typedef MRURPParams Params;
     MRU(const Params &p);
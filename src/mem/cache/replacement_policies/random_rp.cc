@@ -50,7 +50,7 @@ void
 Random::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Unprioritize replacement data victimization
-    std::static_pointer_cast<RandomReplData>(
+    replData<RandomReplData>(
         replacement_data)->valid = false;
 }
 
@@ -63,7 +63,7 @@ void
 Random::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Unprioritize replacement data victimization
-    std::static_pointer_cast<RandomReplData>(
+    replData<RandomReplData>(
         replacement_data)->valid = true;
 }
 
@@ -74,13 +74,13 @@ Random::getVictim(const ReplacementCandidates& candidates) const
     assert(candidates.size() > 0);
 
     // Choose one candidate at random
-    ReplaceableEntry* victim = candidates[random_mt.random<unsigned>(0,
+    ReplaceableEntry* victim = candidates[rng.random<unsigned>(0,
                                     candidates.size() - 1)];
 
     // Visit all candidates to search for an invalid entry. If one is found,
     // its eviction is prioritized
     for (const auto& candidate : candidates) {
-        if (!std::static_pointer_cast<RandomReplData>(
+        if (!replData<RandomReplData>(
                     candidate->replacementData)->valid) {
             victim = candidate;
             break;
@@ -93,7 +93,7 @@ Random::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 Random::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new RandomReplData());
+    return replDataPool.make();
 }
 
 } // namespace replacement_policy
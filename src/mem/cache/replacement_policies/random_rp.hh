@@ -64,6 +64,9 @@ class Random : public Base
         RandomReplData() : valid(false) {}
     };
 
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<RandomReplData> replDataPool;
+
   public:
     typedef RandomRPParams Params;
     Random(const Params &p);
@@ -46,13 +46,13 @@ SecondChance::SecondChance(const Params &p)
 
 void
 SecondChance::useSecondChance(
-    const std::shared_ptr<SecondChanceReplData>& replacement_data) const
+    const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Reset FIFO data
     FIFO::reset(replacement_data);
 
     // Use second chance
-    replacement_data->hasSecondChance = false;
+    replData<SecondChanceReplData>(replacement_data)->hasSecondChance = false;
 }
 
 void
@@ -62,7 +62,7 @@ SecondChance::invalidate(
     FIFO::invalidate(replacement_data);
 
     // Do not give a second chance to invalid entries
-    std::static_pointer_cast<SecondChanceReplData>(
+    replData<SecondChanceReplData>(
         replacement_data)->hasSecondChance = false;
 }
 
@@ -73,7 +73,7 @@ SecondChance::touch(
     FIFO::touch(replacement_data);
 
     // Whenever an entry is touched, it is given a second chance
-    std::static_pointer_cast<SecondChanceReplData>(
+    replData<SecondChanceReplData>(
         replacement_data)->hasSecondChance = true;
 }
 
@@ -84,7 +84,7 @@ SecondChance::reset(
     FIFO::reset(replacement_data);
 
     // Entries are inserted with a second chance
-    std::static_pointer_cast<SecondChanceReplData>(
+    replData<SecondChanceReplData>(
         replacement_data)->hasSecondChance = false;
 }
 
@@ -97,8 +97,8 @@ SecondChance::getVictim(const ReplacementCandidates& candidates) const
     // Search for invalid entries, as they have the eviction priority
     for (const auto& candidate : candidates) {
         // Cast candidate's replacement data
-        std::shared_ptr<SecondChanceReplData> candidate_replacement_data =
-            std::static_pointer_cast<SecondChanceReplData>(
+        SecondChanceReplData *candidate_replacement_data =
+            replData<SecondChanceReplData>(
                 candidate->replacementData);
 
         // Stop iteration if found an invalid entry
@@ -116,13 +116,13 @@ SecondChance::getVictim(const ReplacementCandidates& candidates) const
         victim = FIFO::getVictim(candidates);
 
         // Cast victim's replacement data for code readability
-        std::shared_ptr<SecondChanceReplData> victim_replacement_data =
-            std::static_pointer_cast<SecondChanceReplData>(
+        SecondChanceReplData *victim_replacement_data =
+            replData<SecondChanceReplData>(
                 victim->replacementData);
 
         // If victim has a second chance, use it and repeat search
         if (victim_replacement_data->hasSecondChance) {
-            useSecondChance(victim_replacement_data);
+            useSecondChance(victim->replacementData);
         } else {
             // Found victim
             search_victim = false;
@@ -135,7 +135,7 @@ SecondChance::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 SecondChance::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new SecondChanceReplData());
+    return replDataPool.make();
 }
 
 } // namespace replacement_policy
@@ -75,7 +75,10 @@ class SecondChance : public FIFO
      * @param replacement_data Entry that will use its second chance.
      */
     void useSecondChance(
-        const std::shared_ptr<SecondChanceReplData>& replacement_data) const;
+        const std::shared_ptr<ReplacementData>& replacement_data) const;
+
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<SecondChanceReplData> replDataPool;
 
   public:
     typedef SecondChanceRPParams Params;
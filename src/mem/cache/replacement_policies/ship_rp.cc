@@ -71,20 +71,23 @@ SHiP::SHiPReplData::wasReReferenced() const
 
 SHiP::SHiP(const Params &p)
   : BRRIP(p), insertionThreshold(p.insertion_threshold / 100.0),
-    SHCT(p.shct_size, SatCounter8(numRRPVBits))
+    SHCT(p.shct_size, SatCounter8(numRRPVBits)),
+    SHCTDetrained(p.shct_size, false),
+    bypassDead(p.bypass_dead), bypassSample(p.bypass_sample)
 {
 }
 
 void
 SHiP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData *casted_replacement_data =
+        replData<SHiPReplData>(replacement_data);
 
     // The predictor is detrained when an entry that has not been re-
     // referenced since insertion is invalidated
-    if (casted_replacement_data->wasReReferenced()) {
+    if (!casted_replacement_data->wasReReferenced()) {
         SHCT[casted_replacement_data->getSignature()]--;
+        SHCTDetrained[casted_replacement_data->getSignature()] = true;
     }
 
     BRRIP::invalidate(replacement_data);
@@ -94,8 +97,8 @@ void
 SHiP::touch(const std::shared_ptr<ReplacementData>& replacement_data,
     const PacketPtr pkt)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData *casted_replacement_data =
+        replData<SHiPReplData>(replacement_data);
 
     // When a hit happens the SHCT entry indexed by the signature is
     // incremented
@@ -117,8 +120,8 @@ void
 SHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data,
     const PacketPtr pkt)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData *casted_replacement_data =
+        replData<SHiPReplData>(replacement_data);
 
     // Get signature
     const SignatureType signature = getSignature(pkt);
@@ -144,7 +147,19 @@ SHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data)
 std::shared_ptr<ReplacementData>
 SHiP::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new SHiPReplData(numRRPVBits));
+    return replDataPool.make(numRRPVBits);
+}
+
+bool
+SHiP::shouldBypass(const PacketPtr pkt) const
+{
+    if (!bypassDead) {
+        return false;
+    }
+
+    const SignatureType signature = getSignature(pkt);
+    return SHCTDetrained[signature] && (SHCT[signature] == 0) &&
+        (rng.random<unsigned>(1, 100) > bypassSample);
 }
 
 SHiPMem::SHiPMem(const SHiPMemRPParams &p) : SHiP(p) {}
@@ -107,6 +107,23 @@ class SHiP : public BRRIP
      */
     std::vector<SatCounter8> SHCT;
 
+    /**
+     * Whether each SHCT entry was ever detrained. A zero entry is only
+     * trusted to mean "dead" once lines of its signature have actually
+     * been evicted unreferenced, and not just because nothing was learnt
+     * about it yet.
+     */
+    std::vector<bool> SHCTDetrained;
+
+    /** Whether fills predicted dead bypass the cache. */
+    const bool bypassDead;
+
+    /**
+     * Percentage of fills predicted dead that are still inserted, so the
+     * predictor keeps learning from their signatures.
+     */
+    const unsigned bypassSample;
+
     /**
      * Extract signature from packet.
      *
@@ -115,6 +132,9 @@ class SHiP : public BRRIP
      */
     virtual SignatureType getSignature(const PacketPtr pkt) const = 0;
 
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<SHiPReplData> replDataPool;
+
   public:
     typedef SHiPRPParams Params;
     SHiP(const Params &p);
@@ -159,6 +179,15 @@ class SHiP : public BRRIP
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+
+    /**
+     * Bypass fills whose signature has been seen to bring dead lines,
+     * if enabled, except for a sample of them.
+     *
+     * @param pkt Packet that generated the miss.
+     * @return True if the fill should bypass the cache.
+     */
+    bool shouldBypass(const PacketPtr pkt) const override;
 };
 
 /** SHiP that Uses memory addresses as signatures. */
@@ -123,7 +123,7 @@ class TreePLRU : public Base
     /**
      * Holds the latest temporary tree instance created by instantiateEntry().
      */
-    PLRUTree* treeInstance;
+    std::shared_ptr<PLRUTree> treeInstance;
 
   protected:
     /**
@@ -155,6 +155,9 @@ class TreePLRU : public Base
         TreePLRUReplData(const uint64_t index, std::shared_ptr<PLRUTree> tree);
     };
 
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<TreePLRUReplData> replDataPool;
+
   public:
     typedef TreePLRURPParams Params;
     TreePLRU(const Params &p);
@@ -53,7 +53,7 @@ WeightedLRU::touch(const std::shared_ptr<ReplacementData>& replacement_data,
     int occupancy) const
 {
     LRU::touch(replacement_data);
-    std::static_pointer_cast<WeightedLRUReplData>(replacement_data)->
+    replData<WeightedLRUReplData>(replacement_data)->
                                                   last_occ_ptr = occupancy;
 }
 
@@ -68,12 +68,12 @@ WeightedLRU::getVictim(const ReplacementCandidates& candidates) const
     // If two blocks have the same weight, evict the oldest one.
     for (const auto& candidate : candidates) {
         // candidate's replacement_data
-        std::shared_ptr<WeightedLRUReplData> candidate_replacement_data =
-            std::static_pointer_cast<WeightedLRUReplData>(
+        WeightedLRUReplData *candidate_replacement_data =
+            replData<WeightedLRUReplData>(
                                              candidate->replacementData);
         // victim's replacement_data
-        std::shared_ptr<WeightedLRUReplData> victim_replacement_data =
-            std::static_pointer_cast<WeightedLRUReplData>(
+        WeightedLRUReplData *victim_replacement_data =
+            replData<WeightedLRUReplData>(
                                              victim->replacementData);
 
         if (candidate_replacement_data->last_occ_ptr <
@@ -94,7 +94,7 @@ WeightedLRU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 WeightedLRU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new WeightedLRUReplData);
+    return replDataPool.make();
 }
 
 } // namespace replacement_policy
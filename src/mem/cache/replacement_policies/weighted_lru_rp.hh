@@ -60,6 +60,10 @@ class WeightedLRU : public LRU
          */
         WeightedLRUReplData() : LRUReplData(), last_occ_ptr(0) {}
     };
+
+    /** Keeps the replacement data of the entries side by side. */
+    ReplDataPool<WeightedLRUReplData> replDataPool;
+
   public:
     typedef WeightedLRURPParams Params;
     WeightedLRU(const Params &p);
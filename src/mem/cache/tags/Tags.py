@@ -37,6 +37,7 @@ from m5.params import *
 from m5.proxy import *
 from m5.objects.ClockedObject import ClockedObject
 from m5.objects.IndexingPolicies import *
+from m5.objects.PartitioningPolicies import *
 
 class BaseTags(ClockedObject):
     type = 'BaseTags'
@@ -71,6 +72,11 @@ class BaseTags(ClockedObject):
     # Set the indexing entry size as the block size
     entry_size = Param.Int(Parent.cache_line_size,
                            "Indexing entry size in bytes")
+
+    # Constrain where the blocks of each requestor may be allocated
+    partitioning_policies = VectorParam.BasePartitioningPolicy([],
+        "Partitioning policies applied to the replacement candidates, "
+        "only supported by set associative tags")
     //shivansh
     segment_usage = Param.Int(0, "Initial segment usage per set")
     block_count = Param.Int(0, "Initial block count per set")
@@ -63,6 +63,7 @@ BaseTags::BaseTags(const Params &p)
     : ClockedObject(p), blkSize(p.block_size), blkMask(blkSize - 1),
       size(p.size), lookupLatency(p.tag_latency),
       system(p.system), indexingPolicy(p.indexing_policy),
+      partitioningPolicies(p.partitioning_policies),
       warmupBound((p.warmup_percentage/100.0) * (p.size / p.block_size)),
       warmedUp(false), numBlocks(p.size / (2 * p.block_size)),                       //shivansh
       dataBlks(new uint8_t[p.size]), // Allocate data storage in one big chunk
@@ -92,7 +93,7 @@ BaseTags::findBlock(Addr addr, bool is_secure) const
     Addr tag = extractTag(addr);
 
     // Find possible entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
+    const std::vector<ReplaceableEntry*> &entries =
         indexingPolicy->getPossibleEntries(addr);
 
     // Search for block
@@ -137,6 +138,8 @@ void BaseTags::insertBlock(const PacketPtr pkt, CacheBlk *blk)
     RequestorID requestor_id = pkt->req->requestorId();
     assert(requestor_id < system->maxRequestors());
     stats.occupancies[requestor_id]++;
+    for (auto *policy : partitioningPolicies)
+        policy->notifyAcquire(requestor_id);
 
     blk->insert(extractTag(pkt->getAddr()), pkt->isSecure(), cSize, cStatus, requestor_id,
                 pkt->req->taskId());
@@ -56,6 +56,7 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/cache/cache_blk.hh"
+#include "mem/cache/tags/partitioning_policies/base_pp.hh"
 #include "mem/packet.hh"
 #include "params/BaseTags.hh"
 #include "sim/clocked_object.hh"
@@ -89,6 +90,25 @@ class BaseTags : public ClockedObject
     /** Indexing policy */
     BaseIndexingPolicy *indexingPolicy;
 
+    /** Partitioning policies */
+    std::vector<partitioning_policy::BasePartitioningPolicy *>
+        partitioningPolicies;
+
+    /**
+     * Remove the replacement candidates that the partitioning policies do
+     * not let the partition allocate in.
+     *
+     * @param entries The replacement candidates.
+     * @param partition_id The partition allocating a block.
+     */
+    void
+    filterByPartition(std::vector<ReplaceableEntry*> &entries,
+                      uint64_t partition_id) const
+    {
+        for (const auto *policy : partitioningPolicies)
+            policy->filterByPartition(entries, partition_id);
+    }
+
     /**
      * The number of tags that need to be touched to meet the warmup
      * percentage.
@@ -262,6 +282,8 @@ class BaseTags : public ClockedObject
         assert(blk->isValid());
 
         stats.occupancies[blk->getSrcRequestorId()]--;
+        for (auto *policy : partitioningPolicies)
+            policy->notifyRelease(blk->getSrcRequestorId());
         stats.totalRefs += blk->getRefCount();
         stats.sampledRefs++;
 
@@ -289,11 +311,23 @@ class BaseTags : public ClockedObject
      * @param is_secure True if the target memory space is secure.
      * @param size Size, in bits, of new block to allocate.
      * @param evict_blks Cache blocks to be evicted.
+     * @param partition_id The partition the new block belongs to.
      * @return Cache block to be replaced.
      */
     virtual CacheBlk* findVictim(Addr addr, const bool is_secure,
                                  const std::size_t size,
-                                 std::vector<CacheBlk*>& evict_blks) = 0;
+                                 std::vector<CacheBlk*>& evict_blks,
+                                 const uint64_t partition_id = 0) = 0;
+
+    /**
+     * Ask the replacement policy whether the block a miss brings in
+     * should be inserted. A bypassed fill does not look for a victim and
+     * leaves the cache contents untouched.
+     *
+     * @param pkt Packet that generated the miss.
+     * @return True if the fill should not be inserted.
+     */
+    virtual bool bypassFill(const PacketPtr pkt) const { return false; }
 
     /**
      * Access block and update replacement data. May not succeed, in which case
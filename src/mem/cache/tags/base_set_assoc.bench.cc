@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/gbench/clock_domain.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/tags/base_set_assoc.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "params/BaseSetAssoc.hh"
+#include "params/LRURP.hh"
+#include "params/SetAssociative.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+const unsigned blockSize = 64;
+
+/** Create set associative tags with LRU replacement. */
+BaseSetAssoc *
+makeTags(uint64_t size, int assoc, BaseIndexingPolicy *&indexing)
+{
+    auto *indexing_params = new SetAssociativeParams;
+    indexing_params->name = "tags.indexing_policy";
+    indexing_params->eventq_index = 0;
+    indexing_params->assoc = assoc;
+    indexing_params->entry_size = blockSize;
+    indexing_params->size = size;
+
+    auto *repl_params = new LRURPParams;
+    repl_params->name = "tags.replacement_policy";
+    repl_params->eventq_index = 0;
+
+    auto *params = new BaseSetAssocParams;
+    params->name = "tags";
+    params->eventq_index = 0;
+    params->clk_domain = makeBenchClockDomain("clk_domain", 500);
+    params->power_state = nullptr;
+    params->block_count = 0;
+    params->block_size = blockSize;
+    params->entry_size = blockSize;
+    indexing = new SetAssociative(*indexing_params);
+    params->indexing_policy = indexing;
+    params->segment_usage = 0;
+    params->sequential_access = false;
+    params->size = size;
+    params->system = nullptr;
+    params->tag_latency = Cycles(2);
+    params->warmup_percentage = 0;
+    params->assoc = assoc;
+    params->replacement_policy = new replacement_policy::LRU(*repl_params);
+
+    auto *tags = new BaseSetAssoc(*params);
+    tags->tagsInit();
+    return tags;
+}
+
+/**
+ * Look up blocks in 32kB tags of the given associativity. The
+ * addresses that are looked up are all present in the tags when
+ * hit is set, and none of them otherwise.
+ */
+void
+BM_AccessBlock(benchmark::State &state, bool hit)
+{
+    const uint64_t size = 32 * 1024;
+    const int assoc = state.range(0);
+    BaseIndexingPolicy *indexing;
+    BaseSetAssoc *tags = makeTags(size, assoc, indexing);
+
+    // Fill the tags with the first size bytes of the address space
+    for (Addr addr = 0; addr < size; addr += blockSize) {
+        for (auto *entry : indexing->getPossibleEntries(addr)) {
+            CacheBlk *blk = static_cast<CacheBlk *>(entry);
+            if (!blk->isValid()) {
+                blk->insert(tags->extractTag(addr), false);
+                break;
+            }
+        }
+    }
+
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<Addr> block(0, size / blockSize - 1);
+    std::vector<PacketPtr> pkts(1024);
+    for (auto &pkt : pkts) {
+        Addr addr = block(rng) * blockSize + (hit ? 0 : size);
+        pkt = new Packet(std::make_shared<Request>(addr, blockSize, 0, 0),
+                         MemCmd::ReadReq);
+    }
+
+    size_t i = 0;
+    Cycles lat;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tags->accessBlock(pkts[i], lat));
+        i = (i + 1) % pkts.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    for (auto pkt : pkts)
+        delete pkt;
+}
+
+BENCHMARK_CAPTURE(BM_AccessBlock, Hit, true)->RangeMultiplier(2)
+    ->Range(1, 16);
+BENCHMARK_CAPTURE(BM_AccessBlock, Miss, false)->RangeMultiplier(2)
+    ->Range(1, 16);
+
+} // anonymous namespace
@@ -167,15 +167,26 @@ class BaseSetAssoc : public BaseTags
      */
     CacheBlk* findVictim(Addr addr, const bool is_secure,
                          const std::size_t size,
-                         std::vector<CacheBlk*>& evict_blks) override
+                         std::vector<CacheBlk*>& evict_blks,
+                         const uint64_t partition_id = 0) override
     {
         // Get possible entries to be victimized
-        const std::vector<ReplaceableEntry*> entries =
-            indexingPolicy->getPossibleEntries(addr);
+        const std::vector<ReplaceableEntry*> *entries =
+            &indexingPolicy->getPossibleEntries(addr);
+
+        // Only keep the entries the partition may allocate in
+        std::vector<ReplaceableEntry*> partition_entries;
+        if (!partitioningPolicies.empty()) {
+            partition_entries = *entries;
+            filterByPartition(partition_entries, partition_id);
+            if (partition_entries.empty())
+                return nullptr;
+            entries = &partition_entries;
+        }
 
         // Choose replacement victim from replacement candidates
         CacheBlk* victim = static_cast<CacheBlk*>(replacementPolicy->getVictim(
-                                entries));
+                                *entries));
 
         // There is only one eviction for this replacement
         evict_blks.push_back(victim);
@@ -183,6 +194,12 @@ class BaseSetAssoc : public BaseTags
         return victim;
     }
 
+    bool
+    bypassFill(const PacketPtr pkt) const override
+    {
+        return replacementPolicy->shouldBypass(pkt);
+    }
+
     /**
      * Insert the new block into the cache and update replacement data.
      *
@@ -33,6 +33,7 @@
 
 #include "mem/cache/tags/compressed_tags.hh"
 
+#include "base/bitfield.hh"
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/replacement_policies/base.hh"
@@ -104,10 +105,11 @@ CompressedTags::tagsInit()
 CacheBlk*
 CompressedTags::findVictim(Addr addr, const bool is_secure,
                            const std::size_t compressed_size,
-                           std::vector<CacheBlk*>& evict_blks)
+                           std::vector<CacheBlk*>& evict_blks,
+                           const uint64_t partition_id)
 {
     // Get all possible locations of this superblock
-    const std::vector<ReplaceableEntry*> superblock_entries =
+    const std::vector<ReplaceableEntry*> &superblock_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     // Check if the superblock this address belongs to has been allocated. If
@@ -119,7 +121,7 @@ CompressedTags::findVictim(Addr addr, const bool is_secure,
     for (const auto& entry : superblock_entries){
         SuperBlk* superblock = static_cast<SuperBlk*>(entry);
         if (superblock->matchTag(tag, is_secure) &&
-            !superblock->blks[offset]->isValid() &&
+            !superblock->isSubBlkValid(offset) &&
             superblock->isCompressed() &&
             superblock->canCoAllocate(compressed_size))
         {
@@ -137,10 +139,9 @@ CompressedTags::findVictim(Addr addr, const bool is_secure,
             replacementPolicy->getVictim(superblock_entries));
 
         // The whole superblock must be evicted to make room for the new one
-        for (const auto& blk : victim_superblock->blks){
-            if (blk->isValid()) {
-                evict_blks.push_back(blk);
-            }
+        for (uint64_t mask = victim_superblock->getValidMask(); mask;
+             mask &= mask - 1) {
+            evict_blks.push_back(victim_superblock->blks[ctz64(mask)]);
         }
     }
 
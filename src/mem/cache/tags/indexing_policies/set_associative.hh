@@ -115,8 +115,22 @@ class SetAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                     override;
+    const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const Addr addr) const override;
+
+    /**
+     * Calculate the set of an address without virtual dispatch. Containers
+     * that are indexed by this exact policy, and not by a derived one, can
+     * use it to locate the set directly.
+     *
+     * @param addr The address to calculate the set for.
+     * @return The set index of the address.
+     */
+    uint32_t
+    setIndex(const Addr addr) const
+    {
+        return (addr >> setShift) & setMask;
+    }
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
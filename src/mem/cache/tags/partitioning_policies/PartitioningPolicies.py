@@ -0,0 +1,62 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+class BasePartitioningPolicy(SimObject):
+    type = 'BasePartitioningPolicy'
+    abstract = True
+    cxx_class = 'gem5::partitioning_policy::BasePartitioningPolicy'
+    cxx_header = "mem/cache/tags/partitioning_policies/base_pp.hh"
+
+class WayPartitioningPolicy(BasePartitioningPolicy):
+    type = 'WayPartitioningPolicy'
+    cxx_class = 'gem5::partitioning_policy::WayPartitioningPolicy'
+    cxx_header = "mem/cache/tags/partitioning_policies/way_pp.hh"
+
+    partition_ids = VectorParam.UInt64([], "Partitions restricted to a "
+        "subset of the ways, identified by the ID of their requestor")
+    way_masks = VectorParam.UInt64([], "Ways each of the partitions can "
+        "allocate in, bit i standing for way i. Partitions that are not "
+        "listed can allocate in any way.")
+
+class MaxCapacityPartitioningPolicy(BasePartitioningPolicy):
+    type = 'MaxCapacityPartitioningPolicy'
+    cxx_class = 'gem5::partitioning_policy::MaxCapacityPartitioningPolicy'
+    cxx_header = "mem/cache/tags/partitioning_policies/max_capacity_pp.hh"
+
+    cache_size = Param.MemorySize(Parent.size, "Capacity of the cache")
+    block_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
+
+    partition_ids = VectorParam.UInt64([], "Partitions given a share of "
+        "the capacity, identified by the ID of their requestor")
+    capacities = VectorParam.Float([], "Fraction of the cache blocks "
+        "each of the partitions can hold. Once a partition holds its "
+        "share it can only replace its own blocks. Partitions that are "
+        "not listed are not limited.")
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PARTITIONING_POLICIES_BASE_PP_HH__
+#define __MEM_CACHE_TAGS_PARTITIONING_POLICIES_BASE_PP_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "params/BasePartitioningPolicy.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class ReplaceableEntry;
+
+namespace partitioning_policy
+{
+
+/**
+ * A partitioning policy constrains where the blocks of a partition may be
+ * allocated in a cache, e.g. to model way partitioning (Intel CAT) or
+ * capacity quotas (Arm MPAM). It only narrows down the replacement
+ * candidates; the victim is still chosen among the remaining candidates
+ * by the replacement policy of the tags, with its own replacement data.
+ * Partitions are identified by the requestor ID of the accesses.
+ */
+class BasePartitioningPolicy : public SimObject
+{
+  public:
+    typedef BasePartitioningPolicyParams Params;
+    BasePartitioningPolicy(const Params &p) : SimObject(p) {}
+
+    /**
+     * Remove the replacement candidates a partition may not allocate in.
+     *
+     * @param entries The replacement candidates.
+     * @param partition_id The partition allocating a block.
+     */
+    virtual void filterByPartition(std::vector<ReplaceableEntry *> &entries,
+                                   uint64_t partition_id) const = 0;
+
+    /**
+     * Notify the policy that a block was allocated to a partition.
+     *
+     * @param partition_id The partition the block belongs to.
+     */
+    virtual void notifyAcquire(uint64_t partition_id) {}
+
+    /**
+     * Notify the policy that a block of a partition was released.
+     *
+     * @param partition_id The partition the block belonged to.
+     */
+    virtual void notifyRelease(uint64_t partition_id) {}
+};
+
+} // namespace partitioning_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_PARTITIONING_POLICIES_BASE_PP_HH__
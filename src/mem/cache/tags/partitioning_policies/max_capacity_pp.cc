@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/partitioning_policies/max_capacity_pp.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/logging.hh"
+#include "mem/cache/cache_blk.hh"
+#include "params/MaxCapacityPartitioningPolicy.hh"
+
+namespace gem5
+{
+
+namespace partitioning_policy
+{
+
+MaxCapacityPartitioningPolicy::MaxCapacityPartitioningPolicy(
+    const Params &p)
+    : BasePartitioningPolicy(p)
+{
+    fatal_if(p.partition_ids.size() != p.capacities.size(),
+             "%s: each partition needs exactly one capacity\n", name());
+
+    const uint64_t cache_blocks = p.cache_size / p.block_size;
+    for (int i = 0; i < p.partition_ids.size(); i++) {
+        fatal_if(p.capacities[i] <= 0 || p.capacities[i] > 1,
+                 "%s: the capacity of partition %d must be in (0, 1]\n",
+                 name(), p.partition_ids[i]);
+
+        Quota quota;
+        quota.maxBlocks = std::max<uint64_t>(1,
+            std::floor(p.capacities[i] * cache_blocks));
+        fatal_if(!quotas.emplace(p.partition_ids[i], quota).second,
+                 "%s: partition %d is listed more than once\n", name(),
+                 p.partition_ids[i]);
+    }
+}
+
+void
+MaxCapacityPartitioningPolicy::filterByPartition(
+    std::vector<ReplaceableEntry *> &entries, uint64_t partition_id) const
+{
+    const auto it = quotas.find(partition_id);
+    if (it == quotas.end() || it->second.blocks < it->second.maxBlocks)
+        return;
+
+    // The partition is full, so it may only replace its own blocks
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+        [partition_id](ReplaceableEntry *entry) {
+            const CacheBlk *blk = static_cast<CacheBlk *>(entry);
+            return !blk->isValid() ||
+                blk->getSrcRequestorId() != partition_id;
+        }), entries.end());
+}
+
+void
+MaxCapacityPartitioningPolicy::notifyAcquire(uint64_t partition_id)
+{
+    const auto it = quotas.find(partition_id);
+    if (it != quotas.end())
+        it->second.blocks++;
+}
+
+void
+MaxCapacityPartitioningPolicy::notifyRelease(uint64_t partition_id)
+{
+    const auto it = quotas.find(partition_id);
+    if (it != quotas.end()) {
+        panic_if(it->second.blocks == 0,
+                 "%s: partition %d released more blocks than it acquired\n",
+                 name(), partition_id);
+        it->second.blocks--;
+    }
+}
+
+} // namespace partitioning_policy
+} // namespace gem5
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PARTITIONING_POLICIES_MAX_CAPACITY_PP_HH__
+#define __MEM_CACHE_TAGS_PARTITIONING_POLICIES_MAX_CAPACITY_PP_HH__
+
+#include <unordered_map>
+
+#include "mem/cache/tags/partitioning_policies/base_pp.hh"
+
+namespace gem5
+{
+
+struct MaxCapacityPartitioningPolicyParams;
+
+namespace partitioning_policy
+{
+
+/**
+ * Limits the number of blocks each partition can hold. A partition that
+ * holds its share of the cache can still allocate, but only by replacing
+ * one of its own blocks. The candidates must be CacheBlks, as the owner
+ * of a block is its source requestor.
+ */
+class MaxCapacityPartitioningPolicy : public BasePartitioningPolicy
+{
+  public:
+    typedef MaxCapacityPartitioningPolicyParams Params;
+    MaxCapacityPartitioningPolicy(const Params &p);
+
+    void filterByPartition(std::vector<ReplaceableEntry *> &entries,
+                           uint64_t partition_id) const override;
+
+    void notifyAcquire(uint64_t partition_id) override;
+    void notifyRelease(uint64_t partition_id) override;
+
+  private:
+    struct Quota
+    {
+        uint64_t maxBlocks;
+        uint64_t blocks = 0;
+    };
+
+    /** Quota and current usage of each limited partition */
+    std::unordered_map<uint64_t, Quota> quotas;
+};
+
+} // namespace partitioning_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_PARTITIONING_POLICIES_MAX_CAPACITY_PP_HH__
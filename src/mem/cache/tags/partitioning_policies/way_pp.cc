@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/partitioning_policies/way_pp.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "params/WayPartitioningPolicy.hh"
+
+namespace gem5
+{
+
+namespace partitioning_policy
+{
+
+WayPartitioningPolicy::WayPartitioningPolicy(const Params &p)
+    : BasePartitioningPolicy(p)
+{
+    fatal_if(p.partition_ids.size() != p.way_masks.size(),
+             "%s: each partition needs exactly one way mask\n", name());
+
+    for (int i = 0; i < p.partition_ids.size(); i++) {
+        fatal_if(p.way_masks[i] == 0,
+                 "%s: partition %d has no way to allocate in\n", name(),
+                 p.partition_ids[i]);
+        fatal_if(!wayMasks.emplace(p.partition_ids[i], p.way_masks[i]).second,
+                 "%s: partition %d is listed more than once\n", name(),
+                 p.partition_ids[i]);
+    }
+}
+
+void
+WayPartitioningPolicy::filterByPartition(
+    std::vector<ReplaceableEntry *> &entries, uint64_t partition_id) const
+{
+    const auto it = wayMasks.find(partition_id);
+    if (it == wayMasks.end())
+        return;
+
+    const uint64_t way_mask = it->second;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+        [way_mask](const ReplaceableEntry *entry) {
+            return entry->getWay() >= 64 ||
+                !((way_mask >> entry->getWay()) & 1);
+        }), entries.end());
+}
+
+} // namespace partitioning_policy
+} // namespace gem5
@@ -35,6 +35,7 @@
 
 #include <cassert>
 
+#include "base/bitfield.hh"
 #include "base/cprintf.hh"
 #include "base/logging.hh"
 
@@ -79,7 +80,7 @@ void
 SectorSubBlk::setValid()
 {
     CacheBlk::setValid();
-    _sectorBlk->validateSubBlk();
+    _sectorBlk->validateSubBlk(_sectorOffset);
 }
 
 void
@@ -101,7 +102,7 @@ void
 SectorSubBlk::invalidate()
 {
     CacheBlk::invalidate();
-    _sectorBlk->invalidateSubBlk();
+    _sectorBlk->invalidateSubBlk(_sectorOffset);
 }
 
 std::string
@@ -112,7 +113,7 @@ SectorSubBlk::print() const
 }
 
 SectorBlk::SectorBlk()
-    : TaggedEntry(), _validCounter(0)
+    : TaggedEntry(), _validMask(0)
 {
 }
 
@@ -120,27 +121,31 @@ bool
 SectorBlk::isValid() const
 {
     // If any of the blocks in the sector is valid, so is the sector
-    return _validCounter > 0;
+    return _validMask != 0;
 }
 
 uint8_t
 SectorBlk::getNumValid() const
 {
-    return _validCounter;
+    return popCount(_validMask);
 }
 
 void
-SectorBlk::validateSubBlk()
+SectorBlk::validateSubBlk(int offset)
 {
-    _validCounter++;
+    assert(offset < 64);
+    _validMask |= 1ULL << offset;
 }
 
 void
-SectorBlk::invalidateSubBlk()
+SectorBlk::invalidateSubBlk(int offset)
 {
+    assert(offset < 64);
+    _validMask &= ~(1ULL << offset);
+
     // If all sub-blocks have been invalidated, the sector becomes invalid,
     // so clear secure bit
-    if (--_validCounter == 0) {
+    if (_validMask == 0) {
         invalidate();
     }
 }
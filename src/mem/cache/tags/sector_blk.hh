@@ -135,10 +135,12 @@ class SectorBlk : public TaggedEntry
 {
   private:
     /**
-     * Counter of the number of valid sub-blocks. The sector is valid if any
-     * of its sub-blocks is valid.
+     * Mask of the valid sub-blocks, indexed by sector offset. The sector is
+     * valid if any of its sub-blocks is valid. Keeping the sub-blocks' state
+     * packed in the sector lets lookups and victim searches test all of them
+     * at once instead of visiting each sub-block.
      */
-    uint8_t _validCounter;
+    uint64_t _validMask;
 
   public:
     SectorBlk();
@@ -164,14 +166,38 @@ class SectorBlk : public TaggedEntry
     uint8_t getNumValid() const;
 
     /**
-     * Increase the number of valid sub-blocks.
+     * Get the mask of valid sub-blocks, where bit i is set if the sub-block
+     * at sector offset i is valid.
+     *
+     * @return The valid sub-block mask.
+     */
+    uint64_t getValidMask() const { return _validMask; }
+
+    /**
+     * Checks that a given sub-block is valid without accessing it.
+     *
+     * @param offset The sector offset of the sub-block.
+     * @return True if the sub-block is valid.
      */
-    void validateSubBlk();
+    bool
+    isSubBlkValid(int offset) const
+    {
+        return (_validMask >> offset) & 1;
+    }
 
     /**
-     * Decrease the number of valid sub-blocks.
+     * Mark a sub-block as valid.
+     *
+     * @param offset The sector offset of the sub-block.
+     */
+    void validateSubBlk(int offset);
+
+    /**
+     * Mark a sub-block as invalid.
+     *
+     * @param offset The sector offset of the sub-block.
      */
-    void invalidateSubBlk();
+    void invalidateSubBlk(int offset);
 
     /**
      * Sets the position of the sub-entries, besides its own.
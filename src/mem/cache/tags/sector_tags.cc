@@ -37,6 +37,7 @@
 #include <memory>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/types.hh"
@@ -59,12 +60,16 @@ SectorTags::SectorTags(const SectorTagsParams &p)
 {
     // There must be a indexing policy
     fatal_if(!p.indexing_policy, "An indexing policy is required");
+    fatal_if(!partitioningPolicies.empty(),
+             "Sector tags do not support partitioning policies");
 
     // Check parameters
     fatal_if(blkSize < 4 || !isPowerOf2(blkSize),
              "Block size must be at least 4 and a power of 2");
     fatal_if(!isPowerOf2(numBlocksPerSector),
              "# of blocks per sector must be non-zero and a power of 2");
+    fatal_if(numBlocksPerSector > 64,
+             "# of blocks per sector must not be larger than 64");
 }
 
 void
@@ -257,14 +262,17 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
     const Addr offset = extractSectorOffset(addr);
 
     // Find all possible sector entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
+    const std::vector<ReplaceableEntry*> &entries =
         indexingPolicy->getPossibleEntries(addr);
 
-    // Search for block
-    for (const auto& sector : entries) {
-        auto blk = static_cast<SectorBlk*>(sector)->blks[offset];
-        if (blk->matchTag(tag, is_secure)) {
-            return blk;
+    // Search for block. A valid sub-block shares its sector's tag, so only
+    // the sectors are inspected, and the sub-block is not touched unless
+    // the sector says it is valid.
+    for (const auto& entry : entries) {
+        auto sector = static_cast<SectorBlk*>(entry);
+        if (sector->matchTag(tag, is_secure) &&
+            sector->isSubBlkValid(offset)) {
+            return sector->blks[offset];
         }
     }
 
@@ -274,10 +282,11 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
 
 CacheBlk*
 SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
-                       std::vector<CacheBlk*>& evict_blks)
+                       std::vector<CacheBlk*>& evict_blks,
+                       const uint64_t partition_id)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> sector_entries =
+    const std::vector<ReplaceableEntry*> &sector_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     // Check if the sector this address belongs to has been allocated
@@ -309,10 +318,9 @@ SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
         assert(!victim->isValid());
     } else {
         // The whole sector must be evicted to make room for the new sector
-        for (const auto& blk : victim_sector->blks){
-            if (blk->isValid()) {
-                evict_blks.push_back(blk);
-            }
+        for (uint64_t mask = victim_sector->getValidMask(); mask;
+             mask &= mask - 1) {
+            evict_blks.push_back(victim_sector->blks[ctz64(mask)]);
         }
     }
 
@@ -81,12 +81,20 @@ void
 CompressionBlk::setCompressed()
 {
     _compressed = true;
+    if (getSectorBlock()) {
+        static_cast<SuperBlk*>(getSectorBlock())->setSubBlkCompressed(
+            getSectorOffset(), true);
+    }
 }
 
 void
 CompressionBlk::setUncompressed()
 {
     _compressed = false;
+    if (getSectorBlock()) {
+        static_cast<SuperBlk*>(getSectorBlock())->setSubBlkCompressed(
+            getSectorOffset(), false);
+    }
 }
 
 std::size_t
@@ -169,7 +177,7 @@ CompressionBlk::print() const
 }
 
 SuperBlk::SuperBlk()
-    : SectorBlk(), blkSize(0), compressionFactor(1)
+    : SectorBlk(), blkSize(0), compressionFactor(1), compressedMask(0)
 {
 }
 
@@ -183,14 +191,29 @@ SuperBlk::invalidate()
 bool
 SuperBlk::isCompressed(const CompressionBlk* ignored_blk) const
 {
-    for (const auto& blk : blks) {
-        if (blk->isValid() && (blk != ignored_blk)) {
-            return static_cast<CompressionBlk*>(blk)->isCompressed();
-        }
+    uint64_t valid_mask = getValidMask();
+    if (ignored_blk) {
+        valid_mask &= ~(1ULL << ignored_blk->getSectorOffset());
     }
 
     // An invalid block is seen as compressed
-    return true;
+    if (valid_mask == 0) {
+        return true;
+    }
+
+    // Otherwise the compressibility is that of the first valid block
+    return (compressedMask >> ctz64(valid_mask)) & 1;
+}
+
+void
+SuperBlk::setSubBlkCompressed(int offset, bool compressed)
+{
+    assert(offset < 64);
+    if (compressed) {
+        compressedMask |= 1ULL << offset;
+    } else {
+        compressedMask &= ~(1ULL << offset);
+    }
 }
 
 bool
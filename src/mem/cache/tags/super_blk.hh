@@ -180,6 +180,13 @@ class SuperBlk : public SectorBlk
      */
     uint8_t compressionFactor;
 
+    /**
+     * Mask of the sub-blocks holding compressed data, indexed by sector
+     * offset. It mirrors the sub-blocks' compression bits so that the
+     * superblock's compressibility is found without visiting them.
+     */
+    uint64_t compressedMask;
+
   public:
     SuperBlk();
     SuperBlk(const SuperBlk&) = delete;
@@ -195,6 +202,15 @@ class SuperBlk : public SectorBlk
      */
     bool isCompressed(const CompressionBlk* ignored_blk = nullptr) const;
 
+    /**
+     * Update the compression bit of one of the sub-blocks. Should only be
+     * called by the sub-block itself.
+     *
+     * @param offset The sector offset of the sub-block.
+     * @param compressed Whether the sub-block holds compressed data.
+     */
+    void setSubBlkCompressed(int offset, bool compressed);
+
     /**
      * Checks whether a superblock can co-allocate given compressed data block.
      *
@@ -221,14 +221,14 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
         // broadcasted to our snoopers but the source
         if (snoopFilter) {
             // check with the snoop filter where to forward this packet
-            auto sf_res = snoopFilter->lookupRequest(pkt, *src_port);
+            auto sf_res = snoopFilter->lookupRequestMask(pkt, *src_port);
             // the time required by a packet to be delivered through
             // the xbar has to be charged also with to lookup latency
             // of the snoop filter
             pkt->headerDelay += sf_res.second * clockPeriod();
             DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                     __func__, src_port->name(), pkt->print(),
-                    sf_res.first.size(), sf_res.second);
+                    sf_res.first.count(), sf_res.second);
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -236,10 +236,12 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                 // all we do is determine if the block is cached or
                 // not, instead just set it here based on the snoop
                 // filter result
-                if (!sf_res.first.empty())
+                if (sf_res.first.any())
                     pkt->setBlockCached();
             } else {
-                forwardTiming(pkt, cpu_side_port_id, sf_res.first);
+                // the snoop filter never includes the source port in
+                // the snoop targets
+                forwardTiming(pkt, sf_res.first);
             }
         } else {
             forwardTiming(pkt, cpu_side_port_id);
@@ -533,17 +535,17 @@ CoherentXBar::recvTimingSnoopReq(PacketPtr pkt, PortID mem_side_port_id)
 
     if (snoopFilter) {
         // let the Snoop Filter work its magic and guide probing
-        auto sf_res = snoopFilter->lookupSnoop(pkt);
+        auto sf_res = snoopFilter->lookupSnoopMask(pkt);
         // the time required by a packet to be delivered through
         // the xbar has to be charged also with to lookup latency
         // of the snoop filter
         pkt->headerDelay += sf_res.second * clockPeriod();
         DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                 __func__, memSidePorts[mem_side_port_id]->name(),
-                pkt->print(), sf_res.first.size(), sf_res.second);
+                pkt->print(), sf_res.first.count(), sf_res.second);
 
         // forward to all snoopers
-        forwardTiming(pkt, InvalidPortID, sf_res.first);
+        forwardTiming(pkt, sf_res.first);
     } else {
         forwardTiming(pkt, InvalidPortID);
     }
@@ -724,6 +726,32 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
     snoopFanout.sample(fanout);
 }
 
+void
+CoherentXBar::forwardTiming(PacketPtr pkt,
+                            const SnoopFilter::SnoopMask& dests)
+{
+    DPRINTF(CoherentXBar, "%s for %s\n", __func__, pkt->print());
+
+    // snoops should only happen if the system isn't bypassing caches
+    assert(!system->bypassCaches());
+    assert(snoopFilter);
+
+    const size_t fanout = dests.count();
+
+    // walk the ports until all the selected ones have seen the snoop,
+    // there is no need to look any further, or to build a list
+    for (size_t i = 0, sent = 0; sent < fanout; ++i) {
+        if (dests.test(i)) {
+            // cache is not allowed to refuse snoop
+            snoopFilter->snoopPort(i)->sendTimingSnoopReq(pkt);
+            sent++;
+        }
+    }
+
+    // Stats for fanout of this forward operation
+    snoopFanout.sample(fanout);
+}
+
 void
 CoherentXBar::recvReqRetry(PortID mem_side_port_id)
 {
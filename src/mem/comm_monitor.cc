@@ -39,6 +39,8 @@
 
 #include "mem/comm_monitor.hh"
 
+#include "base/cprintf.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/CommMonitor.hh"
 #include "sim/core.hh"
@@ -55,8 +57,26 @@ CommMonitor::CommMonitor(const Params &params)
       samplePeriodicEvent([this]{ samplePeriodic(); }, name()),
       samplePeriodTicks(params.sample_period),
       samplePeriod(params.sample_period / sim_clock::as_float::s),
+      sampleOneIn(std::max(params.sample_one_in, 1u)),
+      sampleWindow(params.sample_window),
+      sampling(sampleOneIn > 1 || sampleWindow != 0),
+      sampleCount(0),
+      epochStream(nullptr),
       stats(this, params)
 {
+    fatal_if(sampleWindow >= samplePeriodTicks,
+             "%s: sample_window must be shorter than sample_period\n",
+             name());
+
+    if (!params.epoch_file.empty()) {
+        epochStream = simout.create(params.epoch_file);
+        fatal_if(!epochStream, "%s: unable to open %s\n", name(),
+                 params.epoch_file);
+        *epochStream->stream() << "tick,read_bytes,written_bytes,"
+            "read_bandwidth,write_bandwidth,avg_read_latency,"
+            "avg_write_latency\n";
+    }
+
     DPRINTF(CommMonitor,
             "Created monitor %s with sample period %d ticks (%f ms)\n",
             name(), samplePeriodTicks, samplePeriod * 1E3);
@@ -172,7 +192,10 @@ CommMonitor::MonitorStats::MonitorStats(statistics::Group *parent,
       ADD_STAT(readAddrDist, statistics::units::Count::get(),
                "Read address distribution"),
       ADD_STAT(writeAddrDist, statistics::units::Count::get(),
-               "Write address distribution")
+               "Write address distribution"),
+      epochReadBytes(0), epochWrittenBytes(0),
+      epochReadLatency(0), epochWriteLatency(0),
+      epochReads(0), epochWrites(0)
 {
     using namespace statistics;
 
@@ -258,7 +281,7 @@ CommMonitor::MonitorStats::MonitorStats(statistics::Group *parent,
 void
 CommMonitor::MonitorStats::updateReqStats(
     const probing::PacketInfo& pkt_info, bool is_atomic,
-    bool expects_response)
+    bool expects_response, bool sampled)
 {
     if (pkt_info.cmd.isRead()) {
         // Increment number of observed read transactions
@@ -266,21 +289,21 @@ CommMonitor::MonitorStats::updateReqStats(
             ++readTrans;
 
         // Get sample of burst length
-        if (!disableBurstLengthHists)
+        if (!disableBurstLengthHists && sampled)
             readBurstLengthHist.sample(pkt_info.size);
 
         // Sample the masked address
-        if (!disableAddrDists)
+        if (!disableAddrDists && sampled)
             readAddrDist.sample(pkt_info.addr & readAddrMask);
 
         if (!disableITTDists) {
             // Sample value of read-read inter transaction time
-            if (timeOfLastRead != 0)
+            if (timeOfLastRead != 0 && sampled)
                 ittReadRead.sample(curTick() - timeOfLastRead);
             timeOfLastRead = curTick();
 
             // Sample value of req-req inter transaction time
-            if (timeOfLastReq != 0)
+            if (timeOfLastReq != 0 && sampled)
                 ittReqReq.sample(curTick() - timeOfLastReq);
             timeOfLastReq = curTick();
         }
@@ -292,7 +315,7 @@ CommMonitor::MonitorStats::updateReqStats(
         if (!disableTransactionHists)
             ++writeTrans;
 
-        if (!disableBurstLengthHists)
+        if (!disableBurstLengthHists && sampled)
             writeBurstLengthHist.sample(pkt_info.size);
 
         // Update the bandwidth stats on the request
@@ -300,19 +323,20 @@ CommMonitor::MonitorStats::updateReqStats(
             writtenBytes += pkt_info.size;
             totalWrittenBytes += pkt_info.size;
         }
+        epochWrittenBytes += pkt_info.size;
 
         // Sample the masked write address
-        if (!disableAddrDists)
+        if (!disableAddrDists && sampled)
             writeAddrDist.sample(pkt_info.addr & writeAddrMask);
 
         if (!disableITTDists) {
             // Sample value of write-to-write inter transaction time
-            if (timeOfLastWrite != 0)
+            if (timeOfLastWrite != 0 && sampled)
                 ittWriteWrite.sample(curTick() - timeOfLastWrite);
             timeOfLastWrite = curTick();
 
             // Sample value of req-to-req inter transaction time
-            if (timeOfLastReq != 0)
+            if (timeOfLastReq != 0 && sampled)
                 ittReqReq.sample(curTick() - timeOfLastReq);
             timeOfLastReq = curTick();
         }
@@ -324,7 +348,8 @@ CommMonitor::MonitorStats::updateReqStats(
 
 void
 CommMonitor::MonitorStats::updateRespStats(
-    const probing::PacketInfo& pkt_info, Tick latency, bool is_atomic)
+    const probing::PacketInfo& pkt_info, Tick latency, bool is_atomic,
+    bool sampled)
 {
     if (pkt_info.cmd.isRead()) {
         // Decrement number of outstanding read requests
@@ -333,14 +358,18 @@ CommMonitor::MonitorStats::updateRespStats(
             --outstandingReadReqs;
         }
 
-        if (!disableLatencyHists)
+        if (!disableLatencyHists && sampled) {
             readLatencyHist.sample(latency);
+            epochReadLatency += latency;
+            ++epochReads;
+        }
 
         // Update the bandwidth stats based on responses for reads
         if (!disableBandwidthHists) {
             readBytes += pkt_info.size;
             totalReadBytes += pkt_info.size;
         }
+        epochReadBytes += pkt_info.size;
 
     } else if (pkt_info.cmd.isWrite()) {
         // Decrement number of outstanding write requests
@@ -349,24 +378,43 @@ CommMonitor::MonitorStats::updateRespStats(
             --outstandingWriteReqs;
         }
 
-        if (!disableLatencyHists)
+        if (!disableLatencyHists && sampled) {
             writeLatencyHist.sample(latency);
+            epochWriteLatency += latency;
+            ++epochWrites;
+        }
     }
 }
 
+bool
+CommMonitor::sampleRequest()
+{
+    if (!sampling)
+        return true;
+
+    if (sampleWindow && curTick() % samplePeriodTicks >= sampleWindow)
+        return false;
+
+    if (++sampleCount < sampleOneIn)
+        return false;
+    sampleCount = 0;
+    return true;
+}
+
 Tick
 CommMonitor::recvAtomic(PacketPtr pkt)
 {
     const bool expects_response(pkt->needsResponse() &&
                                 !pkt->cacheResponding());
+    const bool sampled = sampleRequest();
     probing::PacketInfo req_pkt_info(pkt);
     ppPktReq->notify(req_pkt_info);
 
     const Tick delay(memSidePort.sendAtomic(pkt));
 
-    stats.updateReqStats(req_pkt_info, true, expects_response);
+    stats.updateReqStats(req_pkt_info, true, expects_response, sampled);
     if (expects_response)
-        stats.updateRespStats(req_pkt_info, delay, true);
+        stats.updateRespStats(req_pkt_info, delay, true, sampled);
 
     // Some packets, such as WritebackDirty, don't need response.
     assert(pkt->isResponse() || !expects_response);
@@ -394,22 +442,32 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
     const bool expects_response(pkt->needsResponse() &&
                                 !pkt->cacheResponding());
 
+    // Only the sampled requests carry a sender state to measure the
+    // latency with
+    const bool sampled = sampleRequest();
+    const bool track_latency = expects_response && sampled &&
+        !stats.disableLatencyHists;
+
     // If a cache miss is served by a cache, a monitor near the memory
     // would see a request which needs a response, but this response
     // would not come back from the memory. Therefore we additionally
     // have to check the cacheResponding flag
-    if (expects_response && !stats.disableLatencyHists) {
-        pkt->pushSenderState(new CommMonitorSenderState(curTick()));
+    if (track_latency) {
+        pkt->pushSenderState(new CommMonitorSenderState(curTick(), this));
     }
 
     // Attempt to send the packet
     bool successful = memSidePort.sendTimingReq(pkt);
 
     // If not successful, restore the sender state
-    if (!successful && expects_response && !stats.disableLatencyHists) {
+    if (!successful && track_latency) {
         delete pkt->popSenderState();
     }
 
+    // Sample the retry of a sampled request instead
+    if (!successful && sampled)
+        sampleCount = sampleOneIn;
+
     if (successful) {
         ppPktReq->notify(pkt_info);
     }
@@ -417,7 +475,7 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
     if (successful) {
         DPRINTF(CommMonitor, "Forwarded %s request\n", pkt->isRead() ? "read" :
                 pkt->isWrite() ? "write" : "non read/write");
-        stats.updateReqStats(pkt_info, false, expects_response);
+        stats.updateReqStats(pkt_info, false, expects_response, sampled);
     }
     return successful;
 }
@@ -436,19 +494,25 @@ CommMonitor::recvTimingResp(PacketPtr pkt)
     CommMonitorSenderState* received_state =
         dynamic_cast<CommMonitorSenderState*>(pkt->senderState);
 
-    if (!stats.disableLatencyHists) {
+    // Unsampled requests were sent without a state of this monitor
+    if (received_state && received_state->monitor != this)
+        received_state = NULL;
+    const bool sampled = received_state != NULL;
+
+    if (!stats.disableLatencyHists && !sampling) {
         // Restore initial sender state
         if (received_state == NULL)
             panic("Monitor got a response without monitor sender state\n");
+    }
 
-        // Restore the sate
+    // Restore the sate
+    if (received_state)
         pkt->senderState = received_state->predecessor;
-    }
 
     // Attempt to send the packet
     bool successful = cpuSidePort.sendTimingResp(pkt);
 
-    if (!stats.disableLatencyHists) {
+    if (received_state) {
         // If packet successfully send, sample value of latency,
         // afterwards delete sender state, otherwise restore state
         if (successful) {
@@ -466,7 +530,7 @@ CommMonitor::recvTimingResp(PacketPtr pkt)
         ppPktResp->notify(pkt_info);
         DPRINTF(CommMonitor, "Received %s response\n", pkt->isRead() ? "read" :
                 pkt->isWrite() ?  "write" : "non read/write");
-        stats.updateRespStats(pkt_info, latency, false);
+        stats.updateRespStats(pkt_info, latency, false, sampled);
     }
     return successful;
 }
@@ -555,6 +619,9 @@ CommMonitor::samplePeriodic()
         }
     }
 
+    if (epochStream)
+        writeEpoch();
+
     // reset the sampled values
     stats.readTrans = 0;
     stats.writeTrans = 0;
@@ -565,6 +632,28 @@ CommMonitor::samplePeriodic()
     schedule(samplePeriodicEvent, curTick() + samplePeriodTicks);
 }
 
+void
+CommMonitor::writeEpoch()
+{
+    auto mean = [](Tick total, uint64_t count) {
+        return count ? double(total) / count : 0.0;
+    };
+
+    ccprintf(*epochStream->stream(), "%d,%d,%d,%f,%f,%f,%f\n",
+             curTick(), stats.epochReadBytes, stats.epochWrittenBytes,
+             stats.epochReadBytes / samplePeriod,
+             stats.epochWrittenBytes / samplePeriod,
+             mean(stats.epochReadLatency, stats.epochReads),
+             mean(stats.epochWriteLatency, stats.epochWrites));
+
+    stats.epochReadBytes = 0;
+    stats.epochWrittenBytes = 0;
+    stats.epochReadLatency = 0;
+    stats.epochWriteLatency = 0;
+    stats.epochReads = 0;
+    stats.epochWrites = 0;
+}
+
 void
 CommMonitor::startup()
 {
@@ -40,6 +40,7 @@
 #ifndef __MEM_COMM_MONITOR_HH__
 #define __MEM_COMM_MONITOR_HH__
 
+#include "base/output.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/CommMonitor.hh"
@@ -99,9 +100,11 @@ class CommMonitor : public SimObject
          * calculate round-trip latency.
          *
          * @param _transmitTime Time of packet transmission
+         * @param _monitor Monitor the state belongs to
          */
-        CommMonitorSenderState(Tick _transmitTime)
-            : transmitTime(_transmitTime)
+        CommMonitorSenderState(Tick _transmitTime,
+                               const CommMonitor *_monitor)
+            : transmitTime(_transmitTime), monitor(_monitor)
         { }
 
         /** Destructor */
@@ -110,6 +113,12 @@ class CommMonitor : public SimObject
         /** Tick when request is transmitted */
         Tick transmitTime;
 
+        /**
+         * Monitor that created the state. When sampling, an unsampled
+         * response may carry the state of another monitor.
+         */
+        const CommMonitor *monitor;
+
     };
 
     /**
@@ -378,6 +387,17 @@ class CommMonitor : public SimObject
          */
         statistics::SparseHistogram writeAddrDist;
 
+        /**
+         * Counters of the current sample period for the epoch file.
+         * The latencies only cover the sampled requests.
+         */
+        uint64_t epochReadBytes;
+        uint64_t epochWrittenBytes;
+        Tick epochReadLatency;
+        Tick epochWriteLatency;
+        uint64_t epochReads;
+        uint64_t epochWrites;
+
         /**
          * Create the monitor stats and initialise all the members
          * that are not statistics themselves, but used to control the
@@ -387,11 +407,17 @@ class CommMonitor : public SimObject
             const CommMonitorParams &params);
 
         void updateReqStats(const probing::PacketInfo& pkt, bool is_atomic,
-                            bool expects_response);
+                            bool expects_response, bool sampled);
         void updateRespStats(const probing::PacketInfo& pkt, Tick latency,
-                             bool is_atomic);
+                             bool is_atomic, bool sampled);
     };
 
+    /** Whether the histograms sample the request seen now */
+    bool sampleRequest();
+
+    /** Write the counters of the sample period that just ended */
+    void writeEpoch();
+
     /** This function is called periodically at the end of each time bin */
     void samplePeriodic();
 
@@ -408,6 +434,18 @@ class CommMonitor : public SimObject
     /** Sample period in seconds */
     const double samplePeriod;
 
+    /** Sample one in this many requests */
+    const unsigned sampleOneIn;
+    /** Ticks at the start of each sample period requests are sampled */
+    const Tick sampleWindow;
+    /** Whether only part of the requests are sampled */
+    const bool sampling;
+    /** Requests seen since the last sampled one */
+    unsigned sampleCount;
+
+    /** Stream the epoch time series is written to, if any */
+    OutputStream *epochStream;
+
     /** @} */
 
     /** Instantiate stats */
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Implementation of a bridge between a requestor and a responder that
+ * are serviced by different event queues.
+ */
+
+#include "mem/cross_queue_bridge.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/CrossQueueBridge.hh"
+#include "debug/Drain.hh"
+
+namespace gem5
+{
+
+CrossQueueBridge::CPUSidePort::CPUSidePort(const std::string &_name,
+                                           CrossQueueBridge &_bridge)
+    : ResponsePort(_name, &_bridge), bridge(_bridge)
+{
+}
+
+CrossQueueBridge::MemSidePort::MemSidePort(const std::string &_name,
+                                           CrossQueueBridge &_bridge)
+    : RequestPort(_name, &_bridge), bridge(_bridge)
+{
+}
+
+CrossQueueBridge::MemSideQueue::MemSideQueue(CrossQueueBridge &_bridge,
+                                             EventManager &_em,
+                                             RequestPort &_mem_side_port)
+    : ReqPacketQueue(_em, _mem_side_port), bridge(_bridge)
+{
+}
+
+CrossQueueBridge::CPUSideQueue::CPUSideQueue(CrossQueueBridge &_bridge,
+                                             EventManager &_em,
+                                             ResponsePort &_cpu_side_port)
+    : RespPacketQueue(_em, _cpu_side_port), bridge(_bridge)
+{
+}
+
+CrossQueueBridge::CrossQueueBridge(const Params &p)
+    : SimObject(p),
+      memSideManager(getEventQueue(p.mem_side_eventq_index)),
+      cpuSidePort(name() + ".cpu_side_port", *this),
+      memSidePort(name() + ".mem_side_port", *this),
+      respQueue(*this, *this, cpuSidePort),
+      reqQueue(*this, memSideManager, memSidePort),
+      delay(p.delay), bufferSize(p.buffer_size), credits(p.buffer_size),
+      retryReq(false)
+{
+    fatal_if(bufferSize == 0, "%s: buffer_size must be non-zero\n",
+             name());
+
+    // the credits bound the number of packets in both queues
+    reqQueue.disableSanityCheck();
+    respQueue.disableSanityCheck();
+}
+
+Port &
+CrossQueueBridge::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "mem_side_port")
+        return memSidePort;
+    else if (if_name == "cpu_side_port")
+        return cpuSidePort;
+    else
+        return SimObject::getPort(if_name, idx);
+}
+
+void
+CrossQueueBridge::init()
+{
+    if (!cpuSidePort.isConnected() || !memSidePort.isConnected())
+        fatal("Both ports of a cross-queue bridge must be connected.\n");
+
+    // a packet sent during a quantum has to reach the other queue in a
+    // later quantum, or it could arrive in its past
+    fatal_if(eventQueue() != memSideManager.eventQueue() &&
+             delay < simQuantum, "%s: delay (%d) must be at least "
+             "sim_quantum (%d)\n", name(), delay, simQuantum);
+
+    cpuSidePort.sendRangeChange();
+}
+
+DrainState
+CrossQueueBridge::drain()
+{
+    // every packet in the bridge holds a credit
+    if (credits == bufferSize) {
+        return DrainState::Drained;
+    } else {
+        DPRINTF(CrossQueueBridge, "Not drained, %d packets in flight\n",
+                bufferSize - credits);
+        return DrainState::Draining;
+    }
+}
+
+void
+CrossQueueBridge::Mailbox::push(PacketPtr pkt, Tick when)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    packets.emplace_back(pkt, when);
+}
+
+std::pair<PacketPtr, Tick>
+CrossQueueBridge::Mailbox::pop()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(!packets.empty());
+    auto front = packets.front();
+    packets.pop_front();
+    return front;
+}
+
+bool
+CrossQueueBridge::Mailbox::trySatisfyFunctional(PacketPtr pkt)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &p : packets) {
+        if (pkt->trySatisfyFunctional(p.first))
+            return true;
+    }
+    return false;
+}
+
+void
+CrossQueueBridge::cross(Mailbox &mailbox, EventQueue *dest, PacketPtr pkt,
+                        Tick when, void (CrossQueueBridge::*deliver)())
+{
+    mailbox.push(pkt, when);
+
+    // Packets are delivered in the order they entered the bridge, each
+    // event moving the oldest one in the mailbox to the other side.
+    dest->schedulePooled([this, deliver]{ (this->*deliver)(); },
+                         "CrossQueueBridge delivery", when);
+}
+
+bool
+CrossQueueBridge::recvTimingReq(PacketPtr pkt)
+{
+    DPRINTF(CrossQueueBridge, "recvTimingReq: %s addr 0x%x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    // as for the bridge, the CPU may send a new request after it has
+    // been told to retry, so simply refuse it
+    if (retryReq)
+        return false;
+
+    if (credits == 0) {
+        DPRINTF(CrossQueueBridge, "No credits left\n");
+        retryReq = true;
+        return false;
+    }
+    credits--;
+
+    Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    cross(reqMailbox, memSideManager.eventQueue(), pkt,
+          curTick() + delay + receive_delay,
+          &CrossQueueBridge::deliverReq);
+    return true;
+}
+
+void
+CrossQueueBridge::deliverReq()
+{
+    auto req = reqMailbox.pop();
+    reqQueue.schedSendTiming(req.first, std::max(req.second, curTick()));
+}
+
+bool
+CrossQueueBridge::recvTimingResp(PacketPtr pkt)
+{
+    DPRINTF(CrossQueueBridge, "recvTimingResp: %s addr 0x%x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    // the credit taken by the request guarantees space for the response
+    Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    cross(respMailbox, eventQueue(), pkt,
+          curTick() + delay + receive_delay,
+          &CrossQueueBridge::deliverResp);
+    return true;
+}
+
+void
+CrossQueueBridge::deliverResp()
+{
+    auto resp = respMailbox.pop();
+    respQueue.schedSendTiming(resp.first, std::max(resp.second, curTick()));
+}
+
+void
+CrossQueueBridge::returnCredit()
+{
+    assert(credits < bufferSize);
+    credits++;
+
+    if (retryReq) {
+        DPRINTF(CrossQueueBridge, "Credit returned, now retrying\n");
+        retryReq = false;
+        cpuSidePort.sendRetryReq();
+    }
+
+    if (drainState() == DrainState::Draining && credits == bufferSize) {
+        DPRINTF(Drain, "CrossQueueBridge done draining\n");
+        signalDrainDone();
+    }
+}
+
+void
+CrossQueueBridge::returnCreditFromMemSide()
+{
+    // the credits belong to the event queue of the bridge
+    schedulePooled([this]{ returnCredit(); }, "CrossQueueBridge credit",
+                   curTick() + delay);
+}
+
+bool
+CrossQueueBridge::MemSideQueue::sendTiming(PacketPtr pkt)
+{
+    // the packet may be gone once it is sent
+    const bool needs_response = pkt->needsResponse();
+
+    if (!ReqPacketQueue::sendTiming(pkt))
+        return false;
+
+    if (!needs_response)
+        bridge.returnCreditFromMemSide();
+    return true;
+}
+
+bool
+CrossQueueBridge::CPUSideQueue::sendTiming(PacketPtr pkt)
+{
+    if (!RespPacketQueue::sendTiming(pkt))
+        return false;
+
+    bridge.returnCredit();
+    return true;
+}
+
+bool
+CrossQueueBridge::CPUSidePort::recvTimingReq(PacketPtr pkt)
+{
+    return bridge.recvTimingReq(pkt);
+}
+
+void
+CrossQueueBridge::CPUSidePort::recvRespRetry()
+{
+    bridge.respQueue.retry();
+}
+
+Tick
+CrossQueueBridge::CPUSidePort::recvAtomic(PacketPtr pkt)
+{
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    EventQueue::ScopedMigration migrate(bridge.memSideManager.eventQueue(),
+                                        inParallelMode);
+    return bridge.delay + bridge.memSidePort.sendAtomic(pkt);
+}
+
+void
+CrossQueueBridge::CPUSidePort::recvFunctional(PacketPtr pkt)
+{
+    pkt->pushLabel(name());
+
+    // check the responses before the requests, as the bridge does
+    bool found = bridge.respQueue.trySatisfyFunctional(pkt) ||
+        bridge.respMailbox.trySatisfyFunctional(pkt);
+
+    if (!found) {
+        EventQueue::ScopedMigration migrate(
+            bridge.memSideManager.eventQueue(), inParallelMode);
+
+        found = bridge.reqMailbox.trySatisfyFunctional(pkt) ||
+            bridge.reqQueue.trySatisfyFunctional(pkt);
+
+        if (!found) {
+            pkt->popLabel();
+            bridge.memSidePort.sendFunctional(pkt);
+            return;
+        }
+    }
+
+    pkt->popLabel();
+    pkt->makeResponse();
+}
+
+void
+CrossQueueBridge::CPUSidePort::recvMemBackdoorReq(const MemBackdoorReq &req,
+                                                  MemBackdoorPtr &backdoor)
+{
+    // never hand out a back door, see the class description
+}
+
+AddrRangeList
+CrossQueueBridge::CPUSidePort::getAddrRanges() const
+{
+    return bridge.memSidePort.getAddrRanges();
+}
+
+bool
+CrossQueueBridge::MemSidePort::recvTimingResp(PacketPtr pkt)
+{
+    return bridge.recvTimingResp(pkt);
+}
+
+void
+CrossQueueBridge::MemSidePort::recvReqRetry()
+{
+    bridge.reqQueue.retry();
+}
+
+void
+CrossQueueBridge::MemSidePort::recvRangeChange()
+{
+    bridge.cpuSidePort.sendRangeChange();
+}
+
+} // namespace gem5
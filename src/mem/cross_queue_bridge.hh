@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a bridge between a requestor and a responder that are
+ * serviced by different event queues.
+ */
+
+#ifndef __MEM_CROSS_QUEUE_BRIDGE_HH__
+#define __MEM_CROSS_QUEUE_BRIDGE_HH__
+
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "base/types.hh"
+#include "mem/packet_queue.hh"
+#include "mem/port.hh"
+#include "params/CrossQueueBridge.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * A cross-queue bridge connects a requestor, typically a crossbar, on
+ * the event queue of the bridge to a responder, typically a memory
+ * controller, on the event queue given by mem_side_eventq_index. This
+ * lets independent responders, such as the channels of a multi-channel
+ * memory, be simulated by their own host thread.
+ *
+ * Every packet takes a fixed delay to cross the bridge, and the delay
+ * must be at least the simulation quantum so that a packet sent in one
+ * quantum always arrives in a later one. Packets in flight are kept in
+ * a mutex-protected FIFO per direction, and the event delivering them
+ * is scheduled on the receiving queue.
+ *
+ * Flow control is credit based. The bridge accepts up to buffer_size
+ * requests, and the credit of a request is only returned once its
+ * response has been sent, or once the request has been sent if it
+ * does not need a response. This bounds the buffering on both sides
+ * without having to look at the state of the other queue.
+ *
+ * Atomic and functional accesses migrate to the memory side event
+ * queue for the duration of the access. Back doors are never handed
+ * out, as they would let the CPU side touch the memory without going
+ * through the memory side queue.
+ */
+class CrossQueueBridge : public SimObject
+{
+  protected:
+
+    class CPUSidePort : public ResponsePort
+    {
+      private:
+        CrossQueueBridge &bridge;
+
+      public:
+        CPUSidePort(const std::string &_name, CrossQueueBridge &_bridge);
+
+      protected:
+        bool recvTimingReq(PacketPtr pkt) override;
+        void recvRespRetry() override;
+        Tick recvAtomic(PacketPtr pkt) override;
+        void recvFunctional(PacketPtr pkt) override;
+        void recvMemBackdoorReq(const MemBackdoorReq &req,
+                                MemBackdoorPtr &backdoor) override;
+        AddrRangeList getAddrRanges() const override;
+    };
+
+    class MemSidePort : public RequestPort
+    {
+      private:
+        CrossQueueBridge &bridge;
+
+      public:
+        MemSidePort(const std::string &_name, CrossQueueBridge &_bridge);
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+        void recvReqRetry() override;
+        void recvRangeChange() override;
+    };
+
+    /**
+     * Queue of the requests on the memory side, returning the credit
+     * of the requests that do not need a response once they are sent.
+     */
+    class MemSideQueue : public ReqPacketQueue
+    {
+      private:
+        CrossQueueBridge &bridge;
+
+      public:
+        MemSideQueue(CrossQueueBridge &_bridge, EventManager &_em,
+                     RequestPort &_mem_side_port);
+
+      protected:
+        bool sendTiming(PacketPtr pkt) override;
+    };
+
+    /**
+     * Queue of the responses on the CPU side, returning the credit of
+     * the corresponding request once a response is sent.
+     */
+    class CPUSideQueue : public RespPacketQueue
+    {
+      private:
+        CrossQueueBridge &bridge;
+
+      public:
+        CPUSideQueue(CrossQueueBridge &_bridge, EventManager &_em,
+                     ResponsePort &_cpu_side_port);
+
+      protected:
+        bool sendTiming(PacketPtr pkt) override;
+    };
+
+    /**
+     * Packets travelling from one event queue to the other, along with
+     * the tick at which they reach the other side.
+     */
+    class Mailbox
+    {
+      private:
+        std::mutex mutex;
+        std::deque<std::pair<PacketPtr, Tick>> packets;
+
+      public:
+        void push(PacketPtr pkt, Tick when);
+        std::pair<PacketPtr, Tick> pop();
+        bool trySatisfyFunctional(PacketPtr pkt);
+    };
+
+    /** Event manager of the memory side, on a different queue. */
+    EventManager memSideManager;
+
+    CPUSidePort cpuSidePort;
+    MemSidePort memSidePort;
+
+    CPUSideQueue respQueue;
+    MemSideQueue reqQueue;
+
+    Mailbox reqMailbox;
+    Mailbox respMailbox;
+
+    /** Time a packet takes to cross the bridge. */
+    const Tick delay;
+
+    /** Number of requests the bridge can hold. */
+    const unsigned bufferSize;
+
+    /**
+     * Requests that can still be accepted. Only accessed from the
+     * event queue of the bridge.
+     */
+    unsigned credits;
+
+    /** Whether the CPU side is waiting for a retry. */
+    bool retryReq;
+
+    /**
+     * Put a packet in a mailbox and schedule its delivery on the event
+     * queue of the other side.
+     */
+    void cross(Mailbox &mailbox, EventQueue *dest, PacketPtr pkt,
+               Tick when, void (CrossQueueBridge::*deliver)());
+
+    /** Move the oldest request to the memory side queue. */
+    void deliverReq();
+
+    /** Move the oldest response to the CPU side queue. */
+    void deliverResp();
+
+    /** Give a request slot back, on the event queue of the bridge. */
+    void returnCredit();
+
+    /** Give a request slot back from the memory side. */
+    void returnCreditFromMemSide();
+
+    bool recvTimingReq(PacketPtr pkt);
+    bool recvTimingResp(PacketPtr pkt);
+
+  public:
+    PARAMS(CrossQueueBridge);
+    CrossQueueBridge(const Params &p);
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void init() override;
+
+    DrainState drain() override;
+};
+
+} // namespace gem5
+
+#endif //__MEM_CROSS_QUEUE_BRIDGE_HH__
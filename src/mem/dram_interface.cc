@@ -59,116 +59,107 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
+    // Summarise the queue per bank in a single pass, remembering the
+    // oldest row hit and the oldest row miss that can be issued to
+    // every bank. The selection is then made from the banks alone, and
+    // is the same as scanning the queue for:
+    // 1) the first seamless row hit, else
+    // 2) if the next bank can be prepped 'behind the scenes', the first
+    //    packet to one of the earliest banks, falling back on the first
+    //    prepped row hit, else
+    // 3) the first prepped row hit, falling back on the first packet
+    //    to one of the earliest banks.
+    // Closed rows are favoured in 2) to enable more open row
+    // possibilities in future selections.
+    const size_t num_banks = ranksPerChannel * banksPerRank;
+    firstRowHit.assign(num_banks, queue.end());
+    firstRowMiss.assign(num_banks, queue.end());
+    bankWaiting.assign(num_banks, false);
+
+    bool found_row_miss = false;
 
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
+    for (auto i = queue.begin(); i != queue.end() ; ++i) {
+        MemPacket* pkt = *i;
 
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
+        if (!pkt->isDram() || pkt->pseudoChannel != pseudoChannel)
+            continue;
 
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
+        // check if rank is not doing a refresh and thus is available,
+        // if not, jump to the next packet
+        if (!burstReady(pkt)) {
+            DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
+                    pkt->bank, pkt->rank);
+            continue;
+        }
 
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
+        const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+        bankWaiting[pkt->bankId] = true;
 
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+        if (bank.openRow == pkt->row) {
             const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
                                                         bank.wrAllowedAt;
+            // no additional rank-to-rank or same bank-group delays, or
+            // we switched read/write and might as well go for the row
+            // hit, so there is no need to look any further
+            if (col_allowed_at <= min_col_at) {
+                DPRINTF(DRAM, "%s Seamless buffer hit, bank %d row %d\n",
+                        __func__, pkt->bank, pkt->row);
+                return std::make_pair(i, col_allowed_at);
+            }
+            if (firstRowHit[pkt->bankId] == queue.end())
+                firstRowHit[pkt->bankId] = i;
+        } else if (firstRowMiss[pkt->bankId] == queue.end()) {
+            firstRowMiss[pkt->bankId] = i;
+            found_row_miss = true;
+        }
+    }
 
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+    auto prepped_pkt_it = queue.end();
+    for (const auto& i : firstRowHit) {
+        if (i < prepped_pkt_it)
+            prepped_pkt_it = i;
+    }
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
-                }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
+    auto earliest_pkt_it = queue.end();
+    bool hidden_bank_prep = false;
+    if (found_row_miss) {
+        // determine entries with earliest bank delay, minBankPrep will
+        // give priority to packets that can issue seamlessly
+        std::vector<uint32_t> earliest_banks;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(bankWaiting, min_col_at);
+
+        for (int r = 0; r < ranksPerChannel; r++) {
+            for (int b = 0; b < banksPerRank; b++) {
+                const auto i = firstRowMiss[r * banksPerRank + b];
+                if (bits(earliest_banks[r], b, b) && i < earliest_pkt_it)
+                    earliest_pkt_it = i;
             }
         }
     }
 
+    // give priority to packets that can issue bank commands 'behind
+    // the scenes', any additional delay if any will be due to
+    // col-to-col command requirements
+    auto selected_pkt_it = prepped_pkt_it;
+    if (earliest_pkt_it != queue.end() &&
+        (hidden_bank_prep || prepped_pkt_it == queue.end())) {
+        selected_pkt_it = earliest_pkt_it;
+    }
+
     if (selected_pkt_it == queue.end()) {
         DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        return std::make_pair(selected_pkt_it, MaxTick);
     }
 
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    const MemPacket* pkt = *selected_pkt_it;
+    const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+    DPRINTF(DRAM, "%s %s, bank %d row %d\n", __func__,
+            selected_pkt_it == prepped_pkt_it ? "Prepped row buffer hit" :
+            "Earliest bank", pkt->bank, pkt->row);
+    return std::make_pair(selected_pkt_it,
+                          pkt->isRead() ? bank.rdAllowedAt :
+                                          bank.wrAllowedAt);
 }
 
 void
@@ -798,6 +789,9 @@ DRAMInterface::isBusy(bool read_queue_empty, bool all_writes_nvm)
 {
     int busy_ranks = 0;
     for (auto r : ranks) {
+        // a rank skipping its refreshes may be in the middle of one
+        r->catchUpRefresh();
+
         if (!r->inRefIdleState()) {
             if (r->pwrState != PWR_SREF) {
                 // rank is busy refreshing
@@ -919,6 +913,9 @@ DRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 
 void DRAMInterface::setupRank(const uint8_t rank, const bool is_read)
 {
+    // bring the refresh state of the rank up to date before it is used
+    ranks[rank]->catchUpRefresh();
+
     // increment entry count of the rank based on packet type
     if (is_read) {
         ++ranks[rank]->readEntries;
@@ -992,6 +989,9 @@ DRAMInterface::drainRanks()
 {
     // also need to kick off events to exit self-refresh
     for (auto r : ranks) {
+        // let the refresh event loop drive any skipped refresh to the end
+        r->catchUpRefresh();
+
         // force self-refresh exit, which in turn will issue auto-refresh
         if (r->pwrState == PWR_SREF) {
             DPRINTF(DRAM,"Rank%d: Forcing self-refresh wakeup in drain\n",
@@ -1011,7 +1011,7 @@ DRAMInterface::allRanksDrained() const
         // closed and rank is not in a low power state. Also verify that rank
         // is idle from a refresh point of view.
         all_ranks_drained = r->inPwrIdleState() && r->inRefIdleState() &&
-            all_ranks_drained;
+            !r->inSkippedRefresh() && all_ranks_drained;
     }
     return all_ranks_drained;
 }
@@ -1025,7 +1025,7 @@ DRAMInterface::suspend()
 }
 
 std::pair<std::vector<uint32_t>, bool>
-DRAMInterface::minBankPrep(const MemPacketQueue& queue,
+DRAMInterface::minBankPrep(const std::vector<bool>& got_waiting,
                       Tick min_col_at) const
 {
     Tick min_act_at = MaxTick;
@@ -1038,16 +1038,6 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // delay on the data bus
     bool hidden_bank_prep = false;
 
-    // determine if we have queued transactions targetting the
-    // bank in question
-    std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
-            continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
-    }
-
     // Find command with optimal bank timing
     // Will prioritize commands that can issue seamlessly.
     for (int i = 0; i < ranksPerChannel; i++) {
@@ -1068,15 +1058,16 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
 
                 // latest Tick for which ACT can occur without
                 // incurring additoinal delay on the data bus
-                const Tick tRCD = ctrl->inReadBusState(false) ?
+                const Tick tRCD = ctrl->inReadBusState(false, this) ?
                                                  tRCD_RD : tRCD_WR;
                 const Tick hidden_act_max =
                             std::max(min_col_at - tRCD, curTick());
 
                 // When is the earliest the R/W burst can issue?
-                const Tick col_allowed_at = ctrl->inReadBusState(false) ?
-                                              ranks[i]->banks[j].rdAllowedAt :
-                                              ranks[i]->banks[j].wrAllowedAt;
+                const Tick col_allowed_at =
+                    ctrl->inReadBusState(false, this) ?
+                        ranks[i]->banks[j].rdAllowedAt :
+                        ranks[i]->banks[j].wrAllowedAt;
                 Tick col_at = std::max(col_allowed_at, act_at + tRCD);
 
                 // bank can issue burst back-to-back (seamlessly) with
@@ -1118,7 +1109,8 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
                          int _rank, DRAMInterface& _dram)
     : EventManager(&_dram), dram(_dram),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
-      pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
+      pwrStateTick(0), refreshDueAt(0), skippedRefreshAt(MaxTick),
+      pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
@@ -1167,6 +1159,8 @@ DRAMInterface::Rank::startup(Tick ref_tick)
 void
 DRAMInterface::Rank::suspend()
 {
+    catchUpRefresh();
+
     deschedule(refreshEvent);
 
     // Update the stats
@@ -1180,9 +1174,9 @@ bool
 DRAMInterface::Rank::isQueueEmpty() const
 {
     // check commmands in Q based on current bus direction
-    bool no_queued_cmds = (dram.ctrl->inReadBusState(true) &&
+    bool no_queued_cmds = (dram.ctrl->inReadBusState(true, &dram) &&
                           (readEntries == 0))
-                       || (dram.ctrl->inWriteBusState(true) &&
+                       || (dram.ctrl->inWriteBusState(true, &dram) &&
                           (writeEntries == 0));
     return no_queued_cmds;
 }
@@ -1282,9 +1276,98 @@ DRAMInterface::Rank::processWriteDoneEvent()
     --outstandingEvents;
 }
 
+bool
+DRAMInterface::Rank::inSkippedRefresh() const
+{
+    return (skippedRefreshAt != MaxTick) &&
+        ((curTick() - skippedRefreshAt) % (dram.tREFI - dram.tRP) <
+         dram.tRFC);
+}
+
+void
+DRAMInterface::Rank::catchUpRefresh()
+{
+    if (skippedRefreshAt == MaxTick)
+        return;
+
+    assert(curTick() >= skippedRefreshAt);
+
+    // an idle rank starts a refresh every tREFI - tRP and spends tRFC
+    // of it in PWR_REF, see the REF_RUN state below
+    const Tick period = dram.tREFI - dram.tRP;
+    const Tick num_ref = (curTick() - skippedRefreshAt) / period + 1;
+    const Tick last_ref_at = skippedRefreshAt + (num_ref - 1) * period;
+
+    DPRINTF(DRAMState, "Rank %d catching up on %llu skipped refreshes\n",
+            rank, num_ref);
+
+    // nothing was issued since the first skipped refresh, so anything
+    // left in the command list goes to DRAMPower ahead of the refreshes
+    flushCmdList();
+
+    for (Tick ref_at = skippedRefreshAt; ref_at <= last_ref_at;
+         ref_at += period) {
+        power.powerlib.doCommand(MemCommand::REF, 0,
+                                 divCeil(ref_at, dram.tCK) -
+                                 dram.timeStampOffset);
+
+        DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(ref_at, dram.tCK) -
+                dram.timeStampOffset, rank);
+    }
+
+    // all but the last refresh have run to completion
+    stats.pwrStateTime[PWR_IDLE] += (skippedRefreshAt - pwrStateTick) +
+        (num_ref - 1) * (period - dram.tRFC);
+    stats.pwrStateTime[PWR_REF] += (num_ref - 1) * dram.tRFC;
+
+    skippedRefreshAt = MaxTick;
+
+    Tick ref_done_at = last_ref_at + dram.tRFC;
+
+    for (auto &b : banks) {
+        b.actAllowedAt = ref_done_at;
+    }
+
+    refreshDueAt = last_ref_at + dram.tREFI;
+
+    if (curTick() < ref_done_at) {
+        // pick the last refresh up where the event loop would be
+        pwrState = PWR_REF;
+        pwrStateTick = last_ref_at;
+        refreshState = REF_RUN;
+        ++outstandingEvents;
+        schedule(refreshEvent, ref_done_at);
+    } else {
+        stats.pwrStateTime[PWR_REF] += dram.tRFC;
+        pwrStateTick = ref_done_at;
+        schedule(refreshEvent, refreshDueAt - dram.tRP);
+    }
+
+    // Update the stats
+    updatePowerStats();
+}
+
 void
 DRAMInterface::Rank::processRefreshEvent()
 {
+    // a rank that is idle and not allowed to power down would go
+    // through the same handful of refresh and power events every
+    // refresh interval, instead skip them until the rank is used
+    // again or its stats are needed, see catchUpRefresh
+    if ((refreshState == REF_IDLE) && !dram.enableDRAMPowerdown &&
+        (pwrState == PWR_IDLE) && (outstandingEvents == 0) &&
+        (readEntries == 0) && (writeEntries == 0) &&
+        !activateEvent.scheduled() && !prechargeEvent.scheduled() &&
+        !writeDoneEvent.scheduled() && !powerEvent.scheduled() &&
+        !wakeUpEvent.scheduled() &&
+        !((rank == dram.activeRank) &&
+          dram.ctrl->requestEventScheduled(dram.pseudoChannel)) &&
+        (dram.ctrl->drainState() == DrainState::Running)) {
+        DPRINTF(DRAMState, "Rank %d idle, skipping refreshes\n", rank);
+        skippedRefreshAt = curTick();
+        return;
+    }
+
     // when first preparing the refresh, remember when it was due
     if ((refreshState == REF_IDLE) || (refreshState == REF_SREF_EXIT)) {
         // remember when the refresh is due
@@ -1810,6 +1893,9 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
+    // account for any refreshes skipped since the last update
+    catchUpRefresh();
+
     // Update the stats
     updatePowerStats();
 
@@ -1831,7 +1917,7 @@ DRAMInterface::Rank::resetStats() {
 bool
 DRAMInterface::Rank::forceSelfRefreshExit() const {
     return (readEntries != 0) ||
-           (dram.ctrl->inWriteBusState(true) && (writeEntries != 0));
+           (dram.ctrl->inWriteBusState(true, &dram) && (writeEntries != 0));
 }
 
 void
@@ -2014,6 +2100,9 @@ DRAMInterface::RankStats::regStats()
 void
 DRAMInterface::RankStats::resetStats()
 {
+    // the skipped refreshes belong to the stats being reset
+    rank.catchUpRefresh();
+
     statistics::Group::resetStats();
 
     rank.resetStats();
@@ -256,6 +256,14 @@ class DRAMInterface : public MemInterface
          */
         Tick refreshDueAt;
 
+        /**
+         * Tick of the first refresh that was skipped because the rank
+         * was idle, or MaxTick when the refresh state machine is
+         * running. While refreshes are skipped no refresh or power
+         * events are scheduled for the rank.
+         */
+        Tick skippedRefreshAt;
+
         /**
          * Function to update Power Stats
          */
@@ -382,6 +390,22 @@ class DRAMInterface : public MemInterface
          */
         bool inPwrIdleState() const { return pwrState == PWR_IDLE; }
 
+        /**
+         * Check if the rank would be refreshing right now had its
+         * refreshes not been skipped while idle.
+         *
+         * @param Return true if a skipped refresh is in progress
+         */
+        bool inSkippedRefresh() const;
+
+        /**
+         * Account for the refreshes skipped while the rank was idle,
+         * feeding them to DRAMPower and the power state stats, and
+         * hand control back to the refresh event loop. Does nothing
+         * unless refreshes are being skipped.
+         */
+        void catchUpRefresh();
+
         /**
          * Trigger a self-refresh exit if there are entries enqueued
          * Exit if there are any read entries regardless of the bus state.
@@ -630,13 +654,24 @@ class DRAMInterface : public MemInterface
      * for the enqueued requests. Assumes maximum of 32 banks per rank
      * Also checks if the bank is already prepped.
      *
-     * @param queue Queued requests to consider
+     * @param got_waiting Banks, indexed by bank id, with queued requests
+     *                    to a rank that is not refreshing
      * @param min_col_at time of seamless burst command
      * @return One-hot encoded mask of bank indices
      * @return boolean indicating burst can issue seamlessly, with no gaps
      */
     std::pair<std::vector<uint32_t>, bool>
-    minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
+    minBankPrep(const std::vector<bool>& got_waiting, Tick min_col_at) const;
+
+    /**
+     * Per bank summary of the queue built by chooseNextFRFCFS, kept
+     * around to avoid allocating it for every scheduling decision.
+     * @{
+     */
+    mutable std::vector<MemPacketQueue::iterator> firstRowHit;
+    mutable std::vector<MemPacketQueue::iterator> firstRowMiss;
+    mutable std::vector<bool> bankWaiting;
+    /** @} */
 
     /*
      * @return time to send a burst of data without gaps
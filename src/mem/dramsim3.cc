@@ -37,6 +37,8 @@
 
 #include "mem/dramsim3.hh"
 
+#include <algorithm>
+
 #include "base/callback.hh"
 #include "base/trace.hh"
 #include "debug/DRAMsim3.hh"
@@ -58,14 +60,22 @@ DRAMsim3::DRAMsim3(const Params &p) :
                        this, 0, std::placeholders::_1)),
     wrapper(p.configFile, p.filePath, read_cb, write_cb),
     retryReq(false), retryResp(false), startTick(0),
+    transactions(wrapper.queueSize()), freeTransactions(0),
     nbrOutstandingReads(0), nbrOutstandingWrites(0),
     sendResponseEvent([this]{ sendResponse(); }, name()),
-    tickEvent([this]{ tick(); }, name())
+    tickEvent([this]{ tick(); }, name()),
+    tickPeriod(0), lastTick(0), idleCatchUpCycles(p.idleCatchUpCycles)
 {
     DPRINTF(DRAMsim3,
             "Instantiated DRAMsim3 with clock %d ns and queue size %d\n",
             wrapper.clockPeriod(), wrapper.queueSize());
 
+    fatal_if(transactions.empty(), "DRAMsim3 %s has no queue\n", name());
+    for (unsigned int i = 0; i < transactions.size(); i++)
+        transactions[i].next = i + 1;
+    transactions.back().next = NoTransaction;
+    outstandingReads.reserve(transactions.size());
+
     // Register a callback to compensate for the destructor not
     // being called. The callback prints the DRAMsim3 stats.
     registerExitCallback([this]() { wrapper.printStats(); });
@@ -92,8 +102,12 @@ DRAMsim3::startup()
 {
     startTick = curTick();
 
-    // kick off the clock ticks
-    schedule(tickEvent, clockEdge());
+    // The clock only ticks while there are transactions outstanding,
+    // with the phase it would have had when started now
+    tickPeriod = wrapper.clockPeriod() * sim_clock::as_int::ns;
+    fatal_if(tickPeriod == 0, "DRAMsim3 %s clock period is too short\n",
+             name());
+    lastTick = curTick();
 }
 
 void
@@ -140,20 +154,40 @@ DRAMsim3::nbrOutstanding() const
 void
 DRAMsim3::tick()
 {
-    // Only tick when it's timing mode
-    if (system()->isTimingMode()) {
-        wrapper.tick();
-
-        // is the connected port waiting for a retry, if so check the
-        // state and send a retry if conditions have changed
-        if (retryReq && nbrOutstanding() < wrapper.queueSize()) {
-            retryReq = false;
-            port.sendRetryReq();
-        }
+    wrapper.tick();
+    lastTick = curTick();
+
+    // is the connected port waiting for a retry, if so check the
+    // state and send a retry if conditions have changed
+    if (retryReq && nbrOutstanding() < wrapper.queueSize()) {
+        retryReq = false;
+        port.sendRetryReq();
     }
 
-    schedule(tickEvent,
-        curTick() + wrapper.clockPeriod() * sim_clock::as_int::ns);
+    // stop ticking when DRAMsim3 has nothing left to do, the next
+    // request wakes it up
+    if (nbrOutstandingReads + nbrOutstandingWrites != 0 &&
+        !tickEvent.scheduled())
+        schedule(tickEvent, curTick() + tickPeriod);
+}
+
+void
+DRAMsim3::wakeUp()
+{
+    if (tickEvent.scheduled())
+        return;
+
+    // the cycles which would have been ticked while idle
+    Tick missed = (curTick() - lastTick) / tickPeriod;
+    Tick catch_up = std::min<Tick>(missed, idleCatchUpCycles);
+
+    DPRINTF(DRAMsim3, "Waking up after %d idle cycles\n", missed);
+
+    for (Tick i = 0; i < catch_up; i++)
+        wrapper.tick();
+    lastTick += missed * tickPeriod;
+
+    schedule(tickEvent, lastTick + tickPeriod);
 }
 
 Tick
@@ -201,7 +235,17 @@ DRAMsim3::recvTimingReq(PacketPtr pkt)
     // keep track of the transaction
     if (pkt->isRead()) {
         if (can_accept) {
-            outstandingReads[pkt->getAddr()].push(pkt);
+            unsigned int id = freeTransactions;
+            assert(id != NoTransaction);
+            freeTransactions = transactions[id].next;
+            transactions[id] = {pkt, NoTransaction};
+
+            auto p = outstandingReads.emplace(pkt->getAddr(),
+                                              TransactionList{id, id});
+            if (!p.second) {
+                transactions[p.first->second.tail].next = id;
+                p.first->second.tail = id;
+            }
 
             // we count a transaction as outstanding until it has left the
             // queue in the controller, and the response has been sent
@@ -210,8 +254,6 @@ DRAMsim3::recvTimingReq(PacketPtr pkt)
         }
     } else if (pkt->isWrite()) {
         if (can_accept) {
-            outstandingWrites[pkt->getAddr()].push(pkt);
-
             ++nbrOutstandingWrites;
 
             // perform the access for writes
@@ -224,6 +266,9 @@ DRAMsim3::recvTimingReq(PacketPtr pkt)
     }
 
     if (can_accept) {
+        // bring DRAMsim3 up to date before it sees the transaction
+        wakeUp();
+
         // we should never have a situation when we think there is space,
         // and there isn't
         assert(wrapper.canAccept(pkt->getAddr(), pkt->isWrite()));
@@ -300,11 +345,16 @@ void DRAMsim3::readComplete(unsigned id, uint64_t addr)
 
     // first in first out, which is not necessarily true, but it is
     // the best we can do at this point
-    PacketPtr pkt = p->second.front();
-    p->second.pop();
+    unsigned int trans_id = p->second.head;
+    PacketPtr pkt = transactions[trans_id].pkt;
 
-    if (p->second.empty())
+    if (trans_id == p->second.tail)
         outstandingReads.erase(p);
+    else
+        p->second.head = transactions[trans_id].next;
+
+    transactions[trans_id] = {nullptr, freeTransactions};
+    freeTransactions = trans_id;
 
     // no need to check for drain here as the next call will add a
     // response to the response queue straight away
@@ -320,16 +370,8 @@ void DRAMsim3::writeComplete(unsigned id, uint64_t addr)
 
     DPRINTF(DRAMsim3, "Write to address %lld complete\n", addr);
 
-    // get the outstanding reads for the address in question
-    auto p = outstandingWrites.find(addr);
-    assert(p != outstandingWrites.end());
-
     // we have already responded, and this is only to keep track of
     // what is outstanding
-    p->second.pop();
-    if (p->second.empty())
-        outstandingWrites.erase(p);
-
     assert(nbrOutstandingWrites != 0);
     --nbrOutstandingWrites;
 
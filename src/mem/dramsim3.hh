@@ -44,8 +44,8 @@
 #define __MEM_DRAMSIM3_HH__
 
 #include <functional>
-#include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include "mem/abstract_mem.hh"
 #include "mem/dramsim3_wrapper.hh"
@@ -121,13 +121,34 @@ class DRAMsim3 : public AbstractMemory
     Tick startTick;
 
     /**
-     * Keep track of what packets are outstanding per
-     * address, and do so separately for reads and writes. This is
-     * done so that we can return the right packet on completion from
-     * DRAMSim.
+     * Reads which DRAMsim3 has not completed yet, indexed by their
+     * transaction ID. The slots are allocated once, as there cannot be
+     * more transactions in flight than the queue size, and the free
+     * ones are kept in a list.
      */
-    std::unordered_map<Addr, std::queue<PacketPtr> > outstandingReads;
-    std::unordered_map<Addr, std::queue<PacketPtr> > outstandingWrites;
+    struct Transaction
+    {
+        PacketPtr pkt;
+        /** Next transaction to the same address, or the next free one */
+        unsigned int next;
+    };
+    std::vector<Transaction> transactions;
+    unsigned int freeTransactions;
+
+    /**
+     * DRAMsim3 only reports the address of a completed read, so the
+     * reads to each address are kept in the order they were issued, as
+     * a list of transactions. Writes are responded to straight away and
+     * are only counted.
+     */
+    struct TransactionList
+    {
+        unsigned int head;
+        unsigned int tail;
+    };
+    std::unordered_map<Addr, TransactionList> outstandingReads;
+
+    static constexpr unsigned int NoTransaction = -1;
 
     /**
      * Count the number of outstanding transactions so that we can
@@ -173,6 +194,21 @@ class DRAMsim3 : public AbstractMemory
      */
     EventFunctionWrapper tickEvent;
 
+    /**
+     * Start ticking again after an idle period. DRAMsim3 is first
+     * ticked for the cycles since the last tick, at most
+     * idleCatchUpCycles of them.
+     */
+    void wakeUp();
+
+    /** Length of a DRAMsim3 cycle */
+    Tick tickPeriod;
+
+    /** Time of the last DRAMsim3 cycle */
+    Tick lastTick;
+
+    const unsigned int idleCatchUpCycles;
+
     /**
      * Upstream caches need this packet until true is returned, so
      * hold it for deletion until a subsequent call
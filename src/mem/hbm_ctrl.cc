@@ -65,6 +65,7 @@ HBMCtrl::HBMCtrl(const HBMCtrlParams &p) :
 
     fatal_if(!pc0Int, "Memory controller must have pc0 interface");
     fatal_if(!pc1Int, "Memory controller must have pc1 interface");
+    fatal_if(p.compressor, "HBMCtrl does not support compression.\n");
 
     pc0Int->setCtrl(this, commandWindow, 0);
     pc1Int->setCtrl(this, commandWindow, 1);
@@ -133,6 +134,17 @@ HBMCtrl::recvFunctional(PacketPtr pkt)
     }
 }
 
+void
+HBMCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &backdoor)
+{
+    bool found = pc0Int && recvMemBackdoorReqLogic(req, backdoor, pc0Int);
+
+    if (!found && pc1Int) {
+        recvMemBackdoorReqLogic(req, backdoor, pc1Int);
+    }
+}
+
 Tick
 HBMCtrl::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor)
 {
@@ -155,9 +167,9 @@ HBMCtrl::writeQueueFullPC0(unsigned int neededEntries) const
 {
     DPRINTF(MemCtrl,
             "Write queue limit %d, PC0 size %d, entries needed %d\n",
-            writeBufferSize, writeQueueSizePC0, neededEntries);
+            writeBufferSize, bus.writeQueueSize, neededEntries);
 
-    unsigned int wrsize_new = (writeQueueSizePC0 + neededEntries);
+    unsigned int wrsize_new = (bus.writeQueueSize + neededEntries);
     return wrsize_new > (writeBufferSize/2);
 }
 
@@ -166,9 +178,9 @@ HBMCtrl::writeQueueFullPC1(unsigned int neededEntries) const
 {
     DPRINTF(MemCtrl,
             "Write queue limit %d, PC1 size %d, entries needed %d\n",
-            writeBufferSize, writeQueueSizePC1, neededEntries);
+            writeBufferSize, busPC1.writeQueueSize, neededEntries);
 
-    unsigned int wrsize_new = (writeQueueSizePC1 + neededEntries);
+    unsigned int wrsize_new = (busPC1.writeQueueSize + neededEntries);
     return wrsize_new > (writeBufferSize/2);
 }
 
@@ -177,11 +189,11 @@ HBMCtrl::readQueueFullPC0(unsigned int neededEntries) const
 {
     DPRINTF(MemCtrl,
             "Read queue limit %d, PC0 size %d, entries needed %d\n",
-            readBufferSize, readQueueSizePC0 + respQueue.size(),
+            readBufferSize, bus.readQueueSize + respQueue.size(),
             neededEntries);
 
-    unsigned int rdsize_new = readQueueSizePC0 + respQueue.size()
-                                               + neededEntries;
+    unsigned int rdsize_new = bus.readQueueSize + respQueue.size()
+                                                + neededEntries;
     return rdsize_new > (readBufferSize/2);
 }
 
@@ -190,11 +202,11 @@ HBMCtrl::readQueueFullPC1(unsigned int neededEntries) const
 {
     DPRINTF(MemCtrl,
             "Read queue limit %d, PC1 size %d, entries needed %d\n",
-            readBufferSize, readQueueSizePC1 + respQueuePC1.size(),
+            readBufferSize, busPC1.readQueueSize + respQueuePC1.size(),
             neededEntries);
 
-    unsigned int rdsize_new = readQueueSizePC1 + respQueuePC1.size()
-                                               + neededEntries;
+    unsigned int rdsize_new = busPC1.readQueueSize + respQueuePC1.size()
+                                                   + neededEntries;
     return rdsize_new > (readBufferSize/2);
 }
 
@@ -229,15 +241,11 @@ HBMCtrl::recvTimingReq(PacketPtr pkt)
     }
     prevArrival = curTick();
 
-    // What type of media does this packet access?
-    bool is_pc0;
-
-    // TODO: make the interleaving bit across pseudo channels a parameter
-    if (bits(pkt->getAddr(), 6) == 0) {
-        is_pc0 = true;
-    } else {
-        is_pc0 = false;
-    }
+    // Which pseudo channel does this packet access? The pseudo channel
+    // interleaving is given by the address ranges of the interfaces
+    bool is_pc0 = pc0Int->getAddrRange().contains(pkt->getAddr());
+    panic_if(!is_pc0 && !pc1Int->getAddrRange().contains(pkt->getAddr()),
+             "Can't handle address range for packet %s\n", pkt->print());
 
     // Find out how many memory packets a pkt translates to
     // If the burst size is equal or larger than the pkt size, then a pkt
@@ -264,6 +272,10 @@ HBMCtrl::recvTimingReq(PacketPtr pkt)
                 return false;
             } else {
                 addToWriteQueue(pkt, pkt_count, pc0Int);
+                if (!nextReqEvent.scheduled()) {
+                    DPRINTF(MemCtrl, "Request scheduled immediately\n");
+                    schedule(nextReqEvent, curTick());
+                }
                 stats.writeReqs++;
                 stats.bytesWrittenSys += size;
             }
@@ -278,6 +290,10 @@ HBMCtrl::recvTimingReq(PacketPtr pkt)
                 return false;
             } else {
                 addToWriteQueue(pkt, pkt_count, pc1Int);
+                if (!nextReqEventPC1.scheduled()) {
+                    DPRINTF(MemCtrl, "Request scheduled immediately\n");
+                    schedule(nextReqEventPC1, curTick());
+                }
                 stats.writeReqs++;
                 stats.bytesWrittenSys += size;
             }
@@ -292,7 +308,7 @@ HBMCtrl::recvTimingReq(PacketPtr pkt)
                                         HBMCtrl::readQueueFull(pkt_count)) {
                 DPRINTF(MemCtrl, "Read queue full, not accepting\n");
                 // remember that we have to retry this port
-                retryRdReqPC1 = true;
+                MemCtrl::retryRdReq = true;
                 stats.numRdRetry++;
                 return false;
             } else {
@@ -488,6 +504,12 @@ HBMCtrl::drainResume()
     isTimingMode = system()->isTimingMode();
 }
 
+MemCtrl::DataBus &
+HBMCtrl::dataBus(const MemInterface *mem_intr)
+{
+    return mem_intr->pseudoChannel == 0 ? bus : busPC1;
+}
+
 AddrRangeList
 HBMCtrl::getAddrRanges()
 {
@@ -59,7 +59,9 @@ class DRAMInterface;
  * the HBM memory controller should be able to control both pseudo channels.
  * This HBM memory controller inherits from gem5's default
  * memory controller (pseudo channel 0) and manages the additional HBM pseudo
- * channel (pseudo channel 1).
+ * channel (pseudo channel 1). Each pseudo channel is scheduled by its own
+ * event and turns its data bus around on its own, only the command bus
+ * arbitration is shared.
  */
 class HBMCtrl : public MemCtrl
 {
@@ -87,6 +89,8 @@ class HBMCtrl : public MemCtrl
 
     AddrRangeList getAddrRanges() override;
 
+    DataBus &dataBus(const MemInterface *mem_intr) override;
+
   public:
     HBMCtrl(const HBMCtrlParams &p);
 
@@ -158,14 +162,12 @@ class HBMCtrl : public MemCtrl
     bool writeQueueFullPC1(unsigned int pkt_count) const;
 
     /**
-     * Following counters are used to keep track of the entries in read/write
-     * queue for each pseudo channel (useful when the partitioned queues are
-     * used)
+     * State of the data bus of the second pseudo channel, the first
+     * pseudo channel uses MemCtrl::bus. The bus states also keep track
+     * of the queue entries of each pseudo channel (useful when the
+     * partitioned queues are used)
      */
-    uint64_t readQueueSizePC0 = 0;
-    uint64_t readQueueSizePC1 = 0;
-    uint64_t writeQueueSizePC0 = 0;
-    uint64_t writeQueueSizePC1 = 0;
+    DataBus busPC1;
 
     /**
      * Response queue for pkts sent to second pseudo channel
@@ -254,6 +256,8 @@ class HBMCtrl : public MemCtrl
     Tick recvAtomic(PacketPtr pkt) override;
     Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor) override;
     void recvFunctional(PacketPtr pkt) override;
+    void recvMemBackdoorReq(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor) override;
     bool recvTimingReq(PacketPtr pkt) override;
 
 };
@@ -69,6 +69,7 @@ HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
             "HeteroMemCtrl's dram interface must be of type DRAMInterface.\n");
     fatal_if(dynamic_cast<NVMInterface*>(nvm) == nullptr,
             "HeteroMemCtrl's nvm interface must be of type NVMInterface.\n");
+    fatal_if(p.compressor, "HeteroMemCtrl does not support compression.\n");
 
     // hook up interfaces to the controller
     dram->setCtrl(this, commandWindow);
@@ -385,6 +386,15 @@ HeteroMemCtrl::pktSizeCheck(MemPacket* mem_pkt, MemInterface* mem_intr) const
     }
 }
 
+void
+HeteroMemCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &backdoor)
+{
+    if (!recvMemBackdoorReqLogic(req, backdoor, dram)) {
+        recvMemBackdoorReqLogic(req, backdoor, nvm);
+    }
+}
+
 void
 HeteroMemCtrl::recvFunctional(PacketPtr pkt)
 {
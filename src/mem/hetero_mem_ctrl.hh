@@ -133,6 +133,8 @@ class HeteroMemCtrl : public MemCtrl
 
     Tick recvAtomic(PacketPtr pkt) override;
     void recvFunctional(PacketPtr pkt) override;
+    void recvMemBackdoorReq(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor) override;
     bool recvTimingReq(PacketPtr pkt) override;
 
 };
@@ -37,6 +37,9 @@
 
 #include "mem/mem_checker.hh"
 
+#include <algorithm>
+#include <iterator>
+
 #include "base/logging.hh"
 #include "sim/cur_tick.hh"
 
@@ -45,7 +48,7 @@ namespace gem5
 
 void
 MemChecker::WriteCluster::startWrite(MemChecker::Serial serial, Tick _start,
-                                     uint8_t data)
+                                     const uint8_t *data, size_t size)
 {
     assert(!isComplete());
 
@@ -66,15 +69,15 @@ MemChecker::WriteCluster::startWrite(MemChecker::Serial serial, Tick _start,
     }
 
     // Create new transaction, and denote completion time to be in the future.
-    writes.insert(std::make_pair(serial,
-                  MemChecker::Transaction(serial, _start, TICK_FUTURE, data)));
+    writes.emplace_back(Transaction(serial, _start, TICK_FUTURE, data, size));
 }
 
 void
 MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
     Tick _complete)
 {
-    auto it = writes.find(serial);
+    auto it = std::find_if(writes.begin(), writes.end(),
+        [serial](const Transaction &write) { return write.serial == serial; });
 
     if (it == writes.end()) {
         warn("Could not locate write transaction: serial = %d, "
@@ -83,8 +86,8 @@ MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
     }
 
     // Record completion time of the write
-    assert(it->second.complete == TICK_FUTURE);
-    it->second.complete = _complete;
+    assert(it->complete == TICK_FUTURE);
+    it->complete = _complete;
 
     // Update max completion time for the cluster
     if (completeMax < _complete) {
@@ -105,10 +108,14 @@ MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
 void
 MemChecker::WriteCluster::abortWrite(MemChecker::Serial serial)
 {
-    if (!writes.erase(serial)) {
+    auto it = std::find_if(writes.begin(), writes.end(),
+        [serial](const Transaction &write) { return write.serial == serial; });
+
+    if (it == writes.end()) {
         warn("Could not locate write transaction: serial = %d\n", serial);
         return;
     }
+    writes.erase(it);
 
     if (--numIncomplete == 0 && !writes.empty()) {
         // This write cluster is now complete, and we can assign the current
@@ -121,16 +128,50 @@ MemChecker::WriteCluster::abortWrite(MemChecker::Serial serial)
     // getIncompleteWriteCluster().
 }
 
+bool
+MemChecker::WriteCluster::sameTiming(const WriteCluster &rhs) const
+{
+    if (start != rhs.start || complete != rhs.complete ||
+        completeMax != rhs.completeMax ||
+        numIncomplete != rhs.numIncomplete ||
+        writes.size() != rhs.writes.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < writes.size(); ++i) {
+        if (!writes[i].sameTiming(rhs.writes[i]))
+            return false;
+    }
+    return true;
+}
+
+void
+MemChecker::WriteCluster::splitData(size_t offset, WriteCluster &upper)
+{
+    for (size_t i = 0; i < writes.size(); ++i)
+        writes[i].splitData(offset, upper.writes[i]);
+}
+
 void
-MemChecker::ByteTracker::startRead(MemChecker::Serial serial, Tick start)
+MemChecker::WriteCluster::mergeData(const WriteCluster &upper)
 {
-    outstandingReads.insert(std::make_pair(serial,
-            MemChecker::Transaction(serial, start, TICK_FUTURE)));
+    for (size_t i = 0; i < writes.size(); ++i) {
+        writes[i].data.insert(writes[i].data.end(),
+                              upper.writes[i].data.begin(),
+                              upper.writes[i].data.end());
+    }
+}
+
+void
+MemChecker::RangeTracker::startRead(MemChecker::Serial serial, Tick start)
+{
+    assert(outstandingReads.empty() ||
+           outstandingReads.back().serial < serial);
+    outstandingReads.emplace_back(Transaction(serial, start, TICK_FUTURE));
 }
 
 bool
-MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
-    uint8_t data)
+MemChecker::RangeTracker::inExpectedData(Tick start, Tick complete,
+    size_t offset, uint8_t data)
 {
     _lastExpectedData.clear();
 
@@ -145,9 +186,7 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
     // preceding & overlapping writes.
     for (auto cluster = writeClusters.rbegin();
          cluster != writeClusters.rend() && wc_overlap; ++cluster) {
-        for (const auto& addr_write : cluster->writes) {
-            const Transaction& write = addr_write.second;
-
+        for (const auto& write : cluster->writes) {
             if (write.complete < last_obs.start) {
                 // If this write transaction completed before the last
                 // observation, we ignore it as the last_observation has the
@@ -155,13 +194,13 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
                 continue;
             }
 
-            if (write.data == data) {
+            if (write.data[offset] == data) {
                 // Found a match, end search.
                 return true;
             }
 
             // Record possible, but non-matching data for debugging
-            _lastExpectedData.push_back(write.data);
+            _lastExpectedData.push_back(write.data[offset]);
 
             if (write.complete > start) {
                 // This write overlapped with the transaction we want to check
@@ -192,12 +231,12 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
         // The last observation is not outdated according to the writes we have
         // seen so far.
         assert(last_obs.complete <= start);
-        if (last_obs.data == data) {
+        if (last_obs.data[offset] == data) {
             // Matched data from last observation -> all good
             return true;
         }
         // Record non-matching, but possible value
-        _lastExpectedData.push_back(last_obs.data);
+        _lastExpectedData.push_back(last_obs.data[offset]);
     } else {
         // We have not seen any valid observation, and the only writes
         // observed are overlapping, so anything (in particular the
@@ -223,32 +262,38 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
 }
 
 bool
-MemChecker::ByteTracker::completeRead(MemChecker::Serial serial,
-                                      Tick complete, uint8_t data)
+MemChecker::RangeTracker::completeRead(MemChecker::Serial serial,
+                                       Tick complete, const uint8_t *data)
 {
-    auto it = outstandingReads.find(serial);
+    _lastMismatches.clear();
+
+    auto it = std::lower_bound(outstandingReads.begin(),
+        outstandingReads.end(), Transaction(serial, 0, 0));
 
-    if (it == outstandingReads.end()) {
+    if (it == outstandingReads.end() || it->serial != serial) {
         // Can happen if concurrent with reset_address_range
         warn("Could not locate read transaction: serial = %d, complete = %d\n",
              serial, complete);
         return true;
     }
 
-    Tick start = it->second.start;
+    Tick start = it->start;
     outstandingReads.erase(it);
 
     // Verify data
-    const bool result = inExpectedData(start, complete, data);
+    for (size_t i = 0; i < _size && !unchecked; ++i) {
+        if (!inExpectedData(start, complete, i, data[i]))
+            _lastMismatches.push_back({i, _lastExpectedData});
+    }
 
-    readObservations.emplace_back(serial, start, complete, data);
+    readObservations.emplace_back(serial, start, complete, data, _size);
     pruneTransactions();
 
-    return result;
+    return _lastMismatches.empty();
 }
 
 MemChecker::WriteCluster*
-MemChecker::ByteTracker::getIncompleteWriteCluster()
+MemChecker::RangeTracker::getIncompleteWriteCluster()
 {
     if (writeClusters.empty() || writeClusters.back().isComplete()) {
         writeClusters.emplace_back();
@@ -258,14 +303,14 @@ MemChecker::ByteTracker::getIncompleteWriteCluster()
 }
 
 void
-MemChecker::ByteTracker::startWrite(MemChecker::Serial serial, Tick start,
-                                    uint8_t data)
+MemChecker::RangeTracker::startWrite(MemChecker::Serial serial, Tick start,
+                                     const uint8_t *data)
 {
-    getIncompleteWriteCluster()->startWrite(serial, start, data);
+    getIncompleteWriteCluster()->startWrite(serial, start, data, _size);
 }
 
 void
-MemChecker::ByteTracker::completeWrite(MemChecker::Serial serial,
+MemChecker::RangeTracker::completeWrite(MemChecker::Serial serial,
     Tick complete)
 {
     getIncompleteWriteCluster()->completeWrite(serial, complete);
@@ -273,19 +318,19 @@ MemChecker::ByteTracker::completeWrite(MemChecker::Serial serial,
 }
 
 void
-MemChecker::ByteTracker::abortWrite(MemChecker::Serial serial)
+MemChecker::RangeTracker::abortWrite(MemChecker::Serial serial)
 {
     getIncompleteWriteCluster()->abortWrite(serial);
 }
 
 void
-MemChecker::ByteTracker::pruneTransactions()
+MemChecker::RangeTracker::pruneTransactions()
 {
     // Obtain tick of first outstanding read. If there are no outstanding
     // reads, we use curTick(), i.e. we will remove all readObservation except
     // the most recent one.
     const Tick before = outstandingReads.empty() ? curTick() :
-                        outstandingReads.begin()->second.start;
+                        outstandingReads.front().start;
 
     // Pruning of readObservations
     readObservations.erase(readObservations.begin(),
@@ -296,6 +341,178 @@ MemChecker::ByteTracker::pruneTransactions()
         writeClusters.erase(writeClusters.begin(),
                             lastCompletedTransaction(&writeClusters, before));
     }
+
+    const bool quiescent = outstandingReads.empty() &&
+        (writeClusters.empty() || writeClusters.back().isComplete());
+    if (unchecked && quiescent) {
+        // Nothing started before the history was dropped is in flight
+        // anymore; start over as if the range had not been accessed yet.
+        DPRINTF(MemChecker, "resuming checks\n");
+        forgetHistory();
+        unchecked = false;
+        return;
+    }
+
+    const size_t max_history = _parent->maxHistory;
+    if (max_history == 0 ||
+        readObservations.size() + writeClusters.size() <= max_history) {
+        return;
+    }
+
+    // Reads in flight may have observed any value of the dropped history,
+    // so they cannot be checked anymore.
+    DPRINTF(MemChecker, "dropping history: %d observations, %d write "
+            "clusters\n", readObservations.size(), writeClusters.size());
+    forgetHistory();
+    unchecked = true;
+}
+
+void
+MemChecker::RangeTracker::forgetHistory()
+{
+    // Only the last cluster can still have writes in flight, keep it so
+    // that they can complete.
+    readObservations.clear();
+    readObservations.emplace_back(
+        Transaction(SERIAL_INITIAL, TICK_INITIAL, TICK_INITIAL));
+    if (writeClusters.back().isComplete()) {
+        writeClusters.clear();
+    } else {
+        writeClusters.erase(writeClusters.begin(),
+                            std::prev(writeClusters.end()));
+    }
+}
+
+MemChecker::RangeTracker
+MemChecker::RangeTracker::split(size_t offset)
+{
+    assert(offset > 0 && offset < _size);
+
+    RangeTracker upper(*this);
+    upper._addr = _addr + offset;
+    upper._size = _size - offset;
+    _size = offset;
+
+    auto upper_obs = upper.readObservations.begin();
+    for (auto &obs : readObservations)
+        obs.splitData(offset, *upper_obs++);
+
+    auto upper_cluster = upper.writeClusters.begin();
+    for (auto &cluster : writeClusters)
+        cluster.splitData(offset, *upper_cluster++);
+
+    return upper;
+}
+
+bool
+MemChecker::RangeTracker::mergeable(const RangeTracker &upper) const
+{
+    if (end() != upper.start() || unchecked != upper.unchecked ||
+        outstandingReads.size() != upper.outstandingReads.size() ||
+        readObservations.size() != upper.readObservations.size() ||
+        writeClusters.size() != upper.writeClusters.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < outstandingReads.size(); ++i) {
+        if (!outstandingReads[i].sameTiming(upper.outstandingReads[i]))
+            return false;
+    }
+
+    auto upper_obs = upper.readObservations.begin();
+    for (const auto &obs : readObservations) {
+        if (!obs.sameTiming(*upper_obs++))
+            return false;
+    }
+
+    auto upper_cluster = upper.writeClusters.begin();
+    for (const auto &cluster : writeClusters) {
+        if (!cluster.sameTiming(*upper_cluster++))
+            return false;
+    }
+
+    return true;
+}
+
+void
+MemChecker::RangeTracker::merge(const RangeTracker &upper)
+{
+    assert(mergeable(upper));
+
+    auto upper_obs = upper.readObservations.begin();
+    for (auto &obs : readObservations) {
+        obs.data.insert(obs.data.end(), upper_obs->data.begin(),
+                        upper_obs->data.end());
+        ++upper_obs;
+    }
+
+    auto upper_cluster = upper.writeClusters.begin();
+    for (auto &cluster : writeClusters)
+        cluster.mergeData(*upper_cluster++);
+
+    _size += upper._size;
+}
+
+void
+MemChecker::splitTrackers(Addr addr)
+{
+    auto it = trackers.upper_bound(addr);
+    if (it == trackers.begin())
+        return;
+
+    RangeTracker &tracker = (--it)->second;
+    if (tracker.start() == addr || tracker.end() <= addr)
+        return;
+
+    trackers.emplace_hint(std::next(it), addr,
+                          tracker.split(addr - tracker.start()));
+}
+
+std::pair<MemChecker::TrackerMap::iterator, MemChecker::TrackerMap::iterator>
+MemChecker::getTrackers(Addr addr, size_t size)
+{
+    const Addr end = addr + size;
+    splitTrackers(addr);
+    splitTrackers(end);
+
+    // Fill the gaps between the existing trackers with fresh ones
+    auto first = trackers.lower_bound(addr);
+    auto it = first;
+    for (Addr cur = addr; cur < end; cur = (it++)->second.end()) {
+        if (it == trackers.end() || it->first > cur) {
+            const Addr gap_end =
+                it == trackers.end() ? end : std::min(end, it->first);
+            it = trackers.emplace_hint(it, cur,
+                                       RangeTracker(cur, gap_end - cur, this));
+            if (cur == addr)
+                first = it;
+        }
+    }
+
+    return std::make_pair(first, it);
+}
+
+void
+MemChecker::mergeTrackers(Addr addr, size_t size)
+{
+    const Addr end = addr + size;
+
+    auto it = trackers.lower_bound(addr);
+    if (it != trackers.begin())
+        --it;
+
+    while (it != trackers.end()) {
+        auto next = std::next(it);
+        if (next == trackers.end() || next->first > end)
+            break;
+
+        if (it->second.mergeable(next->second)) {
+            it->second.merge(next->second);
+            trackers.erase(next);
+        } else {
+            it = next;
+        }
+    }
 }
 
 bool
@@ -308,12 +525,17 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
             "completing read: serial = %d, complete = %d, "
             "addr = %#llx, size = %d\n", serial, complete, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        ByteTracker *tracker = getByteTracker(addr + i);
+    auto range = getTrackers(addr, size);
+    for (auto it = range.first; it != range.second; ++it) {
+        RangeTracker &tracker = it->second;
+        const uint8_t *tracker_data = data + (tracker.start() - addr);
 
-        if (!tracker->completeRead(serial, complete, data[i])) {
-            // Generate error message, and aggregate all failures for the bytes
-            // considered in this transaction in one message.
+        if (tracker.completeRead(serial, complete, tracker_data))
+            continue;
+
+        // Generate error message, and aggregate all failures for the bytes
+        // considered in this transaction in one message.
+        for (const auto &mismatch : tracker.lastMismatches()) {
             if (result) {
                 result = false;
                 errorMessage = "";
@@ -323,17 +545,18 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
 
             errorMessage += csprintf("  Read transaction for address %#llx "
                                      "failed: received %#x, expected ",
-                                     (unsigned long long)(addr + i), data[i]);
+                                     (unsigned long long)(tracker.start() +
+                                                          mismatch.offset),
+                                     tracker_data[mismatch.offset]);
 
-            for (size_t j = 0; j < tracker->lastExpectedData().size(); ++j) {
+            for (size_t j = 0; j < mismatch.expected.size(); ++j) {
                 errorMessage +=
-                    csprintf("%#x%s",
-                             tracker->lastExpectedData()[j],
-                             (j == tracker->lastExpectedData().size() - 1)
-                             ? "" : "|");
+                    csprintf("%#x%s", mismatch.expected[j],
+                             (j == mismatch.expected.size() - 1) ? "" : "|");
             }
         }
     }
+    mergeTrackers(addr, size);
 
     if (!result) {
         DPRINTF(MemChecker, "read of %#llx @ cycle %d failed:\n%s\n", addr,
@@ -346,9 +569,10 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
 void
 MemChecker::reset(Addr addr, size_t size)
 {
-    for (size_t i = 0; i < size; ++i) {
-        byte_trackers.erase(addr + i);
-    }
+    splitTrackers(addr);
+    splitTrackers(addr + size);
+    trackers.erase(trackers.lower_bound(addr),
+                   trackers.lower_bound(addr + size));
 }
 
 } // namespace gem5
@@ -43,11 +43,10 @@
 #include <list>
 #include <map>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/cprintf.hh"
-#include "base/named.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "debug/MemChecker.hh"
@@ -70,6 +69,11 @@ namespace gem5
  * on the particular location, and we do not consider the effect of multi-byte
  * reads or writes. This precludes us from discovering single-copy atomicity
  * violations.
+ *
+ * Locations are tracked as ranges of bytes which have seen the same
+ * transactions, so a transaction is only recorded once per range rather than
+ * once per byte. Ranges are split when an access covers part of one, and
+ * merged again once their histories match.
 */
 class MemChecker : public SimObject
 {
@@ -95,11 +99,6 @@ class MemChecker : public SimObject
      */
     static const Tick    TICK_FUTURE  = MaxTick;
 
-    /**
-     * Initial data value. No requirements.
-     */
-    static const uint8_t DATA_INITIAL   = 0x00;
-
     /**
      * The Transaction class captures the lifetimes of read and write
      * operations, and the values they consumed or produced respectively.
@@ -110,12 +109,38 @@ class MemChecker : public SimObject
 
         Transaction(Serial _serial,
                     Tick _start, Tick _complete,
-                    uint8_t _data = DATA_INITIAL)
+                    const uint8_t *_data = nullptr, size_t size = 0)
             : serial(_serial),
               start(_start), complete(_complete),
-              data(_data)
+              data(_data, _data + size)
         {}
 
+        /**
+         * @return true if both transactions are the same operation, ignoring
+         *         their data.
+         */
+        bool
+        sameTiming(const Transaction &rhs) const
+        {
+            return serial == rhs.serial && start == rhs.start &&
+                complete == rhs.complete;
+        }
+
+        /**
+         * Moves the data from offset onwards to another transaction.
+         *
+         * @param offset Offset of the first byte to move.
+         * @param upper  Transaction receiving the data.
+         */
+        void
+        splitData(size_t offset, Transaction &upper)
+        {
+            if (data.empty())
+                return;
+            upper.data.assign(data.begin() + offset, data.end());
+            data.resize(offset);
+        }
+
       public:
         Serial serial; //!< Unique identifying serial
         Tick start;    //!< Start tick
@@ -124,12 +149,14 @@ class MemChecker : public SimObject
         /**
          * Depending on the memory operation, the data value either represents:
          * for writes, the value written upon start; for reads, the value read
-         * upon completion.
+         * upon completion. The data covers the range of the tracker holding
+         * the transaction, and is empty for outstanding reads and the initial
+         * observation.
          */
-        uint8_t data;
+        std::vector<uint8_t> data;
 
         /**
-         * Orders Transactions for use with std::map.
+         * Orders Transactions by serial.
          */
         bool operator<(const Transaction& rhs) const
         { return serial < rhs.serial; }
@@ -155,8 +182,10 @@ class MemChecker : public SimObject
          * @param _start  When the write was sent off to the memory subsystem.
          * @param data    The data that this write passed to the memory
          *                subsystem.
+         * @param size    Number of bytes in data.
          */
-        void startWrite(Serial serial, Tick _start, uint8_t data);
+        void startWrite(Serial serial, Tick _start, const uint8_t *data,
+                        size_t size);
 
         /**
          * Completes a write transaction.
@@ -179,15 +208,33 @@ class MemChecker : public SimObject
          */
         bool isComplete() const { return complete != TICK_FUTURE; }
 
+        /**
+         * @return true if both clusters hold the same writes in the same
+         *         state, ignoring their data.
+         */
+        bool sameTiming(const WriteCluster &rhs) const;
+
+        /**
+         * Moves the data from offset onwards to another cluster holding the
+         * same writes.
+         */
+        void splitData(size_t offset, WriteCluster &upper);
+
+        /**
+         * Appends the data of another cluster holding the same writes.
+         */
+        void mergeData(const WriteCluster &upper);
+
       public:
         Tick start;     //!< Start of earliest write in cluster
         Tick complete;  //!< Completion of last write in cluster
 
         /**
-         * Map of Serial --> Transaction of all writes in cluster; contains
-         * all, in-flight or already completed.
+         * All writes in cluster in the order they were started; contains
+         * all, in-flight or already completed. Clusters are small, so a
+         * vector is searched faster than a map.
          */
-        std::unordered_map<Serial, Transaction> writes;
+        std::vector<Transaction> writes;
 
       private:
         Tick completeMax;
@@ -198,26 +245,42 @@ class MemChecker : public SimObject
     typedef std::list<WriteCluster> WriteClusterList;
 
     /**
-     * The ByteTracker keeps track of transactions for the *same byte* -- all
-     * outstanding reads, the completed reads (and what they observed) and write
-     * clusters (see WriteCluster).
+     * The RangeTracker keeps track of transactions for a range of bytes which
+     * have all seen the same transactions -- all outstanding reads, the
+     * completed reads (and what they observed) and write clusters (see
+     * WriteCluster). Each byte is still checked on its own.
      */
-    class ByteTracker : public Named
+    class RangeTracker
     {
       public:
+        /**
+         * A byte which did not match the expected data upon a read.
+         */
+        struct Mismatch
+        {
+            size_t offset; //!< Offset of the byte in the range
+            std::vector<uint8_t> expected; //!< Possible values
+        };
 
-        ByteTracker(Addr addr = 0, const MemChecker *parent = NULL)
-            : Named((parent != NULL ? parent->name() : "") +
-                     csprintf(".ByteTracker@%#llx", addr))
+        RangeTracker(Addr addr, size_t size, const MemChecker *parent)
+            : _addr(addr), _size(size), _parent(parent), unchecked(false)
         {
             // The initial transaction has start == complete == TICK_INITIAL,
             // indicating that there has been no real write to this location;
             // therefore, upon checking, we do not expect any particular value.
             readObservations.emplace_back(
-                    Transaction(SERIAL_INITIAL, TICK_INITIAL, TICK_INITIAL,
-                                DATA_INITIAL));
+                    Transaction(SERIAL_INITIAL, TICK_INITIAL, TICK_INITIAL));
+        }
+
+        std::string
+        name() const
+        {
+            return csprintf("%s.RangeTracker@%#llx", _parent->name(), _addr);
         }
 
+        Addr start() const { return _addr; }
+        Addr end() const { return _addr + _size; }
+
         /**
          * Starts a read transaction.
          *
@@ -228,10 +291,10 @@ class MemChecker : public SimObject
 
         /**
          * Given a start and end time (of any read transaction), this function
-         * iterates through all data that such a read is expected to see. The
-         * data parameter is the actual value that we observed, and the
-         * function immediately returns true when a match is found, false
-         * otherwise.
+         * iterates through all data that such a read is expected to see for
+         * one byte of the range. The data parameter is the actual value that
+         * we observed, and the function immediately returns true when a match
+         * is found, false otherwise.
          *
          * The set of expected data are:
          *
@@ -246,20 +309,25 @@ class MemChecker : public SimObject
          *
          * @param start     Start time of transaction to validate.
          * @param complete  End time of transaction to validate.
+         * @param offset    Offset of the byte in the range.
          * @param data      The value that we have actually seen.
          *
          * @return          True if a match is found, false otherwise.
          */
-        bool inExpectedData(Tick start, Tick complete, uint8_t data);
+        bool inExpectedData(Tick start, Tick complete, size_t offset,
+                            uint8_t data);
 
         /**
          * Completes a read transaction that is still outstanding.
          *
          * @param serial   Unique identifier of a read *previously started*.
          * @param complete When the read got a response.
-         * @param data     The data returned by the memory subsystem.
+         * @param data     The data returned by the memory subsystem for the
+         *                 range.
+         *
+         * @return True if all bytes are in the expected set, false otherwise.
          */
-        bool completeRead(Serial serial, Tick complete, uint8_t data);
+        bool completeRead(Serial serial, Tick complete, const uint8_t *data);
 
         /**
          * Starts a write transaction. Wrapper to startWrite of WriteCluster
@@ -268,9 +336,9 @@ class MemChecker : public SimObject
          * @param serial  Unique identifier of the write.
          * @param start   When the write was sent off to the memory subsystem.
          * @param data    The data that this write passed to the memory
-         *                subsystem.
+         *                subsystem for the range.
          */
-        void startWrite(Serial serial, Tick start, uint8_t data);
+        void startWrite(Serial serial, Tick start, const uint8_t *data);
 
         /**
          * Completes a write transaction. Wrapper to startWrite of WriteCluster
@@ -290,16 +358,30 @@ class MemChecker : public SimObject
         void abortWrite(Serial serial);
 
         /**
-         * This function returns the expected data that inExpectedData iterated
-         * through in the last call. If inExpectedData last returned true, the
-         * set may be incomplete; if inExpectedData last returned false, the
-         * vector will contain the full set.
+         * Splits the range in two, keeping the bytes before offset.
          *
-         * @return Reference to internally maintained vector maintaining last
-         *         expected data that inExpectedData iterated through.
+         * @param offset Offset of the first byte of the upper range.
+         * @return Tracker for the upper range, with the same history.
          */
-        const std::vector<uint8_t>& lastExpectedData() const
-        { return _lastExpectedData; }
+        RangeTracker split(size_t offset);
+
+        /**
+         * @return true if this tracker is directly followed by upper and both
+         *         have seen the same transactions.
+         */
+        bool mergeable(const RangeTracker &upper) const;
+
+        /**
+         * Appends a range that is mergeable() to this one.
+         */
+        void merge(const RangeTracker &upper);
+
+        /**
+         * The bytes which did not match in the last call of completeRead,
+         * with the expected data that inExpectedData iterated through.
+         */
+        const std::vector<Mismatch>& lastMismatches() const
+        { return _lastMismatches; }
 
       private:
 
@@ -342,19 +424,35 @@ class MemChecker : public SimObject
          *
          * It depends on the contention / overlap between memory operations to
          * the same location of a particular workload how large each of them
-         * would grow.
+         * would grow. Once they grow beyond the history limit of the checker,
+         * the completed history is dropped, and reads of the range are not
+         * checked until no transaction is in flight anymore.
          */
         void pruneTransactions();
 
+        /**
+         * Drops all read observations and completed write clusters.
+         */
+        void forgetHistory();
+
       private:
+        Addr _addr;   //!< First byte of the range
+        size_t _size; //!< Number of bytes in the range
+
+        const MemChecker *_parent;
 
         /**
-         * Maintains a map of Serial -> Transaction for all outstanding reads.
-         *
-         * Use an ordered map here, as this makes pruneTransactions() more
-         * efficient (find first outstanding read).
+         * Set while reads are not checked, as part of the history they may
+         * have observed was dropped.
          */
-        std::map<Serial, Transaction> outstandingReads;
+        bool unchecked;
+
+        /**
+         * All outstanding reads, ordered by serial as they are started in
+         * order. This makes pruneTransactions() efficient (find first
+         * outstanding read).
+         */
+        std::vector<Transaction> outstandingReads;
 
         /**
          * List of completed reads, i.e. observations of reads.
@@ -367,16 +465,22 @@ class MemChecker : public SimObject
         WriteClusterList writeClusters;
 
         /**
-         * See lastExpectedData().
+         * See inExpectedData().
          */
         std::vector<uint8_t> _lastExpectedData;
+
+        /**
+         * See lastMismatches().
+         */
+        std::vector<Mismatch> _lastMismatches;
     };
 
   public:
 
     MemChecker(const MemCheckerParams &p)
         : SimObject(p),
-          nextSerial(SERIAL_INITIAL)
+          nextSerial(SERIAL_INITIAL),
+          maxHistory(p.max_history)
     {}
 
     virtual ~MemChecker() {}
@@ -452,7 +556,7 @@ class MemChecker : public SimObject
      * the reset with serial S.
      */
     void reset()
-    { byte_trackers.clear(); }
+    { trackers.clear(); }
 
     /**
      * Resets an address-range. This may be useful in case other unmonitored
@@ -476,18 +580,29 @@ class MemChecker : public SimObject
     const std::string& getErrorMessage() const { return errorMessage; }
 
   private:
+    typedef std::map<Addr, RangeTracker> TrackerMap;
+
     /**
-     * Returns the instance of ByteTracker for the requested location.
+     * Splits the tracker containing addr, if any, so that a tracker starts
+     * at addr.
      */
-    ByteTracker* getByteTracker(Addr addr)
-    {
-        auto it = byte_trackers.find(addr);
-        if (it == byte_trackers.end()) {
-            it = byte_trackers.insert(
-                std::make_pair(addr, ByteTracker(addr, this))).first;
-        }
-        return &it->second;
-    };
+    void splitTrackers(Addr addr);
+
+    /**
+     * Returns the trackers covering exactly the requested range, creating
+     * trackers for the locations not seen so far.
+     *
+     * @return Iterators to the first tracker in the range, and past the
+     *         last one.
+     */
+    std::pair<TrackerMap::iterator, TrackerMap::iterator>
+    getTrackers(Addr addr, size_t size);
+
+    /**
+     * Merges the trackers in and around a range whose histories match
+     * again.
+     */
+    void mergeTrackers(Addr addr, size_t size);
 
   private:
     /**
@@ -502,17 +617,23 @@ class MemChecker : public SimObject
     Serial nextSerial;
 
     /**
-     * Maintain a map of address --> byte-tracker. Per-byte entries are
-     * initialized as needed.
+     * Maximum number of read observations and write clusters kept per
+     * tracker, zero if unbounded.
+     */
+    const size_t maxHistory;
+
+    /**
+     * Maintain a map of start address --> range-tracker, for ranges that do
+     * not overlap. Entries are initialized as needed.
      *
      * The required space for this obviously grows with the number of distinct
      * addresses used for a particular workload. The used size is independent on
-     * the number of nodes in the system, those may affect the size of per-byte
-     * tracking information.
+     * the number of nodes in the system, those may affect the size of
+     * per-range tracking information.
      *
-     * Access via getByteTracker()!
+     * Access via getTrackers()!
      */
-    std::unordered_map<Addr, ByteTracker> byte_trackers;
+    TrackerMap trackers;
 };
 
 inline MemChecker::Serial
@@ -522,8 +643,9 @@ MemChecker::startRead(Tick start, Addr addr, size_t size)
             "starting read: serial = %d, start = %d, addr = %#llx, "
             "size = %d\n", nextSerial, start, addr , size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->startRead(nextSerial, start);
+    auto range = getTrackers(addr, size);
+    for (auto it = range.first; it != range.second; ++it) {
+        it->second.startRead(nextSerial, start);
     }
 
     return nextSerial++;
@@ -536,8 +658,9 @@ MemChecker::startWrite(Tick start, Addr addr, size_t size, const uint8_t *data)
             "starting write: serial = %d, start = %d, addr = %#llx, "
             "size = %d\n", nextSerial, start, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->startWrite(nextSerial, start, data[i]);
+    auto range = getTrackers(addr, size);
+    for (auto it = range.first; it != range.second; ++it) {
+        it->second.startWrite(nextSerial, start, data + (it->first - addr));
     }
 
     return nextSerial++;
@@ -551,9 +674,11 @@ MemChecker::completeWrite(MemChecker::Serial serial, Tick complete,
             "completing write: serial = %d, complete = %d, "
             "addr = %#llx, size = %d\n", serial, complete, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->completeWrite(serial, complete);
+    auto range = getTrackers(addr, size);
+    for (auto it = range.first; it != range.second; ++it) {
+        it->second.completeWrite(serial, complete);
     }
+    mergeTrackers(addr, size);
 }
 
 inline void
@@ -563,9 +688,11 @@ MemChecker::abortWrite(MemChecker::Serial serial, Addr addr, size_t size)
             "aborting write: serial = %d, addr = %#llx, size = %d\n",
             serial, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->abortWrite(serial);
+    auto range = getTrackers(addr, size);
+    for (auto it = range.first; it != range.second; ++it) {
+        it->second.abortWrite(serial);
     }
+    mergeTrackers(addr, size);
 }
 
 } // namespace gem5
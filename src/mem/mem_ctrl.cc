@@ -46,6 +46,8 @@
 #include "debug/MemCtrl.hh"
 #include "debug/NVM.hh"
 #include "debug/QOS.hh"
+#include "mem/cache/compressors/base.hh"
+#include "mem/cache/prefetch/associative_set_impl.hh"
 #include "mem/dram_interface.hh"
 #include "mem/mem_interface.hh"
 #include "mem/nvm_interface.hh"
@@ -72,12 +74,15 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
     writeLowThreshold(writeBufferSize * p.write_low_thresh_perc / 100.0),
     minWritesPerSwitch(p.min_writes_per_switch),
     minReadsPerSwitch(p.min_reads_per_switch),
-    writesThisTime(0), readsThisTime(0),
     memSchedPolicy(p.mem_sched_policy),
     frontendLatency(p.static_frontend_latency),
     backendLatency(p.static_backend_latency),
     commandWindow(p.command_window),
     prevArrival(0),
+    compressor(p.compressor),
+    compMetadata(p.comp_metadata_assoc, p.comp_metadata_entries,
+                 p.comp_metadata_indexing_policy,
+                 p.comp_metadata_replacement_policy),
     stats(*this)
 {
     DPRINTF(MemCtrl, "Setting up controller\n");
@@ -269,6 +274,7 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
             DPRINTF(MemCtrl, "Adding to read queue\n");
 
             readQueue[mem_pkt->qosValue()].push_back(mem_pkt);
+            dataBus(mem_intr).readQueueSize++;
 
             // log packet
             logRequest(MemCtrl::READ, pkt->requestorId(),
@@ -340,8 +346,13 @@ MemCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pkt_count,
             DPRINTF(MemCtrl, "Adding to write queue\n");
 
             writeQueue[mem_pkt->qosValue()].push_back(mem_pkt);
+            dataBus(mem_intr).writeQueueSize++;
             isInWriteQueue.insert(burstAlign(addr, mem_intr));
 
+            // The backing store is stale until the write is performed, so
+            // any back door that was handed out has to be revoked
+            mem_intr->invalidateBackdoor();
+
             // log packet
             logRequest(MemCtrl::WRITE, pkt->requestorId(),
                        pkt->qosValue(), mem_pkt->addr, 1);
@@ -442,6 +453,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
             stats.numWrRetry++;
             return false;
         } else {
+            pkt_count = compressWrite(pkt, pkt_count);
             addToWriteQueue(pkt, pkt_count, dram);
             // If we are not already scheduled to get a request out of the
             // queue, do so now
@@ -462,6 +474,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
             stats.numRdRetry++;
             return false;
         } else {
+            pkt_count = compressedReadBursts(pkt, pkt_count);
             if (!addToReadQueue(pkt, pkt_count, dram)) {
                 // If we are not already scheduled to get a request out of the
                 // queue, do so now
@@ -503,15 +516,15 @@ MemCtrl::processRespondEvent(MemInterface* mem_intr,
             // so we can now respond to the requestor
             // @todo we probably want to have a different front end and back
             // end latency for split packets
-            accessAndRespond(mem_pkt->pkt, frontendLatency + backendLatency,
-                             mem_intr);
+            accessAndRespond(mem_pkt->pkt, frontendLatency + backendLatency +
+                             decompressionLatency(mem_pkt->pkt), mem_intr);
             delete mem_pkt->burstHelper;
             mem_pkt->burstHelper = NULL;
         }
     } else {
         // it is not a split packet
-        accessAndRespond(mem_pkt->pkt, frontendLatency + backendLatency,
-                         mem_intr);
+        accessAndRespond(mem_pkt->pkt, frontendLatency + backendLatency +
+                         decompressionLatency(mem_pkt->pkt), mem_intr);
     }
 
     queue.pop_front();
@@ -572,7 +585,8 @@ MemCtrl::chooseNext(MemPacketQueue& queue, Tick extra_col_delay,
             // check if there is a packet going to a free rank
             for (auto i = queue.begin(); i != queue.end(); ++i) {
                 MemPacket* mem_pkt = *i;
-                if (packetReady(mem_pkt, mem_intr)) {
+                if (mem_pkt->pseudoChannel == mem_intr->pseudoChannel &&
+                    packetReady(mem_pkt, mem_intr)) {
                     ret = i;
                     break;
                 }
@@ -609,6 +623,97 @@ MemCtrl::chooseNextFRFCFS(MemPacketQueue& queue, Tick extra_col_delay,
     return std::make_pair(selected_pkt_it, col_allowed_at);
 }
 
+bool
+MemCtrl::isCompressedAccess(PacketPtr pkt) const
+{
+    return compressor && pkt->getSize() == compressor->getBlockSize() &&
+        (pkt->getAddr() % pkt->getSize()) == 0;
+}
+
+unsigned
+MemCtrl::compressWrite(PacketPtr pkt, unsigned pkt_count)
+{
+    if (!isCompressedAccess(pkt)) {
+        // a partial write leaves the line stored uncompressed
+        if (compressor) {
+            compressedLines.erase(
+                roundDown(pkt->getAddr(), compressor->getBlockSize()));
+        }
+        return pkt_count;
+    }
+
+    Cycles comp_lat, decomp_lat;
+    const std::size_t size_bits = compressor->compress(
+        pkt->getConstPtr<uint64_t>(), comp_lat, decomp_lat)->getSizeBits();
+    const unsigned bursts = std::max<unsigned>(1,
+        divCeil(size_bits, CHAR_BIT * dram->bytesPerBurst()));
+
+    // the metadata is written along with the data
+    accessCompMetadata(pkt->getAddr());
+
+    if (bursts >= pkt_count) {
+        compressedLines.erase(pkt->getAddr());
+        return pkt_count;
+    }
+
+    DPRINTF(MemCtrl, "Write to addr %#x compressed to %d bursts\n",
+            pkt->getAddr(), bursts);
+    compressedLines[pkt->getAddr()] = {bursts, decomp_lat};
+    stats.compWriteBurstsSaved += pkt_count - bursts;
+    return bursts;
+}
+
+unsigned
+MemCtrl::compressedReadBursts(PacketPtr pkt, unsigned pkt_count)
+{
+    if (!isCompressedAccess(pkt))
+        return pkt_count;
+
+    // without the metadata the size of the line is not known, and the
+    // whole line is read, its metadata along with it
+    if (!accessCompMetadata(pkt->getAddr())) {
+        stats.compMetadataMisses++;
+        return pkt_count;
+    }
+    stats.compMetadataHits++;
+
+    auto it = compressedLines.find(pkt->getAddr());
+    if (it == compressedLines.end())
+        return pkt_count;
+
+    DPRINTF(MemCtrl, "Read to addr %#x compressed to %d bursts\n",
+            pkt->getAddr(), it->second.bursts);
+    stats.compReadBurstsSaved += pkt_count - it->second.bursts;
+    return it->second.bursts;
+}
+
+bool
+MemCtrl::accessCompMetadata(Addr addr)
+{
+    const Addr line = addr / compressor->getBlockSize();
+
+    TaggedEntry *entry = compMetadata.findEntry(line, false);
+    if (entry) {
+        compMetadata.accessEntry(entry);
+        return true;
+    }
+
+    entry = compMetadata.findVictim(line);
+    compMetadata.insertEntry(line, false, entry);
+    return false;
+}
+
+Tick
+MemCtrl::decompressionLatency(PacketPtr pkt) const
+{
+    if (!isCompressedAccess(pkt) || !pkt->isRead())
+        return 0;
+
+    auto it = compressedLines.find(pkt->getAddr());
+    return it == compressedLines.end() ? 0 :
+        cyclesToTicks(it->second.decompLat);
+}
+
 void
 MemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
                                                 MemInterface* mem_intr)
@@ -758,28 +863,32 @@ MemCtrl::verifyMultiCmd(Tick cmd_tick, Tick max_cmds_per_burst,
 }
 
 bool
-MemCtrl::inReadBusState(bool next_state) const
+MemCtrl::inReadBusState(bool next_state, const MemInterface *mem_intr)
 {
+    const DataBus &data_bus = dataBus(mem_intr);
+
     // check the bus state
     if (next_state) {
-        // use busStateNext to get the state that will be used
+        // use the next state to get the state that will be used
         // for the next burst
-        return (busStateNext == MemCtrl::READ);
+        return (data_bus.stateNext == MemCtrl::READ);
     } else {
-        return (busState == MemCtrl::READ);
+        return (data_bus.state == MemCtrl::READ);
     }
 }
 
 bool
-MemCtrl::inWriteBusState(bool next_state) const
+MemCtrl::inWriteBusState(bool next_state, const MemInterface *mem_intr)
 {
+    const DataBus &data_bus = dataBus(mem_intr);
+
     // check the bus state
     if (next_state) {
-        // use busStateNext to get the state that will be used
+        // use the next state to get the state that will be used
         // for the next burst
-        return (busStateNext == MemCtrl::WRITE);
+        return (data_bus.stateNext == MemCtrl::WRITE);
     } else {
-        return (busState == MemCtrl::WRITE);
+        return (data_bus.state == MemCtrl::WRITE);
     }
 }
 
@@ -810,13 +919,13 @@ MemCtrl::doBurstAccess(MemPacket* mem_pkt, MemInterface* mem_intr)
 
     // Update the common bus stats
     if (mem_pkt->isRead()) {
-        ++readsThisTime;
+        ++dataBus(mem_intr).readsThisTime;
         // Update latency stats
         stats.requestorReadTotalLat[mem_pkt->requestorId()] +=
             mem_pkt->readyTime - mem_pkt->entryTime;
         stats.requestorReadBytes[mem_pkt->requestorId()] += mem_pkt->size;
     } else {
-        ++writesThisTime;
+        ++dataBus(mem_intr).writesThisTime;
         stats.requestorWriteBytes[mem_pkt->requestorId()] += mem_pkt->size;
         stats.requestorWriteTotalLat[mem_pkt->requestorId()] +=
             mem_pkt->readyTime - mem_pkt->entryTime;
@@ -834,7 +943,7 @@ MemCtrl::memBusy(MemInterface* mem_intr) {
     // Default state of unused interface is 'true'
     bool mem_busy = true;
     bool all_writes_nvm = mem_intr->numWritesQueued == totalWriteQueueSize;
-    bool read_queue_empty = totalReadQueueSize == 0;
+    bool read_queue_empty = dataBus(mem_intr).readQueueSize == 0;
     mem_busy = mem_intr->isBusy(read_queue_empty, all_writes_nvm);
     if (mem_busy) {
         // if all ranks are refreshing wait for them to finish
@@ -874,39 +983,48 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
+    // Only the data bus of this interface is turned around, the
+    // interfaces of other pseudo channels keep their own direction
+    DataBus &data_bus = dataBus(mem_intr);
+
     // transition is handled by QoS algorithm if enabled
     if (turnPolicy) {
         // select bus state - only done if QoS algorithms are in use
-        busStateNext = selectNextBusState();
+        busState = data_bus.state;
+        data_bus.stateNext = selectNextBusState();
     }
 
     // detect bus state change
-    bool switched_cmd_type = (busState != busStateNext);
+    bool switched_cmd_type = (data_bus.state != data_bus.stateNext);
     // record stats
-    recordTurnaroundStats();
+    recordTurnaroundStats(data_bus.state, data_bus.stateNext);
 
     DPRINTF(MemCtrl, "QoS Turnarounds selected state %s %s\n",
-            (busState==MemCtrl::READ)?"READ":"WRITE",
+            (data_bus.state==MemCtrl::READ)?"READ":"WRITE",
             switched_cmd_type?"[turnaround triggered]":"");
 
     if (switched_cmd_type) {
-        if (busState == MemCtrl::READ) {
+        if (data_bus.state == MemCtrl::READ) {
             DPRINTF(MemCtrl,
                     "Switching to writes after %d reads with %d reads "
-                    "waiting\n", readsThisTime, totalReadQueueSize);
-            stats.rdPerTurnAround.sample(readsThisTime);
-            readsThisTime = 0;
+                    "waiting\n", data_bus.readsThisTime,
+                    data_bus.readQueueSize);
+            stats.rdPerTurnAround.sample(data_bus.readsThisTime);
+            data_bus.readsThisTime = 0;
         } else {
             DPRINTF(MemCtrl,
                     "Switching to reads after %d writes with %d writes "
-                    "waiting\n", writesThisTime, totalWriteQueueSize);
-            stats.wrPerTurnAround.sample(writesThisTime);
-            writesThisTime = 0;
+                    "waiting\n", data_bus.writesThisTime,
+                    data_bus.writeQueueSize);
+            stats.wrPerTurnAround.sample(data_bus.writesThisTime);
+            data_bus.writesThisTime = 0;
         }
     }
 
     // updates current state
-    busState = busStateNext;
+    data_bus.state = data_bus.stateNext;
+    // the QoS policies and stats follow the bus scheduled last
+    busState = busStateNext = data_bus.state;
 
     nonDetermReads(mem_intr);
 
@@ -915,18 +1033,18 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
     }
 
     // when we get here it is either a read or a write
-    if (busState == READ) {
+    if (data_bus.state == READ) {
 
         // track if we should switch or not
         bool switch_to_writes = false;
 
-        if (totalReadQueueSize == 0) {
+        if (data_bus.readQueueSize == 0) {
             // In the case there is no read request to go next,
             // trigger writes if we have passed the low threshold (or
             // if we are draining)
-            if (!(totalWriteQueueSize == 0) &&
+            if (!(data_bus.writeQueueSize == 0) &&
                 (drainState() == DrainState::Draining ||
-                 totalWriteQueueSize > writeLowThreshold)) {
+                 data_bus.writeQueueSize > writeLowThreshold)) {
 
                 DPRINTF(MemCtrl,
                         "Switching to writes due to read queue empty\n");
@@ -937,6 +1055,7 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
                 // ensuring all banks are closed and
                 // have exited low power states
                 if (drainState() == DrainState::Draining &&
+                    !totalReadQueueSize && !totalWriteQueueSize &&
                     respQEmpty() && allIntfDrained()) {
 
                     DPRINTF(Drain, "MemCtrl controller done draining\n");
@@ -1019,15 +1138,17 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
             // there are no other writes that can issue
             // Also ensure that we've issued a minimum defined number
             // of reads before switching, or have emptied the readQ
-            if ((totalWriteQueueSize > writeHighThreshold) &&
-               (readsThisTime >= minReadsPerSwitch || totalReadQueueSize == 0)
-               && !(nvmWriteBlock(mem_intr))) {
-                switch_to_writes = true;
-            }
-
             // remove the request from the queue
             // the iterator is no longer valid .
             readQueue[mem_pkt->qosValue()].erase(to_read);
+            data_bus.readQueueSize--;
+
+            if ((data_bus.writeQueueSize > writeHighThreshold) &&
+               (data_bus.readsThisTime >= minReadsPerSwitch ||
+                data_bus.readQueueSize == 0)
+               && !(nvmWriteBlock(mem_intr))) {
+                switch_to_writes = true;
+            }
         }
 
         // switching to writes, either because the read queue is empty
@@ -1035,7 +1156,7 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
         // draining), or because the writes hit the hight threshold
         if (switch_to_writes) {
             // transition to writing
-            busStateNext = WRITE;
+            data_bus.stateNext = WRITE;
         }
     } else {
 
@@ -1092,6 +1213,7 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
 
         // remove the request from the queue - the iterator is no longer valid
         writeQueue[mem_pkt->qosValue()].erase(to_write);
+        data_bus.writeQueueSize--;
 
         delete mem_pkt;
 
@@ -1102,15 +1224,16 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
         // If we are interfacing to NVM and have filled the writeRespQueue,
         // with only NVM writes in Q, then switch to reads
         bool below_threshold =
-            totalWriteQueueSize + minWritesPerSwitch < writeLowThreshold;
+            data_bus.writeQueueSize + minWritesPerSwitch < writeLowThreshold;
 
-        if (totalWriteQueueSize == 0 ||
+        if (data_bus.writeQueueSize == 0 ||
             (below_threshold && drainState() != DrainState::Draining) ||
-            (totalReadQueueSize && writesThisTime >= minWritesPerSwitch) ||
-            (totalReadQueueSize && (nvmWriteBlock(mem_intr)))) {
+            (data_bus.readQueueSize &&
+             data_bus.writesThisTime >= minWritesPerSwitch) ||
+            (data_bus.readQueueSize && (nvmWriteBlock(mem_intr)))) {
 
             // turn the bus back around for reads again
-            busStateNext = MemCtrl::READ;
+            data_bus.stateNext = MemCtrl::READ;
 
             // note that the we switch back to reads also in the idle
             // case, which eventually will check for any draining and
@@ -1252,7 +1375,16 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
              "Per-requestor read average memory access latency"),
     ADD_STAT(requestorWriteAvgLat, statistics::units::Rate<
                 statistics::units::Tick, statistics::units::Count>::get(),
-             "Per-requestor write average memory access latency")
+             "Per-requestor write average memory access latency"),
+
+    ADD_STAT(compReadBurstsSaved, statistics::units::Count::get(),
+             "Number of read bursts saved by compression"),
+    ADD_STAT(compWriteBurstsSaved, statistics::units::Count::get(),
+             "Number of write bursts saved by compression"),
+    ADD_STAT(compMetadataHits, statistics::units::Count::get(),
+             "Number of reads finding their compression metadata"),
+    ADD_STAT(compMetadataMisses, statistics::units::Count::get(),
+             "Number of reads missing their compression metadata")
 {
 }
 
@@ -1361,6 +1493,27 @@ MemCtrl::recvFunctional(PacketPtr pkt)
              pkt->print());
 }
 
+void
+MemCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &backdoor)
+{
+    recvMemBackdoorReqLogic(req, backdoor, dram);
+}
+
+bool
+MemCtrl::recvMemBackdoorReqLogic(const MemBackdoorReq &req,
+        MemBackdoorPtr &backdoor, MemInterface* mem_intr)
+{
+    if (!req.range().isSubset(mem_intr->getAddrRange())) {
+        return false;
+    }
+
+    if (isInWriteQueue.empty()) {
+        mem_intr->getBackdoor(backdoor);
+    }
+    return true;
+}
+
 bool
 MemCtrl::recvFunctionalLogic(PacketPtr pkt, MemInterface* mem_intr)
 {
@@ -1484,6 +1637,13 @@ MemCtrl::MemoryPort::recvAtomicBackdoor(
     return ctrl.recvAtomicBackdoor(pkt, backdoor);
 }
 
+void
+MemCtrl::MemoryPort::recvMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &backdoor)
+{
+    ctrl.recvMemBackdoorReq(req, backdoor);
+}
+
 bool
 MemCtrl::MemoryPort::recvTimingReq(PacketPtr pkt)
 {
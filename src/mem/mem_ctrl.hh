@@ -48,6 +48,7 @@
 
 #include <deque>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -55,6 +56,7 @@
 #include "base/callback.hh"
 #include "base/statistics.hh"
 #include "enums/MemSched.hh"
+#include "mem/cache/prefetch/associative_set.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
 #include "params/MemCtrl.hh"
@@ -63,6 +65,11 @@
 namespace gem5
 {
 
+namespace compression
+{
+class Base;
+}
+
 namespace memory
 {
 
@@ -266,6 +273,8 @@ class MemCtrl : public qos::MemCtrl
                 PacketPtr pkt, MemBackdoorPtr &backdoor) override;
 
         void recvFunctional(PacketPtr pkt) override;
+        void recvMemBackdoorReq(const MemBackdoorReq &req,
+                MemBackdoorPtr &backdoor) override;
 
         bool recvTimingReq(PacketPtr) override;
 
@@ -381,6 +390,50 @@ class MemCtrl : public qos::MemCtrl
     virtual void accessAndRespond(PacketPtr pkt, Tick static_latency,
                                                 MemInterface* mem_intr);
 
+    /**
+     * Check if a packet covers exactly one line of the compressor.
+     *
+     * @param pkt The packet from the outside world
+     * @return true if the packet is compressed or decompressed
+     */
+    bool isCompressedAccess(PacketPtr pkt) const;
+
+    /**
+     * Compress the data of a write and remember its compressed size.
+     *
+     * @param pkt The write packet from the outside world
+     * @param pkt_count The number of bursts of the uncompressed write
+     * @return The number of bursts to write
+     */
+    unsigned compressWrite(PacketPtr pkt, unsigned pkt_count);
+
+    /**
+     * Determine how many bursts a read needs to fetch, given what the
+     * metadata cache knows of the compressed size of the line.
+     *
+     * @param pkt The read packet from the outside world
+     * @param pkt_count The number of bursts of the uncompressed read
+     * @return The number of bursts to read
+     */
+    unsigned compressedReadBursts(PacketPtr pkt, unsigned pkt_count);
+
+    /**
+     * Look up the compression metadata of a line, and allocate it if
+     * it is not present.
+     *
+     * @param addr Address of the line
+     * @return true if the metadata was present
+     */
+    bool accessCompMetadata(Addr addr);
+
+    /**
+     * Time to decompress the data of a read serviced by the memory.
+     *
+     * @param pkt The read packet from the outside world
+     * @return The decompression latency, zero if stored uncompressed
+     */
+    Tick decompressionLatency(PacketPtr pkt) const;
+
     /**
      * Determine if there is a packet that can issue.
      *
@@ -514,8 +567,34 @@ class MemCtrl : public qos::MemCtrl
     uint32_t writeLowThreshold;
     const uint32_t minWritesPerSwitch;
     const uint32_t minReadsPerSwitch;
-    uint32_t writesThisTime;
-    uint32_t readsThisTime;
+
+    /**
+     * Scheduling state of a data bus: its read/write direction, the
+     * bursts issued since it last turned around and the bursts queued
+     * for it. A controller normally drives a single data bus, while
+     * the HBM controller has one per pseudo channel and turns them
+     * around independently.
+     */
+    struct DataBus
+    {
+        BusState state = READ;
+        BusState stateNext = READ;
+        uint32_t readsThisTime = 0;
+        uint32_t writesThisTime = 0;
+        uint32_t readQueueSize = 0;
+        uint32_t writeQueueSize = 0;
+    };
+
+    /** State of the data bus shared by all interfaces */
+    DataBus bus;
+
+    /**
+     * Get the data bus an interface transfers its bursts on
+     *
+     * @param mem_intr The memory interface
+     * @return The scheduling state of the interface's data bus
+     */
+    virtual DataBus &dataBus(const MemInterface *mem_intr) { return bus; }
 
     /**
      * Memory controller configuration initialized based on parameter
@@ -558,6 +637,25 @@ class MemCtrl : public qos::MemCtrl
      */
     Tick nextReqTime;
 
+    /** Compressor of the lines stored in memory, if any. */
+    compression::Base *compressor;
+
+    /** How a line that is stored compressed is read back. */
+    struct CompressedLine
+    {
+        unsigned bursts;
+        Cycles decompLat;
+    };
+
+    /**
+     * Lines stored in fewer bursts than when uncompressed, which is
+     * the metadata kept in memory.
+     */
+    std::unordered_map<Addr, CompressedLine> compressedLines;
+
+    /** Lines whose compression metadata is held by the controller. */
+    AssociativeSet<TaggedEntry> compMetadata;
+
     struct CtrlStats : public statistics::Group
     {
         CtrlStats(MemCtrl &ctrl);
@@ -616,6 +714,12 @@ class MemCtrl : public qos::MemCtrl
         // per-requestor raed and write average memory access latency
         statistics::Formula requestorReadAvgLat;
         statistics::Formula requestorWriteAvgLat;
+
+        // memory-side compression
+        statistics::Scalar compReadBurstsSaved;
+        statistics::Scalar compWriteBurstsSaved;
+        statistics::Scalar compMetadataHits;
+        statistics::Scalar compMetadataMisses;
     };
 
     CtrlStats stats;
@@ -752,20 +856,22 @@ class MemCtrl : public qos::MemCtrl
     }
 
     /**
-     * Check the current direction of the memory channel
+     * Check the current direction of the data bus of an interface
      *
      * @param next_state Check either the current or next bus state
+     * @param mem_intr The interface whose data bus to check
      * @return True when bus is currently in a read state
      */
-    bool inReadBusState(bool next_state) const;
+    bool inReadBusState(bool next_state, const MemInterface *mem_intr);
 
     /**
-     * Check the current direction of the memory channel
+     * Check the current direction of the data bus of an interface
      *
      * @param next_state Check either the current or next bus state
+     * @param mem_intr The interface whose data bus to check
      * @return True when bus is currently in a write state
      */
-    bool inWriteBusState(bool next_state) const;
+    bool inWriteBusState(bool next_state, const MemInterface *mem_intr);
 
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
@@ -779,9 +885,24 @@ class MemCtrl : public qos::MemCtrl
     virtual Tick recvAtomic(PacketPtr pkt);
     virtual Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor);
     virtual void recvFunctional(PacketPtr pkt);
+    virtual void recvMemBackdoorReq(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor);
     virtual bool recvTimingReq(PacketPtr pkt);
 
     bool recvFunctionalLogic(PacketPtr pkt, MemInterface* mem_intr);
+
+    /**
+     * Hand out the back door of a memory interface if it covers the
+     * requested range. No back door is given while writes are queued, as
+     * the backing store does not reflect them yet.
+     *
+     * @param req Description of the requested back door.
+     * @param backdoor Set to the back door of the interface, if allowed.
+     * @param mem_intr The memory interface to check.
+     * @return Whether the interface covers the requested range.
+     */
+    bool recvMemBackdoorReqLogic(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor, MemInterface* mem_intr);
     Tick recvAtomicLogic(PacketPtr pkt, MemInterface* mem_intr);
 
 };
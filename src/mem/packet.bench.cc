@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Create and destroy a read packet carrying its own data. */
+void
+BM_CreateDestroy(benchmark::State &state)
+{
+    RequestPtr req = std::make_shared<Request>(0x1000, 64, 0, 0);
+    for (auto _ : state) {
+        PacketPtr pkt = new Packet(req, MemCmd::ReadReq);
+        pkt->allocate();
+        benchmark::DoNotOptimize(pkt->getPtr<uint8_t>());
+        delete pkt;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CreateDestroy);
+
+/** Create a request and a packet, and turn it into a response. */
+void
+BM_RequestResponse(benchmark::State &state)
+{
+    Addr addr = 0;
+    for (auto _ : state) {
+        RequestPtr req = std::make_shared<Request>(addr, 64, 0, 0);
+        PacketPtr pkt = Packet::createRead(req);
+        pkt->allocate();
+        pkt->makeResponse();
+        benchmark::DoNotOptimize(pkt->isResponse());
+        delete pkt;
+        addr += 64;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RequestResponse);
+
+} // anonymous namespace
@@ -49,6 +49,7 @@
 
 #include <bitset>
 #include <cassert>
+#include <cstddef>
 #include <initializer_list>
 #include <list>
 
@@ -57,6 +58,7 @@
 #include "base/compiler.hh"
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/pool_allocator.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
@@ -348,7 +350,8 @@ class Packet : public Printable
         STATIC_DATA            = 0x00001000,
         /// The data pointer points to a value that should be freed when
         /// the packet is destroyed. The pointer is assumed to be pointing
-        /// to an array, and delete [] is consequently called
+        /// to an array, and delete [] is consequently called, unless it
+        /// points to the inline storage of the packet
         DYNAMIC_DATA           = 0x00002000,
 
         /// suppress the error if this packet encounters a functional
@@ -416,6 +419,16 @@ class Packet : public Printable
      */
     uint64_t htmTransactionUid;
 
+    /** Largest payload which is stored in the packet itself. */
+    static constexpr unsigned InlineDataSize = 64;
+
+    /**
+     * Storage for payloads of up to InlineDataSize bytes, which are the
+     * vast majority, so that allocate() does not need to go to the heap
+     * for them. It is owned like any other dynamic data.
+     */
+    alignas(alignof(std::max_align_t)) uint8_t inlineData[InlineDataSize];
+
   public:
 
     /**
@@ -1036,6 +1049,24 @@ class Packet : public Printable
         deleteData();
     }
 
+    /**
+     * Packets are created and destroyed for every memory access, so their
+     * storage is recycled through a per-thread free list. This does not
+     * change who owns a packet, or when it has to be deleted.
+     */
+    static void *
+    operator new(std::size_t size)
+    {
+        assert(size == sizeof(Packet));
+        return PoolAllocator<Packet>().allocate(1);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        PoolAllocator<Packet>().deallocate(static_cast<Packet *>(p), 1);
+    }
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1327,7 +1358,7 @@ class Packet : public Printable
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(DYNAMIC_DATA) && data != inlineData)
             delete [] data;
 
         flags.clear(STATIC_DATA|DYNAMIC_DATA);
@@ -1343,7 +1374,8 @@ class Packet : public Printable
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            data = getSize() <= InlineDataSize ?
+                inlineData : new uint8_t[getSize()];
         }
     }
 
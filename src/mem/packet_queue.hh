@@ -49,7 +49,7 @@
  * for the flow control of the port.
  */
 
-#include <list>
+#include <deque>
 
 #include "mem/port.hh"
 #include "sim/drain.hh"
@@ -76,7 +76,14 @@ class PacketQueue : public Drainable
         {}
     };
 
-    typedef std::list<DeferredPacket> DeferredPacketList;
+    /**
+     * The deferred packets are kept in a contiguous double-ended queue
+     * rather than a linked list, as packets are almost always added
+     * at the back and removed from the front. This avoids allocating
+     * a node for every packet and keeps the backwards search in
+     * schedSendTiming cache friendly.
+     */
+    typedef std::deque<DeferredPacket> DeferredPacketList;
 
     /** A list of outgoing packets. */
     DeferredPacketList transmitList;
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/packet.hh"
+#include "mem/packet_queue.hh"
+#include "mem/request.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Packet queue recording the order in which its packets are sent. */
+class TestPacketQueue : public PacketQueue
+{
+  public:
+    std::vector<Addr> sent;
+    std::vector<Tick> sentTicks;
+    /** Number of upcoming sends to refuse. */
+    unsigned refuse = 0;
+
+    TestPacketQueue(EventManager &em, bool force_order)
+        : PacketQueue(em, "TestPacketQueue", "test.sendEvent",
+                      force_order, true)
+    {}
+
+    const std::string name() const override { return "test"; }
+
+  protected:
+    bool
+    sendTiming(PacketPtr pkt) override
+    {
+        if (refuse) {
+            refuse--;
+            return false;
+        }
+        sent.push_back(pkt->getAddr());
+        sentTicks.push_back(curTick());
+        delete pkt;
+        return true;
+    }
+};
+
+class PacketQueueTest : public testing::Test
+{
+  protected:
+    EventQueue eq{"test_queue"};
+    EventManager em{&eq};
+
+    void SetUp() override { curEventQueue(&eq); }
+
+    PacketPtr
+    makePacket(Addr addr)
+    {
+        RequestPtr req = Request::create(addr, 8, 0, 0);
+        return new Packet(req, MemCmd::ReadResp);
+    }
+
+    void
+    run()
+    {
+        while (!eq.empty())
+            eq.serviceOne();
+    }
+};
+
+} // anonymous namespace
+
+/** Packets are sent by tick, and in insertion order for equal ticks. */
+TEST_F(PacketQueueTest, TickOrder)
+{
+    TestPacketQueue queue(em, false);
+    queue.schedSendTiming(makePacket(0x300), 30);
+    queue.schedSendTiming(makePacket(0x100), 10);
+    queue.schedSendTiming(makePacket(0x200), 20);
+    queue.schedSendTiming(makePacket(0x101), 10);
+    EXPECT_EQ(queue.size(), 4);
+    EXPECT_EQ(queue.deferredPacketReadyTime(), 10);
+
+    run();
+
+    EXPECT_EQ(queue.sent, std::vector<Addr>({0x100, 0x101, 0x200, 0x300}));
+    EXPECT_EQ(queue.sentTicks, std::vector<Tick>({10, 11, 20, 30}));
+    EXPECT_EQ(queue.size(), 0);
+}
+
+/** With forced ordering a packet never overtakes one to the same address. */
+TEST_F(PacketQueueTest, ForceOrder)
+{
+    TestPacketQueue queue(em, true);
+    queue.schedSendTiming(makePacket(0x100), 20);
+    queue.schedSendTiming(makePacket(0x200), 15);
+    queue.schedSendTiming(makePacket(0x100), 10);
+    queue.schedSendTiming(makePacket(0x300), 12);
+
+    run();
+
+    EXPECT_EQ(queue.sent, std::vector<Addr>({0x200, 0x100, 0x100, 0x300}));
+}
+
+/** A refused packet stays at the head of the queue until the retry. */
+TEST_F(PacketQueueTest, Retry)
+{
+    TestPacketQueue queue(em, false);
+    queue.refuse = 1;
+    queue.schedSendTiming(makePacket(0x100), 10);
+    queue.schedSendTiming(makePacket(0x200), 20);
+
+    run();
+    EXPECT_TRUE(queue.sent.empty());
+    EXPECT_EQ(queue.size(), 2);
+
+    EXPECT_EQ(curTick(), 10);
+    queue.schedSendTiming(makePacket(0x300), 10);
+    queue.retry();
+    run();
+
+    EXPECT_EQ(queue.sent, std::vector<Addr>({0x100, 0x300, 0x200}));
+}
+
+/**
+ * Keep a deep queue busy with a mix of in-order and out-of-order
+ * insertions, as seen on a heavily loaded response port, and check
+ * that no packet is lost or sent before its time.
+ */
+TEST_F(PacketQueueTest, HeavyLoad)
+{
+    TestPacketQueue queue(em, false);
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<Tick> delay(1, 1000);
+
+    unsigned queued = 0;
+    const unsigned num_packets = 100000;
+    std::vector<Tick> when;
+    while (queue.sent.size() < num_packets) {
+        while (queued < num_packets && queue.size() < 512) {
+            Tick t = curTick() + (queued % 8 ? 1000 : delay(rng));
+            when.push_back(t);
+            queue.schedSendTiming(makePacket(queued++), t);
+        }
+        ASSERT_FALSE(eq.empty());
+        eq.serviceOne();
+    }
+
+    ASSERT_EQ(queue.sent.size(), num_packets);
+    for (unsigned i = 0; i < num_packets; i++) {
+        EXPECT_GE(queue.sentTicks[i], when[queue.sent[i]]);
+        if (i > 0)
+            EXPECT_GE(queue.sentTicks[i], queue.sentTicks[i - 1]);
+    }
+}
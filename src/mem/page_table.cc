@@ -33,6 +33,8 @@
  */
 #include "mem/page_table.hh"
 
+#include <atomic>
+#include <mutex>
 #include <string>
 
 #include "base/compiler.hh"
@@ -44,9 +46,89 @@
 namespace gem5
 {
 
+namespace
+{
+
+/**
+ * The leaf of the last lookup made by this thread. Consecutive lookups
+ * mostly fall in the same leaf, which then skips the hash table.
+ */
+struct LeafCache
+{
+    uint64_t generation = 0;
+    Addr key = 0;
+    void *leaf = nullptr;
+};
+
+thread_local LeafCache leafCache;
+
+} // anonymous namespace
+
+uint64_t
+EmulationPageTable::nextLeafGeneration()
+{
+    static std::atomic<uint64_t> generation(1);
+    return generation++;
+}
+
+EmulationPageTable::Entry *
+EmulationPageTable::findEntry(Addr vaddr) const
+{
+    Addr key = leafKey(vaddr);
+    Leaf *leaf;
+    if (leafCache.generation == leafGeneration && leafCache.key == key) {
+        leaf = static_cast<Leaf *>(leafCache.leaf);
+    } else {
+        auto it = pTable.find(key);
+        if (it == pTable.end())
+            return nullptr;
+        leaf = it->second.get();
+        leafCache.generation = leafGeneration;
+        leafCache.key = key;
+        leafCache.leaf = leaf;
+    }
+
+    unsigned index = leafIndex(vaddr);
+    return leaf->valid[index] ? &leaf->entries[index] : nullptr;
+}
+
+EmulationPageTable::Entry &
+EmulationPageTable::insertEntry(Addr vaddr, bool &existed)
+{
+    auto &leaf = pTable[leafKey(vaddr)];
+    if (!leaf)
+        leaf = std::make_unique<Leaf>();
+
+    unsigned index = leafIndex(vaddr);
+    existed = leaf->valid[index];
+    if (!existed) {
+        leaf->valid[index] = true;
+        numEntries++;
+    }
+    return leaf->entries[index];
+}
+
+void
+EmulationPageTable::eraseEntry(Addr vaddr)
+{
+    auto it = pTable.find(leafKey(vaddr));
+    assert(it != pTable.end());
+    Leaf &leaf = *it->second;
+    unsigned index = leafIndex(vaddr);
+    assert(leaf.valid[index]);
+    leaf.valid[index] = false;
+    numEntries--;
+
+    if (leaf.valid.none()) {
+        pTable.erase(it);
+        leafGeneration = nextLeafGeneration();
+    }
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
+    std::unique_lock<std::shared_mutex> lock(pTableMutex);
     bool clobber = flags & Clobber;
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
@@ -54,16 +136,13 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
+        bool existed;
+        Entry &entry = insertEntry(vaddr, existed);
+        // already mapped
+        panic_if(existed && !clobber,
+                 "EmulationPageTable::allocate: addr %#x already mapped",
+                 vaddr);
+        entry = Entry(paddr, flags);
 
         size -= _pageSize;
         vaddr += _pageSize;
@@ -74,6 +153,7 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 void
 EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 {
+    std::unique_lock<std::shared_mutex> lock(pTableMutex);
     assert(pageOffset(vaddr) == 0);
     assert(pageOffset(new_vaddr) == 0);
 
@@ -81,12 +161,14 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
             new_vaddr, size);
 
     while (size > 0) {
-        [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
-
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
+        [[maybe_unused]] bool existed;
+        Entry *old_entry = findEntry(vaddr);
+        assert(old_entry);
+        Entry entry = *old_entry;
+        eraseEntry(vaddr);
+
+        insertEntry(new_vaddr, existed) = entry;
+        assert(!existed);
         size -= _pageSize;
         vaddr += _pageSize;
         new_vaddr += _pageSize;
@@ -96,21 +178,22 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    std::shared_lock<std::shared_mutex> lock(pTableMutex);
+    forEachEntry([addr_maps](Addr vaddr, const Entry &entry) {
+        addr_maps->push_back(std::make_pair(vaddr, entry.paddr));
+    });
 }
 
 void
 EmulationPageTable::unmap(Addr vaddr, int64_t size)
 {
+    std::unique_lock<std::shared_mutex> lock(pTableMutex);
     assert(pageOffset(vaddr) == 0);
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
     while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
+        eraseEntry(vaddr);
         size -= _pageSize;
         vaddr += _pageSize;
     }
@@ -122,8 +205,9 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
+    std::shared_lock<std::shared_mutex> lock(pTableMutex);
     for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
+        if (findEntry(vaddr + offset))
             return false;
 
     return true;
@@ -133,10 +217,8 @@ const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
     Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+    std::shared_lock<std::shared_mutex> lock(pTableMutex);
+    return findEntry(page_addr);
 }
 
 bool
@@ -186,17 +268,17 @@ void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
     ScopedCheckpointSection sec(cp, "ptable");
-    paramOut(cp, "size", pTable.size());
+    paramOut(cp, "size", numEntries);
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    uint64_t count = 0;
+    forEachEntry([&cp, &count](Addr vaddr, const Entry &entry) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
-    }
-    assert(count == pTable.size());
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
+    });
+    assert(count == numEntries);
 }
 
 void
@@ -216,7 +298,10 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        bool existed;
+        Entry &entry = insertEntry(vaddr, existed);
+        if (!existed)
+            entry = Entry(paddr, flags);
     }
 }
 
@@ -224,9 +309,9 @@ const std::string
 EmulationPageTable::externalize() const
 {
     std::stringstream ss;
-    for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
-        ss << std::hex << it->first << ":" << it->second.paddr << ";";
-    }
+    forEachEntry([&ss](Addr vaddr, const Entry &entry) {
+        ss << std::hex << vaddr << ":" << entry.paddr << ";";
+    });
     return ss.str();
 }
 
@@ -35,6 +35,10 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <array>
+#include <bitset>
+#include <memory>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
@@ -63,12 +67,73 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
+    /**
+     * The table is a two level radix tree. The upper level maps the
+     * virtual address bits above a leaf to the leaf, and a leaf holds
+     * the entries of LeafPages consecutive pages in an array. With
+     * 4KiB pages a leaf covers 2MiB, so large mappings cost one hash
+     * table node per 2MiB rather than one per page.
+     */
+    static constexpr unsigned LeafBits = 9;
+    static constexpr unsigned LeafPages = 1 << LeafBits;
+
+    struct Leaf
+    {
+        std::array<Entry, LeafPages> entries;
+        std::bitset<LeafPages> valid;
+    };
+
+    typedef std::unordered_map<Addr, std::unique_ptr<Leaf>> PTable;
     PTable pTable;
+    uint64_t numEntries = 0;
+
+    /**
+     * Identifies this table and its current set of leaves for the
+     * per-thread cache of the last leaf looked up. It changes whenever
+     * a leaf is freed.
+     */
+    uint64_t leafGeneration;
+
+    Addr leafKey(Addr vaddr) const { return vaddr >> leafShift; }
+    unsigned
+    leafIndex(Addr vaddr) const
+    {
+        return (vaddr >> pageShift) & (LeafPages - 1);
+    }
+    Addr
+    leafVaddr(Addr key, unsigned index) const
+    {
+        return (key << leafShift) | ((Addr)index << pageShift);
+    }
+
+    /** Look up an entry; the caller holds pTableMutex */
+    Entry *findEntry(Addr vaddr) const;
+    /** Insert or overwrite an entry; the caller holds pTableMutex */
+    Entry &insertEntry(Addr vaddr, bool &existed);
+    /** Remove an entry; the caller holds pTableMutex exclusively */
+    void eraseEntry(Addr vaddr);
+
+    /** Call fn(vaddr, entry) for every mapped page */
+    template <typename Fn>
+    void
+    forEachEntry(Fn fn) const
+    {
+        for (auto &[key, leaf] : pTable) {
+            for (unsigned i = 0; i < LeafPages; i++) {
+                if (leaf->valid[i])
+                    fn(leafVaddr(key, i), leaf->entries[i]);
+            }
+        }
+    }
+
+    // Serializes updates of the table with the lookups of CPUs that run
+    // on other event queues
+    mutable std::shared_mutex pTableMutex;
 
     const Addr _pageSize;
     const Addr offsetMask;
+    const unsigned pageShift;
+    const unsigned leafShift;
 
     const uint64_t _pid;
     const std::string _name;
@@ -78,9 +143,12 @@ class EmulationPageTable : public Serializable
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
             _pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
+            pageShift(floorLog2(_pageSize)),
+            leafShift(floorLog2(_pageSize) + LeafBits),
             _pid(_pid), _name(__name), shared(false)
     {
         assert(isPowerOf2(_pageSize));
+        leafGeneration = nextLeafGeneration();
     }
 
     uint64_t pid() const { return _pid; };
@@ -198,6 +266,9 @@ class EmulationPageTable : public Serializable
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
+
+  private:
+    static uint64_t nextLeafGeneration();
 };
 
 } // namespace gem5
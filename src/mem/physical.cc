@@ -39,25 +39,38 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #include "base/intmath.hh"
 #include "base/trace.hh"
+#include "config/have_zstd.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
 /**
  * On Linux, MAP_NORESERVE allow us to simulate a very large memory
  * without committing to actually providing the swap space on the
@@ -76,15 +89,206 @@ namespace gem5
 namespace memory
 {
 
+/**
+ * Delta checkpoints refer to their parent by path, so make sure the
+ * path remains valid regardless of the working directory.
+ */
+static std::string
+absoluteCptDir(const std::string &dir)
+{
+    char *resolved = realpath(dir.c_str(), nullptr);
+    if (!resolved)
+        return dir;
+    std::string abs_dir(resolved);
+    free(resolved);
+    return abs_dir;
+}
+
+/** Size of the chunks of a chunked memory checkpoint. */
+static constexpr uint64_t CheckpointChunkBytes = 1 << 20;
+
+/** Marks the end of a chunked memory checkpoint file ("GM5CHNK1"). */
+static constexpr uint64_t CheckpointChunkMagic = 0x314b4e4843354d47;
+
+/** Where a chunk is stored in a chunked memory checkpoint file. */
+struct CheckpointChunk
+{
+    uint64_t chunk;
+    uint64_t offset;
+    uint64_t size;
+};
+
+/** Size of the blocks kept in a content-addressed page store. */
+static constexpr uint64_t PageStoreBlockBytes = 1 << 16;
+
+/** A block of a memory checkpoint kept in a page store. */
+struct PageStoreBlock
+{
+    uint64_t block;
+    uint64_t hash[2];
+};
+
+static uint64_t
+mix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Hash a block of memory to 128 bits using two independently seeded
+ * lanes. This is not a cryptographic hash, but accidental collisions
+ * are vanishingly unlikely at the number of blocks in a page store.
+ */
+static void
+hashBlock(const uint8_t *data, uint64_t size, uint64_t hash[2])
+{
+    uint64_t h1 = 0x9e3779b97f4a7c15ULL ^ size;
+    uint64_t h2 = 0x6a09e667f3bcc908ULL ^ (size << 1);
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t w;
+        std::memcpy(&w, data + i, sizeof(w));
+        h1 = (h1 ^ mix64(w)) * 0x87c37b91114253d5ULL;
+        h1 = (h1 << 27) | (h1 >> 37);
+        h2 = (h2 + w) * 0x4cf5ad432745937fULL;
+        h2 = (h2 << 31) | (h2 >> 33);
+    }
+    for (; i < size; ++i) {
+        h1 = (h1 ^ data[i]) * 0x87c37b91114253d5ULL;
+        h2 = (h2 + data[i]) * 0x4cf5ad432745937fULL;
+    }
+    hash[0] = mix64(h1 + h2);
+    hash[1] = mix64(h2 + hash[0]);
+}
+
+/** Where a block with the given hash lives in a page store. */
+static std::string
+pageStorePath(const std::string &store, const uint64_t hash[2])
+{
+    return csprintf("%s/%02x/%016x%016x", store, hash[0] >> 56,
+                    hash[0], hash[1]);
+}
+
+static void
+makeDir(const std::string &dir)
+{
+    if (mkdir(dir.c_str(), 0755) && errno != EEXIST)
+        fatal("Can't create page store directory '%s'\n", dir);
+}
+
+/**
+ * Run f(0) ... f(count - 1) on up to the given number of host threads,
+ * including the calling thread.
+ */
+static void
+parallelFor(unsigned threads, uint64_t count,
+            const std::function<void(uint64_t)> &f)
+{
+    std::atomic<uint64_t> next(0);
+    auto worker = [&]() {
+        for (uint64_t i = next++; i < count; i = next++)
+            f(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (uint64_t t = 1; t < std::min<uint64_t>(threads, count); ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+}
+
+static bool
+isZeroChunk(const uint8_t *data, uint64_t size)
+{
+    const uint64_t *words = (const uint64_t *)data;
+    for (uint64_t i = 0; i < size / sizeof(uint64_t); ++i)
+        if (words[i])
+            return false;
+    for (uint64_t i = size & ~(sizeof(uint64_t) - 1); i < size; ++i)
+        if (data[i])
+            return false;
+    return true;
+}
+
+static void
+compressChunk(const std::string &compression, const uint8_t *data,
+              uint64_t size, std::vector<uint8_t> &out)
+{
+    if (compression == "zstd") {
+#if HAVE_ZSTD
+        out.resize(ZSTD_compressBound(size));
+        size_t len = ZSTD_compress(out.data(), out.size(), data, size, 1);
+        fatal_if(ZSTD_isError(len), "Failed to compress memory: %s\n",
+                 ZSTD_getErrorName(len));
+        out.resize(len);
+        return;
+#endif
+    } else if (compression == "zlib") {
+        uLongf len = compressBound(size);
+        out.resize(len);
+        fatal_if(compress2(out.data(), &len, data, size, Z_BEST_SPEED) !=
+                 Z_OK, "Failed to compress memory\n");
+        out.resize(len);
+        return;
+    }
+    fatal("Unsupported memory checkpoint compression '%s'\n", compression);
+}
+
+static bool
+decompressChunk(const std::string &compression, const uint8_t *data,
+                uint64_t size, uint8_t *out, uint64_t out_size)
+{
+    if (compression == "zstd") {
+#if HAVE_ZSTD
+        size_t len = ZSTD_decompress(out, out_size, data, size);
+        return !ZSTD_isError(len) && len == out_size;
+#endif
+    } else if (compression == "zlib") {
+        uLongf len = out_size;
+        return uncompress(out, &len, data, size) == Z_OK && len == out_size;
+    }
+    fatal("Memory checkpoint compressed with unsupported '%s'\n",
+          compression);
+}
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               bool delta_checkpoints,
+                               bool chunked_checkpoints,
+                               bool raw_checkpoints, bool lazy_restore,
+                               const std::string& page_store,
+                               unsigned checkpoint_threads,
+                               bool huge_pages, bool hugetlb,
+                               const std::vector<int>& numa_nodes) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), deltaCheckpoints(delta_checkpoints),
+    chunkedCheckpoints(chunked_checkpoints),
+    rawCheckpoints(raw_checkpoints), lazyRestore(lazy_restore),
+    pageStore(page_store),
+    checkpointThreads(checkpoint_threads ? checkpoint_threads :
+                      std::max(1u, std::thread::hardware_concurrency())),
+    hugePages(huge_pages), hugetlb(hugetlb), numaNodes(numa_nodes),
+    dirtyTracking(true)
 {
+#ifndef __linux__
+    fatal_if(hugePages || hugetlb || !numaNodes.empty(),
+             "Huge pages and NUMA binding of the backing store are only "
+             "supported on Linux hosts\n");
+#endif
+    fatal_if(hugetlb && lazyRestore,
+             "Checkpoints cannot be restored lazily into a hugetlbfs "
+             "backing store\n");
+
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
         registerExitCallback([=]() { shm_unlink(shared_backstore.c_str()); });
@@ -238,21 +442,57 @@ PhysicalMemory::createBackingStore(
         map_flags |= MAP_NORESERVE;
     }
 
+#ifdef __linux__
+    // hugetlbfs pages come from the anonymous pool, not from the shmem
+    // segment
+    if (hugetlb) {
+        fatal_if(!sharedBackstore.empty(),
+                 "A shared backing store cannot use hugetlbfs pages\n");
+        map_flags |= MAP_HUGETLB;
+    }
+#endif
+
     uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
                                     PROT_READ | PROT_WRITE,
                                     map_flags, shm_fd, map_offset);
 
     if (pmem == (uint8_t*) MAP_FAILED) {
         perror("mmap");
-        fatal("Could not mmap %d bytes for range %s!\n", range.size(),
-              range.to_string());
+        fatal("Could not mmap %d bytes for range %s!%s\n", range.size(),
+              range.to_string(), hugetlb ?
+              " Check that enough huge pages are reserved." : "");
     }
 
+#ifdef __linux__
+    if (hugePages && madvise(pmem, range.size(), MADV_HUGEPAGE))
+        warn("Could not use transparent huge pages for range %s: %s\n",
+             range.to_string(), strerror(errno));
+
+    // bind before anything touches the store, so the pages are
+    // allocated on the requested node
+    const size_t store_idx = backingStore.size();
+    const int node = numaNodes.size() == 1 ? numaNodes[0] :
+        store_idx < numaNodes.size() ? numaNodes[store_idx] : -1;
+    if (node >= 0) {
+        // MPOL_BIND from linux/mempolicy.h
+        constexpr int mpol_bind = 2;
+        constexpr int mask_bits = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> nodemask(node / mask_bits + 1, 0);
+        nodemask[node / mask_bits] = 1UL << (node % mask_bits);
+        if (syscall(SYS_mbind, pmem, range.size(), mpol_bind,
+                    nodemask.data(), nodemask.size() * mask_bits, 0)) {
+            warn("Could not bind range %s to host NUMA node %d: %s\n",
+                 range.to_string(), node, strerror(errno));
+        }
+    }
+#endif
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map,
                               shm_fd, map_offset);
+    storeMemories.push_back(_memories);
 
     // point the memories to their backing store
     for (const auto& m : _memories) {
@@ -275,6 +515,40 @@ PhysicalMemory::isMemAddr(Addr addr) const
     return addrMap.contains(addr) != addrMap.end();
 }
 
+uint8_t *
+PhysicalMemory::hostRange(Addr addr, Addr size, bool write)
+{
+    const auto m = addrMap.contains(AddrRange(addr, addr + size));
+    if (m == addrMap.end())
+        return nullptr;
+    return m->second->hostRange(addr, size, write);
+}
+
+bool
+PhysicalMemory::mapFile(Addr addr, Addr size, int fd, off_t offset)
+{
+    if (size % pageSize || offset % pageSize || hugetlb)
+        return false;
+
+    // a shared backing store has to stay mapped to its shmem segment
+    const AddrRange range(addr, addr + size);
+    for (const auto &store : backingStore) {
+        if (store.shmFd != -1 && store.range.intersects(range))
+            return false;
+    }
+
+    uint8_t *pmem = hostRange(addr, size, true);
+    if (!pmem || (uintptr_t)pmem % pageSize)
+        return false;
+
+    int map_flags = MAP_PRIVATE | MAP_FIXED;
+    if (mmapUsingNoReserve)
+        map_flags |= MAP_NORESERVE;
+    // the old mapping is only replaced if this succeeds
+    return mmap(pmem, size, PROT_READ | PROT_WRITE, map_flags, fd,
+                offset) != MAP_FAILED;
+}
+
 AddrRangeList
 PhysicalMemory::getConfAddrRanges() const
 {
@@ -351,12 +625,32 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     unsigned int nbr_of_stores = backingStore.size();
     SERIALIZE_SCALAR(nbr_of_stores);
 
+    // only store the written pages if we know what the rest of the
+    // memory looks like
+    const bool delta = deltaCheckpoints && dirtyTracking &&
+        !parentCheckpoint.empty();
+
     unsigned int store_id = 0;
     // store each backing store memory segment in a file
     for (auto& s : backingStore) {
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
-        serializeStore(cp, store_id++, s.range, s.pmem);
+        if (delta)
+            serializeStoreDelta(cp, store_id++, s.range, s.pmem);
+        else if (!pageStore.empty())
+            serializeStorePages(cp, store_id++, s.range, s.pmem);
+        else if (rawCheckpoints)
+            serializeStoreRaw(cp, store_id++, s.range, s.pmem);
+        else if (chunkedCheckpoints)
+            serializeStoreChunked(cp, store_id++, s.range, s.pmem);
+        else
+            serializeStore(cp, store_id++, s.range, s.pmem);
     }
+
+    // any subsequent delta checkpoint is relative to this one
+    parentCheckpoint = absoluteCptDir(CheckpointIn::dir());
+    for (auto& mems : storeMemories)
+        for (auto& m : mems)
+            m->clearDirty();
 }
 
 void
@@ -406,6 +700,274 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
 }
 
+void
+PhysicalMemory::serializeStoreDelta(CheckpointOut &cp, unsigned int store_id,
+                                    AddrRange range, uint8_t* pmem) const
+{
+    std::string filename =
+        name() + ".store" + std::to_string(store_id) + ".delta";
+    long range_size = range.size();
+    std::string parent_checkpoint = parentCheckpoint;
+    uint64_t delta_page_size = AbstractMemory::DirtyPageBytes;
+
+    SERIALIZE_SCALAR(store_id);
+    SERIALIZE_SCALAR(filename);
+    SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(parent_checkpoint);
+    SERIALIZE_SCALAR(delta_page_size);
+
+    std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filename);
+
+    // each written page is stored as its index followed by its
+    // contents, where the last page may be partial
+    const auto &mems = storeMemories[store_id];
+    const uint64_t nbr_of_pages = divCeil(range.size(), delta_page_size);
+    uint64_t dirty_pages = 0;
+    for (uint64_t page = 0; page < nbr_of_pages; ++page) {
+        bool dirty = false;
+        for (const auto& m : mems)
+            dirty = dirty || m->isPageDirty(page);
+        if (!dirty)
+            continue;
+
+        const uint64_t offset = page * delta_page_size;
+        const unsigned int len =
+            std::min<uint64_t>(delta_page_size, range.size() - offset);
+        if (gzwrite(compressed_mem, &page, sizeof(page)) != sizeof(page) ||
+            gzwrite(compressed_mem, pmem + offset, len) != (int)len) {
+            fatal("Write failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        }
+        ++dirty_pages;
+    }
+
+    DPRINTF(Checkpoint, "Serialized %d of %d pages of physical memory %s "
+            "relative to %s\n", dirty_pages, nbr_of_pages, filename,
+            parent_checkpoint);
+
+    if (gzclose(compressed_mem))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filename);
+}
+
+void
+PhysicalMemory::serializeStoreChunked(CheckpointOut &cp,
+                                      unsigned int store_id,
+                                      AddrRange range, uint8_t* pmem) const
+{
+    std::string filename =
+        name() + ".store" + std::to_string(store_id) + ".pmemc";
+    long range_size = range.size();
+    uint64_t chunk_size = CheckpointChunkBytes;
+    std::string compression = HAVE_ZSTD ? "zstd" : "zlib";
+
+    DPRINTF(Checkpoint, "Serializing physical memory %s with size %d "
+            "using %s on %d threads\n", filename, range_size, compression,
+            checkpointThreads);
+
+    SERIALIZE_SCALAR(store_id);
+    SERIALIZE_SCALAR(filename);
+    SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(chunk_size);
+    SERIALIZE_SCALAR(compression);
+
+    std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    FILE *f = fopen(filepath.c_str(), "wb");
+    if (f == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filename);
+
+    // compress a batch of chunks in parallel and then append them to
+    // the file in order, which bounds the memory used for buffering
+    const uint64_t nbr_of_chunks = divCeil(range.size(), chunk_size);
+    const uint64_t batch_size = 8 * checkpointThreads;
+    std::vector<std::vector<uint8_t>> batch(batch_size);
+    std::vector<CheckpointChunk> index;
+    uint64_t offset = 0;
+
+    for (uint64_t first = 0; first < nbr_of_chunks; first += batch_size) {
+        const uint64_t count =
+            std::min(batch_size, nbr_of_chunks - first);
+        parallelFor(checkpointThreads, count, [&](uint64_t i) {
+            const uint64_t start = (first + i) * chunk_size;
+            const uint64_t len =
+                std::min(chunk_size, range.size() - start);
+            if (isZeroChunk(pmem + start, len))
+                batch[i].clear();
+            else
+                compressChunk(compression, pmem + start, len, batch[i]);
+        });
+
+        for (uint64_t i = 0; i < count; ++i) {
+            if (batch[i].empty())
+                continue;
+            if (fwrite(batch[i].data(), 1, batch[i].size(), f) !=
+                batch[i].size()) {
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", filename);
+            }
+            index.push_back({first + i, offset, batch[i].size()});
+            offset += batch[i].size();
+        }
+    }
+
+    // the index and its size go at the end of the file
+    const uint64_t trailer[2] = { index.size(), CheckpointChunkMagic };
+    if (fwrite(index.data(), sizeof(CheckpointChunk), index.size(), f) !=
+        index.size() || fwrite(trailer, sizeof(trailer), 1, f) != 1) {
+        fatal("Write failed on physical memory checkpoint file '%s'\n",
+              filename);
+    }
+
+    DPRINTF(Checkpoint, "Serialized %d of %d chunks of physical memory %s\n",
+            index.size(), nbr_of_chunks, filename);
+
+    if (fclose(f))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filename);
+}
+
+void
+PhysicalMemory::serializeStoreRaw(CheckpointOut &cp, unsigned int store_id,
+                                  AddrRange range, uint8_t* pmem) const
+{
+    std::string filename =
+        name() + ".store" + std::to_string(store_id) + ".bin";
+    long range_size = range.size();
+    bool raw = true;
+
+    DPRINTF(Checkpoint, "Serializing physical memory %s with size %d "
+            "uncompressed\n", filename, range_size);
+
+    SERIALIZE_SCALAR(store_id);
+    SERIALIZE_SCALAR(filename);
+    SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(raw);
+
+    std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    int fd = open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, range_size))
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filename);
+
+    // write each run of pages that are not all zero, the rest of the
+    // file is left as holes that read as zero
+    const uint64_t page_size = pageSize;
+    auto page_len = [&](uint64_t start) {
+        return std::min(page_size, range.size() - start);
+    };
+    uint64_t start = 0;
+    while (start < range.size()) {
+        if (isZeroChunk(pmem + start, page_len(start))) {
+            start += page_len(start);
+            continue;
+        }
+
+        uint64_t end = start + page_len(start);
+        while (end < range.size() && !isZeroChunk(pmem + end, page_len(end)))
+            end += page_len(end);
+
+        for (; start < end;) {
+            ssize_t ret = pwrite(fd, pmem + start,
+                                 std::min<uint64_t>(end - start, INT_MAX),
+                                 start);
+            if (ret <= 0)
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", filename);
+            start += ret;
+        }
+    }
+
+    if (close(fd))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filename);
+}
+
+void
+PhysicalMemory::serializeStorePages(CheckpointOut &cp, unsigned int store_id,
+                                    AddrRange range, uint8_t* pmem) const
+{
+    std::string filename =
+        name() + ".store" + std::to_string(store_id) + ".pages";
+    long range_size = range.size();
+    uint64_t page_store_block = PageStoreBlockBytes;
+
+    makeDir(pageStore);
+    std::string page_store = absoluteCptDir(pageStore);
+    for (unsigned i = 0; i < 256; ++i)
+        makeDir(csprintf("%s/%02x", page_store, i));
+
+    DPRINTF(Checkpoint, "Serializing physical memory %s with size %d "
+            "to page store %s\n", filename, range_size, page_store);
+
+    SERIALIZE_SCALAR(store_id);
+    SERIALIZE_SCALAR(filename);
+    SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(page_store);
+    SERIALIZE_SCALAR(page_store_block);
+
+    // hash all the blocks and add the ones that are missing to the
+    // page store, all-zero blocks are left out altogether
+    const uint64_t nbr_of_blocks = divCeil(range.size(), page_store_block);
+    std::vector<PageStoreBlock> blocks(nbr_of_blocks);
+    std::atomic<uint64_t> added(0);
+    parallelFor(checkpointThreads, nbr_of_blocks, [&](uint64_t b) {
+        const uint64_t start = b * page_store_block;
+        const uint64_t len = std::min(page_store_block, range.size() - start);
+        if (isZeroChunk(pmem + start, len)) {
+            blocks[b].block = nbr_of_blocks;
+            return;
+        }
+
+        blocks[b].block = b;
+        hashBlock(pmem + start, len, blocks[b].hash);
+        const std::string path = pageStorePath(page_store, blocks[b].hash);
+        if (::access(path.c_str(), F_OK) == 0)
+            return;
+
+        // write to a temporary file first such that concurrent
+        // checkpoints never see a partial block
+        std::vector<uint8_t> data;
+        compressChunk("zlib", pmem + start, len, data);
+        const std::string tmp_path =
+            csprintf("%s.%d.%d", path, getpid(), b);
+        FILE *f = fopen(tmp_path.c_str(), "wb");
+        if (f == NULL ||
+            fwrite(data.data(), 1, data.size(), f) != data.size() ||
+            fclose(f) || rename(tmp_path.c_str(), path.c_str())) {
+            fatal("Write failed on page store block '%s'\n", path);
+        }
+        ++added;
+    });
+
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+                                [&](const PageStoreBlock &b) {
+                                    return b.block == nbr_of_blocks;
+                                }), blocks.end());
+
+    DPRINTF(Checkpoint, "Serialized %d non-zero blocks of %d to page "
+            "store, %d of which were new\n", blocks.size(), nbr_of_blocks,
+            added.load());
+
+    std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    FILE *f = fopen(filepath.c_str(), "wb");
+    if (f == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filename);
+    if (fwrite(blocks.data(), sizeof(PageStoreBlock), blocks.size(), f) !=
+        blocks.size()) {
+        fatal("Write failed on physical memory checkpoint file '%s'\n",
+              filename);
+    }
+    if (fclose(f))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filename);
+}
+
 void
 PhysicalMemory::unserialize(CheckpointIn &cp)
 {
@@ -429,6 +991,12 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
         unserializeStore(cp);
     }
 
+    // the memory now matches the checkpoint, so a subsequent delta
+    // checkpoint can refer to it
+    parentCheckpoint = absoluteCptDir(cp.getCptDir());
+    for (auto& mems : storeMemories)
+        for (auto& m : mems)
+            m->clearDirty();
 }
 
 void
@@ -443,6 +1011,30 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
+    std::string parent_checkpoint;
+    if (UNSERIALIZE_OPT_SCALAR(parent_checkpoint)) {
+        unserializeStoreDelta(cp, store_id, filepath, parent_checkpoint);
+        return;
+    }
+
+    std::string page_store;
+    if (UNSERIALIZE_OPT_SCALAR(page_store)) {
+        unserializeStorePages(cp, store_id, filepath);
+        return;
+    }
+
+    bool raw;
+    if (UNSERIALIZE_OPT_SCALAR(raw) && raw) {
+        unserializeStoreRaw(cp, store_id, filepath);
+        return;
+    }
+
+    std::string compression;
+    if (UNSERIALIZE_OPT_SCALAR(compression)) {
+        unserializeStoreChunked(cp, store_id, filepath);
+        return;
+    }
+
     // mmap memoryfile
     gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
     if (compressed_mem == NULL)
@@ -491,5 +1083,236 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
               filename);
 }
 
+void
+PhysicalMemory::unserializeStoreDelta(CheckpointIn &cp, unsigned int store_id,
+                                      const std::string &filepath,
+                                      const std::string &parent_checkpoint)
+{
+    // restore the parent first, which is laid out identically and
+    // thus uses the same section, and may itself be a delta
+    DPRINTF(Checkpoint, "Unserializing parent checkpoint %s\n",
+            parent_checkpoint);
+    CheckpointIn parent(parent_checkpoint);
+    unserializeStore(parent);
+
+    uint8_t* pmem = backingStore[store_id].pmem;
+    AddrRange range = backingStore[store_id].range;
+
+    long range_size;
+    UNSERIALIZE_SCALAR(range_size);
+    uint64_t delta_page_size;
+    UNSERIALIZE_SCALAR(delta_page_size);
+
+    if (range_size != range.size())
+        fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+              range_size, range.size());
+
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
+    uint64_t page;
+    int bytes_read;
+    while ((bytes_read = gzread(compressed_mem, &page, sizeof(page))) > 0) {
+        const uint64_t offset = page * delta_page_size;
+        fatal_if(bytes_read != sizeof(page) || offset >= range.size(),
+                 "Corrupt physical memory checkpoint file '%s'\n", filepath);
+        const unsigned int len =
+            std::min<uint64_t>(delta_page_size, range.size() - offset);
+        fatal_if(gzread(compressed_mem, pmem + offset, len) != (int)len,
+                 "Truncated physical memory checkpoint file '%s'\n",
+                 filepath);
+    }
+    fatal_if(bytes_read < 0, "Read failed on physical memory checkpoint "
+             "file '%s'\n", filepath);
+
+    if (gzclose(compressed_mem))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filepath);
+}
+
+void
+PhysicalMemory::unserializeStoreChunked(CheckpointIn &cp,
+                                        unsigned int store_id,
+                                        const std::string &filepath)
+{
+    uint8_t* pmem = backingStore[store_id].pmem;
+    AddrRange range = backingStore[store_id].range;
+
+    long range_size;
+    UNSERIALIZE_SCALAR(range_size);
+    uint64_t chunk_size;
+    UNSERIALIZE_SCALAR(chunk_size);
+    std::string compression;
+    UNSERIALIZE_SCALAR(compression);
+
+    DPRINTF(Checkpoint, "Unserializing physical memory %s with size %d "
+            "using %s on %d threads\n", filepath, range_size, compression,
+            checkpointThreads);
+
+    if (range_size != range.size())
+        fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+              range_size, range.size());
+
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
+    // read the index from the end of the file
+    struct stat st;
+    uint64_t trailer[2];
+    fatal_if(fstat(fd, &st) || st.st_size < (off_t)sizeof(trailer) ||
+             pread(fd, trailer, sizeof(trailer),
+                   st.st_size - sizeof(trailer)) != sizeof(trailer) ||
+             trailer[1] != CheckpointChunkMagic,
+             "Corrupt physical memory checkpoint file '%s'\n", filepath);
+
+    const uint64_t index_bytes = trailer[0] * sizeof(CheckpointChunk);
+    std::vector<CheckpointChunk> index(trailer[0]);
+    fatal_if(st.st_size < (off_t)(sizeof(trailer) + index_bytes) ||
+             pread(fd, index.data(), index_bytes,
+                   st.st_size - sizeof(trailer) - index_bytes) !=
+             (ssize_t)index_bytes,
+             "Corrupt physical memory checkpoint file '%s'\n", filepath);
+
+    // chunks that are missing are all zero, and so is the freshly
+    // mapped backing store
+    parallelFor(checkpointThreads, index.size(), [&](uint64_t i) {
+        const CheckpointChunk &c = index[i];
+        const uint64_t start = c.chunk * chunk_size;
+        fatal_if(start >= range.size(),
+                 "Corrupt physical memory checkpoint file '%s'\n",
+                 filepath);
+        const uint64_t len = std::min(chunk_size, range.size() - start);
+
+        std::vector<uint8_t> data(c.size);
+        fatal_if(pread(fd, data.data(), c.size, c.offset) !=
+                 (ssize_t)c.size ||
+                 !decompressChunk(compression, data.data(), c.size,
+                                  pmem + start, len),
+                 "Corrupt physical memory checkpoint file '%s'\n",
+                 filepath);
+    });
+
+    close(fd);
+}
+
+void
+PhysicalMemory::unserializeStoreRaw(CheckpointIn &cp, unsigned int store_id,
+                                    const std::string &filepath)
+{
+    const BackingStoreEntry &store = backingStore[store_id];
+    uint8_t* pmem = store.pmem;
+    AddrRange range = store.range;
+
+    long range_size;
+    UNSERIALIZE_SCALAR(range_size);
+
+    if (range_size != range.size())
+        fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+              range_size, range.size());
+
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
+    // a shared backing store has to stay mapped to its shmem segment,
+    // so it can only be read
+    if (lazyRestore && store.shmFd == -1) {
+        DPRINTF(Checkpoint, "Mapping physical memory %s with size %d\n",
+                filepath, range_size);
+
+        // replace the anonymous mapping with a private mapping of the
+        // file, keeping the address the memories already point to
+        int map_flags = MAP_PRIVATE | MAP_FIXED;
+        if (mmapUsingNoReserve)
+            map_flags |= MAP_NORESERVE;
+        if (mmap(pmem, range.size(), PROT_READ | PROT_WRITE, map_flags,
+                 fd, 0) == MAP_FAILED) {
+            perror("mmap");
+            fatal("Could not map physical memory checkpoint file '%s'\n",
+                  filepath);
+        }
+        close(fd);
+        return;
+    }
+
+    DPRINTF(Checkpoint, "Unserializing physical memory %s with size %d\n",
+            filepath, range_size);
+
+    // only copy the chunks that are non-zero, so we don't touch more
+    // of the backing store than necessary
+    std::vector<uint8_t> chunk(CheckpointChunkBytes);
+    for (uint64_t start = 0; start < range.size();
+         start += CheckpointChunkBytes) {
+        const uint64_t len =
+            std::min(CheckpointChunkBytes, range.size() - start);
+        fatal_if(pread(fd, chunk.data(), len, start) != (ssize_t)len,
+                 "Truncated physical memory checkpoint file '%s'\n",
+                 filepath);
+        if (!isZeroChunk(chunk.data(), len))
+            std::memcpy(pmem + start, chunk.data(), len);
+    }
+
+    close(fd);
+}
+
+void
+PhysicalMemory::unserializeStorePages(CheckpointIn &cp, unsigned int store_id,
+                                      const std::string &filepath)
+{
+    uint8_t* pmem = backingStore[store_id].pmem;
+    AddrRange range = backingStore[store_id].range;
+
+    long range_size;
+    UNSERIALIZE_SCALAR(range_size);
+    std::string page_store;
+    UNSERIALIZE_SCALAR(page_store);
+    uint64_t page_store_block;
+    UNSERIALIZE_SCALAR(page_store_block);
+
+    DPRINTF(Checkpoint, "Unserializing physical memory %s with size %d "
+            "from page store %s\n", filepath, range_size, page_store);
+
+    if (range_size != range.size())
+        fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+              range_size, range.size());
+
+    FILE *f = fopen(filepath.c_str(), "rb");
+    if (f == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+    std::vector<PageStoreBlock> blocks;
+    PageStoreBlock b;
+    while (fread(&b, sizeof(b), 1, f) == 1)
+        blocks.push_back(b);
+    fatal_if(ferror(f), "Read failed on physical memory checkpoint file "
+             "'%s'\n", filepath);
+    fclose(f);
+
+    // blocks that are not listed are all zero, and so is the freshly
+    // mapped backing store
+    parallelFor(checkpointThreads, blocks.size(), [&](uint64_t i) {
+        const uint64_t start = blocks[i].block * page_store_block;
+        fatal_if(start >= range.size(),
+                 "Corrupt physical memory checkpoint file '%s'\n",
+                 filepath);
+        const uint64_t len = std::min(page_store_block, range.size() - start);
+
+        const std::string path = pageStorePath(page_store, blocks[i].hash);
+        FILE *bf = fopen(path.c_str(), "rb");
+        fatal_if(bf == NULL, "Missing page store block '%s'\n", path);
+        std::vector<uint8_t> data;
+        uint8_t buf[16384];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), bf)) > 0)
+            data.insert(data.end(), buf, buf + n);
+        fclose(bf);
+
+        fatal_if(!decompressChunk("zlib", data.data(), data.size(),
+                                  pmem + start, len),
+                 "Corrupt page store block '%s'\n", path);
+    });
+}
+
 } // namespace memory
 } // namespace gem5
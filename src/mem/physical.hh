@@ -162,6 +162,43 @@ class PhysicalMemory : public Serializable
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // The memories backed by each backing store, in the same order
+    std::vector<std::vector<AbstractMemory*>> storeMemories;
+
+    // Only checkpoint the pages written since the last checkpoint
+    const bool deltaCheckpoints;
+
+    // Store full checkpoints as independently compressed chunks
+    const bool chunkedCheckpoints;
+
+    // Store full checkpoints uncompressed as sparse files
+    const bool rawCheckpoints;
+
+    // Map uncompressed checkpoints copy-on-write when restoring
+    const bool lazyRestore;
+
+    // Shared content-addressed store for the memory contents, if any
+    const std::string pageStore;
+
+    // Host threads used for chunked checkpoint (de)compression
+    const unsigned checkpointThreads;
+
+    // Ask for transparent huge pages for the backing store
+    const bool hugePages;
+
+    // Allocate the backing store from the hugetlbfs pool
+    const bool hugetlb;
+
+    // Host NUMA node to bind each backing store to, -1 for none
+    const std::vector<int> numaNodes;
+
+    // Set if writes may have bypassed the dirty tracking of the memories
+    bool dirtyTracking;
+
+    // The checkpoint the memory contents were last saved to or
+    // restored from, if any, which a delta checkpoint refers to
+    mutable std::string parentCheckpoint;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -191,7 +228,15 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   bool delta_checkpoints=false,
+                   bool chunked_checkpoints=false,
+                   bool raw_checkpoints=false,
+                   bool lazy_restore=false,
+                   const std::string& page_store="",
+                   unsigned checkpoint_threads=0,
+                   bool huge_pages=false, bool hugetlb=false,
+                   const std::vector<int>& numa_nodes={});
 
     /**
      * Unmap all the backing store we have used.
@@ -245,6 +290,40 @@ class PhysicalMemory : public Serializable
     std::vector<BackingStoreEntry> getBackingStore() const
     { return backingStore; }
 
+    /**
+     * Stop relying on the dirty page tracking of the memories, for
+     * users that write to the backing store directly (e.g. KVM). All
+     * subsequent checkpoints are then full checkpoints.
+     */
+    void disableDirtyTracking() { dirtyTracking = false; }
+
+    /**
+     * Get direct host access to a range of guest physical memory. The
+     * range has to be backed by a single, non-interleaved memory.
+     *
+     * @param addr Start address of the range.
+     * @param size Size of the range in bytes.
+     * @param write Whether the range is going to be written.
+     * @return Pointer to the host memory, or nullptr if the range can't
+     *         be accessed directly.
+     */
+    uint8_t *hostRange(Addr addr, Addr size, bool write);
+
+    /**
+     * Replace the backing store of a range of guest physical memory with
+     * a private, copy-on-write mapping of a file, so that its contents
+     * are only read from the file when they are touched. The range and
+     * the file offset have to be aligned to host pages, and the range has
+     * to be backed by a single, non-interleaved memory that isn't shared.
+     *
+     * @param addr Start address of the range.
+     * @param size Size of the range in bytes.
+     * @param fd File to map.
+     * @param offset Offset of the range in the file.
+     * @return Whether the file was mapped.
+     */
+    bool mapFile(Addr addr, Addr size, int fd, off_t offset);
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -284,6 +363,53 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Serialize the pages of a specific store that were written since
+     * the parent checkpoint.
+     *
+     * @param store_id Unique identifier of this backing store
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeStoreDelta(CheckpointOut &cp, unsigned int store_id,
+                             AddrRange range, uint8_t* pmem) const;
+
+    /**
+     * Serialize a specific store as a set of independently compressed
+     * chunks, skipping the chunks that are all zero. The chunks are
+     * compressed in parallel and followed by an index of where each
+     * chunk is stored in the file.
+     *
+     * @param store_id Unique identifier of this backing store
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeStoreChunked(CheckpointOut &cp, unsigned int store_id,
+                               AddrRange range, uint8_t* pmem) const;
+
+    /**
+     * Serialize a specific store as an uncompressed image of the
+     * backing store, leaving holes in the file for all-zero pages.
+     *
+     * @param store_id Unique identifier of this backing store
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeStoreRaw(CheckpointOut &cp, unsigned int store_id,
+                           AddrRange range, uint8_t* pmem) const;
+
+    /**
+     * Serialize a specific store to the shared page store, adding the
+     * blocks that are not in the page store yet and listing the hash
+     * of each block in the checkpoint.
+     *
+     * @param store_id Unique identifier of this backing store
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeStorePages(CheckpointOut &cp, unsigned int store_id,
+                             AddrRange range, uint8_t* pmem) const;
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
@@ -296,6 +422,36 @@ class PhysicalMemory : public Serializable
      */
     void unserializeStore(CheckpointIn &cp);
 
+    /**
+     * Unserialize a delta of a specific backing store on top of the
+     * contents of its parent checkpoint.
+     */
+    void unserializeStoreDelta(CheckpointIn &cp, unsigned int store_id,
+                               const std::string &filepath,
+                               const std::string &parent_checkpoint);
+
+    /**
+     * Unserialize a chunked backing store, decompressing the chunks
+     * in parallel.
+     */
+    void unserializeStoreChunked(CheckpointIn &cp, unsigned int store_id,
+                                 const std::string &filepath);
+
+    /**
+     * Unserialize an uncompressed backing store, either by reading it
+     * or, for lazy restores, by mapping it copy-on-write in place of
+     * the current backing store.
+     */
+    void unserializeStoreRaw(CheckpointIn &cp, unsigned int store_id,
+                             const std::string &filepath);
+
+    /**
+     * Unserialize a backing store from the blocks listed in the
+     * checkpoint, as found in the shared page store.
+     */
+    void unserializeStorePages(CheckpointIn &cp, unsigned int store_id,
+                               const std::string &filepath);
+
 };
 
 } // namespace memory
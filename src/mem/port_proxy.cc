@@ -37,6 +37,9 @@
 
 #include "mem/port_proxy.hh"
 
+#include <algorithm>
+#include <vector>
+
 #include "base/chunk_generator.hh"
 #include "cpu/thread_context.hh"
 #include "mem/port.hh"
@@ -61,7 +64,7 @@ PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::ReadReq);
@@ -78,7 +81,7 @@ PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::WriteReq);
@@ -92,13 +95,22 @@ void
 PortProxy::memsetBlobPhys(Addr addr, Request::Flags flags,
                           uint8_t v, int size) const
 {
-    // quick and dirty...
-    uint8_t *buf = new uint8_t[size];
+    // Write every chunk from the same line sized buffer rather than
+    // allocating one as large as the whole range, which can be the size
+    // of a memory.
+    int chunk = _cacheLineSize ? std::min<int>(size, _cacheLineSize) : size;
+    std::vector<uint8_t> buf(chunk, v);
+
+    for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
+         gen.next()) {
 
-    std::memset(buf, v, size);
-    PortProxy::writeBlobPhys(addr, flags, buf, size);
+        auto req = Request::create(
+            gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
-    delete [] buf;
+        Packet pkt(req, MemCmd::WriteReq);
+        pkt.dataStaticConst(buf.data());
+        sendFunctional(&pkt);
+    }
 }
 
 bool
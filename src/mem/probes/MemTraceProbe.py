@@ -51,5 +51,12 @@ class MemTraceProbe(BaseMemProbe):
     # packet trace output file, disabled by default
     trace_file = Param.String("", "Packet trace output file")
 
+    # Write fixed size binary records from a background thread rather
+    # than protobuf messages
+    binary_format = Param.Bool(False, "Write the trace in the binary "
+                               "record format")
+    ring_records = Param.Unsigned(65536, "Records buffered for the writer "
+                                  "thread in the binary format")
+
     # System object to look up the name associated with a requestor ID
     system = Param.System(Parent.any, "System the probe belongs to")
@@ -60,3 +60,11 @@ class StackDistProbe(BaseMemProbe):
     # logarithmic histogram bins and enable/disable
     log_hist_bins = Param.Unsigned('32', "Bins in logarithmic histograms")
     disable_log_hists = Param.Bool(False, "Disable logarithmic histograms")
+
+    # Estimate the stack distances from a bounded sample of the lines
+    # (SHARDS) rather than tracking all of them
+    sample_size = Param.Unsigned(0, "Maximum number of lines to sample "
+                                 "(0 to compute exact stack distances)")
+
+    # points of the miss ratio curve, for caches of 1, 2, 4, ... lines
+    mrc_points = Param.Unsigned(24, "Points in the miss ratio curve")
@@ -37,6 +37,9 @@
 
 #include "mem/probes/mem_trace.hh"
 
+#include <chrono>
+#include <ostream>
+
 #include "base/callback.hh"
 #include "base/output.hh"
 #include "params/MemTraceProbe.hh"
@@ -52,6 +55,7 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
     : BaseMemProbe(p),
       traceStream(nullptr),
       system(p.system),
+      binaryFile(nullptr),
       withPC(p.with_pc)
 {
     std::string filename;
@@ -69,12 +73,19 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
             filename = filename + suffix;
     } else {
         // Generate a filename from the name of the SimObject. Append .trc
-        // and .gz if we want compression enabled.
-        filename = simout.resolve(name() + ".trc" +
+        // (or .bin) and .gz if we want compression enabled.
+        filename = simout.resolve(name() +
+                                  (p.binary_format ? ".bin" : ".trc") +
                                   (p.trace_compress ? ".gz" : ""));
     }
 
-    traceStream = new ProtoOutputStream(filename);
+    if (p.binary_format) {
+        ring.reset(new SpscRing<Record>(p.ring_records));
+        // simout compresses the file if the name ends with .gz
+        binaryFile = simout.create(filename, true);
+    } else {
+        traceStream = new ProtoOutputStream(filename);
+    }
 
     // Register a callback to compensate for the destructor not
     // being called. The callback forces the stream to flush and
@@ -85,6 +96,22 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
 void
 MemTraceProbe::startup()
 {
+    if (binaryFile) {
+        std::ostream &os = *binaryFile->stream();
+        const Header header{Magic, Version, sizeof(Record),
+            sim_clock::Frequency, (uint32_t)system->maxRequestors(), 0};
+        os.write((const char *)&header, sizeof(header));
+        for (int i = 0; i < system->maxRequestors(); i++) {
+            const std::string id = system->getRequestorName(i);
+            const uint32_t len = id.size();
+            os.write((const char *)&len, sizeof(len));
+            os.write(id.data(), len);
+        }
+
+        writer = std::thread([this]() { writeRecords(); });
+        return;
+    }
+
     // Create a protobuf message for the header and write it to
     // the stream
     ProtoMessage::PacketHeader header_msg;
@@ -105,11 +132,57 @@ MemTraceProbe::closeStreams()
 {
     if (traceStream != NULL)
         delete traceStream;
+
+    if (binaryFile) {
+        if (writer.joinable()) {
+            stopping.store(true, std::memory_order_release);
+            writer.join();
+        }
+        simout.close(binaryFile);
+        binaryFile = nullptr;
+    }
+}
+
+void
+MemTraceProbe::writeRecords()
+{
+    std::ostream &os = *binaryFile->stream();
+    while (true) {
+        // Check before looking at the ring, so nothing added before
+        // closeStreams() is left behind.
+        const bool last = stopping.load(std::memory_order_acquire);
+
+        const Record *first;
+        size_t n = ring->peek(first);
+        if (n) {
+            os.write((const char *)first, n * sizeof(Record));
+            ring->pop(n);
+        } else if (last) {
+            break;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
 }
 
 void
 MemTraceProbe::handleRequest(const probing::PacketInfo &pkt_info)
 {
+    if (ring) {
+        Record rec{};
+        rec.tick = curTick();
+        rec.addr = pkt_info.addr;
+        if (withPC)
+            rec.pc = pkt_info.pc;
+        rec.pktId = pkt_info.id;
+        rec.flags = pkt_info.flags;
+        rec.size = pkt_info.size;
+        rec.cmd = pkt_info.cmd.toInt();
+        while (!ring->push(rec))
+            std::this_thread::yield();
+        return;
+    }
+
     ProtoMessage::Packet pkt_msg;
 
     pkt_msg.set_tick(curTick());
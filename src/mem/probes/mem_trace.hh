@@ -38,6 +38,12 @@
 #ifndef __MEM_PROBES_MEM_TRACE_HH__
 #define __MEM_PROBES_MEM_TRACE_HH__
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "base/spsc_ring.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "proto/protoio.hh"
@@ -46,11 +52,54 @@ namespace gem5
 {
 
 struct MemTraceProbeParams;
+class OutputStream;
 class System;
 
+/**
+ * Probe that writes the packets it sees to a trace file. By default
+ * every packet is written as a protobuf message, from the simulation
+ * thread. With binary_format, a packet is only copied into a fixed size
+ * Record on a lock-free ring, and a writer thread of the probe drains
+ * the ring into the (usually gzipped) file in bulk. When the ring is
+ * full the simulation waits for the writer rather than dropping
+ * records.
+ *
+ * A binary trace starts with a Header, followed by numRequestors
+ * requestor names, each as a uint32_t length and the characters, and
+ * then the Records. TraceGen and util/decode_packet_trace.py read both
+ * formats.
+ */
 class MemTraceProbe : public BaseMemProbe
 {
   public:
+    static constexpr uint64_t Magic = 0x4352544d354d4547ULL; // "GEM5MTRC"
+    static constexpr uint32_t Version = 1;
+
+    struct Header
+    {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t recordSize;
+        uint64_t tickFrequency;
+        uint32_t numRequestors;
+        uint32_t reserved;
+    };
+
+    /** One packet. The pc is zero if it is not known or not traced. */
+    struct Record
+    {
+        uint64_t tick;
+        uint64_t addr;
+        uint64_t pc;
+        uint64_t pktId;
+        uint32_t flags;
+        uint32_t size;
+        uint16_t cmd;
+        uint16_t reserved[3];
+    };
+
+    static_assert(sizeof(Record) == 48, "Records should be packed");
+
     MemTraceProbe(const MemTraceProbeParams &params);
 
   protected:
@@ -71,6 +120,16 @@ class MemTraceProbe : public BaseMemProbe
 
     System *system;
 
+    /** Ring and file of the binary format */
+    std::unique_ptr<SpscRing<Record>> ring;
+    OutputStream *binaryFile;
+
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+
+    /** Body of the writer thread of the binary format. */
+    void writeRecords();
+
   private:
 
     /** Include the Program Counter in the memory trace */
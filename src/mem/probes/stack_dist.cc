@@ -37,6 +37,10 @@
 
 #include "mem/probes/stack_dist.hh"
 
+#include <algorithm>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
 #include "params/StackDistProbe.hh"
 #include "sim/system.hh"
 
@@ -49,11 +53,19 @@ StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
       calc(p.verify),
+      sampledCalc(p.sample_size ?
+                  new SampledStackDistCalc(p.sample_size) : nullptr),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
              "The stack distance probe must use a cache line size that is "
              "larger or equal to the system's cahce line size.");
+    fatal_if(p.verify && p.sample_size,
+             "The stack distance probe can't verify sampled stack "
+             "distances.");
+    fatal_if(p.mrc_points > 64,
+             "The stack distance probe supports at most 64 points in the "
+             "miss ratio curve.");
 }
 
 StackDistProbe::StackDistProbeStats::StackDistProbeStats(
@@ -68,7 +80,11 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
       ADD_STAT(writeLogHist, statistics::units::Ratio::get(),
                "Writes logarithmic distribution"),
       ADD_STAT(infiniteSD, statistics::units::Count::get(),
-               "Number of requests with infinite stack distance")
+               "Number of requests with infinite stack distance"),
+      ADD_STAT(missRatio, statistics::units::Ratio::get(),
+               "Miss ratio of a fully associative LRU cache of the given "
+               "number of lines"),
+      totalWeight(0)
 {
     using namespace statistics;
 
@@ -93,6 +109,49 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
 
     infiniteSD
         .flags(nozero);
+
+    missRatio
+        .init(p.mrc_points)
+        .flags(nozero);
+    for (unsigned i = 0; i < p.mrc_points; i++)
+        missRatio.subname(i, csprintf("lines_%d", 1ULL << i));
+    hitWeights.resize(p.mrc_points, 0);
+}
+
+void
+StackDistProbe::StackDistProbeStats::sampleMissRatio(uint64_t sd,
+                                                     double weight)
+{
+    totalWeight += weight;
+    if (sd == StackDistCalc::Infinity)
+        return;
+
+    // A cache of 2^i lines hits if fewer than 2^i other lines were
+    // accessed since
+    unsigned i = sd == 0 ? 0 : floorLog2(sd) + 1;
+    if (i < hitWeights.size())
+        hitWeights[i] += weight;
+}
+
+void
+StackDistProbe::StackDistProbeStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    double hits = 0;
+    for (unsigned i = 0; i < hitWeights.size(); i++) {
+        hits += hitWeights[i];
+        missRatio[i] = totalWeight ? 1 - hits / totalWeight : 0;
+    }
+}
+
+void
+StackDistProbe::StackDistProbeStats::resetStats()
+{
+    statistics::Group::resetStats();
+
+    std::fill(hitWeights.begin(), hitWeights.end(), 0);
+    totalWeight = 0;
 }
 
 void
@@ -107,7 +166,19 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
     // Calculate the stack distance
-    const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
+    uint64_t sd;
+    double weight = 1;
+    if (sampledCalc) {
+        sd = sampledCalc->calcStackDistAndUpdate(aligned_addr);
+        if (sd == SampledStackDistCalc::NotSampled)
+            return;
+        // Each sampled access stands for the ones to unsampled lines
+        weight = 1 / sampledCalc->samplingRate();
+    } else {
+        sd = calc.calcStackDistAndUpdate(aligned_addr).first;
+    }
+
+    stats.sampleMissRatio(sd, weight);
     if (sd == StackDistCalc::Infinity) {
         stats.infiniteSD++;
         return;
@@ -38,8 +38,12 @@
 #ifndef __MEM_PROBES_STACK_DIST_HH__
 #define __MEM_PROBES_STACK_DIST_HH__
 
+#include <memory>
+#include <vector>
+
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
+#include "mem/sampled_stack_dist.hh"
 #include "mem/stack_dist_calc.hh"
 #include "sim/stats.hh"
 
@@ -69,10 +73,20 @@ class StackDistProbe : public BaseMemProbe
   protected:
     StackDistCalc calc;
 
+    // Approximate calculator, used instead of calc if sampling
+    std::unique_ptr<SampledStackDistCalc> sampledCalc;
+
     struct StackDistProbeStats : public statistics::Group
     {
         StackDistProbeStats(StackDistProbe* parent);
 
+        void preDumpStats() override;
+        void resetStats() override;
+
+        // Account an access, which represents weight accesses when
+        // sampling, in the miss ratio curve
+        void sampleMissRatio(uint64_t sd, double weight);
+
         // Reads linear histogram
         statistics::Histogram readLinearHist;
 
@@ -87,6 +101,14 @@ class StackDistProbe : public BaseMemProbe
 
         // Writes logarithmic histogram
         statistics::Scalar infiniteSD;
+
+        // Miss ratio of fully associative LRU caches of 2^i lines
+        statistics::Vector missRatio;
+
+        // Accesses hitting in a cache of 2^i lines but not in a smaller
+        // one, and all the accesses, for computing missRatio
+        std::vector<double> hitWeights;
+        double totalWeight;
     } stats;
 };
 
@@ -41,6 +41,7 @@
 #ifndef __MEM_GEM5_PROTOCOL_FUNCTIONAL_HH__
 #define __MEM_GEM5_PROTOCOL_FUNCTIONAL_HH__
 
+#include "mem/backdoor.hh"
 #include "mem/packet.hh"
 
 namespace gem5
@@ -62,6 +63,16 @@ class FunctionalRequestProtocol
      */
     void send(FunctionalResponseProtocol *peer, PacketPtr pkt) const;
 
+    /**
+     * Request a back door to a range of memory, without sending a packet.
+     *
+     * @param req Description of the requested back door.
+     * @param backdoor Set to a back door pointer by the target, if it can
+     *        provide one.
+     */
+    void sendMemBackdoorReq(FunctionalResponseProtocol *peer,
+            const MemBackdoorReq &req, MemBackdoorPtr &backdoor);
+
     /**
      * Receive a functional snoop request packet from the peer.
      */
@@ -86,6 +97,12 @@ class FunctionalResponseProtocol
      * Receive a functional request packet from the peer.
      */
     virtual void recvFunctional(PacketPtr pkt) = 0;
+
+    /**
+     * Receive a request for a back door to a range of memory.
+     */
+    virtual void recvMemBackdoorReq(const MemBackdoorReq &req,
+            MemBackdoorPtr &backdoor) = 0;
 };
 
 } // namespace gem5
@@ -121,3 +121,40 @@ class QoSPropFairPolicy(QoSPolicy):
                         request_port.getCCObject(), float(score))
 
     weight = Param.Float(0.5, "Pf score weight")
+
+class QoSReservationPolicy(QoSPolicy):
+    type = 'QoSReservationPolicy'
+    cxx_header = "mem/qos/policy_reservation.hh"
+    cxx_class = 'gem5::memory::qos::ReservationPolicy'
+
+    cxx_exports = [
+        PyBindMethod('initRequestorName'),
+        PyBindMethod('initRequestorObj'),
+    ]
+
+    _requestor_reservations = None
+
+    def setReservation(self, request_port, bandwidth):
+        if not self._requestor_reservations:
+            self._requestor_reservations = []
+
+        self._requestor_reservations.append(
+            [request_port, MemoryBandwidth(bandwidth)])
+
+    def init(self):
+        if not self._requestor_reservations:
+            print("Error, use setReservation to reserve bandwidth\n");
+            exit(1)
+        else:
+            for res in self._requestor_reservations:
+                request_port = res[0]
+                bandwidth = float(res[1])
+                if isinstance(request_port, str):
+                    self.getCCObject().initRequestorName(
+                        request_port, bandwidth)
+                else:
+                    self.getCCObject().initRequestorObj(
+                        request_port.getCCObject(), bandwidth)
+
+    bucket_depth = Param.MemorySize("1KiB", "Maximum number of bytes a "
+        "requestor can accumulate while issuing below its reservation")
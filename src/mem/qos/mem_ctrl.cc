@@ -356,18 +356,18 @@ MemCtrl::MemCtrlStats::regStats()
 }
 
 void
-MemCtrl::recordTurnaroundStats()
+MemCtrl::recordTurnaroundStats(BusState bus_state, BusState bus_state_next)
 {
-    if (busStateNext != busState) {
-        if (busState == READ) {
+    if (bus_state_next != bus_state) {
+        if (bus_state == READ) {
             stats.numWriteReadTurnArounds++;
-        } else if (busState == WRITE) {
+        } else if (bus_state == WRITE) {
             stats.numReadWriteTurnArounds++;
         }
     } else {
-        if (busState == READ) {
+        if (bus_state == READ) {
             stats.numStayReadState++;
-        } else if (busState == WRITE) {
+        } else if (bus_state == WRITE) {
             stats.numStayWriteState++;
         }
     }
@@ -243,7 +243,16 @@ class MemCtrl : public ClockedObject
      * Record statistics on turnarounds based on
      * busStateNext and busState values
      */
-    void recordTurnaroundStats();
+    void recordTurnaroundStats() { recordTurnaroundStats(busState,
+                                                         busStateNext); }
+
+    /**
+     * Record statistics on turnarounds of a bus
+     *
+     * @param bus_state Current direction of the bus
+     * @param bus_state_next Direction selected for the next access
+     */
+    void recordTurnaroundStats(BusState bus_state, BusState bus_state_next);
 
     /**
      * Escalates/demotes priority of all packets
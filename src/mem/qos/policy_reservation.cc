@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/qos/policy_reservation.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "params/QoSReservationPolicy.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace qos
+{
+
+ReservationPolicy::ReservationPolicy(const Params &p)
+  : Policy(p), depth(p.bucket_depth), stats(*this)
+{
+    fatal_if(depth == 0, "bucket_depth must be larger than zero");
+}
+
+template <typename Requestor>
+void
+ReservationPolicy::initRequestor(const Requestor requestor,
+                                 const double bandwidth)
+{
+    RequestorID id = memCtrl->system()->lookupRequestorId(requestor);
+
+    assert(id != Request::invldRequestorId);
+    fatal_if(bandwidth <= 0, "Reserved bandwidth must be positive");
+
+    if (id >= buckets.size())
+        buckets.resize(id + 1);
+
+    // Buckets start full, so a requestor can burst from the beginning
+    // of the simulation
+    Bucket &bucket = buckets[id];
+    bucket.rate = bandwidth / sim_clock::Frequency;
+    bucket.tokens = depth;
+    bucket.lastRefill = curTick();
+}
+
+void
+ReservationPolicy::initRequestorName(const std::string requestor,
+                                     const double bandwidth)
+{
+    initRequestor(requestor, bandwidth);
+}
+
+void
+ReservationPolicy::initRequestorObj(const SimObject* requestor,
+                                    const double bandwidth)
+{
+    initRequestor(requestor, bandwidth);
+}
+
+uint8_t
+ReservationPolicy::schedule(const RequestorID id, const uint64_t pkt_size)
+{
+    if (id < buckets.size() && buckets[id].rate > 0) {
+        Bucket &bucket = buckets[id];
+        const Tick now = curTick();
+
+        bucket.tokens = std::min(depth, bucket.tokens +
+                                 (now - bucket.lastRefill) * bucket.rate);
+        bucket.lastRefill = now;
+
+        if (bucket.tokens > 0) {
+            bucket.tokens -= pkt_size;
+            stats.reservationMet[id]++;
+            return memCtrl->numPriorities() - 1;
+        }
+
+        stats.reservationMissed[id]++;
+    }
+
+    stats.bestEffortBytes[id] += pkt_size;
+    return 0;
+}
+
+ReservationPolicy::ReservationStats::ReservationStats(ReservationPolicy &p)
+    : statistics::Group(&p), policy(p),
+      ADD_STAT(reservationMet, statistics::units::Count::get(),
+               "Number of packets issued within the reservation"),
+      ADD_STAT(reservationMissed, statistics::units::Count::get(),
+               "Number of packets issued with the reservation exhausted"),
+      ADD_STAT(bestEffortBytes, statistics::units::Byte::get(),
+               "Number of bytes scheduled as best effort traffic")
+{
+}
+
+void
+ReservationPolicy::ReservationStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    System *system = policy.memCtrl->system();
+    const auto max_requestors = system->maxRequestors();
+
+    reservationMet.init(max_requestors).flags(nozero);
+    reservationMissed.init(max_requestors).flags(nozero);
+    bestEffortBytes.init(max_requestors).flags(nozero);
+
+    for (int i = 0; i < max_requestors; i++) {
+        const std::string requestor = system->getRequestorName(i);
+        reservationMet.subname(i, requestor);
+        reservationMissed.subname(i, requestor);
+        bestEffortBytes.subname(i, requestor);
+    }
+}
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_QOS_POLICY_RESERVATION_HH__
+#define __MEM_QOS_POLICY_RESERVATION_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/qos/policy.hh"
+#include "mem/request.hh"
+
+namespace gem5
+{
+
+struct QoSReservationPolicyParams;
+
+namespace memory
+{
+
+namespace qos
+{
+
+/**
+ * Bandwidth reservation QoS Policy
+ * Every requestor with a reservation owns a token bucket that is
+ * refilled at the reserved bandwidth and capped at the configured
+ * depth. A packet issued while its requestor still has tokens is
+ * within the reservation and gets the highest QoS priority; any
+ * other packet is best effort and gets priority zero.
+ *
+ * The buckets are kept in a vector indexed by RequestorID, and are
+ * refilled lazily when a packet of the requestor is scheduled, so
+ * accounting a packet costs a single vector access.
+ */
+class ReservationPolicy : public Policy
+{
+    using Params = QoSReservationPolicyParams;
+
+  public:
+    ReservationPolicy(const Params &);
+
+    /**
+     * Reserve bandwidth for a requestor by providing the requestor's
+     * name. The requestor's name has to match a name in the system.
+     *
+     * @param requestor requestor's name to lookup.
+     * @param bandwidth reserved bandwidth in bytes per second
+     */
+    void initRequestorName(const std::string requestor,
+                           const double bandwidth);
+
+    /**
+     * Reserve bandwidth for a requestor by providing the requestor's
+     * SimObject pointer. The requestor's pointer has to match a
+     * requestor in the system.
+     *
+     * @param requestor requestor's SimObject pointer to lookup.
+     * @param bandwidth reserved bandwidth in bytes per second
+     */
+    void initRequestorObj(const SimObject* requestor,
+                          const double bandwidth);
+
+    /**
+     * Schedules a packet based on the requestor's reservation
+     *
+     * @param id requestor id to schedule
+     * @param pkt_size size of the packet
+     * @return QoS priority value
+     */
+    uint8_t schedule(const RequestorID id, const uint64_t pkt_size) override;
+
+  protected:
+    template <typename Requestor>
+    void initRequestor(const Requestor requestor, const double bandwidth);
+
+    struct Bucket
+    {
+        /** Refill rate in bytes per tick, zero when not reserved */
+        double rate = 0;
+
+        /**
+         * Available bytes; it may go negative, as a packet is admitted
+         * as long as the bucket is not empty
+         */
+        double tokens = 0;
+
+        /** Tick of the last refill */
+        Tick lastRefill = 0;
+    };
+
+    /** Maximum number of bytes a bucket can accumulate */
+    const double depth;
+
+    /** Token bucket of every requestor, indexed by RequestorID */
+    std::vector<Bucket> buckets;
+
+    struct ReservationStats : public statistics::Group
+    {
+        ReservationStats(ReservationPolicy &p);
+
+        void regStats() override;
+
+        const ReservationPolicy &policy;
+
+        /** Packets issued within the requestor's reservation */
+        statistics::Vector reservationMet;
+
+        /** Packets issued after the requestor's reservation ran out */
+        statistics::Vector reservationMissed;
+
+        /** Bytes scheduled as best effort traffic */
+        statistics::Vector bestEffortBytes;
+    } stats;
+};
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_QOS_POLICY_RESERVATION_HH__
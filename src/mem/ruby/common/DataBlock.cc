@@ -51,16 +51,22 @@ namespace ruby
 
 DataBlock::DataBlock(const DataBlock &cp)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+    allocStorage();
     memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
+}
+
+void
+DataBlock::allocStorage()
+{
+    const int size = RubySystem::getBlockSizeBytes();
+    m_data = size <= InlineBytes ? m_inline : new uint8_t[size];
     m_alloc = true;
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
+    allocStorage();
     clear();
 }
 
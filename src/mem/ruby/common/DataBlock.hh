@@ -69,8 +69,7 @@ class DataBlock
 
     ~DataBlock()
     {
-        if (m_alloc)
-            delete [] m_data;
+        release();
     }
 
     DataBlock& operator=(const DataBlock& obj);
@@ -91,18 +90,29 @@ class DataBlock
     void print(std::ostream& out) const;
 
   private:
+    // Blocks up to this size are stored in the DataBlock itself, so that
+    // creating one, e.g. in every data message, does not reach the heap
+    static constexpr int InlineBytes = 64;
+
     void alloc();
+    void allocStorage();
+    void
+    release()
+    {
+        if (m_alloc && m_data != m_inline)
+            delete [] m_data;
+    }
+
     uint8_t *m_data;
     bool m_alloc;
+    uint8_t m_inline[InlineBytes];
 };
 
 inline void
 DataBlock::assign(uint8_t *data)
 {
     assert(data != NULL);
-    if (m_alloc) {
-        delete [] m_data;
-    }
+    release();
     m_data = data;
     m_alloc = false;
 }
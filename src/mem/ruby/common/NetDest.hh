@@ -29,6 +29,7 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <array>
 #include <iostream>
 #include <vector>
 
@@ -111,7 +112,10 @@ class NetDest
 
     NodeID bitIndex(NodeID index) const { return index; }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    // One bit vector (i.e. Set) per machine type. The number of machine
+    // types is known when the protocol is built, so a NetDest is a flat
+    // array of bitsets that can be copied without reaching the heap
+    std::array<Set, MachineType_NUM> m_bits;
 };
 
 inline std::ostream&
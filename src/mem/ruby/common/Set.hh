@@ -118,9 +118,7 @@ class Set
     void broadcast()
     {
         bits.set();
-        for (int j = m_nSize; j < NUMBER_BITS_PER_SET; ++j) {
-            bits.reset(j);
-        }
+        bits >>= NUMBER_BITS_PER_SET - m_nSize;
     }
 
     /*
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/gbench/clock_domain.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+#include "params/ClockedObject.hh"
+#include "params/MessageBuffer.hh"
+#include "sim/clocked_object.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+class BenchMessage : public Message
+{
+  public:
+    BenchMessage() : Message(0) {}
+
+    MsgPtr clone() const override
+    {
+        return std::make_shared<BenchMessage>(*this);
+    }
+
+    void print(std::ostream &out) const override { out << "[BenchMessage]"; }
+};
+
+/** A consumer that is never woken up, as the event queue isn't run. */
+class BenchConsumer : public Consumer
+{
+  public:
+    BenchConsumer(ClockedObject *em) : Consumer(em) {}
+
+    void wakeup() override {}
+    void print(std::ostream &out) const override { out << "[BenchConsumer]"; }
+};
+
+/**
+ * Create a buffer with its consumer. They are shared by all the runs,
+ * as the wakeup event of the consumer stays scheduled on the event
+ * queue for the lifetime of the process.
+ */
+MessageBuffer *
+getBuffer()
+{
+    static MessageBuffer *buffer = [] {
+        auto *clocked_params = new ClockedObjectParams;
+        clocked_params->name = "controller";
+        clocked_params->eventq_index = 0;
+        clocked_params->clk_domain = makeBenchClockDomain("clk_domain", 500);
+        clocked_params->power_state = nullptr;
+        auto *controller = new ClockedObject(*clocked_params);
+
+        auto *params = new MessageBufferParams;
+        params->name = "buffer";
+        params->eventq_index = 0;
+        params->allow_zero_latency = false;
+        params->buffer_size = 0;
+        params->max_dequeue_rate = 0;
+        params->ordered = false;
+        params->randomization = MessageRandomization::disabled;
+        params->routing_priority = 0;
+        params->port_out_port_connection_count = 0;
+        params->port_in_port_connection_count = 0;
+
+        auto *buffer = new MessageBuffer(*params);
+        buffer->setConsumer(new BenchConsumer(controller));
+        return buffer;
+    }();
+    return buffer;
+}
+
+/**
+ * Enqueue a batch of messages and dequeue all of them once they have
+ * arrived, which exercises the priority heap of the buffer with the
+ * given number of messages in flight.
+ */
+void
+BM_EnqueueDequeue(benchmark::State &state)
+{
+    MessageBuffer *buffer = getBuffer();
+    const int depth = state.range(0);
+    const Tick latency = 1000;
+    std::vector<MsgPtr> msgs(depth);
+    for (auto &msg : msgs)
+        msg = std::make_shared<BenchMessage>();
+
+    for (auto _ : state) {
+        for (auto &msg : msgs)
+            buffer->enqueue(msg, 0, latency);
+        for (int i = 0; i < depth; i++)
+            buffer->dequeue(latency);
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+
+BENCHMARK(BM_EnqueueDequeue)->RangeMultiplier(4)->Range(1, 256);
+
+} // anonymous namespace
@@ -48,6 +48,7 @@
 #include "base/stl_helpers.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/ruby/system/RubySystem.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -66,6 +67,7 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_randomization(p.randomization),
     m_allow_zero_latency(p.allow_zero_latency),
     m_routing_priority(p.routing_priority),
+    m_rng(name()),
     ADD_STAT(m_not_avail_count, statistics::units::Count::get(),
              "Number of times this buffer did not have N slots available"),
     ADD_STAT(m_msg_count, statistics::units::Count::get(),
@@ -203,18 +205,80 @@ MessageBuffer::peek() const
 
 // FIXME - move me somewhere else
 Tick
-random_time()
+random_time(RandomStream &rng)
 {
     Tick time = 1;
-    time += random_mt.random(0, 3);  // [0...3]
-    if (random_mt.random(0, 7) == 0) {  // 1 in 8 chance
-        time += 100 + random_mt.random(1, 15); // 100 + [1...15]
+    time += rng.random(0, 3);  // [0...3]
+    if (rng.random(0, 7) == 0) {  // 1 in 8 chance
+        time += 100 + rng.random(1, 15); // 100 + [1...15]
     }
     return time;
 }
 
 void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
+{
+    panic_if((delta == 0) && !m_allow_zero_latency,
+           "Delta equals zero and allow_zero_latency is false during enqueue");
+
+    if (isRemoteEnqueue())
+        enqueueRemote(message, current_time, delta);
+    else
+        enqueueLocal(message, current_time, delta);
+}
+
+bool
+MessageBuffer::isRemoteEnqueue() const
+{
+    return inParallelMode && m_consumer != NULL &&
+        m_consumer->getObject()->eventQueue() != curEventQueue();
+}
+
+void
+MessageBuffer::enqueueRemote(MsgPtr message, Tick current_time, Tick delta)
+{
+    // The sender can't look at the consumer side state, so flow control
+    // and sub-quantum latencies can't be honoured across partitions.
+    fatal_if(m_max_size != 0, "%s: buffers between event queues must have "
+             "an unlimited buffer_size\n", name());
+    fatal_if(delta < simQuantum, "%s: latency %d between event queues is "
+             "less than sim_quantum (%d)\n", name(), delta, simQuantum);
+
+    DPRINTF(RubyQueue, "Enqueue from another event queue, delta: %lld, "
+            "Message: %s\n", delta, *(message.get()));
+
+    {
+        std::lock_guard<std::mutex> lock(m_remote_mutex);
+        m_remote_msgs.push_back({message, current_time, delta});
+    }
+
+    // The event reaches the consumer's queue at the next quantum
+    // boundary, which is at most simQuantum ticks away.
+    m_consumer->getObject()->eventQueue()->schedulePooled(
+        [this]{ deliverRemote(); }, "MessageBuffer remote enqueue",
+        current_time + simQuantum);
+}
+
+void
+MessageBuffer::deliverRemote()
+{
+    RemoteMsg msg;
+    {
+        std::lock_guard<std::mutex> lock(m_remote_mutex);
+        assert(!m_remote_msgs.empty());
+        msg = std::move(m_remote_msgs.front());
+        m_remote_msgs.pop_front();
+    }
+
+    // Keep the original arrival time. The message may be late if the
+    // quantum is adaptive and grew past the link latency.
+    Tick arrival = msg.sendTime + msg.delta;
+    Tick now = curTick();
+    enqueueLocal(msg.message, now, arrival > now ? arrival - now : 0);
+}
+
+void
+MessageBuffer::enqueueLocal(MsgPtr message, Tick current_time, Tick delta)
 {
     // record current time incase we have a pop that also adjusts my size
     if (m_time_last_time_enqueue < current_time) {
@@ -227,8 +291,6 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 
     // Calculate the arrival time of the message, that is, the first
     // cycle the message can be dequeued.
-    panic_if((delta == 0) && !m_allow_zero_latency,
-           "Delta equals zero and allow_zero_latency is false during enqueue");
     Tick arrival_time = 0;
 
     // random delays are inserted if the RubySystem level randomization flag
@@ -244,9 +306,9 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
             if (m_last_arrival_time < current_time) {
                 m_last_arrival_time = current_time;
             }
-            arrival_time = m_last_arrival_time + random_time();
+            arrival_time = m_last_arrival_time + random_time(m_rng);
         } else {
-            arrival_time = current_time + random_time();
+            arrival_time = current_time + random_time(m_rng);
         }
     }
 
@@ -277,9 +339,9 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    // Insert the message in arrival order
+    insertMessage(message);
+    updateReadyFlag();
     // Increment the number of messages statistic
     m_buf_msgs++;
 
@@ -318,8 +380,8 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
+    m_prio_heap.pop_front();
+    updateReadyFlag();
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -354,6 +416,7 @@ void
 MessageBuffer::clear()
 {
     m_prio_heap.clear();
+    updateReadyFlag();
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -369,16 +432,30 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
     MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    m_prio_heap.pop_front();
 
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    insertMessage(node);
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
+void
+MessageBuffer::insertMessage(const MsgPtr &message)
+{
+    if (m_prio_heap.empty() || !(m_prio_heap.back() > message)) {
+        m_prio_heap.push_back(message);
+        return;
+    }
+
+    // The message goes before the first one that is due after it
+    auto pos = std::upper_bound(m_prio_heap.begin(), m_prio_heap.end(),
+        message, [](const MsgPtr &msg, const MsgPtr &other)
+                 { return other > msg; });
+    m_prio_heap.insert(pos, message);
+}
+
 void
 MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
 {
@@ -386,9 +463,8 @@ MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
         MsgPtr m = lt.front();
         assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
+        insertMessage(m);
+        updateReadyFlag();
 
         m_consumer->scheduleEventAbsolute(schdTick);
 
@@ -503,8 +579,7 @@ MessageBuffer::print(std::ostream& out) const
         ccprintf(out, " consumer-yes ");
     }
 
-    std::vector<MsgPtr> copy(m_prio_heap);
-    std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
+    std::vector<MsgPtr> copy(m_prio_heap.begin(), m_prio_heap.end());
     ccprintf(out, "%s] %s", copy, name());
 }
 
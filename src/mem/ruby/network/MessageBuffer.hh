@@ -49,11 +49,14 @@
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/packet.hh"
@@ -93,9 +96,7 @@ class MessageBuffer : public SimObject
     delayHead(Tick current_time, Tick delta)
     {
         MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
+        m_prio_heap.pop_front();
         enqueue(m, current_time, delta);
     }
 
@@ -115,6 +116,18 @@ class MessageBuffer : public SimObject
 
     Consumer* getConsumer() { return m_consumer; }
 
+    //! Keep the bit of the consumer's ready mask set while the buffer
+    //! holds messages, so that the consumer can skip the buffer without
+    //! looking at it when the bit is clear.
+    void
+    setReadyFlag(uint64_t *mask, int bit)
+    {
+        assert(bit >= 0 && bit < 64);
+        m_ready_mask = mask;
+        m_ready_bit = 1ULL << bit;
+        updateReadyFlag();
+    }
+
     bool getOrdered() { return m_strict_fifo; }
 
     //! Function for extracting the message at the head of the
@@ -123,6 +136,11 @@ class MessageBuffer : public SimObject
 
     const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
 
+    //! Enqueue a message to arrive delta ticks after curTime. When the
+    //! consumer runs on a different event queue than the caller (a
+    //! partitioned parallel Ruby system), the message is handed over to
+    //! the consumer's queue at the next quantum boundary instead, which
+    //! requires an unbounded buffer and delta >= sim_quantum.
     void enqueue(MsgPtr message, Tick curTime, Tick delta);
 
     // Defer enqueueing a message to a later cycle by putting it aside and not
@@ -195,13 +213,57 @@ class MessageBuffer : public SimObject
   private:
     void reanalyzeList(std::list<MsgPtr> &, Tick);
 
+    //! Insert a message in m_prio_heap after the messages that precede it
+    void insertMessage(const MsgPtr &message);
+
+    void
+    updateReadyFlag()
+    {
+        if (!m_ready_mask)
+            return;
+        if (m_prio_heap.empty())
+            *m_ready_mask &= ~m_ready_bit;
+        else
+            *m_ready_mask |= m_ready_bit;
+    }
+
+    //! Insert a message in the buffer. Must run on the consumer's queue.
+    void enqueueLocal(MsgPtr message, Tick current_time, Tick delta);
+
+    //! True if the consumer runs on a queue other than the caller's.
+    bool isRemoteEnqueue() const;
+    void enqueueRemote(MsgPtr message, Tick current_time, Tick delta);
+    void deliverRemote();
+
+    //! A message sent from another partition, waiting to be enqueued.
+    struct RemoteMsg
+    {
+        MsgPtr message;
+        Tick sendTime;
+        Tick delta;
+    };
+
+    //! Messages sent from other partitions, in send order. They are
+    //! handed over by events on the consumer's queue, each of which
+    //! enqueues the oldest pending message.
+    std::mutex m_remote_mutex;
+    std::deque<RemoteMsg> m_remote_msgs;
+
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
-    std::vector<MsgPtr> m_prio_heap;
+
+    //! Pending messages sorted by arrival time, then by enqueue order.
+    //! Messages mostly arrive in order, so inserting one is usually a
+    //! push to the back, and the next message is always at the front.
+    std::deque<MsgPtr> m_prio_heap;
+
+    //! Ready mask of the consumer and the bit of this buffer in it
+    uint64_t *m_ready_mask = nullptr;
+    uint64_t m_ready_bit = 0;
 
     std::function<void()> m_dequeue_callback;
 
@@ -277,6 +339,9 @@ class MessageBuffer : public SimObject
 
     const int m_routing_priority;
 
+    // Delays of the randomized arrivals, independent of other buffers
+    RandomStream m_rng;
+
     int m_input_link_id;
     int m_vnet_id;
 
@@ -290,7 +355,7 @@ class MessageBuffer : public SimObject
     statistics::Formula m_occupancy;
 };
 
-Tick random_time();
+Tick random_time(RandomStream &rng);
 
 inline std::ostream&
 operator<<(std::ostream& out, const MessageBuffer& obj)
@@ -47,6 +47,11 @@ from m5.SimObject import SimObject
 class MessageRandomization(ScopedEnum):
     vals = ['disabled', 'enabled', 'ruby_system']
 
+# Ruby controllers and network objects may be assigned to different event
+# queues through eventq_index. A MessageBuffer whose sender and consumer run
+# on different queues must then have an infinite buffer_size, and the
+# latency of every message sent through it must be at least
+# Root.sim_quantum.
 class MessageBuffer(SimObject):
     type = 'MessageBuffer'
     cxx_class = 'gem5::ruby::MessageBuffer'
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/analytical/AnalyticalNetwork.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/BasicLink.hh"
+#include "mem/ruby/network/BasicRouter.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+AnalyticalNetwork::AnalyticalNetwork(const Params &p)
+    : Network(p), Consumer(this),
+      m_utilization_window(p.utilization_window),
+      m_max_utilization(p.max_utilization),
+      networkStats(this)
+{
+    fatal_if(m_utilization_window == 0,
+             "%s: utilization_window must be at least one cycle\n", name());
+    fatal_if(m_max_utilization <= 0 || m_max_utilization >= 1,
+             "%s: max_utilization must be between 0 and 1\n", name());
+
+    m_router_links.resize(p.routers.size());
+    m_router_latency.resize(p.routers.size());
+    for (BasicRouter *router : p.routers) {
+        auto id = static_cast<size_t>(router->params().router_id);
+        fatal_if(id >= p.routers.size(), "%s: router id %d out of range\n",
+                 name(), id);
+        m_router_latency[id] = router->params().latency;
+    }
+
+    m_node_link.resize(m_nodes, -1);
+    m_node_dest.resize(m_nodes);
+    m_paths.resize(m_nodes * m_nodes);
+    m_last_arrival.resize(m_nodes,
+                          std::vector<Tick>(m_virtual_networks, 0));
+}
+
+void
+AnalyticalNetwork::init()
+{
+    Network::init();
+
+    // The topology pointer should have already been initialized in
+    // the parent class network constructor.
+    assert(m_topology_ptr != NULL);
+    m_topology_ptr->createLinks(this);
+}
+
+// From a switch to an endpoint node
+void
+AnalyticalNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
+                                  BasicLink* link,
+                                  std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_dest = getLocalNodeID(global_dest);
+    assert(local_dest < m_nodes);
+
+    m_node_dest[local_dest] = routing_table_entry[0];
+    m_router_links[src].insert(m_router_links[src].begin(), m_links.size());
+    m_links.emplace_back(link->m_latency, link->m_bandwidth_factor, -1,
+                         routing_table_entry[0]);
+}
+
+// From an endpoint node to a switch
+void
+AnalyticalNetwork::makeExtInLink(NodeID global_src, SwitchID dest,
+                                 BasicLink* link,
+                                 std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_src = getLocalNodeID(global_src);
+    assert(local_src < m_nodes);
+
+    m_node_link[local_src] = m_links.size();
+    m_links.emplace_back(link->m_latency, link->m_bandwidth_factor, dest,
+                         routing_table_entry[0]);
+
+    for (MessageBuffer *buffer : m_toNetQueues[local_src]) {
+        if (buffer)
+            buffer->setConsumer(this);
+    }
+}
+
+// From a switch to a switch
+void
+AnalyticalNetwork::makeInternalLink(SwitchID src, SwitchID dest,
+                                    BasicLink* link,
+                                    std::vector<NetDest>& routing_table_entry,
+                                    PortDirection src_outport,
+                                    PortDirection dst_inport)
+{
+    m_router_links[src].push_back(m_links.size());
+    m_links.emplace_back(link->m_latency, link->m_bandwidth_factor, dest,
+                         routing_table_entry[0]);
+}
+
+const AnalyticalNetwork::Path &
+AnalyticalNetwork::getPath(NodeID src, NodeID dest)
+{
+    Path &path = m_paths[src * m_nodes + dest];
+    if (!path.empty())
+        return path;
+
+    // Follow the links the weight based routing of the topology picks,
+    // as the simple network does.
+    int link_id = m_node_link[src];
+    fatal_if(link_id < 0, "%s: node %d is not connected\n", name(), src);
+    path.push_back(link_id);
+    while (m_links[link_id].destRouter >= 0) {
+        int router = m_links[link_id].destRouter;
+        auto it = std::find_if(m_router_links[router].begin(),
+            m_router_links[router].end(), [&](int l) {
+                return m_links[l].reachable.intersectionIsNotEmpty(
+                    m_node_dest[dest]);
+            });
+        fatal_if(it == m_router_links[router].end() ||
+                 path.size() > m_router_links.size(),
+                 "%s: no route from node %d to node %d\n", name(), src,
+                 dest);
+        link_id = *it;
+        path.push_back(link_id);
+    }
+    return path;
+}
+
+double
+AnalyticalNetwork::useLink(Link &link, int bytes)
+{
+    Cycles now = curCycle();
+    if (now - link.windowStart >= m_utilization_window) {
+        double elapsed = now - link.windowStart;
+        link.utilization = std::min(link.busyCycles / elapsed,
+                                    m_max_utilization);
+        link.meanService = link.numMsgs ?
+            double(link.busyCycles) / link.numMsgs : 0;
+        link.windowStart = now;
+        link.busyCycles = 0;
+        link.numMsgs = 0;
+    }
+
+    link.busyCycles += divCeil(bytes, link.bandwidth);
+    link.numMsgs++;
+
+    // M/D/1 mean waiting time
+    double rho = link.utilization;
+    return rho * link.meanService / (2 * (1 - rho));
+}
+
+bool
+AnalyticalNetwork::sendMessage(NodeID src, MessageBuffer *buffer, int vnet)
+{
+    // temporary vector to store the destinations
+    static thread_local std::vector<NodeID> dests;
+
+    Tick current_time = clockEdge();
+    MsgPtr msg_ptr = buffer->peekMsgPtr();
+    const NetDest &msg_dest = msg_ptr->getDestination();
+
+    dests.clear();
+    for (NodeID node = 0; node < m_nodes; node++) {
+        if (!msg_dest.intersectionIsNotEmpty(m_node_dest[node]))
+            continue;
+        panic_if(vnet >= m_fromNetQueues[node].size() ||
+                 !m_fromNetQueues[node][vnet],
+                 "%s: node %d has no queue for vnet %d\n", name(), node,
+                 vnet);
+        MessageBuffer *out = m_fromNetQueues[node][vnet];
+        if (!out->areNSlotsAvailable(1, current_time)) {
+            DPRINTF(RubyNetwork, "Can't deliver message since node %d "
+                    "is blocked\n", node);
+            networkStats.stalls++;
+            return false;
+        }
+        dests.push_back(node);
+    }
+
+    int bytes = MessageSizeType_to_int(msg_ptr->getMessageSize());
+
+    // The enqueue changes the message, so each destination other than
+    // the first gets a private copy of the unmodified one.
+    MsgPtr unmodified_msg_ptr;
+    if (dests.size() > 1)
+        unmodified_msg_ptr = msg_ptr->clone();
+
+    buffer->dequeue(current_time);
+
+    for (int i = 0; i < dests.size(); i++) {
+        NodeID dest = dests[i];
+        if (i > 0)
+            msg_ptr = unmodified_msg_ptr->clone();
+        msg_ptr->getDestination() = m_node_dest[dest];
+
+        Cycles latency(0);
+        uint64_t serialization = 0;
+        double queueing = 0;
+        for (int link_id : getPath(src, dest)) {
+            Link &link = m_links[link_id];
+            latency += link.latency;
+            if (link.destRouter >= 0)
+                latency += m_router_latency[link.destRouter];
+            serialization = std::max<uint64_t>(serialization,
+                divCeil(bytes, link.bandwidth));
+            queueing += useLink(link, bytes);
+        }
+        Cycles queueing_cycles(std::lround(queueing));
+        latency += Cycles(serialization) + queueing_cycles;
+
+        Tick delta = cyclesToTicks(latency);
+        if (m_ordered[vnet]) {
+            Tick &last_arrival = m_last_arrival[dest][vnet];
+            if (last_arrival > current_time + delta)
+                delta = last_arrival - current_time;
+            last_arrival = current_time + delta;
+        }
+
+        DPRINTF(RubyNetwork, "Node %d to node %d, vnet %d: latency %d "
+                "cycles (queueing %d). Message: %s\n", src, dest, vnet,
+                latency, queueing_cycles, *msg_ptr);
+
+        m_fromNetQueues[dest][vnet]->enqueue(msg_ptr, current_time, delta);
+
+        networkStats.msgCount++;
+        networkStats.msgBytes += bytes;
+        networkStats.totalLatency += latency;
+        networkStats.queueingLatency += queueing_cycles;
+    }
+    return true;
+}
+
+void
+AnalyticalNetwork::wakeup()
+{
+    Tick current_time = clockEdge();
+    bool stalled = false;
+
+    for (NodeID node = 0; node < m_nodes; node++) {
+        for (int vnet = 0; vnet < m_toNetQueues[node].size(); vnet++) {
+            MessageBuffer *buffer = m_toNetQueues[node][vnet];
+            if (!buffer)
+                continue;
+            while (buffer->isReady(current_time)) {
+                if (!sendMessage(node, buffer, vnet)) {
+                    stalled = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Try again once the destinations had a chance to drain
+    if (stalled)
+        scheduleEvent(Cycles(1));
+}
+
+void
+AnalyticalNetwork::print(std::ostream& out) const
+{
+    out << "[AnalyticalNetwork]";
+}
+
+AnalyticalNetwork::NetworkStats::NetworkStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(msgCount, statistics::units::Count::get(),
+               "Number of messages delivered"),
+      ADD_STAT(msgBytes, statistics::units::Byte::get(),
+               "Number of bytes delivered"),
+      ADD_STAT(totalLatency, statistics::units::Cycle::get(),
+               "Total latency of the delivered messages"),
+      ADD_STAT(queueingLatency, statistics::units::Cycle::get(),
+               "Part of the total latency estimated as queueing"),
+      ADD_STAT(stalls, statistics::units::Count::get(),
+               "Number of times a message was held at its source because "
+               "a destination queue was full"),
+      ADD_STAT(avgLatency, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average latency of the delivered messages"),
+      ADD_STAT(avgQueueingLatency, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average estimated queueing latency of the delivered "
+               "messages")
+{
+    avgLatency = totalLatency / msgCount;
+    avgQueueingLatency = queueingLatency / msgCount;
+}
+
+} // namespace ruby
+} // namespace gem5
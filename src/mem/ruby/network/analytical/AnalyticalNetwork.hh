@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a Ruby network that computes the latency of each
+ * message analytically instead of simulating every hop.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
+#define __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
+
+#include <iostream>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/network/Network.hh"
+#include "params/AnalyticalNetwork.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+class MessageBuffer;
+
+/**
+ * A network that moves each message from its source to its destination
+ * queues in one step. The latency is the sum of the link and router
+ * latencies along the path chosen by the topology's weight based
+ * routing, plus the time to serialize the message on the narrowest link
+ * of the path, plus an M/D/1 estimate of the queueing at every link.
+ *
+ * A link transfers bandwidth_factor bytes per cycle. Its utilization is
+ * measured over windows of utilization_window cycles, and the waiting
+ * time a message sees at the link is rho * s / (2 * (1 - rho)), where
+ * rho is the utilization of the last window and s the mean service
+ * time in that window. rho is capped at max_utilization so that the
+ * estimate stays finite.
+ *
+ * Messages are kept in order on ordered virtual networks, and are held
+ * at the source when a destination queue is full.
+ */
+class AnalyticalNetwork : public Network, public Consumer
+{
+  public:
+    PARAMS(AnalyticalNetwork);
+
+    AnalyticalNetwork(const Params &p);
+    ~AnalyticalNetwork() = default;
+
+    void init() override;
+
+    void wakeup() override;
+
+    void collateStats() override {}
+    void print(std::ostream& out) const override;
+
+    // Methods used by Topology to setup the network
+    void makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
+                     std::vector<NetDest>& routing_table_entry) override;
+    void makeExtInLink(NodeID src, SwitchID dest, BasicLink* link,
+                    std::vector<NetDest>& routing_table_entry) override;
+    void makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
+                          std::vector<NetDest>& routing_table_entry,
+                          PortDirection src_outport,
+                          PortDirection dst_inport) override;
+
+    // Messages in flight are already in the destination queues, which
+    // are checked by their controllers.
+    bool functionalRead(Packet *pkt) override { return false; }
+    bool functionalRead(Packet *pkt, WriteMask &mask) override
+    { return false; }
+    uint32_t functionalWrite(Packet *pkt) override { return 0; }
+
+  private:
+    struct Link
+    {
+        Link(Cycles _latency, int _bandwidth, int _dest_router,
+             const NetDest &_reachable)
+            : latency(_latency), bandwidth(_bandwidth),
+              destRouter(_dest_router), reachable(_reachable)
+        {}
+
+        Cycles latency;
+        //! Bytes transferred per cycle
+        int bandwidth;
+        //! Router at the far end, or -1 for a link to a node
+        int destRouter;
+        //! Nodes whose shortest path goes through this link
+        NetDest reachable;
+
+        // Utilization of the last window
+        double utilization = 0;
+        double meanService = 0;
+
+        // Usage in the current window
+        Cycles windowStart = Cycles(0);
+        uint64_t busyCycles = 0;
+        uint64_t numMsgs = 0;
+    };
+
+    //! Links of a path, from the source node to the destination node
+    typedef std::vector<int> Path;
+
+    const Path &getPath(NodeID src, NodeID dest);
+
+    /**
+     * Account for a message of the given size crossing a link and
+     * return the estimated waiting time at the link, in cycles.
+     */
+    double useLink(Link &link, int bytes);
+
+    /** Try to send the oldest message of a queue of node src. */
+    bool sendMessage(NodeID src, MessageBuffer *buffer, int vnet);
+
+    const Cycles m_utilization_window;
+    const double m_max_utilization;
+
+    std::vector<Link> m_links;
+    //! Outgoing links of each router, links to nodes first
+    std::vector<std::vector<int>> m_router_links;
+    std::vector<Cycles> m_router_latency;
+    //! The link from each node into the network
+    std::vector<int> m_node_link;
+    //! The destination set that selects each node
+    std::vector<NetDest> m_node_dest;
+    //! Paths from each node to each node, filled in on first use
+    std::vector<Path> m_paths;
+    //! Latest arrival in each destination queue, for ordered vnets
+    std::vector<std::vector<Tick>> m_last_arrival;
+
+    struct NetworkStats : public statistics::Group
+    {
+        NetworkStats(statistics::Group *parent);
+
+        statistics::Scalar msgCount;
+        statistics::Scalar msgBytes;
+        statistics::Scalar totalLatency;
+        statistics::Scalar queueingLatency;
+        statistics::Scalar stalls;
+        statistics::Formula avgLatency;
+        statistics::Formula avgQueueingLatency;
+    } networkStats;
+};
+
+inline std::ostream&
+operator<<(std::ostream& out, const AnalyticalNetwork& obj)
+{
+    obj.print(out);
+    out << std::flush;
+    return out;
+}
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
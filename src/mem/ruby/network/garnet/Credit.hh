@@ -66,6 +66,19 @@ class Credit : public flit
 
     bool is_free_signal() { return m_is_free_signal; }
 
+    static void *
+    operator new(std::size_t size)
+    {
+        assert(size == sizeof(Credit));
+        return PoolAllocator<Credit>().allocate(1);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        PoolAllocator<Credit>().deallocate(static_cast<Credit *>(p), 1);
+    }
+
   private:
     bool m_is_free_signal;
 };
@@ -63,6 +63,7 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_num_buffered_flits++;
     }
 
     inline double get_crossbar_activity() { return m_crossbar_activity; }
@@ -75,6 +76,9 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     double m_crossbar_activity;
     std::vector<flitBuffer> switchBuffers;
+    // Number of flits in the switch buffers, wakeup() returns early when
+    // there are none
+    int m_num_buffered_flits;
 };
 
 } // namespace garnet
@@ -32,7 +32,9 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 #include "mem/ruby/network/Network.hh"
@@ -115,40 +117,68 @@ class GarnetNetwork : public Network
     void resetStats();
     void print(std::ostream& out) const;
 
-    // increment counters
-    void increment_injected_packets(int vnet) { m_packets_injected[vnet]++; }
-    void increment_received_packets(int vnet) { m_packets_received[vnet]++; }
+    // increment counters. The network interfaces may run on different
+    // event queues, so the network wide counters are updated under a lock.
+    void
+    increment_injected_packets(int vnet)
+    {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        m_packets_injected[vnet]++;
+    }
+
+    void
+    increment_received_packets(int vnet)
+    {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        m_packets_received[vnet]++;
+    }
 
     void
     increment_packet_network_latency(Tick latency, int vnet)
     {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
         m_packet_network_latency[vnet] += latency;
     }
 
     void
     increment_packet_queueing_latency(Tick latency, int vnet)
     {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
         m_packet_queueing_latency[vnet] += latency;
     }
 
-    void increment_injected_flits(int vnet) { m_flits_injected[vnet]++; }
-    void increment_received_flits(int vnet) { m_flits_received[vnet]++; }
+    void
+    increment_injected_flits(int vnet)
+    {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        m_flits_injected[vnet]++;
+    }
+
+    void
+    increment_received_flits(int vnet)
+    {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        m_flits_received[vnet]++;
+    }
 
     void
     increment_flit_network_latency(Tick latency, int vnet)
     {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
         m_flit_network_latency[vnet] += latency;
     }
 
     void
     increment_flit_queueing_latency(Tick latency, int vnet)
     {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
         m_flit_queueing_latency[vnet] += latency;
     }
 
     void
     increment_total_hops(int hops)
     {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
         m_total_hops += hops;
     }
 
@@ -210,7 +240,9 @@ class GarnetNetwork : public Network
     std::vector<NetworkLink *> m_networklinks; // All flit links in the network
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
-    int m_next_packet_id; // static vairable for packet id allocation
+    std::atomic<int> m_next_packet_id; // for packet id allocation
+
+    std::mutex m_stats_mutex;
 };
 
 inline std::ostream&
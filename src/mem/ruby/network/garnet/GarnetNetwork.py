@@ -51,6 +51,29 @@ class GarnetNetwork(RubyNetwork):
     garnet_deadlock_threshold = Param.UInt32(50000,
                               "network-level deadlock threshold")
 
+    def partition(self, num_queues):
+        """Spread the routers over num_queues event queues in contiguous
+        blocks of router ids, i.e. in bands of rows of a mesh. Each
+        network interface goes with the router it attaches to and each
+        link with the object that sends on it. Flits crossing between
+        queues use the link latency as lookahead, so every link must be
+        at least sim_quantum long. The controllers behind the network
+        interfaces are left to the caller."""
+        routers = sorted(self.routers, key=lambda r: r.router_id)
+        per_queue = (len(routers) + num_queues - 1) // num_queues
+        for i, router in enumerate(routers):
+            router.eventq_index = i // per_queue
+
+        for link in self.int_links:
+            link.network_link.eventq_index = link.src_node.eventq_index
+            link.credit_link.eventq_index = link.dst_node.eventq_index
+
+        for ni, link in zip(self.netifs, self.ext_links):
+            index = link.int_node.eventq_index
+            ni.eventq_index = index
+            for l in list(link.network_links) + list(link.credit_links):
+                l.eventq_index = index
+
 class GarnetNetworkInterface(ClockedObject):
     type = 'GarnetNetworkInterface'
     cxx_class = 'gem5::ruby::garnet::NetworkInterface'
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/garnet/GarnetPowerModel.hh"
+
+#include "base/logging.hh"
+#include "mem/ruby/network/garnet/NetworkLink.hh"
+#include "mem/ruby/network/garnet/Router.hh"
+#include "sim/clocked_object.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+GarnetPowerModel::GarnetPowerModel(const Params &p)
+    : PowerModelState(p),
+      bufferReadEnergy(p.buffer_read_energy),
+      bufferWriteEnergy(p.buffer_write_energy),
+      arbiterEnergy(p.arbiter_energy),
+      crossbarEnergy(p.crossbar_energy),
+      linkEnergy(p.link_energy),
+      staticPowerW(p.static_power),
+      lastReset(0),
+      ADD_STAT(dynamicEnergy, statistics::units::Joule::get(),
+               "Dynamic energy spent since the last stats reset")
+{
+    dynamicEnergy.method(this, &GarnetPowerModel::getDynamicEnergy);
+}
+
+double
+GarnetPowerModel::getDynamicEnergy() const
+{
+    panic_if(!clocked_object, "%s: not attached to an object\n", name());
+
+    if (auto *router = dynamic_cast<Router *>(clocked_object)) {
+        Router::Activity activity = router->getActivity();
+        return activity.bufferReads * bufferReadEnergy +
+            activity.bufferWrites * bufferWriteEnergy +
+            (activity.inputArbiter + activity.outputArbiter) *
+                arbiterEnergy +
+            activity.crossbar * crossbarEnergy;
+    }
+
+    if (auto *link = dynamic_cast<NetworkLink *>(clocked_object))
+        return link->getLinkUtilization() * linkEnergy;
+
+    panic("%s: only garnet routers and links are supported\n", name());
+}
+
+double
+GarnetPowerModel::getDynamicPower() const
+{
+    Tick elapsed = curTick() - lastReset;
+    if (elapsed == 0)
+        return 0;
+    return getDynamicEnergy() / (elapsed / sim_clock::as_float::s);
+}
+
+void
+GarnetPowerModel::resetStats()
+{
+    PowerModelState::resetStats();
+    lastReset = curTick();
+}
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
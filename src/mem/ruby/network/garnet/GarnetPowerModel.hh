@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_GARNETPOWERMODEL_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_GARNETPOWERMODEL_HH__
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "params/GarnetPowerModel.hh"
+#include "sim/power/power_model.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+/**
+ * Power model of a garnet router or link, driven by the activity
+ * counters garnet keeps anyway. Each buffer read and write, switch
+ * arbitration, crossbar traversal and link traversal costs a fixed
+ * energy, and the dynamic power is the energy spent since the last
+ * stats reset divided by the time elapsed since then. The energies
+ * should come from a tool such as DSENT for the technology of interest;
+ * the defaults are only indicative.
+ *
+ * The energy spent since the last reset is also reported as a stat, so
+ * the energy of each epoch is available by resetting the stats at
+ * every dump.
+ */
+class GarnetPowerModel : public PowerModelState
+{
+  public:
+    typedef GarnetPowerModelParams Params;
+    GarnetPowerModel(const Params &p);
+
+    double getDynamicPower() const override;
+    double getStaticPower() const override { return staticPowerW; }
+
+    void resetStats() override;
+
+  private:
+    /** Dynamic energy (in Joules) spent since the last stats reset. */
+    double getDynamicEnergy() const;
+
+    const double bufferReadEnergy;
+    const double bufferWriteEnergy;
+    const double arbiterEnergy;
+    const double crossbarEnergy;
+    const double linkEnergy;
+    const double staticPowerW;
+
+    Tick lastReset;
+
+    statistics::Value dynamicEnergy;
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_GARNETPOWERMODEL_HH__
@@ -0,0 +1,55 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+
+from m5.params import *
+from m5.objects.PowerModelState import PowerModelState
+
+# Power model of a garnet router or link based on the activity counters
+# of garnet, so that the power and energy of the network are available
+# while the simulation runs instead of from a separate DSENT run on the
+# stats. Use it as a power state model of the PowerModel of a
+# GarnetRouter or NetworkLink. The energies are per event, in Joules.
+# The defaults are only indicative and should be calibrated (e.g. with
+# DSENT) for the technology and configuration being studied.
+class GarnetPowerModel(PowerModelState):
+    type = 'GarnetPowerModel'
+    cxx_header = "mem/ruby/network/garnet/GarnetPowerModel.hh"
+    cxx_class = 'gem5::ruby::garnet::GarnetPowerModel'
+
+    buffer_read_energy = Param.Float(1.0e-12,
+        "Energy of a flit buffer read (J)")
+    buffer_write_energy = Param.Float(1.2e-12,
+        "Energy of a flit buffer write (J)")
+    arbiter_energy = Param.Float(0.1e-12,
+        "Energy of a switch allocator arbitration (J)")
+    crossbar_energy = Param.Float(1.5e-12,
+        "Energy of a flit crossing the crossbar (J)")
+    link_energy = Param.Float(2.0e-12,
+        "Energy of a flit traversing a link (J)")
+    static_power = Param.Float(0.0, "Static power of the object (W)")
@@ -67,14 +67,21 @@ class InputUnit : public Consumer
     set_vc_idle(int vc, Tick curTime)
     {
         virtualChannels[vc].set_idle(curTime);
+        assert(m_num_active_vcs > 0);
+        m_num_active_vcs--;
     }
 
     inline void
     set_vc_active(int vc, Tick curTime)
     {
         virtualChannels[vc].set_active(curTime);
+        m_num_active_vcs++;
     }
 
+    // Whether a packet is held in any of the VCs of this port. The switch
+    // allocator skips the ports where this is false.
+    inline bool has_active_vc() const { return m_num_active_vcs > 0; }
+
     inline void
     grant_outport(int vc, int outport)
     {
@@ -166,6 +173,7 @@ class InputUnit : public Consumer
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
+    int m_num_active_vcs;
 
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
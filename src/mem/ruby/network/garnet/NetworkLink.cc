@@ -32,9 +32,13 @@
 
 #include "mem/ruby/network/garnet/NetworkLink.hh"
 
+#include <algorithm>
+
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -77,6 +81,19 @@ NetworkLink::setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObj)
 {
     link_srcQueue = src_queue;
     src_object = srcClockObj;
+
+    // The source wakes the link up directly, so the two must share a
+    // queue. Only the link to consumer hop may cross event queues.
+    fatal_if(srcClockObj->eventQueue() != eventQueue(),
+             "%s: link must be on the event queue of its source %s\n",
+             name(), srcClockObj->name());
+}
+
+bool
+NetworkLink::isRemoteConsumer() const
+{
+    return inParallelMode && link_consumer != nullptr &&
+        link_consumer->getObject()->eventQueue() != curEventQueue();
 }
 
 void
@@ -98,8 +115,12 @@ NetworkLink::wakeup()
                 (mVnets.size() == 0));
         }
         t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        if (isRemoteConsumer()) {
+            sendRemote(t_flit);
+        } else {
+            linkBuffer.insert(t_flit);
+            link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        }
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
@@ -109,6 +130,44 @@ NetworkLink::wakeup()
     }
 }
 
+void
+NetworkLink::sendRemote(flit *t_flit)
+{
+    // The link latency is the lookahead between the two partitions.
+    Tick delta = clockEdge(m_latency) - curTick();
+    fatal_if(delta < simQuantum, "%s: latency %d between event queues is "
+             "less than sim_quantum (%d)\n", name(), delta, simQuantum);
+
+    {
+        std::lock_guard<std::mutex> lock(m_remote_mutex);
+        m_remote_flits.push_back(t_flit);
+    }
+
+    // The event reaches the consumer's queue at the next quantum
+    // boundary, which is at most simQuantum ticks away.
+    link_consumer->getObject()->eventQueue()->schedulePooled(
+        [this]{ deliverRemote(); }, "NetworkLink remote flit",
+        curTick() + simQuantum);
+}
+
+void
+NetworkLink::deliverRemote()
+{
+    flit *t_flit;
+    {
+        std::lock_guard<std::mutex> lock(m_remote_mutex);
+        assert(!m_remote_flits.empty());
+        t_flit = m_remote_flits.front();
+        m_remote_flits.pop_front();
+    }
+
+    // The flit keeps its arrival time. It may be late if the quantum
+    // is adaptive and grew past the link latency.
+    linkBuffer.insert(t_flit);
+    link_consumer->scheduleEventAbsolute(
+        std::max(t_flit->get_time(), clockEdge()));
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -122,7 +181,14 @@ NetworkLink::resetStats()
 uint32_t
 NetworkLink::functionalWrite(Packet *pkt)
 {
-    return linkBuffer.functionalWrite(pkt);
+    uint32_t num_functional_writes = linkBuffer.functionalWrite(pkt);
+
+    std::lock_guard<std::mutex> lock(m_remote_mutex);
+    for (flit *t_flit : m_remote_flits) {
+        if (t_flit->functionalWrite(pkt))
+            num_functional_writes++;
+    }
+    return num_functional_writes;
 }
 
 } // namespace garnet
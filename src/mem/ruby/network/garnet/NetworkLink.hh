@@ -33,7 +33,9 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_NETWORKLINK_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_NETWORKLINK_HH__
 
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
@@ -84,6 +86,9 @@ class NetworkLink : public ClockedObject, public Consumer
     uint32_t functionalWrite(Packet *);
     void resetStats();
 
+    //! True if the consumer runs on a queue other than the caller's.
+    bool isRemoteConsumer() const;
+
     std::vector<int> mVnets;
     uint32_t bitWidth;
 
@@ -94,6 +99,15 @@ class NetworkLink : public ClockedObject, public Consumer
 
     ClockedObject *src_object;
 
+    void sendRemote(flit *t_flit);
+    void deliverRemote();
+
+    //! Flits sent to a consumer on another event queue, in send order.
+    //! Each is handed over by an event on the consumer's queue which
+    //! moves the oldest pending flit into linkBuffer.
+    std::mutex m_remote_mutex;
+    std::deque<flit *> m_remote_flits;
+
     // Statistical variables
     unsigned int m_link_utilized;
     std::vector<unsigned int> m_vc_load;
@@ -234,6 +234,24 @@ Router::collateStats()
     m_crossbar_activity = crossbarSwitch.get_crossbar_activity();
 }
 
+Router::Activity
+Router::getActivity()
+{
+    Activity activity;
+    for (int j = 0; j < m_virtual_networks; j++) {
+        for (int i = 0; i < m_input_unit.size(); i++) {
+            activity.bufferReads += m_input_unit[i]->get_buf_read_activity(j);
+            activity.bufferWrites +=
+                m_input_unit[i]->get_buf_write_activity(j);
+        }
+    }
+
+    activity.inputArbiter = switchAllocator.get_input_arbiter_activity();
+    activity.outputArbiter = switchAllocator.get_output_arbiter_activity();
+    activity.crossbar = crossbarSwitch.get_crossbar_activity();
+    return activity;
+}
+
 void
 Router::resetStats()
 {
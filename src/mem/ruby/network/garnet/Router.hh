@@ -128,6 +128,18 @@ class Router : public BasicRouter, public Consumer
     void collateStats();
     void resetStats();
 
+    //! Activity of the router since the last stats reset
+    struct Activity
+    {
+        double bufferReads = 0;
+        double bufferWrites = 0;
+        double inputArbiter = 0;
+        double outputArbiter = 0;
+        double crossbar = 0;
+    };
+
+    Activity getActivity();
+
     // For Fault Model:
     bool get_fault_vector(int temperature, float fault_vector[]) {
         return m_network_ptr->fault_model->fault_vector(m_id, temperature,
@@ -93,20 +93,11 @@ RoutingUnit::supportsVnet(int vnet, std::vector<int> sVnets)
  * Routes can be biased via weight assignments in the topology file.
  * Correct weight assignments are critical to provide deadlock avoidance.
  */
-int
-RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+void
+RoutingUnit::routeCandidates(int vnet, const NetDest &msg_destination,
+                             std::vector<int> &candidates)
 {
-    // First find all possible output link candidates
-    // For ordered vnet, just choose the first
-    // (to make sure different packets don't choose different routes)
-    // For unordered vnet, randomly choose any of the links
-    // To have a strict ordering between links, they should be given
-    // different weights in the topology file
-
-    int output_link = -1;
     int min_weight = INFINITE_;
-    std::vector<int> output_link_candidates;
-    int num_candidates = 0;
 
     // Identify the minimum weight among the candidate output links
     for (int link = 0; link < m_routing_table[vnet].size(); link++) {
@@ -124,24 +115,70 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
             m_routing_table[vnet][link])) {
 
             if (m_weight_table[link] == min_weight) {
-                num_candidates++;
-                output_link_candidates.push_back(link);
+                candidates.push_back(link);
             }
         }
     }
 
-    if (output_link_candidates.size() == 0) {
+    if (candidates.size() == 0) {
         fatal("Fatal Error:: No Route exists from this Router.");
         exit(0);
     }
+}
+
+int
+RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+{
+    // First find all possible output link candidates
+    // For ordered vnet, just choose the first
+    // (to make sure different packets don't choose different routes)
+    // For unordered vnet, randomly choose any of the links
+    // To have a strict ordering between links, they should be given
+    // different weights in the topology file
+
+    std::vector<int> output_link_candidates;
+    routeCandidates(vnet, msg_destination, output_link_candidates);
 
     // Randomly select any candidate output link
     int candidate = 0;
     if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
-        candidate = rand() % num_candidates;
+        candidate = rand() % output_link_candidates.size();
 
-    output_link = output_link_candidates.at(candidate);
-    return output_link;
+    return output_link_candidates.at(candidate);
+}
+
+/*
+ * Packets have a single destination by the time they reach the routers,
+ * so the output link only depends on the vnet and the destination. It is
+ * computed once per destination and then looked up, unless there are
+ * several candidates to pick from randomly.
+ */
+int
+RoutingUnit::lookupRoute(const RouteInfo &route)
+{
+    const int num_nodes = MachineType_base_number(MachineType_NUM);
+    if (m_route_cache.empty()) {
+        m_route_cache.resize(m_routing_table.size() * num_nodes,
+                             UnknownRoute);
+    }
+
+    assert(route.dest_ni < num_nodes);
+    int &entry = m_route_cache[route.vnet * num_nodes + route.dest_ni];
+    if (entry >= 0)
+        return entry;
+    if (entry == MultipleRoutes)
+        return lookupRoutingTable(route.vnet, route.net_dest);
+
+    std::vector<int> candidates;
+    routeCandidates(route.vnet, route.net_dest, candidates);
+    if (candidates.size() > 1 &&
+        !m_router->get_net_ptr()->isVNetOrdered(route.vnet)) {
+        entry = MultipleRoutes;
+        return candidates.at(rand() % candidates.size());
+    }
+
+    entry = candidates.front();
+    return entry;
 }
 
 
@@ -176,7 +213,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
         // Multiple NIs may be connected to this router,
         // all with output port direction = "Local"
         // Get exact outport id from table
-        outport = lookupRoutingTable(route.vnet, route.net_dest);
+        outport = lookupRoute(route);
         return outport;
     }
 
@@ -187,14 +224,14 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 
     switch (routing_algorithm) {
         case TABLE_:  outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+            lookupRoute(route); break;
         case XY_:     outport =
             outportComputeXY(route, inport, inport_dirn); break;
         // any custom algorithm
         case CUSTOM_: outport =
             outportComputeCustom(route, inport, inport_dirn); break;
         default: outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+            lookupRoute(route); break;
     }
 
     assert(outport != -1);
@@ -220,6 +257,9 @@ RoutingUnit::outportComputeXY(RouteInfo route,
     int my_y = my_id / num_cols;
 
     int dest_id = route.dest_router;
+    if (dest_id < m_xy_route_cache.size() && m_xy_route_cache[dest_id] >= 0)
+        return m_xy_route_cache[dest_id];
+
     int dest_x = dest_id % num_cols;
     int dest_y = dest_id / num_cols;
 
@@ -257,7 +297,11 @@ RoutingUnit::outportComputeXY(RouteInfo route,
         panic("x_hops == y_hops == 0");
     }
 
-    return m_outports_dirn2idx[outport_dirn];
+    // The XY route only depends on the destination router
+    if (dest_id >= m_xy_route_cache.size())
+        m_xy_route_cache.resize(dest_id + 1, -1);
+    m_xy_route_cache[dest_id] = m_outports_dirn2idx[outport_dirn];
+    return m_xy_route_cache[dest_id];
 }
 
 // Template for implementing custom routing algorithm
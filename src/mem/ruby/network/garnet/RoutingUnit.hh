@@ -64,6 +64,10 @@ class RoutingUnit
     // get output port from routing table
     int  lookupRoutingTable(int vnet, NetDest net_dest);
 
+    // get output port from routing table for a single destination,
+    // caching the result when it is the only choice
+    int  lookupRoute(const RouteInfo &route);
+
     // Topology-specific direction based routing
     void addInDirection(PortDirection inport_dirn, int inport);
     void addOutDirection(PortDirection outport_dirn, int outport);
@@ -84,12 +88,26 @@ class RoutingUnit
 
 
   private:
+    // Output links with the minimum weight towards msg_destination
+    void routeCandidates(int vnet, const NetDest &msg_destination,
+                         std::vector<int> &candidates);
+
     Router *m_router;
 
     // Routing Table
     std::vector<std::vector<NetDest>> m_routing_table;
     std::vector<int> m_weight_table;
 
+    // Output link to each destination node, indexed by
+    // vnet * number of nodes + destination. Filled on the first packet
+    // to each destination.
+    static const int UnknownRoute = -1;
+    static const int MultipleRoutes = -2;
+    std::vector<int> m_route_cache;
+
+    // Output port of the XY routes, indexed by destination router
+    std::vector<int> m_xy_route_cache;
+
     // Inport and Outport direction to idx maps
     std::map<PortDirection, int> m_inports_dirn2idx;
     std::map<int, PortDirection> m_inports_idx2dirn;
@@ -55,6 +55,7 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+    m_num_port_requests = 0;
 }
 
 void
@@ -113,11 +114,15 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
+        auto input_unit = m_router->getInputUnit(inport);
+
+        // No flit can be waiting for SA without an active VC
+        if (!input_unit->has_active_vc())
+            continue;
+
         int invc = m_round_robin_invc[inport];
 
         for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
-
             if (input_unit->need_stage(invc, SA_, curTick())) {
                 // This flit is in SA stage
 
@@ -132,6 +137,7 @@ SwitchAllocator::arbitrate_inports()
                 if (make_request) {
                     m_input_arbiter_activity++;
                     m_port_requests[inport] = outport;
+                    m_num_port_requests++;
                     m_vc_winners[inport] = invc;
 
                     break; // got one vc winner for this port
@@ -165,6 +171,9 @@ SwitchAllocator::arbitrate_outports()
     // Now there are a set of input vc requests for output vcs.
     // Again do round robin arbitration on these requests
     // Independent arbiter at each output port
+    if (m_num_port_requests == 0)
+        return;
+
     for (int outport = 0; outport < m_num_outports; outport++) {
         int inport = m_round_robin_inport[outport];
 
@@ -363,8 +372,12 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
+        auto input_unit = m_router->getInputUnit(i);
+        if (!input_unit->has_active_vc())
+            continue;
+
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+            if (input_unit->need_stage(j, SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
@@ -386,7 +399,11 @@ SwitchAllocator::get_vnet(int invc)
 void
 SwitchAllocator::clear_request_vector()
 {
+    if (m_num_port_requests == 0)
+        return;
+
     std::fill(m_port_requests.begin(), m_port_requests.end(), -1);
+    m_num_port_requests = 0;
 }
 
 void
@@ -89,6 +89,8 @@ class SwitchAllocator : public Consumer
     std::vector<int> m_round_robin_invc;
     std::vector<int> m_round_robin_inport;
     std::vector<int> m_port_requests;
+    // Number of requests placed in m_port_requests by SA-I
+    int m_num_port_requests;
     std::vector<int> m_vc_winners;
 };
 
@@ -34,6 +34,7 @@
 #include <cassert>
 #include <iostream>
 
+#include "base/pool_allocator.hh"
 #include "base/types.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
@@ -112,6 +113,22 @@ class flit
     virtual flit* serialize(int ser_id, int parts, uint32_t bWidth);
     virtual flit* deserialize(int des_id, int num_flits, uint32_t bWidth);
 
+    // A flit is allocated for every flit of every packet and freed at
+    // ejection, so they are recycled instead of going through the heap.
+    // Derived classes must provide their own operators.
+    static void *
+    operator new(std::size_t size)
+    {
+        assert(size == sizeof(flit));
+        return PoolAllocator<flit>().allocate(1);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        PoolAllocator<flit>().deallocate(static_cast<flit *>(p), 1);
+    }
+
     uint32_t m_width;
     int msgSize;
   protected:
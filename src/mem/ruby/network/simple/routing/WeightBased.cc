@@ -69,6 +69,28 @@ WeightBased::addOutPort(LinkID link_id,
                         m_out_buffer,
                         0, link_weight});
     sortLinks();
+    m_dest_links_valid = false;
+}
+
+void
+WeightBased::buildDestLinks()
+{
+    m_dest_links.assign(MachineType_base_number(MachineType_NUM),
+                        NoLink);
+    for (MachineType type = MachineType_FIRST; type < MachineType_NUM;
+         ++type) {
+        for (NodeID num = 0; num < MachineType_base_count(type); num++) {
+            MachineID mach = {type, num};
+            for (auto &link : m_links) {
+                if (link->m_routing_entry.isElement(mach)) {
+                    m_dest_links[MachineType_base_number(type) + num] =
+                        link->m_link_id;
+                    break;
+                }
+            }
+        }
+    }
+    m_dest_links_valid = true;
 }
 
 void
@@ -77,6 +99,8 @@ WeightBased::route(const Message &msg,
                    bool deterministic,
                    std::vector<RouteInfo> &out_links)
 {
+    bool static_order = !params().adaptive_routing || deterministic;
+
     // Makes sure ordering was reset adaptive option was set
     if (params().adaptive_routing) {
         if (deterministic) {
@@ -101,15 +125,31 @@ WeightBased::route(const Message &msg,
         sortLinks();
     }
 
-    findRoute(msg, out_links);
+    if (static_order && !m_dest_links_valid)
+        buildDestLinks();
+
+    findRoute(msg, static_order, out_links);
 }
 
 void
-WeightBased::findRoute(const Message &msg,
+WeightBased::findRoute(const Message &msg, bool static_order,
                        std::vector<RouteInfo> &out_links) const
 {
-    NetDest msg_dsts = msg.getDestination();
     assert(out_links.size() == 0);
+
+    // Most messages have a single destination, whose link is known
+    // without matching the destination against every link.
+    if (static_order && msg.getDestination().count() == 1) {
+        MachineID dest = msg.getDestination().smallestElement();
+        LinkID link_id =
+            m_dest_links[MachineType_base_number(dest.type) + dest.num];
+        if (link_id != NoLink) {
+            out_links.emplace_back(msg.getDestination(), link_id);
+            return;
+        }
+    }
+
+    NetDest msg_dsts = msg.getDestination();
     for (auto &link : m_links) {
         const NetDest &dst = link->m_routing_entry;
         if (msg_dsts.intersectionIsNotEmpty(dst)) {
@@ -41,6 +41,9 @@
 #ifndef __MEM_RUBY_NETWORK_SIMPLE_WEIGHTBASEDROUTINGUNIT_HH__
 #define __MEM_RUBY_NETWORK_SIMPLE_WEIGHTBASEDROUTINGUNIT_HH__
 
+#include <limits>
+#include <vector>
+
 #include "mem/ruby/network/simple/routing/BaseRoutingUnit.hh"
 #include "params/WeightBased.hh"
 
@@ -80,7 +83,16 @@ class WeightBased : public BaseRoutingUnit
 
     std::vector<std::unique_ptr<LinkInfo>> m_links;
 
-    void findRoute(const Message &msg,
+    // Link taken by a message to a single destination, indexed by
+    // MachineType_base_number(type) + num. It reflects the weight order
+    // of the links, so it is only valid while the order is not adaptive.
+    std::vector<LinkID> m_dest_links;
+    static constexpr LinkID NoLink = std::numeric_limits<LinkID>::max();
+    bool m_dest_links_valid = false;
+
+    void buildDestLinks();
+
+    void findRoute(const Message &msg, bool static_order,
                    std::vector<RouteInfo> &out_links) const;
 
     void sortLinks() {
@@ -152,6 +152,18 @@ class AbstractController : public ClockedObject, public Consumer
                                  const bool& was_miss)
     { }
 
+    //! These functions expose the state of the cache to a classic
+    //! prefetcher attached through a RubyPrefetcherProxy. Protocols that
+    //! support such prefetchers must override them.
+    virtual bool inCache(const Addr &addr, const bool &is_secure)
+    { fatal("inCache() not implemented!"); }
+    virtual bool hasBeenPrefetched(const Addr &addr, const bool &is_secure)
+    { fatal("hasBeenPrefetched() not implemented!"); }
+    virtual bool inMissQueue(const Addr &addr, const bool &is_secure)
+    { fatal("inMissQueue() not implemented!"); }
+    virtual bool coalesce()
+    { return false; }
+
     //! Function for collating statistics from all the controllers of this
     //! particular type. This function should only be called from the
     //! version 0 of this controller type.
@@ -358,8 +370,13 @@ class AbstractController : public ClockedObject, public Consumer
 
     unsigned int m_in_ports;
     unsigned int m_cur_in_port;
+
+    // One bit per in-port message buffer, set while the buffer holds
+    // messages. wakeup() skips the in-ports whose bit is clear.
+    uint64_t m_ready_buffers = 0;
     const int m_number_of_TBEs;
     const int m_transitions_per_cycle;
+    const bool m_profile_transitions;
     const unsigned int m_buffer_size;
     Cycles m_recycle_latency;
     const Cycles m_mandatory_queue_latency;
@@ -429,6 +446,10 @@ class AbstractController : public ClockedObject, public Consumer
         std::vector<statistics::Histogram*> outTransLatHist;
         std::vector<statistics::Scalar*> outTransLatHistRetries;
 
+        // Initialized by the SLICC compiler for all transitions when
+        // profile_transitions is set, indexed by state and event.
+        std::vector<statistics::Scalar*> transHostTime;
+
         //! Counter for the number of cycles when the transitions carried out
         //! were equal to the maximum allowed
         statistics::Scalar fullyBusyCycles;
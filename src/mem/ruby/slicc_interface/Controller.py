@@ -54,6 +54,8 @@ class RubyController(ClockedObject):
     transitions_per_cycle = \
         Param.Int(32, "no. of  SLICC state machine transitions per cycle")
     buffer_size = Param.UInt32(0, "max buffer size 0 means infinite")
+    profile_transitions = Param.Bool(False, "Record the host time spent "
+                                     "in each state machine transition")
 
     recycle_latency = Param.Cycles(10, "")
     number_of_TBEs = Param.Int(256, "")
@@ -44,7 +44,9 @@
 #include <iostream>
 #include <memory>
 #include <stack>
+#include <utility>
 
+#include "base/pool_allocator.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -132,6 +134,20 @@ class Message
     int vnet;
 };
 
+/**
+ * Create a message of type MSG with the arguments of any of its
+ * constructors. The message and its reference count share one allocation,
+ * which is recycled through a per-thread free list, so this should be
+ * preferred to std::make_shared() for messages created on every access.
+ */
+template <class MSG, typename... Args>
+inline std::shared_ptr<MSG>
+createMessage(Args&&... args)
+{
+    return std::allocate_shared<MSG>(PoolAllocator<MSG>(),
+                                     std::forward<Args>(args)...);
+}
+
 inline bool
 operator>(const MsgPtr &lhs, const MsgPtr &rhs)
 {
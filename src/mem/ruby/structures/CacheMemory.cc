@@ -41,6 +41,8 @@
 
 #include "mem/ruby/structures/CacheMemory.hh"
 
+#include <algorithm>
+
 #include "base/compiler.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
@@ -82,6 +84,10 @@ CacheMemory::CacheMemory(const Params &p)
     m_is_instruction_only_cache = p.is_icache;
     m_resource_stalls = p.resourceStalls;
     m_block_size = p.block_size;  // may be 0 at this point. Updated in init()
+    m_htmReadSetSize = 0;
+    m_htmWriteSetSize = 0;
+    m_htmMaxReadSet = p.htm_max_read_set;
+    m_htmMaxWriteSet = p.htm_max_write_set;
     m_use_occupancy = dynamic_cast<replacement_policy::WeightedLRU*>(
                                     m_replacementPolicy_ptr) ? true : false;
 }
@@ -97,16 +103,13 @@ CacheMemory::init()
     m_cache_num_set_bits = floorLog2(m_cache_num_sets);
     assert(m_cache_num_set_bits > 0);
 
-    m_cache.resize(m_cache_num_sets,
-                    std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
-    replacement_data.resize(m_cache_num_sets,
-                               std::vector<ReplData>(m_cache_assoc, nullptr));
+    const int num_blocks = getNumBlocks();
+    m_cache.resize(num_blocks, nullptr);
+    m_tags.resize(num_blocks, MaxAddr);
+    replacement_data.resize(num_blocks, nullptr);
     // instantiate all the replacement_data here
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for ( int j = 0; j < m_cache_assoc; j++) {
-            replacement_data[i][j] =
-                                m_replacementPolicy_ptr->instantiateEntry();
-        }
+    for (auto &repl_data : replacement_data) {
+        repl_data = m_replacementPolicy_ptr->instantiateEntry();
     }
 }
 
@@ -114,10 +117,8 @@ CacheMemory::~CacheMemory()
 {
     if (m_replacementPolicy_ptr)
         delete m_replacementPolicy_ptr;
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
-            delete m_cache[i][j];
-        }
+    for (auto entry : m_cache) {
+        delete entry;
     }
 }
 
@@ -135,14 +136,11 @@ CacheMemory::addressToCacheSet(Addr address) const
 int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
-    assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
-    return -1; // Not found
+    int loc = findTagInSetIgnorePermissions(cacheSet, tag);
+    if (loc != -1 && m_cache[blockIndex(cacheSet, loc)]->m_Permission ==
+        AccessPermission_NotPresent)
+        return -1;
+    return loc;
 }
 
 // Given a cache index: returns the index of the tag in a set.
@@ -153,9 +151,11 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
+    const Addr *tags = &m_tags[blockIndex(cacheSet, 0)];
+    for (int i = 0; i < m_cache_assoc; i++) {
+        if (tags[i] == tag)
+            return i;
+    }
     return -1; // Not found
 }
 
@@ -173,7 +173,7 @@ CacheMemory::getAddressAtIdx(int idx) const
     int way = idx - set * m_cache_assoc;
     assert (way < m_cache_assoc);
 
-    AbstractCacheEntry* entry = m_cache[set][way];
+    AbstractCacheEntry* entry = m_cache[blockIndex(set, way)];
     if (entry == NULL ||
         entry->m_Permission == AccessPermission_Invalid ||
         entry->m_Permission == AccessPermission_NotPresent) {
@@ -251,7 +251,7 @@ CacheMemory::cacheAvail(Addr address) const
     int64_t cacheSet = addressToCacheSet(address);
 
     for (int i = 0; i < m_cache_assoc; i++) {
-        AbstractCacheEntry* entry = m_cache[cacheSet][i];
+        AbstractCacheEntry* entry = m_cache[blockIndex(cacheSet, i)];
         if (entry != NULL) {
             if (entry->m_Address == address ||
                 entry->m_Permission == AccessPermission_NotPresent) {
@@ -275,7 +275,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
 
     // Find the first open slot
     int64_t cacheSet = addressToCacheSet(address);
-    std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
+    AbstractCacheEntry **set = &m_cache[blockIndex(cacheSet, 0)];
     for (int i = 0; i < m_cache_assoc; i++) {
         if (!set[i] || set[i]->m_Permission == AccessPermission_NotPresent) {
             if (set[i] && (set[i] != entry)) {
@@ -291,9 +291,10 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            m_tags[blockIndex(cacheSet, i)] = address;
             set[i]->setPosition(cacheSet, i);
-            set[i]->replacementData = replacement_data[cacheSet][i];
+            set[i]->replacementData =
+                replacement_data[blockIndex(cacheSet, i)];
             set[i]->setLastAccess(curTick());
 
             // Call reset function here to set initial value for different
@@ -312,12 +313,14 @@ CacheMemory::deallocate(Addr address)
     DPRINTF(RubyCache, "address: %#x\n", address);
     AbstractCacheEntry* entry = lookup(address);
     assert(entry != nullptr);
+    if (entry->getInHtmReadSet() || entry->getInHtmWriteSet())
+        htmRemoveFromSet(entry);
     m_replacementPolicy_ptr->invalidate(entry->replacementData);
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
     delete entry;
-    m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    m_cache[blockIndex(cache_set, way)] = NULL;
+    m_tags[blockIndex(cache_set, way)] = MaxAddr;
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -331,10 +334,10 @@ CacheMemory::cacheProbe(Addr address) const
     std::vector<ReplaceableEntry*> candidates;
     for (int i = 0; i < m_cache_assoc; i++) {
         candidates.push_back(static_cast<ReplaceableEntry*>(
-                                                       m_cache[cacheSet][i]));
+                                           m_cache[blockIndex(cacheSet, i)]));
     }
-    return m_cache[cacheSet][m_replacementPolicy_ptr->
-                        getVictim(candidates)->getWay()]->m_Address;
+    return m_cache[blockIndex(cacheSet, m_replacementPolicy_ptr->
+                   getVictim(candidates)->getWay())]->m_Address;
 }
 
 // looks an address up in the cache
@@ -345,7 +348,7 @@ CacheMemory::lookup(Addr address)
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return m_cache[blockIndex(cacheSet, loc)];
 }
 
 // looks an address up in the cache
@@ -356,7 +359,7 @@ CacheMemory::lookup(Addr address) const
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return m_cache[blockIndex(cacheSet, loc)];
 }
 
 // Sets the most recently used bit for a cache block
@@ -403,8 +406,9 @@ CacheMemory::getReplacementWeight(int64_t set, int64_t loc)
     assert(set < m_cache_num_sets);
     assert(loc < m_cache_assoc);
     int ret = 0;
-    if (m_cache[set][loc] != NULL) {
-        ret = m_cache[set][loc]->getNumValidBlocks();
+    AbstractCacheEntry* entry = m_cache[blockIndex(set, loc)];
+    if (entry != NULL) {
+        ret = entry->getNumValidBlocks();
         assert(ret >= 0);
     }
 
@@ -418,29 +422,27 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
     [[maybe_unused]] uint64_t totalBlocks = (uint64_t)m_cache_num_sets *
                                          (uint64_t)m_cache_assoc;
 
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
-                AccessPermission perm = m_cache[i][j]->m_Permission;
-                RubyRequestType request_type = RubyRequestType_NULL;
-                if (perm == AccessPermission_Read_Only) {
-                    if (m_is_instruction_only_cache) {
-                        request_type = RubyRequestType_IFETCH;
-                    } else {
-                        request_type = RubyRequestType_LD;
-                    }
-                } else if (perm == AccessPermission_Read_Write) {
-                    request_type = RubyRequestType_ST;
+    for (AbstractCacheEntry *entry : m_cache) {
+        if (entry != NULL) {
+            AccessPermission perm = entry->m_Permission;
+            RubyRequestType request_type = RubyRequestType_NULL;
+            if (perm == AccessPermission_Read_Only) {
+                if (m_is_instruction_only_cache) {
+                    request_type = RubyRequestType_IFETCH;
+                } else {
+                    request_type = RubyRequestType_LD;
                 }
+            } else if (perm == AccessPermission_Read_Write) {
+                request_type = RubyRequestType_ST;
+            }
 
-                if (request_type != RubyRequestType_NULL) {
-                    Tick lastAccessTick;
-                    lastAccessTick = m_cache[i][j]->getLastAccess();
-                    tr->addRecord(cntrl, m_cache[i][j]->m_Address,
-                                  0, request_type, lastAccessTick,
-                                  m_cache[i][j]->getDataBlk());
-                    warmedUpBlocks++;
-                }
+            if (request_type != RubyRequestType_NULL) {
+                Tick lastAccessTick;
+                lastAccessTick = entry->getLastAccess();
+                tr->addRecord(cntrl, entry->m_Address,
+                              0, request_type, lastAccessTick,
+                              entry->getDataBlk());
+                warmedUpBlocks++;
             }
         }
     }
@@ -456,10 +458,11 @@ CacheMemory::print(std::ostream& out) const
     out << "Cache dump: " << name() << std::endl;
     for (int i = 0; i < m_cache_num_sets; i++) {
         for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
+            const AbstractCacheEntry *entry = m_cache[blockIndex(i, j)];
+            if (entry != NULL) {
                 out << "  Index: " << i
                     << " way: " << j
-                    << " entry: " << *m_cache[i][j] << std::endl;
+                    << " entry: " << *entry << std::endl;
             } else {
                 out << "  Index: " << i
                     << " way: " << j
@@ -497,15 +500,11 @@ void
 CacheMemory::clearLockedAll(int context)
 {
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i) {
-        std::vector<AbstractCacheEntry*> set = *i;
-        for (auto j = set.begin(); j != set.end(); ++j) {
-            AbstractCacheEntry *line = *j;
-            if (line && line->isLocked(context)) {
-                DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
-                    line->m_Address);
-                line->clearLocked();
-            }
+    for (AbstractCacheEntry *line : m_cache) {
+        if (line && line->isLocked(context)) {
+            DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
+                line->m_Address);
+            line->clearLocked();
         }
     }
 }
@@ -536,6 +535,8 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
       ADD_STAT(htmTransAbortReadSet, "Read set size of a aborted transaction"),
       ADD_STAT(htmTransAbortWriteSet, "Write set size of a aborted "
                                       "transaction"),
+      ADD_STAT(htmSetOverflows, "Number of transactions failed by going "
+                                "over the modelled read/write set size"),
       ADD_STAT(m_demand_hits, "Number of cache demand hits"),
       ADD_STAT(m_demand_misses, "Number of cache demand misses"),
       ADD_STAT(m_demand_accesses, "Number of cache demand accesses",
@@ -584,6 +585,9 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
         .flags(statistics::pdf | statistics::dist | statistics::nozero |
             statistics::nonan);
 
+    htmSetOverflows
+        .flags(statistics::nozero);
+
     m_prefetch_hits
         .flags(statistics::nozero);
 
@@ -672,13 +676,15 @@ CacheMemory::checkResourceAvailable(CacheResourceType res, Addr addr)
 bool
 CacheMemory::isBlockInvalid(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission == AccessPermission_Invalid);
+  return (m_cache[blockIndex(cache_set, loc)]->m_Permission ==
+          AccessPermission_Invalid);
 }
 
 bool
 CacheMemory::isBlockNotBusy(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission != AccessPermission_Busy);
+  return (m_cache[blockIndex(cache_set, loc)]->m_Permission !=
+          AccessPermission_Busy);
 }
 
 /* hardware transactional memory */
@@ -686,30 +692,19 @@ CacheMemory::isBlockNotBusy(int64_t cache_set, int64_t loc)
 void
 CacheMemory::htmAbortTransaction()
 {
-    uint64_t htmReadSetSize = 0;
-    uint64_t htmWriteSetSize = 0;
+    uint64_t htmReadSetSize = m_htmReadSetSize;
+    uint64_t htmWriteSetSize = m_htmWriteSetSize;
 
-    // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                if (line->getInHtmWriteSet()) {
-                    line->invalidateEntry();
-                }
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-            }
+    for (AbstractCacheEntry *line : m_htmSet) {
+        if (line->getInHtmWriteSet()) {
+            line->invalidateEntry();
         }
+        line->setInHtmWriteSet(false);
+        line->setInHtmReadSet(false);
     }
+    m_htmSet.clear();
+    m_htmReadSetSize = 0;
+    m_htmWriteSetSize = 0;
 
     cacheMemoryStats.htmTransAbortReadSet.sample(htmReadSetSize);
     cacheMemoryStats.htmTransAbortWriteSet.sample(htmWriteSetSize);
@@ -720,26 +715,16 @@ CacheMemory::htmAbortTransaction()
 void
 CacheMemory::htmCommitTransaction()
 {
-    uint64_t htmReadSetSize = 0;
-    uint64_t htmWriteSetSize = 0;
+    uint64_t htmReadSetSize = m_htmReadSetSize;
+    uint64_t htmWriteSetSize = m_htmWriteSetSize;
 
-    // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-             }
-        }
+    for (AbstractCacheEntry *line : m_htmSet) {
+        line->setInHtmWriteSet(false);
+        line->setInHtmReadSet(false);
     }
+    m_htmSet.clear();
+    m_htmReadSetSize = 0;
+    m_htmWriteSetSize = 0;
 
     cacheMemoryStats.htmTransCommitReadSet.sample(htmReadSetSize);
     cacheMemoryStats.htmTransCommitWriteSet.sample(htmWriteSetSize);
@@ -747,6 +732,59 @@ CacheMemory::htmCommitTransaction()
         htmReadSetSize, htmWriteSetSize);
 }
 
+bool
+CacheMemory::htmAddToReadSet(Addr address)
+{
+    AbstractCacheEntry *entry = lookup(address);
+    assert(entry != nullptr);
+    if (entry->getInHtmReadSet())
+        return true;
+
+    if (!entry->getInHtmWriteSet())
+        m_htmSet.push_back(entry);
+    entry->setInHtmReadSet(true);
+    m_htmReadSetSize++;
+
+    if (m_htmMaxReadSet && m_htmReadSetSize > m_htmMaxReadSet) {
+        cacheMemoryStats.htmSetOverflows++;
+        return false;
+    }
+    return true;
+}
+
+bool
+CacheMemory::htmAddToWriteSet(Addr address)
+{
+    AbstractCacheEntry *entry = lookup(address);
+    assert(entry != nullptr);
+    if (entry->getInHtmWriteSet())
+        return true;
+
+    if (!entry->getInHtmReadSet())
+        m_htmSet.push_back(entry);
+    entry->setInHtmWriteSet(true);
+    m_htmWriteSetSize++;
+
+    if (m_htmMaxWriteSet && m_htmWriteSetSize > m_htmMaxWriteSet) {
+        cacheMemoryStats.htmSetOverflows++;
+        return false;
+    }
+    return true;
+}
+
+void
+CacheMemory::htmRemoveFromSet(AbstractCacheEntry *entry)
+{
+    auto it = std::find(m_htmSet.begin(), m_htmSet.end(), entry);
+    assert(it != m_htmSet.end());
+    *it = m_htmSet.back();
+    m_htmSet.pop_back();
+    if (entry->getInHtmReadSet())
+        m_htmReadSetSize--;
+    if (entry->getInHtmWriteSet())
+        m_htmWriteSetSize--;
+}
+
 void
 CacheMemory::profileDemandHit()
 {
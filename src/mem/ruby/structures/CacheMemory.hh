@@ -43,7 +43,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -153,6 +152,14 @@ class CacheMemory : public SimObject
     void htmAbortTransaction();
     void htmCommitTransaction();
 
+    /**
+     * Add the line to the transactional read (write) set. Returns false
+     * if the set grows past the modelled capacity, in which case the
+     * transaction is expected to fail.
+     */
+    bool htmAddToReadSet(Addr address);
+    bool htmAddToWriteSet(Addr address);
+
   public:
     int getCacheSize() const { return m_cache_size; }
     int getCacheAssoc() const { return m_cache_assoc; }
@@ -168,6 +175,13 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // Position of the block at (set, way) in the per-block arrays
+    int64_t
+    blockIndex(int64_t set, int way) const
+    {
+        return set * m_cache_assoc + way;
+    }
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -176,10 +190,12 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Blocks are stored set by set, the ways of a set being contiguous,
+    // see blockIndex(). Every block keeps its tag next to the other tags
+    // of its set, so that a lookup only scans the ways of one set.
+    // Unused blocks have a null entry and a MaxAddr tag.
+    std::vector<AbstractCacheEntry*> m_cache;
+    std::vector<Addr> m_tags;
 
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
@@ -196,14 +212,25 @@ class CacheMemory : public SimObject
     int m_block_size;
 
     /**
-     * We store all the ReplacementData in a 2-dimensional array. By doing
+     * Lines in the transactional read or write set, so that commits and
+     * aborts do not have to walk the whole cache.
+     */
+    std::vector<AbstractCacheEntry *> m_htmSet;
+    int m_htmReadSetSize;
+    int m_htmWriteSetSize;
+    int m_htmMaxReadSet;
+    int m_htmMaxWriteSet;
+    void htmRemoveFromSet(AbstractCacheEntry *entry);
+
+    /**
+     * We store all the ReplacementData in a per-block array. By doing
      * this, we can use all replacement policies from Classic system. Ruby
      * cache will deallocate cache entry every time we evict the cache block
      * so we cannot store the ReplacementData inside the cache entry.
      * Instantiate ReplacementData for multiple times will break replacement
      * policy like TreePLRU.
      */
-    std::vector<std::vector<ReplData> > replacement_data;
+    std::vector<ReplData> replacement_data;
 
     /**
      * Set to true when using WeightedLRU replacement policy, otherwise, set to
@@ -229,6 +256,7 @@ class CacheMemory : public SimObject
           statistics::Histogram htmTransCommitWriteSet;
           statistics::Histogram htmTransAbortReadSet;
           statistics::Histogram htmTransAbortWriteSet;
+          statistics::Scalar htmSetOverflows;
 
           statistics::Scalar m_demand_hits;
           statistics::Scalar m_demand_misses;
@@ -70,20 +70,30 @@ void
 DirectoryMemory::init()
 {
     m_num_entries = m_size_bytes / RubySystem::getBlockSizeBytes();
-    m_entries = new AbstractCacheEntry*[m_num_entries];
-    for (int i = 0; i < m_num_entries; i++)
-        m_entries[i] = NULL;
+    m_chunks.resize(divCeil(m_num_entries, ChunkEntries));
 }
 
 DirectoryMemory::~DirectoryMemory()
 {
     // free up all the directory entries
-    for (uint64_t i = 0; i < m_num_entries; i++) {
-        if (m_entries[i] != NULL) {
-            delete m_entries[i];
-        }
+    for (auto &chunk : m_chunks) {
+        if (!chunk)
+            continue;
+        for (AbstractCacheEntry *entry : *chunk)
+            delete entry;
+    }
+}
+
+AbstractCacheEntry *&
+DirectoryMemory::entrySlot(uint64_t idx)
+{
+    assert(idx < m_num_entries);
+    auto &chunk = m_chunks[idx >> ChunkBits];
+    if (!chunk) {
+        // value-initialized, so all the entries start out as NULL
+        chunk = std::make_unique<Chunk>();
     }
-    delete [] m_entries;
+    return (*chunk)[idx & (ChunkEntries - 1)];
 }
 
 bool
@@ -119,7 +129,8 @@ DirectoryMemory::lookup(Addr address)
 
     uint64_t idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    return m_entries[idx];
+    const auto &chunk = m_chunks[idx >> ChunkBits];
+    return chunk ? (*chunk)[idx & (ChunkEntries - 1)] : NULL;
 }
 
 AbstractCacheEntry*
@@ -130,10 +141,10 @@ DirectoryMemory::allocate(Addr address, AbstractCacheEntry *entry)
     DPRINTF(RubyCache, "Looking up address: %#x\n", address);
 
     idx = mapAddressToLocalIdx(address);
-    assert(idx < m_num_entries);
-    assert(m_entries[idx] == NULL);
+    AbstractCacheEntry *&slot = entrySlot(idx);
+    assert(slot == NULL);
     entry->changePermission(AccessPermission_Read_Only);
-    m_entries[idx] = entry;
+    slot = entry;
 
     return entry;
 }
@@ -146,10 +157,10 @@ DirectoryMemory::deallocate(Addr address)
     DPRINTF(RubyCache, "Removing entry for address: %#x\n", address);
 
     idx = mapAddressToLocalIdx(address);
-    assert(idx < m_num_entries);
-    assert(m_entries[idx] != NULL);
-    delete m_entries[idx];
-    m_entries[idx] = NULL;
+    AbstractCacheEntry *&slot = entrySlot(idx);
+    assert(slot != NULL);
+    delete slot;
+    slot = NULL;
 }
 
 void
@@ -41,8 +41,11 @@
 #ifndef __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 
+#include <array>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "mem/ruby/common/Address.hh"
@@ -97,8 +100,21 @@ class DirectoryMemory : public SimObject
     DirectoryMemory& operator=(const DirectoryMemory& obj);
 
   private:
+    /**
+     * The entries are kept in fixed size chunks that are only allocated
+     * once a block in them is touched, so that the host memory used
+     * follows the footprint of the workload rather than the size of the
+     * simulated memory.
+     */
+    static constexpr unsigned ChunkBits = 12;
+    static constexpr uint64_t ChunkEntries = 1ULL << ChunkBits;
+    typedef std::array<AbstractCacheEntry *, ChunkEntries> Chunk;
+
+    /** Get the slot of the entry at idx, allocating its chunk if needed */
+    AbstractCacheEntry *&entrySlot(uint64_t idx);
+
     const std::string m_name;
-    AbstractCacheEntry **m_entries;
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
     // int m_size;  // # of memory module blocks this directory is
                     // responsible for
     uint64_t m_size_bytes;
@@ -46,4 +46,8 @@ class RubyCache(SimObject):
     dataAccessLatency = Param.Cycles(1, "cycles for a data array access")
     tagAccessLatency = Param.Cycles(1, "cycles for a tag array access")
     resourceStalls = Param.Bool(False, "stall if there is a resource failure")
+    htm_max_read_set = Param.Int(0, "Lines a transaction can read before "
+        "failing, 0 is only bounded by the cache")
+    htm_max_write_set = Param.Int(0, "Lines a transaction can write before "
+        "failing, 0 is only bounded by the cache")
     ruby_system = Param.RubySystem(Parent.any, "")
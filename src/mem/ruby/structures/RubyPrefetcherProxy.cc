@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/structures/RubyPrefetcherProxy.hh"
+
+#include <algorithm>
+#include <memory>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/HWPrefetch.hh"
+#include "mem/ruby/slicc_interface/RubyRequest.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+RubyPrefetcherProxy::RubyPrefetcherProxy(AbstractController *parent,
+                                         prefetch::Base *_prefetcher,
+                                         MessageBuffer *pf_queue)
+    : Named(parent->name() + ".prefetcherProxy"),
+      cacheCntrl(parent), prefetcher(_prefetcher), pfQueue(pf_queue),
+      issuePfEvent([this]{ issuePrefetch(); }, name())
+{
+    if (!prefetcher)
+        return;
+
+    fatal_if(!pfQueue, "%s: a prefetch queue is required to attach a "
+             "prefetcher\n", parent->name());
+
+    // The controller calls the notify functions directly, so the
+    // prefetcher does not listen to any of its probes
+    prefetcher->setParentInfo(nullptr, this,
+                              RubySystem::getBlockSizeBytes());
+}
+
+void
+RubyPrefetcherProxy::deschedulePrefetch()
+{
+    if (issuePfEvent.scheduled())
+        cacheCntrl->deschedule(issuePfEvent);
+}
+
+void
+RubyPrefetcherProxy::scheduleNextPrefetch()
+{
+    if (issuePfEvent.scheduled())
+        return;
+
+    Tick next_pf_time = prefetcher->nextPrefetchReadyTime();
+    if (next_pf_time != MaxTick) {
+        cacheCntrl->schedule(issuePfEvent,
+                             std::max(next_pf_time, cacheCntrl->clockEdge()));
+    }
+}
+
+void
+RubyPrefetcherProxy::issuePrefetch()
+{
+    assert(prefetcher);
+
+    if (!pfQueue->areNSlotsAvailable(1, curTick())) {
+        // Try again once the controller has drained the queue
+        cacheCntrl->schedule(issuePfEvent,
+                             cacheCntrl->clockEdge(Cycles(1)));
+        return;
+    }
+
+    PacketPtr pkt = prefetcher->getPacket();
+    if (pkt) {
+        unsigned blk_size = RubySystem::getBlockSizeBytes();
+        Addr line_addr = pkt->getBlockAddr(blk_size);
+
+        if (issuedPfPkts.count(line_addr) == 0) {
+            DPRINTF(HWPrefetch, "%s: issuing prefetch %s\n", name(),
+                    pkt->print());
+
+            issuedPfPkts[line_addr] = pkt;
+            auto msg = std::make_shared<RubyRequest>(
+                cacheCntrl->clockEdge(), pkt->getAddr(), blk_size,
+                0, // pc
+                RubyRequestType_LD, RubyAccessMode_Supervisor, pkt,
+                PrefetchBit_Yes);
+            pfQueue->enqueue(msg, cacheCntrl->clockEdge(),
+                             cacheCntrl->cyclesToTicks(Cycles(1)));
+        } else {
+            DPRINTF(HWPrefetch, "%s: prefetch of line %#x already in "
+                    "flight\n", name(), line_addr);
+            delete pkt;
+        }
+    }
+
+    scheduleNextPrefetch();
+}
+
+void
+RubyPrefetcherProxy::completePrefetch(Addr addr)
+{
+    assert(prefetcher);
+
+    auto it = issuedPfPkts.find(makeLineAddress(addr));
+    if (it != issuedPfPkts.end()) {
+        DPRINTF(HWPrefetch, "%s: prefetch of line %#x completed\n", name(),
+                it->first);
+        delete it->second;
+        issuedPfPkts.erase(it);
+    }
+}
+
+void
+RubyPrefetcherProxy::notifyAccess(const RequestPtr &req, bool is_read,
+                                  const DataBlock &data_blk, bool miss)
+{
+    panic_if(!prefetcher, "%s: notified without a prefetcher\n", name());
+    assert(req);
+
+    Packet pkt(req, is_read ? MemCmd::ReadReq : MemCmd::WriteReq);
+    pkt.dataStaticConst(data_blk.getData(getOffset(req->getPaddr()),
+                                         req->getSize()));
+    prefetcher->probeNotify(&pkt, miss);
+    scheduleNextPrefetch();
+}
+
+void
+RubyPrefetcherProxy::notifyPfHit(const RequestPtr &req, bool is_read,
+                                 const DataBlock &data_blk)
+{
+    notifyAccess(req, is_read, data_blk, false);
+}
+
+void
+RubyPrefetcherProxy::notifyPfMiss(const RequestPtr &req, bool is_read,
+                                  const DataBlock &data_blk)
+{
+    notifyAccess(req, is_read, data_blk, true);
+}
+
+void
+RubyPrefetcherProxy::notifyPfFill(const RequestPtr &req,
+                                  const DataBlock &data_blk, bool from_pf)
+{
+    panic_if(!prefetcher, "%s: notified without a prefetcher\n", name());
+    assert(req);
+
+    Packet pkt(req, from_pf ? MemCmd::HardPFResp : MemCmd::ReadResp);
+    pkt.dataStaticConst(data_blk.getData(getOffset(req->getPaddr()),
+                                         req->getSize()));
+    prefetcher->notifyFill(&pkt);
+}
+
+void
+RubyPrefetcherProxy::notifyPfEvict(Addr blk_addr, bool hw_prefetched)
+{
+    panic_if(!prefetcher, "%s: notified without a prefetcher\n", name());
+
+    // A prefetched block evicted before any demand used it
+    if (hw_prefetched)
+        prefetcher->prefetchUnused();
+}
+
+bool
+RubyPrefetcherProxy::inCache(Addr addr, bool is_secure) const
+{
+    return cacheCntrl->inCache(addr, is_secure);
+}
+
+bool
+RubyPrefetcherProxy::hasBeenPrefetched(Addr addr, bool is_secure) const
+{
+    return cacheCntrl->hasBeenPrefetched(addr, is_secure);
+}
+
+bool
+RubyPrefetcherProxy::inMissQueue(Addr addr, bool is_secure) const
+{
+    return cacheCntrl->inMissQueue(addr, is_secure);
+}
+
+bool
+RubyPrefetcherProxy::coalesce() const
+{
+    return cacheCntrl->coalesce();
+}
+
+} // namespace ruby
+} // namespace gem5
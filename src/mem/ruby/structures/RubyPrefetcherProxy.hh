@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_RUBY_PREFETCHER_PROXY_HH__
+#define __MEM_RUBY_STRUCTURES_RUBY_PREFETCHER_PROXY_HH__
+
+#include <unordered_map>
+
+#include "base/named.hh"
+#include "mem/cache/cache_accessor.hh"
+#include "mem/cache/prefetch/base.hh"
+#include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Connects a classic prefetcher (prefetch::Base) to a SLICC controller.
+ *
+ * The controller forwards its hit, miss, fill and eviction notifications
+ * to the proxy, which trains the prefetcher with them. Prefetch candidates
+ * are turned into RubyRequests and enqueued in the controller's prefetch
+ * queue. The controller calls completePrefetch() once a prefetch is done.
+ * The prefetcher queries the state of the cache through the proxy, which
+ * relies on the controller implementing AbstractController::inCache(),
+ * hasBeenPrefetched() and inMissQueue().
+ */
+class RubyPrefetcherProxy : public CacheAccessor, public Named
+{
+  public:
+    /**
+     * @param parent The controller the prefetcher is attached to.
+     * @param prefetcher The prefetcher, or nullptr if the controller does
+     *        not prefetch.
+     * @param pf_queue The queue prefetch requests are enqueued into.
+     */
+    RubyPrefetcherProxy(AbstractController *parent,
+                        prefetch::Base *prefetcher,
+                        MessageBuffer *pf_queue);
+
+    /** Deschedule the next prefetch, e.g., before draining. */
+    void deschedulePrefetch();
+
+    /** Notify the prefetcher of a demand hit. */
+    void notifyPfHit(const RequestPtr &req, bool is_read,
+                     const DataBlock &data_blk);
+
+    /** Notify the prefetcher of a demand miss. */
+    void notifyPfMiss(const RequestPtr &req, bool is_read,
+                      const DataBlock &data_blk);
+
+    /** Notify the prefetcher of a fill, by a demand or a prefetch. */
+    void notifyPfFill(const RequestPtr &req, const DataBlock &data_blk,
+                      bool from_pf);
+
+    /** Notify the prefetcher of the eviction of a block. */
+    void notifyPfEvict(Addr blk_addr, bool hw_prefetched);
+
+    /** Notify the proxy that the prefetch of a line has completed. */
+    void completePrefetch(Addr addr);
+
+    bool inCache(Addr addr, bool is_secure) const override;
+    bool hasBeenPrefetched(Addr addr, bool is_secure) const override;
+    bool inMissQueue(Addr addr, bool is_secure) const override;
+    bool coalesce() const override;
+
+  private:
+    /** Train the prefetcher with a demand access. */
+    void notifyAccess(const RequestPtr &req, bool is_read,
+                      const DataBlock &data_blk, bool miss);
+
+    /** Schedule the next prefetch, if the prefetcher has one. */
+    void scheduleNextPrefetch();
+
+    /** Enqueue the next prefetch ready to be issued. */
+    void issuePrefetch();
+
+    AbstractController *cacheCntrl;
+    prefetch::Base *prefetcher;
+    MessageBuffer *pfQueue;
+
+    /** Prefetch packets in flight, by line address. */
+    std::unordered_map<Addr, PacketPtr> issuedPfPkts;
+
+    EventFunctionWrapper issuePfEvent;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_STRUCTURES_RUBY_PREFETCHER_PROXY_HH__
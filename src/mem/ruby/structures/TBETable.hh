@@ -41,9 +41,13 @@
 #ifndef __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 
+#include "base/intmath.hh"
+#include "base/logging.hh"
 #include "mem/ruby/common/Address.hh"
 
 namespace gem5
@@ -52,13 +56,29 @@ namespace gem5
 namespace ruby
 {
 
+// The TBEs of a TBETable are preallocated when the table is built, as the
+// number of TBEs of a controller is fixed. Allocated TBEs are found
+// through an open-addressed index with linear probing, and the free TBEs
+// are kept in a freelist, so allocating, deallocating or looking up a TBE
+// never reaches the heap.
 template<class ENTRY>
 class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_entries(number_of_TBEs),
+          m_slot_addr(number_of_TBEs, MaxAddr),
+          m_number_of_TBEs(number_of_TBEs)
     {
+        // Keep the index at most half full so that probe sequences are
+        // short
+        const int index_size = 1 << ceilLog2(std::max(2 * number_of_TBEs, 2));
+        m_index.resize(index_size, -1);
+        m_index_mask = index_size - 1;
+
+        m_free_slots.reserve(number_of_TBEs);
+        for (int slot = number_of_TBEs - 1; slot >= 0; --slot)
+            m_free_slots.push_back(slot);
     }
 
     bool isPresent(Addr address) const;
@@ -67,7 +87,7 @@ class TBETable
     bool
     areNSlotsAvailable(int n, Tick current_time) const
     {
-        return (m_number_of_TBEs - m_map.size()) >= n;
+        return (int)m_free_slots.size() >= n;
     }
 
     ENTRY *getNullEntry();
@@ -81,8 +101,33 @@ class TBETable
     TBETable(const TBETable& obj);
     TBETable& operator=(const TBETable& obj);
 
+    // Returns the number of TBE slots, allocated or not
+    int numSlots() const { return m_entries.size(); }
+
+    // Returns true if the TBE in the slot is allocated
+    bool isSlotUsed(int slot) const { return m_slot_addr[slot] != MaxAddr; }
+
+    // Returns the position of the address in m_index, or of the empty
+    // position that ends its probe sequence if the address is not present
+    int findIndex(Addr address) const;
+
+    int
+    hashIndex(Addr address) const
+    {
+        return (address * 0x9e3779b97f4a7c15ULL >> 32) & m_index_mask;
+    }
+
     // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+    std::vector<ENTRY> m_entries;
+
+    // Address of the TBE in each slot, MaxAddr when the slot is free
+    std::vector<Addr> m_slot_addr;
+
+    // Slot of each allocated TBE, -1 for empty positions
+    std::vector<int> m_index;
+    int m_index_mask;
+
+    std::vector<int> m_free_slots;
 
   private:
     int m_number_of_TBEs;
@@ -97,31 +142,69 @@ operator<<(std::ostream& out, const TBETable<ENTRY>& obj)
     return out;
 }
 
+template<class ENTRY>
+inline int
+TBETable<ENTRY>::findIndex(Addr address) const
+{
+    int pos = hashIndex(address);
+    while (m_index[pos] != -1 && m_slot_addr[m_index[pos]] != address)
+        pos = (pos + 1) & m_index_mask;
+    return pos;
+}
+
 template<class ENTRY>
 inline bool
 TBETable<ENTRY>::isPresent(Addr address) const
 {
     assert(address == makeLineAddress(address));
-    assert(m_map.size() <= m_number_of_TBEs);
-    return !!m_map.count(address);
+    return m_index[findIndex(address)] != -1;
 }
 
 template<class ENTRY>
 inline void
 TBETable<ENTRY>::allocate(Addr address)
 {
-    assert(!isPresent(address));
-    assert(m_map.size() < m_number_of_TBEs);
-    m_map[address] = ENTRY();
+    assert(address == makeLineAddress(address));
+    const int pos = findIndex(address);
+    assert(m_index[pos] == -1);
+    panic_if(m_free_slots.empty(), "All %d TBEs are already allocated\n",
+             m_number_of_TBEs);
+
+    const int slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    m_entries[slot] = ENTRY();
+    m_slot_addr[slot] = address;
+    m_index[pos] = slot;
 }
 
 template<class ENTRY>
 inline void
 TBETable<ENTRY>::deallocate(Addr address)
 {
-    assert(isPresent(address));
-    assert(m_map.size() > 0);
-    m_map.erase(address);
+    int pos = findIndex(address);
+    const int slot = m_index[pos];
+    assert(slot != -1);
+
+    m_slot_addr[slot] = MaxAddr;
+    m_free_slots.push_back(slot);
+
+    // Remove the position and shift back the following entries of the
+    // probe sequence that can fill the hole, so that no tombstones are
+    // needed
+    m_index[pos] = -1;
+    for (int next = (pos + 1) & m_index_mask; m_index[next] != -1;
+         next = (next + 1) & m_index_mask) {
+        // An entry whose home position lies cyclically in (pos, next]
+        // must stay where it is
+        const int home = hashIndex(m_slot_addr[m_index[next]]);
+        const bool stays = pos <= next ? (pos < home && home <= next) :
+                                         (pos < home || home <= next);
+        if (!stays) {
+            m_index[pos] = m_index[next];
+            m_index[next] = -1;
+            pos = next;
+        }
+    }
 }
 
 template<class ENTRY>
@@ -136,8 +219,9 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    const int slot = m_index[findIndex(address)];
+    if (slot != -1) return &m_entries[slot];
+    return NULL;
 }
 
 
@@ -57,10 +57,11 @@ CacheRecorder::CacheRecorder()
 CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                              uint64_t uncompressed_trace_size,
                              std::vector<Sequencer*>& seq_map,
-                             uint64_t block_size_bytes)
+                             uint64_t block_size_bytes,
+                             bool parallel_warmup)
     : m_uncompressed_trace(uncompressed_trace),
       m_uncompressed_trace_size(uncompressed_trace_size),
-      m_seq_map(seq_map),  m_bytes_read(0), m_records_read(0),
+      m_seq_map(seq_map), m_records_read(0),
       m_records_flushed(0), m_block_size_bytes(block_size_bytes)
 {
     if (m_uncompressed_trace != NULL) {
@@ -72,6 +73,27 @@ CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                     m_block_size_bytes, RubySystem::getBlockSizeBytes());
         }
     }
+
+    // Split the trace in streams of records, keeping the trace order in
+    // each stream
+    const uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    for (uint64_t offset = 0;
+         offset + record_size <= m_uncompressed_trace_size;
+         offset += record_size) {
+        const TraceRecord *rec =
+            (const TraceRecord *)(m_uncompressed_trace + offset);
+        Sequencer *seq = parallel_warmup ? m_seq_map[rec->m_cntrl_id] : NULL;
+        auto it = m_seq_stream.find(seq);
+        if (it == m_seq_stream.end()) {
+            it = m_seq_stream.emplace(seq, m_fetch_streams.size()).first;
+            m_fetch_streams.emplace_back();
+        }
+        m_fetch_streams[it->second].records.push_back(offset);
+    }
+    if (parallel_warmup) {
+        DPRINTF(RubyCacheTrace, "Warming up %d sequencers in parallel\n",
+                m_fetch_streams.size());
+    }
 }
 
 CacheRecorder::~CacheRecorder()
@@ -108,9 +130,33 @@ CacheRecorder::enqueueNextFlushRequest()
 void
 CacheRecorder::enqueueNextFetchRequest()
 {
-    if (m_bytes_read < m_uncompressed_trace_size) {
+    for (auto &stream : m_fetch_streams)
+        enqueueFetchRequest(stream);
+
+    if (m_fetch_streams.empty()) {
+        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+    }
+}
+
+void
+CacheRecorder::fetchRequestDone(Sequencer *seq)
+{
+    // Without parallel warmup, all the records are in one stream
+    auto it = m_seq_stream.find(seq);
+    FetchStream &stream = m_fetch_streams[
+        it == m_seq_stream.end() ? m_seq_stream.at(NULL) : it->second];
+
+    assert(stream.pending > 0);
+    if (--stream.pending == 0)
+        enqueueFetchRequest(stream);
+}
+
+void
+CacheRecorder::enqueueFetchRequest(FetchStream &stream)
+{
+    if (stream.next < stream.records.size()) {
         TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
-                                                                m_bytes_read);
+                                            stream.records[stream.next++]);
 
         DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
 
@@ -144,13 +190,14 @@ CacheRecorder::enqueueNextFetchRequest()
 
             Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
             assert(m_sequencer_ptr != NULL);
+            stream.pending++;
             m_sequencer_ptr->makeRequest(pkt);
         }
 
-        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
         m_records_read++;
     } else {
-        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+        DPRINTF(RubyCacheTrace, "Fetched all %d records of a stream\n",
+                stream.records.size());
     }
 }
 
@@ -180,21 +227,18 @@ CacheRecorder::aggregateRecords(uint8_t **buf, uint64_t total_size)
     uint64_t current_size = 0;
     int record_size = sizeof(TraceRecord) + m_block_size_bytes;
 
-    for (int i = 0; i < size; ++i) {
-        // Determine if we need to expand the buffer size
-        if (current_size + record_size > total_size) {
-            uint8_t* new_buf = new (std::nothrow) uint8_t[total_size * 2];
-            if (new_buf == NULL) {
-                fatal("Unable to allocate buffer of size %s\n",
-                      total_size * 2);
-            }
-            total_size = total_size * 2;
-            uint8_t* old_buf = *buf;
-            memcpy(new_buf, old_buf, current_size);
-            *buf = new_buf;
-            delete [] old_buf;
+    // The size of the trace is known, so grow the buffer once
+    if ((uint64_t)size * record_size > total_size) {
+        total_size = (uint64_t)size * record_size;
+        uint8_t* new_buf = new (std::nothrow) uint8_t[total_size];
+        if (new_buf == NULL) {
+            fatal("Unable to allocate buffer of size %s\n", total_size);
         }
+        delete [] *buf;
+        *buf = new_buf;
+    }
 
+    for (int i = 0; i < size; ++i) {
         // Copy the current record into the buffer
         memcpy(&((*buf)[current_size]), m_records[i], record_size);
         current_size += record_size;
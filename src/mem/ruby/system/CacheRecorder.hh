@@ -35,6 +35,7 @@
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <unordered_map>
 #include <vector>
 
 #include "base/types.hh"
@@ -79,7 +80,8 @@ class CacheRecorder
     CacheRecorder(uint8_t* uncompressed_trace,
                   uint64_t uncompressed_trace_size,
                   std::vector<Sequencer*>& SequencerMap,
-                  uint64_t block_size_bytes);
+                  uint64_t block_size_bytes,
+                  bool parallel_warmup = false);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
@@ -101,22 +103,46 @@ class CacheRecorder
      * checkpoint and issues fetch requests. Except for the first one, a
      * fetch request is issued only after the previous one has completed.
      * It should be possible to use this with any protocol.
+     *
+     * With parallel warmup, the records of each sequencer are fetched in
+     * order, but the sequencers fetch their records concurrently.
      */
     void enqueueNextFetchRequest();
 
+    /*!
+     * Called when a fetch request issued by enqueueNextFetchRequest()
+     * completes; issues the next record of the sequencer once all the
+     * requests of its current record are done.
+     */
+    void fetchRequestDone(Sequencer *seq);
+
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
+    //! Records fetched one after the other, as offsets in the trace
+    struct FetchStream
+    {
+        std::vector<uint64_t> records;
+        size_t next = 0;
+        //! Requests of the current record that have not completed
+        int pending = 0;
+    };
+
+    void enqueueFetchRequest(FetchStream &stream);
+
     std::vector<TraceRecord*> m_records;
     uint8_t* m_uncompressed_trace;
     uint64_t m_uncompressed_trace_size;
     std::vector<Sequencer*> m_seq_map;
-    uint64_t m_bytes_read;
     uint64_t m_records_read;
     uint64_t m_records_flushed;
     uint64_t m_block_size_bytes;
+
+    //! A single stream, or one per sequencer with parallel warmup
+    std::vector<FetchStream> m_fetch_streams;
+    std::unordered_map<Sequencer*, int> m_seq_stream;
 };
 
 inline bool
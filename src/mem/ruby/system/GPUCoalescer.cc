@@ -31,6 +31,8 @@
 
 #include "mem/ruby/system/GPUCoalescer.hh"
 
+#include <algorithm>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "base/str.hh"
@@ -63,88 +65,125 @@ UncoalescedTable::UncoalescedTable(GPUCoalescer *gc)
 {
 }
 
+UncoalescedTable::InstSlot *
+UncoalescedTable::findSlot(InstSeqNum seqNum)
+{
+    // the instruction being looked up is most likely a recent one
+    for (size_t i = numSlots; i-- > 0; ) {
+        if (slots[i].seqNum == seqNum)
+            return &slots[i];
+        if (slots[i].seqNum < seqNum)
+            break;
+    }
+    return nullptr;
+}
+
 void
 UncoalescedTable::insertPacket(PacketPtr pkt)
 {
     uint64_t seqNum = pkt->req->getReqInstSeqNum();
 
-    instMap[seqNum].push_back(pkt);
+    InstSlot *slot = findSlot(seqNum);
+    if (!slot) {
+        // take a free slot and move it to its place in age order
+        if (numSlots == slots.size())
+            slots.emplace_back();
+        auto pos = std::upper_bound(slots.begin(), slots.begin() + numSlots,
+            seqNum, [](InstSeqNum seq_num, const InstSlot &s) {
+                return seq_num < s.seqNum;
+            });
+        std::rotate(pos, slots.begin() + numSlots,
+                    slots.begin() + numSlots + 1);
+        ++numSlots;
+
+        slot = &*pos;
+        slot->seqNum = seqNum;
+        slot->pktsRemaining = -1;
+        assert(slot->pkts.empty());
+    }
+
+    slot->pkts.push_back(pkt);
     DPRINTF(GPUCoalescer, "Adding 0x%X seqNum %d to map. (map %d vec %d)\n",
-            pkt->getAddr(), seqNum, instMap.size(), instMap[seqNum].size());
+            pkt->getAddr(), seqNum, numSlots, slot->pkts.size());
 }
 
 bool
 UncoalescedTable::packetAvailable()
 {
-    return !instMap.empty();
+    return numSlots > 0;
 }
 
 void
 UncoalescedTable::initPacketsRemaining(InstSeqNum seqNum, int count)
 {
-    if (!instPktsRemaining.count(seqNum)) {
-        instPktsRemaining[seqNum] = count;
+    InstSlot *slot = findSlot(seqNum);
+    assert(slot);
+    if (slot->pktsRemaining < 0) {
+        slot->pktsRemaining = count;
     }
 }
 
 int
 UncoalescedTable::getPacketsRemaining(InstSeqNum seqNum)
 {
-    return instPktsRemaining[seqNum];
+    InstSlot *slot = findSlot(seqNum);
+    assert(slot && slot->pktsRemaining >= 0);
+    return slot->pktsRemaining;
 }
 
 void
 UncoalescedTable::setPacketsRemaining(InstSeqNum seqNum, int count)
 {
-    instPktsRemaining[seqNum] = count;
+    InstSlot *slot = findSlot(seqNum);
+    assert(slot);
+    slot->pktsRemaining = count;
 }
 
 PerInstPackets*
 UncoalescedTable::getInstPackets(int offset)
 {
-    if (offset >= instMap.size()) {
+    if (offset >= (int)numSlots) {
         return nullptr;
     }
 
-    auto instMapIter = instMap.begin();
-    std::advance(instMapIter, offset);
-
-    return &(instMapIter->second);
+    return &slots[offset].pkts;
 }
 
 void
 UncoalescedTable::updateResources()
 {
-    for (auto iter = instMap.begin(); iter != instMap.end(); ) {
-        InstSeqNum seq_num = iter->first;
+    // compact the slots in use, keeping them in age order
+    size_t kept = 0;
+    for (size_t i = 0; i < numSlots; ++i) {
+        InstSlot &slot = slots[i];
+        InstSeqNum seq_num = slot.seqNum;
         DPRINTF(GPUCoalescer, "%s checking remaining pkts for %d\n",
                 coalescer->name().c_str(), seq_num);
-        assert(instPktsRemaining.count(seq_num));
+        assert(slot.pktsRemaining >= 0);
 
-        if (instPktsRemaining[seq_num] == 0) {
-            assert(iter->second.empty());
-
-            // Remove from both maps
-            instMap.erase(iter++);
-            instPktsRemaining.erase(seq_num);
+        if (slot.pktsRemaining == 0) {
+            assert(slot.pkts.empty());
 
             // Release the token
             DPRINTF(GPUCoalescer, "Returning token seqNum %d\n", seq_num);
             coalescer->getGMTokenPort().sendTokens(1);
         } else {
-            ++iter;
+            if (kept != i)
+                std::swap(slots[kept], slot);
+            ++kept;
         }
     }
+    numSlots = kept;
 }
 
 bool
 UncoalescedTable::areRequestsDone(const uint64_t instSeqNum) {
     // iterate the instructions held in UncoalescedTable to see whether there
     // are more requests to issue; if yes, not yet done; otherwise, done
-    for (auto& inst : instMap) {
+    for (size_t i = 0; i < numSlots; ++i) {
         DPRINTF(GPUCoalescer, "instSeqNum= %d, pending packets=%d\n"
-            ,inst.first, inst.second.size());
-        if (inst.first == instSeqNum) { return false; }
+            ,slots[i].seqNum, slots[i].pkts.size());
+        if (slots[i].seqNum == instSeqNum) { return false; }
     }
 
     return true;
@@ -153,11 +192,11 @@ UncoalescedTable::areRequestsDone(const uint64_t instSeqNum) {
 void
 UncoalescedTable::printRequestTable(std::stringstream& ss)
 {
-    ss << "Listing pending packets from " << instMap.size() << " instructions";
+    ss << "Listing pending packets from " << numSlots << " instructions";
 
-    for (auto& inst : instMap) {
-        ss << "\tAddr: " << printAddress(inst.first) << " with "
-           << inst.second.size() << " pending packets" << std::endl;
+    for (size_t i = 0; i < numSlots; ++i) {
+        ss << "\tAddr: " << printAddress(slots[i].seqNum) << " with "
+           << slots[i].pkts.size() << " pending packets" << std::endl;
     }
 }
 
@@ -166,8 +205,8 @@ UncoalescedTable::checkDeadlock(Tick threshold)
 {
     Tick current_time = curTick();
 
-    for (auto &it : instMap) {
-        for (auto &pkt : it.second) {
+    for (size_t i = 0; i < numSlots; ++i) {
+        for (auto &pkt : slots[i].pkts) {
             if (current_time - pkt->req->time() > threshold) {
                 std::stringstream ss;
                 printRequestTable(ss);
@@ -176,7 +215,7 @@ UncoalescedTable::checkDeadlock(Tick threshold)
                      "version: %d request.paddr: 0x%x uncoalescedTable: %d "
                      "current time: %u issue_time: %d difference: %d\n"
                      "Request Tables:\n\n%s", coalescer->getId(),
-                      pkt->getAddr(), instMap.size(), current_time,
+                      pkt->getAddr(), numSlots, current_time,
                       pkt->req->time(), current_time - pkt->req->time(),
                       ss.str());
             }
@@ -645,8 +684,9 @@ GPUCoalescer::makeRequest(PacketPtr pkt)
         int num_packets = 1;
         if (!m_usingRubyTester) {
             num_packets = 0;
+            GPUDynInstPtr gpu_dyn_inst = getDynInst(pkt);
             for (int i = 0; i < TheGpuISA::NumVecElemPerVecReg; i++) {
-                num_packets += getDynInst(pkt)->getLaneStatus(i);
+                num_packets += gpu_dyn_inst->getLaneStatus(i);
             }
         }
 
@@ -715,9 +755,10 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
 
     // If the packet has the same line address as a request already in the
     // coalescedTable and has the same sequence number, it can be coalesced.
-    if (coalescedTable.count(line_addr)) {
+    auto table_it = coalescedTable.find(line_addr);
+    if (table_it != coalescedTable.end()) {
         // Search for a previous coalesced request with the same seqNum.
-        auto& creqQueue = coalescedTable.at(line_addr);
+        auto& creqQueue = table_it->second;
         auto citer = std::find_if(creqQueue.begin(), creqQueue.end(),
             [&](CoalescedRequest* c) { return c->getSeqNum() == seqNum; }
         );
@@ -738,21 +779,19 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
         creq->setRubyType(getRequestType(pkt));
         creq->setIssueTime(curCycle());
 
-        if (!coalescedTable.count(line_addr)) {
+        if (table_it == coalescedTable.end()) {
             // If there is no outstanding request for this line address,
             // create a new coalecsed request and issue it immediately.
-            auto reqList = std::deque<CoalescedRequest*> { creq };
-            coalescedTable.insert(std::make_pair(line_addr, reqList));
-            if (!coalescedReqs.count(seqNum)) {
-                coalescedReqs.insert(std::make_pair(seqNum, reqList));
-            } else {
-                coalescedReqs.at(seqNum).push_back(creq);
-            }
+            coalescedTable.emplace(line_addr,
+                                   std::deque<CoalescedRequest*>{ creq });
+            assert(coalescedReqs.empty() ||
+                   coalescedReqs.front()->getSeqNum() == seqNum);
+            coalescedReqs.push_back(creq);
         } else {
             // The request is for a line address that is already outstanding
             // but for a different instruction. Add it as a new request to be
             // issued when the current outstanding request is completed.
-            coalescedTable.at(line_addr).push_back(creq);
+            table_it->second.push_back(creq);
             DPRINTF(GPUCoalescer, "found address 0x%X with new seqNum %d\n",
                     line_addr, seqNum);
         }
@@ -831,20 +870,18 @@ GPUCoalescer::completeIssue()
             // erase them from the list if coalescing is successful and
             // leave them in the list otherwise. This aggressively attempts
             // to coalesce as many packets as possible from the current inst.
-            pkt_list->remove_if(
-                [&](PacketPtr pkt) { return coalescePacket(pkt); }
-            );
-
-            if (coalescedReqs.count(seq_num)) {
-                auto& creqs = coalescedReqs.at(seq_num);
-                for (auto creq : creqs) {
-                    DPRINTF(GPUCoalescer, "Issued req type %s seqNum %d\n",
-                            RubyRequestType_to_string(creq->getRubyType()),
-                                                      seq_num);
-                    issueRequest(creq);
-                }
-                coalescedReqs.erase(seq_num);
+            pkt_list->erase(std::remove_if(pkt_list->begin(),
+                pkt_list->end(),
+                [&](PacketPtr pkt) { return coalescePacket(pkt); }),
+                pkt_list->end());
+
+            for (auto creq : coalescedReqs) {
+                DPRINTF(GPUCoalescer, "Issued req type %s seqNum %d\n",
+                        RubyRequestType_to_string(creq->getRubyType()),
+                                                  seq_num);
+                issueRequest(creq);
             }
+            coalescedReqs.clear();
 
             assert(pkt_list_size >= pkt_list->size());
             size_t pkt_list_diff = pkt_list_size - pkt_list->size();
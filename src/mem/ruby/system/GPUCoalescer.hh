@@ -34,7 +34,9 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 
+#include "base/pool_allocator.hh"
 #include "base/statistics.hh"
 #include "gpu-compute/gpu_dyn_inst.hh"
 #include "gpu-compute/misc.hh"
@@ -62,7 +64,7 @@ struct MachineID;
 class CacheMemory;
 
 // List of packets that belongs to a specific instruction.
-typedef std::list<PacketPtr> PerInstPackets;
+typedef std::vector<PacketPtr> PerInstPackets;
 
 class UncoalescedTable
 {
@@ -92,15 +94,28 @@ class UncoalescedTable
     void checkDeadlock(Tick threshold);
 
   private:
-    GPUCoalescer *coalescer;
+    // An instruction in the table: the packets that still need to be
+    // coalesced and the number of its packets that have not been
+    // coalesced yet (-1 until it is initialized).
+    struct InstSlot
+    {
+        InstSeqNum seqNum = 0;
+        int pktsRemaining = -1;
+        PerInstPackets pkts;
+    };
 
-    // Maps an instructions unique sequence number to a queue of packets
-    // which need responses. This data structure assumes the sequence number
-    // is monotonically increasing (which is true for CU class) in order to
-    // issue packets in age order.
-    std::map<InstSeqNum, PerInstPackets> instMap;
+    InstSlot *findSlot(InstSeqNum seqNum);
 
-    std::map<InstSeqNum, int> instPktsRemaining;
+    GPUCoalescer *coalescer;
+
+    // The instructions with packets which need responses, kept in
+    // sequence number order in order to issue packets in age order. The
+    // first numSlots entries are in use. The others are free and keep
+    // their packet storage, so reusing a slot does not allocate. Sequence
+    // numbers of a CU mostly arrive in increasing order, so new
+    // instructions are usually appended.
+    std::vector<InstSlot> slots;
+    size_t numSlots = 0;
 };
 
 class CoalescedRequest
@@ -123,6 +138,24 @@ class CoalescedRequest
     RubyRequestType getRubyType() const { return rubyType; }
     std::vector<PacketPtr>& getPackets() { return pkts; }
 
+    /**
+     * A coalesced request is created for every line accessed by an
+     * instruction, so their storage is recycled.
+     */
+    static void *
+    operator new(std::size_t size)
+    {
+        assert(size == sizeof(CoalescedRequest));
+        return PoolAllocator<CoalescedRequest>().allocate(1);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        PoolAllocator<CoalescedRequest>().deallocate(
+            static_cast<CoalescedRequest *>(p), 1);
+    }
+
   private:
     uint64_t seqNum;
     Cycles issueTime;
@@ -432,11 +465,14 @@ class GPUCoalescer : public RubyPort
     // maximum size is equal to the maximum outstanding requests for a CU
     // (typically the number of blocks in TCP). If there are duplicates of
     // an address, the are serviced in age order.
-    std::map<Addr, std::deque<CoalescedRequest*>> coalescedTable;
-    // Map of instruction sequence number to coalesced requests that get
+    std::map<Addr, std::deque<CoalescedRequest*>, std::less<Addr>,
+             PoolAllocator<std::pair<const Addr,
+                                     std::deque<CoalescedRequest*>>>>
+        coalescedTable;
+    // Coalesced requests of the instruction being coalesced that get
     // created in coalescePacket, used in completeIssue to send the fully
     // coalesced request
-    std::unordered_map<uint64_t, std::deque<CoalescedRequest*>> coalescedReqs;
+    std::vector<CoalescedRequest*> coalescedReqs;
 
     // a map btw an instruction sequence number and PendingWriteInst
     // this is used to do a final call back for each write when it is
@@ -370,6 +370,10 @@ RubyPort::MemResponsePort::recvAtomic(PacketPtr pkt)
     Tick latency = mem_interface->recvAtomic(pkt);
     if (access_backing_store)
         rs->getPhysMem()->access(pkt);
+    if (rs->functionalWarming() && pkt->cmd != MemCmd::MemSyncReq &&
+        !pkt->req->isUncacheable()) {
+        rs->recordWarmingAccess(ruby_port->m_controller, pkt);
+    }
     return latency;
 }
 
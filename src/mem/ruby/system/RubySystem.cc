@@ -43,7 +43,9 @@
 #include <fcntl.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <list>
 
 #include "base/compiler.hh"
@@ -78,6 +80,10 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
+      m_parallel_warmup(p.parallel_cache_warmup),
+      m_functional_warming(p.functional_warming),
+      m_functional_warming_lines(p.functional_warming_lines),
+      m_functional_hints(NumFunctionalHints),
       m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
@@ -202,7 +208,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 
     // Create the CacheRecorder and record the cache trace
     m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
-                                         sequencer_map, block_size_bytes);
+                                         sequencer_map, block_size_bytes,
+                                         m_parallel_warmup);
 }
 
 void
@@ -343,6 +350,103 @@ RubySystem::drainResume()
         delete m_cache_recorder;
         m_cache_recorder = NULL;
     }
+
+    if (!m_warming_lru.empty() && !params().system->bypassCaches())
+        replayWarmingAccesses();
+}
+
+void
+RubySystem::recordWarmingAccess(AbstractController *cntrl, PacketPtr pkt)
+{
+    auto it = std::find(m_abs_cntrl_vec.begin(), m_abs_cntrl_vec.end(),
+                        cntrl);
+    assert(it != m_abs_cntrl_vec.end());
+    int cntrl_id = it - m_abs_cntrl_vec.begin();
+
+    // Stores are replayed as loads. This gives up the ownership the
+    // store would have obtained, but the data replayed is then always
+    // the current memory contents.
+    RubyRequestType type = pkt->req->isInstFetch() ?
+        RubyRequestType_IFETCH : RubyRequestType_LD;
+
+    Addr line = makeLineAddress(pkt->getAddr());
+    auto key = std::make_pair(cntrl_id, line);
+    auto entry = m_warming_index.find(key);
+    if (entry != m_warming_index.end()) {
+        entry->second->type = type;
+        m_warming_lru.splice(m_warming_lru.end(), m_warming_lru,
+                             entry->second);
+        return;
+    }
+
+    if (m_warming_lru.size() >= m_functional_warming_lines) {
+        const WarmingAccess &oldest = m_warming_lru.front();
+        m_warming_index.erase(std::make_pair(oldest.cntrl, oldest.line));
+        m_warming_lru.pop_front();
+    }
+    m_warming_lru.push_back({cntrl_id, line, type});
+    m_warming_index[key] = std::prev(m_warming_lru.end());
+}
+
+void
+RubySystem::replayWarmingAccesses()
+{
+    DPRINTF(RubyCacheTrace, "Replaying %d warming accesses\n",
+            m_warming_lru.size());
+
+    // Build a cache trace, oldest access first so that the replacement
+    // state ends up as recorded. The data is read at this point since
+    // the sequencers install whatever the trace holds.
+    const uint64_t block_size = getBlockSizeBytes();
+    const uint64_t record_size = sizeof(TraceRecord) + block_size;
+    const uint64_t trace_size = m_warming_lru.size() * record_size;
+    uint8_t *trace = new uint8_t[trace_size];
+    uint8_t *pos = trace;
+    for (const auto &access : m_warming_lru) {
+        TraceRecord *rec = (TraceRecord *)pos;
+        rec->m_cntrl_id = access.cntrl;
+        rec->m_time = 0;
+        rec->m_data_address = access.line;
+        rec->m_pc_address = 0;
+        rec->m_type = access.type;
+
+        auto req = std::make_shared<Request>(access.line, block_size, 0,
+                                             Request::funcRequestorId);
+        Packet pkt(req, MemCmd::ReadReq);
+        pkt.dataStatic(rec->m_data);
+        if (!functionalRead(&pkt))
+            std::memset(rec->m_data, 0, block_size);
+
+        pos += record_size;
+    }
+    m_warming_lru.clear();
+    m_warming_index.clear();
+
+    makeCacheRecorder(trace, trace_size, block_size);
+    m_warmup_enabled = true;
+    m_systems_to_warmup++;
+
+    // Replay the trace in isolation, like on checkpoint restore, but
+    // from the current tick.
+    Tick curtick_original = curTick();
+    Event *eventq_head = eventq->replaceHead(NULL);
+    enqueueRubyEvent(curTick());
+    simulate();
+
+    delete m_cache_recorder;
+    m_cache_recorder = NULL;
+    m_systems_to_warmup--;
+    if (m_systems_to_warmup == 0) {
+        m_warmup_enabled = false;
+    }
+
+    eventq->replaceHead(eventq_head);
+    setCurTick(curtick_original);
+
+    // As with memWriteback(), objects may have seen ticks beyond the
+    // restored one while replaying.
+    warn_once("Ruby functional warming is experimental. Timing right after "
+              "the replay may not always be accurate.");
 }
 
 void
@@ -503,6 +607,19 @@ RubySystem::functionalRead(PacketPtr pkt)
     int request_net_id = requestorToNetwork[pkt->requestorId()];
     assert(netCntrls.count(request_net_id));
 
+    // A line with a writable copy is read from that copy whatever state
+    // the other controllers are in, so if the controller that had it last
+    // time still has it the other controllers need not be looked at.
+    FunctionalHint &hint = functionalHint(line_address);
+    if (hint.line == line_address && hint.net == request_net_id &&
+        hint.cntrl->getAccessPermission(line_address) ==
+            AccessPermission_Read_Write) {
+        DPRINTF(RubySystem, "Functional read of %#x from the last "
+                            "writable copy\n", address);
+        hint.cntrl->functionalRead(line_address, pkt);
+        return true;
+    }
+
     AbstractController *ctrl_ro = nullptr;
     AbstractController *ctrl_rw = nullptr;
     AbstractController *ctrl_backing_store = nullptr;
@@ -569,6 +686,9 @@ RubySystem::functionalRead(PacketPtr pkt)
         // any), otherwise use get the first read only found
         if (ctrl_rw) {
             ctrl_rw->functionalRead(line_address, pkt);
+            if (num_rw == 1)
+                hint = FunctionalHint{line_address,
+                                      (unsigned)request_net_id, ctrl_rw};
         } else {
             assert(ctrl_ro);
             ctrl_ro->functionalRead(line_address, pkt);
@@ -35,7 +35,10 @@
 #ifndef __MEM_RUBY_SYSTEM_RUBYSYSTEM_HH__
 #define __MEM_RUBY_SYSTEM_RUBYSYSTEM_HH__
 
+#include <list>
+#include <map>
 #include <unordered_map>
+#include <utility>
 
 #include "base/callback.hh"
 #include "base/output.hh"
@@ -108,12 +111,19 @@ class RubySystem : public ClockedObject
     void registerMachineID(const MachineID& mach_id, Network* network);
     void registerRequestorIDs();
 
+    bool functionalWarming() const { return m_functional_warming; }
+
+    /**
+     * Record an access that bypassed the caches, to be replayed through
+     * the requesting controller's sequencer once the caches are used
+     * again. The replay only includes the most recently accessed lines.
+     */
+    void recordWarmingAccess(AbstractController *cntrl, PacketPtr pkt);
+
     bool eventQueueEmpty() { return eventq->empty(); }
     void enqueueRubyEvent(Tick tick)
     {
-        auto e = new EventFunctionWrapper(
-            [this]{ processRubyEvent(); }, "RubyEvent");
-        schedule(e, tick);
+        schedulePooled([this]{ processRubyEvent(); }, "RubyEvent", tick);
     }
 
   private:
@@ -132,6 +142,11 @@ class RubySystem : public ClockedObject
                                      uint64_t uncompressed_trace_size);
 
     void processRubyEvent();
+
+    //! Warm up the caches with the accesses recorded while they were
+    //! bypassed, using the cache trace replay of checkpoint restore.
+    void replayWarmingAccesses();
+
   private:
     // configuration parameters
     static bool m_randomization;
@@ -144,6 +159,24 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     memory::SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_parallel_warmup;
+
+    const bool m_functional_warming;
+    const unsigned m_functional_warming_lines;
+
+    //! A line accessed while the caches were bypassed.
+    struct WarmingAccess
+    {
+        int cntrl;
+        Addr line;
+        RubyRequestType type;
+    };
+
+    //! Warming accesses from least to most recently used, and an index
+    //! of them by controller and line.
+    std::list<WarmingAccess> m_warming_lru;
+    std::map<std::pair<int, Addr>,
+             std::list<WarmingAccess>::iterator> m_warming_index;
 
     //std::vector<Network *> m_networks;
     std::vector<std::unique_ptr<Network>> m_networks;
@@ -154,6 +187,24 @@ class RubySystem : public ClockedObject
     std::unordered_map<RequestorID, unsigned> requestorToNetwork;
     std::unordered_map<unsigned, std::vector<AbstractController*>> netCntrls;
 
+    //! The controller found with a writable copy of a line by a recent
+    //! functional read, which later reads of the line check first.
+    struct FunctionalHint
+    {
+        Addr line = MaxAddr;
+        unsigned net = 0;
+        AbstractController *cntrl = nullptr;
+    };
+    static constexpr unsigned NumFunctionalHints = 4096;
+    std::vector<FunctionalHint> m_functional_hints;
+
+    FunctionalHint &
+    functionalHint(Addr line_address)
+    {
+        return m_functional_hints[(line_address >> m_block_size_bits) %
+                                  NumFunctionalHints];
+    }
+
   public:
     Profiler* m_profiler;
     CacheRecorder* m_cache_recorder;
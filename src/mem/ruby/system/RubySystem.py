@@ -50,6 +50,13 @@ class RubySystem(ClockedObject):
         store and only use ruby for timing.")
 
     # Profiler related configuration variables
+    functional_warming = Param.Bool(False, "Record the lines accessed \
+        while the caches are bypassed (atomic_noncaching mode) and replay \
+        them to warm up the caches when leaving that mode")
+    functional_warming_lines = Param.Unsigned(1 << 20, "Number of most \
+        recently accessed lines replayed by functional warming")
+    parallel_cache_warmup = Param.Bool(False, "Replay the cache trace of \
+        each sequencer independently instead of one record at a time")
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
     num_of_sequencers = Param.Int("")
@@ -45,6 +45,7 @@
 #include <list>
 #include <unordered_map>
 
+#include "base/pool_allocator.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/MachineType.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
@@ -83,6 +84,11 @@ struct SequencerRequest
 
 std::ostream& operator<<(std::ostream& out, const SequencerRequest& obj);
 
+// The requests to a line, in the order they were issued. An entry is
+// added and removed for every access, so the nodes are recycled.
+typedef std::list<SequencerRequest, PoolAllocator<SequencerRequest>>
+    SequencerRequestList;
+
 class Sequencer : public RubyPort
 {
   public:
@@ -220,8 +226,14 @@ class Sequencer : public RubyPort
     Sequencer& operator=(const Sequencer& obj);
 
   protected:
-    // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    // RequestTable contains both read and write requests, handles aliasing.
+    // It is sized for max_outstanding_requests lines and its nodes are
+    // recycled, so it does not allocate in the common case.
+    std::unordered_map<Addr, SequencerRequestList, std::hash<Addr>,
+                       std::equal_to<Addr>,
+                       PoolAllocator<std::pair<const Addr,
+                                               SequencerRequestList>>>
+        m_RequestTable;
     // UnadressedRequestTable contains "unaddressed" requests,
     // guaranteed not to alias each other
     std::unordered_map<uint64_t, SequencerRequest> m_UnaddressedRequestTable;
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sampled_stack_dist.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+SampledStackDistCalc::SampledStackDistCalc(unsigned max_samples)
+    : maxSamples(max_samples),
+      threshold(std::numeric_limits<uint64_t>::max()),
+      numTracked(0), nextTime(1)
+{
+    fatal_if(max_samples == 0,
+             "The sampled stack distance needs at least one sample\n");
+
+    // Keep the table at most half full, so that the probe sequences
+    // stay short
+    const size_t table_size = std::max<size_t>(
+        2, size_t(1) << ceilLog2(2 * uint64_t(max_samples)));
+    table.resize(table_size, Slot{Empty, 0, 0});
+    tableMask = table_size - 1;
+    tableShift = 64 - floorLog2(table_size);
+
+    heap.reserve(max_samples + 1);
+
+    // Leave room for a few timestamps per sample, so that renumbering
+    // them is rare
+    tree.resize(4 * uint64_t(max_samples) + 1, 0);
+}
+
+uint64_t
+SampledStackDistCalc::hashAddr(Addr addr)
+{
+    // splitmix64 finalizer. Line addresses have their low bits clear,
+    // so the bits have to be mixed well for the threshold to select a
+    // uniform sample.
+    uint64_t x = addr;
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+double
+SampledStackDistCalc::samplingRate() const
+{
+    return std::ldexp(double(threshold), -64);
+}
+
+size_t
+SampledStackDistCalc::findSlot(Addr addr, uint64_t hash) const
+{
+    size_t pos = home(hash);
+    while (table[pos].addr != Empty && table[pos].addr != addr)
+        pos = (pos + 1) & tableMask;
+    return pos;
+}
+
+void
+SampledStackDistCalc::eraseSlot(size_t pos)
+{
+    // Backward shift deletion: move up the entries of the probe
+    // sequence that would otherwise no longer be found
+    size_t next = (pos + 1) & tableMask;
+    while (table[next].addr != Empty) {
+        const size_t ideal = home(table[next].hash);
+        const bool stays = pos <= next ?
+            (pos < ideal && ideal <= next) :
+            (pos < ideal || ideal <= next);
+        if (!stays) {
+            table[pos] = table[next];
+            pos = next;
+        }
+        next = (next + 1) & tableMask;
+    }
+    table[pos].addr = Empty;
+}
+
+void
+SampledStackDistCalc::addTime(uint64_t time, int delta)
+{
+    for (; time < tree.size(); time += time & -time)
+        tree[time] += delta;
+}
+
+uint64_t
+SampledStackDistCalc::countUpTo(uint64_t time) const
+{
+    uint64_t count = 0;
+    for (; time > 0; time -= time & -time)
+        count += tree[time];
+    return count;
+}
+
+uint64_t
+SampledStackDistCalc::newTime()
+{
+    if (nextTime == tree.size()) {
+        // Out of timestamps, number the live ones from one again in the
+        // same order
+        std::vector<size_t> live;
+        live.reserve(numTracked);
+        for (size_t pos = 0; pos < table.size(); pos++) {
+            if (table[pos].addr != Empty)
+                live.push_back(pos);
+        }
+        std::sort(live.begin(), live.end(), [this](size_t a, size_t b) {
+            return table[a].time < table[b].time;
+        });
+
+        std::fill(tree.begin(), tree.end(), 0);
+        nextTime = 1;
+        for (size_t pos : live) {
+            table[pos].time = nextTime;
+            addTime(nextTime, 1);
+            nextTime++;
+        }
+    }
+    return nextTime++;
+}
+
+void
+SampledStackDistCalc::evict()
+{
+    // Drop the address with the largest hash, and any other address that
+    // would no longer be sampled at the lowered threshold
+    do {
+        std::pop_heap(heap.begin(), heap.end());
+        const auto [hash, addr] = heap.back();
+        heap.pop_back();
+
+        const size_t pos = findSlot(addr, hash);
+        assert(table[pos].addr == addr);
+        addTime(table[pos].time, -1);
+        eraseSlot(pos);
+        numTracked--;
+        threshold = hash;
+    } while (!heap.empty() && heap.front().first >= threshold);
+}
+
+uint64_t
+SampledStackDistCalc::calcStackDistAndUpdate(Addr addr)
+{
+    const uint64_t hash = hashAddr(addr);
+    if (hash >= threshold)
+        return NotSampled;
+
+    const size_t pos = findSlot(addr, hash);
+    const uint64_t time = newTime();
+
+    if (table[pos].addr == Empty) {
+        table[pos] = Slot{addr, hash, time};
+        addTime(time, 1);
+        numTracked++;
+
+        heap.emplace_back(hash, addr);
+        std::push_heap(heap.begin(), heap.end());
+        if (numTracked > maxSamples)
+            evict();
+        return Infinity;
+    }
+
+    // The number of sampled addresses accessed since the last access to
+    // this one, scaled up by the sampling rate
+    Slot &slot = table[pos];
+    const uint64_t dist = countUpTo(time - 1) - countUpTo(slot.time);
+    addTime(slot.time, -1);
+    slot.time = time;
+    addTime(time, 1);
+
+    const double estimate = std::round(dist / samplingRate());
+    return estimate < double(NotSampled) ? uint64_t(estimate) :
+        NotSampled - 1;
+}
+
+} // namespace gem5
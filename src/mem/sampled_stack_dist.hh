@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_SAMPLED_STACK_DIST_HH__
+#define __MEM_SAMPLED_STACK_DIST_HH__
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Approximate stack distance calculator with a fixed memory footprint,
+ * following the fixed-size variant of SHARDS (Waldspurger et al.,
+ * FAST 2015).
+ *
+ * Addresses are sampled spatially: an address is tracked if the hash of
+ * it is below a threshold, so either every access to an address or none
+ * of them is seen. At most maxSamples addresses are tracked at a time.
+ * When a new address would go over that limit, the tracked address with
+ * the largest hash is dropped and the threshold lowered to its hash,
+ * which lowers the sampling rate accordingly. The stack distance among
+ * the sampled addresses, scaled by the inverse of the sampling rate, is
+ * an estimate of the true stack distance.
+ *
+ * The sampled addresses live in a flat open addressing hash table. The
+ * distinct addresses accessed since a given time are counted with a
+ * Fenwick tree over access timestamps, in which each address marks the
+ * timestamp of its last access. The timestamps are renumbered when they
+ * run out, so that the tree stays a fixed size too.
+ */
+class SampledStackDistCalc
+{
+  public:
+    /** Returned for the first access to a sampled address */
+    static constexpr uint64_t Infinity =
+        std::numeric_limits<uint64_t>::max();
+    /** Returned for the accesses to addresses that are not sampled */
+    static constexpr uint64_t NotSampled = Infinity - 1;
+
+    /**
+     * @param max_samples Maximum number of addresses tracked at a time
+     */
+    SampledStackDistCalc(unsigned max_samples);
+
+    /**
+     * Process an access to an address, usually a cache line address.
+     *
+     * @param addr The accessed address
+     * @return The estimated stack distance, Infinity or NotSampled
+     */
+    uint64_t calcStackDistAndUpdate(Addr addr);
+
+    /** The fraction of the addresses that are currently sampled */
+    double samplingRate() const;
+
+    /** Number of addresses currently tracked */
+    unsigned numSamples() const { return numTracked; }
+
+  private:
+    struct Slot
+    {
+        Addr addr;
+        uint64_t hash;
+        uint64_t time;
+    };
+
+    static constexpr Addr Empty = MaxAddr;
+
+    static uint64_t hashAddr(Addr addr);
+
+    /** Table index an address with the given hash would ideally be at */
+    size_t home(uint64_t hash) const { return hash >> tableShift; }
+
+    /** Find the slot of addr, or the empty slot it would go in */
+    size_t findSlot(Addr addr, uint64_t hash) const;
+
+    /** Remove the entry at a slot, closing the gap behind it */
+    void eraseSlot(size_t pos);
+
+    /** Fenwick tree primitives over the timestamps */
+    void addTime(uint64_t time, int delta);
+    uint64_t countUpTo(uint64_t time) const;
+
+    /** Take a new timestamp, renumbering the existing ones if needed */
+    uint64_t newTime();
+
+    /** Drop the sampled address with the largest hash */
+    void evict();
+
+    const unsigned maxSamples;
+
+    /** Addresses with a hash at or above this are not sampled */
+    uint64_t threshold;
+
+    std::vector<Slot> table;
+    size_t tableMask;
+    unsigned tableShift;
+    unsigned numTracked;
+
+    /** Max heap of the (hash, address) of the sampled addresses */
+    std::vector<std::pair<uint64_t, Addr>> heap;
+
+    /** Fenwick tree, indexed by timestamps starting at one */
+    std::vector<uint32_t> tree;
+    uint64_t nextTime;
+};
+
+} // namespace gem5
+
+#endif //__MEM_SAMPLED_STACK_DIST_HH__
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+
+#include "mem/sampled_stack_dist.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Reference LRU stack distance */
+class ExactStackDist
+{
+  public:
+    uint64_t
+    calc(Addr addr)
+    {
+        uint64_t dist = 0;
+        for (auto it = stack.begin(); it != stack.end(); ++it, ++dist) {
+            if (*it == addr) {
+                stack.erase(it);
+                stack.push_front(addr);
+                return dist;
+            }
+        }
+        stack.push_front(addr);
+        return SampledStackDistCalc::Infinity;
+    }
+
+  private:
+    std::list<Addr> stack;
+};
+
+} // anonymous namespace
+
+/** With room for all the addresses, every access is sampled exactly */
+TEST(SampledStackDistTest, ExactWhenNotFull)
+{
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<Addr> line(0, 499);
+
+    SampledStackDistCalc calc(1024);
+    ExactStackDist exact;
+    // Long enough for the timestamps to be renumbered a few times
+    for (int i = 0; i < 20000; i++) {
+        const Addr addr = line(rng) * 64;
+        ASSERT_EQ(calc.calcStackDistAndUpdate(addr), exact.calc(addr));
+    }
+    EXPECT_EQ(calc.numSamples(), 500);
+}
+
+/** Over budget, the sample stays bounded and the estimate stays close */
+TEST(SampledStackDistTest, BoundedEstimate)
+{
+    const unsigned num_lines = 20000;
+    SampledStackDistCalc calc(256);
+
+    // Cyclic accesses, every reuse has a distance of num_lines - 1
+    double total = 0;
+    unsigned reuses = 0;
+    for (int pass = 0; pass < 4; pass++) {
+        for (Addr line = 0; line < num_lines; line++) {
+            const uint64_t dist = calc.calcStackDistAndUpdate(line * 64);
+            ASSERT_LE(calc.numSamples(), 256);
+            if (pass > 0 && dist != SampledStackDistCalc::NotSampled) {
+                ASSERT_NE(dist, SampledStackDistCalc::Infinity);
+                total += dist;
+                reuses++;
+            }
+        }
+    }
+
+    EXPECT_LT(calc.samplingRate(), 256.0 / num_lines * 1.5);
+    ASSERT_GT(reuses, 0);
+    EXPECT_NEAR(total / reuses, num_lines - 1, 0.2 * num_lines);
+}
@@ -90,6 +90,15 @@ SimpleMemory::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &_backdoor)
     return latency;
 }
 
+void
+SimpleMemory::recvMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &_backdoor)
+{
+    // Accesses are performed on the backing store as soon as they are
+    // received, so it is always up to date
+    getBackdoor(_backdoor);
+}
+
 void
 SimpleMemory::recvFunctional(PacketPtr pkt)
 {
@@ -294,6 +303,13 @@ SimpleMemory::MemoryPort::recvFunctional(PacketPtr pkt)
     mem.recvFunctional(pkt);
 }
 
+void
+SimpleMemory::MemoryPort::recvMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &_backdoor)
+{
+    mem.recvMemBackdoorReq(req, _backdoor);
+}
+
 bool
 SimpleMemory::MemoryPort::recvTimingReq(PacketPtr pkt)
 {
@@ -73,6 +73,7 @@ class InPortDeclAST(DeclAST):
         self.pairs["buffer_expr"] = self.var_expr
         in_port = Var(self.symtab, self.ident, self.location, type, str(code),
                       self.pairs, machine)
+        in_port["queue_type"] = queue_type.ident
         symtab.newSymbol(in_port)
 
         symtab.pushFrame()
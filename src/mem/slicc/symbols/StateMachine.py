@@ -63,6 +63,7 @@ python_class_map = {
                     "MessageBuffer": "MessageBuffer",
                     "DMASequencer": "DMASequencer",
                     "RubyPrefetcher":"RubyPrefetcher",
+                    "prefetch::Base":"BasePrefetcher",
                     "Cycles":"Cycles",
                    }
 
@@ -157,6 +158,12 @@ class StateMachine(Symbol):
         self.symtab.registerSym(str(func), func)
         self.functions.append(func)
 
+    def profilesTransactions(self):
+        # Machines profile transactions through the AbstractController
+        # functions, which they declare to call them
+        names = ("incomingTransactionStart", "outgoingTransactionStart")
+        return any(func.c_name in names for func in self.functions)
+
     def addObject(self, obj):
         self.symtab.registerSym(str(obj), obj)
         self.objects.append(obj)
@@ -224,6 +231,12 @@ class StateMachine(Symbol):
                 in_msg_bufs[buf_name].append(port)
         return port_to_buf_map, in_msg_bufs, msg_bufs
 
+    def hasReadyFlag(self, port, port_to_buf_map):
+        '''True if the message buffer of the in_port has a bit in the
+        ready mask. In_ports on other queue types are always visited.'''
+        return port["queue_type"] == "MessageBuffer" and \
+            port_to_buf_map[port] < 64
+
     def writeCodeFiles(self, path, includes):
         self.printControllerPython(path)
         self.printControllerHH(path)
@@ -349,9 +362,10 @@ private:
         # added by SS
         for param in self.config_parameters:
             if param.pointer:
-                code('${{param.type_ast.type}}* m_${{param.ident}}_ptr;')
+                code('${{param.type_ast.type.c_ident}}* '
+                     'm_${{param.ident}}_ptr;')
             else:
-                code('${{param.type_ast.type}} m_${{param.ident}};')
+                code('${{param.type_ast.type.c_ident}} m_${{param.ident}};')
 
         code('''
 TransitionResult doTransition(${ident}_Event event,
@@ -392,8 +406,8 @@ ${ident}_State m_curTransitionNextState;
 ${ident}_Event curTransitionEvent() { return m_curTransitionEvent; }
 ${ident}_State curTransitionNextState() { return m_curTransitionNextState; }
 
-int m_counters[${ident}_State_NUM][${ident}_Event_NUM];
-int m_event_counters[${ident}_Event_NUM];
+uint64_t m_counters[${ident}_State_NUM][${ident}_Event_NUM];
+uint64_t m_event_counters[${ident}_Event_NUM];
 bool m_possible[${ident}_State_NUM][${ident}_Event_NUM];
 
 static std::vector<statistics::Vector *> eventVec;
@@ -698,6 +712,14 @@ $c_ident::init()
             # Set the queue consumers
             code('${{port.code}}.setConsumer(this);')
 
+        # Let the message buffers flag themselves in the ready mask
+        port_to_buf_map, in_msg_bufs, msg_bufs = self.getBufferMaps(ident)
+        for ports in in_msg_bufs.values():
+            port = ports[0]
+            if self.hasReadyFlag(port, port_to_buf_map):
+                code('${{port.code}}.setReadyFlag(&m_ready_buffers, '
+                     '${{port_to_buf_map[port]}});')
+
         # Initialize the transition profiling
         code()
         for trans in self.transitions:
@@ -853,6 +875,12 @@ $c_ident::regStats()
 
             for (${ident}_Event event = ${ident}_Event_FIRST;
                  event < ${ident}_Event_NUM; ++event) {
+                // Transitions that are not possible are never counted
+                if (!m_possible[state][event]) {
+                    transVec[state].push_back(nullptr);
+                    continue;
+                }
+
                 std::string stat_name = "${c_ident}." +
                     ${ident}_State_to_string(state) +
                     "." + ${ident}_Event_to_string(event);
@@ -865,6 +893,13 @@ $c_ident::regStats()
             }
         }
     }
+''')
+
+        # The transaction latency histograms are only allocated for the
+        # machines that profile transactions, as there is one for every
+        # combination of event, initial state and final state.
+        if self.profilesTransactions():
+            code('''
 
     for (${ident}_Event event = ${ident}_Event_FIRST;
                  event < ${ident}_Event_NUM; ++event) {
@@ -916,20 +951,45 @@ $c_ident::regStats()
             }
         }
     }
+''')
+
+        code('''
+
+    if (m_profile_transitions) {
+        stats.transHostTime.resize(${ident}_State_NUM * ${ident}_Event_NUM,
+                                   nullptr);
+''')
+        code.indent(2)
+        for trans in self.transitions:
+            state = "%s_State_%s" % (self.ident, trans.state.ident)
+            event = "%s_Event_%s" % (self.ident, trans.event.ident)
+            code('''
+stats.transHostTime[$state * ${ident}_Event_NUM + $event] =
+    new statistics::Scalar(&stats,
+        "transHostTime.${{trans.state.ident}}.${{trans.event.ident}}",
+        "Host time spent in the transition (ns)");
+''')
+        code.dedent(2)
+        code('''
+    }
 }
 
 void
 $c_ident::collateStats()
 {
+    RubySystem *rs = params().ruby_system;
+    std::vector<$c_ident *> cntrls(m_num_controllers);
+    for (unsigned int i = 0; i < m_num_controllers; ++i) {
+        std::map<uint32_t, AbstractController *>::iterator it =
+                 rs->m_abstract_controls[MachineType_${ident}].find(i);
+        assert(it != rs->m_abstract_controls[MachineType_${ident}].end());
+        cntrls[i] = ($c_ident *)(*it).second;
+    }
+
     for (${ident}_Event event = ${ident}_Event_FIRST;
          event < ${ident}_Event_NUM; ++event) {
         for (unsigned int i = 0; i < m_num_controllers; ++i) {
-            RubySystem *rs = params().ruby_system;
-            std::map<uint32_t, AbstractController *>::iterator it =
-                     rs->m_abstract_controls[MachineType_${ident}].find(i);
-            assert(it != rs->m_abstract_controls[MachineType_${ident}].end());
-            (*eventVec[event])[i] =
-                (($c_ident *)(*it).second)->getEventCount(event);
+            (*eventVec[event])[i] = cntrls[i]->getEventCount(event);
         }
     }
 
@@ -938,14 +998,12 @@ $c_ident::collateStats()
 
         for (${ident}_Event event = ${ident}_Event_FIRST;
              event < ${ident}_Event_NUM; ++event) {
+            if (!transVec[state][event])
+                continue;
 
             for (unsigned int i = 0; i < m_num_controllers; ++i) {
-                RubySystem *rs = params().ruby_system;
-                std::map<uint32_t, AbstractController *>::iterator it =
-                         rs->m_abstract_controls[MachineType_${ident}].find(i);
-                assert(it != rs->m_abstract_controls[MachineType_${ident}].end());
                 (*transVec[state][event])[i] =
-                    (($c_ident *)(*it).second)->getTransitionCount(state, event);
+                    cntrls[i]->getTransitionCount(state, event);
             }
         }
     }
@@ -1317,6 +1375,12 @@ ${ident}_Controller::wakeup()
                 code('m_cur_in_port = ${{port.pairs["rank"]}};')
             else:
                 code('m_cur_in_port = 0;')
+            ready_flag = self.hasReadyFlag(port, port_to_buf_map)
+            if ready_flag:
+                # Nothing to do for this port if its buffer is empty
+                code('if (m_ready_buffers & '
+                     '(1ULL << ${{port_to_buf_map[port]}})) {')
+                code.indent()
             if port in port_to_buf_map:
                 code('try {')
                 code.indent()
@@ -1329,6 +1393,9 @@ ${ident}_Controller::wakeup()
                 rejected[${{port_to_buf_map[port]}}]++;
             }
 ''')
+            if ready_flag:
+                code.dedent()
+                code('}')
             code.dedent()
             code('')
 
@@ -1363,16 +1430,119 @@ ${ident}_Controller::wakeup()
 
         code.write(path, "%s_Wakeup.cc" % self.ident)
 
+    def transitionCases(self):
+        '''Return the unique code blocks of the transitions, the code block
+        and next state of each (state, event) pair, and whether any
+        transition uses getNextState()'''
+
+        ident = self.ident
+
+        # The next state of a transition is looked up in the table, so the
+        # code blocks only hold the checks and actions. This map will allow
+        # suppress generating duplicate code
+        cases = OrderedDict()
+        table = {}
+        wildcard = False
+
+        for trans in self.transitions:
+            case_string = "%s, %s" % (trans.state.ident, trans.event.ident)
+
+            if trans.nextState.isWildcard():
+                # When * is encountered as an end state of a transition,
+                # the next state is determined by calling the
+                # machine-specific getNextState function. The next state
+                # is determined before any actions of the transition
+                # execute, and therefore the next state calculation cannot
+                # depend on any of the transitionactions.
+                next_state = "%s_State_NUM" % self.ident
+                wildcard = True
+            else:
+                next_state = "%s_State_%s" % (self.ident,
+                                              trans.nextState.ident)
+
+            case = self.symtab.codeFormatter()
+            actions = trans.actions
+            request_types = trans.request_types
+
+            # Check for resources
+            case_sorter = []
+            res = trans.resources
+            for key,val in res.items():
+                val = '''
+if (!%s.areNSlotsAvailable(%s, clockEdge()))
+    return TransitionResult_ResourceStall;
+''' % (key.code, val)
+                case_sorter.append(val)
+
+            # Check all of the request_types for resource constraints
+            for request_type in request_types:
+                val = '''
+if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
+    return TransitionResult_ResourceStall;
+}
+''' % (self.ident, request_type.ident)
+                case_sorter.append(val)
+
+            # Emit the code sequences in a sorted order.  This makes the
+            # output deterministic (without this the output order can vary
+            # since Map's keys() on a vector of pointers is not deterministic
+            for c in sorted(case_sorter):
+                case("$c")
+
+            # Record access types for this transition
+            for request_type in request_types:
+                case('recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);')
+
+            # Figure out if we stall
+            stall = False
+            for action in actions:
+                if action.ident == "z_stall":
+                    stall = True
+                    break
+
+            if stall:
+                case('return TransitionResult_ProtocolStall;')
+            else:
+                if self.TBEType != None and self.EntryType != None:
+                    for action in actions:
+                        case('${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);')
+                elif self.TBEType != None:
+                    for action in actions:
+                        case('${{action.ident}}(m_tbe_ptr, addr);')
+                elif self.EntryType != None:
+                    for action in actions:
+                        case('${{action.ident}}(m_cache_entry_ptr, addr);')
+                else:
+                    for action in actions:
+                        case('${{action.ident}}(addr);')
+                case('return TransitionResult_Valid;')
+
+            case = str(case)
+
+            # Look to see if this transition code is unique. Code block 0
+            # marks the invalid transitions.
+            if case not in cases:
+                cases[case] = (len(cases) + 1, [])
+
+            cases[case][1].append(case_string)
+            table[(trans.state.ident, trans.event.ident)] = \
+                (cases[case][0], next_state)
+
+        return cases, table, wildcard
+
     def printCSwitch(self, path):
         '''Output switch statement for transition table'''
 
         code = self.symtab.codeFormatter()
         ident = self.ident
+        cases, table, wildcard = self.transitionCases()
 
         code('''
 // ${ident}: ${{self.short}}
 
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -1395,6 +1565,41 @@ namespace gem5
 namespace ruby
 {
 
+namespace
+{
+
+/**
+ * Dense transition table, indexed by state and event. It holds the code
+ * block of the transition, 0 for the invalid transitions, and the next
+ * state, ${ident}_State_NUM when getNextState() gives the next state.
+ */
+struct ${ident}_TransitionEntry
+{
+    uint16_t code;
+    ${ident}_State nextState;
+};
+
+''')
+        code('constexpr ${ident}_TransitionEntry ${ident}_transitionTable'
+             '[${ident}_State_NUM][${ident}_Event_NUM] = {')
+        code.indent()
+        for state in self.states.values():
+            code('// ${{state.ident}}')
+            code('{')
+            code.indent()
+            for event in self.events.values():
+                entry = table.get((state.ident, event.ident))
+                if entry is None:
+                    entry = (0, "%s_State_%s" % (self.ident, state.ident))
+                code('{ ${{entry[0]}}, ${{entry[1]}} }, // ${{event.ident}}')
+            code.dedent()
+            code('},')
+        code.dedent()
+        code('''
+};
+
+} // anonymous namespace
+
 TransitionResult
 ${ident}_Controller::doTransition(${ident}_Event event,
 ''')
@@ -1428,16 +1633,27 @@ DPRINTF(RubyGenerated, "%s, Time: %lld, state: %s, event: %s, addr: %#x\\n",
         *this, curCycle(), ${ident}_State_to_string(state),
         ${ident}_Event_to_string(event), addr);
 
-TransitionResult result =
+TransitionResult result;
 ''')
         if self.TBEType != None and self.EntryType != None:
-            code('doTransitionWorker(event, state, next_state, m_tbe_ptr, m_cache_entry_ptr, addr);')
+            worker = 'doTransitionWorker(event, state, next_state, m_tbe_ptr, m_cache_entry_ptr, addr);'
         elif self.TBEType != None:
-            code('doTransitionWorker(event, state, next_state, m_tbe_ptr, addr);')
+            worker = 'doTransitionWorker(event, state, next_state, m_tbe_ptr, addr);'
         elif self.EntryType != None:
-            code('doTransitionWorker(event, state, next_state, m_cache_entry_ptr, addr);')
+            worker = 'doTransitionWorker(event, state, next_state, m_cache_entry_ptr, addr);'
         else:
-            code('doTransitionWorker(event, state, next_state, addr);')
+            worker = 'doTransitionWorker(event, state, next_state, addr);'
+        code('''
+if (m_profile_transitions) {
+    auto start = std::chrono::steady_clock::now();
+    result = $worker
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    *stats.transHostTime[HASH_FUN(state, event)] +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+} else {
+    result = $worker
+}
+''')
 
         port_to_buf_map, in_msg_bufs, msg_bufs = self.getBufferMaps(ident)
 
@@ -1512,105 +1728,31 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
                                         Addr addr)
 {
     m_curTransitionEvent = event;
-    m_curTransitionNextState = next_state;
-    switch(HASH_FUN(state, event)) {
+    const ${ident}_TransitionEntry &entry = ${ident}_transitionTable[state][event];
 ''')
 
-        # This map will allow suppress generating duplicate code
-        cases = OrderedDict()
-
-        for trans in self.transitions:
-            case_string = "%s_State_%s, %s_Event_%s" % \
-                (self.ident, trans.state.ident, self.ident, trans.event.ident)
-
-            case = self.symtab.codeFormatter()
-            # Only set next_state if it changes
-            if trans.state != trans.nextState:
-                if trans.nextState.isWildcard():
-                    # When * is encountered as an end state of a transition,
-                    # the next state is determined by calling the
-                    # machine-specific getNextState function. The next state
-                    # is determined before any actions of the transition
-                    # execute, and therefore the next state calculation cannot
-                    # depend on any of the transitionactions.
-                    case('next_state = getNextState(addr); '
-                         'm_curTransitionNextState = next_state;')
-                else:
-                    ns_ident = trans.nextState.ident
-                    case('next_state = ${ident}_State_${ns_ident}; '
-                         'm_curTransitionNextState = next_state;')
-
-            actions = trans.actions
-            request_types = trans.request_types
-
-            # Check for resources
-            case_sorter = []
-            res = trans.resources
-            for key,val in res.items():
-                val = '''
-if (!%s.areNSlotsAvailable(%s, clockEdge()))
-    return TransitionResult_ResourceStall;
-''' % (key.code, val)
-                case_sorter.append(val)
-
-            # Check all of the request_types for resource constraints
-            for request_type in request_types:
-                val = '''
-if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
-    return TransitionResult_ResourceStall;
-}
-''' % (self.ident, request_type.ident)
-                case_sorter.append(val)
-
-            # Emit the code sequences in a sorted order.  This makes the
-            # output deterministic (without this the output order can vary
-            # since Map's keys() on a vector of pointers is not deterministic
-            for c in sorted(case_sorter):
-                case("$c")
-
-            # Record access types for this transition
-            for request_type in request_types:
-                case('recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);')
-
-            # Figure out if we stall
-            stall = False
-            for action in actions:
-                if action.ident == "z_stall":
-                    stall = True
-                    break
-
-            if stall:
-                case('return TransitionResult_ProtocolStall;')
-            else:
-                if self.TBEType != None and self.EntryType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);')
-                elif self.TBEType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_tbe_ptr, addr);')
-                elif self.EntryType != None:
-                    for action in actions:
-                        case('${{action.ident}}(m_cache_entry_ptr, addr);')
-                else:
-                    for action in actions:
-                        case('${{action.ident}}(addr);')
-                case('return TransitionResult_Valid;')
-
-            case = str(case)
-
-            # Look to see if this transition code is unique.
-            if case not in cases:
-                cases[case] = []
+        if wildcard:
+            code('''
+    if (entry.nextState == ${ident}_State_NUM)
+        next_state = getNextState(addr);
+    else
+        next_state = entry.nextState;
+''')
+        else:
+            code('    next_state = entry.nextState;')
+        code('''
+    m_curTransitionNextState = next_state;
 
-            cases[case].append(case_string)
+    switch (entry.code) {
+''')
 
         # Walk through all of the unique code blocks and spit out the
         # corresponding case statement elements
-        for case,transitions in cases.items():
-            # Iterative over all the multiple transitions that share
-            # the same code
+        for case,(index,transitions) in cases.items():
+            # List the multiple transitions that share the same code
+            code('  case $index:')
             for trans in transitions:
-                code('  case HASH_FUN($trans):')
+                code('    // $trans')
             code('    $case\n')
 
         code('''
@@ -63,13 +63,12 @@ class Type(Symbol):
         super().__init__(table, ident, location, pairs)
         self.c_ident = ident
         self.abstract_ident = ""
-        if machine:
-            if self.isExternal or self.isPrimitive:
-                if "external_name" in self:
-                    self.c_ident = self["external_name"]
-            else:
-                # Append with machine name
-                self.c_ident = "%s_%s" % (machine, ident)
+        if self.isExternal or self.isPrimitive:
+            if "external_name" in self:
+                self.c_ident = self["external_name"]
+        elif machine:
+            # Append with machine name
+            self.c_ident = "%s_%s" % (machine, ident)
 
         self.pairs.setdefault("desc", "No description avaliable")
 
@@ -297,7 +296,7 @@ $klass ${{self.c_ident}}$parent
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return createMessage<${{self.c_ident}}>(*this);
 }
 ''')
         else:
@@ -52,6 +52,104 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+namespace
+{
+
+/** Number of slots the table starts out with. */
+const size_t InitialSlots = 1024;
+
+} // anonymous namespace
+
+SnoopFilter::SnoopFilterCache::SnoopFilterCache()
+    : slots(InitialSlots, value_type{EmptySlot, SnoopItem()}),
+      slotMask(InitialSlots - 1), used(0), erased(0), numRebuilds(0)
+{
+}
+
+size_t
+SnoopFilter::SnoopFilterCache::slotIndex(Addr addr) const
+{
+    // Line addresses have their lower bits cleared, so mix the whole
+    // address into the bits selecting the slot
+    uint64_t hash = addr * 0x9e3779b97f4a7c15ULL;
+    return (hash ^ (hash >> 32)) & slotMask;
+}
+
+SnoopFilter::SnoopFilterCache::iterator
+SnoopFilter::SnoopFilterCache::find(Addr addr)
+{
+    for (size_t i = slotIndex(addr); ; i = (i + 1) & slotMask) {
+        if (slots[i].first == addr)
+            return &slots[i];
+        if (slots[i].first == EmptySlot)
+            return end();
+    }
+}
+
+std::pair<SnoopFilter::SnoopFilterCache::iterator, bool>
+SnoopFilter::SnoopFilterCache::emplace(Addr addr, const SnoopItem &item)
+{
+    assert(addr != EmptySlot && addr != ErasedSlot);
+
+    iterator it = find(addr);
+    if (it != end())
+        return std::make_pair(it, false);
+
+    // Keep at least a quarter of the slots empty so that the probe
+    // sequences stay short, and grow once half of them are in use
+    if ((used + erased + 1) * 4 > slots.size() * 3) {
+        rebuild((used + 1) * 2 > slots.size() ?
+                slots.size() * 2 : slots.size());
+    }
+
+    size_t i = slotIndex(addr);
+    while (slots[i].first != EmptySlot && slots[i].first != ErasedSlot)
+        i = (i + 1) & slotMask;
+
+    if (slots[i].first == ErasedSlot)
+        erased--;
+    used++;
+    slots[i].first = addr;
+    slots[i].second = item;
+    return std::make_pair(&slots[i], true);
+}
+
+void
+SnoopFilter::SnoopFilterCache::erase(iterator it)
+{
+    assert(it >= slots.data() && it < slots.data() + slots.size());
+    size_t next = (it - slots.data() + 1) & slotMask;
+    // A tombstone is only needed while a probe sequence continues
+    // past this slot
+    if (slots[next].first == EmptySlot) {
+        it->first = EmptySlot;
+    } else {
+        it->first = ErasedSlot;
+        erased++;
+    }
+    used--;
+}
+
+void
+SnoopFilter::SnoopFilterCache::rebuild(size_t num_slots)
+{
+    std::vector<value_type> old_slots(num_slots,
+                                      value_type{EmptySlot, SnoopItem()});
+    old_slots.swap(slots);
+    slotMask = num_slots - 1;
+    erased = 0;
+    numRebuilds++;
+
+    for (const auto &slot : old_slots) {
+        if (slot.first == EmptySlot || slot.first == ErasedSlot)
+            continue;
+        size_t i = slotIndex(slot.first);
+        while (slots[i].first != EmptySlot)
+            i = (i + 1) & slotMask;
+        slots[i] = slot;
+    }
+}
+
 void
 SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
 {
@@ -63,9 +161,23 @@ SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
     }
 }
 
-std::pair<SnoopFilter::SnoopList, Cycles>
-SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
-                           cpu_side_port)
+SnoopFilter::SnoopFilterCache::iterator
+SnoopFilter::allocateEntry(Addr line_addr)
+{
+    const bool pending = reqLookupResult.it != cachedLocations.end();
+    const Addr pending_addr = pending ? reqLookupResult.it->first : 0;
+    const uint64_t rebuilds = cachedLocations.rebuilds();
+
+    auto sf_it = cachedLocations.emplace(line_addr, SnoopItem()).first;
+
+    if (pending && cachedLocations.rebuilds() != rebuilds)
+        reqLookupResult.it = cachedLocations.find(pending_addr);
+    return sf_it;
+}
+
+std::pair<SnoopFilter::SnoopMask, Cycles>
+SnoopFilter::lookupRequestMask(const Packet* cpkt, const ResponsePort&
+                               cpu_side_port)
 {
     DPRINTF(SnoopFilter, "%s: src %s packet %s\n", __func__,
             cpu_side_port.name(), cpkt->print());
@@ -85,12 +197,11 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
     // do not create a new snoop filter entry, simply return a NULL
     // portlist.
     if (!is_hit && !allocate)
-        return snoopDown(lookupLatency);
+        return std::make_pair(SnoopMask(), lookupLatency);
 
     // If no hit in snoop filter create a new element and update iterator
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        reqLookupResult.it = allocateEntry(line_addr);
     }
     SnoopItem& sf_item = reqLookupResult.it->second;
     SnoopMask interested = sf_item.holder | sf_item.requested;
@@ -113,8 +224,7 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 
     // If we are not allocating, we are done
     if (!allocate)
-        return snoopSelected(maskToPortList(interested & ~req_port),
-                             lookupLatency);
+        return std::make_pair(interested & ~req_port, lookupLatency);
 
     if (cpkt->needsResponse()) {
         if (!cpkt->cacheResponding()) {
@@ -153,7 +263,7 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         }
     }
 
-    return snoopSelected(maskToPortList(interested & ~req_port), lookupLatency);
+    return std::make_pair(interested & ~req_port, lookupLatency);
 }
 
 void
@@ -179,11 +289,12 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
         }
 
         eraseIfNullEntry(reqLookupResult.it);
+        reqLookupResult.it = cachedLocations.end();
     }
 }
 
-std::pair<SnoopFilter::SnoopList, Cycles>
-SnoopFilter::lookupSnoop(const Packet* cpkt)
+std::pair<SnoopFilter::SnoopMask, Cycles>
+SnoopFilter::lookupSnoopMask(const Packet* cpkt)
 {
     DPRINTF(SnoopFilter, "%s: packet %s\n", __func__, cpkt->print());
 
@@ -204,7 +315,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     // portlist, there is no point creating an entry only to remove it
     // later
     if (!is_hit)
-        return snoopDown(lookupLatency);
+        return std::make_pair(SnoopMask(), lookupLatency);
 
     SnoopItem& sf_item = sf_it->second;
 
@@ -239,7 +350,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         eraseIfNullEntry(sf_it);
     }
 
-    return snoopSelected(maskToPortList(interested), lookupLatency);
+    return std::make_pair(interested, lookupLatency);
 }
 
 void
@@ -266,7 +377,10 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    auto sf_it = cachedLocations.find(line_addr);
+    if (sf_it == cachedLocations.end())
+        sf_it = allocateEntry(line_addr);
+    SnoopItem& sf_item = sf_it->second;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -44,8 +44,8 @@
 #define __MEM_SNOOP_FILTER_HH__
 
 #include <bitset>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
@@ -95,6 +95,13 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
+    /**
+     * The underlying type for the bitmask we use for tracking. This
+     * limits the number of snooping ports supported per crossbar.
+     * Bit i of a mask corresponds to snoopPort(i).
+     */
+    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
+
     SnoopFilter (const SnoopFilterParams &p) :
         SimObject(p), reqLookupResult(cachedLocations.end()),
         linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
@@ -139,8 +146,19 @@ class SnoopFilter : public SimObject
      * @param cpu_side_port     Response port where the request came from.
      * @return Pair of a vector of snoop target ports and lookup latency.
      */
-    std::pair<SnoopList, Cycles> lookupRequest(const Packet* cpkt,
-                                        const ResponsePort& cpu_side_port);
+    std::pair<SnoopList, Cycles>
+    lookupRequest(const Packet* cpkt, const ResponsePort& cpu_side_port)
+    {
+        auto res = lookupRequestMask(cpkt, cpu_side_port);
+        return snoopSelected(maskToPortList(res.first), res.second);
+    }
+
+    /**
+     * Same as lookupRequest, but return the snoop targets as a mask
+     * rather than building a list of ports.
+     */
+    std::pair<SnoopMask, Cycles> lookupRequestMask(const Packet* cpkt,
+        const ResponsePort& cpu_side_port);
 
     /**
      * For an un-successful request, revert the change to the snoop
@@ -162,7 +180,25 @@ class SnoopFilter : public SimObject
      * @return Pair with a vector of ResponsePorts that need snooping and a
      * lookup latency.
      */
-    std::pair<SnoopList, Cycles> lookupSnoop(const Packet* cpkt);
+    std::pair<SnoopList, Cycles>
+    lookupSnoop(const Packet* cpkt)
+    {
+        auto res = lookupSnoopMask(cpkt);
+        return snoopSelected(maskToPortList(res.first), res.second);
+    }
+
+    /**
+     * Same as lookupSnoop, but return the snoop targets as a mask
+     * rather than building a list of ports.
+     */
+    std::pair<SnoopMask, Cycles> lookupSnoopMask(const Packet* cpkt);
+
+    /** Number of snooping ports tracked, i.e. of valid mask bits. */
+    size_t numSnoopPorts() const { return cpuSidePorts.size(); }
+
+    /** Port corresponding to bit idx of a SnoopMask. */
+    QueuedResponsePort *snoopPort(size_t idx) const
+    { return cpuSidePorts[idx]; }
 
     /**
      * Let the snoop filter see any snoop responses that turn into
@@ -204,12 +240,6 @@ class SnoopFilter : public SimObject
 
   protected:
 
-    /**
-     * The underlying type for the bitmask we use for tracking. This
-     * limits the number of snooping ports supported per crossbar.
-     */
-    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
-
     /**
     * Per cache line item tracking a bitmask of ResponsePorts who have an
     * outstanding request to this line (requested) or already share a
@@ -220,10 +250,69 @@ class SnoopFilter : public SimObject
         SnoopMask requested;
         SnoopMask holder;
     };
+
     /**
-     * HashMap of SnoopItems indexed by line address
+     * Open-addressed hash table of SnoopItems indexed by line
+     * address. The items are stored in a flat array of slots, probed
+     * linearly, so that a lookup touches a contiguous range of memory
+     * and allocating an entry never allocates host memory unless the
+     * table has to grow. Erased entries are turned into tombstones,
+     * which keeps every live entry in place until the table is
+     * rebuilt by an insertion.
+     *
+     * The interface mirrors the subset of std::unordered_map used by
+     * the snoop filter, with plain pointers as iterators.
      */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
+    class SnoopFilterCache
+    {
+      public:
+        struct value_type
+        {
+            Addr first;
+            SnoopItem second;
+        };
+        typedef value_type *iterator;
+
+        SnoopFilterCache();
+
+        iterator end() const { return nullptr; }
+        size_t size() const { return used; }
+
+        /** Number of times the slots have been rebuilt. */
+        uint64_t rebuilds() const { return numRebuilds; }
+
+        iterator find(Addr addr);
+
+        /**
+         * Insert an item unless there is already one for this
+         * address. This may rebuild the table, and thus invalidate
+         * any other iterator.
+         *
+         * @return Iterator to the item, and whether it was inserted.
+         */
+        std::pair<iterator, bool> emplace(Addr addr, const SnoopItem &item);
+
+        void erase(iterator it);
+
+      private:
+        /** Slot markers, neither can be a (possibly secure) line address */
+        static constexpr Addr EmptySlot = MaxAddr;
+        static constexpr Addr ErasedSlot = MaxAddr - 1;
+
+        size_t slotIndex(Addr addr) const;
+
+        /** Re-insert all live entries into numSlots slots. */
+        void rebuild(size_t num_slots);
+
+        std::vector<value_type> slots;
+        /** Mask selecting a slot, the number of slots is a power of 2 */
+        size_t slotMask;
+        /** Number of live entries */
+        size_t used;
+        /** Number of tombstones */
+        size_t erased;
+        uint64_t numRebuilds;
+    };
 
     /**
      * Simple factory methods for standard return values.
@@ -263,6 +352,12 @@ class SnoopFilter : public SimObject
      */
     void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
 
+    /**
+     * Allocate an empty item for a line address, keeping the pending
+     * request lookup valid if the table had to be rebuilt.
+     */
+    SnoopFilterCache::iterator allocateEntry(Addr line_addr);
+
     /** Simple hash set of cached addresses. */
     SnoopFilterCache cachedLocations;
 
@@ -337,17 +432,20 @@ SnoopFilter::portToMask(const ResponsePort& port) const
 {
     assert(port.getId() != InvalidPortID);
     // if this is not a snooping port, return a zero mask
-    return !port.isSnooping() ? 0 :
-        ((SnoopMask)1) << localResponsePortIds[port.getId()];
+    SnoopMask mask;
+    if (port.isSnooping())
+        mask.set(localResponsePortIds[port.getId()]);
+    return mask;
 }
 
 inline SnoopFilter::SnoopList
 SnoopFilter::maskToPortList(SnoopMask port_mask) const
 {
+    // the local ids are handed out in the order of cpuSidePorts
     SnoopList res;
-    for (const auto& p : cpuSidePorts)
-        if ((port_mask & portToMask(*p)).any())
-            res.push_back(p);
+    for (size_t i = 0; i < cpuSidePorts.size(); ++i)
+        if (port_mask.test(i))
+            res.push_back(cpuSidePorts[i]);
     return res;
 }
 
@@ -0,0 +1,726 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definition of a two-tier memory that migrates pages between a near
+ * and a far memory.
+ */
+
+#include "mem/tiered_memory.hh"
+
+#include <algorithm>
+
+#include "base/cast.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/Drain.hh"
+#include "debug/TieredMemory.hh"
+#include "sim/serialize.hh"
+#include "sim/stats.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Near frames looked at when looking for a cold page. */
+constexpr uint32_t maxVictimScan = 64;
+
+/** Epochs after which a heat counter has decayed to zero. */
+constexpr uint32_t maxHeatAge = 8;
+
+} // anonymous namespace
+
+TieredMemory::CPUSidePort::CPUSidePort(const std::string &_name,
+                                       TieredMemory &_mem)
+    : ResponsePort(_name, &_mem), mem(_mem)
+{
+}
+
+TieredMemory::MemSidePort::MemSidePort(const std::string &_name,
+                                       TieredMemory &_mem, bool _far)
+    : RequestPort(_name, &_mem), mem(_mem), far(_far)
+{
+}
+
+TieredMemory::MemSideQueue::MemSideQueue(TieredMemory &_mem,
+                                         RequestPort &_mem_side_port)
+    : ReqPacketQueue(_mem, _mem_side_port), mem(_mem)
+{
+}
+
+TieredMemory::CPUSideQueue::CPUSideQueue(TieredMemory &_mem,
+                                         ResponsePort &_cpu_side_port)
+    : RespPacketQueue(_mem, _cpu_side_port), mem(_mem)
+{
+}
+
+TieredMemory::TieredMemoryStats::TieredMemoryStats(TieredMemory &mem)
+    : statistics::Group(&mem),
+      ADD_STAT(nearAccesses, statistics::units::Count::get(),
+               "Number of accesses to the near memory"),
+      ADD_STAT(farAccesses, statistics::units::Count::get(),
+               "Number of accesses to the far memory"),
+      ADD_STAT(migrations, statistics::units::Count::get(),
+               "Number of page swaps between the tiers"),
+      ADD_STAT(migratedBytes, statistics::units::Byte::get(),
+               "Number of bytes moved by page swaps, in both directions"),
+      ADD_STAT(migrationTicks, statistics::units::Tick::get(),
+               "Total time spent swapping pages"),
+      ADD_STAT(stalledReqs, statistics::units::Count::get(),
+               "Number of requests refused because of a page swap"),
+      ADD_STAT(stallTicks, statistics::units::Tick::get(),
+               "Total time requests waited for page swaps"),
+      ADD_STAT(migrationBandwidth, statistics::units::Rate<
+                    statistics::units::Byte, statistics::units::Second>::get(),
+               "Average bandwidth of the page swaps",
+               migratedBytes / simSeconds),
+      ADD_STAT(avgMigrationLatency, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average time to swap a pair of pages",
+               migrationTicks / migrations)
+{
+    avgMigrationLatency.precision(2);
+}
+
+TieredMemory::TieredMemory(const Params &p)
+    : SimObject(p),
+      cpuSidePort(name() + ".cpu_side_port", *this),
+      nearSidePort(name() + ".near_side_port", *this, false),
+      farSidePort(name() + ".far_side_port", *this, true),
+      respQueue(*this, cpuSidePort),
+      nearQueue(*this, nearSidePort),
+      farQueue(*this, farSidePort),
+      requestorId(p.system->getRequestorId(this)),
+      range(p.range), nearRange(p.near_range), farRange(p.far_range),
+      pageSize(p.page_size),
+      numNear(p.near_range.size() / p.page_size),
+      numFar(p.far_range.size() / p.page_size),
+      farLatency(p.far_latency), farBandwidth(p.far_bandwidth),
+      bufferSize(p.buffer_size), credits(p.buffer_size), retryReq(false),
+      farReqFreeAt(0), farRespFreeAt(0), nearLastSendAt(0),
+      epoch(0), sampleInterval(p.sample_interval), sampleCount(0),
+      hotThreshold(p.hot_threshold), clockHand(0), accessedInEpoch(false),
+      migrationInterval(p.migration_interval),
+      blockSize(p.migration_block_size),
+      maxOutstanding(p.migration_max_outstanding),
+      stallStart(MaxTick),
+      epochEvent([this]{ processEpochEvent(); }, name()),
+      stats(*this)
+{
+    fatal_if(range.interleaved() || nearRange.interleaved() ||
+             farRange.interleaved(), "%s: ranges must not be interleaved\n",
+             name());
+    fatal_if(!isPowerOf2(pageSize), "%s: page_size must be a power of 2\n",
+             name());
+    fatal_if(range.size() != nearRange.size() + farRange.size(),
+             "%s: range must be as large as near_range and far_range "
+             "together\n", name());
+    fatal_if(range.start() % pageSize || nearRange.start() % pageSize ||
+             farRange.start() % pageSize || nearRange.size() % pageSize ||
+             farRange.size() % pageSize,
+             "%s: ranges must be aligned to page_size\n", name());
+    fatal_if(blockSize == 0 || pageSize % blockSize,
+             "%s: migration_block_size must divide page_size\n", name());
+    fatal_if(bufferSize == 0 || sampleInterval == 0 || maxOutstanding == 0,
+             "%s: buffer_size, sample_interval and "
+             "migration_max_outstanding must be non-zero\n", name());
+
+    frameOf.resize(numPages());
+    pageAt.resize(numPages());
+    for (uint32_t page = 0; page < numPages(); page++) {
+        frameOf[page] = page;
+        pageAt[page] = page;
+    }
+
+    heat.resize(numPages(), 0);
+    heatEpoch.resize(numPages(), 0);
+    hotPage = numPages();
+
+    migration.data.resize(2 * pageSize);
+
+    // the credits bound the number of packets in the queues
+    respQueue.disableSanityCheck();
+    nearQueue.disableSanityCheck();
+    farQueue.disableSanityCheck();
+}
+
+Port &
+TieredMemory::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "cpu_side_port")
+        return cpuSidePort;
+    else if (if_name == "near_side_port")
+        return nearSidePort;
+    else if (if_name == "far_side_port")
+        return farSidePort;
+    else
+        return SimObject::getPort(if_name, idx);
+}
+
+void
+TieredMemory::init()
+{
+    if (!cpuSidePort.isConnected() || !nearSidePort.isConnected() ||
+        !farSidePort.isConnected())
+        fatal("All ports of a tiered memory must be connected.\n");
+
+    cpuSidePort.sendRangeChange();
+}
+
+DrainState
+TieredMemory::drain()
+{
+    if (credits == bufferSize && !migration.active) {
+        return DrainState::Drained;
+    } else {
+        DPRINTF(TieredMemory, "Not drained, %d requests in flight%s\n",
+                bufferSize - credits,
+                migration.active ? ", migrating" : "");
+        return DrainState::Draining;
+    }
+}
+
+void
+TieredMemory::serialize(CheckpointOut &cp) const
+{
+    SERIALIZE_CONTAINER(frameOf);
+}
+
+void
+TieredMemory::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_CONTAINER(frameOf);
+
+    fatal_if(frameOf.size() != numPages(), "%s: checkpoint has %d pages, "
+             "expected %d\n", name(), frameOf.size(), numPages());
+
+    for (uint32_t page = 0; page < numPages(); page++)
+        pageAt[frameOf[page]] = page;
+}
+
+uint32_t
+TieredMemory::pageOf(Addr addr) const
+{
+    assert(range.contains(addr));
+    return (addr - range.start()) / pageSize;
+}
+
+Addr
+TieredMemory::frameAddr(uint32_t frame) const
+{
+    return isFar(frame) ? farRange.start() + (frame - numNear) * pageSize :
+        nearRange.start() + frame * pageSize;
+}
+
+unsigned
+TieredMemory::heatOf(uint32_t page) const
+{
+    const uint32_t age = epoch - heatEpoch[page];
+    return age >= maxHeatAge ? 0 : heat[page] >> age;
+}
+
+bool
+TieredMemory::isMigrating(uint32_t page) const
+{
+    return migration.active &&
+        (page == migration.hotPage || page == migration.coldPage);
+}
+
+uint32_t
+TieredMemory::migrationTarget(uint32_t page) const
+{
+    assert(isMigrating(page));
+    return page == migration.hotPage ? frameOf[migration.coldPage] :
+        frameOf[migration.hotPage];
+}
+
+Tick
+TieredMemory::crossFarLink(Tick &free_at, Tick when, unsigned bytes)
+{
+    const Tick start = std::max(free_at, when);
+    free_at = start + bytes * farBandwidth;
+    return free_at + farLatency;
+}
+
+void
+TieredMemory::sendToFrame(PacketPtr pkt, uint32_t frame, Tick when)
+{
+    if (isFar(frame)) {
+        const unsigned bytes = pkt->hasData() ? pkt->getSize() : 0;
+        farQueue.schedSendTiming(pkt, crossFarLink(farReqFreeAt, when,
+                                                   bytes));
+    } else {
+        nearLastSendAt = std::max(nearLastSendAt, when);
+        nearQueue.schedSendTiming(pkt, when);
+    }
+}
+
+bool
+TieredMemory::recvTimingReq(PacketPtr pkt)
+{
+    DPRINTF(TieredMemory, "recvTimingReq: %s addr 0x%x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    const Addr orig_addr = pkt->getAddr();
+    const uint32_t page = pageOf(orig_addr);
+    panic_if(pageOf(orig_addr + pkt->getSize() - 1) != page,
+             "%s: %s addr 0x%x size %d crosses a page\n", name(),
+             pkt->cmdString(), orig_addr, pkt->getSize());
+
+    // as for the bridge, the CPU may send a new request after it has
+    // been told to retry, so simply refuse it
+    if (retryReq)
+        return false;
+
+    if (isMigrating(page)) {
+        DPRINTF(TieredMemory, "Page %d is migrating\n", page);
+        ++stats.stalledReqs;
+        if (stallStart == MaxTick)
+            stallStart = curTick();
+        retryReq = true;
+        return false;
+    }
+
+    if (credits == 0) {
+        DPRINTF(TieredMemory, "No credits left\n");
+        retryReq = true;
+        return false;
+    }
+    credits--;
+
+    sample(page);
+
+    const uint32_t frame = frameOf[page];
+    if (isFar(frame))
+        ++stats.farAccesses;
+    else
+        ++stats.nearAccesses;
+
+    if (pkt->needsResponse())
+        pkt->pushSenderState(new TierSenderState(orig_addr));
+    pkt->setAddr(frameAddr(frame) + (orig_addr - range.start()) % pageSize);
+
+    Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    sendToFrame(pkt, frame, curTick() + receive_delay);
+
+    // the epochs only run while there are timing accesses
+    accessedInEpoch = true;
+    if (!epochEvent.scheduled())
+        schedule(epochEvent, curTick() + migrationInterval);
+
+    return true;
+}
+
+bool
+TieredMemory::recvTimingResp(PacketPtr pkt, bool far)
+{
+    DPRINTF(TieredMemory, "recvTimingResp: %s addr 0x%x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    Tick when = curTick() + pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    if (far) {
+        const unsigned bytes = pkt->hasData() ? pkt->getSize() : 0;
+        when = crossFarLink(farRespFreeAt, when, bytes);
+    }
+
+    if (pkt->req->requestorId() == requestorId) {
+        if (when == curTick()) {
+            recvMigrationResp(pkt);
+        } else {
+            schedulePooled([this, pkt]{ recvMigrationResp(pkt); },
+                           "TieredMemory migration response", when);
+        }
+        return true;
+    }
+
+    auto *state = safe_cast<TierSenderState *>(pkt->popSenderState());
+    pkt->setAddr(state->origAddr);
+    delete state;
+
+    // the credit taken by the request guarantees space for the response
+    respQueue.schedSendTiming(pkt, when);
+    return true;
+}
+
+Tick
+TieredMemory::recvAtomic(PacketPtr pkt)
+{
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    const Addr orig_addr = pkt->getAddr();
+    const uint32_t page = pageOf(orig_addr);
+    panic_if(pageOf(orig_addr + pkt->getSize() - 1) != page,
+             "%s: %s addr 0x%x size %d crosses a page\n", name(),
+             pkt->cmdString(), orig_addr, pkt->getSize());
+
+    const uint32_t frame = frameOf[page];
+    pkt->setAddr(frameAddr(frame) + (orig_addr - range.start()) % pageSize);
+
+    Tick latency;
+    if (isFar(frame)) {
+        ++stats.farAccesses;
+        latency = farSidePort.sendAtomic(pkt) + 2 * farLatency +
+            pkt->getSize() * farBandwidth;
+    } else {
+        ++stats.nearAccesses;
+        latency = nearSidePort.sendAtomic(pkt);
+    }
+
+    pkt->setAddr(orig_addr);
+    return latency;
+}
+
+void
+TieredMemory::recvFunctional(PacketPtr pkt)
+{
+    pkt->pushLabel(name());
+
+    if (respQueue.trySatisfyFunctional(pkt)) {
+        pkt->popLabel();
+        pkt->makeResponse();
+        return;
+    }
+
+    const Addr orig_addr = pkt->getAddr();
+    const uint32_t page = pageOf(orig_addr);
+    const Addr offset = (orig_addr - range.start()) % pageSize;
+    panic_if(offset + pkt->getSize() > pageSize,
+             "%s: %s addr 0x%x size %d crosses a page\n", name(),
+             pkt->cmdString(), orig_addr, pkt->getSize());
+
+    uint32_t frame = frameOf[page];
+
+    // Once a migration is writing, the copy it holds is the content
+    // of its pages, and a write has to reach both the copy and the
+    // frame the page is moving to.
+    if (isMigrating(page) && migration.writing) {
+        uint8_t *copy = migration.data.data() + offset +
+            (page == migration.hotPage ? 0 : pageSize);
+        if (pkt->isRead()) {
+            pkt->setData(copy);
+            pkt->popLabel();
+            pkt->makeResponse();
+            return;
+        }
+        pkt->writeData(copy);
+        frame = migrationTarget(page);
+    }
+
+    MemSideQueue &queue = isFar(frame) ? farQueue : nearQueue;
+    MemSidePort &port = isFar(frame) ? farSidePort : nearSidePort;
+
+    pkt->setAddr(frameAddr(frame) + offset);
+    if (queue.trySatisfyFunctional(pkt)) {
+        pkt->makeResponse();
+    } else {
+        port.sendFunctional(pkt);
+    }
+    pkt->setAddr(orig_addr);
+
+    pkt->popLabel();
+}
+
+void
+TieredMemory::sample(uint32_t page)
+{
+    if (++sampleCount < sampleInterval)
+        return;
+    sampleCount = 0;
+
+    unsigned h = heatOf(page);
+    if (h < UINT8_MAX)
+        h++;
+    heat[page] = h;
+    heatEpoch[page] = epoch;
+
+    if (isFar(frameOf[page]) &&
+        (hotPage == numPages() || h > heatOf(hotPage))) {
+        hotPage = page;
+    }
+}
+
+void
+TieredMemory::processEpochEvent()
+{
+    if (!migration.active && hotPage != numPages() && numNear != 0 &&
+        isFar(frameOf[hotPage]) && heatOf(hotPage) >= hotThreshold &&
+        drainState() == DrainState::Running) {
+        const unsigned hot_heat = heatOf(hotPage);
+
+        // look for a near page that is neither hot nor as warm as the
+        // one replacing it
+        for (uint32_t i = 0; i < std::min(numNear, maxVictimScan); i++) {
+            const uint32_t page = pageAt[clockHand];
+            clockHand = (clockHand + 1) % numNear;
+
+            const unsigned h = heatOf(page);
+            if (h < hotThreshold && h < hot_heat) {
+                startMigration(hotPage, page);
+                break;
+            }
+        }
+    }
+
+    epoch++;
+    hotPage = numPages();
+
+    if (accessedInEpoch) {
+        accessedInEpoch = false;
+        schedule(epochEvent, curTick() + migrationInterval);
+    }
+}
+
+void
+TieredMemory::startMigration(uint32_t hot_page, uint32_t cold_page)
+{
+    DPRINTF(TieredMemory, "Swapping far page %d (frame %d) with near page "
+            "%d (frame %d)\n", hot_page, frameOf[hot_page], cold_page,
+            frameOf[cold_page]);
+
+    migration.active = true;
+    migration.writing = false;
+    migration.hotPage = hot_page;
+    migration.coldPage = cold_page;
+    migration.next = 0;
+    migration.outstanding = 0;
+    migration.done = 0;
+    migration.startTick = curTick();
+
+    issueMigration();
+}
+
+void
+TieredMemory::issueMigration()
+{
+    const unsigned page_blocks = pageSize / blockSize;
+
+    while (migration.outstanding < maxOutstanding &&
+           migration.next < 2 * page_blocks) {
+        const unsigned block = migration.next++;
+
+        // the first half of the blocks belong to the hot page, which
+        // is read from its far frame and written to the near frame of
+        // the cold page, and the second half the other way around
+        const bool hot = block < page_blocks;
+        const uint32_t page = hot ? migration.hotPage : migration.coldPage;
+        const uint32_t frame = migration.writing ? migrationTarget(page) :
+            frameOf[page];
+
+        RequestPtr req = Request::create(
+            frameAddr(frame) + (block % page_blocks) * blockSize,
+            blockSize, 0, requestorId);
+        PacketPtr pkt = new Packet(req, migration.writing ?
+                                   MemCmd::WriteReq : MemCmd::ReadReq);
+        pkt->allocate();
+        if (migration.writing)
+            pkt->setData(migration.data.data() + block * blockSize);
+
+        // queue behind any demand request to the same frames, so that
+        // they are seen by the copy, the far link being in order anyway
+        sendToFrame(pkt, frame, isFar(frame) ? curTick() :
+                    std::max(curTick(), nearLastSendAt));
+        migration.outstanding++;
+    }
+}
+
+void
+TieredMemory::recvMigrationResp(PacketPtr pkt)
+{
+    delete pkt;
+
+    assert(migration.active && migration.outstanding > 0);
+    migration.outstanding--;
+    migration.done++;
+
+    if (migration.done < 2 * (pageSize / blockSize)) {
+        issueMigration();
+        return;
+    }
+
+    if (migration.writing) {
+        finishMigration();
+        return;
+    }
+
+    // With the reads done, every write accepted before the migration
+    // started has reached the memory, so take the data as it is now.
+    for (const uint32_t page : {migration.hotPage, migration.coldPage}) {
+        const uint32_t frame = frameOf[page];
+        RequestPtr req = Request::create(frameAddr(frame), pageSize, 0,
+                                         requestorId);
+        Packet copy(req, MemCmd::ReadReq);
+        copy.dataStatic(migration.data.data() +
+                        (page == migration.hotPage ? 0 : pageSize));
+        (isFar(frame) ? farSidePort : nearSidePort).sendFunctional(&copy);
+    }
+
+    migration.writing = true;
+    migration.next = 0;
+    migration.done = 0;
+    issueMigration();
+}
+
+void
+TieredMemory::finishMigration()
+{
+    const uint32_t hot_frame = frameOf[migration.hotPage];
+    const uint32_t cold_frame = frameOf[migration.coldPage];
+
+    frameOf[migration.hotPage] = cold_frame;
+    frameOf[migration.coldPage] = hot_frame;
+    pageAt[cold_frame] = migration.hotPage;
+    pageAt[hot_frame] = migration.coldPage;
+
+    migration.active = false;
+
+    DPRINTF(TieredMemory, "Swapped pages %d and %d\n", migration.hotPage,
+            migration.coldPage);
+
+    ++stats.migrations;
+    stats.migratedBytes += 2 * pageSize;
+    stats.migrationTicks += curTick() - migration.startTick;
+
+    if (stallStart != MaxTick) {
+        stats.stallTicks += curTick() - stallStart;
+        stallStart = MaxTick;
+    }
+
+    if (retryReq) {
+        retryReq = false;
+        cpuSidePort.sendRetryReq();
+    }
+
+    checkDrainDone();
+}
+
+void
+TieredMemory::returnCredit()
+{
+    assert(credits < bufferSize);
+    credits++;
+
+    // a request waiting for a migration is retried once it is done
+    if (retryReq && stallStart == MaxTick) {
+        DPRINTF(TieredMemory, "Credit returned, now retrying\n");
+        retryReq = false;
+        cpuSidePort.sendRetryReq();
+    }
+
+    checkDrainDone();
+}
+
+void
+TieredMemory::checkDrainDone()
+{
+    if (drainState() == DrainState::Draining && credits == bufferSize &&
+        !migration.active) {
+        DPRINTF(Drain, "TieredMemory done draining\n");
+        signalDrainDone();
+    }
+}
+
+bool
+TieredMemory::MemSideQueue::sendTiming(PacketPtr pkt)
+{
+    // the packet may be gone once it is sent
+    const bool needs_response = pkt->needsResponse();
+
+    if (!ReqPacketQueue::sendTiming(pkt))
+        return false;
+
+    if (!needs_response)
+        mem.returnCredit();
+    return true;
+}
+
+bool
+TieredMemory::CPUSideQueue::sendTiming(PacketPtr pkt)
+{
+    if (!RespPacketQueue::sendTiming(pkt))
+        return false;
+
+    mem.returnCredit();
+    return true;
+}
+
+bool
+TieredMemory::CPUSidePort::recvTimingReq(PacketPtr pkt)
+{
+    return mem.recvTimingReq(pkt);
+}
+
+void
+TieredMemory::CPUSidePort::recvRespRetry()
+{
+    mem.respQueue.retry();
+}
+
+Tick
+TieredMemory::CPUSidePort::recvAtomic(PacketPtr pkt)
+{
+    return mem.recvAtomic(pkt);
+}
+
+void
+TieredMemory::CPUSidePort::recvFunctional(PacketPtr pkt)
+{
+    mem.recvFunctional(pkt);
+}
+
+AddrRangeList
+TieredMemory::CPUSidePort::getAddrRanges() const
+{
+    return { mem.range };
+}
+
+bool
+TieredMemory::MemSidePort::recvTimingResp(PacketPtr pkt)
+{
+    return mem.recvTimingResp(pkt, far);
+}
+
+void
+TieredMemory::MemSidePort::recvReqRetry()
+{
+    (far ? mem.farQueue : mem.nearQueue).retry();
+}
+
+} // namespace gem5
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a two-tier memory that migrates pages between a near
+ * and a far memory.
+ */
+
+#ifndef __MEM_TIERED_MEMORY_HH__
+#define __MEM_TIERED_MEMORY_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "mem/packet_queue.hh"
+#include "mem/port.hh"
+#include "params/TieredMemory.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class System;
+
+/**
+ * A tiered memory presents one address range to the CPU side and keeps
+ * each page of it in a frame of either the near or the far memory. The
+ * pages start out identity mapped, with the near frames first. Requests
+ * are remapped on their way down and restored on their way back, much
+ * like the address mapper does, but may not cross a page.
+ *
+ * The far memory is reached over a link with a fixed latency and a
+ * bandwidth per direction, as for a CXL-attached memory expander. Only
+ * the data of a packet occupies the link.
+ *
+ * One in sample_interval timing accesses is sampled into a saturating
+ * heat counter per page, which halves every epoch. At the end of an
+ * epoch, the hottest far page sampled in it is swapped with a cold near
+ * page found by a clock hand, provided it has reached hot_threshold.
+ * The swap reads both pages and writes them back to the other frame in
+ * blocks through the same ports and link as the demand traffic, and
+ * accesses to the two pages are refused until the swap is complete.
+ * The data itself is taken with functional reads once the timing reads
+ * are done, so that it reflects every write that was accepted before.
+ *
+ * Migrations only happen in timing mode, and the page placement is
+ * part of the checkpoint.
+ */
+class TieredMemory : public SimObject
+{
+  protected:
+
+    class CPUSidePort : public ResponsePort
+    {
+      private:
+        TieredMemory &mem;
+
+      public:
+        CPUSidePort(const std::string &_name, TieredMemory &_mem);
+
+      protected:
+        bool recvTimingReq(PacketPtr pkt) override;
+        void recvRespRetry() override;
+        Tick recvAtomic(PacketPtr pkt) override;
+        void recvFunctional(PacketPtr pkt) override;
+        AddrRangeList getAddrRanges() const override;
+    };
+
+    class MemSidePort : public RequestPort
+    {
+      private:
+        TieredMemory &mem;
+
+        /** Whether the port leads to the far memory. */
+        const bool far;
+
+      public:
+        MemSidePort(const std::string &_name, TieredMemory &_mem,
+                    bool _far);
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+        void recvReqRetry() override;
+        void recvRangeChange() override { }
+    };
+
+    /**
+     * Queue of the requests to one of the tiers, returning the credit
+     * of the requests that do not need a response once they are sent.
+     */
+    class MemSideQueue : public ReqPacketQueue
+    {
+      private:
+        TieredMemory &mem;
+
+      public:
+        MemSideQueue(TieredMemory &_mem, RequestPort &_mem_side_port);
+
+      protected:
+        bool sendTiming(PacketPtr pkt) override;
+    };
+
+    /**
+     * Queue of the responses on the CPU side, returning the credit of
+     * the corresponding request once a response is sent.
+     */
+    class CPUSideQueue : public RespPacketQueue
+    {
+      private:
+        TieredMemory &mem;
+
+      public:
+        CPUSideQueue(TieredMemory &_mem, ResponsePort &_cpu_side_port);
+
+      protected:
+        bool sendTiming(PacketPtr pkt) override;
+    };
+
+    /** Remember the CPU side address of a request. */
+    class TierSenderState : public Packet::SenderState
+    {
+      public:
+        TierSenderState(Addr _orig_addr) : origAddr(_orig_addr) { }
+
+        const Addr origAddr;
+    };
+
+    /** The page swap in progress, if any. */
+    struct Migration
+    {
+        bool active = false;
+
+        /** Whether the copy is past the reads and into the writes. */
+        bool writing = false;
+
+        /** The far page moving near, and the near page moving far. */
+        uint32_t hotPage = 0;
+        uint32_t coldPage = 0;
+
+        /** Next block to issue, and blocks issued but not done. */
+        unsigned next = 0;
+        unsigned outstanding = 0;
+        unsigned done = 0;
+
+        Tick startTick = 0;
+
+        /** Content of the hot page followed by that of the cold one. */
+        std::vector<uint8_t> data;
+    };
+
+    struct TieredMemoryStats : public statistics::Group
+    {
+        TieredMemoryStats(TieredMemory &mem);
+
+        statistics::Scalar nearAccesses;
+        statistics::Scalar farAccesses;
+        statistics::Scalar migrations;
+        statistics::Scalar migratedBytes;
+        statistics::Scalar migrationTicks;
+        statistics::Scalar stalledReqs;
+        statistics::Scalar stallTicks;
+
+        statistics::Formula migrationBandwidth;
+        statistics::Formula avgMigrationLatency;
+    };
+
+    CPUSidePort cpuSidePort;
+    MemSidePort nearSidePort;
+    MemSidePort farSidePort;
+
+    CPUSideQueue respQueue;
+    MemSideQueue nearQueue;
+    MemSideQueue farQueue;
+
+    /** Requestor ID of the page copies. */
+    const RequestorID requestorId;
+
+    const AddrRange range;
+    const AddrRange nearRange;
+    const AddrRange farRange;
+    const Addr pageSize;
+
+    /** Number of frames in each tier. */
+    const uint32_t numNear;
+    const uint32_t numFar;
+
+    const Tick farLatency;
+
+    /** Bandwidth of the far link in ticks per byte. */
+    const double farBandwidth;
+
+    /** Number of requests the memory can hold. */
+    const unsigned bufferSize;
+
+    /** Requests that can still be accepted. */
+    unsigned credits;
+
+    /** Whether the CPU side is waiting for a retry. */
+    bool retryReq;
+
+    /** When each direction of the far link is next free. */
+    Tick farReqFreeAt;
+    Tick farRespFreeAt;
+
+    /** Latest send time of a request queued to the near memory. */
+    Tick nearLastSendAt;
+
+    /** Frame of each page, the near frames coming first. */
+    std::vector<uint32_t> frameOf;
+
+    /** Page held by each frame. */
+    std::vector<uint32_t> pageAt;
+
+    /** Heat of each page, and the epoch it was last updated in. */
+    std::vector<uint8_t> heat;
+    std::vector<uint32_t> heatEpoch;
+
+    uint32_t epoch;
+
+    const unsigned sampleInterval;
+    unsigned sampleCount;
+
+    const unsigned hotThreshold;
+
+    /** Hottest far page sampled this epoch, or numPages() if none. */
+    uint32_t hotPage;
+
+    /** Next near frame to consider when looking for a cold page. */
+    uint32_t clockHand;
+
+    /** Whether there were timing accesses this epoch. */
+    bool accessedInEpoch;
+
+    const Tick migrationInterval;
+    const unsigned blockSize;
+    const unsigned maxOutstanding;
+
+    Migration migration;
+
+    /**
+     * When the oldest request refused because of a migration was
+     * first refused, or MaxTick if there is none.
+     */
+    Tick stallStart;
+
+    EventFunctionWrapper epochEvent;
+
+    TieredMemoryStats stats;
+
+    uint32_t numPages() const { return numNear + numFar; }
+    uint32_t pageOf(Addr addr) const;
+    Addr frameAddr(uint32_t frame) const;
+    bool isFar(uint32_t frame) const { return frame >= numNear; }
+
+    /** Decayed heat of a page. */
+    unsigned heatOf(uint32_t page) const;
+
+    /** Whether accesses to a page have to wait for a migration. */
+    bool isMigrating(uint32_t page) const;
+
+    /** Frame a page is copied to by the migration in progress. */
+    uint32_t migrationTarget(uint32_t page) const;
+
+    /**
+     * Occupy the far link with a number of bytes, starting no earlier
+     * than a given tick.
+     *
+     * @return The tick the bytes reach the other end
+     */
+    Tick crossFarLink(Tick &free_at, Tick when, unsigned bytes);
+
+    /** Queue a request to the memory holding a frame. */
+    void sendToFrame(PacketPtr pkt, uint32_t frame, Tick when);
+
+    void sample(uint32_t page);
+    void processEpochEvent();
+
+    void startMigration(uint32_t hot_page, uint32_t cold_page);
+    void issueMigration();
+    void recvMigrationResp(PacketPtr pkt);
+    void finishMigration();
+
+    void returnCredit();
+    void checkDrainDone();
+
+    bool recvTimingReq(PacketPtr pkt);
+    bool recvTimingResp(PacketPtr pkt, bool far);
+    Tick recvAtomic(PacketPtr pkt);
+    void recvFunctional(PacketPtr pkt);
+
+  public:
+    PARAMS(TieredMemory);
+    TieredMemory(const Params &p);
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void init() override;
+
+    DrainState drain() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+};
+
+} // namespace gem5
+
+#endif //__MEM_TIERED_MEMORY_HH__
@@ -140,9 +140,8 @@ TokenResponsePort::sendTimingResp(PacketPtr pkt)
 }
 
 TokenManager::TokenManager(int init_tokens)
+    : maxTokens(init_tokens), availableTokens(init_tokens)
 {
-    availableTokens = init_tokens;
-    maxTokens = init_tokens;
 }
 
 int
@@ -154,12 +153,12 @@ TokenManager::getMaxTokenCount() const
 void
 TokenManager::recvTokens(int num_tokens)
 {
-    availableTokens += num_tokens;
+    int tokens = availableTokens += num_tokens;
 
     DPRINTF(TokenPort, "Received %d tokens, have %d\n",
-                       num_tokens, availableTokens);
+                       num_tokens, tokens);
 
-    panic_if(availableTokens > maxTokens,
+    panic_if(tokens > maxTokens,
              "More tokens available than the maximum after recvTokens!\n");
 }
 
@@ -175,10 +174,10 @@ TokenManager::acquireTokens(int num_tokens)
     panic_if(!haveTokens(num_tokens),
              "Attempted to acquire more tokens than are available!\n");
 
-    availableTokens -= num_tokens;
+    int tokens = availableTokens -= num_tokens;
 
     DPRINTF(TokenPort, "Acquired %d tokens, have %d\n",
-                       num_tokens, availableTokens);
+                       num_tokens, tokens);
 }
 
 } // namespace gem5
@@ -45,6 +45,8 @@
 
 #include "mem/xbar.hh"
 
+#include <algorithm>
+
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -327,6 +329,32 @@ BaseXBar::Layer<SrcType, DstType>::recvRetry()
     }
 }
 
+void
+BaseXBar::buildPortDecoder()
+{
+    portDecoder.clear();
+    for (const auto &[range, port] : portMap) {
+        // interleaved ranges that merge are consecutive in the map
+        if (range.interleaved() && !portDecoder.empty() &&
+            portDecoder.back().ranges.front().first.mergesWith(range)) {
+            portDecoder.back().ranges[range.getIntlvMatch()] =
+                {range, port};
+            continue;
+        }
+
+        PortDecodeEntry entry;
+        entry.start = range.start();
+        if (range.interleaved()) {
+            // stripes that are not mapped are left to the interval tree
+            entry.ranges.resize(range.stripes(), {range, InvalidPortID});
+            entry.ranges[range.getIntlvMatch()] = {range, port};
+        } else {
+            entry.ranges.emplace_back(range, port);
+        }
+        portDecoder.push_back(std::move(entry));
+    }
+}
+
 PortID
 BaseXBar::findPort(AddrRange addr_range)
 {
@@ -334,6 +362,22 @@ BaseXBar::findPort(AddrRange addr_range)
     // ranges of all connected CPU-side-port modules
     assert(gotAllAddrRanges);
 
+    // Find the last entry starting at or before the range, and if the
+    // range is interleaved, the interleaved range the address picks
+    auto e = std::upper_bound(portDecoder.begin(), portDecoder.end(),
+        addr_range.start(), [](Addr a, const PortDecodeEntry &entry) {
+            return a < entry.start;
+        });
+    if (e != portDecoder.begin()) {
+        --e;
+        const auto &first = e->ranges.front().first;
+        const auto &r = first.interleaved() ?
+            e->ranges[first.intlvSelect(addr_range.start())] :
+            e->ranges.front();
+        if (r.second != InvalidPortID && addr_range.isSubset(r.first))
+            return r.second;
+    }
+
     // Check the address map interval tree
     auto i = portMap.contains(addr_range);
     if (i != portMap.end()) {
@@ -431,6 +475,8 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
                       memSidePorts[conflict_id]->getPeer());
             }
         }
+
+        buildPortDecoder();
     }
 
     // if we have received ranges from all our neighbouring CPU-side-port
@@ -522,6 +568,14 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
     }
 }
 
+void
+BaseXBar::recvMemBackdoorReq(const MemBackdoorReq &req,
+                             MemBackdoorPtr &backdoor)
+{
+    PortID mem_side_port_id = findPort(req.range());
+    memSidePorts[mem_side_port_id]->sendMemBackdoorReq(req, backdoor);
+}
+
 AddrRangeList
 BaseXBar::getAddrRanges() const
 {
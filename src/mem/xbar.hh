@@ -48,6 +48,8 @@
 
 #include <deque>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
@@ -318,6 +320,23 @@ class BaseXBar : public ClockedObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /**
+     * The port map flattened into an array sorted by start address
+     * for findPort. The ranges interleaved with each other share an
+     * entry, in which the port is picked by the interleaving bits of
+     * the address rather than by searching.
+     */
+    struct PortDecodeEntry
+    {
+        Addr start;
+        /** The ranges of the entry indexed by their match value */
+        std::vector<std::pair<AddrRange, PortID>> ranges;
+    };
+    std::vector<PortDecodeEntry> portDecoder;
+
+    /** Rebuild the port decoder after the port map changed */
+    void buildPortDecoder();
+
     /**
      * Remember where request packets came from so that we can route
      * responses to the appropriate port. This relies on the fact that
@@ -355,6 +374,18 @@ class BaseXBar : public ClockedObject
      */
     AddrRangeList getAddrRanges() const;
 
+    /**
+     * Forward a back door request to the memory-side port responsible for
+     * the requested range. Caches above the crossbar are not consulted, so
+     * it is up to the requestor to only use the back door for data it knows
+     * to be coherent in memory.
+     *
+     * @param req Description of the requested back door.
+     * @param backdoor Set by the target if it can provide a back door.
+     */
+    void recvMemBackdoorReq(const MemBackdoorReq &req,
+                            MemBackdoorPtr &backdoor);
+
     /**
      * Calculate the timing parameters for the packet. Updates the
      * headerDelay and payloadDelay fields of the packet
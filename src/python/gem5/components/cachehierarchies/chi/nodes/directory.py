@@ -61,6 +61,7 @@ class SimpleDirectory(AbstractNode):
         self.send_evictions = False
         self.sequencer = NULL
 
+        self.prefetcher = NULL
         self.use_prefetcher = False
 
         # Set up home node that allows three hop protocols
@@ -31,6 +31,7 @@ from .abstract_node import AbstractNode
 
 from m5.objects import (
     ClockDomain,
+    NULL,
     RubyCache,
 )
 
@@ -72,6 +73,7 @@ class DMARequestor(AbstractNode):
         self.dealloc_backinv_shared = True
 
         self.send_evictions = False
+        self.prefetcher = NULL
         self.use_prefetcher = False
         # Some reasonable default TBE params
         self.number_of_TBEs = 16
@@ -31,6 +31,7 @@ from .abstract_node import AbstractNode
 
 from m5.objects import (
     ClockDomain,
+    NULL,
     RubyCache,
     RubyNetwork,
 )
@@ -55,6 +56,7 @@ class PrivateL1MOESICache(AbstractNode):
 
         self.clk_domain = clk_domain
         self.send_evictions = self.sendEvicts(core=core, target_isa=target_isa)
+        self.prefetcher = NULL
         self.use_prefetcher = False
 
         # Only applies to home nodes
@@ -0,0 +1,161 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+""" HBM memory system using HBMCtrl
+"""
+
+from math import log
+from ...utils.override import overrides
+from .memory import ChanneledMemory, _isPow2, _try_convert
+from .abstract_memory_system import AbstractMemorySystem
+from .dram_interfaces.hbm import HBM_2000_4H_1x64
+from m5.objects import AddrRange, DRAMInterface, HBMCtrl, Port
+from typing import Type, Optional, Union, Sequence, Tuple
+
+
+class HighBandwidthMemory(ChanneledMemory):
+    """
+    This class extends ChanneledMemory and can be used to create HBM based
+    memory system where a single physical channel contains two pseudo
+    channels. This is supposed to be used with the HBMCtrl and two dram
+    (HBM2) interfaces per channel. The two pseudo channels of a channel
+    are interleaved at the lowest interleaving bit, the channels above it.
+    """
+
+    def __init__(
+        self,
+        dram_interface_class: Type[DRAMInterface],
+        num_channels: Union[int, str],
+        interleaving_size: Union[int, str],
+        size: Optional[str] = None,
+        addr_mapping: Optional[str] = None,
+    ) -> None:
+        """
+        :param dram_interface_class: The DRAM interface type of a single
+            pseudo channel
+        :param num_channels: The number of channels, each having two
+            pseudo channels, that needs to be simulated
+        :param interleaving_size: Defines the interleaving size of the
+            pseudo channels and channels
+        :param size: Optionally specify the size of the memory's address
+            space. By default, it is the capacity of all pseudo channels
+        :param addr_mapping: Defines the address mapping scheme to be used.
+            If None, it is defaulted to addr_mapping from dram_interface_class.
+        """
+        num_channels = _try_convert(num_channels, int)
+        if not _isPow2(num_channels):
+            raise ValueError("The number of HBM channels should be a power "
+                             "of 2")
+
+        # The base class creates one interface per pseudo channel
+        super().__init__(
+            dram_interface_class,
+            num_channels * 2,
+            interleaving_size,
+            size=size,
+            addr_mapping=addr_mapping,
+        )
+        self._num_channels = num_channels
+
+    @overrides(ChanneledMemory)
+    def _create_mem_interfaces_controller(self):
+        num_channels = self._num_channels // 2
+        self._dram = [
+            self._dram_class(addr_mapping=self._addr_mapping)
+            for _ in range(num_channels)
+        ]
+        self._dram_2 = [
+            self._dram_class(addr_mapping=self._addr_mapping)
+            for _ in range(num_channels)
+        ]
+        self.mem_ctrl = [
+            HBMCtrl(dram=self._dram[i], dram_2=self._dram_2[i])
+            for i in range(num_channels)
+        ]
+
+    def _get_ctrl_range(self, intlv_bits: int, match: int) -> AddrRange:
+        intlv_low_bit = self._get_intlv_low_bit()
+        return AddrRange(
+            start=self._mem_range.start,
+            size=self._mem_range.size(),
+            intlvHighBit=intlv_low_bit + intlv_bits - 1,
+            xorHighBit=0,
+            intlvBits=intlv_bits,
+            intlvMatch=match,
+        )
+
+    @overrides(ChanneledMemory)
+    def _interleave_addresses(self):
+        # The pseudo channel is selected by the lowest interleaving bit
+        intlv_bits = int(log(self._num_channels, 2)) + 1
+        for i, ctrl in enumerate(self.mem_ctrl):
+            ctrl.dram.range = self._get_ctrl_range(intlv_bits, 2 * i)
+            ctrl.dram_2.range = self._get_ctrl_range(intlv_bits, 2 * i + 1)
+
+    def _get_port_range(self, channel: int) -> AddrRange:
+        # A controller serves both of its pseudo channels, so its port
+        # range skips the pseudo channel bit
+        intlv_low_bit = self._get_intlv_low_bit() + 1
+        intlv_bits = int(log(self._num_channels, 2))
+        return AddrRange(
+            start=self._mem_range.start,
+            size=self._mem_range.size(),
+            intlvHighBit=intlv_low_bit + intlv_bits - 1,
+            xorHighBit=0,
+            intlvBits=intlv_bits,
+            intlvMatch=channel,
+        )
+
+    @overrides(ChanneledMemory)
+    def get_mem_ports(self) -> Sequence[Tuple[AddrRange, Port]]:
+        if self._bridged:
+            ports = [bridge.cpu_side_port for bridge in self.bridges]
+        else:
+            ports = [ctrl.port for ctrl in self.mem_ctrl]
+        return [(self._get_port_range(i), port)
+                for i, port in enumerate(ports)]
+
+
+def HBM2Stacks(
+    num_stacks: int = 1,
+    size: Optional[str] = None,
+) -> AbstractMemorySystem:
+    """
+    HBM2 stacks of 8 channels of two HBM_2000_4H_1x64 pseudo channels each,
+    4GiB per stack. The pseudo channels are scheduled independently and
+    only share the command bus of their channel.
+
+    :param num_stacks: The number of stacks, a power of 2
+    :param size: Optionally specify the size of the memory's address space
+    """
+    if not _isPow2(num_stacks):
+        raise ValueError("The number of HBM stacks should be a power of 2")
+    return HighBandwidthMemory(
+        HBM_2000_4H_1x64,
+        8 * num_stacks,
+        64,
+        size=size,
+    )
@@ -32,7 +32,13 @@ from ...utils.override import overrides
 from m5.util.convert import toMemorySize
 from ..boards.abstract_board import AbstractBoard
 from .abstract_memory_system import AbstractMemorySystem
-from m5.objects import AddrRange, DRAMInterface, MemCtrl, Port
+from m5.objects import (
+    AddrRange,
+    CrossQueueBridge,
+    DRAMInterface,
+    MemCtrl,
+    Port,
+)
 from typing import Type, Sequence, Tuple, List, Optional, Union
 
 
@@ -104,14 +110,50 @@ class ChanneledMemory(AbstractMemorySystem):
         else:
             self._size = self._get_dram_size(num_channels, self._dram_class)
 
+        self._create_mem_interfaces_controller()
+        self._bridged = False
+
+    def _create_mem_interfaces_controller(self):
         self._dram = [
             self._dram_class(addr_mapping=self._addr_mapping)
-            for _ in range(num_channels)
+            for _ in range(self._num_channels)
         ]
         self.mem_ctrl = [
-            MemCtrl(dram=self._dram[i]) for i in range(num_channels)
+            MemCtrl(dram=self._dram[i]) for i in range(self._num_channels)
         ]
 
+    def use_separate_event_queues(
+        self, latency: str, first_eventq_index: int = 1
+    ) -> None:
+        """Simulate every channel on an event queue of its own.
+
+        Each memory controller is given its own event queue, and thus
+        host thread, starting at `first_eventq_index`. It is connected to
+        the rest of the system through a CrossQueueBridge adding
+        `latency` to every access. The simulation quantum
+        (`Root.sim_quantum`) has to be set to at most `latency`.
+
+        This must be called before the memory is incorporated into the
+        board.
+
+        :param latency: The latency of the bridge in front of each
+            channel, e.g., "10ns".
+        :param first_eventq_index: The event queue of the first channel.
+        """
+        if self._bridged:
+            raise Exception("The channels already use separate event queues")
+
+        self.bridges = [
+            CrossQueueBridge(
+                delay=latency, mem_side_eventq_index=first_eventq_index + i
+            )
+            for i in range(self._num_channels)
+        ]
+        for i, ctrl in enumerate(self.mem_ctrl):
+            ctrl.eventq_index = first_eventq_index + i
+            self.bridges[i].mem_side_port = ctrl.port
+        self._bridged = True
+
     def _get_dram_size(self, num_channels: int, dram: DRAMInterface) -> int:
         return num_channels * (
             dram.device_size.value
@@ -119,21 +161,23 @@ class ChanneledMemory(AbstractMemorySystem):
             * dram.ranks_per_channel.value
         )
 
-    def _interleave_addresses(self):
+    def _get_intlv_low_bit(self):
         if self._addr_mapping == "RoRaBaChCo":
             rowbuffer_size = (
                 self._dram_class.device_rowbuffer_size.value
                 * self._dram_class.devices_per_rank.value
             )
-            intlv_low_bit = log(rowbuffer_size, 2)
+            return log(rowbuffer_size, 2)
         elif self._addr_mapping in ["RoRaBaCoCh", "RoCoRaBaCh"]:
-            intlv_low_bit = log(self._intlv_size, 2)
+            return log(self._intlv_size, 2)
         else:
             raise ValueError(
                 "Only these address mappings are supported: "
                 "RoRaBaChCo, RoRaBaCoCh, RoCoRaBaCh"
             )
 
+    def _interleave_addresses(self):
+        intlv_low_bit = self._get_intlv_low_bit()
         intlv_bits = log(self._num_channels, 2)
         for i, ctrl in enumerate(self.mem_ctrl):
             ctrl.dram.range = AddrRange(
@@ -157,6 +201,11 @@ class ChanneledMemory(AbstractMemorySystem):
 
     @overrides(AbstractMemorySystem)
     def get_mem_ports(self) -> Sequence[Tuple[AddrRange, Port]]:
+        if self._bridged:
+            return [
+                (ctrl.dram.range, bridge.cpu_side_port)
+                for ctrl, bridge in zip(self.mem_ctrl, self.bridges)
+            ]
         return [(ctrl.dram.range, ctrl.port) for ctrl in self.mem_ctrl]
 
     @overrides(AbstractMemorySystem)
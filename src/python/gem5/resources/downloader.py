@@ -35,13 +35,16 @@ import hashlib
 import base64
 import time
 import random
+import glob
+import http.client
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
 import tarfile
 from tempfile import gettempdir
 from urllib.error import HTTPError
-from typing import List, Dict
+from typing import Any, Callable, List, Dict, Optional, Tuple
 
-from .md5_utils import md5_file, md5_dir
+from .md5_utils import md5_cached, record_md5
 
 from ..utils.filelock import FileLock
 
@@ -66,6 +69,38 @@ def _url_validator(url):
     except:
         return False
 
+# Downloads of at least this many bytes are split into byte ranges which are
+# fetched in parallel
+_PARALLEL_DOWNLOAD_MIN_SIZE = 64 * 1024 * 1024
+
+# The parsed resources JSON files, keyed by their path, together with the
+# modification time of the file when it was parsed
+_parsed_json_files: Dict[str, Tuple[int, Dict]] = {}
+
+def _load_json_file(path: str) -> Dict:
+    """
+    Loads a resources JSON file. The file is only parsed again if it changed
+    since it was last loaded.
+    """
+    mtime = os.stat(path).st_mtime_ns
+    if path in _parsed_json_files and _parsed_json_files[path][0] == mtime:
+        return _parsed_json_files[path][1]
+
+    with open(path) as f:
+        file_contents = f.read()
+
+    try:
+        to_return = json.loads(file_contents)
+    except json.JSONDecodeError:
+        # This is a bit of a hack. If the URL specified exists in a Google
+        # Source repo (which is the case when on the gem5 develop branch) we
+        # retrieve the JSON in base64 format. This cannot be loaded directly as
+        # text. Conversion is therefore needed.
+        to_return = json.loads(base64.b64decode(file_contents).decode("utf-8"))
+
+    _parsed_json_files[path] = (mtime, to_return)
+    return to_return
+
 def _get_resources_json_at_path(path: str, use_caching: bool = True) -> Dict:
     '''
     Returns a resource JSON, in the form of a Python Dict. The location
@@ -82,7 +117,7 @@ def _get_resources_json_at_path(path: str, use_caching: bool = True) -> Dict:
 
     # If a local valid path is passed, just load it.
     if Path(path).is_file():
-        return json.load(open(path))
+        return _load_json_file(path)
 
     # If it's not a local path, it should be a URL. We check this here and
     # raise an Exception if it's not.
@@ -97,42 +132,34 @@ def _get_resources_json_at_path(path: str, use_caching: bool = True) -> Dict:
         f"-{str(os.getuid())}.json",
     )
 
+    # The resources.json file can change at any time, but to avoid
+    # excessive retrieval we cache a version locally and use it for up to
+    # an hour before obtaining a fresh copy.
+    #
+    # `time.time()` and `os.path.getmtime(..)` both return an unix epoch
+    # time in seconds. Therefore, the value of "3600" here represents an
+    # hour difference between the two values. `time.time()` gets the
+    # current time, and `os.path.getmtime(<file>)` gets the modification
+    # time of the file. This is the most portable solution as other ideas,
+    # like "file creation time", are  not always the same concept between
+    # operating systems.
+    def needs_download() -> bool:
+        return not use_caching or not os.path.exists(download_path) or \
+            (time.time() - os.path.getmtime(download_path)) > 3600
+
     # We apply a lock on the resources file for when it's downloaded, or
-    # re-downloaded, and read. This stops a corner-case from occuring where
-    # the file is re-downloaded while being read by another gem5 thread.
+    # re-downloaded, so only one gem5 instance retrieves it. Reading it needs
+    # no lock, as `_download` only moves the file into place once it is
+    # complete, so the lock is not taken at all while the local copy is fresh.
     # Note the timeout is 120 so the `_download` function is given time to run
     # its Truncated Exponential Backoff algorithm
     # (maximum of roughly 1 minute). Typically this code will run quickly.
-    with FileLock("{}.lock".format(download_path), timeout=120):
-
-        # The resources.json file can change at any time, but to avoid
-        # excessive retrieval we cache a version locally and use it for up to
-        # an hour before obtaining a fresh copy.
-        #
-        # `time.time()` and `os.path.getmtime(..)` both return an unix epoch
-        # time in seconds. Therefore, the value of "3600" here represents an
-        # hour difference between the two values. `time.time()` gets the
-        # current time, and `os.path.getmtime(<file>)` gets the modification
-        # time of the file. This is the most portable solution as other ideas,
-        # like "file creation time", are  not always the same concept between
-        # operating systems.
-        if not use_caching or not os.path.exists(download_path) or \
-            (time.time() - os.path.getmtime(download_path)) > 3600:
-                    _download(path, download_path)
-
-    with open(download_path) as f:
-        file_contents = f.read()
-
-    try:
-        to_return = json.loads(file_contents)
-    except json.JSONDecodeError:
-        # This is a bit of a hack. If the URL specified exists in a Google
-        # Source repo (which is the case when on the gem5 develop branch) we
-        # retrieve the JSON in base64 format. This cannot be loaded directly as
-        # text. Conversion is therefore needed.
-        to_return = json.loads(base64.b64decode(file_contents).decode("utf-8"))
+    if needs_download():
+        with FileLock("{}.lock".format(download_path), timeout=120):
+            if needs_download():
+                _download(path, download_path, resume=False)
 
-    return to_return
+    return _load_json_file(download_path)
 
 def _get_resources_json() -> Dict:
     """
@@ -217,39 +244,36 @@ def _get_resources(resources_group: Dict) -> Dict[str, Dict]:
 
     return to_return
 
-def _download(
+def _retry(
+    func: Callable[[], Any],
     url: str,
-    download_to: str,
-    max_attempts: int = 6,
-) -> None:
+    max_attempts: int,
+    retry_transfer_errors: bool = False,
+) -> Any:
     """
-    Downloads a file.
+    Calls `func`, retrying with a Truncated Exponential Backoff algorithm if
+    it fails with a HTTP Status Code deemed retryable.
 
-    The function will run a Truncated Exponential Backoff algorithm to retry
-    the download if the HTTP Status Code returned is deemed retryable.
+    :param func: The function retrieving `url`.
 
-    :param url: The URL of the file to download.
+    :param url: The URL being retrieved, for error messages.
 
-    :param download_to: The location the downloaded file is to be stored.
-
-    :param max_attempts: The max number of download attempts before stopping.
-    The default is 6. This translates to roughly 1 minute of retrying before
-    stopping.
-    """
-
-    # TODO: This whole setup will only work for single files we can get via
-    # wget. We also need to support git clones going forward.
+    :param max_attempts: The max number of attempts before stopping.
 
+    :param retry_transfer_errors: If True, a connection dropped part way
+    through is also retried. This is only worthwhile when `func` continues
+    from where the previous attempt stopped.
 
+    :returns: The value returned by `func`.
+    """
     attempt = 0
     while True:
-        # The loop will be broken on a successful download, via a `return`, or
-        # if an exception is raised. An exception will be raised if the maximum
-        # number of download attempts has been reached or if a HTTP status code
-        # other than 408, 429, or 5xx is received.
+        # The loop will be broken on a success, via a `return`, or if an
+        # exception is raised. An exception will be raised if the maximum
+        # number of attempts has been reached or if a HTTP status code other
+        # than 408, 429, or 5xx is received.
         try:
-            urllib.request.urlretrieve(url, download_to)
-            return
+            return func()
         except HTTPError as e:
             # If the error code retrieved is retryable, we retry using a
             # Truncated Exponential backoff algorithm, truncating after
@@ -259,14 +283,187 @@ def _download(
                 attempt += 1
                 if attempt >= max_attempts:
                     raise Exception(
-                        f"After {attempt} attempts, the resource json could "
-                        "not be retrieved. HTTP Status Code retrieved: "
-                        f"{e.code}"
+                        f"After {attempt} attempts, '{url}' could not be "
+                        f"retrieved. HTTP Status Code retrieved: {e.code}"
                     )
                 time.sleep((2 ** attempt) + random.uniform(0, 1))
             else:
                 raise e
+        except (ConnectionError, TimeoutError,
+                http.client.IncompleteRead) as e:
+            attempt += 1
+            if not retry_transfer_errors or attempt >= max_attempts:
+                raise e
+            time.sleep((2 ** attempt) + random.uniform(0, 1))
 
+def _probe_download(url: str) -> Tuple[Optional[int], bool, str]:
+    """
+    Asks the server about a file before downloading it.
+
+    :returns: The size of the file, or None if the server does not say, True
+    if the server supports byte range requests, and a string identifying the
+    version of the file (its ETag or modification time), which is empty if
+    the server gives neither.
+    """
+    request = urllib.request.Request(url, method="HEAD")
+    with urllib.request.urlopen(request) as response:
+        length = response.headers.get("Content-Length")
+        ranges = response.headers.get("Accept-Ranges", "") == "bytes"
+        version = response.headers.get("ETag") or \
+            response.headers.get("Last-Modified") or ""
+    return (int(length) if length else None, ranges, version)
+
+def _download_range(
+    url: str,
+    part: str,
+    start: int,
+    end: Optional[int],
+    ranged: bool,
+) -> None:
+    """
+    Downloads bytes `start` to `end` (inclusive) of a file into `part`.
+
+    :param ranged: If True, the bytes already in `part` are kept and only the
+    remaining ones are requested. Otherwise the whole file is downloaded and
+    `start` and `end` are ignored.
+    """
+    offset = start
+    if ranged and os.path.exists(part):
+        offset += os.path.getsize(part)
+        if end is not None and offset > end:
+            return
+
+    request = urllib.request.Request(url)
+    if ranged:
+        last = "" if end is None else str(end)
+        request.add_header("Range", f"bytes={offset}-{last}")
+
+    with urllib.request.urlopen(request) as response:
+        if ranged and response.getcode() != 206:
+            raise Exception(
+                f"The server did not honour a byte range request for '{url}'."
+            )
+        with open(part, "ab" if ranged else "wb") as f:
+            shutil.copyfileobj(response, f, 1024 * 1024)
+
+def _get_download_connections() -> int:
+    """
+    The number of connections a large download is split across, set by the
+    `GEM5_RESOURCE_DOWNLOAD_CONNECTIONS` environment variable. 4 by default.
+    """
+    return max(1, int(os.getenv("GEM5_RESOURCE_DOWNLOAD_CONNECTIONS", "4")))
+
+def _download(
+    url: str,
+    download_to: str,
+    max_attempts: int = 6,
+    resume: bool = True,
+) -> None:
+    """
+    Downloads a file.
+
+    The function will run a Truncated Exponential Backoff algorithm to retry
+    the download if the HTTP Status Code returned is deemed retryable.
+
+    If the server supports byte range requests, large files are split into
+    ranges downloaded in parallel, and a download interrupted part way
+    through (including by the gem5 instance being killed) continues from
+    where it stopped rather than starting over, as long as the file has not
+    changed on the server since. The partially downloaded data is kept next
+    to `download_to`, which only appears once the download is complete.
+
+    :param url: The URL of the file to download.
+
+    :param download_to: The location the downloaded file is to be stored.
+
+    :param max_attempts: The max number of download attempts before stopping.
+    The default is 6. This translates to roughly 1 minute of retrying before
+    stopping.
+
+    :param resume: If False, any partial download left by an earlier attempt
+    is discarded. True by default.
+    """
+
+    # TODO: This whole setup will only work for single files we can get via
+    # wget. We also need to support git clones going forward.
+
+    try:
+        length, ranges, version = _retry(
+            lambda: _probe_download(url), url, max_attempts
+        )
+    except HTTPError:
+        # Not every server answers HEAD requests. Fall back to a plain
+        # download of the whole file.
+        length, ranges, version = (None, False, "")
+
+    ranged = ranges and bool(length)
+    num_parts = 1
+    if ranged and length >= _PARALLEL_DOWNLOAD_MIN_SIZE:
+        num_parts = _get_download_connections()
+
+    # Partial downloads are only continued if they are of the same version of
+    # the file, split in the same way
+    state_path = f"{download_to}.part.json"
+    state = {
+        "url": url,
+        "length": length,
+        "version": version,
+        "parts": num_parts,
+    }
+    try:
+        with open(state_path) as f:
+            previous_state = json.load(f)
+    except (OSError, ValueError):
+        previous_state = None
+    if not (resume and ranged and version) or previous_state != state:
+        for stale in glob.glob(glob.escape(download_to) + ".part*"):
+            os.remove(stale)
+        if resume and ranged and version:
+            with open(state_path, "w") as f:
+                json.dump(state, f)
+
+    parts = [f"{download_to}.part{i}" for i in range(num_parts)]
+    if ranged:
+        chunk = -(-length // num_parts)
+        bounds = [
+            (i * chunk, min(length, (i + 1) * chunk) - 1)
+            for i in range(num_parts)
+        ]
+    else:
+        bounds = [(0, None)]
+
+    def download_part(i: int) -> None:
+        start, end = bounds[i]
+        _retry(
+            lambda: _download_range(url, parts[i], start, end, ranged),
+            url,
+            max_attempts,
+            retry_transfer_errors=ranged,
+        )
+
+    if num_parts == 1:
+        download_part(0)
+    else:
+        with ThreadPoolExecutor(max_workers=num_parts) as pool:
+            for future in [pool.submit(download_part, i)
+                           for i in range(num_parts)]:
+                future.result()
+
+    # Assemble the parts next to the destination so it can be moved into
+    # place in one step
+    if num_parts == 1:
+        os.replace(parts[0], download_to)
+    else:
+        assembled = f"{download_to}.part"
+        with open(assembled, "wb") as o:
+            for part in parts:
+                with open(part, "rb") as f:
+                    shutil.copyfileobj(f, o, 1024 * 1024)
+        os.replace(assembled, download_to)
+        for part in parts:
+            os.remove(part)
+    if os.path.exists(state_path):
+        os.remove(state_path)
 
 
 def list_resources() -> List[str]:
@@ -301,17 +498,133 @@ def get_resources_json_obj(resource_name: str) -> Dict:
     return resource_map[resource_name]
 
 
+def _remove_path(path: str) -> None:
+    if os.path.isfile(path) or os.path.islink(path):
+        os.remove(path)
+    else:
+        shutil.rmtree(path)
+
+
+def _link_or_copy(src: str, dst: str) -> None:
+    """
+    Populates `dst` with the contents of `src`. Files are hard linked where
+    the file system allows it, so a resource taken from the shared cache
+    does not take up space twice, and copied otherwise.
+    """
+
+    def link(s: str, d: str) -> None:
+        try:
+            os.link(s, d)
+        except OSError:
+            shutil.copy2(s, d)
+
+    if os.path.isdir(src):
+        shutil.copytree(src, dst, copy_function=link)
+    else:
+        link(src, dst)
+
+
+def _fetch_resource(
+    resource_name: str,
+    resource_json: Dict,
+    to_path: str,
+    unzip: bool,
+    untar: bool,
+) -> None:
+    """
+    Downloads a resource to `to_path`, decompressing and unpacking it as
+    requested.
+    """
+
+    download_dest = to_path
+
+    # This if-statement is remain backwards compatable with the older,
+    # string-based way of doing things. It can be refactored away over
+    # time:
+    # https://gem5-review.googlesource.com/c/public/gem5-resources/+/51168
+    if isinstance(resource_json["is_zipped"], str):
+        run_unzip = unzip and resource_json["is_zipped"].lower() == "true"
+    elif isinstance(resource_json["is_zipped"], bool):
+        run_unzip = unzip and resource_json["is_zipped"]
+    else:
+        raise Exception(
+            "The resource.json entry for '{}' has a value for the "
+            "'is_zipped' field which is neither a string or a boolean."
+            .format(
+                resource_name
+            )
+        )
+
+    run_tar_extract = untar and "is_tar_archive" in resource_json and \
+                      resource_json["is_tar_archive"]
+
+    tar_extension = ".tar"
+    if run_tar_extract:
+        download_dest += tar_extension
+
+    zip_extension = ".gz"
+    if run_unzip:
+        download_dest += zip_extension
+
+    # TODO: Might be nice to have some kind of download status bar here.
+    # TODO: There might be a case where this should be silenced.
+    print(
+        "Resource '{}' was not found locally. Downloading to '{}'..."
+        .format(
+            resource_name, download_dest
+        )
+    )
+
+    # Get the URL. The URL may contain '{url_base}' which needs replaced
+    # with the correct value.
+    url = resource_json["url"].format(url_base=_get_url_base())
+
+    _download(url=url, download_to=download_dest)
+    print("Finished downloading resource '{}'.".format(resource_name))
+
+    if run_unzip:
+        print(
+            "Decompressing resource '{}' ('{}')...".format(
+                resource_name, download_dest
+            )
+        )
+        unzip_to = download_dest[:-len(zip_extension)]
+        with gzip.open(download_dest, "rb") as f:
+            with open(unzip_to, "wb") as o:
+                shutil.copyfileobj(f, o)
+        os.remove(download_dest)
+        download_dest = unzip_to
+        print(
+            "Finished decompressing resource '{}'.".format(resource_name)
+        )
+
+    if run_tar_extract:
+        print(
+            f"Unpacking the the resource '{resource_name}' "
+            f"('{download_dest}')"
+        )
+        unpack_to = download_dest[:-len(tar_extension)]
+        with tarfile.open(download_dest) as f:
+            f.extractall(unpack_to)
+        os.remove(download_dest)
+
+
 def get_resource(
     resource_name: str,
     to_path: str,
     unzip: bool = True,
     untar: bool = True,
     download_md5_mismatch: bool = True,
+    cache_dir: Optional[str] = None,
 ) -> None:
     """
     Obtains a gem5 resource and stored it to a specified location. If the
     specified resource is already at the location, no action is taken.
 
+    Checking the resource present at the location only reads its contents
+    the first time. The md5 value is remembered, next to the resource, for as
+    long as the sizes and modification times of its files do not change.
+
     :param resource_name: The resource to be obtained.
 
     :param to_path: The location in the file system the resource is to be
@@ -328,11 +641,25 @@ def get_resource(
     will delete this local resource and re-download it if this parameter is
     True. True by default.
 
+    :param cache_dir: A directory shared between gem5 instances (and users)
+    holding resources named after their md5 value. A resource missing from
+    `to_path` is taken from it, and downloaded into it first if it is not
+    there either, so each version of a resource is only downloaded once. The
+    files in `to_path` are hard links to the cached ones where possible, so
+    resources the simulation writes to should be used through a copy-on-write
+    disk image. If not set, the `GEM5_RESOURCE_CACHE_DIR` environment
+    variable is used. If neither is set the resource is downloaded directly
+    to `to_path`. The cache is only used when the resource is unzipped and
+    untarred.
+
     :raises Exception: An exception is thrown if a file is already present at
     `to_path` but it does not have the correct md5 sum. An exception will also
     be thrown is a directory is present at `to_path`
     """
 
+    if cache_dir is None:
+        cache_dir = os.getenv("GEM5_RESOURCE_CACHE_DIR")
+
     # We apply a lock for a specific resource. This is to avoid circumstances
     # where multiple instances of gem5 are running and trying to obtain the
     # same resources at once. The timeout here is somewhat arbitarily put at 15
@@ -341,97 +668,91 @@ def get_resource(
     with FileLock("{}.lock".format(to_path), timeout=900):
 
         resource_json = get_resources_json_obj(resource_name)
+        md5sum = resource_json["md5sum"]
 
         if os.path.exists(to_path):
 
-            if os.path.isfile(to_path):
-                md5 = md5_file(Path(to_path))
-            else:
-                md5 = md5_dir(Path(to_path))
-
-            if md5 == resource_json["md5sum"]:
+            if md5_cached(Path(to_path)) == md5sum:
                 # In this case, the file has already been download, no need to
                 # do so again.
                 return
             elif download_md5_mismatch:
-                if os.path.isfile(to_path):
-                    os.remove(to_path)
-                else:
-                    shutil.rmtree(to_path)
+                _remove_path(to_path)
             else:
                 raise Exception(
                     "There already a file present at '{}' but "
                     "its md5 value is invalid.".format(to_path)
                 )
 
-        download_dest = to_path
+        if not cache_dir or not unzip or not untar:
+            _fetch_resource(resource_name, resource_json, to_path, unzip,
+                            untar)
+            return
 
-        # This if-statement is remain backwards compatable with the older,
-        # string-based way of doing things. It can be refactored away over
-        # time:
-        # https://gem5-review.googlesource.com/c/public/gem5-resources/+/51168
-        if isinstance(resource_json["is_zipped"], str):
-            run_unzip = unzip and resource_json["is_zipped"].lower() == "true"
-        elif isinstance(resource_json["is_zipped"], bool):
-            run_unzip = unzip and resource_json["is_zipped"]
-        else:
-            raise Exception(
-                "The resource.json entry for '{}' has a value for the "
-                "'is_zipped' field which is neither a string or a boolean."
-                .format(
-                    resource_name
-                )
-            )
+        os.makedirs(cache_dir, exist_ok=True)
+        cached_path = os.path.join(cache_dir, md5sum)
+        with FileLock("{}.lock".format(cached_path), timeout=900):
+            if os.path.exists(cached_path) and \
+                md5_cached(Path(cached_path)) != md5sum:
+                _remove_path(cached_path)
+
+            if not os.path.exists(cached_path):
+                _fetch_resource(resource_name, resource_json, cached_path,
+                                unzip, untar)
+                # Other instances trust the cache, so check the download
+                # once here
+                if md5_cached(Path(cached_path)) != md5sum:
+                    _remove_path(cached_path)
+                    raise Exception(
+                        f"The downloaded resource '{resource_name}' does not "
+                        "have the md5 value given in the resources JSON."
+                    )
 
-        run_tar_extract = untar and "is_tar_archive" in resource_json and \
-                          resource_json["is_tar_archive"]
+            print(
+                f"Resource '{resource_name}' was found in the resource cache "
+                f"'{cache_dir}'. Copying to '{to_path}'."
+            )
+            _link_or_copy(cached_path, to_path)
 
-        tar_extension = ".tar"
-        if run_tar_extract:
-            download_dest += tar_extension
+        # The copy has the same contents as the cache but its own modification
+        # times where files had to be copied, so record the known value
+        record_md5(Path(to_path), md5sum)
 
-        zip_extension = ".gz"
-        if run_unzip:
-            download_dest += zip_extension
 
-        # TODO: Might be nice to have some kind of download status bar here.
-        # TODO: There might be a case where this should be silenced.
-        print(
-            "Resource '{}' was not found locally. Downloading to '{}'..."
-            .format(
-                resource_name, download_dest
-            )
-        )
+def get_resources(
+    resource_names: List[str],
+    resource_directory: str,
+    max_workers: Optional[int] = None,
+    **kwargs,
+) -> None:
+    """
+    Obtains several gem5 resources at once. The resources are obtained in
+    parallel, so the downloads overlap, each as if by `get_resource`.
 
-        # Get the URL. The URL may contain '{url_base}' which needs replaced
-        # with the correct value.
-        url = resource_json["url"].format(url_base=_get_url_base())
+    :param resource_names: The resources to be obtained.
 
-        _download(url=url, download_to=download_dest)
-        print("Finished downloading resource '{}'.".format(resource_name))
+    :param resource_directory: The directory the resources are to be stored
+    in, each under its own name.
 
-        if run_unzip:
-            print(
-                "Decompressing resource '{}' ('{}')...".format(
-                    resource_name, download_dest
-                )
-            )
-            unzip_to = download_dest[:-len(zip_extension)]
-            with gzip.open(download_dest, "rb") as f:
-                with open(unzip_to, "wb") as o:
-                    shutil.copyfileobj(f, o)
-            os.remove(download_dest)
-            download_dest = unzip_to
-            print(
-                "Finished decompressing resource '{}'.".format(resource_name)
-            )
+    :param max_workers: The max number of resources obtained at the same
+    time. By default, all of them.
 
-        if run_tar_extract:
-            print(
-                f"Unpacking the the resource '{resource_name}' "
-                f"('{download_dest}')"
+    :param kwargs: Passed to `get_resource` for every resource.
+    """
+    if not resource_names:
+        return
+
+    os.makedirs(resource_directory, exist_ok=True)
+    workers = max_workers or len(resource_names)
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        futures = [
+            pool.submit(
+                get_resource,
+                resource_name=name,
+                to_path=os.path.join(resource_directory, name),
+                **kwargs,
             )
-            unpack_to = download_dest[:-len(tar_extension)]
-            with tarfile.open(download_dest) as f:
-                f.extractall(unpack_to)
-            os.remove(download_dest)
+            for name in resource_names
+        ]
+        for future in futures:
+            future.result()
@@ -25,7 +25,10 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from pathlib import Path
+from typing import Optional
 import hashlib
+import json
+import os
 from _hashlib import HASH as Hash
 
 def _md5_update_from_file(filename:  Path, hash: Hash) -> Hash:
@@ -78,3 +81,80 @@ def md5_dir(directory: Path) -> str:
     if empty files are included or filenames are changed.
     """
     return str(_md5_update_from_dir(directory, hashlib.md5()).hexdigest())
+
+def _md5_record_path(path: Path) -> Path:
+    return path.parent / f".{path.name}.md5.json"
+
+def _stat_stamp(path: Path) -> str:
+    """
+    Gives a cheap fingerprint of a file or directory, made from the names,
+    sizes and modification times of its contents rather than the contents
+    themselves.
+    """
+    if path.is_file():
+        st = path.stat()
+        return f"{st.st_size}:{st.st_mtime_ns}"
+
+    stamp = hashlib.md5()
+    for root, dirs, files in os.walk(path):
+        dirs.sort()
+        for name in dirs:
+            rel = (Path(root) / name).relative_to(path)
+            stamp.update(f"{rel}/\n".encode())
+        for name in sorted(files):
+            st = (Path(root) / name).stat()
+            rel = (Path(root) / name).relative_to(path)
+            stamp.update(f"{rel}:{st.st_size}:{st.st_mtime_ns}\n".encode())
+    return stamp.hexdigest()
+
+def record_md5(path: Path, md5: str, stamp: Optional[str] = None) -> None:
+    """
+    Records the md5 value of a file or directory so later calls to
+    `md5_cached` return it without hashing the contents. The record is kept
+    in a hidden file next to the path. Failing to write it is not an error,
+    the value is simply computed again next time.
+
+    :param path: The path the md5 value belongs to.
+    :param md5: The md5 value of the path.
+    :param stamp: The fingerprint of the path the value was computed for. It
+    is taken from the path as it is now if not given.
+    """
+    path = Path(path)
+    if stamp is None:
+        stamp = _stat_stamp(path)
+    record = _md5_record_path(path)
+    tmp = record.with_name(f"{record.name}.{os.getpid()}")
+    try:
+        with open(tmp, "w") as f:
+            json.dump({"stamp": stamp, "md5": md5}, f)
+        os.replace(tmp, record)
+    except OSError:
+        pass
+
+def md5_cached(path: Path) -> str:
+    """
+    Gets the md5 value of a file or directory, as `md5` does, but remembers
+    the result. As long as the sizes and modification times of the path's
+    contents do not change, the remembered value is returned without reading
+    the contents again, so only the first call pays for hashing them.
+
+    :param path: The path to get the md5 of.
+    """
+    path = Path(path)
+    if not path.is_file() and not path.is_dir():
+        raise Exception(f"Path '{path}' is not a valid file or directory.")
+
+    stamp = _stat_stamp(path)
+    try:
+        with open(_md5_record_path(path)) as f:
+            record = json.load(f)
+        if record["stamp"] == stamp:
+            return record["md5"]
+    except (OSError, ValueError, KeyError, TypeError):
+        pass
+
+    # The fingerprint is taken before hashing, so a path modified while it is
+    # being hashed is simply hashed again next time
+    value = md5(path)
+    record_md5(path, value, stamp)
+    return value
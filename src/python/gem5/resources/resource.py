@@ -133,6 +133,9 @@ class Resource(AbstractResource):
         resource is to be stored. If this parameter is not set, it will set to
         the environment variable `GEM5_RESOURCE_DIR`. If the environment is not
         set it will default to `~/.cache/gem5` if available, otherwise the CWD.
+        If the environment variable `GEM5_RESOURCE_CACHE_DIR` is set, missing
+        resources are taken from that shared cache rather than downloaded
+        again. @sa downloader.get_resource.
         :param download_md5_mismatch: If the resource is present, but does not
         have the correct md5 value, the resoruce will be deleted and
         re-downloaded if this value is True. Otherwise an exception will be
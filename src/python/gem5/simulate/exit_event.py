@@ -46,6 +46,7 @@ class ExitEvent(Enum):
     USER_INTERRUPT = ( # An exit due to a user interrupt (e.g., cntr + c)
         "user interupt"
     )
+    LOOPPOINT = "looppoint"  # An exit because a LoopPoint marker is reached.
 
     @classmethod
     def translate_exit_status(cls, exit_string: str) -> "ExitEvent":
@@ -81,6 +82,8 @@ class ExitEvent(Enum):
             return ExitEvent.CHECKPOINT
         elif exit_string == "user interrupt received":
             return ExitEvent.USER_INTERRUPT
+        elif exit_string == "looppoint marker reached":
+            return ExitEvent.LOOPPOINT
         raise NotImplementedError(
             "Exit event '{}' not implemented".format(exit_string)
         )
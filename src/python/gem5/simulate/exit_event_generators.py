@@ -24,7 +24,9 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import m5
 import m5.stats
+from pathlib import Path
 from ..components.processors.abstract_processor import AbstractProcessor
 from ..components.processors.switchable_processor import SwitchableProcessor
 
@@ -74,3 +76,42 @@ def default_workend_generator():
     while True:
         m5.stats.dump()
         yield False
+
+
+def looppoint_save_checkpoint_generator(
+    checkpoint_dir: Path, manager: "LoopPointManager", exit_when_empty=True
+):
+    """
+    A generator for LoopPoint exit events that saves a checkpoint at each
+    marker it is given. The checkpoints are named after the markers, e.g.
+    "cpt.0x401230_42" for the 42nd entry to the loop at 0x401230.
+
+    :param checkpoint_dir: The directory the checkpoints are saved in.
+    :param manager: The LoopPointManager holding the markers.
+    :param exit_when_empty: Whether to exit the simulation once every
+    marker has been reached.
+    """
+    while True:
+        pc = manager.getCurrentPc()
+        count = manager.getCurrentCount()
+        m5.checkpoint(str(Path(checkpoint_dir) / f"cpt.{pc:#x}_{count}"))
+        yield exit_when_empty and manager.numMarkersLeft() == 0
+
+
+def looppoint_region_generator(manager: "LoopPointManager"):
+    """
+    A generator for LoopPoint exit events when simulating regions. The
+    markers are expected to alternate between the start and the end of
+    regions: at a start marker the statistics are reset, at an end marker
+    they are dumped. The simulation exits after the last region. Regions
+    that start at the beginning of the run, or share a marker with the
+    previous region, break the alternation and should be simulated one at
+    a time.
+
+    :param manager: The LoopPointManager holding the markers.
+    """
+    while True:
+        m5.stats.reset()
+        yield False
+        m5.stats.dump()
+        yield manager.numMarkersLeft() == 0
@@ -0,0 +1,193 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+"""
+Run several configurations of one simulation in forked child processes.
+
+The parent process instantiates the simulation once, which loads the
+kernel, disk image and checkpoint, and may also run it to a common point,
+such as the start of a region of interest. Every configuration is then run
+in a child forked from that state with `m5.fork()`. The children share the
+parent's memory copy-on-write, so the shared assets are neither loaded nor
+stored again per configuration. Each child gets its own output directory
+and the value returned by its configuration function is collected by the
+parent.
+
+Example:
+
+.. code-block:: python
+
+    simulator = Simulator(board=board, checkpoint_path=ckpt)
+
+    def run_with(cpu_type):
+        def run(simulator):
+            processor.switch_to(cpu_type)
+            simulator.run()
+            return simulator.get_stats()
+        return run
+
+    results = run_forked(
+        simulator,
+        {"timing": run_with(CPUTypes.TIMING), "o3": run_with(CPUTypes.O3)},
+        max_processes=2,
+    )
+"""
+
+import os
+import pickle
+import sys
+import traceback
+from typing import Any, Callable, Dict, Optional
+
+import m5
+from m5.objects import Root, System
+
+from .simulator import Simulator
+
+_RESULT_FILE = "multisim_result.pickle"
+
+
+def _check_private_memory() -> None:
+    # A shared backstore is mapped shared, so forked children would
+    # overwrite each other's memory rather than getting private copies.
+    for obj in Root.getInstance().descendants():
+        if isinstance(obj, System) and obj.shared_backstore != "":
+            raise Exception(
+                f"Cannot fork '{obj.path()}' since its memory uses the shared "
+                f"backstore '{obj.shared_backstore}'."
+            )
+
+
+def _run_child(
+    simulator: Simulator, function: Callable[[Simulator], Any]
+) -> None:
+    # The child must never return into the parent's loop, so every outcome,
+    # including exceptions, ends with an explicit exit.
+    status = 0
+    try:
+        result = (True, function(simulator))
+    except BaseException:
+        result = (False, traceback.format_exc())
+        status = 1
+    try:
+        with open(os.path.join(m5.options.outdir, _RESULT_FILE), "wb") as f:
+            pickle.dump(result, f)
+    except BaseException:
+        traceback.print_exc()
+        status = 1
+    sys.stdout.flush()
+    sys.stderr.flush()
+    os._exit(status)
+
+
+def run_forked(
+    simulator: Simulator,
+    configurations: Dict[str, Callable[[Simulator], Any]],
+    max_processes: Optional[int] = None,
+    outdir: Optional[str] = None,
+) -> Dict[str, Any]:
+    """
+    Run each configuration in a child process forked from the current state
+    of the simulation.
+
+    The simulator is instantiated first if it has not been already. Children
+    are forked with `m5.fork()`, so listeners are disabled, and the
+    simulation is drained before each fork. Stats are not redirected to the
+    children's output directories; configurations that want stat files
+    should add their own outputs, e.g., with
+    `Simulator.add_text_stats_output()`.
+
+    :param simulator: The simulator whose state the children start from.
+    :param configurations: Map from a unique configuration name to the
+    function run in its child. The function gets the simulator and its
+    return value, which must be picklable, is collected by the parent.
+    :param max_processes: The maximum number of children run at the same
+    time. Defaults to the number of host CPUs.
+    :param outdir: The directory in which a subdirectory is created for
+    every configuration. Defaults to the simulation's output directory.
+
+    :returns: A map from every configuration name to the value returned by
+    its function.
+    """
+
+    simulator._instantiate()
+    _check_private_memory()
+
+    if max_processes is None:
+        max_processes = os.cpu_count() or 1
+    if max_processes < 1:
+        raise Exception("At least one process is needed to run the sweep.")
+    if outdir is None:
+        outdir = m5.options.outdir
+
+    if not m5.listenersDisabled():
+        m5.disableAllListeners()
+
+    pending = list(configurations.items())
+    running = {}
+    results = {}
+    failures = {}
+    while pending or running:
+        while pending and len(running) < max_processes:
+            name, function = pending.pop(0)
+            child_outdir = os.path.join(outdir, name)
+            os.makedirs(child_outdir, exist_ok=True)
+            pid = m5.fork(simout=child_outdir.replace("%", "%%"))
+            if pid == 0:
+                _run_child(simulator, function)
+            running[pid] = (name, child_outdir)
+
+        pid, status = os.wait()
+        if pid not in running:
+            continue
+        name, child_outdir = running.pop(pid)
+
+        result_path = os.path.join(child_outdir, _RESULT_FILE)
+        result = None
+        if os.path.exists(result_path):
+            with open(result_path, "rb") as f:
+                result = pickle.load(f)
+            os.remove(result_path)
+
+        if result is not None and result[0]:
+            results[name] = result[1]
+        elif result is not None:
+            failures[name] = result[1]
+        else:
+            if os.WIFSIGNALED(status):
+                how = f"was killed by signal {os.WTERMSIG(status)}"
+            else:
+                how = f"exited with status {os.WEXITSTATUS(status)}"
+            failures[name] = f"Child {pid} {how} without a result."
+
+    if failures:
+        raise Exception(
+            "Configurations failed:\n"
+            + "\n".join(f"{name}:\n{msg}" for name, msg in failures.items())
+        )
+
+    return results
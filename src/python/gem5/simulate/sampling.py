@@ -0,0 +1,116 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Support for statistical sampling (SMARTS-style) of a simulation. See
+`Simulator.run_sampled()`.
+"""
+
+import math
+from typing import List, Optional
+
+
+def _normal_quantile(p: float) -> float:
+    """
+    Returns the `p` quantile of the standard normal distribution, found by
+    bisection on the error function.
+    """
+    low, high = -10.0, 10.0
+    for _ in range(100):
+        mid = (low + high) / 2
+        if 0.5 * (1 + math.erf(mid / math.sqrt(2))) < p:
+            low = mid
+        else:
+            high = mid
+    return (low + high) / 2
+
+
+class SampleResults:
+    """
+    Holds the metric measured in each detailed sampling window and derives
+    an estimate of the metric over the whole run from it.
+    """
+
+    def __init__(self, samples: Optional[List[float]] = None) -> None:
+        self._samples = list(samples) if samples else []
+
+    def add_sample(self, value: float) -> None:
+        self._samples.append(float(value))
+
+    def get_samples(self) -> List[float]:
+        return self._samples
+
+    def num_samples(self) -> int:
+        return len(self._samples)
+
+    def mean(self) -> float:
+        if not self._samples:
+            raise Exception("No samples have been collected.")
+        return sum(self._samples) / len(self._samples)
+
+    def stdev(self) -> float:
+        """
+        Returns the sample standard deviation. This is 0 when there are fewer
+        than two samples.
+        """
+        n = len(self._samples)
+        if n < 2:
+            return 0.0
+        mean = self.mean()
+        return math.sqrt(
+            sum((x - mean) ** 2 for x in self._samples) / (n - 1)
+        )
+
+    def confidence_interval(self, confidence: float = 0.95) -> float:
+        """
+        Returns the half-width of the confidence interval of the mean, using
+        the normal approximation. This assumes enough samples (typically 30
+        or more) were taken.
+
+        :param confidence: The confidence level, between 0 and 1.
+        """
+        if not 0 < confidence < 1:
+            raise ValueError("The confidence level must be between 0 and 1.")
+        z = _normal_quantile(0.5 + confidence / 2)
+        return z * self.stdev() / math.sqrt(len(self._samples))
+
+    def relative_error(self, confidence: float = 0.95) -> float:
+        """
+        Returns the half-width of the confidence interval relative to the
+        mean. SMARTS typically aims for 0.03 at 99.7% confidence.
+        """
+        mean = self.mean()
+        if mean == 0:
+            return math.inf
+        return self.confidence_interval(confidence) / abs(mean)
+
+    def __str__(self) -> str:
+        if not self._samples:
+            return "no samples"
+        return (
+            f"{self.mean()} +/- {self.confidence_interval()} (95% confidence,"
+            f" {self.num_samples()} samples)"
+        )
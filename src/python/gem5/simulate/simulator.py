@@ -25,6 +25,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 import m5
+import m5.stats
 import m5.ticks
 from m5.stats import addStatVisitor
 from m5.stats.gem5stats import get_simstat
@@ -33,7 +34,7 @@ from m5.util import warn
 
 import os
 from pathlib import Path
-from typing import Optional, List, Tuple, Dict, Generator, Union
+from typing import Callable, Optional, List, Tuple, Dict, Generator, Union
 
 from .exit_event_generators import (
     default_exit_generator,
@@ -42,6 +43,7 @@ from .exit_event_generators import (
     default_workend_generator,
 )
 from .exit_event import ExitEvent
+from .sampling import SampleResults
 from ..components.boards.abstract_board import AbstractBoard
 from ..components.processors.cpu_types import CPUTypes
 
@@ -142,6 +144,7 @@ class Simulator:
             * ExitEvent.WORKEND: default_workend_list
             * ExitEvent.USER_INTERRUPT: default_exit_generator
             * ExitEvent.MAX_TICK: default_exit_generator()
+            * ExitEvent.LOOPPOINT: default_exit_generator()
 
         These generators can be found in the `exit_event_generator.py` module.
 
@@ -167,6 +170,7 @@ class Simulator:
             ExitEvent.WORKEND: default_workend_generator(),
             ExitEvent.USER_INTERRUPT: default_exit_generator(),
             ExitEvent.MAX_TICK: default_exit_generator(),
+            ExitEvent.LOOPPOINT: default_exit_generator(),
         }
 
         if on_exit_event:
@@ -364,6 +368,101 @@ class Simulator:
             if exit_on_completion:
                 return
 
+    def _run_for(self, ticks: int) -> bool:
+        """
+        Runs the simulation for `ticks` ticks, handling any exit events in
+        the meantime. Returns False if the run ended on anything other than
+        the tick limit.
+        """
+        self.run(max_ticks=ticks)
+        return self._tick_stopwatch[-1][0] == ExitEvent.MAX_TICK
+
+    def run_sampled(
+        self,
+        metric: Callable[[], float],
+        detailed_ticks: int,
+        fast_forward_ticks: int,
+        warmup_ticks: int = 0,
+        max_samples: Optional[int] = None,
+        dump_stats: bool = True,
+    ) -> SampleResults:
+        """
+        Runs a periodically sampled simulation (SMARTS-style) and returns
+        the metric measured in each detailed window.
+
+        The board's processor must be switchable (e.g., a
+        `SimpleSwitchableProcessor`) and start with the fast-forwarding
+        cores, which should be atomic cores. Each sampling period is made of:
+
+            1. `fast_forward_ticks` ticks on the starting cores. Atomic cores
+               access the caches, so these stay warm without having to write
+               them back or invalidate them on the switch.
+            2. A switch to the detailed cores, then `warmup_ticks` ticks to
+               warm up their microarchitectural state.
+            3. A stats reset and `detailed_ticks` measured ticks, after which
+               `metric()` is recorded (and the stats dumped, if
+               `dump_stats` is set).
+            4. A switch back to the starting cores.
+
+        Sampling stops after `max_samples` samples, or when an exit event
+        other than the tick limit ends a run (e.g., the workload exits).
+
+        :param metric: Evaluated at the end of each detailed window to obtain
+        the value to sample, e.g., the IPC computed from the detailed cores'
+        statistics.
+        :param detailed_ticks: The length of each measured window.
+        :param fast_forward_ticks: The number of ticks to fast-forward between
+        detailed windows.
+        :param warmup_ticks: The number of ticks to run on the detailed cores
+        before each measured window.
+        :param max_samples: The maximum number of samples to take. If None,
+        sampling continues until the simulation exits.
+        :param dump_stats: Whether to dump the stats after each window.
+        """
+        processor = self._board.get_processor()
+        if not hasattr(processor, "switch"):
+            raise Exception(
+                "Sampling requires a processor that can switch between "
+                "fast-forwarding and detailed cores."
+            )
+        if detailed_ticks <= 0 or fast_forward_ticks <= 0:
+            raise ValueError(
+                "The detailed and fast-forward windows must be non-empty."
+            )
+
+        self._instantiate()
+
+        if any(
+            core.get_type() != CPUTypes.ATOMIC
+            for core in processor.get_cores()
+        ):
+            warn(
+                "Sampling is fast-forwarding on non-atomic cores. The caches "
+                "may not be warmed up functionally."
+            )
+
+        results = SampleResults()
+        while max_samples is None or results.num_samples() < max_samples:
+            if not self._run_for(fast_forward_ticks):
+                break
+
+            processor.switch()
+            if warmup_ticks and not self._run_for(warmup_ticks):
+                break
+
+            m5.stats.reset()
+            # A partial window would bias the estimate, so only complete
+            # windows are sampled.
+            if not self._run_for(detailed_ticks):
+                break
+            results.add_sample(metric())
+            if dump_stats:
+                m5.stats.dump()
+
+            processor.switch()
+
+        return results
+
     def save_checkpoint(self, checkpoint_dir: Path) -> None:
         """
         This function will save the checkpoint to the specified directory.
@@ -0,0 +1,99 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+"""
+Helpers to set up LoopPoint style profiling and region simulation of
+multi-threaded workloads. See `LoopPointManager` for how regions and
+their (PC, count) markers are defined.
+
+A profiling run splits the execution into regions and writes a BBV per
+region, which can be clustered with SimPoint, and a marker file:
+
+    manager = LoopPointManager(profile=True, region_length=100000000)
+    add_looppoint_probes(cpus, manager)
+
+A later run can then exit at the markers of the chosen regions:
+
+    regions = read_looppoint_markers("m5out/looppoint.markers")
+    manager = looppoint_manager_for_regions([regions[i] for i in chosen])
+"""
+
+from typing import Iterable, List, Tuple
+
+from m5.objects import BaseCPU, LoopPoint, LoopPointManager
+
+Marker = Tuple[int, int]
+
+
+def add_looppoint_probes(
+    cpus: Iterable[BaseCPU], manager: LoopPointManager
+) -> None:
+    """
+    Attach a LoopPoint probe feeding `manager` to each of `cpus`. All the
+    cores running the workload must be attached for the entry counts to
+    be global.
+    """
+    for cpu in cpus:
+        cpu.looppoint = LoopPoint(looppoint_manager=manager)
+
+
+def read_looppoint_markers(path: str) -> List[Tuple[Marker, Marker]]:
+    """
+    Read the marker file of a profiling run. Returns the (start, end)
+    markers of every region, in order. The first region starts at (0, 0),
+    the start of the run, and the last one ends at (0, 0), its end.
+    """
+    regions = []
+    with open(path) as f:
+        for line in f:
+            if line.startswith("#") or not line.strip():
+                continue
+            _, start_pc, start_count, end_pc, end_count, _ = line.split()
+            regions.append(
+                (
+                    (int(start_pc, 0), int(start_count)),
+                    (int(end_pc, 0), int(end_count)),
+                )
+            )
+    return regions
+
+
+def looppoint_manager_for_regions(
+    regions: Iterable[Tuple[Marker, Marker]]
+) -> LoopPointManager:
+    """
+    Create a LoopPointManager exiting at the start and end markers of
+    `regions`. The (0, 0) markers of the start and end of the run are
+    skipped, as no exit is needed there.
+    """
+    markers = []
+    for region in regions:
+        markers.extend(m for m in region if m != (0, 0))
+    return LoopPointManager(
+        target_pcs=[pc for pc, _ in markers],
+        target_counts=[count for _, count in markers],
+    )
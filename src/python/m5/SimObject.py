@@ -108,6 +108,12 @@ allClasses = {}
 # dict to look up SimObjects based on path
 instanceDict = {}
 
+# Names of the params of each class that hold a given SimObject type, as
+# searched for by Parent.any and Parent.all. Declaring a new param
+# anywhere flushes the whole cache, since subclasses share their base's
+# params.
+_ptypeParams = {}
+
 # Did any of the SimObjects lack a header file?
 noCxxHeader = False
 
@@ -295,6 +301,7 @@ class MetaSimObject(type):
         assert(not hasattr(pdesc, 'name'))
         pdesc.name = name
         cls._params[name] = pdesc
+        _ptypeParams.clear()
         if hasattr(pdesc, 'default'):
             cls._set_param(name, pdesc.default, pdesc)
 
@@ -973,18 +980,33 @@ class SimObject(object, metaclass=MetaSimObject):
                           (found_obj.path, child.path))
                 found_obj = child
         # search param space
-        for pname,pdesc in self._params.items():
-            if issubclass(pdesc.ptype, ptype):
-                match_obj = self._values[pname]
-                if found_obj != None and found_obj != match_obj:
-                    raise AttributeError(
-                          'parent.any matched more than one: %s and %s' % \
-                          (found_obj.path, match_obj.path))
-                found_obj = match_obj
+        for pname in self._ptype_params(ptype):
+            match_obj = self._values[pname]
+            if found_obj != None and found_obj != match_obj:
+                raise AttributeError(
+                      'parent.any matched more than one: %s and %s' % \
+                      (found_obj.path, match_obj.path))
+            found_obj = match_obj
         return found_obj, found_obj != None
 
+    def _ptype_params(self, ptype):
+        key = (self.__class__, ptype)
+        pnames = _ptypeParams.get(key)
+        if pnames is None:
+            pnames = _ptypeParams[key] = [ pname for pname,pdesc in
+                self._params.items() if issubclass(pdesc.ptype, ptype) ]
+        return pnames
+
     def find_all(self, ptype):
         all = {}
+        self._find_all(ptype, all)
+        # Also make sure to sort the keys based on the objects' path to
+        # ensure that the order is the same on all hosts
+        return sorted(all.keys(), key = lambda o: o.path()), True
+
+    # Collect the matches of the whole subtree into one dict, so that
+    # they only have to be sorted once by find_all()
+    def _find_all(self, ptype, all):
         # search children
         for child in self._children.values():
             # a child could be a list, so ensure we visit each item
@@ -999,17 +1021,12 @@ class SimObject(object, metaclass=MetaSimObject):
                     all[child] = True
                 if isSimObject(child):
                     # also add results from the child itself
-                    child_all, done = child.find_all(ptype)
-                    all.update(dict(zip(child_all, [done] * len(child_all))))
+                    child._find_all(ptype, all)
         # search param space
-        for pname,pdesc in self._params.items():
-            if issubclass(pdesc.ptype, ptype):
-                match_obj = self._values[pname]
-                if not isproxy(match_obj) and not isNullPointer(match_obj):
-                    all[match_obj] = True
-        # Also make sure to sort the keys based on the objects' path to
-        # ensure that the order is the same on all hosts
-        return sorted(all.keys(), key = lambda o: o.path()), True
+        for pname in self._ptype_params(ptype):
+            match_obj = self._values[pname]
+            if not isproxy(match_obj) and not isNullPointer(match_obj):
+                all[match_obj] = True
 
     def unproxy(self, base):
         return self
@@ -1165,13 +1182,27 @@ class SimObject(object, metaclass=MetaSimObject):
         return self._ccObject
 
     def descendants(self):
-        yield self
-        # The order of the dict is implementation dependent, so sort
-        # it based on the key (name) to ensure the order is the same
-        # on all hosts
-        for (name, child) in sorted(self._children.items()):
-            for obj in child.descendants():
-                yield obj
+        # Walk the tree with an explicit stack rather than a chain of
+        # nested generators, which costs a frame per level for every
+        # object yielded. The children of an object are only looked up
+        # once the caller is done with it, as callers such as
+        # adoptOrphanParams() add children on the way.
+        stack = [self]
+        while stack:
+            obj = stack.pop()
+            if isSimObjectVector(obj):
+                stack.extend(reversed(obj))
+                continue
+            if not isinstance(obj, SimObject):
+                # e.g. NullSimObject
+                stack.extend(reversed(list(obj.descendants())))
+                continue
+            yield obj
+            # The order of the dict is implementation dependent, so sort
+            # it based on the key (name) to ensure the order is the same
+            # on all hosts
+            stack.extend(child for (name, child) in
+                         sorted(obj._children.items(), reverse=True))
 
     # Call C++ to create C++ object corresponding to this object
     def createCCObject(self):
@@ -144,6 +144,15 @@ def parse_options():
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug. Append '.gz' to the name for it"
               " to be compressed automatically [Default: %default]")
+    option("--debug-format", metavar="{text,binary}",
+        choices=["text", "binary"], default="text",
+        help="Format of the debug output. Binary traces are written to "
+        "--debug-file and decoded with util/decode_debug_trace.py "
+        "[Default: %default]")
+    option("--debug-per-queue", action="store_true", default=False,
+        help="Write the debug output of each event queue to a file of its "
+        "own, --debug-file with the queue's index added. Merge them with "
+        "util/merge_debug_traces.py")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
@@ -396,7 +405,9 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    trace.output(options.debug_file,
+                 binary=(options.debug_format == "binary"),
+                 per_queue=options.debug_per_queue)
 
     for ignore in options.debug_ignore:
         _check_tracing()
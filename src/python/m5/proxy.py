@@ -249,9 +249,16 @@ class AllProxy(BaseProxy):
     def path(self):
         return 'all'
 
+# params imports this module, so look EthernetAddr up on first use. This
+# is called for every param of every object during instantiation.
+_proxyTypes = None
+
 def isproxy(obj):
-    from . import params
-    if isinstance(obj, (BaseProxy, params.EthernetAddr)):
+    global _proxyTypes
+    if _proxyTypes is None:
+        from . import params
+        _proxyTypes = (BaseProxy, params.EthernetAddr)
+    if isinstance(obj, _proxyTypes):
         return True
     elif isinstance(obj, (list, tuple)):
         for v in obj:
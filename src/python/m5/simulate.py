@@ -224,15 +224,23 @@ def drain():
 
     assert _drain_manager.isDrained(), "Drain state inconsistent"
 
+def _subtreeName(root):
+    # The children of the root object are named without a prefix
+    path = root.path()
+    return "" if path == "root" else path
+
 def memWriteback(root):
-    for obj in root.descendants():
-        obj.memWriteback()
+    _m5.core.memWritebackAll(_subtreeName(root))
 
 def memInvalidate(root):
-    for obj in root.descendants():
-        obj.memInvalidate()
+    _m5.core.memInvalidateAll(_subtreeName(root))
 
-def checkpoint(dir):
+def checkpoint(dir, binary=False):
+    """Write a checkpoint of the simulation to the given directory.
+
+    If binary is set, a binary index of the checkpoint is written as
+    well, which speeds up restoring large checkpoints.
+    """
     root = objects.Root.getInstance()
     if not isinstance(root, objects.Root):
         raise TypeError("Checkpoint must be called on a root object.")
@@ -241,6 +249,8 @@ def checkpoint(dir):
     memWriteback(root)
     print("Writing checkpoint")
     _m5.core.serializeAll(dir)
+    if binary:
+        _m5.core.writeBinaryCheckpoint(dir)
 
 def _changeMemoryMode(system, mode):
     if not isinstance(system, (objects.Root, objects.System)):
@@ -37,12 +37,13 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import re
+
 import m5
 
 import _m5.stats
 from m5.objects import Root
 from m5.params import isNullPointer
-from .gem5stats import JsonOutputVistor
 from m5.util import attrdict, fatal
 
 # Stat exports
@@ -147,6 +148,29 @@ def _textFactory(fn, desc=True, spaces=True):
 
     return _m5.stats.initText(fn, desc, spaces)
 
+@_url_factory([ "columnar", ])
+def _columnarFactory(fn, desc=True):
+    """Output stats in a columnar binary format.
+
+    The names, units and descriptions of the stats are only written
+    again when the set of dumped stats changes, and each dump otherwise
+    only appends the raw values. This makes frequent periodic dumps a
+    lot cheaper than with the text format. The file can be loaded into
+    pandas with m5.stats.columnar.load().
+
+    Known limitations:
+      * Sparse histograms currently unsupported.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+
+    Example:
+      columnar://stats.bin?desc=False
+
+    """
+
+    return _m5.stats.initColumnar(fn, desc)
+
 @_url_factory([ "h5", ], enable=hasattr(_m5.stats, "initHDF5"))
 def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     """Output stats in HDF5 format.
@@ -187,12 +211,104 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
 def _jsonFactory(fn):
     """Output stats in JSON format.
 
+    The stats are written as they are visited, using the schema of the
+    m5.ext.pystats SimStat objects. Every dump replaces the content of
+    the file, which is relative to the current directory rather than
+    the output directory.
+
+    Known limitations:
+      * Formulas, vector distributions, 2d vectors and sparse
+        histograms currently unsupported.
+
     Example:
       json://stats.json
 
     """
 
-    return JsonOutputVistor(fn)
+    import os
+
+    return _m5.stats.initJson(os.path.abspath(fn))
+
+class _FilteredOutput(object):
+    """Wrapper for a stat visitor that only dumps the stats whose full
+    name (e.g., system.cpu.ipc) matches one of a list of regular
+    expressions. The stats to dump are only looked up on the first
+    dump, so subsequent dumps only visit the selected stats."""
+
+    def __init__(self, output, patterns):
+        self.output = output
+        self.patterns = [ re.compile(p) for p in patterns ]
+        self._selections = {}
+
+    def valid(self):
+        return self.output.valid()
+
+    def selection(self, roots):
+        """Get a list of (group path, stats) to dump for the roots."""
+        key = tuple(id(root) for root in roots)
+        if key not in self._selections:
+            self._selections[key] = self._select(roots)
+        return self._selections[key]
+
+    def _select(self, roots):
+        def match(name):
+            return any(p.match(name) for p in self.patterns)
+
+        selected = []
+        def select_group(path, group):
+            prefix = "".join(p + "." for p in path)
+            stats = [ stat for stat in group.getStats()
+                      if match(prefix + stat.name) ]
+            if stats:
+                selected.append((path, stats))
+            for n, g in group.getStatGroups().items():
+                select_group(path + [ n ], g)
+
+        if roots:
+            for root in roots:
+                select_group(list(root.path_list()), root)
+        else:
+            select_group([], Root.getInstance())
+            legacy = [ stat for stat in stats_list if match(stat.name) ]
+            if legacy:
+                selected.append(([], legacy))
+
+        return selected
+
+    def dump(self, roots):
+        output = self.output
+        output.begin()
+        for path, stats in self.selection(roots):
+            for p in path:
+                output.beginGroup(p)
+            for stat in stats:
+                stat.visit(output)
+            for p in path:
+                output.endGroup()
+        output.end()
+
+# Options accepted by all stat visitors, see addStatVisitor()
+_common_options = ("filter", "changed")
+
+def _parseCommonOptions(parsed):
+    """Split the options common to all stat visitors from a URL."""
+
+    from urllib.parse import parse_qsl, urlencode
+    from ast import literal_eval
+
+    query = parse_qsl(parsed.query, keep_blank_values=True)
+    options = {}
+    for key, value in query:
+        if key not in _common_options:
+            continue
+        try:
+            options[key] = literal_eval(value)
+        except (ValueError, SyntaxError):
+            # Allow regular expressions without quotes
+            options[key] = value
+
+    query = [ (k, v) for k, v in query if k not in _common_options ]
+    return parsed._replace(query=urlencode(query)), options
 
 def addStatVisitor(url):
     """Add a stat visitor specified using a URL string
@@ -205,6 +321,15 @@ def addStatVisitor(url):
     parameters are keyword arguments. Parameter values must be valid
     Python literals.
 
+    The following parameters are accepted by all formats:
+      * filter (str or list of str): Only dump the stats whose full
+        name matches (from the start) one of these regular expressions.
+      * changed (bool): Only dump the stats that have changed since
+        they were last dumped (default: False).
+
+    Example:
+      text://ipc.txt?filter=['system.cpu.ipc','system.mem_ctrl']&changed=True
+
     """
 
     try:
@@ -213,7 +338,7 @@ def addStatVisitor(url):
         # Python 2 fallback
         from urlparse import urlsplit
 
-    parsed = urlsplit(url)
+    parsed, options = _parseCommonOptions(urlsplit(url))
 
     try:
         factory = factories[parsed.scheme]
@@ -223,7 +348,18 @@ def addStatVisitor(url):
     if factory is None:
         fatal("Stat type '%s' disabled at compile time" % parsed.scheme)
 
-    outputList.append(factory(parsed))
+    output = factory(parsed)
+
+    if options.get("changed", False):
+        output = _m5.stats.initChangedFilter(output)
+
+    patterns = options.get("filter", None)
+    if patterns:
+        if isinstance(patterns, str):
+            patterns = [ patterns ]
+        output = _FilteredOutput(output, patterns)
+
+    outputList.append(output)
 
 def printStatVisitorTypes():
     """List available stat visitors and their documentation"""
@@ -392,13 +528,20 @@ def dump(roots=None):
         sim_root = Root.getInstance()
         if sim_root:
             sim_root.preDumpStats();
-        prepare()
+
+        # If all outputs are filtered, only prepare the stats they dump
+        if outputList and \
+           all(isinstance(o, _FilteredOutput) for o in outputList):
+            for output in outputList:
+                for _, stats in output.selection(all_roots):
+                    for stat in stats:
+                        stat.prepare()
+        else:
+            prepare()
 
     for output in outputList:
-        if isinstance(output, JsonOutputVistor):
-            if not all_roots:
-                output.dump(Root.getInstance())
-            else:
+        if isinstance(output, _FilteredOutput):
+            if output.valid():
                 output.dump(all_roots)
         else:
             if output.valid():
@@ -0,0 +1,132 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Reader for the columnar binary stats format (see
+src/base/stats/columnar.hh), which is written when adding a stat
+visitor like "columnar://stats.bin".
+
+This module does not depend on the rest of gem5, so it can also be
+used outside of a simulation, e.g.:
+
+    from m5.stats.columnar import load
+    df = load("m5out/stats.bin")
+    df["system.cpu.numCycles"].plot()
+"""
+
+import struct
+from typing import Dict, List, NamedTuple, Tuple
+
+MAGIC = 0x4C435453354D4547  # "GEM5STCL"
+SCHEMA_BLOCK = 1
+ROW_BLOCK = 2
+
+
+class Column(NamedTuple):
+    name: str
+    unit: str
+    desc: str
+
+
+class Dump(NamedTuple):
+    """The values of a single stat dump."""
+
+    tick: int
+    columns: List[Column]
+    values: Tuple[float, ...]
+
+
+def read(filename: str) -> List[Dump]:
+    """Read all dumps from a columnar stats file."""
+
+    with open(filename, "rb") as f:
+        data = f.read()
+
+    offset = 0
+
+    def word() -> int:
+        nonlocal offset
+        if offset + 8 > len(data):
+            raise ValueError(f"Truncated stats file '{filename}'")
+        (value,) = struct.unpack_from("=Q", data, offset)
+        offset += 8
+        return value
+
+    def string() -> str:
+        nonlocal offset
+        size = word()
+        value = data[offset : offset + size].decode()
+        offset += size
+        return value
+
+    if word() != MAGIC:
+        raise ValueError(f"'{filename}' is not a columnar stats file")
+
+    dumps = []
+    columns = []
+    while offset < len(data):
+        block = word()
+        if block == SCHEMA_BLOCK:
+            columns = [
+                Column(string(), string(), string()) for _ in range(word())
+            ]
+        elif block == ROW_BLOCK:
+            tick = word()
+            size = 8 * len(columns)
+            if offset + size > len(data):
+                # The simulation was presumably stopped mid-dump
+                break
+            values = struct.unpack_from(f"={len(columns)}d", data, offset)
+            offset += size
+            dumps.append(Dump(tick, columns, values))
+        else:
+            raise ValueError(f"Corrupt stats file '{filename}'")
+
+    return dumps
+
+
+def units(filename: str) -> Dict[str, str]:
+    """Get the unit of every column in a columnar stats file."""
+
+    return {
+        column.name: column.unit
+        for dump in read(filename)
+        for column in dump.columns
+    }
+
+
+def load(filename: str):
+    """Load a columnar stats file into a pandas DataFrame, with one row
+    per dump indexed by tick and one column per stat value. Columns
+    that were not part of a dump are NaN."""
+
+    import pandas
+
+    dumps = read(filename)
+    return pandas.DataFrame.from_records(
+        [dict(zip((c.name for c in d.columns), d.values)) for d in dumps],
+        index=pandas.Index([d.tick for d in dumps], name="tick"),
+    )
@@ -38,8 +38,16 @@ class multidict(object):
     def __repr__(self):
         return repr(dict(list(self.items())))
 
+    # The lookups below walk the chain of parents iteratively rather than
+    # recursing, since SimObject params and values are looked up through
+    # one multidict per level of the class hierarchy.
     def __contains__(self, key):
-        return key in self.local or key in self.parent
+        node = self
+        while isinstance(node, multidict):
+            if key in node.local:
+                return True
+            node = node.parent
+        return key in node
 
     def __delitem__(self, key):
         try:
@@ -55,32 +63,36 @@ class multidict(object):
         self.local[key] = value
 
     def __getitem__(self, key):
-        try:
-            return self.local[key]
-        except KeyError as e:
-            if not self.deleted.get(key, False) and key in self.parent:
-                return self.parent[key]
-            else:
-                raise KeyError(e)
+        node = self
+        while isinstance(node, multidict):
+            try:
+                return node.local[key]
+            except KeyError:
+                if node.deleted.get(key, False):
+                    raise
+            node = node.parent
+        return node[key]
 
     def __len__(self):
         return len(self.local) + len(self.parent)
 
     def next(self):
-        for key,value in self.local.items():
-            yield key,value
-
-        if self.parent:
-            for key,value in self.parent.next():
-                if key not in self.local and key not in self.deleted:
+        # keys that are already yielded or deleted hide the ones below
+        hidden = set()
+        node = self
+        while isinstance(node, multidict):
+            for key,value in node.local.items():
+                if key not in hidden:
+                    hidden.add(key)
                     yield key,value
+            hidden.update(node.deleted)
+            node = node.parent
 
     def has_key(self, key):
         return key in self
 
     def items(self):
-        for item in self.next():
-            yield item
+        return self.next()
 
     def keys(self):
         for key,value in self.next():
@@ -270,7 +270,10 @@ pybind_init_core(py::module_ &m_native)
         .def("disableAllListeners", &ListenSocket::disableAll)
         .def("listenersDisabled", &ListenSocket::allDisabled)
         .def("listenersLoopbackOnly", &ListenSocket::loopbackOnly)
-        .def("seedRandom", [](uint64_t seed) { random_mt.init(seed); })
+        .def("seedRandom", [](uint64_t seed) {
+                random_mt.init(seed);
+                RandomStream::setSeed(seed);
+            })
 
 
         .def("fixClockFrequency", &fixClockFrequency)
@@ -294,6 +297,9 @@ pybind_init_core(py::module_ &m_native)
      */
     m_core
         .def("serializeAll", &SimObject::serializeAll)
+        .def("memWritebackAll", &SimObject::memWritebackAll)
+        .def("memInvalidateAll", &SimObject::memInvalidateAll)
+        .def("writeBinaryCheckpoint", &CheckpointIn::writeBinary)
         .def("getCheckpoint", [](const std::string &cpt_dir) {
             SimObject::setSimObjectResolver(&pybindSimObjectResolver);
             return new CheckpointIn(cpt_dir);
@@ -45,11 +45,15 @@
 #include <map>
 #include <vector>
 
+#include "base/binary_logger.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
+#include "base/logging.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
+#include "sim/queue_logger.hh"
 
 namespace py = pybind11;
 
@@ -57,14 +61,37 @@ namespace gem5
 {
 
 static void
-output(const char *filename)
+output(const char *filename, bool binary, bool per_queue)
 {
+    fatal_if(binary && !simout.isFile(filename),
+             "Binary debug traces must be written to a file, not '%s'.",
+             filename);
+    fatal_if(per_queue && !simout.isFile(filename),
+             "Debug output split by event queue must be written to files, "
+             "not '%s'.", filename);
+    fatal_if(binary && per_queue,
+             "Binary debug traces can't be split by event queue.");
+
+    if (per_queue) {
+        auto *logger = new Trace::QueueLogger(filename, simout);
+        Trace::setDebugLogger(logger);
+        registerExitCallback([logger]() { logger->flush(); });
+        return;
+    }
+
     OutputStream *file_stream = simout.find(filename);
 
     if (!file_stream)
-        file_stream = simout.create(filename);
-
-    Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
+        file_stream = simout.create(filename, binary);
+
+    if (binary) {
+        auto *logger = new Trace::BinaryLogger(*file_stream->stream());
+        Trace::setDebugLogger(logger);
+        registerExitCallback([logger]() { logger->flush(); });
+    } else {
+        Trace::setDebugLogger(
+            new Trace::OstreamLogger(*file_stream->stream()));
+    }
 }
 
 static void
@@ -121,7 +148,9 @@ pybind_init_debug(py::module_ &m_native)
 
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
-        .def("output", &output)
+        .def("output", &output,
+             py::arg("filename"), py::arg("binary") = false,
+             py::arg("per_queue") = false)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
@@ -42,6 +42,9 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/filter.hh"
+#include "base/stats/json.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -112,6 +115,12 @@ pybind_init_stats(py::module_ &m_native)
         .def("initSimStats", &statistics::initSimStats)
         .def("initText", &statistics::initText,
             py::return_value_policy::reference)
+        .def("initColumnar", &statistics::initColumnar)
+        .def("initJson", &statistics::initJson)
+        .def("initChangedFilter", [](statistics::Output &output) {
+                return std::unique_ptr<statistics::Output>(
+                    new statistics::ChangedFilter(output));
+            }, py::keep_alive<0, 1>())
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
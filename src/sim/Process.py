@@ -45,6 +45,9 @@ class Process(SimObject):
     useArchPT = Param.Bool('false', 'maintain an in-memory version of the page\
                             table in an architecture-specific format')
     kvmInSE = Param.Bool('false', 'initialize the process for KvmCPU in SE')
+    directSyscallIO = Param.Bool(False, 'let file I/O system calls access '
+        'the backing store of the guest buffers directly; only safe when no '
+        'caches can hold those buffers, e.g. atomic CPUs without caches')
     maxStackSize = Param.MemorySize('64MiB', 'maximum size of the stack')
 
     uid = Param.Int(100, 'user id')
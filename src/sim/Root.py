@@ -30,6 +30,12 @@ from m5.SimObject import SimObject
 from m5.params import *
 from m5.util import fatal
 
+# Data structure used by the main event queues to keep events sorted.
+# Both backends service events in the same order. The calendar queue
+# has amortized constant time insertion and is faster when many
+# distinct ticks are pending at the same time.
+class EventQueueBackend(Enum): vals = ['sorted_list', 'calendar']
+
 class Root(SimObject):
 
     _the_instance = None
@@ -66,6 +72,35 @@ class Root(SimObject):
     # Simulation Quantum for multiple main event queue simulation.
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
+    # Upper bound for an adaptive quantum. When larger than sim_quantum,
+    # the quantum grows while the event queues do not communicate and
+    # returns to sim_quantum when they do. Events sent across queues
+    # less than this far ahead may then be serviced late.
+    sim_quantum_max = Param.Tick(0, "maximum adaptive simulation quantum")
+
+    # Host CPU that the thread servicing each main event queue is pinned
+    # to, indexed by eventq_index. Negative values leave a thread unpinned.
+    eventq_host_cpus = VectorParam.Int([],
+            "host CPU to pin each event queue's thread to")
+
+    eventq_backend = Param.EventQueueBackend('sorted_list',
+            "data structure used to keep the main event queues sorted")
+
+    # Event profiling measures the host time spent in every event of the
+    # main event queues. The profile is written to eventq_profile.txt
+    # whenever statistics are dumped and at exit.
+    eventq_profile = Param.Bool(False,
+            "collect the host time spent per event on the main event queues")
+    # The profile is also attributed to the objects the events are named
+    # after, and reported as the hostProfile stats of every object,
+    # including the objects below it. Sampling only measures one in
+    # eventq_profile_sample events on average to reduce the overhead, and
+    # the host performance counters (Linux perf_event) add host cycles,
+    # instructions and cache misses to the profile.
+    eventq_profile_sample = Param.Unsigned(1,
+            "profile one in this many events on average")
+    eventq_profile_counters = Param.Bool(False,
+            "read host performance counters around the profiled events")
 
     full_system = Param.Bool("if this is a full system simulation")
 
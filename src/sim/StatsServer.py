@@ -0,0 +1,53 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.SimObject import SimObject
+from m5.params import *
+
+class StatsServerFormat(ScopedEnum): vals = ["prometheus", "columnar"]
+
+class StatsServer(SimObject):
+    """Serve a selection of the stats over a TCP socket while the
+    simulation runs. In the prometheus format, every HTTP request is
+    answered with the current values of the stats in the Prometheus text
+    format. In the columnar format, a client that connects first gets the
+    columnar file header, and then a row (preceded by a schema whenever
+    the stats change) for every byte it sends.
+
+    The stats are read between the event queue quanta, from the main
+    thread, the same way as for a stat dump."""
+
+    type = 'StatsServer'
+    cxx_header = "sim/stats_server.hh"
+    cxx_class = 'gem5::StatsServer'
+
+    port = Param.TcpPort(9465, "listen port")
+    format = Param.StatsServerFormat("prometheus",
+        "Format the stats are served in")
+    stats = VectorParam.String([], "Regular expressions matched against "
+        "the full names of the stats to serve. All stats are served if "
+        "empty.")
+    desc = Param.Bool(True, "Include the descriptions of the stats")
@@ -90,6 +90,35 @@ class System(SimObject):
     auto_unlink_shared_backstore = Param.Bool(False, "Automatically remove the "
         "shmem segment file upon destruction. This is used only if "
         "shared_backstore is non-empty.")
+    delta_checkpoints = Param.Bool(False, "Only store the memory pages "
+        "written since the previous checkpoint, referring to that checkpoint "
+        "for the rest. The parent checkpoint must be kept around.")
+    chunked_checkpoints = Param.Bool(False, "Store memory checkpoints as "
+        "independently compressed chunks (zstd if available, zlib "
+        "otherwise), which are written and read in parallel and where "
+        "all-zero chunks are skipped.")
+    raw_checkpoints = Param.Bool(False, "Store memory checkpoints "
+        "uncompressed as sparse files, which can be restored lazily.")
+    lazy_restore = Param.Bool(False, "Map uncompressed memory checkpoints "
+        "copy-on-write rather than reading them, such that pages are only "
+        "read from the checkpoint when touched. The checkpoint files must "
+        "not be modified while simulating.")
+    page_store = Param.String("", "Directory of a content-addressed page "
+        "store shared between checkpoints. If set, the memory contents are "
+        "stored there by hash and each checkpoint only lists the hashes, "
+        "so pages common to several checkpoints are only stored once.")
+    checkpoint_threads = Param.Unsigned(0, "Number of host threads used to "
+        "compress and decompress chunked memory checkpoints, 0 to use all "
+        "host CPUs.")
+    backstore_huge_pages = Param.Bool(False, "Ask the host for transparent "
+        "huge pages for the backing store, which cuts host TLB misses on "
+        "the guest memory.")
+    backstore_hugetlb = Param.Bool(False, "Allocate the backing store from "
+        "the host's reserved hugetlbfs pages. Enough huge pages must be "
+        "reserved for the whole guest memory.")
+    backstore_numa_nodes = VectorParam.Int([], "Host NUMA node to bind each "
+        "backing store to, in the order the stores are created, or -1 to "
+        "leave one unbound. A single node applies to all stores.")
 
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
@@ -128,3 +157,6 @@ class System(SimObject):
     # ISA specific value in this class directly.
     m5ops_base = Param.Addr(0, "Base of the 64KiB PA range used for "
        "memory-mapped m5ops. Set to 0 to disable.")
+    m5ops_ring_base = Param.Addr(0, "Base of the 4KiB PA range, in memory "
+       "reserved from the guest OS, holding the ring of deferred m5ops "
+       "(see include/gem5/m5ring.h). Set to 0 to disable.")
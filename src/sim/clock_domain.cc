@@ -124,6 +124,7 @@ SrcClockDomain::clockPeriod(Tick clock_period)
     }
 
     _clockPeriod = clock_period;
+    _periodDivider.set(clock_period);
 
     DPRINTF(ClockDomain,
             "Setting clock period to %d ticks for source clock %s\n",
@@ -216,6 +217,7 @@ DerivedClockDomain::updateClockPeriod()
     // recalculate the clock period, relying on the fact that changes
     // propagate downwards in the tree
     _clockPeriod = parent.clockPeriod() * clockDivider;
+    _periodDivider.set(_clockPeriod);
 
     DPRINTF(ClockDomain,
             "Setting clock period to %d ticks for derived clock %s\n",
@@ -46,6 +46,7 @@
 
 #include <algorithm>
 
+#include "base/intmath.hh"
 #include "base/statistics.hh"
 #include "params/ClockDomain.hh"
 #include "params/DerivedClockDomain.hh"
@@ -78,6 +79,12 @@ class ClockDomain : public SimObject
      */
     Tick _clockPeriod;
 
+    /**
+     * Divider by the clock period, updated along with it, so that the
+     * members of the domain can convert ticks to cycles cheaply.
+     */
+    InvariantDivider _periodDivider;
+
     /**
      * Voltage domain this clock domain belongs to
      */
@@ -107,6 +114,13 @@ class ClockDomain : public SimObject
      */
     Tick clockPeriod() const { return _clockPeriod; }
 
+    /**
+     * Get a divider by the clock period.
+     *
+     * @return Divider by the clock period in ticks
+     */
+    const InvariantDivider &periodDivider() const { return _periodDivider; }
+
     /**
      * Register a Clocked object with this ClockDomain.
      *
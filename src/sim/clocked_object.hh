@@ -96,7 +96,8 @@ class Clocked
         // if not, we have to recalculate the cycle and tick, we
         // perform the calculations in terms of relative cycles to
         // allow changes to the clock period in the future
-        Cycles elapsedCycles(divCeil(curTick() - tick, clockPeriod()));
+        Cycles elapsedCycles(
+            clockDomain.periodDivider().divCeil(curTick() - tick));
         cycle += elapsedCycles;
         tick += elapsedCycles * clockPeriod();
     }
@@ -136,7 +137,7 @@ class Clocked
     void
     resetClock() const
     {
-        Cycles elapsedCycles(divCeil(curTick(), clockPeriod()));
+        Cycles elapsedCycles(clockDomain.periodDivider().divCeil(curTick()));
         cycle = elapsedCycles;
         tick = elapsedCycles * clockPeriod();
     }
@@ -212,6 +213,24 @@ class Clocked
      */
     Tick nextCycle() const { return clockEdge(Cycles(1)); }
 
+    /**
+     * Determine the ticks of a number of consecutive clock edges, as
+     * needed by pipelined models scheduling several stages at once. The
+     * clock is only aligned once for all of them.
+     *
+     * @param edges Array receiving the ticks of n clock edges.
+     * @param n The number of clock edges.
+     * @param first The first clock edge, as the parameter of clockEdge().
+     */
+    void
+    clockEdges(Tick *edges, size_t n, Cycles first=Cycles(0)) const
+    {
+        Tick edge = clockEdge(first);
+        const Tick period = clockPeriod();
+        for (size_t i = 0; i < n; ++i, edge += period)
+            edges[i] = edge;
+    }
+
     uint64_t frequency() const { return sim_clock::Frequency / clockPeriod(); }
 
     Tick clockPeriod() const { return clockDomain.clockPeriod(); }
@@ -221,7 +240,7 @@ class Clocked
     Cycles
     ticksToCycles(Tick t) const
     {
-        return Cycles(divCeil(t, clockPeriod()));
+        return Cycles(clockDomain.periodDivider().divCeil(t));
     }
 
     Tick cyclesToTicks(Cycles c) const { return clockPeriod() * c; }
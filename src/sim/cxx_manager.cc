@@ -37,8 +37,12 @@
 
 #include "sim/cxx_manager.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <exception>
 #include <sstream>
+#include <thread>
 
 #include "base/str.hh"
 #include "base/trace.hh"
@@ -57,7 +61,7 @@ CxxConfigManager::CxxConfigManager(CxxConfigFileBase &configFile_) :
 
 const CxxConfigDirectoryEntry &
 CxxConfigManager::findObjectType(const std::string &object_name,
-    std::string &object_type)
+    std::string &object_type) const
 {
     if (!configFile.objectExists(object_name))
         throw Exception(object_name, "Can't find sim object");
@@ -78,7 +82,7 @@ CxxConfigManager::findObjectType(const std::string &object_name,
 }
 
 std::string
-CxxConfigManager::rename(const std::string &from_name)
+CxxConfigManager::rename(const std::string &from_name) const
 {
     for (auto i = renamings.begin(); i != renamings.end(); ++ i) {
         const Renaming &renaming = *i;
@@ -93,7 +97,7 @@ CxxConfigManager::rename(const std::string &from_name)
 }
 
 std::string
-CxxConfigManager::unRename(const std::string &to_name)
+CxxConfigManager::unRename(const std::string &to_name) const
 {
     for (auto i = renamings.begin(); i != renamings.end(); ++ i) {
         const Renaming &renaming = *i;
@@ -268,8 +272,20 @@ CxxConfigManager::findObjectParams(const std::string &object_name)
     std::string instance_name = rename(object_name);
 
     /* Already constructed */
-    if (objectParamsByName.find(instance_name) != objectParamsByName.end())
-        return objectParamsByName[instance_name];
+    auto found = objectParamsByName.find(instance_name);
+    if (found != objectParamsByName.end())
+        return found->second;
+
+    CxxConfigParams *object_params = makeObjectParams(object_name);
+    objectParamsByName[instance_name] = object_params;
+
+    return object_params;
+}
+
+CxxConfigParams *
+CxxConfigManager::makeObjectParams(const std::string &object_name) const
+{
+    std::string instance_name = rename(object_name);
 
     std::string object_type;
     const CxxConfigDirectoryEntry &entry =
@@ -405,17 +421,78 @@ CxxConfigManager::findObjectParams(const std::string &object_name)
         throw;
     }
 
-    objectParamsByName[instance_name] = object_params;
-
     return object_params;
 }
 
 void
-CxxConfigManager::findAllObjects()
+CxxConfigManager::findAllObjectParams(const std::string &object_name,
+    unsigned num_threads)
 {
-    std::vector<std::string> objects;
-    configFile.getAllObjectNames(objects);
+    /* Collect the objects which don't have their ...Params yet, in
+     *  traversal order */
+    std::vector<std::string> names;
+    std::vector<std::string> to_visit(1, object_name);
+    std::set<std::string> seen;
+    while (!to_visit.empty()) {
+        std::string current = std::move(to_visit.back());
+        to_visit.pop_back();
+
+        if (!configFile.objectExists(current) || !seen.insert(current).second)
+            continue;
+        if (objectParamsByName.find(rename(current)) ==
+            objectParamsByName.end())
+        {
+            names.push_back(current);
+        }
 
+        std::vector<std::string> children;
+        configFile.getObjectChildren(current, children, true);
+        to_visit.insert(to_visit.end(), children.rbegin(), children.rend());
+    }
+
+    /* The debug output of the workers would be interleaved */
+    if (debug::CxxConfig)
+        num_threads = 1;
+    num_threads = std::max(1u, std::min<unsigned>(num_threads,
+        names.size()));
+
+    std::vector<CxxConfigParams *> params(names.size(), nullptr);
+    std::vector<std::exception_ptr> errors(names.size());
+    std::atomic<std::size_t> next(0);
+
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < names.size(); i = next++) {
+            try {
+                params[i] = makeObjectParams(names[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < num_threads; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &thread : threads)
+        thread.join();
+
+    for (std::size_t i = 0; i < names.size(); i++) {
+        if (params[i])
+            objectParamsByName[rename(names[i])] = params[i];
+    }
+
+    /* Report the first failure in traversal order, as a serial walk
+     *  would have */
+    for (auto &error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+void
+CxxConfigManager::findAllObjects()
+{
     /* Set the traversal order for further iterators */
     objectsInOrder.clear();
     findTraversalOrder("root");
@@ -592,9 +669,10 @@ CxxConfigManager::forEachObject(void (SimObject::*mem_func)())
 }
 
 void
-CxxConfigManager::instantiate(bool build_all)
+CxxConfigManager::instantiate(bool build_all, unsigned num_threads)
 {
     if (build_all) {
+        findAllObjectParams("root", num_threads);
         findAllObjects();
         bindAllPorts();
     }
@@ -141,11 +141,17 @@ class CxxConfigManager
         const std::vector<std::string> &peers);
 
     /** Apply the first matching renaming in renamings to the given name */
-    std::string rename(const std::string &from_name);
+    std::string rename(const std::string &from_name) const;
 
     /** Apply the first matching renaming in reverse (toPrefix -> fromPrefix
      *  for the given name */
-    std::string unRename(const std::string &to_name);
+    std::string unRename(const std::string &to_name) const;
+
+    /** Make and fill in a new ...Params object for the named object
+     *  without recording it in objectParamsByName.  This only reads the
+     *  config file and the manager's state, so it can be called for
+     *  several objects in parallel. */
+    CxxConfigParams *makeObjectParams(const std::string &object_name) const;
 
   protected:
     /** Bind the ports of all the objects in objectInOrder order.
@@ -178,7 +184,7 @@ class CxxConfigManager
      *  name of the type to object_type and the object's directory
      *  entry as the return value */
     const CxxConfigDirectoryEntry &findObjectType(
-        const std::string &object_name, std::string &object_type);
+        const std::string &object_name, std::string &object_type) const;
 
     /** Add a name prefix renaming to those currently applied.  Call this
      *  before trying to instantiate any object as the name mappings are
@@ -228,6 +234,15 @@ class CxxConfigManager
      *  objectParamsByName[object_name] */
     CxxConfigParams *findObjectParams(const std::string &object_name);
 
+    /** Call findObjectParams on all the objects in the tree of children
+     *  below object_name.  The ...Params objects are built by num_threads
+     *  threads, as filling them in means parsing all the parameter
+     *  values of the config file.  The SimObjects themselves are still
+     *  constructed serially, by findObject, as their constructors
+     *  register with global state such as the stats and event queues */
+    void findAllObjectParams(const std::string &object_name,
+        unsigned num_threads);
+
     /** Populate objectsInOrder with a preorder, depth first traversal from
      *  the given object name down through all its children */
     void findTraversalOrder(const std::string &object_name);
@@ -274,8 +289,11 @@ class CxxConfigManager
      *
      *  If you want to set some parameters before completing instantiation,
      *  call findObjectParams on the objects you want to modify, then call
-     *  instantiate */
-    void instantiate(bool build_all = true);
+     *  instantiate.
+     *
+     *  When building all objects, num_threads threads are used to fill in
+     *  the ...Params objects (see findAllObjectParams) */
+    void instantiate(bool build_all = true, unsigned num_threads = 1);
 
     /** Call initState on all objects */
     void initState();
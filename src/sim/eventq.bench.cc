@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Event that schedules itself again when it is processed. */
+class RepeatEvent : public Event
+{
+  private:
+    EventQueue &eq;
+    const Tick delay;
+
+  public:
+    RepeatEvent(EventQueue &_eq, Tick _delay) : eq(_eq), delay(_delay) {}
+
+    void process() override { eq.schedule(this, eq.getCurTick() + delay); }
+};
+
+/**
+ * Service events from a queue that holds a constant number of them, so
+ * each iteration is one serviceOne() plus one schedule().
+ */
+void
+BM_ScheduleService(benchmark::State &state, EventQueue::Backend backend)
+{
+    EventQueue eq("bench_queue");
+    eq.backend(backend);
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<Tick> delay(1, 10000);
+    std::vector<std::unique_ptr<RepeatEvent>> events;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        events.emplace_back(new RepeatEvent(eq, delay(rng)));
+        eq.schedule(events.back().get(), delay(rng));
+    }
+
+    for (auto _ : state)
+        eq.serviceOne();
+    state.SetItemsProcessed(state.iterations());
+
+    for (auto &event : events)
+        eq.deschedule(event.get());
+}
+
+BENCHMARK_CAPTURE(BM_ScheduleService, SortedList,
+                  EventQueue::SortedListBackend)->Range(8, 8 << 10);
+BENCHMARK_CAPTURE(BM_ScheduleService, Calendar,
+                  EventQueue::CalendarBackend)->Range(8, 8 << 10);
+
+/** Schedule and deschedule an event in a queue of a given depth. */
+void
+BM_ScheduleDeschedule(benchmark::State &state)
+{
+    EventQueue eq("bench_queue");
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<Tick> delay(1, 10000);
+    std::vector<std::unique_ptr<RepeatEvent>> events;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        events.emplace_back(new RepeatEvent(eq, 1));
+        eq.schedule(events.back().get(), delay(rng));
+    }
+
+    RepeatEvent event(eq, 1);
+    for (auto _ : state) {
+        eq.schedule(&event, delay(rng));
+        eq.deschedule(&event);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    for (auto &e : events)
+        eq.deschedule(e.get());
+}
+
+BENCHMARK(BM_ScheduleDeschedule)->Range(8, 8 << 10);
+
+} // anonymous namespace
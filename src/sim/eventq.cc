@@ -30,7 +30,9 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -46,6 +48,7 @@ namespace gem5
 {
 
 Tick simQuantum = 0;
+Tick simQuantumMax = 0;
 
 //
 // Main Event Queues
@@ -58,6 +61,15 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+//! Backend used for newly created main event queues.
+static EventQueue::Backend mainEventQueueBackend =
+    EventQueue::SortedListBackend;
+
+//! Whether newly created main event queues are profiled.
+static bool mainEventQueueProfiling = false;
+static unsigned mainEventQueueProfilePeriod = 1;
+static bool mainEventQueueProfileCounters = false;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
@@ -65,11 +77,39 @@ getEventQueue(uint32_t index)
         numMainEventQueues++;
         mainEventQueue.push_back(
             new EventQueue(csprintf("MainEventQueue-%d", index)));
+        mainEventQueue.back()->backend(mainEventQueueBackend);
+        mainEventQueue.back()->profile(mainEventQueueProfiling);
+        mainEventQueue.back()->profileSamplePeriod(
+                mainEventQueueProfilePeriod);
+        mainEventQueue.back()->profileHostCounters(
+                mainEventQueueProfileCounters);
     }
 
     return mainEventQueue[index];
 }
 
+void
+setMainEventQueueBackend(EventQueue::Backend backend)
+{
+    mainEventQueueBackend = backend;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->backend(backend);
+}
+
+void
+setMainEventQueueProfiling(bool enable, unsigned sample_period,
+                           bool host_counters)
+{
+    mainEventQueueProfiling = enable;
+    mainEventQueueProfilePeriod = sample_period;
+    mainEventQueueProfileCounters = host_counters;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        mainEventQueue[i]->profile(enable);
+        mainEventQueue[i]->profileSamplePeriod(sample_period);
+        mainEventQueue[i]->profileHostCounters(host_counters);
+    }
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -111,6 +151,11 @@ Event::insertBefore(Event *event, Event *curr)
 void
 EventQueue::insert(Event *event)
 {
+    if (calendar) {
+        calendarInsert(event);
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -170,6 +215,11 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (calendar) {
+        calendarRemove(event);
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -194,6 +244,321 @@ EventQueue::remove(Event *event)
     prev->nextBin = Event::removeItem(event, curr);
 }
 
+namespace
+{
+
+//! Smallest number of buckets of an event calendar.
+const size_t minCalendarBuckets = 16;
+//! Initial bucket width of an event calendar (1024 ticks).
+const unsigned initialCalendarShift = 10;
+//! Number of bins sampled to estimate the calendar bucket width.
+const size_t calendarWidthSamples = 25;
+
+bool
+binOrder(const Event *l, const Event *r)
+{
+    return *l < *r;
+}
+
+} // anonymous namespace
+
+EventCalendar::EventCalendar()
+    : buckets(minCalendarBuckets), shift(initialCalendarShift),
+      numBins(0), curBucket(0), curWindow(0)
+{
+}
+
+EventCalendar::Bucket::iterator
+EventCalendar::lowerBound(Bucket &bucket, const Event *key)
+{
+    // Buckets are sorted in descending order, find the first bin that
+    // would be serviced no later than the key.
+    return std::lower_bound(bucket.begin(), bucket.end(), key,
+            [](const Event *bin, const Event *key) { return *bin > *key; });
+}
+
+void
+EventCalendar::resize(size_t num_buckets)
+{
+    std::vector<Event *> bins = sorted();
+
+    // Estimate the bucket width as three times the average separation
+    // between the earliest distinct ticks, ignoring large outliers.
+    std::vector<Tick> gaps;
+    for (size_t i = 1; i < bins.size() && gaps.size() < calendarWidthSamples;
+         ++i) {
+        if (bins[i]->when() != bins[i - 1]->when())
+            gaps.push_back(bins[i]->when() - bins[i - 1]->when());
+    }
+
+    const unsigned old_shift = shift;
+    if (!gaps.empty()) {
+        Tick total = 0;
+        for (Tick gap : gaps)
+            total += gap;
+        const Tick average = total / gaps.size();
+
+        Tick trimmed_total = 0;
+        size_t trimmed_count = 0;
+        for (Tick gap : gaps) {
+            if (gap <= 2 * average) {
+                trimmed_total += gap;
+                trimmed_count++;
+            }
+        }
+
+        const Tick width = 3 * (trimmed_total / trimmed_count);
+        shift = 0;
+        while (shift < 63 && (Tick(1) << shift) < width)
+            shift++;
+    }
+
+    buckets.assign(num_buckets, Bucket());
+    // Insert the latest bins first so that every bucket ends up
+    // sorted in descending order.
+    for (auto it = bins.rbegin(); it != bins.rend(); ++it)
+        bucketOf(*it).push_back(*it);
+
+    if (bins.empty()) {
+        curWindow = (curWindow << old_shift) >> shift;
+    } else {
+        curWindow = bins.front()->when() >> shift;
+    }
+    curBucket = curWindow & (buckets.size() - 1);
+}
+
+void
+EventCalendar::insert(Event *bin)
+{
+    Bucket &bucket = bucketOf(bin);
+    bucket.insert(lowerBound(bucket, bin), bin);
+    numBins++;
+
+    const Tick window = bin->when() >> shift;
+    if (window < curWindow) {
+        curWindow = window;
+        curBucket = bucketIndex(bin->when());
+    }
+
+    if (numBins > 2 * buckets.size())
+        resize(2 * buckets.size());
+}
+
+void
+EventCalendar::remove(Event *bin)
+{
+    Bucket &bucket = bucketOf(bin);
+    auto it = lowerBound(bucket, bin);
+    if (it == bucket.end() || *it != bin)
+        panic("event not found!");
+
+    bucket.erase(it);
+    numBins--;
+
+    if (buckets.size() > minCalendarBuckets && numBins < buckets.size() / 2)
+        resize(buckets.size() / 2);
+}
+
+void
+EventCalendar::replace(Event *old_top, Event *new_top)
+{
+    assert(*old_top == *new_top);
+
+    Bucket &bucket = bucketOf(old_top);
+    auto it = lowerBound(bucket, old_top);
+    if (it == bucket.end() || *it != old_top)
+        panic("event not found!");
+
+    *it = new_top;
+}
+
+Event *
+EventCalendar::find(const Event *event)
+{
+    Bucket &bucket = bucketOf(event);
+    auto it = lowerBound(bucket, event);
+    return (it != bucket.end() && **it == *event) ? *it : nullptr;
+}
+
+Event *
+EventCalendar::removeMin()
+{
+    if (numBins == 0)
+        return nullptr;
+
+    // Scan at most one year of the calendar starting at the bucket
+    // of the last bin that was removed.
+    const size_t mask = buckets.size() - 1;
+    Bucket *found = nullptr;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        Bucket &bucket = buckets[curBucket];
+        if (!bucket.empty() && (bucket.back()->when() >> shift) == curWindow) {
+            found = &bucket;
+            break;
+        }
+        curBucket = (curBucket + 1) & mask;
+        curWindow++;
+    }
+
+    if (!found) {
+        // The calendar is sparse compared to its width, fall back to
+        // a direct search for the earliest bin.
+        for (Bucket &bucket : buckets) {
+            if (!bucket.empty() &&
+                (!found || *bucket.back() < *found->back())) {
+                found = &bucket;
+            }
+        }
+        curWindow = found->back()->when() >> shift;
+        curBucket = curWindow & mask;
+    }
+
+    Event *bin = found->back();
+    found->pop_back();
+    numBins--;
+
+    if (buckets.size() > minCalendarBuckets && numBins < buckets.size() / 2)
+        resize(buckets.size() / 2);
+
+    return bin;
+}
+
+Event *
+EventCalendar::unlinkAll()
+{
+    std::vector<Event *> bins = sorted();
+    for (Bucket &bucket : buckets)
+        bucket.clear();
+    numBins = 0;
+
+    Event *next = nullptr;
+    for (auto it = bins.rbegin(); it != bins.rend(); ++it) {
+        (*it)->nextBin = next;
+        next = *it;
+    }
+
+    return next;
+}
+
+std::vector<Event *>
+EventCalendar::sorted() const
+{
+    std::vector<Event *> bins;
+    bins.reserve(numBins);
+    for (const Bucket &bucket : buckets)
+        bins.insert(bins.end(), bucket.begin(), bucket.end());
+    std::sort(bins.begin(), bins.end(), binOrder);
+    return bins;
+}
+
+void
+EventQueue::calendarInsert(Event *event)
+{
+    // When using the calendar, bins are never linked through
+    // 'nextBin'. The head bin is kept out of the calendar so that
+    // servicing events from the same bin doesn't touch it.
+    event->nextBin = nullptr;
+
+    if (!head || *event < *head) {
+        if (head)
+            calendar->insert(head);
+        event->nextInBin = nullptr;
+        head = event;
+    } else if (*event == *head) {
+        event->nextInBin = head;
+        head = event;
+    } else if (Event *top = calendar->find(event)) {
+        event->nextInBin = top;
+        calendar->replace(top, event);
+    } else {
+        event->nextInBin = nullptr;
+        calendar->insert(event);
+    }
+}
+
+void
+EventQueue::calendarRemove(Event *event)
+{
+    if (*head == *event) {
+        head = Event::removeItem(event, head);
+        if (!head)
+            head = calendar->removeMin();
+        return;
+    }
+
+    Event *top = calendar->find(event);
+    if (!top)
+        panic("event not found!");
+
+    // removeItem() returns the (null) 'nextBin' pointer of the bin
+    // when removing its last event.
+    Event *new_top = Event::removeItem(event, top);
+    if (!new_top)
+        calendar->remove(top);
+    else if (new_top != top)
+        calendar->replace(top, new_top);
+}
+
+Event *
+EventQueue::unlinkBins()
+{
+    Event *bins = head;
+    if (calendar && head)
+        head->nextBin = calendar->unlinkAll();
+    head = nullptr;
+    return bins;
+}
+
+void
+EventQueue::linkBins(Event *bins)
+{
+    assert(!head);
+    head = bins;
+    if (!calendar || !head)
+        return;
+
+    Event *bin = head->nextBin;
+    head->nextBin = nullptr;
+    while (bin) {
+        Event *next = bin->nextBin;
+        bin->nextBin = nullptr;
+        calendar->insert(bin);
+        bin = next;
+    }
+}
+
+void
+EventQueue::backend(Backend b)
+{
+    if (b == backend())
+        return;
+
+    Event *bins = unlinkBins();
+    if (b == CalendarBackend)
+        calendar.reset(new EventCalendar());
+    else
+        calendar.reset();
+    linkBins(bins);
+}
+
+std::vector<Event *>
+EventQueue::bins() const
+{
+    std::vector<Event *> all;
+    if (!head)
+        return all;
+
+    if (calendar) {
+        all.push_back(head);
+        std::vector<Event *> rest = calendar->sorted();
+        all.insert(all.end(), rest.begin(), rest.end());
+    } else {
+        for (Event *bin = head; bin; bin = bin->nextBin)
+            all.push_back(bin);
+    }
+    return all;
+}
+
 Event *
 EventQueue::serviceOne()
 {
@@ -211,7 +576,7 @@ EventQueue::serviceOne()
     } else {
         // this was the only element on the 'in bin' list, so get rid of
         // the 'in bin' list and point to the next bin list
-        head = head->nextBin;
+        head = calendar ? calendar->removeMin() : head->nextBin;
     }
 
     // handle action
@@ -220,7 +585,11 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        _numServiced++;
+        if (profileEnabled)
+            processProfiled(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -235,6 +604,115 @@ EventQueue::serviceOne()
     return NULL;
 }
 
+void
+EventQueue::profileSamplePeriod(unsigned period)
+{
+    fatal_if(period == 0, "%s: The profile sample period must be at "
+             "least one.\n", name());
+    profilePeriod = period;
+    profileCountdown = 1;
+}
+
+void
+EventQueue::processProfiled(Event *event)
+{
+    if (--profileCountdown) {
+        event->process();
+        return;
+    }
+
+    // Draw the next interval uniformly from [1, 2 * period - 1], so the
+    // samples don't lock onto events recurring with a fixed stride.
+    profileCountdown = 1;
+    if (profilePeriod > 1) {
+        profileRandom ^= profileRandom << 13;
+        profileRandom ^= profileRandom >> 7;
+        profileRandom ^= profileRandom << 17;
+        profileCountdown += profileRandom % (2 * profilePeriod - 1);
+    }
+
+    // The counters have to be opened by the thread servicing the queue.
+    if (profileCountersEnabled && !hostCounters.isOpen() &&
+            !hostCounters.open()) {
+        warn("%s: Host performance counters are not available.\n",
+             name());
+        profileCountersEnabled = false;
+    }
+
+    // Look the entry up first since some events delete themselves in
+    // process().
+    ProfileEntry &entry = profileData[event->name()];
+
+    uint64_t before[HostCounters::NumCounters];
+    uint64_t after[HostCounters::NumCounters];
+    if (profileCountersEnabled)
+        hostCounters.read(before);
+    const auto start = std::chrono::steady_clock::now();
+    event->process();
+    const auto end = std::chrono::steady_clock::now();
+    if (profileCountersEnabled)
+        hostCounters.read(after);
+
+    // Every sample stands for a period's worth of events.
+    entry.hostNs += profilePeriod *
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end - start).count();
+    entry.calls += profilePeriod;
+    if (profileCountersEnabled) {
+        for (int i = 0; i < HostCounters::NumCounters; i++)
+            entry.counters[i] += profilePeriod * (after[i] - before[i]);
+    }
+}
+
+void
+EventQueue::dumpProfile(std::ostream &os) const
+{
+    std::vector<std::pair<std::string, ProfileEntry>> entries(
+            profileData.begin(), profileData.end());
+    std::sort(entries.begin(), entries.end(),
+        [](const auto &l, const auto &r) {
+            return l.second.hostNs > r.second.hostNs ||
+                (l.second.hostNs == r.second.hostNs && l.first < r.first);
+        });
+
+    ProfileEntry total;
+    for (const auto &entry : entries) {
+        total.hostNs += entry.second.hostNs;
+        total.calls += entry.second.calls;
+        for (int i = 0; i < HostCounters::NumCounters; i++)
+            total.counters[i] += entry.second.counters[i];
+    }
+
+    ccprintf(os, "---------- Begin %s profile (tick %d) ----------\n",
+             name(), getCurTick());
+    if (profilePeriod > 1)
+        ccprintf(os, "Estimated from one in %d events\n", profilePeriod);
+    ccprintf(os, "%16s %14s %10s %7s", "host_ns", "calls", "ns/call", "%");
+    if (profileCountersEnabled) {
+        ccprintf(os, " %16s %16s %14s", "host_cycles", "host_insts",
+                 "cache_misses");
+    }
+    ccprintf(os, "  %s\n", "event");
+
+    auto print = [&](const std::string &name, const ProfileEntry &data) {
+        ccprintf(os, "%16d %14d %10.1f %7.2f",
+                 data.hostNs, data.calls,
+                 data.calls ? double(data.hostNs) / data.calls : 0.0,
+                 total.hostNs ? 100.0 * data.hostNs / total.hostNs : 0.0);
+        if (profileCountersEnabled) {
+            ccprintf(os, " %16d %16d %14d",
+                     data.counters[HostCounters::Cycles],
+                     data.counters[HostCounters::Instructions],
+                     data.counters[HostCounters::CacheMisses]);
+        }
+        ccprintf(os, "  %s\n", name);
+    };
+    for (const auto &entry : entries)
+        print(entry.first, entry.second);
+    print("total", total);
+    ccprintf(os, "---------- End %s profile ----------\n\n", name());
+}
+
 void
 Event::serialize(CheckpointOut &cp) const
 {
@@ -295,15 +773,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
-            Event *nextInBin = nextBin;
+        for (Event *bin : bins()) {
+            Event *nextInBin = bin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -316,11 +791,10 @@ EventQueue::debugVerify() const
     std::unordered_map<long, bool> map;
 
     Tick time = 0;
-    short priority = 0;
+    short priority = Event::Minimum_Pri;
 
-    Event *nextBin = head;
-    while (nextBin) {
-        Event *nextInBin = nextBin;
+    for (Event *bin : bins()) {
+        Event *nextInBin = bin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
                 cprintf("time goes backwards!");
@@ -345,8 +819,6 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
@@ -355,8 +827,8 @@ EventQueue::debugVerify() const
 Event*
 EventQueue::replaceHead(Event* s)
 {
-    Event* t = head;
-    head = s;
+    Event* t = unlinkBins();
+    linkBins(s);
     return t;
 }
 
@@ -416,30 +888,108 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), pooledFreeList(nullptr),
+      _numServiced(0), profileEnabled(false)
 {
 }
 
+PooledFunctionEvent *
+EventQueue::allocPooled()
+{
+    // The free list may only be touched by the thread servicing this
+    // queue. Other threads fall back to the heap.
+    if (inParallelMode && this != curEventQueue())
+        return new PooledFunctionEvent();
+
+    if (!pooledFreeList) {
+        pooledChunks.emplace_back(new PooledFunctionEvent[pooledChunkSize]);
+        PooledFunctionEvent *chunk = pooledChunks.back().get();
+        for (size_t i = 0; i < pooledChunkSize; i++) {
+            chunk[i].owner = this;
+            chunk[i].nextFree = pooledFreeList;
+            pooledFreeList = &chunk[i];
+        }
+    }
+
+    PooledFunctionEvent *event = pooledFreeList;
+    pooledFreeList = event->nextFree;
+    event->nextFree = nullptr;
+    return event;
+}
+
+void
+EventQueue::freePooled(PooledFunctionEvent *event)
+{
+    assert(event->owner == this);
+    event->nextFree = pooledFreeList;
+    pooledFreeList = event;
+}
+
+void
+PooledFunctionEvent::releaseImpl()
+{
+    if (scheduled())
+        return;
+
+    destroyFn(callable);
+    destroyFn = nullptr;
+    invokeFn = nullptr;
+
+    if (owner)
+        owner->freePooled(this);
+    else
+        delete this;
+}
+
 void
 EventQueue::asyncInsert(Event *event)
 {
-    async_queue_mutex.lock();
-    async_queue.push_back(event);
-    async_queue_mutex.unlock();
+    if (!event->globalEvent())
+        numAsyncInserts.fetch_add(1, std::memory_order_relaxed);
+
+    Event *top = async_queue.load(std::memory_order_relaxed);
+    do {
+        event->nextInBin = top;
+    } while (!async_queue.compare_exchange_weak(top, event,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    Event *top = async_queue.exchange(nullptr, std::memory_order_acquire);
+
+    // Reverse the stack so that events are inserted in the order they
+    // were scheduled. Global events rely on this to keep the same order
+    // on every queue.
+    Event *event = nullptr;
+    while (top) {
+        Event *next = top->nextInBin;
+        top->nextInBin = event;
+        event = top;
+        top = next;
     }
 
-    async_queue_mutex.unlock();
+    while (event) {
+        Event *next = event->nextInBin;
+        // With an adaptive quantum, an event may have been aimed at a
+        // tick this queue has already passed. Service it right away.
+        if (event->when() < getCurTick()) {
+            assert(simQuantumMax > simQuantum);
+            event->setWhen(getCurTick(), this);
+        }
+        insert(event);
+        event = next;
+    }
+}
+
+uint64_t
+EventQueue::asyncInsertions()
+{
+    return numAsyncInserts.load(std::memory_order_relaxed);
 }
 
 } // namespace gem5
@@ -37,15 +37,22 @@
 
 #include <algorithm>
 #include <cassert>
+#include <atomic>
 #include <climits>
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
-#include <list>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
+#include "base/host_counters.hh"
 #include "base/types.hh"
 #include "base/uncontended_mutex.hh"
 #include "debug/Event.hh"
@@ -65,6 +72,14 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+//! Upper bound of the adaptive simulation quantum. When larger than
+//! simQuantum, the quantum doubles after every quantum in which no
+//! events were exchanged between queues, up to this value, and drops
+//! back to simQuantum as soon as queues communicate again. Events that
+//! end up behind the receiving queue because of this are serviced at
+//! the start of the next quantum.
+extern Tick simQuantumMax;
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -251,6 +266,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class EventCalendar;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -581,6 +597,143 @@ operator!=(const Event &l, const Event &r)
     return l.when() != r.when() || l.priority() != r.priority();
 }
 
+/**
+ * Calendar queue (R. Brown, CACM 1988) of event bins.
+ *
+ * The calendar stores the top event of each bin (a bin being all
+ * events sharing the same when+priority) in an array of buckets, each
+ * covering a power-of-two number of ticks. A bucket holds the bins
+ * that fall into it sorted in descending order, so the earliest bin
+ * of a bucket sits at its back. The number of buckets and their width
+ * are adapted as the number of bins changes, which gives amortized
+ * constant time insertion and removal as long as the distribution of
+ * event times does not change abruptly.
+ *
+ * The calendar only deals with bins. The events within a bin are
+ * still kept in the 'nextInBin' stack managed by EventQueue, which
+ * preserves the exact servicing order of the sorted list backend.
+ */
+class EventCalendar
+{
+  private:
+    typedef std::vector<Event *> Bucket;
+
+    std::vector<Bucket> buckets;
+    //! log2 of the width of a bucket in ticks
+    unsigned shift;
+    //! Number of bins stored in the calendar
+    size_t numBins;
+    //! Bucket the next removeMin() starts looking from
+    size_t curBucket;
+    //! Virtual bucket number (when >> shift) of curBucket
+    Tick curWindow;
+
+    size_t bucketIndex(Tick when) const
+    {
+        return (when >> shift) & (buckets.size() - 1);
+    }
+
+    Bucket &
+    bucketOf(const Event *bin)
+    {
+        return buckets[bucketIndex(bin->when())];
+    }
+
+    Bucket::iterator lowerBound(Bucket &bucket, const Event *key);
+
+    /** Redistribute all bins over a calendar of the given size. */
+    void resize(size_t num_buckets);
+
+  public:
+    EventCalendar();
+
+    bool empty() const { return numBins == 0; }
+    size_t size() const { return numBins; }
+
+    /** Add a new bin to the calendar. */
+    void insert(Event *bin);
+
+    /** Remove the bin topped by the given event from the calendar. */
+    void remove(Event *bin);
+
+    /** Replace the top event of a bin already in the calendar. */
+    void replace(Event *old_top, Event *new_top);
+
+    /**
+     * Find the bin matching the when+priority of an event.
+     *
+     * @return Top event of the bin or nullptr if there is no such bin.
+     */
+    Event *find(const Event *event);
+
+    /** Remove and return the earliest bin, nullptr if empty. */
+    Event *removeMin();
+
+    /** Remove all bins and link them in order through 'nextBin'. */
+    Event *unlinkAll();
+
+    /** Get all bins sorted in servicing order. */
+    std::vector<Event *> sorted() const;
+};
+
+/**
+ * Auto-delete event running a callable that is stored inline.
+ *
+ * These events are handed out by EventQueue::schedulePooled(). Once
+ * they have been serviced or descheduled they go back to a free list
+ * owned by their event queue instead of being returned to the heap,
+ * so short-lived events don't need any dynamic memory allocation.
+ */
+class PooledFunctionEvent : public Event
+{
+  public:
+    /** Largest callable (e.g., lambda and its captures) supported. */
+    static const size_t MaxCallableSize = 48;
+
+  private:
+    friend class EventQueue;
+
+    alignas(std::max_align_t) unsigned char callable[MaxCallableSize];
+    void (*invokeFn)(void *);
+    void (*destroyFn)(void *);
+    const char *_name;
+
+    //! Queue owning this event, nullptr if allocated from the heap.
+    EventQueue *owner;
+    //! Next event in the free list of the owner.
+    PooledFunctionEvent *nextFree;
+
+    template <typename F>
+    void
+    set(F &&f, const char *name)
+    {
+        typedef typename std::decay<F>::type Callable;
+        static_assert(sizeof(Callable) <= MaxCallableSize,
+                      "Callable too large for a pooled event");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t),
+                      "Callable over-aligned for a pooled event");
+
+        new (callable) Callable(std::forward<F>(f));
+        invokeFn = [](void *c) { (*static_cast<Callable *>(c))(); };
+        destroyFn = [](void *c) { static_cast<Callable *>(c)->~Callable(); };
+        _name = name;
+    }
+
+  protected:
+    void releaseImpl() override;
+
+  public:
+    PooledFunctionEvent()
+        : Event(Default_Pri, AutoDelete), invokeFn(nullptr),
+          destroyFn(nullptr), _name(""), owner(nullptr), nextFree(nullptr)
+    {}
+
+    void process() override { invokeFn(callable); }
+
+    const std::string name() const override { return _name; }
+    const char *description() const override { return "PooledFunction"; }
+};
+
 /**
  * Queue of events sorted in time order
  *
@@ -621,6 +774,31 @@ operator!=(const Event &l, const Event &r)
  */
 class EventQueue
 {
+  public:
+    /**
+     * Data structures available to keep the bins of the queue sorted.
+     *
+     * Both backends service events in exactly the same order. The
+     * sorted list is cheap when few distinct ticks are pending, the
+     * calendar queue scales to many distinct pending ticks.
+     *
+     * @ingroup api_eventq
+     */
+    enum Backend
+    {
+        SortedListBackend,
+        CalendarBackend
+    };
+
+    /** Host cost of servicing the events sharing a name. */
+    struct ProfileEntry
+    {
+        uint64_t hostNs = 0;
+        uint64_t calls = 0;
+        //! Host performance counter deltas, indexed by counter.
+        uint64_t counters[HostCounters::NumCounters] = {};
+    };
+
   private:
     friend void curEventQueue(EventQueue *);
 
@@ -628,11 +806,75 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
-    //! Mutex to protect async queue.
-    UncontendedMutex async_queue_mutex;
+    //! Bins other than the head one when using the calendar backend,
+    //! nullptr when bins are linked in a sorted list.
+    std::unique_ptr<EventCalendar> calendar;
+
+    //! Calendar backend versions of insert() and remove().
+    void calendarInsert(Event *event);
+    void calendarRemove(Event *event);
+
+    //! Detach all events from the queue, returning them as a sorted
+    //! list of bins.
+    Event *unlinkBins();
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    //! Attach a sorted list of bins to an empty queue.
+    void linkBins(Event *bins);
+
+    //! Top events of all bins in servicing order (for debugging).
+    std::vector<Event *> bins() const;
+
+    //! Number of events allocated at once when the pool is empty.
+    static const size_t pooledChunkSize = 64;
+
+    //! Free events available to schedulePooled().
+    PooledFunctionEvent *pooledFreeList;
+    //! Storage for all the pooled events owned by this queue.
+    std::vector<std::unique_ptr<PooledFunctionEvent[]>> pooledChunks;
+
+    //! Get an unused pooled event, either from the free list or, if
+    //! called from a thread not owning the queue, from the heap.
+    PooledFunctionEvent *allocPooled();
+
+    //! Return an event allocated by allocPooled() to the free list.
+    void freePooled(PooledFunctionEvent *event);
+
+    friend class PooledFunctionEvent;
+
+    //! Number of events serviced since the queue was created.
+    uint64_t _numServiced;
+
+    //! Whether host time is collected for every event serviced.
+    bool profileEnabled;
+    //! Host time spent per event name since the last profile reset.
+    std::unordered_map<std::string, ProfileEntry> profileData;
+
+    //! Profile one in this many events on average.
+    unsigned profilePeriod = 1;
+    //! Events left until the next one is profiled.
+    unsigned profileCountdown = 1;
+    //! State of the generator randomizing the sampling intervals.
+    uint64_t profileRandom = 0x9e3779b97f4a7c15ULL;
+
+    //! Whether the host counters are read around the profiled events.
+    bool profileCountersEnabled = false;
+    //! Counters of the thread servicing this queue, opened on first use.
+    HostCounters hostCounters;
+
+    //! Process an event and account the host time it took.
+    void processProfiled(Event *event);
+
+    /**
+     * Events added by other threads to this event queue, most recent
+     * first. This is a lock-free stack linked through the events'
+     * nextInBin pointers, which are unused until the events are
+     * inserted in the queue. Producers push with a CAS and the owning
+     * thread takes the whole stack at once.
+     */
+    std::atomic<Event *> async_queue{nullptr};
+
+    //! Number of non-global events ever added to async_queue.
+    std::atomic<uint64_t> numAsyncInserts{0};
 
     /**
      * Lock protecting event handling.
@@ -755,6 +997,61 @@ class EventQueue
     void name(const std::string &st) { objName = st; }
     /** @}*/ //end of api_eventq group
 
+    /**
+     * Select the data structure used to keep events sorted. Events
+     * that are already scheduled are migrated to the new backend.
+     *
+     * @ingroup api_eventq
+     */
+    void backend(Backend b);
+    Backend
+    backend() const
+    {
+        return calendar ? CalendarBackend : SortedListBackend;
+    }
+
+    /**
+     * Enable or disable collecting the host time and number of calls
+     * of the events serviced by this queue, aggregated by event name.
+     *
+     * @ingroup api_eventq
+     * @{
+     */
+    void profile(bool enable) { profileEnabled = enable; }
+    bool profiling() const { return profileEnabled; }
+    /** @}*/
+
+    /**
+     * Only profile one in this many events on average. The profile
+     * scales the samples up to estimate the cost of all the events.
+     */
+    void profileSamplePeriod(unsigned period);
+
+    /**
+     * Also read the host cycle, instruction and cache miss counters
+     * around the profiled events, if the host provides them.
+     */
+    void profileHostCounters(bool enable) { profileCountersEnabled = enable; }
+
+    /** The profile collected so far, indexed by event name. */
+    const std::unordered_map<std::string, ProfileEntry> &
+    getProfile() const
+    {
+        return profileData;
+    }
+
+    /**
+     * Print the collected profile as a table sorted by decreasing
+     * host time.
+     */
+    void dumpProfile(std::ostream &os) const;
+
+    /** Discard the collected profile. */
+    void resetProfile() { profileData.clear(); }
+
+    /** Number of events serviced by this queue since its creation. */
+    uint64_t numServiced() const { return _numServiced; }
+
     /**
      * Schedule the given event on this queue. Safe to call from any thread.
      *
@@ -776,18 +1073,46 @@ class EventQueue
         //    this event belongs to this eventq. This is required to maintain
         //    a total order amongst the global events. See global_event.{cc,hh}
         //    for more explanation.
+        //
+        // The event is marked as scheduled first, since the owning
+        // thread may pick it up as soon as it is in the asyncq.
+        event->flags.set(Event::Scheduled);
+        event->acquire();
         if (inParallelMode && (this != curEventQueue() || global)) {
             asyncInsert(event);
         } else {
             insert(event);
         }
-        event->flags.set(Event::Scheduled);
-        event->acquire();
 
         if (debug::Event)
             event->trace("scheduled");
     }
 
+    /**
+     * Schedule a callable to be run at the given tick by an event taken
+     * from this queue's pool of auto-delete events. This avoids heap
+     * allocations for transient events, as long as the callable fits
+     * in PooledFunctionEvent::MaxCallableSize bytes.
+     *
+     * @param callback Callable to invoke, must be copy or move
+     *        constructible.
+     * @param name Static string naming the event.
+     * @param when Tick at which to run the callable.
+     * @param p Event priority.
+     *
+     * @ingroup api_eventq
+     */
+    template <typename F>
+    void
+    schedulePooled(F &&callback, const char *name, Tick when,
+                   Event::Priority p=Event::Default_Pri)
+    {
+        PooledFunctionEvent *event = allocPooled();
+        event->set(std::forward<F>(callback), name);
+        event->_priority = p;
+        schedule(event, when);
+    }
+
     /**
      * Deschedule the specified event. Should be called only from the owning
      * thread.
@@ -912,6 +1237,13 @@ class EventQueue
      */
     void handleAsyncInsertions();
 
+    /**
+     * Number of events (not counting the local instances of global
+     * events) that were scheduled on this queue from other threads
+     * since it was created. Used to adapt the simulation quantum.
+     */
+    uint64_t asyncInsertions();
+
     /**
      *  Function to signal that the event loop should be woken up because
      *  an event has been scheduled by an agent outside the gem5 event
@@ -984,6 +1316,13 @@ curEventQueue(EventQueue *q)
 
 void dumpMainQueue();
 
+//! Select the backend of all current and future main event queues.
+void setMainEventQueueBackend(EventQueue::Backend backend);
+
+//! Enable profiling on all current and future main event queues.
+void setMainEventQueueProfiling(bool enable, unsigned sample_period=1,
+                                bool host_counters=false);
+
 class EventManager
 {
   protected:
@@ -1066,6 +1405,14 @@ class EventManager
         eventq->reschedule(event, when, always);
     }
 
+    template <typename F>
+    void
+    schedulePooled(F &&callback, const char *name, Tick when,
+                   Event::Priority p=Event::Default_Pri)
+    {
+        eventq->schedulePooled(std::forward<F>(callback), name, when, p);
+    }
+
     /**
      * This function is not needed by the usual gem5 event loop
      * but may be necessary in derived EventQueues which host gem5
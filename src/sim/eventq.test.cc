@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Event recording its identifier in a shared log when processed. */
+class LogEvent : public Event
+{
+  private:
+    int id;
+    std::vector<int> &log;
+
+  public:
+    LogEvent(int _id, std::vector<int> &_log, Priority p)
+        : Event(p), id(_id), log(_log)
+    {}
+
+    void process() override { log.push_back(id); }
+};
+
+/**
+ * Schedule, deschedule and reschedule a pseudo-random set of events
+ * and return the order in which they were serviced.
+ */
+std::vector<int>
+runRandomSchedule(EventQueue::Backend backend, unsigned seed,
+                  unsigned num_events, Tick max_delay)
+{
+    EventQueue eq("test_queue");
+    eq.backend(backend);
+
+    std::vector<int> log;
+    std::vector<std::unique_ptr<LogEvent>> events;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<Tick> delay(0, max_delay);
+    std::uniform_int_distribution<int> prio(-2, 2);
+
+    for (unsigned i = 0; i < num_events; i++) {
+        events.emplace_back(new LogEvent(i, log, prio(rng)));
+        eq.schedule(events.back().get(), delay(rng));
+    }
+
+    // Move a third of the events around and remove another third.
+    for (unsigned i = 0; i < num_events; i += 3) {
+        eq.reschedule(events[i].get(), delay(rng));
+        if (i + 1 < num_events)
+            eq.deschedule(events[i + 1].get());
+    }
+
+    while (!eq.empty()) {
+        eq.serviceOne();
+        // Keep inserting events while servicing the queue
+        if (events.size() < 2 * num_events) {
+            events.emplace_back(new LogEvent(events.size(), log, prio(rng)));
+            eq.schedule(events.back().get(), eq.getCurTick() + delay(rng));
+        }
+        EXPECT_TRUE(eq.debugVerify());
+    }
+
+    return log;
+}
+
+} // anonymous namespace
+
+/** Events are serviced by tick, then priority, then LIFO within a bin. */
+TEST(EventQueueTest, BinOrder)
+{
+    for (auto backend : {EventQueue::SortedListBackend,
+                         EventQueue::CalendarBackend}) {
+        EventQueue eq("test_queue");
+        eq.backend(backend);
+
+        std::vector<int> log;
+        LogEvent e0(0, log, Event::Default_Pri);
+        LogEvent e1(1, log, Event::Default_Pri);
+        LogEvent e2(2, log, Event::CPU_Tick_Pri);
+        LogEvent e3(3, log, Event::Debug_Break_Pri);
+        LogEvent e4(4, log, Event::Default_Pri);
+
+        eq.schedule(&e0, 100);
+        eq.schedule(&e1, 100);
+        eq.schedule(&e2, 100);
+        eq.schedule(&e3, 100);
+        eq.schedule(&e4, 50);
+
+        while (!eq.empty())
+            eq.serviceOne();
+
+        EXPECT_EQ(log, std::vector<int>({4, 3, 1, 0, 2}));
+    }
+}
+
+/** Both backends service the events in exactly the same order. */
+TEST(EventQueueTest, CalendarMatchesSortedList)
+{
+    // Dense ticks with many collisions, and sparse ticks.
+    for (Tick max_delay : {Tick(16), Tick(1000), Tick(100000000)}) {
+        for (unsigned seed = 0; seed < 4; seed++) {
+            auto expected = runRandomSchedule(
+                EventQueue::SortedListBackend, seed, 500, max_delay);
+            auto actual = runRandomSchedule(
+                EventQueue::CalendarBackend, seed, 500, max_delay);
+            EXPECT_EQ(expected, actual);
+        }
+    }
+}
+
+/** Events scheduled before a backend switch are kept in order. */
+TEST(EventQueueTest, BackendSwitch)
+{
+    EventQueue eq("test_queue");
+    std::vector<int> log;
+    std::vector<std::unique_ptr<LogEvent>> events;
+    for (int i = 0; i < 100; i++) {
+        events.emplace_back(new LogEvent(i, log, Event::Default_Pri));
+        eq.schedule(events.back().get(), (100 - i) * 10);
+    }
+
+    eq.backend(EventQueue::CalendarBackend);
+    for (int i = 0; i < 50; i++)
+        eq.serviceOne();
+    eq.backend(EventQueue::SortedListBackend);
+    while (!eq.empty())
+        eq.serviceOne();
+
+    ASSERT_EQ(log.size(), 100);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(log[i], 99 - i);
+}
+
+/** The head of a calendar queue can be swapped out and restored. */
+TEST(EventQueueTest, CalendarReplaceHead)
+{
+    EventQueue eq("test_queue");
+    eq.backend(EventQueue::CalendarBackend);
+
+    std::vector<int> log;
+    LogEvent e0(0, log, Event::Default_Pri);
+    LogEvent e1(1, log, Event::Default_Pri);
+    LogEvent e2(2, log, Event::Default_Pri);
+    eq.schedule(&e0, 300);
+    eq.schedule(&e1, 100);
+
+    Event *saved = eq.replaceHead(nullptr);
+    EXPECT_TRUE(eq.empty());
+    eq.schedule(&e2, 200);
+    eq.serviceOne();
+    EXPECT_TRUE(eq.empty());
+
+    eq.replaceHead(saved);
+    while (!eq.empty())
+        eq.serviceOne();
+
+    EXPECT_EQ(log, std::vector<int>({2, 1, 0}));
+}
+
+/** Pooled events run their callable and are recycled once serviced. */
+TEST(EventQueueTest, SchedulePooled)
+{
+    EventQueue eq("test_queue");
+    std::vector<int> log;
+    LogEvent e0(0, log, Event::Default_Pri);
+
+    auto payload = std::make_shared<int>(1);
+    eq.schedule(&e0, 100);
+    eq.schedulePooled([&log, payload]{ log.push_back(*payload); },
+                      "pooled", 100, Event::Default_Pri);
+    eq.schedulePooled([&log]{ log.push_back(2); }, "pooled", 100,
+                      Event::Minimum_Pri);
+    EXPECT_EQ(payload.use_count(), 2);
+
+    while (!eq.empty())
+        eq.serviceOne();
+
+    EXPECT_EQ(log, std::vector<int>({2, 1, 0}));
+    // The callable (and its captures) are destroyed once serviced.
+    EXPECT_EQ(payload.use_count(), 1);
+
+    // Released events are handed out again.
+    eq.schedulePooled([&log]{ log.push_back(3); }, "pooled", 200);
+    Event *recycled = eq.getHead();
+    eq.serviceOne();
+    eq.schedulePooled([&log]{ log.push_back(4); }, "pooled", 300);
+    EXPECT_EQ(eq.getHead(), recycled);
+    eq.serviceOne();
+    EXPECT_EQ(log, std::vector<int>({2, 1, 0, 3, 4}));
+}
+
+/** Profiling counts the calls of every event name. */
+TEST(EventQueueTest, Profile)
+{
+    EventQueue eq("test_queue");
+    eq.profile(true);
+
+    std::vector<int> log;
+    for (int i = 0; i < 3; i++)
+        eq.schedulePooled([&log]{ log.push_back(0); }, "pooled", 10 * i);
+    while (!eq.empty())
+        eq.serviceOne();
+
+    std::ostringstream os;
+    eq.dumpProfile(os);
+    EXPECT_NE(os.str().find("test_queue"), std::string::npos);
+    EXPECT_NE(os.str().find(" 3 "), std::string::npos);
+    EXPECT_NE(os.str().find("pooled"), std::string::npos);
+
+    eq.resetProfile();
+    std::ostringstream empty;
+    eq.dumpProfile(empty);
+    EXPECT_EQ(empty.str().find("pooled"), std::string::npos);
+}
+
+/** Events scheduled from other threads are merged in schedule order. */
+TEST(EventQueueTest, AsyncInsert)
+{
+    EventQueue eq("test_queue");
+    EventQueue *old_eq = curEventQueue();
+    curEventQueue(&eq);
+    inParallelMode = true;
+
+    const int num_threads = 4;
+    const int num_events = 250;
+    std::vector<int> log;
+    std::vector<std::unique_ptr<LogEvent>> events;
+    for (int i = 0; i < num_threads * num_events; i++)
+        events.emplace_back(new LogEvent(i, log, Event::Default_Pri));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]{
+            for (int i = 0; i < num_events; i++) {
+                int id = t * num_events + i;
+                eq.schedule(events[id].get(), id + 1);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    // Three events in the same bin, scheduled as a global event would.
+    LogEvent e0(-1, log, Event::Default_Pri);
+    LogEvent e1(-2, log, Event::Default_Pri);
+    LogEvent e2(-3, log, Event::Default_Pri);
+    eq.schedule(&e0, 0, true);
+    eq.schedule(&e1, 0, true);
+    eq.schedule(&e2, 0, true);
+
+    EXPECT_TRUE(eq.empty());
+    EXPECT_EQ(eq.asyncInsertions(), num_threads * num_events + 3);
+    eq.handleAsyncInsertions();
+
+    inParallelMode = false;
+    while (!eq.empty())
+        eq.serviceOne();
+    curEventQueue(old_eq);
+
+    ASSERT_EQ(log.size(), num_threads * num_events + 3);
+    EXPECT_EQ(log[0], -3);
+    EXPECT_EQ(log[1], -2);
+    EXPECT_EQ(log[2], -1);
+    for (int i = 0; i < num_threads * num_events; i++)
+        EXPECT_EQ(log[i + 3], i);
+}
+
+/** A sampled profile estimates the calls from one in every few events. */
+TEST(EventQueueTest, ProfileSampled)
+{
+    EventQueue eq("test_queue");
+    eq.profile(true);
+    eq.profileSamplePeriod(4);
+
+    int count = 0;
+    for (int i = 0; i < 1000; i++)
+        eq.schedulePooled([&count]{ count++; }, "pooled", i);
+    while (!eq.empty())
+        eq.serviceOne();
+    EXPECT_EQ(count, 1000);
+
+    const auto &profile = eq.getProfile();
+    ASSERT_EQ(profile.size(), 1);
+    const auto &entry = profile.begin()->second;
+    EXPECT_EQ(entry.calls % 4, 0);
+    EXPECT_GT(entry.calls, 500);
+    EXPECT_LT(entry.calls, 1500);
+}
@@ -28,6 +28,9 @@
 
 #include <sim/futex_map.hh>
 
+#include "sim/process.hh"
+#include "sim/se_workload.hh"
+
 namespace gem5
 {
 
@@ -49,6 +52,13 @@ WaiterState::checkMask(int wakeup_bitmask) const
     return bitmask & wakeup_bitmask;
 }
 
+void
+FutexMap::activate(ThreadContext *tc)
+{
+    tc->getProcessPtr()->seWorkload->updateContext(tc,
+        [tc]() { tc->activate(); });
+}
+
 void
 FutexMap::suspend(Addr addr, uint64_t tgid, ThreadContext *tc)
 {
@@ -73,7 +83,7 @@ FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
         // must only count threads that were actually
         // woken up by this syscall.
         auto& tc = waiterList.front().tc;
-        tc->activate();
+        activate(tc);
         woken_up++;
         waiterList.pop_front();
         waitingTcs.erase(tc);
@@ -122,7 +132,7 @@ FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
         WaiterState& waiter = *iter;
 
         if (waiter.checkMask(bitmask)) {
-            waiter.tc->activate();
+            activate(waiter.tc);
             waitingTcs.erase(waiter.tc);
             iter = waiterList.erase(iter);
             woken_up++;
@@ -150,7 +160,7 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
     auto &waiterList1 = it1->second;
 
     while (!waiterList1.empty() && woken_up < count) {
-        waiterList1.front().tc->activate();
+        activate(waiterList1.front().tc);
         waiterList1.pop_front();
         woken_up++;
     }
@@ -184,6 +194,11 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
 bool
 FutexMap::is_waiting(ThreadContext *tc)
 {
+    // CPUs on other event queues may be updating the map
+    Process *p = tc->getProcessPtr();
+    if (!p)
+        return false;
+    auto lock = p->seWorkload->lockEmulation();
     return waitingTcs.find(tc) != waitingTcs.end();
 }
 
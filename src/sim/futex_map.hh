@@ -139,6 +139,8 @@ class FutexMap : public std::unordered_map<FutexKey, WaiterList>
     bool is_waiting(ThreadContext *tc);
 
   private:
+    /** Wakes up a waiter, which may run on another event queue */
+    static void activate(ThreadContext *tc);
 
     std::unordered_set<ThreadContext *> waitingTcs;
 };
@@ -157,11 +157,31 @@ GlobalSyncEvent::BarrierEvent::process()
 void
 GlobalSyncEvent::process()
 {
+    if (maxRepeat > minRepeat)
+        adaptRepeat();
+
     if (repeat) {
         schedule(curTick() + repeat);
     }
 }
 
+void
+GlobalSyncEvent::adaptRepeat()
+{
+    // All threads are held at the barrier while this runs, so the
+    // counters can only move because of non-simulation threads.
+    uint64_t inserts = 0;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        inserts += mainEventQueue[i]->asyncInsertions();
+
+    if (inserts != lastAsyncInserts)
+        repeat = minRepeat;
+    else
+        repeat = std::min(repeat * 2, maxRepeat);
+
+    lastAsyncInserts = inserts;
+}
+
 const char *
 GlobalSyncEvent::description() const
 {
@@ -30,6 +30,7 @@
 #ifndef __SIM_GLOBAL_EVENT_HH__
 #define __SIM_GLOBAL_EVENT_HH__
 
+#include <algorithm>
 #include <mutex>
 #include <vector>
 
@@ -220,11 +221,26 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     };
 
     GlobalSyncEvent(Priority p, Flags f)
-        : Base(p, f), repeat(0)
+        : Base(p, f), repeat(0), minRepeat(0), maxRepeat(0)
     { }
 
     GlobalSyncEvent(Tick when, Tick _repeat, Priority p, Flags f)
-        : Base(p, f), repeat(_repeat)
+        : Base(p, f), repeat(_repeat), minRepeat(_repeat),
+          maxRepeat(_repeat)
+    {
+        schedule(when);
+    }
+
+    /**
+     * Create a sync event with an adaptive period. The period starts
+     * at min_repeat, doubles (up to max_repeat) after each period in
+     * which no events were scheduled across event queues, and falls
+     * back to min_repeat after any period in which some were.
+     */
+    GlobalSyncEvent(Tick when, Tick min_repeat, Tick max_repeat,
+                    Priority p, Flags f)
+        : Base(p, f), repeat(min_repeat), minRepeat(min_repeat),
+          maxRepeat(std::max(min_repeat, max_repeat))
     {
         schedule(when);
     }
@@ -234,6 +250,17 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     const char *description() const;
 
     Tick repeat;
+
+  private:
+    //! Pick the next period from the cross-queue traffic seen in the
+    //! period that just ended.
+    void adaptRepeat();
+
+    Tick minRepeat;
+    Tick maxRepeat;
+
+    //! Total cross-queue insertions seen at the previous sync.
+    uint64_t lastAsyncInserts = 0;
 };
 
 } // namespace gem5
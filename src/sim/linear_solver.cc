@@ -37,6 +37,9 @@
 
 #include "sim/linear_solver.hh"
 
+#include <algorithm>
+#include <cmath>
+
 namespace gem5
 {
 
@@ -87,4 +90,145 @@ LinearSystem::solve() const
     return ret;
 }
 
+void
+SparseLinearSystem::add(unsigned row, unsigned col, double value)
+{
+    assert(row < rows.size() && col < rows.size());
+
+    auto &r = rows[row];
+    auto it = std::lower_bound(r.begin(), r.end(), col,
+        [](const std::pair<unsigned, double> &e, unsigned c) {
+            return e.first < c;
+        });
+    if (it != r.end() && it->first == col)
+        it->second += value;
+    else
+        r.insert(it, std::make_pair(col, value));
+}
+
+bool
+SparseLinearSystem::symmetric() const
+{
+    for (unsigned row = 0; row < rows.size(); row++) {
+        for (auto &e : rows[row]) {
+            auto &t = rows[e.first];
+            auto it = std::find_if(t.begin(), t.end(),
+                [row](const std::pair<unsigned, double> &te) {
+                    return te.first == row;
+                });
+            double other = it == t.end() ? 0.0 : it->second;
+            double scale = std::max(std::fabs(e.second), std::fabs(other));
+            if (std::fabs(e.second - other) > 1e-12 * scale)
+                return false;
+        }
+    }
+    return true;
+}
+
+void
+SparseLinearSystem::multiply(const std::vector<double> &x,
+                             std::vector<double> &y) const
+{
+    for (unsigned row = 0; row < rows.size(); row++) {
+        double sum = 0.0;
+        for (auto &e : rows[row])
+            sum += e.second * x[e.first];
+        y[row] = sum;
+    }
+}
+
+bool
+SparseLinearSystem::solveCG(const std::vector<double> &cnt,
+                            std::vector<double> &x, double tolerance,
+                            unsigned max_iters) const
+{
+    const unsigned order = rows.size();
+    assert(cnt.size() == order && x.size() == order);
+
+    // A negative definite system is solved as -A x = c, so that the
+    // iteration always works on a positive definite matrix.
+    double sign = 0.0;
+    std::vector<double> inv_diag(order, 0.0);
+    for (unsigned row = 0; row < order; row++) {
+        double diag = 0.0;
+        for (auto &e : rows[row]) {
+            if (e.first == row)
+                diag = e.second;
+        }
+        if (sign == 0.0)
+            sign = diag < 0.0 ? -1.0 : 1.0;
+        if (sign * diag <= 0.0)
+            return false;
+        inv_diag[row] = 1.0 / (sign * diag);
+    }
+
+    double cnt_norm = 0.0;
+    for (auto c : cnt)
+        cnt_norm += c * c;
+    const double limit = tolerance * tolerance *
+        std::max(cnt_norm, 1e-300);
+
+    // r = b - M x with M = sign * A and b = -sign * c
+    std::vector<double> r(order), z(order), p(order), mp(order);
+    multiply(x, mp);
+    double residual = 0.0;
+    for (unsigned i = 0; i < order; i++) {
+        r[i] = -sign * cnt[i] - sign * mp[i];
+        residual += r[i] * r[i];
+    }
+
+    double rz = 0.0;
+    for (unsigned i = 0; i < order; i++) {
+        z[i] = inv_diag[i] * r[i];
+        p[i] = z[i];
+        rz += r[i] * z[i];
+    }
+
+    for (unsigned iter = 0; iter < max_iters; iter++) {
+        if (residual <= limit)
+            return true;
+
+        multiply(p, mp);
+        double pmp = 0.0;
+        for (unsigned i = 0; i < order; i++) {
+            mp[i] *= sign;
+            pmp += p[i] * mp[i];
+        }
+        if (pmp <= 0.0)
+            return false;
+
+        const double alpha = rz / pmp;
+        residual = 0.0;
+        for (unsigned i = 0; i < order; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * mp[i];
+            residual += r[i] * r[i];
+        }
+
+        double rz_next = 0.0;
+        for (unsigned i = 0; i < order; i++) {
+            z[i] = inv_diag[i] * r[i];
+            rz_next += r[i] * z[i];
+        }
+        const double beta = rz_next / rz;
+        rz = rz_next;
+        for (unsigned i = 0; i < order; i++)
+            p[i] = z[i] + beta * p[i];
+    }
+
+    return residual <= limit;
+}
+
+LinearSystem
+SparseLinearSystem::toDense(const std::vector<double> &cnt) const
+{
+    LinearSystem ls(rows.size());
+    for (unsigned row = 0; row < rows.size(); row++) {
+        for (auto &e : rows[row])
+            ls[row][e.first] = e.second;
+        ls[row][ls[row].cnt()] = cnt[row];
+    }
+    return ls;
+}
+
 } // namespace gem5
@@ -41,6 +41,7 @@
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace gem5
@@ -134,6 +135,54 @@ class LinearSystem
     std::vector < LinearEquation > matrix;
 };
 
+/**
+ * A linear system with constant coefficients stored sparsely, for
+ * systems where each equation only involves a few of the unknowns. The
+ * constant terms are provided separately at every solve, so the
+ * coefficients can be reused as long as they do not change. Like
+ * LinearEquation, each row i stands for sum_j(a[i][j] * x[j]) + c[i] = 0.
+ */
+class SparseLinearSystem
+{
+  public:
+    SparseLinearSystem(unsigned unknowns = 0) : rows(unknowns) {}
+
+    /** Add value to the coefficient of unknown col in equation row */
+    void add(unsigned row, unsigned col, double value);
+
+    unsigned size() const { return rows.size(); }
+
+    /** Whether the coefficient matrix is symmetric */
+    bool symmetric() const;
+
+    /**
+     * Solve the system with a Jacobi preconditioned conjugate gradient.
+     * This requires the coefficient matrix to be symmetric and either
+     * positive or negative definite, as the nodal equations of a passive
+     * circuit are.
+     *
+     * @param cnt Constant term of each equation
+     * @param x Initial guess, replaced by the solution
+     * @param tolerance Residual norm, relative to the one of cnt, at which
+     *                  to stop
+     * @param max_iters Maximum number of iterations
+     * @return Whether the solver converged; x is unspecified otherwise
+     */
+    bool solveCG(const std::vector<double> &cnt, std::vector<double> &x,
+                 double tolerance, unsigned max_iters) const;
+
+    /** Build the equivalent dense system for the given constant terms */
+    LinearSystem toDense(const std::vector<double> &cnt) const;
+
+  private:
+    /** Non-zero coefficients of each equation as (unknown, value) */
+    std::vector<std::vector<std::pair<unsigned, double>>> rows;
+
+    /** y = A * x */
+    void multiply(const std::vector<double> &x,
+                  std::vector<double> &y) const;
+};
+
 } // namespace gem5
 
 #endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "sim/linear_solver.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * A chain of nodes connected through unit conductances, with the first
+ * one also connected to a reference at 0 and a current injected in the
+ * last one, as the thermal model would build it.
+ */
+SparseLinearSystem
+chain(unsigned nodes)
+{
+    SparseLinearSystem sys(nodes);
+    sys.add(0, 0, -1.0);
+    for (unsigned i = 0; i + 1 < nodes; i++) {
+        sys.add(i, i, -1.0);
+        sys.add(i, i + 1, 1.0);
+        sys.add(i + 1, i + 1, -1.0);
+        sys.add(i + 1, i, 1.0);
+    }
+    return sys;
+}
+
+} // anonymous namespace
+
+TEST(SparseLinearSystemTest, AccumulatesCoefficients)
+{
+    SparseLinearSystem sys(2);
+    sys.add(0, 1, 1.0);
+    sys.add(0, 1, 2.0);
+    sys.add(1, 0, 3.0);
+
+    LinearSystem ls = sys.toDense({4.0, 5.0});
+    EXPECT_EQ(ls[0][0], 0.0);
+    EXPECT_EQ(ls[0][1], 3.0);
+    EXPECT_EQ(ls[0][ls[0].cnt()], 4.0);
+    EXPECT_EQ(ls[1][0], 3.0);
+    EXPECT_EQ(ls[1][ls[1].cnt()], 5.0);
+    EXPECT_TRUE(sys.symmetric());
+
+    sys.add(1, 0, 1.0);
+    EXPECT_FALSE(sys.symmetric());
+}
+
+TEST(SparseLinearSystemTest, ConjugateGradientMatchesGauss)
+{
+    const unsigned nodes = 20;
+    SparseLinearSystem sys = chain(nodes);
+    std::vector<double> cnt(nodes, 0.0);
+    cnt[nodes - 1] = 1.0;
+
+    std::vector<double> expected = sys.toDense(cnt).solve();
+    std::vector<double> x(nodes, 0.0);
+    ASSERT_TRUE(sys.solveCG(cnt, x, 1e-12, 2 * nodes));
+
+    // Unit current through unit resistors: node i sits at i + 1
+    for (unsigned i = 0; i < nodes; i++) {
+        EXPECT_NEAR(x[i], expected[i], 1e-9);
+        EXPECT_NEAR(x[i], i + 1.0, 1e-9);
+    }
+}
+
+TEST(SparseLinearSystemTest, ConjugateGradientRejectsIndefinite)
+{
+    SparseLinearSystem sys(2);
+    sys.add(0, 0, 1.0);
+    sys.add(1, 1, -1.0);
+
+    std::vector<double> x(2, 0.0);
+    EXPECT_FALSE(sys.solveCG({1.0, 1.0}, x, 1e-12, 10));
+}
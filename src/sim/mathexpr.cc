@@ -177,6 +177,43 @@ MathExpr::toStr(Node *n, std::string prefix) const {
     return ret;
 }
 
+MathExpr::Program
+MathExpr::compile(BindCallback bind) const
+{
+    Program prog;
+    prog.stack.resize(compile(root, bind, prog));
+    return prog;
+}
+
+unsigned
+MathExpr::compile(const Node *n, const BindCallback &bind,
+                  Program &prog) const
+{
+    assert(n);
+
+    if (n->op == sVariable) {
+        prog.insts.push_back({sVariable, 0, bind(n->variable)});
+        return 1;
+    }
+
+    std::vector<std::string> vars;
+    getVariables(n, vars);
+    if (vars.empty()) {
+        double value = eval(n, [](std::string) -> double {
+            panic("Constant expression with a variable\n");
+        });
+        prog.insts.push_back({sValue, value, 0});
+        return 1;
+    }
+
+    unsigned depth = 0;
+    if (n->l)
+        depth = compile(n->l, bind, prog);
+    depth = std::max(depth, (n->l ? 1 : 0) + compile(n->r, bind, prog));
+    prog.insts.push_back({n->op, 0, 0});
+    return depth;
+}
+
 void
 MathExpr::getVariables(const Node *n,
                        std::vector<std::string> &variables) const
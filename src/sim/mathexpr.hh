@@ -40,6 +40,8 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
 #include <functional>
 #include <string>
 #include <vector>
@@ -54,6 +56,9 @@ class MathExpr
     MathExpr(std::string expr);
 
     typedef std::function<double(std::string)> EvalCallback;
+    typedef std::function<unsigned(const std::string &)> BindCallback;
+
+    class Program;
 
     /**
      * Prints an ASCII representation of the expression tree
@@ -87,6 +92,17 @@ class MathExpr
         return vars;
     }
 
+    /**
+     * Flatten the expression into a program that can be evaluated
+     * without walking the tree or looking variables up by name.
+     * Constant sub-expressions are folded.
+     *
+     * @param bind Returns the index a variable will be read from
+     *
+     * @return The program for this expression
+     */
+    Program compile(BindCallback bind) const;
+
   private:
     enum Operator
     {
@@ -147,6 +163,85 @@ class MathExpr
     /** Return all variable reachable from a node to a vector of
      * strings */
     void getVariables(const Node *n, std::vector<std::string> &vars) const;
+
+    /** Append the postfix program of a node, return its stack depth */
+    unsigned compile(const Node *n, const BindCallback &bind,
+                     Program &prog) const;
+
+  public:
+    /**
+     * A MathExpr in postfix form, with the variables bound to indices.
+     */
+    class Program
+    {
+      public:
+        bool empty() const { return insts.empty(); }
+
+        /**
+         * Evaluates the program
+         *
+         * @param fn Returns the value of the variable at an index
+         *
+         * @return The value of the expression
+         */
+        template <typename Fn>
+        double
+        eval(Fn &&fn) const
+        {
+            double *top = stack.data() - 1;
+            for (const auto &inst : insts) {
+                switch (inst.op) {
+                  case sValue:
+                    *++top = inst.value;
+                    break;
+                  case sVariable:
+                    *++top = fn(inst.var);
+                    break;
+                  case uNeg:
+                    *top = -*top;
+                    break;
+                  case bAdd:
+                    top--;
+                    top[0] = top[0] + top[1];
+                    break;
+                  case bSub:
+                    top--;
+                    top[0] = top[0] - top[1];
+                    break;
+                  case bMul:
+                    top--;
+                    top[0] = top[0] * top[1];
+                    break;
+                  case bDiv:
+                    top--;
+                    top[0] = top[0] / top[1];
+                    break;
+                  case bPow:
+                    top--;
+                    top[0] = std::pow(top[0], top[1]);
+                    break;
+                  default:
+                    assert(false);
+                }
+            }
+            assert(top == stack.data());
+            return *top;
+        }
+
+      private:
+        friend class MathExpr;
+
+        struct Inst
+        {
+            Operator op;
+            double value;
+            unsigned var;
+        };
+
+        std::vector<Inst> insts;
+        /** Scratch space for evaluation, sized for the deepest point */
+        mutable std::vector<double> stack;
+    };
 };
 
 } // namespace gem5
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+#include "sim/mathexpr.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+double
+evalTree(const std::string &str, const std::map<std::string, double> &vars)
+{
+    MathExpr expr(str);
+    return expr.eval([&vars](std::string var) { return vars.at(var); });
+}
+
+double
+evalProgram(const std::string &str,
+            const std::map<std::string, double> &vars)
+{
+    MathExpr expr(str);
+    std::vector<double> values;
+    MathExpr::Program prog = expr.compile(
+        [&vars, &values](const std::string &var) {
+            values.push_back(vars.at(var));
+            return (unsigned)(values.size() - 1);
+        });
+    return prog.eval([&values](unsigned idx) { return values[idx]; });
+}
+
+} // anonymous namespace
+
+TEST(MathExprTest, ProgramMatchesTree)
+{
+    const std::map<std::string, double> vars = {
+        {"a", 3.0}, {"b", -2.5}, {"system.cpu.ipc", 1.25},
+    };
+    const char *exprs[] = {
+        "1 + 2 * 3",
+        "a",
+        "-a",
+        "a - b - 1",
+        "a / b / 2",
+        "2 ^ 3 ^ 2",
+        "(a + b) * (a - b) / -system.cpu.ipc",
+        "a * (1 + 2) ^ 2 - -b",
+        "((a))",
+    };
+
+    for (auto str : exprs)
+        EXPECT_DOUBLE_EQ(evalProgram(str, vars), evalTree(str, vars)) << str;
+}
+
+TEST(MathExprTest, ProgramFoldsConstants)
+{
+    MathExpr expr("a * (2 + 3 * 4)");
+    unsigned binds = 0;
+    MathExpr::Program prog = expr.compile([&binds](const std::string &) {
+        return binds++;
+    });
+
+    EXPECT_EQ(binds, 1u);
+    EXPECT_DOUBLE_EQ(prog.eval([](unsigned) { return 2.0; }), 28.0);
+}
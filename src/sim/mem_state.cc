@@ -402,6 +402,18 @@ MemState::fixupFault(Addr vaddr)
              * are recycled.
              */
             if (vma.hasHostBuf()) {
+                /**
+                 * Map whole pages of the file straight into the backing
+                 * store when possible. The page was just allocated, so
+                 * no cache can hold stale copies of it.
+                 */
+                Addr paddr;
+                if (_ownerProcess->pTable->translate(vpage_start, paddr) &&
+                    vma.mapMemPage(vpage_start, paddr,
+                                   _ownerProcess->system->getPhysMem())) {
+                    return true;
+                }
+
                 /**
                  * Write the memory for the host buffer contents for all
                  * ThreadContexts associated with this process.
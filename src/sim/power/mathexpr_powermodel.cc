@@ -71,6 +71,62 @@ MathExprPowerModel::startup()
             statsMap[var] = info;
         }
     }
+
+    // Bind every variable to its slot, resolving the stat type only once
+    std::unordered_map<std::string, unsigned> slots;
+    auto bind = [this, &slots](const std::string &var) {
+        auto it = slots.find(var);
+        if (it != slots.end())
+            return it->second;
+
+        Variable v{Variable::Temp, nullptr};
+        if (var == "voltage") {
+            v.kind = Variable::Voltage;
+        } else if (var == "clock_period") {
+            v.kind = Variable::ClockPeriod;
+        } else if (var != "temp") {
+            v.info = statsMap.at(var);
+            if (dynamic_cast<const statistics::ScalarInfo *>(v.info))
+                v.kind = Variable::Scalar;
+            else if (dynamic_cast<const statistics::FormulaInfo *>(v.info))
+                v.kind = Variable::Formula;
+            else
+                panic("Unknown stat type!\n");
+        }
+
+        variables.push_back(v);
+        slots[var] = variables.size() - 1;
+        return (unsigned)(variables.size() - 1);
+    };
+    dyn_prog = dyn_expr.compile(bind);
+    st_prog = st_expr.compile(bind);
+}
+
+double
+MathExprPowerModel::eval(const MathExpr::Program &prog,
+                         const MathExpr &expr) const
+{
+    using namespace statistics;
+
+    if (prog.empty())
+        return eval(expr);
+
+    return prog.eval([this](unsigned idx) -> double {
+        const Variable &v = variables[idx];
+        switch (v.kind) {
+          case Variable::Temp:
+            return _temp.toCelsius();
+          case Variable::Voltage:
+            return clocked_object->voltage();
+          case Variable::ClockPeriod:
+            return clocked_object->clockPeriod();
+          case Variable::Scalar:
+            return static_cast<const ScalarInfo *>(v.info)->value();
+          case Variable::Formula:
+            return static_cast<const FormulaInfo *>(v.info)->total();
+        }
+        GEM5_UNREACHABLE;
+    });
 }
 
 double
@@ -39,6 +39,7 @@
 #define __SIM_MATHEXPR_POWERMODEL_PM_HH__
 
 #include <unordered_map>
+#include <vector>
 
 #include "params/MathExprPowerModel.hh"
 #include "sim/mathexpr.hh"
@@ -69,14 +70,22 @@ class MathExprPowerModel : public PowerModelState
      *
      * @return Power (Watts) consumed by this object (dynamic component)
      */
-    double getDynamicPower() const override { return eval(dyn_expr); }
+    double
+    getDynamicPower() const override
+    {
+        return eval(dyn_prog, dyn_expr);
+    }
 
     /**
      * Get the static power consumption.
      *
      * @return Power (Watts) consumed by this object (static component)
      */
-    double getStaticPower() const override { return eval(st_expr); }
+    double
+    getStaticPower() const override
+    {
+        return eval(st_prog, st_expr);
+    }
 
     /**
      * Get the value for a variable (maps to a stat)
@@ -100,9 +109,29 @@ class MathExprPowerModel : public PowerModelState
      */
     double eval(const MathExpr &expr) const;
 
+    /**
+     * Evaluate a compiled expression, falling back to the expression if
+     * it has not been compiled yet.
+     */
+    double eval(const MathExpr::Program &prog, const MathExpr &expr) const;
+
     // Math expressions for dynamic and static power
     MathExpr dyn_expr, st_expr;
 
+    /** A variable of the expressions, resolved at startup */
+    struct Variable
+    {
+        enum Kind { Temp, Voltage, ClockPeriod, Scalar, Formula };
+        Kind kind;
+        const statistics::Info *info;
+    };
+
+    /** Variables of the compiled expressions, by index */
+    std::vector<Variable> variables;
+
+    // The expressions compiled at startup
+    MathExpr::Program dyn_prog, st_prog;
+
     // Map that contains relevant stats for this power model
     std::unordered_map<std::string, const statistics::Info*> statsMap;
 };
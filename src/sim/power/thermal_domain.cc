@@ -93,4 +93,12 @@ ThermalDomain::getEquation(ThermalNode * tn, unsigned n, double step) const
     return eq;
 }
 
+double
+ThermalDomain::getConstant(ThermalNode * tn, unsigned n, double step) const
+{
+    if (tn != node)
+        return 0.0;
+    return subsystem->getDynamicPower() + subsystem->getStaticPower();
+}
+
 } // namespace gem5
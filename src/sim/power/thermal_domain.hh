@@ -86,6 +86,9 @@ class ThermalDomain : public SimObject, public ThermalEntity
     /** Get nodal equation imposed by this node */
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
+    double getConstant(ThermalNode * tn, unsigned n,
+                       double step) const override;
+    bool dependsOn(ThermalNode * tn) const override { return tn == node; }
 
     /**
       *  Emit a temperature update through probe points interface
@@ -38,12 +38,12 @@
 #ifndef __SIM_THERMAL_ENTITY_HH__
 #define __SIM_THERMAL_ENTITY_HH__
 
+#include "sim/linear_solver.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
 {
 
-class LinearEquation;
 class ThermalNode;
 
 /**
@@ -57,6 +57,24 @@ class ThermalEntity
     // Get the equation given a node and a step in seconds (assuming N nodes)
     virtual LinearEquation getEquation(ThermalNode *tn, unsigned n,
                                        double step) const = 0;
+
+    /**
+     * Get the constant term of the equation of a node. The coefficients
+     * of the unknowns are only read once, at startup, so they are not
+     * allowed to change during the simulation, but this term can.
+     */
+    virtual double
+    getConstant(ThermalNode *tn, unsigned n, double step) const
+    {
+        LinearEquation eq = getEquation(tn, n, step);
+        return eq[eq.cnt()];
+    }
+
+    /**
+     * Whether the equation of a node can be non-empty, so that the
+     * model can skip the entities that are not connected to it.
+     */
+    virtual bool dependsOn(ThermalNode *tn) const { return true; }
 };
 
 } // namespace gem5
@@ -100,6 +100,22 @@ ThermalResistor::getEquation(ThermalNode * n, unsigned nnodes,
     return eq;
 }
 
+double
+ThermalResistor::getConstant(ThermalNode * n, unsigned nnodes,
+                             double step) const
+{
+    if (n != node1 && n != node2)
+        return 0.0;
+
+    double cnt = 0.0;
+    if (node1->isref)
+        cnt += -node1->temp.toKelvin() / _resistance;
+    if (node2->isref)
+        cnt += node2->temp.toKelvin() / _resistance;
+
+    return n == node2 ? -cnt : cnt;
+}
+
 /**
  * ThermalCapacitor
  */
@@ -139,11 +155,29 @@ ThermalCapacitor::getEquation(ThermalNode * n, unsigned nnodes,
     return eq;
 }
 
+double
+ThermalCapacitor::getConstant(ThermalNode * n, unsigned nnodes,
+                              double step) const
+{
+    if (n != node1 && n != node2)
+        return 0.0;
+
+    double cnt = _capacitance / step *
+        (node1->temp - node2->temp).toKelvin();
+    if (node1->isref)
+        cnt += _capacitance / step * (-node1->temp.toKelvin());
+    if (node2->isref)
+        cnt += _capacitance / step * (node2->temp.toKelvin());
+
+    return n == node2 ? -cnt : cnt;
+}
+
 /**
  * ThermalModel
  */
 ThermalModel::ThermalModel(const Params &p)
-    : ClockedObject(p), stepEvent([this]{ doStep(); }, name()), _step(p.step)
+    : ClockedObject(p), iterative(false),
+      stepEvent([this]{ doStep(); }, name()), _step(p.step)
 {
 }
 
@@ -151,20 +185,23 @@ void
 ThermalModel::doStep()
 {
     // Calculate new temperatures!
-    // For each node in the system, create the kirchhoff nodal equation
-    LinearSystem ls(eq_nodes.size());
+    // For each node in the system, gather the constant term of the
+    // kirchhoff nodal equation, the coefficients do not change.
+    std::vector <double> cnt(eq_nodes.size(), 0.0);
+    std::vector <double> temps(eq_nodes.size());
     for (unsigned i = 0; i < eq_nodes.size(); i++) {
         auto n = eq_nodes[i];
-        LinearEquation node_equation (eq_nodes.size());
-        for (auto e : entities) {
-            LinearEquation eq = e->getEquation(n, eq_nodes.size(), _step);
-            node_equation = node_equation + eq;
-        }
-        ls[i] = node_equation;
+        for (auto e : node_entities[i])
+            cnt[i] += e->getConstant(n, eq_nodes.size(), _step);
+        // The previous temperatures are a good initial guess
+        temps[i] = n->temp.toKelvin();
     }
 
     // Get temperatures for this iteration
-    std::vector <double> temps = ls.solve();
+    if (!iterative ||
+        !system.solveCG(cnt, temps, 1e-10, 2 * eq_nodes.size() + 10)) {
+        temps = system.toDense(cnt).solve();
+    }
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->temp = Temperature::fromKelvin(temps[i]);
 
@@ -205,6 +242,24 @@ ThermalModel::startup()
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->id = i;
 
+    // Build the coefficients of the nodal equations
+    node_entities.resize(eq_nodes.size());
+    system = SparseLinearSystem(eq_nodes.size());
+    for (unsigned i = 0; i < eq_nodes.size(); i++) {
+        auto n = eq_nodes[i];
+        for (auto e : entities) {
+            if (!e->dependsOn(n))
+                continue;
+            node_entities[i].push_back(e);
+            LinearEquation eq = e->getEquation(n, eq_nodes.size(), _step);
+            for (unsigned j = 0; j < eq_nodes.size(); j++) {
+                if (eq[j] != 0.0)
+                    system.add(i, j, eq[j]);
+            }
+        }
+    }
+    iterative = system.symmetric();
+
     // Schedule first thermal update
     schedule(stepEvent, curTick() + sim_clock::as_int::s * _step);
 }
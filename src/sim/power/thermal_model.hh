@@ -73,6 +73,12 @@ class ThermalResistor : public SimObject, public ThermalEntity
 
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
+    double getConstant(ThermalNode * tn, unsigned n,
+                       double step) const override;
+    bool dependsOn(ThermalNode * tn) const override
+    {
+        return tn == node1 || tn == node2;
+    }
 
   private:
     /* Resistance value in K/W */
@@ -94,6 +100,12 @@ class ThermalCapacitor : public SimObject, public ThermalEntity
 
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
+    double getConstant(ThermalNode * tn, unsigned n,
+                       double step) const override;
+    bool dependsOn(ThermalNode * tn) const override
+    {
+        return tn == node1 || tn == node2;
+    }
 
     void setNodes(ThermalNode * n1, ThermalNode * n2) {
         node1 = n1;
@@ -125,6 +137,9 @@ class ThermalReference : public SimObject, public ThermalEntity
 
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
+    double getConstant(ThermalNode * tn, unsigned n,
+                       double step) const override { return 0.0; }
+    bool dependsOn(ThermalNode * tn) const override { return false; }
 
     /* Fixed temperature value */
     const Temperature _temperature;
@@ -173,6 +188,18 @@ class ThermalModel : public ClockedObject
     std::vector <ThermalNode*> nodes;
     std::vector <ThermalNode*> eq_nodes;
 
+    /* Entities each node in eq_nodes depends on */
+    std::vector <std::vector <ThermalEntity *>> node_entities;
+
+    /**
+     * Coefficients of the nodal equations, which only depend on the
+     * topology and the step, so they are built once at startup. Only the
+     * constant terms are gathered at every step.
+     */
+    SparseLinearSystem system;
+    /* Whether the system can be solved with conjugate gradient */
+    bool iterative;
+
     /** Stepping event to update the model values */
     EventFunctionWrapper stepEvent;
 
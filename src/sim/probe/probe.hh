@@ -215,6 +215,22 @@ class ProbeListenerArgBase : public ProbeListener
         : ProbeListener(pm, name)
     {}
     virtual void notify(const Arg &val) = 0;
+
+    /**
+     * Called when a ProbePoint delivers several values at once, e.g.
+     * all the instructions a CPU retired in a cycle. The default
+     * implementation forwards each value to notify(); listeners that
+     * can process a batch more cheaply should override it.
+     *
+     * @param vals the values, in the order they were produced.
+     * @param count the number of values.
+     */
+    virtual void
+    notifyBatch(const Arg *vals, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            notify(vals[i]);
+    }
 };
 
 /**
@@ -230,6 +246,7 @@ class ProbeListenerArg : public ProbeListenerArgBase<Arg>
   private:
     T *object;
     void (T::* function)(const Arg &);
+    void (T::* batchFunction)(const Arg *, size_t);
 
   public:
     /**
@@ -241,7 +258,24 @@ class ProbeListenerArg : public ProbeListenerArgBase<Arg>
         void (T::* func)(const Arg &))
         : ProbeListenerArgBase<Arg>(obj->getProbeManager(), name),
           object(obj),
-          function(func)
+          function(func),
+          batchFunction(nullptr)
+    {}
+
+    /**
+     * @param obj the class of type T containing the methods to call.
+     * @param name the name of the ProbePoint to add this listener to.
+     * @param func a pointer to the function on obj (called on notify).
+     * @param batch_func a pointer to the function on obj called with a
+     *        whole batch of values (called on notifyBatch).
+     */
+    ProbeListenerArg(T *obj, const std::string &name,
+        void (T::* func)(const Arg &),
+        void (T::* batch_func)(const Arg *, size_t))
+        : ProbeListenerArgBase<Arg>(obj->getProbeManager(), name),
+          object(obj),
+          function(func),
+          batchFunction(batch_func)
     {}
 
     /**
@@ -250,6 +284,15 @@ class ProbeListenerArg : public ProbeListenerArgBase<Arg>
      * @param val the argument value to pass.
      */
     void notify(const Arg &val) override { (object->*function)(val); }
+
+    void
+    notifyBatch(const Arg *vals, size_t count) override
+    {
+        if (batchFunction)
+            (object->*batchFunction)(vals, count);
+        else
+            ProbeListenerArgBase<Arg>::notifyBatch(vals, count);
+    }
 };
 
 /**
@@ -278,7 +321,7 @@ class ProbePointArg : public ProbePoint
      *
      * @return Whether this probe has any listener.
      */
-    bool hasListeners() const { return listeners.size() > 0; }
+    bool hasListeners() const { return !listeners.empty(); }
 
     /**
      * @brief adds a ProbeListener to this ProbePoints notify list.
@@ -307,10 +350,39 @@ class ProbePointArg : public ProbePoint
 
     /**
      * @brief called at the ProbePoint call site, passes arg to each listener.
+     *
+     * Most probe points have no listeners in a normal run, so that case
+     * is kept down to a single inlined test of the listener vector.
+     *
      * @param arg the argument to pass to each listener.
      */
     void
     notify(const Arg &arg)
+    {
+        if (GEM5_LIKELY(listeners.empty()))
+            return;
+        notifyListeners(arg);
+    }
+
+    /**
+     * @brief passes a batch of values to each listener at once.
+     * @param vals the values to pass, in the order they were produced.
+     * @param count the number of values.
+     */
+    void
+    notifyBatch(const Arg *vals, size_t count)
+    {
+        if (GEM5_LIKELY(listeners.empty()) || count == 0)
+            return;
+        for (auto l = listeners.begin(); l != listeners.end(); ++l) {
+            (*l)->notifyBatch(vals, count);
+        }
+    }
+
+  private:
+    /** Out of line slow path of notify(). */
+    GEM5_NO_INLINE void
+    notifyListeners(const Arg &arg)
     {
         for (auto l = listeners.begin(); l != listeners.end(); ++l) {
             (*l)->notify(arg);
@@ -44,6 +44,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <climits>
 #include <csignal>
@@ -116,6 +117,7 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
       seWorkload(dynamic_cast<SEWorkload *>(system->workload)),
       useArchPT(params.useArchPT),
       kvmInSE(params.kvmInSE),
+      directSyscallIO(params.directSyscallIO),
       useForClone(false),
       pTable(pTable),
       objFile(obj_file),
@@ -364,6 +366,7 @@ Process::replicatePage(Addr vaddr, Addr new_paddr, ThreadContext *old_tc,
 bool
 Process::fixupFault(Addr vaddr)
 {
+    auto lock = seWorkload->lockEmulation();
     return memState->fixupFault(vaddr);
 }
 
@@ -409,6 +412,39 @@ Process::map(Addr vaddr, Addr paddr, int size, bool cacheable)
     return true;
 }
 
+bool
+Process::hostBuffer(Addr vaddr, Addr size, bool write,
+                    std::vector<struct iovec> &iov)
+{
+    iov.clear();
+    if (!directSyscallIO)
+        return false;
+
+    memory::PhysicalMemory &physmem = system->getPhysMem();
+    const Addr page_bytes = pTable->pageSize();
+    while (size > 0) {
+        Addr paddr;
+        if (!pTable->translate(vaddr, paddr))
+            return false;
+        Addr chunk = std::min(size, page_bytes - (vaddr & (page_bytes - 1)));
+        uint8_t *host = physmem.hostRange(paddr, chunk, write);
+        if (!host)
+            return false;
+
+        if (!iov.empty() &&
+            (uint8_t *)iov.back().iov_base + iov.back().iov_len == host) {
+            iov.back().iov_len += chunk;
+        } else {
+            if (iov.size() == IOV_MAX)
+                return false;
+            iov.push_back({host, chunk});
+        }
+        vaddr += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
 EmulatedDriver *
 Process::findDriver(std::string filename)
 {
@@ -31,6 +31,7 @@
 #define __PROCESS_HH__
 
 #include <inttypes.h>
+#include <sys/uio.h>
 
 #include <map>
 #include <memory>
@@ -161,6 +162,23 @@ class Process : public SimObject
      */
     bool map(Addr vaddr, Addr paddr, int size, bool cacheable = true);
 
+    /**
+     * Find the host memory backing a buffer in the address space of this
+     * process, so that a system call can pass it to the host directly
+     * instead of copying it through a port proxy. Physically contiguous
+     * pages are merged into a single I/O vector.
+     *
+     * @param vaddr The virtual address of the buffer.
+     * @param size The size of the buffer in bytes.
+     * @param write Whether the host writes to the buffer.
+     * @param iov The I/O vectors covering the buffer.
+     * @return False if direct access is disabled or part of the buffer is
+     *           not mapped to host memory, in which case the buffer has to
+     *           be copied.
+     */
+    bool hostBuffer(Addr vaddr, Addr size, bool write,
+                    std::vector<struct iovec> &iov);
+
     void replicatePage(Addr vaddr, Addr new_paddr, ThreadContext *old_tc,
                        ThreadContext *new_tc, bool alloc_page);
 
@@ -179,6 +197,8 @@ class Process : public SimObject
     bool useArchPT;
     // running KVM requires special initialization
     bool kvmInSE;
+    // let system calls access the backing store of guest buffers directly
+    bool directSyscallIO;
     // flag for using the process as a thread which shares page tables
     bool useForClone;
 
@@ -47,10 +47,14 @@
 
 #include <array>
 #include <cerrno>
+#include <cstddef>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include <gem5/m5ring.h>
+
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "cpu/base.hh"
@@ -595,5 +599,66 @@ workend(ThreadContext *tc, uint64_t workid, uint64_t threadid)
     }
 }
 
+void
+ringdrain(ThreadContext *tc)
+{
+    System *sys = tc->getSystemPtr();
+    const Addr base = sys->params().m5ops_ring_base;
+    if (!base)
+        return;
+
+    // CPUs on different event queues can drain at the same time
+    static std::mutex ringLock;
+    std::lock_guard<std::mutex> lock(ringLock);
+
+    const ByteOrder bo = sys->getGuestByteOrder();
+    PortProxy &proxy = sys->physProxy;
+    const Addr tail_addr = base + offsetof(m5_ring_header, tail);
+    const Addr entries = base + sizeof(m5_ring_header);
+
+    uint64_t tail = proxy.read<uint64_t>(tail_addr, bo);
+    const uint64_t start = tail;
+    while (true) {
+        const Addr entry = entries +
+            (tail % M5_RING_ENTRIES) * sizeof(m5_ring_entry);
+        // The guest publishes an entry by writing its sequence number last
+        if (proxy.read<uint64_t>(entry + offsetof(m5_ring_entry, seq), bo) !=
+            tail + 1) {
+            break;
+        }
+
+        const uint32_t func =
+            proxy.read<uint32_t>(entry + offsetof(m5_ring_entry, func), bo);
+        const uint32_t cpu =
+            proxy.read<uint32_t>(entry + offsetof(m5_ring_entry, cpu), bo);
+        const Addr args = entry + offsetof(m5_ring_entry, args);
+        const uint64_t arg0 = proxy.read<uint64_t>(args, bo);
+        const uint64_t arg1 = proxy.read<uint64_t>(args + 8, bo);
+
+        // Attribute the op to the CPU the guest issued it from
+        ThreadContext *issuer =
+            cpu < sys->threads.size() ? sys->threads[cpu] : tc;
+
+        DPRINTF(PseudoInst, "pseudo_inst::ringdrain: op %#x cpu %d "
+                "(%#x, %#x)\n", func, cpu, arg0, arg1);
+
+        switch (func) {
+          case M5OP_WORK_BEGIN:
+            workbegin(issuer, arg0, arg1);
+            break;
+          case M5OP_WORK_END:
+            workend(issuer, arg0, arg1);
+            break;
+          default:
+            warn_once("Unsupported m5 op %#x in the m5op ring\n", func);
+            break;
+        }
+        tail++;
+    }
+
+    if (tail != start)
+        proxy.write<uint64_t>(tail_addr, tail, bo);
+}
+
 } // namespace pseudo_inst
 } // namespace gem5
@@ -92,6 +92,7 @@ void debugbreak(ThreadContext *tc);
 void switchcpu(ThreadContext *tc);
 void workbegin(ThreadContext *tc, uint64_t workid, uint64_t threadid);
 void workend(ThreadContext *tc, uint64_t workid, uint64_t threadid);
+void ringdrain(ThreadContext *tc);
 void m5Syscall(ThreadContext *tc);
 void togglesync(ThreadContext *tc);
 void triggerWorkloadEvent(ThreadContext *tc);
@@ -214,6 +215,10 @@ pseudoInstWork(ThreadContext *tc, uint8_t func, uint64_t &result)
         invokeSimcall<ABI>(tc, workend);
         return true;
 
+      case M5OP_RING_DRAIN:
+        invokeSimcall<ABI>(tc, ringdrain);
+        return true;
+
       case M5OP_RESERVED1:
       case M5OP_RESERVED2:
       case M5OP_RESERVED3:
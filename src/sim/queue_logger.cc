@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/queue_logger.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <ostream>
+
+#include "base/output.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace Trace {
+
+/** The buffered messages and the file of one event queue. */
+struct QueueLogger::Sink
+{
+    /** Appends everything written to it to a string. */
+    class Buf : public std::streambuf
+    {
+      private:
+        std::string &data;
+
+      protected:
+        int_type
+        overflow(int_type c) override
+        {
+            if (c != traits_type::eof())
+                data += traits_type::to_char_type(c);
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize
+        xsputn(const char *s, std::streamsize n) override
+        {
+            data.append(s, n);
+            return n;
+        }
+
+      public:
+        Buf(std::string &_data) : data(_data) {}
+    };
+
+    /** Protects data against the flusher. */
+    std::mutex mutex;
+    std::string data;
+
+    /** What the flusher is writing, only used with flushMutex held. */
+    std::string spare;
+
+    Buf buf;
+    std::ostream os;
+
+    /** Formats messages into data. */
+    OstreamLogger formatter;
+
+    OutputStream *file;
+
+    Sink(OutputStream *_file)
+        : buf(data), os(&buf), formatter(os), file(_file)
+    {}
+};
+
+namespace
+{
+
+std::atomic<uint64_t> queueLoggers(0);
+
+} // anonymous namespace
+
+QueueLogger::QueueLogger(const std::string &base_name, OutputDirectory &_dir)
+    : baseName(base_name), dir(_dir), serial(++queueLoggers)
+{
+    thread = std::thread([this]() { flusher(); });
+}
+
+QueueLogger::~QueueLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+    flush();
+}
+
+std::string
+QueueLogger::fileName(const std::string &base_name, const std::string &queue)
+{
+    const size_t len = base_name.length();
+    if (len > 3 && base_name.find(".gz", len - 3) < len)
+        return base_name.substr(0, len - 3) + "." + queue + ".gz";
+    return base_name + "." + queue;
+}
+
+QueueLogger::Sink &
+QueueLogger::sink()
+{
+    const EventQueue *eq = curEventQueue();
+    if (!eq)
+        eq = getEventQueue(0);
+
+    thread_local uint64_t owner = 0;
+    thread_local const EventQueue *cached_eq = nullptr;
+    thread_local Sink *cached = nullptr;
+    if (owner == serial && cached_eq == eq)
+        return *cached;
+
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    auto &entry = sinks[eq];
+    if (!entry) {
+        auto it = std::find(mainEventQueue.begin(), mainEventQueue.end(), eq);
+        const std::string queue = it != mainEventQueue.end() ?
+            std::to_string(it - mainEventQueue.begin()) : eq->name();
+        entry.reset(new Sink(dir.create(fileName(baseName, queue))));
+    }
+
+    owner = serial;
+    cached_eq = eq;
+    cached = entry.get();
+    return *cached;
+}
+
+void
+QueueLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    Sink &s = sink();
+    size_t buffered;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.formatter.logMessage(when, name, flag, message);
+        buffered = s.data.size();
+    }
+
+    if (buffered >= FlushBytes) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        if (!flushRequested) {
+            flushRequested = true;
+            wake.notify_one();
+        }
+    }
+}
+
+std::ostream &
+QueueLogger::getOstream()
+{
+    return sink().os;
+}
+
+void
+QueueLogger::flusher()
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!stopping) {
+        wake.wait_for(lock, FlushPeriod,
+                      [this]() { return stopping || flushRequested; });
+        flushRequested = false;
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void
+QueueLogger::flush()
+{
+    std::lock_guard<std::mutex> flush_lock(flushMutex);
+
+    std::vector<Sink *> to_flush;
+    {
+        std::lock_guard<std::mutex> lock(sinksMutex);
+        for (auto &entry : sinks)
+            to_flush.push_back(entry.second.get());
+    }
+
+    // Only hold the lock of a sink while taking its messages, so its
+    // queue can go on logging while they are written.
+    for (Sink *s : to_flush) {
+        {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            s->data.swap(s->spare);
+        }
+        if (s->spare.empty())
+            continue;
+        std::ostream &os = *s->file->stream();
+        os.write(s->spare.data(), s->spare.size());
+        os.flush();
+        s->spare.clear();
+    }
+}
+
+} // namespace Trace
+} // namespace gem5
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_QUEUE_LOGGER_HH__
+#define __SIM_QUEUE_LOGGER_HH__
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/trace.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class EventQueue;
+class OutputDirectory;
+class OutputStream;
+
+namespace Trace {
+
+/**
+ * Logger that gives every event queue a file of its own, so threads of
+ * a parallel simulation neither interleave their messages nor wait on
+ * each other to write them. The messages of a queue are formatted like
+ * OstreamLogger does and collected in memory; a background thread
+ * writes them to the file of the queue. The file of the queue with
+ * index N in mainEventQueue is the base name with ".N" added, before any
+ * ".gz". util/merge_debug_traces.py merges the files back by tick.
+ */
+class QueueLogger : public Logger
+{
+  public:
+    /** Wake the flusher once a queue has buffered this many bytes. */
+    static constexpr size_t FlushBytes = 1 << 16;
+
+    /** How often the flusher writes out what has been buffered. */
+    static constexpr std::chrono::milliseconds FlushPeriod{100};
+
+    QueueLogger(const std::string &base_name, OutputDirectory &dir);
+    ~QueueLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    /**
+     * The stream of the current event queue. Text written to it is
+     * buffered like messages are.
+     */
+    std::ostream &getOstream() override;
+
+    /** Write everything that has been buffered to the files. */
+    void flush();
+
+    /** The name of the file of a queue, like "debug.log.1". */
+    static std::string fileName(const std::string &base_name,
+                                const std::string &queue);
+
+  protected:
+    struct Sink;
+
+    /** The sink of the current event queue, created on first use. */
+    Sink &sink();
+
+    /** Body of the flusher thread. */
+    void flusher();
+
+    const std::string baseName;
+    OutputDirectory &dir;
+
+    /** Protects the list of sinks. */
+    std::mutex sinksMutex;
+    std::unordered_map<const EventQueue *, std::unique_ptr<Sink>> sinks;
+
+    /** Serializes writing the files. */
+    std::mutex flushMutex;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    bool flushRequested = false;
+    std::thread thread;
+
+    /** Tells loggers apart in the per-thread sink caches. */
+    const uint64_t serial;
+};
+
+} // namespace Trace
+} // namespace gem5
+
+#endif // __SIM_QUEUE_LOGGER_HH__
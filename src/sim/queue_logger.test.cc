@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/output.hh"
+#include "sim/eventq.hh"
+#include "sim/queue_logger.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** A fresh output directory in the temporary directory. */
+class QueueLoggerTest : public testing::Test
+{
+  protected:
+    OutputDirectory dir;
+
+    void
+    SetUp() override
+    {
+        char path[] = "/tmp/queue_logger.test.XXXXXX";
+        ASSERT_NE(mkdtemp(path), nullptr);
+        dir.setDirectory(path);
+    }
+
+    std::string
+    contents(const std::string &name)
+    {
+        std::ifstream file(dir.resolve(name));
+        std::ostringstream oss;
+        oss << file.rdbuf();
+        return oss.str();
+    }
+};
+
+} // anonymous namespace
+
+/** Test the names of the files of the queues. */
+TEST(QueueLoggerNameTest, FileName)
+{
+    ASSERT_EQ(Trace::QueueLogger::fileName("debug.log", "3"), "debug.log.3");
+    ASSERT_EQ(Trace::QueueLogger::fileName("trace.gz", "0"), "trace.0.gz");
+}
+
+/** Test that every queue writes its messages to its own file. */
+TEST_F(QueueLoggerTest, SplitByQueue)
+{
+    EventQueue *q0 = getEventQueue(0);
+    EventQueue *q1 = getEventQueue(1);
+    {
+        Trace::QueueLogger logger("debug", dir);
+        curEventQueue(q0);
+        logger.logMessage(10, "a", "", "first\n");
+        curEventQueue(q1);
+        logger.logMessage(20, "b", "", "second\n");
+        logger.getOstream() << "text\n";
+        curEventQueue(q0);
+        logger.logMessage(30, "a", "", "third\n");
+    }
+
+    ASSERT_EQ(contents("debug.0"), "     10: a: first\n     30: a: third\n");
+    ASSERT_EQ(contents("debug.1"), "     20: b: second\ntext\n");
+}
+
+/** Test that flush() writes what has been buffered so far. */
+TEST_F(QueueLoggerTest, Flush)
+{
+    curEventQueue(getEventQueue(0));
+    Trace::QueueLogger logger("debug", dir);
+    logger.logMessage(10, "a", "", "first\n");
+    logger.flush();
+    ASSERT_EQ(contents("debug.0"), "     10: a: first\n");
+}
@@ -41,6 +41,8 @@
 
 #include "base/hostinfo.hh"
 #include "base/logging.hh"
+#include "base/output.hh"
+#include "base/statistics.hh"
 #include "base/trace.hh"
 #include "debug/TimeSync.hh"
 #include "sim/core.hh"
@@ -48,6 +50,7 @@
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
 #include "sim/root.hh"
+#include "sim/simulate.hh"
 
 namespace gem5
 {
@@ -56,6 +59,20 @@ Root *Root::_root = NULL;
 Root::RootStats Root::RootStats::instance;
 Root::RootStats &rootStats = Root::RootStats::instance;
 
+namespace
+{
+
+uint64_t
+numMainEventQueueEvents()
+{
+    uint64_t events = 0;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        events += mainEventQueue[i]->numServiced();
+    return events;
+}
+
+} // anonymous namespace
+
 Root::RootStats::RootStats()
     : statistics::Group(nullptr),
     ADD_STAT(simSeconds, statistics::units::Second::get(),
@@ -75,9 +92,12 @@ Root::RootStats::RootStats()
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, statistics::units::Byte::get(),
              "Number of bytes of host memory used"),
+    ADD_STAT(hostEvents, statistics::units::Count::get(),
+             "Number of events serviced by the main event queues"),
 
     statTime(true),
-    startTick(0)
+    startTick(0),
+    startEvents(0)
 {
     simFreq.scalar(sim_clock::Frequency);
     simTicks.functor([this]() { return curTick() - startTick; });
@@ -88,6 +108,10 @@ Root::RootStats::RootStats()
         .prereq(hostMemory)
         ;
 
+    hostEvents.functor([this]() {
+            return numMainEventQueueEvents() - startEvents;
+        });
+
     hostSeconds
         .functor([this]() {
                 Time now;
@@ -108,6 +132,7 @@ Root::RootStats::resetStats()
 {
     statTime.setTimer();
     startTick = curTick();
+    startEvents = numMainEventQueueEvents();
 
     statistics::Group::resetStats();
 }
@@ -175,6 +200,32 @@ Root::timeSyncSpinThreshold(Time newThreshold)
     timeSyncEnable(en);
 }
 
+namespace
+{
+
+OutputStream *eventqProfileStream = nullptr;
+
+void
+dumpEventQueueProfiles()
+{
+    if (!eventqProfileStream)
+        eventqProfileStream = simout.create("eventq_profile.txt");
+
+    std::ostream &os = *eventqProfileStream->stream();
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->dumpProfile(os);
+    os.flush();
+}
+
+void
+resetEventQueueProfiles()
+{
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->resetProfile();
+}
+
+} // anonymous namespace
+
 Root::Root(const RootParams &p, int)
     : SimObject(p), _enabled(false), _periodTick(p.time_sync_period),
       syncEvent([this]{ timeSync(); }, name())
@@ -187,6 +238,22 @@ Root::Root(const RootParams &p, int)
     lastTime.setTimer();
 
     simQuantum = p.sim_quantum;
+    simQuantumMax = p.sim_quantum_max;
+    setEventQueueHostCpus(p.eventq_host_cpus);
+
+    setMainEventQueueBackend(p.eventq_backend == enums::calendar ?
+            EventQueue::CalendarBackend : EventQueue::SortedListBackend);
+
+    if (p.eventq_profile) {
+        setMainEventQueueProfiling(true, p.eventq_profile_sample,
+                                   p.eventq_profile_counters);
+        statistics::registerDumpCallback([this]() {
+                updateHostProfileStats();
+            });
+        statistics::registerDumpCallback(dumpEventQueueProfiles);
+        statistics::registerResetCallback(resetEventQueueProfiles);
+        registerExitCallback(dumpEventQueueProfiles);
+    }
 
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
@@ -201,6 +268,106 @@ Root::startup()
     timeSyncEnable(params().time_sync_enable);
 }
 
+void
+Root::regStats()
+{
+    // All the object stat groups are in place by now, and stats can't be
+    // added anymore once they are enabled.
+    if (params().eventq_profile)
+        addHostProfileStats(this, nullptr);
+
+    SimObject::regStats();
+}
+
+Root::HostProfileStats::HostProfileStats(SimObject *owner,
+                                         HostProfileStats *parent)
+    : statistics::Group(owner, "hostProfile"), parent(parent),
+      ADD_STAT(events, statistics::units::Count::get(),
+               "Number of events serviced for this object and the objects "
+               "below it"),
+      ADD_STAT(seconds, statistics::units::Second::get(),
+               "Host time spent in these events"),
+      ADD_STAT(cycles, statistics::units::Cycle::get(),
+               "Host cycles spent in these events"),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Host instructions executed by these events"),
+      ADD_STAT(cacheMisses, statistics::units::Count::get(),
+               "Host cache misses caused by these events"),
+      ADD_STAT(ipc, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Cycle>::get(),
+               "Host instructions per cycle of these events")
+{
+    // Most objects never schedule an event of their own.
+    events.prereq(events);
+    seconds.prereq(events);
+    cycles.prereq(cycles);
+    insts.prereq(cycles);
+    cacheMisses.prereq(cycles);
+    ipc.prereq(cycles);
+
+    ipc = insts / cycles;
+}
+
+void
+Root::HostProfileStats::add(const EventQueue::ProfileEntry &entry)
+{
+    for (HostProfileStats *stats = this; stats; stats = stats->parent) {
+        stats->events += entry.calls;
+        stats->seconds += entry.hostNs / 1e9;
+        stats->cycles += entry.counters[HostCounters::Cycles];
+        stats->insts += entry.counters[HostCounters::Instructions];
+        stats->cacheMisses += entry.counters[HostCounters::CacheMisses];
+    }
+}
+
+void
+Root::addHostProfileStats(statistics::Group *group,
+                          HostProfileStats *parent)
+{
+    // Take a copy, the new group is added next to the children.
+    const auto children = group->getStatGroups();
+
+    if (auto *obj = dynamic_cast<SimObject *>(group)) {
+        hostProfileStats.emplace_back(new HostProfileStats(obj, parent));
+        parent = hostProfileStats.back().get();
+        hostProfileOwners[obj->name()] = parent;
+    }
+
+    for (const auto &child : children)
+        addHostProfileStats(child.second, parent);
+}
+
+Root::HostProfileStats *
+Root::hostProfileOwner(const std::string &name)
+{
+    auto it = hostProfileOwners.find(name);
+    if (it != hostProfileOwners.end())
+        return it->second;
+
+    // Events are named after the object that owns them, possibly with
+    // a suffix naming the event. Whatever can't be matched to an object
+    // is only accounted to the root.
+    HostProfileStats *owner = hostProfileStats.front().get();
+    auto pos = name.rfind('.');
+    if (pos != std::string::npos)
+        owner = hostProfileOwner(name.substr(0, pos));
+    hostProfileOwners[name] = owner;
+    return owner;
+}
+
+void
+Root::updateHostProfileStats()
+{
+    // The profile holds everything since the last stats reset.
+    for (auto &stats : hostProfileStats)
+        stats->resetStats();
+
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        for (const auto &entry : mainEventQueue[i]->getProfile())
+            hostProfileOwner(entry.first)->add(entry.second);
+    }
+}
+
 void
 Root::serialize(CheckpointOut &cp) const
 {
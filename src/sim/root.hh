@@ -51,6 +51,11 @@
 #ifndef __SIM_ROOT_HH__
 #define __SIM_ROOT_HH__
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "base/types.hh"
@@ -80,6 +85,38 @@ class Root : public SimObject
     void timeSync();
     EventFunctionWrapper syncEvent;
 
+    /**
+     * Host cost of the profiled events of an object and all the objects
+     * below it, estimated by the event queue profile. Events are
+     * attributed to the object they are named after.
+     */
+    struct HostProfileStats : public statistics::Group
+    {
+        HostProfileStats(SimObject *owner, HostProfileStats *parent);
+
+        /** Account the given events here and in all the parents. */
+        void add(const EventQueue::ProfileEntry &entry);
+
+        HostProfileStats *const parent;
+
+        statistics::Scalar events;
+        statistics::Scalar seconds;
+        statistics::Scalar cycles;
+        statistics::Scalar insts;
+        statistics::Scalar cacheMisses;
+        statistics::Formula ipc;
+    };
+
+    /** Host profile stats of all objects, the root's first. */
+    std::vector<std::unique_ptr<HostProfileStats>> hostProfileStats;
+    /** Host profile stats to account an object's or event's name to. */
+    std::unordered_map<std::string, HostProfileStats *> hostProfileOwners;
+
+    void addHostProfileStats(statistics::Group *group,
+                             HostProfileStats *parent);
+    HostProfileStats *hostProfileOwner(const std::string &name);
+    void updateHostProfileStats();
+
   public:
     /**
      * Use this function to get a pointer to the single Root object in the
@@ -109,6 +146,7 @@ class Root : public SimObject
 
         statistics::Formula hostTickRate;
         statistics::Value hostMemory;
+        statistics::Value hostEvents;
 
         static RootStats instance;
 
@@ -120,6 +158,7 @@ class Root : public SimObject
 
         Time statTime;
         Tick startTick;
+        uint64_t startEvents;
     };
 
   public:
@@ -148,6 +187,8 @@ class Root : public SimObject
      */
     void startup() override;
 
+    void regStats() override;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 };
@@ -27,6 +27,7 @@
 
 #include "sim/se_workload.hh"
 
+#include "cpu/base.hh"
 #include "cpu/thread_context.hh"
 #include "params/SEWorkload.hh"
 #include "sim/process.hh"
@@ -71,6 +72,20 @@ SEWorkload::syscall(ThreadContext *tc)
     tc->getProcessPtr()->syscall(tc);
 }
 
+void
+SEWorkload::updateContext(ThreadContext *tc, std::function<void()> update)
+{
+    EventQueue *eq = tc->getCpuPtr()->eventQueue();
+    if (!inParallelMode || eq == curEventQueue()) {
+        update();
+        return;
+    }
+
+    eq->schedule(new EventFunctionWrapper(update,
+                     "SEWorkload context update", true),
+                 curTick() + simQuantum, true);
+}
+
 Addr
 SEWorkload::allocPhysPages(int npages, int pool_id)
 {
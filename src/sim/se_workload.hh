@@ -28,6 +28,9 @@
 #ifndef __SIM_SE_WORKLOAD_HH__
 #define __SIM_SE_WORKLOAD_HH__
 
+#include <functional>
+#include <mutex>
+
 #include "params/SEWorkload.hh"
 #include "sim/mem_pool.hh"
 #include "sim/workload.hh"
@@ -41,6 +44,12 @@ class SEWorkload : public Workload
     /** Memory allocation objects for all physical memories in the system. */
     MemPools memPools;
 
+    /**
+     * Serializes the emulation of system calls and page faults, which
+     * CPUs on different event queues may request concurrently.
+     */
+    std::recursive_mutex emulationMutex;
+
   public:
     using Params = SEWorkloadParams;
 
@@ -89,6 +98,25 @@ class SEWorkload : public Workload
     // For now, assume the only type of events are system calls.
     void event(ThreadContext *tc) override { syscall(tc); }
 
+    /**
+     * Lock the state of the emulated OS (processes, memory state, futexes,
+     * physical page allocation) for the calling CPU.
+     */
+    std::unique_lock<std::recursive_mutex>
+    lockEmulation()
+    {
+        return std::unique_lock<std::recursive_mutex>(emulationMutex);
+    }
+
+    /**
+     * Apply a change to a thread context, e.g. activating or halting it,
+     * on behalf of the thread context that is emulating a system call.
+     * Thread contexts of CPUs on other event queues are changed by an
+     * asynchronous event one simulation quantum in the future, because
+     * only the thread servicing a queue may reschedule its events.
+     */
+    void updateContext(ThreadContext *tc, std::function<void()> update);
+
     Addr allocPhysPages(int npages, int pool_id=0);
     Addr memSize(int pool_id=0) const;
     Addr freeMemSize(int pool_id=0) const;
@@ -42,12 +42,17 @@
 
 #include "sim/serialize.hh"
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <cassert>
 #include <cerrno>
+#include <cstdio>
+#include <string_view>
 
 #include "base/trace.hh"
 #include "debug/Checkpoint.hh"
@@ -135,6 +140,58 @@ Serializable::currentSection()
 }
 
 const char *CheckpointIn::baseFilename = "m5.cpt";
+const char *CheckpointIn::binaryFilename = "m5.cpt.bin";
+
+/*
+ * The binary index consists of a header, a table of sections sorted
+ * by name, a table of entries per section sorted by name, and the
+ * strings they refer to. All fields are 64-bit host endian words and
+ * all offsets are relative to the start of the file.
+ */
+namespace
+{
+
+constexpr uint64_t BinaryCptMagic = 0x42545043354d4547ULL; // "GEM5CPTB"
+
+enum BinaryCptHeader
+{
+    HeaderMagic,
+    HeaderTextSize,
+    HeaderTextMtime,
+    HeaderNumSections,
+    HeaderWords
+};
+
+/** Words per section or entry: name offset and size, 2 data words. */
+constexpr uint64_t BinaryCptRecordWords = 4;
+
+std::string_view
+binaryName(const char *bin, const uint64_t *record)
+{
+    return std::string_view(bin + record[0], record[1]);
+}
+
+/** Binary search a sorted table of records for a name. */
+const uint64_t *
+findBinaryRecord(const char *bin, const uint64_t *table, uint64_t count,
+                 std::string_view name)
+{
+    uint64_t lo = 0, hi = count;
+    while (lo < hi) {
+        const uint64_t mid = lo + (hi - lo) / 2;
+        const uint64_t *record = table + mid * BinaryCptRecordWords;
+        const int cmp = binaryName(bin, record).compare(name);
+        if (cmp == 0)
+            return record;
+        else if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
 
 std::string CheckpointIn::currentDirectory;
 
@@ -160,8 +217,140 @@ CheckpointIn::CheckpointIn(const std::string &cpt_dir)
     : db(), _cptDir(setDir(cpt_dir))
 {
     std::string filename = getCptDir() + "/" + CheckpointIn::baseFilename;
-    if (!db.load(filename)) {
+    std::string bin_file = getCptDir() + "/" + CheckpointIn::binaryFilename;
+    if (!loadBinary(filename, bin_file) && !db.load(filename)) {
+        fatal("Can't load checkpoint file '%s'\n", filename);
+    }
+}
+
+CheckpointIn::~CheckpointIn()
+{
+    if (bin)
+        munmap(const_cast<char *>(bin), binSize);
+}
+
+bool
+CheckpointIn::loadBinary(const std::string &filename,
+                         const std::string &bin_file)
+{
+    int fd = open(bin_file.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat text_st, bin_st;
+    void *map = MAP_FAILED;
+    if (stat(filename.c_str(), &text_st) == 0 && fstat(fd, &bin_st) == 0 &&
+        bin_st.st_size >= (off_t)(HeaderWords * sizeof(uint64_t))) {
+        map = mmap(nullptr, bin_st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) {
+        warn("Can't load binary checkpoint file '%s', using '%s'\n",
+             bin_file, filename);
+        return false;
+    }
+
+    // the index is only valid as long as the text it was made from
+    // is unchanged, e.g., not updated by the checkpoint upgrader
+    const uint64_t *header = (const uint64_t *)map;
+    if (header[HeaderMagic] != BinaryCptMagic ||
+        header[HeaderTextSize] != (uint64_t)text_st.st_size ||
+        header[HeaderTextMtime] != (uint64_t)text_st.st_mtime ||
+        (HeaderWords + header[HeaderNumSections] * BinaryCptRecordWords) *
+        sizeof(uint64_t) > (uint64_t)bin_st.st_size) {
+        warn("Binary checkpoint file '%s' is out of date, using '%s'\n",
+             bin_file, filename);
+        munmap(map, bin_st.st_size);
+        return false;
+    }
+
+    bin = (const char *)map;
+    binSize = bin_st.st_size;
+    return true;
+}
+
+const uint64_t *
+CheckpointIn::findBinarySection(const std::string &section) const
+{
+    const uint64_t *header = (const uint64_t *)bin;
+    return findBinaryRecord(bin, header + HeaderWords,
+                            header[HeaderNumSections], section);
+}
+
+std::string
+CheckpointIn::binaryString(uint64_t offset, uint64_t size) const
+{
+    return std::string(bin + offset, size);
+}
+
+void
+CheckpointIn::writeBinary(const std::string &cpt_dir)
+{
+    // use the same directory name as the checkpoint was written to
+    std::string dir = setDir(cpt_dir);
+    std::string filename = dir + CheckpointIn::baseFilename;
+    std::string bin_file = dir + CheckpointIn::binaryFilename;
+
+    IniFile db;
+    struct stat text_st;
+    if (stat(filename.c_str(), &text_st) || !db.load(filename))
         fatal("Can't load checkpoint file '%s'\n", filename);
+
+    std::vector<std::string> sections;
+    db.getSectionNames(sections);
+    std::sort(sections.begin(), sections.end());
+
+    using Entries = std::vector<std::pair<std::string, std::string>>;
+    std::vector<Entries> entries(sections.size());
+    uint64_t nbr_of_entries = 0;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        db.visitSection(sections[i], [&](const std::string &name,
+                                         const std::string &value) {
+            entries[i].emplace_back(name, value);
+        });
+        std::sort(entries[i].begin(), entries[i].end());
+        nbr_of_entries += entries[i].size();
+    }
+
+    // lay out the tables first and the strings after them
+    const uint64_t words = HeaderWords +
+        (sections.size() + nbr_of_entries) * BinaryCptRecordWords;
+    std::vector<uint64_t> tables(words);
+    std::string strings;
+    auto add_string = [&](const std::string &str, uint64_t *record) {
+        record[0] = words * sizeof(uint64_t) + strings.size();
+        record[1] = str.size();
+        strings += str;
+    };
+
+    tables[HeaderMagic] = BinaryCptMagic;
+    tables[HeaderTextSize] = text_st.st_size;
+    tables[HeaderTextMtime] = text_st.st_mtime;
+    tables[HeaderNumSections] = sections.size();
+
+    uint64_t next_entry = HeaderWords + sections.size() * BinaryCptRecordWords;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        uint64_t *section =
+            &tables[HeaderWords + i * BinaryCptRecordWords];
+        add_string(sections[i], section);
+        section[2] = next_entry * sizeof(uint64_t);
+        section[3] = entries[i].size();
+        for (const auto &[name, value] : entries[i]) {
+            uint64_t *entry = &tables[next_entry];
+            add_string(name, entry);
+            add_string(value, entry + 2);
+            next_entry += BinaryCptRecordWords;
+        }
+    }
+
+    // write to a temporary file first such that a partial index is
+    // never picked up
+    std::string tmp_file = bin_file + ".tmp";
+    FILE *f = fopen(tmp_file.c_str(), "wb");
+    if (!f || fwrite(tables.data(), sizeof(uint64_t), words, f) != words ||
+        fwrite(strings.data(), 1, strings.size(), f) != strings.size() ||
+        fclose(f) || rename(tmp_file.c_str(), bin_file.c_str())) {
+        fatal("Can't write binary checkpoint file '%s'\n", bin_file);
     }
 }
 
@@ -177,6 +366,10 @@ CheckpointIn::CheckpointIn(const std::string &cpt_dir)
 bool
 CheckpointIn::entryExists(const std::string &section, const std::string &entry)
 {
+    if (bin) {
+        std::string value;
+        return find(section, entry, value);
+    }
     return db.entryExists(section, entry);
 }
 /**
@@ -193,12 +386,25 @@ bool
 CheckpointIn::find(const std::string &section, const std::string &entry,
         std::string &value)
 {
+    if (bin) {
+        const uint64_t *sec = findBinarySection(section);
+        if (!sec)
+            return false;
+        const uint64_t *record = findBinaryRecord(
+            bin, (const uint64_t *)(bin + sec[2]), sec[3], entry);
+        if (!record)
+            return false;
+        value = binaryString(record[2], record[3]);
+        return true;
+    }
     return db.find(section, entry, value);
 }
 
 bool
 CheckpointIn::sectionExists(const std::string &section)
 {
+    if (bin)
+        return findBinarySection(section) != nullptr;
     return db.sectionExists(section);
 }
 
@@ -206,6 +412,16 @@ void
 CheckpointIn::visitSection(const std::string &section,
     IniFile::VisitSectionCallback cb)
 {
+    if (bin) {
+        const uint64_t *sec = findBinarySection(section);
+        if (!sec)
+            return;
+        const uint64_t *record = (const uint64_t *)(bin + sec[2]);
+        for (uint64_t i = 0; i < sec[3]; ++i, record += BinaryCptRecordWords)
+            cb(binaryString(record[0], record[1]),
+               binaryString(record[2], record[3]));
+        return;
+    }
     db.visitSection(section, cb);
 }
 
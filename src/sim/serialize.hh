@@ -47,6 +47,7 @@
 
 
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -72,9 +73,25 @@ class CheckpointIn
 
     const std::string _cptDir;
 
+    /**
+     * The binary index of the checkpoint (see writeBinary()), mapped
+     * into memory. It is used instead of the ini file when present.
+     */
+    const char *bin = nullptr;
+    size_t binSize = 0;
+
+    /** Load the binary index of the checkpoint, if it is up to date. */
+    bool loadBinary(const std::string &filename, const std::string &bin_file);
+
+    /** Find the entry table of a section in the binary index. */
+    const uint64_t *findBinarySection(const std::string &section) const;
+
+    /** Get a string stored in the binary index. */
+    std::string binaryString(uint64_t offset, uint64_t size) const;
+
   public:
     CheckpointIn(const std::string &cpt_dir);
-    ~CheckpointIn() = default;
+    ~CheckpointIn();
 
     /**
      * @return Returns the current directory being used for creating
@@ -128,8 +145,22 @@ class CheckpointIn
      */
     static std::string dir();
 
+    /**
+     * Write a binary, indexed copy of the checkpoint in the given
+     * directory, which is then used for subsequent restores. Sections
+     * and entries are sorted and looked up in place, so a restore no
+     * longer parses all of the checkpoint text. The index is ignored
+     * if the text checkpoint changes afterwards.
+     *
+     * @ingroup api_serialize
+     */
+    static void writeBinary(const std::string &cpt_dir);
+
     // Filename for base checkpoint file within directory.
     static const char *baseFilename;
+
+    // Filename for the binary index within directory.
+    static const char *binaryFilename;
 };
 
 /**
@@ -263,6 +263,52 @@ TEST_F(CheckpointInFixture, ExtractEntries)
     ASSERT_FALSE(cpt->find("Junk", "test4", value));
 }
 
+/** Test that the binary index gives the same results as the ini file. */
+TEST_F(CheckpointInFixture, BinaryEntries)
+{
+    CheckpointIn::writeBinary(getDirName());
+    CheckpointIn bin_cpt(getDirName());
+    std::string value;
+
+    ASSERT_TRUE(bin_cpt.sectionExists("General"));
+    ASSERT_TRUE(bin_cpt.sectionExists("Foo"));
+    ASSERT_FALSE(bin_cpt.sectionExists("Junk2"));
+    ASSERT_TRUE(bin_cpt.entryExists("General", "Test3"));
+    ASSERT_FALSE(bin_cpt.entryExists("Junk", "test4"));
+
+    ASSERT_TRUE(bin_cpt.find("General", "Test1", value));
+    ASSERT_EQ(value, "BARasdf");
+    ASSERT_TRUE(bin_cpt.find("General", "Test3", value));
+    ASSERT_EQ(value, "89");
+    ASSERT_TRUE(bin_cpt.find("Junk", "Test4", value));
+    ASSERT_EQ(value, "mama mia");
+    ASSERT_FALSE(bin_cpt.find("Junk2", "test3", value));
+    ASSERT_FALSE(bin_cpt.find("Foo", "Foo3", value));
+
+    std::vector<std::string> names;
+    bin_cpt.visitSection("Foo", [&](const std::string &name,
+                                    const std::string &value) {
+        names.push_back(name + "=" + value);
+    });
+    ASSERT_THAT(names, testing::ElementsAre("Foo1=89", "Foo2=384"));
+}
+
+/** Test that a binary index is ignored once the ini file changes. */
+TEST_F(CheckpointInFixture, BinaryOutOfDate)
+{
+    CheckpointIn::writeBinary(getDirName());
+    simulateSerialization("[General]\nTest1=updated\n");
+
+    gtestLogOutput.str("");
+    CheckpointIn bin_cpt(getDirName());
+    ASSERT_THAT(gtestLogOutput.str(), testing::HasSubstr("out of date"));
+
+    std::string value;
+    ASSERT_TRUE(bin_cpt.find("General", "Test1", value));
+    ASSERT_EQ(value, "updated");
+    ASSERT_FALSE(bin_cpt.sectionExists("Foo"));
+}
+
 /**
  * Test that paths are increased and decreased according to the scope that
  * its SCS was created in (using CheckpointIn).
@@ -148,6 +148,36 @@ SimObject::serializeAll(const std::string &cpt_dir)
    }
 }
 
+namespace
+{
+
+bool
+inSubtree(const std::string &name, const std::string &root)
+{
+    return root.empty() || (name.compare(0, root.size(), root) == 0 &&
+        (name.size() == root.size() || name[root.size()] == '.'));
+}
+
+} // anonymous namespace
+
+void
+SimObject::memWritebackAll(const std::string &root)
+{
+    for (SimObject *obj : simObjectList) {
+        if (inSubtree(obj->name(), root))
+            obj->memWriteback();
+    }
+}
+
+void
+SimObject::memInvalidateAll(const std::string &root)
+{
+    for (SimObject *obj : simObjectList) {
+        if (inSubtree(obj->name(), root))
+            obj->memInvalidate();
+    }
+}
+
 #ifdef DEBUG
 //
 // static function: flag which objects should have the debugger break
@@ -329,6 +329,24 @@ class SimObject : public EventManager, public Serializable, public Drainable,
      */
     static void serializeAll(const std::string &cpt_dir);
 
+    /**
+     * Call memWriteback() on all objects in a subtree of the object
+     * hierarchy, without a round trip through Python per object.
+     *
+     * @param root Name of the root of the subtree, or an empty string
+     *             for all objects.
+     */
+    static void memWritebackAll(const std::string &root);
+
+    /**
+     * Call memInvalidate() on all objects in a subtree of the object
+     * hierarchy, see memWritebackAll().
+     *
+     * @param root Name of the root of the subtree, or an empty string
+     *             for all objects.
+     */
+    static void memInvalidateAll(const std::string &root);
+
 #ifdef DEBUG
   public:
     bool doDebugBreak;
@@ -43,9 +43,15 @@
 #include "sim/simulate.hh"
 
 #include <atomic>
+#include <cstring>
 #include <mutex>
 #include <thread>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "base/logging.hh"
 #include "base/pollevent.hh"
 #include "base/types.hh"
@@ -63,6 +69,43 @@ Event *doSimLoop(EventQueue *);
 
 GlobalSimLoopExitEvent *simulate_limit_event = nullptr;
 
+static std::vector<int> eventqHostCpus;
+
+void
+setEventQueueHostCpus(const std::vector<int> &cpus)
+{
+    eventqHostCpus = cpus;
+}
+
+/**
+ * Bind the calling thread to the host CPU configured for the given
+ * event queue, if any. Keeping each queue on one core (and thus one
+ * NUMA node) avoids migrations that slow down the quantum barriers,
+ * and makes memory the thread touches first local to it.
+ */
+static void
+pinToHostCpu(uint32_t queue)
+{
+    if (queue >= eventqHostCpus.size() || eventqHostCpus[queue] < 0)
+        return;
+
+    const int cpu = eventqHostCpus[queue];
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set),
+                                     &cpu_set);
+    if (err) {
+        warn("Failed to pin event queue %d to host CPU %d: %s\n",
+             queue, cpu, strerror(err));
+    }
+#else
+    warn_once("Pinning event queues to host CPUs is only supported on "
+              "Linux hosts.\n");
+#endif
+}
+
 class SimulatorThreads
 {
   public:
@@ -99,9 +142,11 @@ class SimulatorThreads
             // the main thread (the one running Python) handles queue 0,
             // so we only need to allocate new threads for queues 1..N-1.
             // We'll call these the "subordinate" threads.
+            pinToHostCpu(0);
             for (uint32_t i = 1; i < numQueues; i++) {
                 threads.emplace_back(
-                    [this](EventQueue *eq) {
+                    [this, i](EventQueue *eq) {
+                        pinToHostCpu(i);
                         thread_main(eq);
                     }, mainEventQueue[i]);
             }
@@ -209,6 +254,7 @@ simulate(Tick num_cycles)
 
         quantum_event.reset(
             new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
+                                simQuantumMax,
                                 EventBase::Progress_Event_Pri, 0));
 
         inParallelMode = true;
@@ -38,6 +38,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <vector>
+
 #include "base/types.hh"
 
 namespace gem5
@@ -55,6 +57,14 @@ GlobalSimLoopExitEvent *simulate(Tick num_cycles = MaxTick);
  */
 void terminateEventQueueThreads();
 
+/**
+ * Pin the host thread servicing each main event queue to a host CPU.
+ * Entry i is used for queue i, and queues without an entry or with a
+ * negative one are left to the host scheduler. Takes effect when the
+ * simulation threads are started.
+ */
+void setEventQueueHostCpus(const std::vector<int> &cpus);
+
 extern GlobalSimLoopExitEvent *simulate_limit_event;
 
 } // namespace gem5
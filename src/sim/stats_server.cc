@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/stats_server.hh"
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+#include <iostream>
+
+#include "base/atomicio.hh"
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/statistics.hh"
+#include "base/stats/group.hh"
+#include "base/stats/prometheus.hh"
+#include "base/trace.hh"
+#include "debug/StatsServer.hh"
+#include "sim/eventq.hh"
+#include "sim/global_event.hh"
+#include "sim/root.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** The largest HTTP request header we are willing to buffer. */
+constexpr size_t MaxRequestBytes = 16 * 1024;
+
+/**
+ * Serve the pending requests of a stats server once all event queues
+ * have reached the same tick.
+ */
+class ServeEvent : public GlobalEvent
+{
+  private:
+    StatsServer *server;
+
+  public:
+    ServeEvent(Tick when, StatsServer *s)
+        : GlobalEvent(when, Stat_Event_Pri, AutoDelete), server(s)
+    {
+    }
+
+    void process() override { server->serve(); }
+
+    const char *description() const override { return "StatsServerEvent"; }
+};
+
+} // anonymous namespace
+
+/*
+ * Poll event for the listen socket
+ */
+StatsServer::ListenEvent::ListenEvent(StatsServer *s, int fd, int e)
+    : PollEvent(fd, e), server(s)
+{
+}
+
+void
+StatsServer::ListenEvent::process(int revent)
+{
+    server->accept();
+}
+
+/*
+ * Poll event and state of a client
+ */
+StatsServer::Client::Client(StatsServer *s, int fd)
+    : PollEvent(fd, POLLIN), server(s), pending(false)
+{
+}
+
+StatsServer::Client::~Client()
+{
+    ::close(pfd.fd);
+}
+
+void
+StatsServer::Client::process(int revent)
+{
+    // As a consequence of being called from the PollQueue, we might
+    // have been called from a different thread. Migrate to "our"
+    // thread.
+    EventQueue::ScopedMigration migrate(server->eventQueue());
+
+    if (revent & POLLIN)
+        server->data(this);
+    else if (revent & (POLLHUP | POLLERR | POLLNVAL))
+        server->detach(this);
+}
+
+/*
+ * Stats server code
+ */
+StatsServer::StatsServer(const Params &p)
+    : SimObject(p), listenEvent(nullptr), format(p.format),
+      enableDescriptions(p.desc), resolved(false), servePending(false)
+{
+    for (const auto &pattern : p.stats) {
+        try {
+            patterns.emplace_back(pattern);
+        } catch (const std::regex_error &e) {
+            fatal("%s: Invalid stat selection '%s': %s\n", name(), pattern,
+                  e.what());
+        }
+    }
+
+    listen(p.port);
+}
+
+StatsServer::~StatsServer()
+{
+    clients.clear();
+    delete listenEvent;
+}
+
+void
+StatsServer::listen(int port)
+{
+    if (ListenSocket::allDisabled()) {
+        warn_once("Sockets disabled, not serving stats");
+        return;
+    }
+
+    while (!listener.listen(port, true)) {
+        DPRINTF(StatsServer, "Can't bind stats server port %d\n", port);
+        port++;
+    }
+
+    ccprintf(std::cerr, "%s: Serving stats on port %d\n", name(), port);
+
+    listenEvent = new ListenEvent(this, listener.getfd(), POLLIN);
+    pollQueue.schedule(listenEvent);
+}
+
+void
+StatsServer::accept()
+{
+    panic_if(!listener.islistening(),
+             "%s: cannot accept a connection if not listening!", name());
+
+    int fd = listener.accept(true);
+    if (fd < 0)
+        return;
+
+    auto *client = new Client(this, fd);
+    clients.emplace_back(client);
+    if (format == StatsServerFormat::columnar) {
+        client->columnar.reset(new statistics::Columnar(client->buffer,
+                                                        enableDescriptions));
+    }
+    pollQueue.schedule(client);
+
+    DPRINTF(StatsServer, "Accepted client %d\n", fd);
+}
+
+void
+StatsServer::data(Client *client)
+{
+    char buf[1024];
+    ssize_t len;
+    do {
+        len = ::read(client->getfd(), buf, sizeof(buf));
+    } while (len == -1 && errno == EINTR);
+
+    if (len <= 0) {
+        detach(client);
+        return;
+    }
+
+    if (format == StatsServerFormat::columnar) {
+        // Every byte asks for a row, but rows requested before the next
+        // serve are merged.
+        client->pending = true;
+    } else {
+        client->request.append(buf, len);
+        if (client->request.find("\r\n\r\n") != std::string::npos ||
+            client->request.find("\n\n") != std::string::npos) {
+            client->pending = true;
+        } else if (client->request.size() > MaxRequestBytes) {
+            warn("%s: Dropping a client with an oversized request\n",
+                 name());
+            detach(client);
+            return;
+        }
+    }
+
+    if (client->pending)
+        scheduleServe();
+}
+
+void
+StatsServer::detach(Client *client)
+{
+    DPRINTF(StatsServer, "Detaching client %d\n", client->getfd());
+
+    auto it = std::find_if(clients.begin(), clients.end(),
+        [client](const auto &c) { return c.get() == client; });
+    assert(it != clients.end());
+    clients.erase(it);
+}
+
+void
+StatsServer::send(Client *client, const std::string &str)
+{
+    if (atomic_write(client->getfd(), str.data(), str.size()) !=
+            (ssize_t)str.size()) {
+        DPRINTF(StatsServer, "Write to client %d failed\n", client->getfd());
+    }
+}
+
+void
+StatsServer::scheduleServe()
+{
+    if (servePending)
+        return;
+
+    // As for a stat dump, simQuantum makes sure the event only happens
+    // after the next sync of the event queues.
+    servePending = true;
+    new ServeEvent(curTick() + simQuantum, this);
+}
+
+void
+StatsServer::resolve()
+{
+    auto selected = [this](const std::string &name) {
+        if (patterns.empty())
+            return true;
+        return std::any_of(patterns.begin(), patterns.end(),
+            [&name](const std::regex &re) {
+                return std::regex_match(name, re);
+            });
+    };
+
+    std::vector<std::string> path;
+    std::string prefix;
+    std::function<void(statistics::Group *)> walk =
+        [&](statistics::Group *group) {
+            for (auto *info : group->getStats()) {
+                if (selected(prefix + info->name))
+                    stats.push_back({ path, info });
+            }
+            for (const auto &g : group->getStatGroups()) {
+                const size_t length = prefix.size();
+                path.push_back(g.first);
+                prefix += g.first + ".";
+                walk(g.second);
+                prefix.resize(length);
+                path.pop_back();
+            }
+        };
+    walk(Root::root());
+
+    // Legacy stats carry their full name
+    for (auto *info : statistics::statsList()) {
+        if (selected(info->name))
+            stats.push_back({ {}, info });
+    }
+
+    warn_if(stats.empty(), "%s: No stats match the selection\n", name());
+    resolved = true;
+}
+
+void
+StatsServer::visit(statistics::Output &output)
+{
+    output.begin();
+    for (const auto &stat : stats) {
+        for (const auto &group : stat.path)
+            output.beginGroup(group.c_str());
+        stat.info->visit(output);
+        for (size_t i = 0; i < stat.path.size(); ++i)
+            output.endGroup();
+    }
+    output.end();
+}
+
+void
+StatsServer::serve()
+{
+    servePending = false;
+
+    if (!resolved)
+        resolve();
+
+    // Only prepare the selected stats, like a filtered stat dump
+    Root::root()->preDumpStats();
+    for (const auto &stat : stats)
+        stat.info->prepare();
+
+    std::string response;
+    for (auto it = clients.begin(); it != clients.end(); ) {
+        Client *client = (it++)->get();
+        if (!client->pending)
+            continue;
+        client->pending = false;
+
+        if (format == StatsServerFormat::columnar) {
+            visit(*client->columnar);
+            send(client, client->buffer.str());
+            client->buffer.str("");
+            continue;
+        }
+
+        if (response.empty()) {
+            std::ostringstream body;
+            statistics::Prometheus prometheus(body, enableDescriptions);
+            visit(prometheus);
+            response = csprintf("HTTP/1.1 200 OK\r\n"
+                "Content-Type: text/plain; version=0.0.4\r\n"
+                "Content-Length: %d\r\n"
+                "Connection: close\r\n"
+                "\r\n", body.str().size()) + body.str();
+        }
+        send(client, response);
+        detach(client);
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_STATS_SERVER_HH__
+#define __SIM_STATS_SERVER_HH__
+
+#include <list>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/pollevent.hh"
+#include "base/socket.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/info.hh"
+#include "enums/StatsServerFormat.hh"
+#include "params/StatsServer.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Serve a selection of the stats over a socket while the simulation is
+ * running. A client request is noticed by the poll queue, but the stats
+ * are only read from a global event, when all the event queues are in
+ * sync, so what a client gets is as consistent as a stat dump.
+ */
+class StatsServer : public SimObject
+{
+  protected:
+    class ListenEvent : public PollEvent
+    {
+      protected:
+        StatsServer *server;
+
+      public:
+        ListenEvent(StatsServer *s, int fd, int e);
+        void process(int revent) override;
+    };
+
+    friend class ListenEvent;
+    ListenEvent *listenEvent;
+
+    /** A connected client. */
+    class Client : public PollEvent
+    {
+      public:
+        StatsServer *server;
+
+        /** What has been received of the current request. */
+        std::string request;
+        /** Whether the client is waiting for the stats. */
+        bool pending;
+
+        /** The columnar writer and its buffer, in the columnar format. */
+        std::ostringstream buffer;
+        std::unique_ptr<statistics::Columnar> columnar;
+
+        Client(StatsServer *s, int fd);
+        ~Client();
+        void process(int revent) override;
+
+        int getfd() const { return pfd.fd; }
+    };
+
+    friend class Client;
+    std::list<std::unique_ptr<Client>> clients;
+
+    /** A selected stat and the names of the groups it is in. */
+    struct Stat
+    {
+        std::vector<std::string> path;
+        statistics::Info *info;
+    };
+
+  public:
+    PARAMS(StatsServer);
+    StatsServer(const Params &p);
+    ~StatsServer();
+
+    /** Read the stats and answer all the pending requests. */
+    void serve();
+
+  protected:
+    void listen(int port);
+    void accept();
+    void data(Client *client);
+    void detach(Client *client);
+    void send(Client *client, const std::string &str);
+
+    /** Make sure the pending requests get served. */
+    void scheduleServe();
+
+    /** Find the stats that match the selection. */
+    void resolve();
+
+    /** Hand the selected stats to an output. */
+    void visit(statistics::Output &output);
+
+  protected:
+    ListenSocket listener;
+
+    const StatsServerFormat format;
+    const bool enableDescriptions;
+    std::vector<std::regex> patterns;
+
+    /** The selected stats, once they have been resolved. */
+    std::vector<Stat> stats;
+    bool resolved;
+
+    /** Whether a global event has been scheduled to serve requests. */
+    bool servePending;
+};
+
+} // namespace gem5
+
+#endif // __SIM_STATS_SERVER_HH__
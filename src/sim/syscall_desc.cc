@@ -30,20 +30,25 @@
 #include "sim/syscall_desc.hh"
 
 #include "base/types.hh"
+#include "cpu/thread_context.hh"
 #include "sim/eventq.hh"
+#include "sim/process.hh"
+#include "sim/se_workload.hh"
 #include "sim/syscall_debug_macros.hh"
 
 namespace gem5
 {
 
-class ThreadContext;
-
 void
 SyscallDesc::doSyscall(ThreadContext *tc)
 {
     DPRINTF_SYSCALL(Base, "Calling %s...\n", dumper(name(), tc));
 
-    SyscallReturn retval = executor(this, tc);
+    SyscallReturn retval;
+    {
+        auto lock = tc->getProcessPtr()->seWorkload->lockEmulation();
+        retval = executor(this, tc);
+    }
 
     if (retval.needsRetry()) {
         // Suspend this ThreadContext while the syscall is pending.
@@ -62,7 +67,11 @@ SyscallDesc::retrySyscall(ThreadContext *tc)
 {
     DPRINTF_SYSCALL(Base, "Retrying %s...\n", dumper(name(), tc));
 
-    SyscallReturn retval = executor(this, tc);
+    SyscallReturn retval;
+    {
+        auto lock = tc->getProcessPtr()->seWorkload->lockEmulation();
+        retval = executor(this, tc);
+    }
 
     if (retval.needsRetry()) {
         DPRINTF_SYSCALL(Base, "%s still needs retry.\n", name());
@@ -47,6 +47,7 @@
 #include "sim/byteswap.hh"
 #include "sim/process.hh"
 #include "sim/proxy_ptr.hh"
+#include "sim/se_workload.hh"
 #include "sim/sim_exit.hh"
 #include "sim/syscall_debug_macros.hh"
 #include "sim/syscall_desc.hh"
@@ -157,7 +158,7 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
                  * all threads in the group.
                  */
                 if (*(p->exitGroup)) {
-                    tc->halt();
+                    p->seWorkload->updateContext(tc, [tc]() { tc->halt(); });
                 } else {
                     last_thread = false;
                 }
@@ -201,7 +202,7 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
     if (!p->vforkContexts.empty()) {
         ThreadContext *vtc = sys->threads[p->vforkContexts.front()];
         assert(vtc->status() == ThreadContext::Suspended);
-        vtc->activate();
+        p->seWorkload->updateContext(vtc, [vtc]() { vtc->activate(); });
     }
 
     tc->halt();
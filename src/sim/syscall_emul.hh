@@ -85,6 +85,7 @@
 #include <cerrno>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "arch/generic/tlb.hh"
 #include "base/intmath.hh"
@@ -105,6 +106,7 @@
 #include "sim/guest_abi.hh"
 #include "sim/process.hh"
 #include "sim/proxy_ptr.hh"
+#include "sim/se_workload.hh"
 #include "sim/syscall_debug_macros.hh"
 #include "sim/syscall_desc.hh"
 #include "sim/syscall_emul_buf.hh"
@@ -1655,6 +1657,7 @@ cloneFunc(SyscallDesc *desc, ThreadContext *tc, RegVal flags, RegVal newStack,
     pp->ppid = (flags & OS::TGT_CLONE_THREAD) ? p->ppid() : p->pid();
     pp->useArchPT = p->useArchPT;
     pp->kvmInSE = p->kvmInSE;
+    pp->directSyscallIO = p->directSyscallIO;
     Process *cp = pp->create();
     // TODO: there is no way to know when the Process SimObject is done with
     // the params pointer. Both the params pointer (pp) and the process
@@ -1705,7 +1708,7 @@ cloneFunc(SyscallDesc *desc, ThreadContext *tc, RegVal flags, RegVal newStack,
 
     desc->returnInto(ctc, 0);
 
-    ctc->activate();
+    p->seWorkload->updateContext(ctc, [ctc]() { ctc->activate(); });
 
     if (flags & OS::TGT_CLONE_VFORK) {
         tc->suspend();
@@ -1975,11 +1978,16 @@ pread64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
+    std::vector<struct iovec> iov;
+    bool direct = nbytes > 0 && p->hostBuffer(bufPtr, nbytes, true, iov);
+    BufferArg bufArg(bufPtr, direct ? 0 : nbytes);
+    if (!direct)
+        iov.push_back({bufArg.bufferPtr(), (size_t)nbytes});
 
-    int bytes_read = pread(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    int bytes_read = preadv(sim_fd, iov.data(), iov.size(), offset);
 
-    bufArg.copyOut(SETranslatingPortProxy(tc));
+    if (!direct)
+        bufArg.copyOut(SETranslatingPortProxy(tc));
 
     return (bytes_read == -1) ? -errno : bytes_read;
 }
@@ -1996,10 +2004,15 @@ pwrite64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
-    bufArg.copyIn(SETranslatingPortProxy(tc));
+    std::vector<struct iovec> iov;
+    bool direct = nbytes > 0 && p->hostBuffer(bufPtr, nbytes, false, iov);
+    BufferArg bufArg(bufPtr, direct ? 0 : nbytes);
+    if (!direct) {
+        bufArg.copyIn(SETranslatingPortProxy(tc));
+        iov.push_back({bufArg.bufferPtr(), (size_t)nbytes});
+    }
 
-    int bytes_written = pwrite(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    int bytes_written = pwritev(sim_fd, iov.data(), iov.size(), offset);
 
     return (bytes_written == -1) ? -errno : bytes_written;
 }
@@ -2208,7 +2221,7 @@ execveFunc(SyscallDesc *desc, ThreadContext *tc,
     if (!p->vforkContexts.empty()) {
         ThreadContext *vtc = p->system->threads[p->vforkContexts.front()];
         assert(vtc->status() == ThreadContext::Suspended);
-        vtc->activate();
+        p->seWorkload->updateContext(vtc, [vtc]() { vtc->activate(); });
     }
 
     /**
@@ -2233,6 +2246,7 @@ execveFunc(SyscallDesc *desc, ThreadContext *tc,
     pp->cwd.assign(p->tgtCwd);
     pp->system = p->system;
     pp->release = p->release;
+    pp->directSyscallIO = p->directSyscallIO;
     /**
      * Prevent process object creation with identical PIDs (which will trip
      * a fatal check in Process constructor). The execve call is supposed to
@@ -2636,10 +2650,16 @@ readFunc(SyscallDesc *desc, ThreadContext *tc,
         && !(hbfdp->getFlags() & OS::TGT_O_NONBLOCK))
         return SyscallReturn::retry();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    int bytes_read = read(sim_fd, buf_arg.bufferPtr(), nbytes);
+    // Read straight into the guest memory if it can be accessed directly
+    std::vector<struct iovec> iov;
+    bool direct = nbytes > 0 && p->hostBuffer(buf_ptr, nbytes, true, iov);
+    BufferArg buf_arg(buf_ptr, direct ? 0 : nbytes);
+    if (!direct)
+        iov.push_back({buf_arg.bufferPtr(), (size_t)nbytes});
+
+    int bytes_read = readv(sim_fd, iov.data(), iov.size());
 
-    if (bytes_read > 0)
+    if (bytes_read > 0 && !direct)
         buf_arg.copyOut(SETranslatingPortProxy(tc));
 
     return (bytes_read == -1) ? -errno : bytes_read;
@@ -2657,8 +2677,13 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = hbfdp->getSimFD();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    buf_arg.copyIn(SETranslatingPortProxy(tc));
+    std::vector<struct iovec> iov;
+    bool direct = nbytes > 0 && p->hostBuffer(buf_ptr, nbytes, false, iov);
+    BufferArg buf_arg(buf_ptr, direct ? 0 : nbytes);
+    if (!direct) {
+        buf_arg.copyIn(SETranslatingPortProxy(tc));
+        iov.push_back({buf_arg.bufferPtr(), (size_t)nbytes});
+    }
 
     struct pollfd pfd;
     pfd.fd = sim_fd;
@@ -2676,7 +2701,7 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
             return SyscallReturn::retry();
     }
 
-    int bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    int bytes_written = writev(sim_fd, iov.data(), iov.size());
 
     if (bytes_written != -1)
         fsync(sim_fd);
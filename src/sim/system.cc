@@ -182,7 +182,11 @@ System::System(const Params &p)
       physProxy(_systemPort, p.cache_line_size),
       workload(p.workload),
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore, p.auto_unlink_shared_backstore),
+              p.shared_backstore, p.auto_unlink_shared_backstore,
+              p.delta_checkpoints, p.chunked_checkpoints,
+              p.raw_checkpoints, p.lazy_restore, p.page_store,
+              p.checkpoint_threads, p.backstore_huge_pages,
+              p.backstore_hugetlb, p.backstore_numa_nodes),
       ShadowRomRanges(p.shadow_rom_ranges.begin(),
                       p.shadow_rom_ranges.end()),
       memoryMode(p.mem_mode),
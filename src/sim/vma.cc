@@ -30,6 +30,7 @@
 
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "base/types.hh"
 
@@ -50,6 +51,25 @@ VMA::fillMemPages(Addr start, Addr size, PortProxy &port) const
     }
 }
 
+bool
+VMA::mapMemPage(Addr start, Addr paddr,
+                memory::PhysicalMemory &physmem) const
+{
+    auto offset = start - _addrRange.start();
+
+    /**
+     * Only map whole pages of the file, the host may fault on the part of
+     * a mapping that lies beyond the end of the file.
+     */
+    if (!_origHostBuf || offset + _pageBytes > _hostBufLen)
+        return false;
+
+    auto buf_offset = (uint8_t *)_hostBuf -
+        (uint8_t *)_origHostBuf->getBuffer();
+    return physmem.mapFile(paddr, _pageBytes, _origHostBuf->getFD(),
+                           _origHostBuf->getOffset() + buf_offset + offset);
+}
+
 bool
 VMA::isStrictSuperset(const AddrRange &r) const
 {
@@ -120,7 +140,7 @@ VMA::sanityCheck()
 
 VMA::MappedFileBuffer::MappedFileBuffer(int fd, size_t length,
                                         off_t offset)
-    : _buffer(nullptr), _length(length)
+    : _buffer(nullptr), _length(length), _fd(-1), _offset(offset)
 {
     panic_if(_length == 0, "Tried to mmap file of length zero");
 
@@ -145,6 +165,10 @@ VMA::MappedFileBuffer::MappedFileBuffer(int fd, size_t length,
     } else {
         panic("Tried to mmap 0 bytes");
     }
+
+    _fd = dup(fd);
+    panic_if(_fd == -1, "Failed to duplicate mmap file descriptor: %s",
+             strerror(errno));
 }
 
 VMA::MappedFileBuffer::~MappedFileBuffer()
@@ -154,6 +178,8 @@ VMA::MappedFileBuffer::~MappedFileBuffer()
                  "mmap: failed to unmap file-backed host memory: %s",
                  strerror(errno));
     }
+    if (_fd != -1)
+        close(_fd);
 }
 
 } // namespace gem5
@@ -35,6 +35,7 @@
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "debug/Vma.hh"
+#include "mem/physical.hh"
 #include "mem/se_translating_port_proxy.hh"
 
 namespace gem5
@@ -88,6 +89,18 @@ class VMA
      */
     void fillMemPages(Addr start, Addr size, PortProxy &port) const;
 
+    /**
+     * Back the target page at start, which is mapped to paddr, with the
+     * contents of the host file directly, instead of copying them with
+     * fillMemPages(). The file is mapped copy-on-write into the physical
+     * memory, so the page only becomes resident on the host when it is
+     * touched.
+     *
+     * @return Whether the page was mapped.
+     */
+    bool mapMemPage(Addr start, Addr paddr,
+                    memory::PhysicalMemory &physmem) const;
+
     /**
      * Returns true if desired range exists within this virtual memory area
      * and does not include the start and end addresses.
@@ -181,7 +194,9 @@ class VMA
      * MappedFileBuffer is a wrapper around a region of host memory backed by a
      * file. The constructor attempts to map a file from host memory, and the
      * destructor attempts to unmap it.  If there is a problem with the host
-     * mapping/unmapping, then we panic.
+     * mapping/unmapping, then we panic. A duplicate of the file descriptor
+     * is kept, so that pages of the file can be mapped into the physical
+     * memory after the target closed it.
      */
     class MappedFileBuffer
     {
@@ -191,10 +206,14 @@ class VMA
 
         void *getBuffer() const { return _buffer; }
         uint64_t getLength() const { return _length; }
+        int getFD() const { return _fd; }
+        off_t getOffset() const { return _offset; }
 
       private:
         void *_buffer;       // Host buffer ptr
         size_t _length;       // Length of host ptr
+        int _fd;             // Host file descriptor
+        off_t _offset;       // File offset of the host buffer
     };
 };
 
@@ -37,3 +37,7 @@ class OutgoingRequestBridge(SimObject):
         [AddrRange(0x80000000, MaxAddr)],
         "Physical address ranges."
     )
+    batch_requests = Param.Bool(True,
+        "Hand timing requests over to SST once per SST clock instead of "
+        "one at a time. SST timestamps them with the same time either way."
+    )
@@ -41,7 +41,8 @@ OutgoingRequestBridge::OutgoingRequestBridge(
     outgoingPort(std::string(name()), this),
     sstResponder(nullptr),
     physicalAddressRanges(params.physical_address_ranges.begin(),
-                          params.physical_address_ranges.end())
+                          params.physical_address_ranges.end()),
+    batchRequests(params.batch_requests)
 {
 }
 
@@ -93,6 +94,13 @@ OutgoingRequestBridge::setResponder(SSTResponderInterface* responder)
     sstResponder = responder;
 }
 
+void
+OutgoingRequestBridge::takeRequestBatch(std::vector<PacketPtr> &batch)
+{
+    assert(batch.empty());
+    batch.swap(requestBatch);
+}
+
 bool
 OutgoingRequestBridge::sendTimingResp(gem5::PacketPtr pkt)
 {
@@ -133,7 +141,10 @@ bool
 OutgoingRequestBridge::
 OutgoingRequestPort::recvTimingReq(PacketPtr pkt)
 {
-    owner->sstResponder->handleRecvTimingReq(pkt);
+    if (owner->batchRequests)
+        owner->requestBatch.push_back(pkt);
+    else
+        owner->sstResponder->handleRecvTimingReq(pkt);
     return true;
 }
 
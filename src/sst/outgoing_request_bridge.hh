@@ -79,6 +79,11 @@ class OutgoingRequestBridge: public SimObject
 
     AddrRangeList physicalAddressRanges;
 
+    // If set, timing requests are not forwarded to SST one at a time, but
+    // collected here until SST picks them up at the end of its clock.
+    bool batchRequests;
+    std::vector<PacketPtr> requestBatch;
+
   public:
     OutgoingRequestBridge(const OutgoingRequestBridgeParams &params);
     ~OutgoingRequestBridge();
@@ -105,6 +110,12 @@ class OutgoingRequestBridge: public SimObject
     // corresponding port in SST.
     void setResponder(SSTResponderInterface* responder);
 
+    // This function is called when SST collects the timing requests gem5 sent
+    // during the last SST clock. The requests are swapped into batch, which
+    // should be empty, so both vectors keep their storage from one clock to
+    // the next. gem5 and SST run on the same thread, so no locking is needed.
+    void takeRequestBatch(std::vector<PacketPtr> &batch);
+
     // This function is called when SST wants to sent a timing response to gem5
     bool sendTimingResp(PacketPtr pkt);
 
@@ -40,6 +40,9 @@ class Gem5ToTlmBridgeBase(SystemC_ScModule):
     gem5 = ResponsePort('gem5 response port')
     addr_ranges = VectorParam.AddrRange([],
             'Addresses served by this port\'s TLM side')
+    loosely_timed = Param.Bool(False, 'Complete timing requests with the '
+            'blocking interface and only return their responses at global '
+            'quantum boundaries')
 
 class TlmToGem5BridgeBase(SystemC_ScModule):
     type = 'TlmToGem5BridgeBase'
@@ -60,6 +60,7 @@
 
 #include <utility>
 
+#include "base/intmath.hh"
 #include "params/Gem5ToTlmBridge32.hh"
 #include "params/Gem5ToTlmBridge64.hh"
 #include "params/Gem5ToTlmBridge128.hh"
@@ -67,6 +68,7 @@
 #include "params/Gem5ToTlmBridge512.hh"
 #include "sim/eventq.hh"
 #include "sim/system.hh"
+#include "systemc/ext/tlm_core/2/quantum/global_quantum.hh"
 #include "systemc/tlm_bridge/sc_ext.hh"
 #include "systemc/tlm_bridge/sc_mm.hh"
 
@@ -236,7 +238,7 @@ Gem5ToTlmBridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
     AddrRange r(start, end);
     auto it = backdoorMap.contains(r);
     if (it != backdoorMap.end())
-        return it->second;
+        return it->second.backdoor;
 
     // If not, ask the target for one.
     tlm::tlm_dmi dmi_data;
@@ -244,25 +246,68 @@ Gem5ToTlmBridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
         return nullptr;
 
     // If the target gave us one, translate it to a gem5 MemBackdoor and
-    // store it in our cache.
-    AddrRange dmi_r(dmi_data.get_start_address(), dmi_data.get_end_address());
+    // store it in our cache. The end of a TLM DMI range is inclusive.
+    sc_dt::uint64 dmi_end = dmi_data.get_end_address();
+    AddrRange dmi_r(dmi_data.get_start_address(),
+                    dmi_end == MaxAddr ? MaxAddr : dmi_end + 1);
     auto backdoor = new MemBackdoor(
             dmi_r, dmi_data.get_dmi_ptr(), MemBackdoor::NoAccess);
     backdoor->readable(dmi_data.is_read_allowed());
     backdoor->writeable(dmi_data.is_write_allowed());
 
-    backdoorMap.insert(dmi_r, backdoor);
+    backdoorMap.insert(dmi_r, DmiRegion{backdoor,
+            dmi_data.get_read_latency().value(),
+            dmi_data.get_write_latency().value()});
 
     return backdoor;
 }
 
-// Similar to TLM's blocking transport (LT)
+template <unsigned int BITWIDTH>
+bool
+Gem5ToTlmBridge<BITWIDTH>::dmiAccess(PacketPtr packet, Tick &delay)
+{
+    // Only plain reads and writes can skip the target. Anything with side
+    // effects beyond the data itself still needs a transaction.
+    if (!(packet->isRead() || packet->isWrite()) || packet->isAtomicOp() ||
+            packet->isLLSC() ||
+            (packet->req->getFlags() & Request::NO_ACCESS) != 0) {
+        return false;
+    }
+
+    auto it = backdoorMap.contains(packet->getAddrRange());
+    if (it == backdoorMap.end())
+        return false;
+
+    const DmiRegion &region = it->second;
+    MemBackdoorPtr backdoor = region.backdoor;
+    uint8_t *ptr = backdoor->ptr() +
+        (packet->getAddr() - backdoor->range().start());
+
+    if (packet->isRead()) {
+        if (!backdoor->readable())
+            return false;
+        packet->setData(ptr);
+        delay = region.readLatency;
+    } else {
+        if (!backdoor->writeable())
+            return false;
+        packet->writeData(ptr);
+        delay = region.writeLatency;
+    }
+
+    if (packet->needsResponse())
+        packet->makeResponse();
+
+    return true;
+}
+
 template <unsigned int BITWIDTH>
 Tick
-Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
+Gem5ToTlmBridge<BITWIDTH>::blockingAccess(PacketPtr packet)
 {
-    panic_if(packet->cacheResponding(),
-             "Should not see packets where cache is responding");
+    Tick dmi_delay;
+    if (dmiAccess(packet, dmi_delay))
+        return dmi_delay;
 
     // Prepare the transaction.
     auto *trans = packet2payload(packet);
@@ -272,6 +317,10 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
     if (trans->get_command() != tlm::TLM_IGNORE_COMMAND) {
         // Execute b_transport:
         socket->b_transport(*trans, delay);
+        // Take the target up on its DMI hint, so that later accesses to
+        // the same region don't need a transaction at all.
+        if (trans->is_dmi_allowed())
+            getBackdoor(*trans);
     }
 
     if (packet->needsResponse())
@@ -282,6 +331,17 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
     return delay.value();
 }
 
+// Similar to TLM's blocking transport (LT)
+template <unsigned int BITWIDTH>
+Tick
+Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
+{
+    panic_if(packet->cacheResponding(),
+             "Should not see packets where cache is responding");
+
+    return blockingAccess(packet);
+}
+
 template <unsigned int BITWIDTH>
 Tick
 Gem5ToTlmBridge<BITWIDTH>::recvAtomicBackdoor(
@@ -290,6 +350,13 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomicBackdoor(
     panic_if(packet->cacheResponding(),
              "Should not see packets where cache is responding");
 
+    Tick dmi_delay;
+    if (dmiAccess(packet, dmi_delay)) {
+        auto it = backdoorMap.contains(packet->getAddrRange());
+        backdoor = it->second.backdoor;
+        return dmi_delay;
+    }
+
     sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
 
     // Prepare the transaction.
@@ -315,6 +382,26 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomicBackdoor(
     return delay.value();
 }
 
+template <unsigned int BITWIDTH>
+void
+Gem5ToTlmBridge<BITWIDTH>::recvMemBackdoorReq(const MemBackdoorReq &req,
+        MemBackdoorPtr &backdoor)
+{
+    // Build just enough of a transaction to ask the target for DMI.
+    tlm::tlm_generic_payload *trans = mm.allocate();
+    trans->acquire();
+
+    trans->set_address(req.range().start());
+    trans->set_data_length(req.range().size());
+    trans->set_streaming_width(req.range().size());
+    trans->set_command(req.writeable() ?
+            tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND);
+
+    backdoor = getBackdoor(*trans);
+
+    trans->release();
+}
+
 template <unsigned int BITWIDTH>
 void
 Gem5ToTlmBridge<BITWIDTH>::recvFunctionalSnoop(PacketPtr packet)
@@ -332,6 +419,25 @@ Gem5ToTlmBridge<BITWIDTH>::recvTimingReq(PacketPtr packet)
     panic_if(packet->cacheResponding(),
              "Should not see packets where cache is responding");
 
+    if (looselyTimed) {
+        // Complete the request right away, and hold on to the response
+        // until the quantum it falls in is over.
+        Tick delay = packet->payloadDelay;
+        packet->payloadDelay = 0;
+        packet->headerDelay = 0;
+        delay += blockingAccess(packet);
+
+        if (packet->isResponse()) {
+            Tick due = curTick() + delay;
+            Tick quantum = tlm::tlm_global_quantum::instance().get().value();
+            if (quantum)
+                due = divCeil(due, quantum) * quantum;
+            ltResponses.emplace(due, packet);
+            scheduleLTResponses();
+        }
+        return true;
+    }
+
     // We should never get a second request after noting that a retry is
     // required.
     sc_assert(!needToSendRequestRetry);
@@ -428,10 +534,46 @@ Gem5ToTlmBridge<BITWIDTH>::tryTiming(PacketPtr packet)
     panic("tryTiming(PacketPtr) isn't implemented.");
 }
 
+template <unsigned int BITWIDTH>
+void
+Gem5ToTlmBridge<BITWIDTH>::scheduleLTResponses()
+{
+    if (ltResponseBlocked || ltResponses.empty())
+        return;
+
+    Tick when = ltResponses.begin()->first;
+    if (!ltResponseEvent.scheduled())
+        system->schedule(ltResponseEvent, when);
+    else if (ltResponseEvent.when() > when)
+        system->reschedule(ltResponseEvent, when);
+}
+
+template <unsigned int BITWIDTH>
+void
+Gem5ToTlmBridge<BITWIDTH>::sendLTResponses()
+{
+    while (!ltResponses.empty() && ltResponses.begin()->first <= curTick()) {
+        if (!bridgeResponsePort.sendTimingResp(
+                    ltResponses.begin()->second)) {
+            ltResponseBlocked = true;
+            return;
+        }
+        ltResponses.erase(ltResponses.begin());
+    }
+
+    scheduleLTResponses();
+}
+
 template <unsigned int BITWIDTH>
 void
 Gem5ToTlmBridge<BITWIDTH>::recvRespRetry()
 {
+    if (ltResponseBlocked) {
+        ltResponseBlocked = false;
+        sendLTResponses();
+        return;
+    }
+
     /* Retry a response */
     sc_assert(blockingResponse);
 
@@ -456,6 +598,10 @@ template <unsigned int BITWIDTH>
 void
 Gem5ToTlmBridge<BITWIDTH>::recvFunctional(PacketPtr packet)
 {
+    Tick dmi_delay;
+    if (dmiAccess(packet, dmi_delay))
+        return;
+
     // Prepare the transaction.
     auto *trans = packet2payload(packet);
 
@@ -486,15 +632,16 @@ void
 Gem5ToTlmBridge<BITWIDTH>::invalidate_direct_mem_ptr(
         sc_dt::uint64 start_range, sc_dt::uint64 end_range)
 {
-    AddrRange r(start_range, end_range);
+    // The end of a TLM DMI range is inclusive.
+    AddrRange r(start_range, end_range == MaxAddr ? MaxAddr : end_range + 1);
 
     for (;;) {
         auto it = backdoorMap.intersects(r);
         if (it == backdoorMap.end())
             break;
 
-        it->second->invalidate();
-        delete it->second;
+        it->second.backdoor->invalidate();
+        delete it->second.backdoor;
         backdoorMap.erase(it);
     };
 }
@@ -508,7 +655,10 @@ Gem5ToTlmBridge<BITWIDTH>::Gem5ToTlmBridge(
     wrapper(socket, std::string(name()) + ".tlm", InvalidPortID),
     system(params.system), blockingRequest(nullptr),
     needToSendRequestRetry(false), blockingResponse(nullptr),
-    addrRanges(params.addr_ranges.begin(), params.addr_ranges.end())
+    addrRanges(params.addr_ranges.begin(), params.addr_ranges.end()),
+    looselyTimed(params.loosely_timed), ltResponseBlocked(false),
+    ltResponseEvent([this]() { sendLTResponses(); },
+                    std::string(name()) + ".ltResponseEvent")
 {
 }
 
@@ -60,10 +60,12 @@
 #define __SYSTEMC_TLM_BRIDGE_GEM5_TO_TLM_HH__
 
 #include <functional>
+#include <map>
 #include <string>
 
 #include "mem/port.hh"
 #include "params/Gem5ToTlmBridgeBase.hh"
+#include "sim/eventq.hh"
 #include "sim/system.hh"
 #include "systemc/ext/core/sc_module.hh"
 #include "systemc/ext/core/sc_module_name.hh"
@@ -113,6 +115,12 @@ class Gem5ToTlmBridge : public Gem5ToTlmBridgeBase
             return bridge.recvAtomicBackdoor(pkt, backdoor);
         }
         void
+        recvMemBackdoorReq(const gem5::MemBackdoorReq &req,
+            gem5::MemBackdoorPtr &backdoor) override
+        {
+            bridge.recvMemBackdoorReq(req, backdoor);
+        }
+        void
         recvFunctional(gem5::PacketPtr pkt) override
         {
             return bridge.recvFunctional(pkt);
@@ -168,16 +176,57 @@ class Gem5ToTlmBridge : public Gem5ToTlmBridgeBase
 
     gem5::AddrRangeList addrRanges;
 
+    /**
+     * In loosely timed mode, timing requests are completed right away
+     * with the blocking interface (or through DMI) and their responses
+     * are held back until the next global quantum boundary, when they
+     * are all sent to gem5 together.
+     */
+    const bool looselyTimed;
+
+    /** Responses of loosely timed requests, by the tick they are due. */
+    std::multimap<gem5::Tick, gem5::PacketPtr> ltResponses;
+
+    /** Did gem5 ask us to retry the first of the ltResponses? */
+    bool ltResponseBlocked;
+
+    gem5::EventFunctionWrapper ltResponseEvent;
+
+    void sendLTResponses();
+    void scheduleLTResponses();
+
   protected:
     void pec(tlm::tlm_generic_payload &trans, const tlm::tlm_phase &phase);
 
+    /**
+     * A DMI region granted by the target, along with the latencies the
+     * target asked us to charge for accesses through it.
+     */
+    struct DmiRegion
+    {
+        gem5::MemBackdoorPtr backdoor;
+        gem5::Tick readLatency;
+        gem5::Tick writeLatency;
+    };
+
     gem5::MemBackdoorPtr getBackdoor(tlm::tlm_generic_payload &trans);
-    gem5::AddrRangeMap<gem5::MemBackdoorPtr> backdoorMap;
+    gem5::AddrRangeMap<DmiRegion> backdoorMap;
+
+    /**
+     * Serve a packet straight from a known DMI region, without building
+     * a transaction. Returns false if no region allows the access.
+     */
+    bool dmiAccess(gem5::PacketPtr packet, gem5::Tick &delay);
+
+    /** Complete a packet with DMI or the blocking interface. */
+    gem5::Tick blockingAccess(gem5::PacketPtr packet);
 
     // The gem5 port interface.
     gem5::Tick recvAtomic(gem5::PacketPtr packet);
     gem5::Tick recvAtomicBackdoor(gem5::PacketPtr pkt,
         gem5::MemBackdoorPtr &backdoor);
+    void recvMemBackdoorReq(const gem5::MemBackdoorReq &req,
+        gem5::MemBackdoorPtr &backdoor);
     void recvFunctional(gem5::PacketPtr packet);
     bool recvTimingReq(gem5::PacketPtr packet);
     bool tryTiming(gem5::PacketPtr packet);
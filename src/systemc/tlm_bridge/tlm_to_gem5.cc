@@ -57,6 +57,7 @@
 
 #include "systemc/tlm_bridge/tlm_to_gem5.hh"
 
+#include <algorithm>
 #include <utility>
 
 #include "params/TlmToGem5Bridge32.hh"
@@ -269,8 +270,9 @@ template <unsigned int BITWIDTH>
 void
 TlmToGem5Bridge<BITWIDTH>::invalidateDmi(const gem5::MemBackdoor &backdoor)
 {
+    // The end of a TLM DMI range is inclusive.
     socket->invalidate_direct_mem_ptr(
-            backdoor.range().start(), backdoor.range().end());
+            backdoor.range().start(), backdoor.range().end() - 1);
 }
 
 template <unsigned int BITWIDTH>
@@ -383,27 +385,45 @@ bool
 TlmToGem5Bridge<BITWIDTH>::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
                                               tlm::tlm_dmi &dmi_data)
 {
-    Gem5SystemC::Gem5Extension *extension = nullptr;
-    trans.get_extension(extension);
+    MemBackdoorPtr backdoor = nullptr;
 
-    PacketPtr pkt = nullptr;
+    if (system->isAtomicMode()) {
+        Gem5SystemC::Gem5Extension *extension = nullptr;
+        trans.get_extension(extension);
 
-    // If there is an extension, this transaction was initiated by the gem5
-    // world and we can pipe through the original packet.
-    if (extension != nullptr) {
-        pkt = extension->getPacket();
+        PacketPtr pkt = nullptr;
+
+        // If there is an extension, this transaction was initiated by the
+        // gem5 world and we can pipe through the original packet.
+        if (extension != nullptr) {
+            pkt = extension->getPacket();
+        } else {
+            pkt = payload2packet(_id, trans);
+            pkt->req->setFlags(Request::NO_ACCESS);
+        }
+
+        bmp.sendAtomicBackdoor(pkt, backdoor);
+
+        if (extension == nullptr)
+            destroyPacket(pkt);
     } else {
-        pkt = payload2packet(_id, trans);
-        pkt->req->setFlags(Request::NO_ACCESS);
+        // There is no atomic access to piggy back on outside of atomic
+        // mode, so ask the memory system for the back door directly. This
+        // lets loosely timed initiators skip the bridge even when gem5
+        // itself is running in timing mode.
+        MemBackdoor::Flags flags = trans.is_write() ?
+            MemBackdoor::Writeable : MemBackdoor::Readable;
+        AddrRange r = RangeSize(trans.get_address(),
+                std::max(trans.get_data_length(), 1u));
+        bmp.sendMemBackdoorReq(MemBackdoorReq(r, flags), backdoor);
     }
 
-    MemBackdoorPtr backdoor = nullptr;
-    bmp.sendAtomicBackdoor(pkt, backdoor);
     if (backdoor) {
         trans.set_dmi_allowed(true);
         dmi_data.set_dmi_ptr(backdoor->ptr());
         dmi_data.set_start_address(backdoor->range().start());
-        dmi_data.set_end_address(backdoor->range().end());
+        // The end of a TLM DMI range is inclusive.
+        dmi_data.set_end_address(backdoor->range().end() - 1);
 
         typedef tlm::tlm_dmi::dmi_access_e access_t;
         access_t access = tlm::tlm_dmi::DMI_ACCESS_NONE;
@@ -421,9 +441,6 @@ TlmToGem5Bridge<BITWIDTH>::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
         );
     }
 
-    if (extension == nullptr)
-        destroyPacket(pkt);
-
     trans.set_response_status(tlm::TLM_OK_RESPONSE);
 
     return backdoor != nullptr;
@@ -552,6 +569,8 @@ TlmToGem5Bridge<BITWIDTH>::before_end_of_elaboration()
         SC_REPORT_INFO("TlmToGem5Bridge", "register non-blocking interface");
         socket.register_nb_transport_fw(
                 this, &TlmToGem5Bridge<BITWIDTH>::nb_transport_fw);
+        socket.register_get_direct_mem_ptr(
+                this, &TlmToGem5Bridge<BITWIDTH>::get_direct_mem_ptr);
     } else if (system->isAtomicMode()) {
         SC_REPORT_INFO("TlmToGem5Bridge", "register blocking interface");
         socket.register_b_transport(
@@ -0,0 +1,178 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+
+"""
+Runs one copy of a binary on each of the O3 cores of a simple SE system and
+reports how fast the host simulated it. The classic hierarchy has private L1
+and L2 caches per core, the Ruby one is MESI_Two_Level with a shared L2.
+
+The results are printed and written to `o3_scaling.json` in the output
+directory, with the configuration, the number of committed instructions,
+the host seconds spent in the simulation loop, the simulated instructions per
+host second and the peak resident set size of the gem5 process in KiB.
+"""
+
+import argparse
+import json
+import os
+import resource
+import time
+
+import m5
+from m5.objects import Process
+
+from gem5.components.boards.simple_board import SimpleBoard
+from gem5.components.memory import DualChannelDDR4_2400
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_processor import SimpleProcessor
+from gem5.resources.resource import CustomResource
+from gem5.simulate.simulator import Simulator
+from gem5.utils.requires import requires
+
+
+def cache_factory(cache_class: str, num_cores: int):
+    if cache_class == "classic":
+        from gem5.components.cachehierarchies\
+            .classic.private_l1_private_l2_cache_hierarchy import (
+            PrivateL1PrivateL2CacheHierarchy,
+        )
+
+        return PrivateL1PrivateL2CacheHierarchy(
+            l1d_size="32KiB", l1i_size="32KiB", l2_size="256KiB"
+        )
+    elif cache_class == "ruby":
+        from gem5.components.cachehierarchies\
+            .ruby.mesi_two_level_cache_hierarchy import (
+            MESITwoLevelCacheHierarchy,
+        )
+
+        return MESITwoLevelCacheHierarchy(
+            l1i_size="32KiB",
+            l1i_assoc="8",
+            l1d_size="32KiB",
+            l1d_assoc="8",
+            l2_size="256KiB",
+            l2_assoc="16",
+            num_l2_banks=min(num_cores, 16),
+        )
+    else:
+        raise ValueError(f"The cache class {cache_class} is not supported.")
+
+
+parser = argparse.ArgumentParser(
+    description="Measures the host performance of multi-core O3 systems."
+)
+
+parser.add_argument("binary", type=str, help="The binary each core runs.")
+
+parser.add_argument(
+    "cache_class",
+    type=str,
+    choices=["classic", "ruby"],
+    help="The memory system to use.",
+)
+
+parser.add_argument(
+    "num_cores", type=int, help="The number of O3 cores in the system."
+)
+
+parser.add_argument(
+    "--rob-entries",
+    type=int,
+    default=192,
+    help="The number of ROB entries of each core.",
+)
+
+parser.add_argument(
+    "--max-ticks",
+    type=int,
+    default=m5.MaxTick,
+    help="Stop the simulation after this many ticks.",
+)
+
+args = parser.parse_args()
+
+if args.cache_class == "ruby":
+    from gem5.coherence_protocol import CoherenceProtocol
+
+    requires(coherence_protocol_required=CoherenceProtocol.MESI_TWO_LEVEL)
+
+processor = SimpleProcessor(cpu_type=CPUTypes.O3, num_cores=args.num_cores)
+
+board = SimpleBoard(
+    clk_freq="3GHz",
+    processor=processor,
+    memory=DualChannelDDR4_2400(size="3GiB"),
+    cache_hierarchy=cache_factory(args.cache_class, args.num_cores),
+)
+
+binary = CustomResource(args.binary)
+board.set_se_binary_workload(binary)
+
+# The board only gives the first core a process, the others get their own
+# copy of the same binary.
+for pid, core in enumerate(processor.get_cores()[1:], start=101):
+    process = Process(pid=pid)
+    process.cmd = [args.binary]
+    core.set_workload(process)
+
+cores = [core.get_simobject() for core in processor.get_cores()]
+for core in cores:
+    core.numROBEntries = args.rob_entries
+
+simulator = Simulator(board=board)
+
+start = time.time()
+simulator.run(max_ticks=args.max_ticks)
+host_seconds = time.time() - start
+
+sim_insts = sum(core.totalInsts() for core in cores)
+
+results = {
+    "binary": os.path.basename(args.binary),
+    "cache_class": args.cache_class,
+    "num_cores": args.num_cores,
+    "rob_entries": args.rob_entries,
+    "sim_ticks": simulator.get_current_tick(),
+    "sim_insts": sim_insts,
+    "host_seconds": host_seconds,
+    "sim_insts_per_host_second": sim_insts / host_seconds,
+    "peak_rss_kib": resource.getrusage(resource.RUSAGE_SELF).ru_maxrss,
+}
+
+with open(os.path.join(m5.options.outdir, "o3_scaling.json"), "w") as f:
+    json.dump(results, f, indent=4)
+
+print("o3_scaling: " + json.dumps(results))
+print(
+    "Exiting @ tick {} because {}.".format(
+        simulator.get_current_tick(),
+        simulator.get_last_exit_event_cause(),
+    )
+)
@@ -0,0 +1,98 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+
+"""
+Measures how the host performance of the O3 CPU scales with the number of
+simulated cores. Each test runs one copy of a cpu-tests kernel per core and
+writes its results to `o3_scaling.json` in the test's output directory, so
+they can be collected and compared across gem5 versions.
+"""
+
+from testlib import *
+
+workloads = ("Bubblesort", "FloatMM")
+
+core_counts = (1, 2, 4, 8, 16, 32, 64)
+
+rob_sizes = (192, 512)
+
+base_path = joinpath(config.bin_path, "cpu_tests", "x86")
+
+base_url = config.resource_url + "/test-progs/cpu-tests/bin/x86"
+
+verifiers = (
+    verifier.MatchRegex(
+        re.compile(r"o3_scaling: .*sim_insts_per_host_second")
+    ),
+)
+
+for workload in workloads:
+    workload_binary = DownloadedProgram(
+        base_url + "/" + workload, base_path, workload
+    )
+    binary = joinpath(workload_binary.path, workload)
+
+    for cache_class in ("classic", "ruby"):
+        # The X86 build uses MESI_Two_Level, the VEGA_X86 one doesn't.
+        if cache_class == "ruby":
+            isa = constants.x86_tag
+        else:
+            isa = constants.vega_x86_tag
+
+        for num_cores in core_counts:
+            for rob_entries in rob_sizes:
+                if num_cores <= 8:
+                    length = constants.long_tag
+                else:
+                    length = constants.very_long_tag
+
+                gem5_verify_config(
+                    name="o3_scaling_{}_{}_{}-cores_{}-rob".format(
+                        workload, cache_class, num_cores, rob_entries
+                    ),
+                    verifiers=verifiers,
+                    fixtures=(workload_binary,),
+                    config=joinpath(
+                        config.base_dir,
+                        "tests",
+                        "gem5",
+                        "o3_scaling",
+                        "o3_scaling_run.py",
+                    ),
+                    config_args=[
+                        binary,
+                        cache_class,
+                        str(num_cores),
+                        "--rob-entries",
+                        str(rob_entries),
+                    ],
+                    valid_isas=(isa,),
+                    valid_hosts=constants.supported_hosts,
+                    length=length,
+                )
@@ -30,7 +30,12 @@ import os
 import shutil
 from pathlib import Path
 
-from gem5.resources.md5_utils import md5_file, md5_dir
+from gem5.resources.md5_utils import (
+    md5_file,
+    md5_dir,
+    md5_cached,
+    record_md5,
+)
 
 
 class MD5FileTestSuite(unittest.TestCase):
@@ -114,3 +119,44 @@ class MD5DirTestSuite(unittest.TestCase):
         shutil.rmtree(dir2)
 
         self.assertEquals(first_md5, second_md5)
+
+
+class MD5CachedTestSuite(unittest.TestCase):
+    """Test cases for gem5.resources.md5_utils.md5_cached()"""
+
+    def setUp(self) -> None:
+        self.dir = tempfile.mkdtemp()
+        self.file = Path(self.dir) / "file"
+        with open(self.file, "w") as f:
+            f.write("This is a test string, to be put in a temp file")
+
+    def tearDown(self) -> None:
+        shutil.rmtree(self.dir)
+
+    def test_md5CachedMatchesMd5(self) -> None:
+        # The first call hashes the file, the second uses the recorded value.
+        # Both must give the file's real md5 value.
+        self.assertEquals(md5_file(self.file), md5_cached(self.file))
+        self.assertEquals(md5_file(self.file), md5_cached(self.file))
+
+    def test_recordedValueReused(self) -> None:
+        # While the file is unchanged, the recorded value is returned without
+        # hashing the file again.
+        record_md5(self.file, "not-the-real-md5")
+        self.assertEquals("not-the-real-md5", md5_cached(self.file))
+
+    def test_modifiedFileRehashed(self) -> None:
+        # Changing the file invalidates the recorded value.
+        record_md5(self.file, "not-the-real-md5")
+        with open(self.file, "a") as f:
+            f.write(", and some more")
+        self.assertEquals(md5_file(self.file), md5_cached(self.file))
+
+    def test_modifiedDirRehashed(self) -> None:
+        # Adding a file to a directory invalidates its recorded value.
+        dir = Path(self.dir) / "dir"
+        os.mkdir(dir)
+        record_md5(dir, "not-the-real-md5")
+        with open(dir / "file", "w") as f:
+            f.write("Some test data here")
+        self.assertEquals(md5_dir(dir), md5_cached(dir))
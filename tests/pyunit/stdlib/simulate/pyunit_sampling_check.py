@@ -0,0 +1,60 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import math
+import unittest
+
+from gem5.simulate.sampling import SampleResults
+
+
+class SampleResultsTestSuite(unittest.TestCase):
+    """Test cases for gem5.simulate.sampling"""
+
+    def test_mean_and_stdev(self) -> None:
+        results = SampleResults([2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0])
+        self.assertEqual(8, results.num_samples())
+        self.assertAlmostEqual(5.0, results.mean())
+        self.assertAlmostEqual(math.sqrt(32 / 7), results.stdev())
+
+    def test_confidence_interval(self) -> None:
+        results = SampleResults()
+        for value in [1.0, 2.0, 3.0, 4.0]:
+            results.add_sample(value)
+        half_width = 1.959964 * results.stdev() / 2
+        self.assertAlmostEqual(half_width, results.confidence_interval(0.95),
+                               places=5)
+        self.assertAlmostEqual(half_width / 2.5, results.relative_error(0.95),
+                               places=5)
+        self.assertGreater(results.confidence_interval(0.99), half_width)
+
+    def test_single_sample(self) -> None:
+        results = SampleResults([3.0])
+        self.assertEqual(0.0, results.stdev())
+        self.assertEqual(0.0, results.confidence_interval())
+
+    def test_no_samples(self) -> None:
+        with self.assertRaises(Exception):
+            SampleResults().mean()
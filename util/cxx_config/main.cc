@@ -93,6 +93,9 @@ usage(const std::string &prog_name)
         "    -c <from> <to> <ticks>       -- switch from cpu 'from' to cpu"
         " 'to' after\n"
         "                                    the given number of ticks\n"
+        "    -j <threads>                 -- number of threads to read the"
+        " object\n"
+        "                                    parameters with\n"
         "\n"
         );
 
@@ -141,6 +144,7 @@ main(int argc, char **argv)
     std::string to_cpu = "";
     Tick pre_run_time = 1000000;
     Tick pre_switch_time = 1000000;
+    unsigned num_threads = 1;
 
     try {
         while (arg_ptr < argc) {
@@ -192,6 +196,11 @@ main(int argc, char **argv)
                 to_cpu = argv[arg_ptr + 1];
                 std::istringstream(argv[arg_ptr + 2]) >> pre_switch_time;
                 arg_ptr += 3;
+            } else if (option == "-j") {
+                if (num_args < 1)
+                    usage(prog_name);
+                std::istringstream(argv[arg_ptr]) >> num_threads;
+                arg_ptr++;
             } else {
                 usage(prog_name);
             }
@@ -211,7 +220,7 @@ main(int argc, char **argv)
     getEventQueue(0)->dump();
 
     try {
-        config_manager->instantiate();
+        config_manager->instantiate(true, num_threads);
         if (!checkpoint_restore) {
             config_manager->initState();
             config_manager->startup();
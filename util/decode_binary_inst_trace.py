@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script prints a binary instruction trace, as written by the
+# BinaryInstTracer, as text, one committed instruction per line.
+#
+# Usage: decode_binary_inst_trace.py <trace> [<output>]
+
+import gzip
+import struct
+import sys
+
+MAGIC = 0x43525449354D4547
+VERSION = 1
+
+HEADER = struct.Struct("<QIIQ")
+RECORD = struct.Struct("<QQQ8IHHBBBB")
+
+MEM_VALID = 0x01
+FAULTING = 0x02
+PREDICATE_FALSE = 0x04
+MICROOP = 0x08
+LAST_MICROOP = 0x10
+REGS_TRUNCATED = 0x20
+
+
+def reg_name(reg):
+    return f"{reg >> 24}:{reg & 0xFFFFFF}"
+
+
+def format_record(fields):
+    tick, pc, mem_addr = fields[0:3]
+    regs = fields[3:11]
+    mem_size, cpu_id, op_class, flags, num_src, num_dest = fields[11:]
+
+    srcs = ",".join(reg_name(r) for r in regs[:num_src])
+    dests = ",".join(reg_name(r) for r in regs[num_src : num_src + num_dest])
+    line = (
+        f"{tick:7d}: cpu{cpu_id}: {pc:#x} op={op_class} "
+        f"src=[{srcs}] dest=[{dests}]"
+    )
+    if flags & REGS_TRUNCATED:
+        line += "+"
+    if flags & MEM_VALID:
+        line += f" mem={mem_addr:#x}/{mem_size}"
+    if flags & MICROOP:
+        line += " uop" + ("(last)" if flags & LAST_MICROOP else "")
+    if flags & PREDICATE_FALSE:
+        line += " pred=false"
+    if flags & FAULTING:
+        line += " fault"
+    return line
+
+
+def main():
+    if len(sys.argv) < 2 or len(sys.argv) > 3:
+        print("Usage: ", sys.argv[0], " <trace> [<output>]")
+        sys.exit(-1)
+
+    name = sys.argv[1]
+    trace = gzip.open(name, "rb") if name.endswith(".gz") else open(name, "rb")
+    out = open(sys.argv[2], "w") if len(sys.argv) == 3 else sys.stdout
+
+    magic, version, record_size, freq = HEADER.unpack(trace.read(HEADER.size))
+    if magic != MAGIC:
+        print("Not a binary gem5 instruction trace")
+        sys.exit(-1)
+    if version != VERSION or record_size != RECORD.size:
+        print(f"Unsupported trace version {version}")
+        sys.exit(-1)
+    print(f"# tick frequency {freq}", file=out)
+
+    while True:
+        data = trace.read(RECORD.size * 4096)
+        if not data:
+            break
+        # A trace cut short ends with part of a record
+        usable = len(data) - len(data) % RECORD.size
+        for fields in RECORD.iter_unpack(data[:usable]):
+            print(format_record(fields), file=out)
+
+    trace.close()
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
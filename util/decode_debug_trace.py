@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script decodes a binary debug trace, as written by
+# --debug-format=binary, back into the text gem5 would have printed.
+#
+# Usage: decode_debug_trace.py [--flags A,B] [--fmt-flag] [--sort] <trace>
+
+import argparse
+import gzip
+import re
+import struct
+import sys
+
+MAGIC = 0x43525444354D4547
+VERSION = 1
+
+STRING_RECORD = 1
+MESSAGE_RECORD = 2
+TEXT_RECORD = 3
+
+MAX_TICK = 2**64 - 1
+
+# One cprintf conversion: flags, width, precision, length and conversion
+CONVERSION = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d*)"
+    r"(?:\.(?P<prec>\*|\d*))?[hl]*(?P<conv>[a-zA-Z%])"
+)
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def done(self):
+        return self.pos >= len(self.data)
+
+    def get(self, fmt):
+        size = struct.calcsize(fmt)
+        if self.pos + size > len(self.data):
+            raise EOFError("truncated trace")
+        (value,) = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += size
+        return value
+
+    def bytes(self, size):
+        if self.pos + size > len(self.data):
+            raise EOFError("truncated trace")
+        value = self.data[self.pos : self.pos + size]
+        self.pos += size
+        return value
+
+    def string(self):
+        return self.bytes(self.get("<I")).decode("utf-8", "replace")
+
+
+def read_arg(reader):
+    """Read one argument as a (tag, size, value) tuple."""
+    tag = chr(reader.get("<B"))
+    if tag in "iu":
+        size = reader.get("<B")
+        value = reader.get("<q" if tag == "i" else "<Q")
+        return tag, size, value
+    if tag in "cb":
+        return tag, 1, reader.get("<B")
+    if tag == "f":
+        return tag, 8, reader.get("<d")
+    if tag == "p":
+        return tag, 8, reader.get("<Q")
+    if tag in "sF":
+        return tag, 0, reader.string()
+    raise ValueError(f"unknown argument tag '{tag}'")
+
+
+def convert(match, arg):
+    """Format an argument the way cprintf would."""
+    tag, size, value = arg
+    flags = match.group("flags")
+    width = match.group("width") or ""
+    prec = match.group("prec")
+    conv = match.group("conv")
+    spec = flags + width + ("." + prec if prec is not None else "")
+
+    if tag == "F":
+        # Formatted by gem5 already, with this very conversion
+        return value
+    if tag == "c" and conv not in "diuxXo":
+        value = chr(value)
+    if conv == "p":
+        conv = "x"
+        spec = "#" + spec
+    if conv == "c" and isinstance(value, int):
+        value = chr(value & 0xFF)
+    if conv in "xXo" and isinstance(value, int) and value < 0:
+        # Streams print the two's complement of the argument's type
+        value &= (1 << (8 * size)) - 1
+    if isinstance(value, str):
+        if conv != "s":
+            spec = spec.replace("#", "").replace("+", "").replace(" ", "")
+        conv = "s"
+    elif conv == "s" or conv not in "diuoxXeEfgGc":
+        value = value if tag == "f" else int(value)
+        return ("%" + spec.replace("#", "") + "s") % value
+    elif isinstance(value, float) and conv in "diuoxXc":
+        conv = "g"
+    elif conv == "u":
+        conv = "d"
+    return ("%" + spec + conv) % value
+
+
+def format_message(fmt, args):
+    out = []
+    pos = 0
+    args = iter(args)
+    for match in CONVERSION.finditer(fmt):
+        out.append(fmt[pos : match.start()])
+        pos = match.end()
+        if match.group("conv") == "%":
+            out.append("%")
+            continue
+
+        # '*' widths and precisions take an argument of their own
+        spec = match.group(0)
+        for field in ("width", "prec"):
+            if match.group(field) == "*":
+                stars = next(args, None)
+                spec = spec.replace("*", str(stars[2] if stars else 0), 1)
+        match = CONVERSION.match(spec)
+
+        arg = next(args, None)
+        if arg is None:
+            out.append("<missing>")
+        else:
+            out.append(convert(match, arg))
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def records(data):
+    """Yield (tick, name, flag, message) for every message in a trace."""
+    reader = Reader(data)
+    if reader.get("<Q") != MAGIC:
+        raise ValueError("not a binary gem5 debug trace")
+    version = reader.get("<I")
+    if version != VERSION:
+        raise ValueError(f"unsupported trace version {version}")
+
+    strings = {}
+    while not reader.done():
+        kind = reader.get("<B")
+        if kind == STRING_RECORD:
+            ident = reader.get("<I")
+            strings[ident] = reader.string()
+        elif kind == MESSAGE_RECORD:
+            tick = reader.get("<Q")
+            name = strings[reader.get("<I")]
+            flag = strings[reader.get("<I")]
+            fmt = strings[reader.get("<I")]
+            count = reader.get("<B")
+            reader.get("<I")
+            args = [read_arg(reader) for _ in range(count)]
+            yield tick, name, flag, format_message(fmt, args)
+        elif kind == TEXT_RECORD:
+            tick = reader.get("<Q")
+            name = strings[reader.get("<I")]
+            flag = strings[reader.get("<I")]
+            yield tick, name, flag, reader.string()
+        else:
+            raise ValueError(f"unknown record type {kind}")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a binary gem5 debug trace into text."
+    )
+    parser.add_argument("trace", help="Binary trace, optionally gzipped")
+    parser.add_argument(
+        "--flags",
+        default="",
+        help="Comma separated debug flags to print, all if empty",
+    )
+    parser.add_argument(
+        "--fmt-flag",
+        action="store_true",
+        help="Prefix each message with its debug flag, like FmtFlag",
+    )
+    parser.add_argument(
+        "--sort",
+        action="store_true",
+        help="Sort the messages by tick. Threads write their messages in "
+        "batches, so messages of different threads come out interleaved "
+        "by batch otherwise",
+    )
+    args = parser.parse_args()
+
+    opener = gzip.open if args.trace.endswith(".gz") else open
+    with opener(args.trace, "rb") as f:
+        data = f.read()
+
+    flags = set(f for f in args.flags.split(",") if f)
+    messages = records(data)
+    if flags:
+        messages = (m for m in messages if m[2] in flags)
+    if args.sort:
+        messages = sorted(messages, key=lambda m: m[0])
+
+    out = sys.stdout
+    for tick, name, flag, message in messages:
+        if tick != MAX_TICK:
+            out.write("%7d: " % tick)
+        if args.fmt_flag and flag:
+            out.write(f"{flag}: ")
+        if name:
+            out.write(f"{name}: ")
+        out.write(message)
+
+
+if __name__ == "__main__":
+    main()
@@ -36,10 +36,12 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 # This script is used to dump protobuf packet traces to ASCII
-# format.
+# format. Traces in the binary format of MemTraceProbe (binary_format)
+# are dumped in the same format.
 
 import os
 import protolib
+import struct
 import subprocess
 import sys
 
@@ -48,6 +50,43 @@ util_dir = os.path.dirname(os.path.realpath(__file__))
 subprocess.check_call(['make', '--quiet', '-C', util_dir, 'packet_pb2.py'])
 import packet_pb2
 
+# Layout of the binary format, see src/mem/probes/mem_trace.hh
+binary_header = struct.Struct('<8sIIQII')
+binary_record = struct.Struct('<QQQQIIH6x')
+
+def decode_binary(trace_in, ascii_out):
+    magic, version, record_size, tick_freq, num_ids, _ = \
+        binary_header.unpack(b'GEM5' + trace_in.read(binary_header.size - 4))
+    if magic != b'GEM5MTRC' or version != 1 or \
+       record_size != binary_record.size:
+        print("Unsupported binary trace format")
+        exit(-1)
+
+    print("Tick frequency:", tick_freq)
+    for i in range(num_ids):
+        length, = struct.unpack('<I', trace_in.read(4))
+        print('Master id %d: %s' % (i, trace_in.read(length).decode()))
+
+    print("Parsing packets")
+
+    num_packets = 0
+    while True:
+        chunk = trace_in.read(binary_record.size * 4096)
+        if not chunk:
+            break
+        for tick, addr, pc, pkt_id, flags, size, cmd in \
+                binary_record.iter_unpack(chunk):
+            num_packets += 1
+            cmd = 'r' if cmd == 1 else ('w' if cmd == 4 else 'u')
+            ascii_out.write('%s,%s,%s,%s,%s,%s' % (pkt_id, cmd, addr, size,
+                                                 flags, tick))
+            if pc:
+                ascii_out.write(',%s\n' % (pc))
+            else:
+                ascii_out.write('\n')
+
+    print("Parsed packets:", num_packets)
+
 def main():
     if len(sys.argv) != 3:
         print("Usage: ", sys.argv[0], " <protobuf input> <ASCII output>")
@@ -65,6 +104,12 @@ def main():
     # Read the magic number in 4-byte Little Endian
     magic_number = proto_in.read(4).decode()
 
+    if magic_number == "GEM5":
+        decode_binary(proto_in, ascii_out)
+        ascii_out.close()
+        proto_in.close()
+        return
+
     if magic_number != "gem5":
         print("Unrecognized file", sys.argv[1])
         exit(-1)
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts an ASCII branch trace to the protobuf format read
+# by the BranchTraceDriver. It assumes that protoc has been executed and
+# already generated the Python package for the branch messages. This can
+# be done manually using:
+# protoc --python_out=. --proto_path=src/proto src/proto/branch.proto
+#
+# The ASCII trace format uses one line per committed control instruction
+# on the format pc, target, taken, type[, size[, insts]]. The type is one
+# of the BranchType names in src/proto/branch.proto, size is the size of
+# the instruction in bytes and insts is the number of instructions
+# committed since the previous branch, including the branch itself.
+# Numbers may be given in decimal or hexadecimal. For example:
+# 0x400500,0x400520,1,CondDirect,2,7
+# 0x400524,0x401000,1,CallDirect,5,2
+# 0x401010,0x400529,1,Return,1,5
+
+import protolib
+import sys
+
+# Import the branch proto definitions. If they are not found, attempt
+# to generate them automatically. This assumes that the script is
+# executed from the gem5 root.
+try:
+    import branch_pb2
+except:
+    print("Did not find branch proto definitions, attempting to generate")
+    from subprocess import call
+    error = call(['protoc', '--python_out=util', '--proto_path=src/proto',
+                  'src/proto/branch.proto'])
+    if not error:
+        print("Generated branch proto definitions")
+
+        try:
+            import google.protobuf
+        except:
+            print("Please install the Python protobuf module")
+            exit(-1)
+
+        import branch_pb2
+    else:
+        print("Failed to import branch proto definitions")
+        exit(-1)
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <ASCII input> <protobuf output>")
+        exit(-1)
+
+    try:
+        ascii_in = open(sys.argv[1], 'r')
+    except IOError:
+        print("Failed to open ", sys.argv[1], " for reading")
+        exit(-1)
+
+    try:
+        proto_out = open(sys.argv[2], 'wb')
+    except IOError:
+        print("Failed to open ", sys.argv[2], " for writing")
+        exit(-1)
+
+    # Write the magic number in 4-byte Little Endian, similar to what
+    # is done in src/proto/protoio.cc
+    proto_out.write(b"gem5")
+
+    header = branch_pb2.BranchHeader()
+    header.obj_id = "Converted ASCII trace " + sys.argv[1]
+    protolib.encodeMessage(proto_out, header)
+
+    for line in ascii_in:
+        fields = [f.strip() for f in line.split(',')]
+        if not fields[0] or fields[0].startswith('#'):
+            continue
+        branch = branch_pb2.Branch()
+        branch.pc = int(fields[0], 0)
+        branch.target = int(fields[1], 0)
+        branch.taken = int(fields[2], 0) != 0
+        branch.type = branch_pb2.Branch.BranchType.Value(fields[3])
+        if len(fields) > 4:
+            branch.size = int(fields[4], 0)
+        if len(fields) > 5:
+            branch.insts = int(fields[5], 0)
+        protolib.encodeMessage(proto_out, branch)
+
+    ascii_in.close()
+    proto_out.close()
+
+if __name__ == "__main__":
+    main()
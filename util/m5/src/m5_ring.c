@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gem5/m5ops.h>
+#include <gem5/m5ring.h>
+
+#include "m5_mmap.h"
+#include "m5_ring.h"
+
+static struct m5_ring_header *m5_ring = NULL;
+
+#ifndef M5_RING_ADDR
+#define M5_RING_ADDR 0
+#endif
+uint64_t m5_ring_addr = M5_RING_ADDR;
+
+void
+map_m5_ring()
+{
+    int fd;
+    void *ring;
+
+    if (m5_ring) {
+        fprintf(stderr, "m5 ring already mapped.\n");
+        exit(1);
+    }
+
+    // A full ring is drained through the address based mechanism
+    if (!m5_mem)
+        map_m5_mem();
+
+    // The ring is shared through (cached) memory, unlike the m5 op range
+    fd = open(m5_mmap_dev, O_RDWR);
+    if (fd == -1) {
+        fprintf(stderr, "Can't open %s: %s\n", m5_mmap_dev, strerror(errno));
+        exit(1);
+    }
+
+    ring = mmap(NULL, M5_RING_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                m5_ring_addr);
+    close(fd);
+
+    if (ring == MAP_FAILED) {
+        fprintf(stderr, "Can't map %s: %s\n", m5_mmap_dev, strerror(errno));
+        exit(1);
+    }
+    m5_ring = (struct m5_ring_header *)ring;
+}
+
+void
+unmap_m5_ring()
+{
+    if (m5_ring) {
+        munmap(m5_ring, M5_RING_SIZE);
+        m5_ring = NULL;
+    }
+}
+
+static void
+m5_ring_push(uint32_t func, uint64_t arg0, uint64_t arg1)
+{
+    struct m5_ring_entry *entries = (struct m5_ring_entry *)(m5_ring + 1);
+    struct m5_ring_entry *entry;
+    uint64_t idx;
+    int cpu;
+
+    idx = __atomic_fetch_add(&m5_ring->head, 1, __ATOMIC_RELAXED);
+
+    // Wait for gem5 to consume the entry from the previous lap
+    while (idx - __atomic_load_n(&m5_ring->tail, __ATOMIC_ACQUIRE) >=
+           M5_RING_ENTRIES) {
+        m5_ring_drain_addr();
+    }
+
+    cpu = sched_getcpu();
+    entry = &entries[idx % M5_RING_ENTRIES];
+    entry->func = func;
+    entry->cpu = cpu < 0 ? 0 : cpu;
+    entry->args[0] = arg0;
+    entry->args[1] = arg1;
+    __atomic_store_n(&entry->seq, idx + 1, __ATOMIC_RELEASE);
+}
+
+void
+m5_ring_work_begin(uint64_t workid, uint64_t threadid)
+{
+    m5_ring_push(M5OP_WORK_BEGIN, workid, threadid);
+}
+
+void
+m5_ring_work_end(uint64_t workid, uint64_t threadid)
+{
+    m5_ring_push(M5OP_WORK_END, workid, threadid);
+}
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script merges the debug output of several event queues, as
+# written by --debug-per-queue, into one stream ordered by tick.
+#
+# Usage: merge_debug_traces.py [-o merged.log] debug.log.0 debug.log.1 ...
+#
+# Messages of the same tick are kept in the order of the files on the
+# command line. Lines that don't start with a tick, such as the rest of
+# a message spanning several lines, stay with the message before them.
+
+import argparse
+import gzip
+import heapq
+import re
+import sys
+
+TICK = re.compile(r"^\s*(\d+): ")
+
+
+def messages(index, lines):
+    """Yield a (tick, index, text) tuple for every message of a file."""
+    tick = 0
+    text = []
+    for line in lines:
+        match = TICK.match(line)
+        if match and text:
+            yield tick, index, "".join(text)
+            text = []
+        if match:
+            tick = int(match.group(1))
+        text.append(line)
+    if text:
+        yield tick, index, "".join(text)
+
+
+def open_trace(name):
+    if name.endswith(".gz"):
+        return gzip.open(name, "rt")
+    return open(name)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Merge per event queue gem5 debug files by tick."
+    )
+    parser.add_argument("files", nargs="+", help="Debug files to merge")
+    parser.add_argument(
+        "-o", "--output", default="-", help="Merged file, '-' for stdout"
+    )
+    args = parser.parse_args()
+
+    files = [open_trace(name) for name in args.files]
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    try:
+        merged = heapq.merge(
+            *(messages(i, f) for i, f in enumerate(files)),
+            key=lambda m: (m[0], m[1]),
+        )
+        for _, _, text in merged:
+            out.write(text)
+    finally:
+        for f in files:
+            f.close()
+        if out is not sys.stdout:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -35,10 +35,14 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-# Pipeline activity viewer for the O3 CPU model.
+# Pipeline activity viewer for the O3 CPU model. It reads either the
+# text trace of the O3PipeView debug flag or the binary trace of the
+# PipeTrace probe listener, whose index is used to only read the parts of
+# the trace which are in the tick or instruction range.
 
 import argparse
 import os
+import struct
 import sys
 import copy
 
@@ -104,22 +108,7 @@ def process_trace(trace, outfile, cycle_time, width, color, timestamps,
         if not line: return
         fields = line.split(':')
 
-    # Print header
-    outfile.write('// f = fetch, d = decode, n = rename, p = dispatch, '
-                  'i = issue, c = complete, r = retire')
-
-    if store_completions:
-        outfile.write(', s = store-complete')
-    outfile.write('\n\n')
-
-    outfile.write(' ' + 'timeline'.center(width) +
-                  '   ' + 'tick'.center(15) +
-                  '  ' + 'pc.upc'.center(12) +
-                  '  ' + 'disasm'.ljust(25) +
-                  '  ' + 'seq_num'.center(10))
-    if timestamps:
-        outfile.write('timestamps'.center(25))
-    outfile.write('\n')
+    print_header(outfile, width, timestamps, store_completions)
 
     # Region of interest
     curr_inst = {}
@@ -140,7 +129,8 @@ def process_trace(trace, outfile, cycle_time, width, color, timestamps,
                     curr_inst['disasm'] = '-----' + curr_inst['disasm']
                 if store_completions:
                     curr_inst[fields[3]] = int(fields[4])
-                queue_inst(outfile, curr_inst, cycle_time, width, color, timestamps, store_completions)
+                queue_inst(outfile, copy.deepcopy(curr_inst), cycle_time,
+                           width, color, timestamps, store_completions)
 
         line = trace.readline()
         if not line:
@@ -149,12 +139,132 @@ def process_trace(trace, outfile, cycle_time, width, color, timestamps,
         fields = line.split(':')
 
 
+# Binary trace format of the PipeTrace probe listener, see
+# src/cpu/o3/probe/pipe_trace_format.hh
+PIPE_MAGIC = b'GEM5PIPE'
+PIPE_INDEX_MAGIC = b'GEM5PIDX'
+PIPE_HEADER = struct.Struct('=8sIIQ')
+PIPE_BLOCK_HEADER = struct.Struct('=IIQQQQQ')
+PIPE_RECORD = struct.Struct('=QQQIHH7iI')
+PIPE_INDEX_ENTRY = struct.Struct('=QQQQQ')
+PIPE_TRAILER = struct.Struct('=Q8s')
+PIPE_COMMITTED = 0x1
+PIPE_STAGES = ['decode', 'rename', 'dispatch', 'issue', 'complete',
+               'retire', 'store']
+
+def is_binary_trace(tracefile):
+    with open(tracefile, 'rb') as trace:
+        return trace.read(len(PIPE_MAGIC)) == PIPE_MAGIC
+
+# Returns the index entries (offset, min/max fetch tick, min/max seq.
+# number) of the blocks of a binary trace. If the simulation did not
+# finish writing the index, the blocks are found by walking the trace.
+def read_binary_index(trace):
+    trace.seek(0, os.SEEK_END)
+    size = trace.tell()
+    if size >= PIPE_HEADER.size + PIPE_TRAILER.size:
+        trace.seek(size - PIPE_TRAILER.size)
+        num_blocks, magic = PIPE_TRAILER.unpack(
+            trace.read(PIPE_TRAILER.size))
+        index_size = num_blocks * PIPE_INDEX_ENTRY.size
+        if (magic == PIPE_INDEX_MAGIC and
+            index_size <= size - PIPE_HEADER.size - PIPE_TRAILER.size):
+            trace.seek(size - PIPE_TRAILER.size - index_size)
+            return list(PIPE_INDEX_ENTRY.iter_unpack(
+                trace.read(index_size)))
+
+    index = []
+    offset = PIPE_HEADER.size
+    while offset + PIPE_BLOCK_HEADER.size <= size:
+        trace.seek(offset)
+        (num_records, num_strings, string_bytes, min_tick, max_tick,
+         min_sn, max_sn) = PIPE_BLOCK_HEADER.unpack(
+             trace.read(PIPE_BLOCK_HEADER.size))
+        block_size = (PIPE_BLOCK_HEADER.size + string_bytes +
+                      num_records * PIPE_RECORD.size)
+        if offset + block_size > size:
+            break # truncated block
+        index.append((offset, min_tick, max_tick, min_sn, max_sn))
+        offset += block_size
+    return index
+
+def process_binary_trace(trace, outfile, cycle_time, width, color,
+                         timestamps, committed_only, store_completions,
+                         start_tick, stop_tick, start_sn, stop_sn):
+    global insts
+
+    insts['sn_start'] = start_sn
+    insts['sn_stop'] = stop_sn
+    insts['tick_start'] = start_tick
+    insts['tick_stop'] = stop_tick
+    insts['only_committed'] = committed_only
+
+    magic, version, _, _ = PIPE_HEADER.unpack(trace.read(PIPE_HEADER.size))
+    if version != 1:
+        sys.exit('Unsupported pipeline trace version %d' % version)
+
+    print_header(outfile, width, timestamps, store_completions)
+
+    for offset, min_tick, max_tick, min_sn, max_sn in \
+            read_binary_index(trace):
+        # Skip the blocks out of the region of interest
+        if ((max_tick < start_tick) or (stop_tick > 0 and
+                                        min_tick > stop_tick) or
+            (max_sn < start_sn) or (stop_sn > 0 and min_sn > stop_sn)):
+            continue
+
+        trace.seek(offset)
+        num_records, num_strings, _, _, _, _, _ = PIPE_BLOCK_HEADER.unpack(
+            trace.read(PIPE_BLOCK_HEADER.size))
+        strings = []
+        for _ in range(num_strings):
+            length, = struct.unpack('=H', trace.read(2))
+            strings.append(' '.join(
+                trace.read(length).decode('utf-8', 'replace').split()))
+
+        for rec in PIPE_RECORD.iter_unpack(
+                trace.read(num_records * PIPE_RECORD.size)):
+            (sn, pc, fetch, disasm, upc, flags) = rec[:6]
+            inst = {'fetch': fetch, 'pc': '0x%08x' % pc, 'upc': str(upc),
+                    'sn': sn, 'disasm': strings[disasm]}
+            # As in the text trace, the ticks of the stages that did not
+            # happen are zero
+            for stage, delta in zip(PIPE_STAGES, rec[6:13]):
+                inst[stage] = 0 if delta == -1 else fetch + delta
+            if not flags & PIPE_COMMITTED:
+                inst['retire'] = 0
+            if inst['retire'] == 0:
+                inst['disasm'] = '-----' + inst['disasm']
+            queue_inst(outfile, inst, cycle_time, width, color, timestamps,
+                       store_completions)
+
+    print_insts(outfile, cycle_time, width, color, timestamps,
+                store_completions, 0)
+
+
+def print_header(outfile, width, timestamps, store_completions):
+    outfile.write('// f = fetch, d = decode, n = rename, p = dispatch, '
+                  'i = issue, c = complete, r = retire')
+
+    if store_completions:
+        outfile.write(', s = store-complete')
+    outfile.write('\n\n')
+
+    outfile.write(' ' + 'timeline'.center(width) +
+                  '   ' + 'tick'.center(15) +
+                  '  ' + 'pc.upc'.center(12) +
+                  '  ' + 'disasm'.ljust(25) +
+                  '  ' + 'seq_num'.center(10))
+    if timestamps:
+        outfile.write('timestamps'.center(25))
+    outfile.write('\n')
+
+
 # Puts new instruction into the print queue.
 # Sorts out and prints instructions when their number reaches threshold value
 def queue_inst(outfile, inst, cycle_time, width, color, timestamps, store_completions):
     global insts
-    l_copy = copy.deepcopy(inst)
-    insts['queue'].append(l_copy)
+    insts['queue'].append(inst)
     if len(insts['queue']) > insts['max_threshold']:
         print_insts(outfile, cycle_time, width, color, timestamps, store_completions, insts['min_threshold'])
 
@@ -359,12 +469,16 @@ def main():
         sys.exit(1)
     # Process trace
     print('Processing trace... ', end=' ')
-    with open(args.tracefile, 'r') as trace:
+    if is_binary_trace(args.tracefile):
+        process, mode = process_binary_trace, 'rb'
+    else:
+        process, mode = process_trace, 'r'
+    with open(args.tracefile, mode) as trace:
         with open(args.outfile, 'w') as out:
-            process_trace(trace, out, args.cycle_time, args.width,
-                          args.color, args.timestamps,
-                          args.only_committed, args.store_completions,
-                          *(tick_range + inst_range))
+            process(trace, out, args.cycle_time, args.width,
+                    args.color, args.timestamps,
+                    args.only_committed, args.store_completions,
+                    *(tick_range + inst_range))
     print('done!')
 
 